@@ -0,0 +1,87 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "DataStructures/ArrayList.h"
+#include <string>
+#include <vector>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+namespace {
+	/**
+	 * An element with no default constructor, which the old ArrayList could not hold
+	 */
+	struct Point {
+		/**
+		 * The coordinates
+		 */
+		double x, y, z;
+
+		/**
+		 * Makes a point
+		 * @param x The x coordinate
+		 * @param y The y coordinate
+		 * @param z The z coordinate
+		 */
+		Point(double x, double y, double z) : x(x), y(y), z(z) {}
+	};
+}
+
+/**
+ * Push and emplace throughput of ArrayList against std::vector, starting from empty lists so growth is included
+ */
+ESSENTIALS_BENCHMARK(arrayListPush) {
+	size_t count = scaled(10000000);
+	report("ArrayList<int>::push", measure([&] {
+		DataStructures::ArrayList<int> list;
+		for (size_t i = 0; i < count; i++)
+			list.push(static_cast<int>(i));
+		keep(list.data());
+	}), static_cast<double>(count));
+	report("std::vector<int>::push_back", measure([&] {
+		std::vector<int> list;
+		for (size_t i = 0; i < count; i++)
+			list.push_back(static_cast<int>(i));
+		keep(list.data());
+	}), static_cast<double>(count));
+	report("ArrayList<Point>::emplace", measure([&] {
+		DataStructures::ArrayList<Point> list;
+		for (size_t i = 0; i < count; i++)
+			list.emplace(1.0 * i, 2.0, 3.0);
+		keep(list.data());
+	}), static_cast<double>(count));
+	report("std::vector<Point>::emplace_back", measure([&] {
+		std::vector<Point> list;
+		for (size_t i = 0; i < count; i++)
+			list.emplace_back(1.0 * i, 2.0, 3.0);
+		keep(list.data());
+	}), static_cast<double>(count));
+	size_t strings = count / 10;
+	report("ArrayList<std::string>::emplace", measure([&] {
+		DataStructures::ArrayList<std::string> list;
+		for (size_t i = 0; i < strings; i++)
+			list.emplace("a string too long for inline storage");
+		keep(list.data());
+	}), static_cast<double>(strings));
+	report("std::vector<std::string>::emplace_back", measure([&] {
+		std::vector<std::string> list;
+		for (size_t i = 0; i < strings; i++)
+			list.emplace_back("a string too long for inline storage");
+		keep(list.data());
+	}), static_cast<double>(strings));
+}
\ No newline at end of file
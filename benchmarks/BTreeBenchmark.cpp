@@ -0,0 +1,145 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "DataStructures/BTree.h"
+#include "DataStructures/BinarySearchTree.h"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+namespace {
+	/**
+	 * Makes pseudo random keys
+	 * @param count The number of keys
+	 * @param seed Where the sequence starts
+	 * @returns The keys
+	 */
+	DataStructures::ArrayList<uint64_t> randomKeys(size_t count, uint64_t seed) {
+		DataStructures::ArrayList<uint64_t> keys;
+		for (size_t i = 0; i < count; i++) {
+			seed ^= seed << 13;
+			seed ^= seed >> 7;
+			seed ^= seed << 17;
+			keys.push(seed);
+		}
+		return keys;
+	}
+}
+
+/**
+ * BTree against std::map (random inserts, lookups, in-order iteration and removals)
+ */
+ESSENTIALS_BENCHMARK(bTree) {
+	size_t count = scaled(1000000);
+	DataStructures::ArrayList<uint64_t> keys = randomKeys(count, 88172645463325252ull);
+
+	DataStructures::BTree<uint64_t, uint64_t> tree;
+	report("BTree insert", measure([&] {
+		tree.clear();
+		for (size_t i = 0; i < count; i++)
+			tree.set(keys[i], i);
+	}), static_cast<double>(count));
+	report("BTree get", measure([&] {
+		uint64_t sum = 0;
+		for (size_t i = 0; i < count; i++)
+			sum += *tree.get(keys[i]);
+		keep(sum);
+	}), static_cast<double>(count));
+	report("BTree iterate", measure([&] {
+		uint64_t sum = 0;
+		for (auto it = tree.begin(); it != tree.end(); ++it)
+			sum += it.value();
+		keep(sum);
+	}), static_cast<double>(count));
+	report("BTree remove", measure([&] {
+		for (size_t i = 0; i < count; i++)
+			tree.remove(keys[i]);
+		keep(tree.length());
+	}, 1), static_cast<double>(count));
+
+	std::map<uint64_t, uint64_t> map;
+	report("std::map insert", measure([&] {
+		map.clear();
+		for (size_t i = 0; i < count; i++)
+			map[keys[i]] = i;
+	}), static_cast<double>(count));
+	report("std::map find", measure([&] {
+		uint64_t sum = 0;
+		for (size_t i = 0; i < count; i++)
+			sum += map.find(keys[i])->second;
+		keep(sum);
+	}), static_cast<double>(count));
+	report("std::map iterate", measure([&] {
+		uint64_t sum = 0;
+		for (auto it = map.begin(); it != map.end(); ++it)
+			sum += it->second;
+		keep(sum);
+	}), static_cast<double>(count));
+	report("std::map erase", measure([&] {
+		for (size_t i = 0; i < count; i++)
+			map.erase(keys[i]);
+		keep(map.size());
+	}, 1), static_cast<double>(count));
+}
+
+/**
+ * Lower bound searches with BinarySearchTree and BTree against std::lower_bound on a sorted array, for a cache resident and a large set
+ */
+ESSENTIALS_BENCHMARK(lowerBound) {
+	size_t queries = scaled(2000000);
+	DataStructures::ArrayList<uint64_t> probes = randomKeys(queries, 0x2545F4914F6CDD1Dull);
+	for (size_t size : { scaled(4096), scaled(4000000) }) {
+		DataStructures::ArrayList<uint64_t> sorted = randomKeys(size, 88172645463325252ull);
+		std::sort(sorted.data(), sorted.data() + size);
+		DataStructures::BinarySearchTree<uint64_t> implicit(sorted);
+		DataStructures::BTree<uint64_t, void> tree;
+		for (size_t i = 0; i < size; i++)
+			tree.insert(sorted[i]);
+
+		char label[64];
+		std::snprintf(label, sizeof(label), "std::lower_bound, %zu keys", size);
+		report(label, measure([&] {
+			uint64_t sum = 0;
+			for (size_t i = 0; i < queries; i++) {
+				const uint64_t* found = std::lower_bound(sorted.data(), sorted.data() + size, probes[i]);
+				sum += found != sorted.data() + size ? *found : 0;
+			}
+			keep(sum);
+		}), static_cast<double>(queries));
+		std::snprintf(label, sizeof(label), "BinarySearchTree::lowerBound, %zu keys", size);
+		report(label, measure([&] {
+			uint64_t sum = 0;
+			for (size_t i = 0; i < queries; i++) {
+				const uint64_t* found = implicit.lowerBound(probes[i]);
+				sum += found != nullptr ? *found : 0;
+			}
+			keep(sum);
+		}), static_cast<double>(queries));
+		std::snprintf(label, sizeof(label), "BTree::lowerBound, %zu keys", size);
+		report(label, measure([&] {
+			uint64_t sum = 0;
+			for (size_t i = 0; i < queries; i++) {
+				auto found = tree.lowerBound(probes[i]);
+				sum += found != tree.end() ? *found : 0;
+			}
+			keep(sum);
+		}), static_cast<double>(queries));
+	}
+}
\ No newline at end of file
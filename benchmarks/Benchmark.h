@@ -0,0 +1,140 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "DataStructures/ArrayList.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * Defines a benchmark and registers it under its name
+ * @param name The name of the benchmark function
+ */
+#define ESSENTIALS_BENCHMARK(name) \
+	static void name(); \
+	static Essentials::Benchmarks::Registration name##Registration(#name, name); \
+	static void name()
+
+/**
+ * The namespace for the benchmarks of the essentials library
+ */
+namespace Essentials::Benchmarks {
+
+	/**
+	 * A benchmark registered with ESSENTIALS_BENCHMARK
+	 */
+	struct Benchmark {
+		/**
+		 * The name the benchmark is selected by
+		 */
+		const char* name;
+
+		/**
+		 * Runs the benchmark and prints its results
+		 */
+		void (*run)();
+	};
+
+	/**
+	 * Gets every registered benchmark
+	 * @returns The benchmarks, in registration order
+	 */
+	inline DataStructures::ArrayList<Benchmark>& registry() {
+		static DataStructures::ArrayList<Benchmark> benchmarks;
+		return benchmarks;
+	}
+
+	/**
+	 * Adds a benchmark to the registry when it is constructed (used by ESSENTIALS_BENCHMARK)
+	 */
+	struct Registration {
+		/**
+		 * Registers a benchmark
+		 * @param name The name of the benchmark
+		 * @param run The function running it
+		 */
+		Registration(const char* name, void (*run)()) {
+			registry().push({name, run});
+		}
+	};
+
+	/**
+	 * Gets the factor problem sizes are multiplied by, read from the ESSENTIALS_BENCH_SCALE environment variable
+	 * @returns The scale (1 by default)
+	 */
+	inline double scale() {
+		static const double value = [] {
+			const char* text = std::getenv("ESSENTIALS_BENCH_SCALE");
+			double parsed = text != nullptr ? std::atof(text) : 1.0;
+			return parsed > 0 ? parsed : 1.0;
+		}();
+		return value;
+	}
+
+	/**
+	 * Scales a problem size
+	 * @param count The size at a scale of 1
+	 * @returns The scaled size (at least 1)
+	 */
+	inline size_t scaled(size_t count) {
+		double result = static_cast<double>(count) * scale();
+		return result < 1 ? 1 : static_cast<size_t>(result);
+	}
+
+	/**
+	 * Keeps the compiler from optimizing away a value a benchmark computed
+	 * @param value The value
+	 */
+	template<typename T> inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "g"(&value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	/**
+	 * Times a function, taking the best of a few runs so one slow run (page faults, another process) does not count
+	 * @param function The function to time
+	 * @param repeats The number of runs
+	 * @returns The fastest run in seconds
+	 */
+	template<typename F> double measure(F&& function, size_t repeats = 3) {
+		double best = 0;
+		for (size_t i = 0; i < repeats; i++) {
+			auto start = std::chrono::steady_clock::now();
+			function();
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (i == 0 || seconds < best)
+				best = seconds;
+		}
+		return best;
+	}
+
+	/**
+	 * Prints one result line
+	 * @param label What was measured
+	 * @param seconds The time it took
+	 * @param operations The number of operations done in that time
+	 */
+	inline void report(const char* label, double seconds, double operations) {
+		std::printf("  %-48s %10.2f ms %12.2f Mops/s\n", label, seconds * 1e3, operations / seconds / 1e6);
+	}
+}
\ No newline at end of file
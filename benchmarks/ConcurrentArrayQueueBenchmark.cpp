@@ -0,0 +1,70 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "DataStructures/ArrayQueue.h"
+#include <atomic>
+#include <thread>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+/**
+ * ConcurrentArrayQueue throughput with 1, 2, 4, 8 and 16 producer/consumer pairs, pushing and popping one item at a time and in batches of 16
+ */
+ESSENTIALS_BENCHMARK(concurrentArrayQueue) {
+	size_t count = scaled(4000000);
+	for (size_t batch : { size_t(1), size_t(16) }) {
+		for (size_t pairs = 1; pairs <= 16; pairs *= 2) {
+			size_t perThread = count / pairs;
+			double seconds = measure([&] {
+				DataStructures::ConcurrentArrayQueue<size_t> queue(1024);
+				DataStructures::ArrayList<std::thread> threads;
+				for (size_t p = 0; p < pairs; p++) {
+					threads.emplace([&] {
+						size_t items[16];
+						for (size_t i = 0; i < perThread; ) {
+							size_t want = perThread - i < batch ? perThread - i : batch;
+							for (size_t j = 0; j < want; j++)
+								items[j] = i + j;
+							size_t pushed = queue.tryPush(items, want);
+							if (pushed == 0) std::this_thread::yield();
+							i += pushed;
+						}
+					});
+					threads.emplace([&] {
+						size_t items[16];
+						size_t sum = 0;
+						for (size_t i = 0; i < perThread; ) {
+							size_t want = perThread - i < batch ? perThread - i : batch;
+							size_t popped = queue.tryDequeue(items, want);
+							if (popped == 0) std::this_thread::yield();
+							for (size_t j = 0; j < popped; j++)
+								sum += items[j];
+							i += popped;
+						}
+						keep(sum);
+					});
+				}
+				for (size_t i = 0; i < threads.length(); i++)
+					threads[i].join();
+			});
+			char label[64];
+			std::snprintf(label, sizeof(label), "%zu pair%s, batch %zu", pairs, pairs == 1 ? "" : "s", batch);
+			report(label, seconds, static_cast<double>(perThread * pairs));
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "Files/Directory.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+namespace {
+	/**
+	 * Makes a tree of directories, each directory holding the same number of files, half .txt and half .log
+	 * @param root The directory to make the tree in
+	 * @param fanOut The number of subdirectories of each directory above the last level
+	 * @param levels The number of levels of subdirectories
+	 * @param files The number of files in each directory
+	 * @param textFiles Increased by the number of .txt files made
+	 * @returns The number of entries in the tree (files and directories, not counting the root)
+	 */
+	size_t makeTree(const std::filesystem::path& root, size_t fanOut, size_t levels, size_t files, size_t& textFiles) {
+		std::filesystem::create_directories(root);
+		size_t entries = 0;
+		for (size_t i = 0; i < files; i++) {
+			std::ofstream(root / ("file" + std::to_string(i) + (i % 2 == 0 ? ".txt" : ".log"))) << i;
+			entries++;
+			if (i % 2 == 0)
+				textFiles++;
+		}
+		if (levels == 0) return entries;
+		for (size_t i = 0; i < fanOut; i++)
+			entries += 1 + makeTree(root / ("directory" + std::to_string(i)), fanOut, levels - 1, files, textFiles);
+		return entries;
+	}
+
+	/**
+	 * Prints a line if a walk did not list the entries it should have
+	 * @param label The walk
+	 * @param found The number of entries it listed
+	 * @param expected The number of entries it should have listed
+	 */
+	void checkCount(const char* label, size_t found, size_t expected) {
+		if (found != expected)
+			std::printf("  %s listed %zu entries, expected %zu\n", label, found, expected);
+	}
+}
+
+/**
+ * Walking a tree of about 17000 entries (at a scale of 1) with the parallel Directory walker against
+ * std::filesystem::recursive_directory_iterator, listing everything, filtering by extension and getting sizes
+ * The tree is made once first, so every walk reads cached directories
+ */
+ESSENTIALS_BENCHMARK(directoryWalk) {
+	const char* directory = std::getenv("TMPDIR");
+	std::filesystem::path root = std::filesystem::path(directory != nullptr ? directory : "/tmp") / "essentials-directory-benchmark";
+	std::filesystem::remove_all(root);
+	size_t textFiles = 0;
+	size_t entries = makeTree(root, 20, 2, scaled(40), textFiles);
+	std::string rootPath = root.string();
+	double count = static_cast<double>(entries);
+
+	report("recursive_directory_iterator", measure([&] {
+		size_t found = 0;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(root)) {
+			keep(entry);
+			found++;
+		}
+		checkCount("recursive_directory_iterator", found, entries);
+	}), count);
+	report("Directory::next", measure([&] {
+		Files::Directory walk(Strings::StringView(rootPath.c_str()));
+		Files::DirectoryEntry entry;
+		size_t found = 0;
+		while (walk.next(entry))
+			found++;
+		checkCount("Directory::next", found, entries);
+	}), count);
+	report("Directory::forEach", measure([&] {
+		Files::Directory walk(Strings::StringView(rootPath.c_str()));
+		std::atomic<size_t> found(0);
+		walk.forEach([&](Files::DirectoryEntry&) {
+			found.fetch_add(1, std::memory_order_relaxed);
+		});
+		checkCount("Directory::forEach", found.load(), entries);
+	}), count);
+
+	report("recursive_directory_iterator, .txt only", measure([&] {
+		size_t found = 0;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(root))
+			if (entry.path().extension() == ".txt")
+				found++;
+		checkCount("recursive_directory_iterator .txt", found, textFiles);
+	}), count);
+	report("Directory::next, .txt only", measure([&] {
+		Files::Directory walk(Strings::StringView(rootPath.c_str()));
+		walk.addExtension(Strings::StringView("txt"));
+		Files::DirectoryEntry entry;
+		size_t found = 0;
+		while (walk.next(entry))
+			found++;
+		checkCount("Directory::next .txt", found, textFiles);
+	}), count);
+
+	report("recursive_directory_iterator, file sizes", measure([&] {
+		uint64_t total = 0;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(root))
+			if (entry.is_regular_file())
+				total += entry.file_size();
+		keep(total);
+	}), count);
+	report("Directory::next, file sizes", measure([&] {
+		Files::DirectoryOptions options;
+		options.stat = true;
+		Files::Directory walk(Strings::StringView(rootPath.c_str()), options);
+		Files::DirectoryEntry entry;
+		uint64_t total = 0;
+		while (walk.next(entry))
+			if (entry.type == Files::EntryType::file)
+				total += entry.size;
+		keep(total);
+	}), count);
+	std::filesystem::remove_all(root);
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "Files/File.h"
+#include <cstring>
+#include <fstream>
+#include <string>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+namespace {
+	/**
+	 * The number of bytes copied at once by the scans that read into a buffer
+	 */
+	constexpr size_t blockSize = static_cast<size_t>(1) << 20;
+
+	/**
+	 * Counts the newlines in some bytes
+	 * @param bytes The bytes
+	 * @param count The number of bytes
+	 * @returns The number of newlines
+	 */
+	size_t countLines(const char* bytes, size_t count) {
+		size_t lines = 0;
+		const char* end = bytes + count;
+		while ((bytes = static_cast<const char*>(std::memchr(bytes, '\n', static_cast<size_t>(end - bytes)))) != nullptr) {
+			lines++;
+			bytes++;
+		}
+		return lines;
+	}
+
+	/**
+	 * Writes a file of 64 byte lines
+	 * @param path The path of the file
+	 * @param bytes The length of the file (rounded down to whole lines)
+	 * @returns The number of lines written
+	 */
+	size_t writeLines(const char* path, size_t bytes) {
+		std::string block;
+		for (size_t i = 0; i < blockSize / 64; i++) {
+			std::string line = "record " + std::to_string(i) + " ";
+			line.resize(63, 'x');
+			block += line + "\n";
+		}
+		Files::File file(path, Files::FileMode::create, Files::FileOptions{false});
+		size_t written = 0;
+		while (written + 64 <= bytes) {
+			size_t count = bytes - written < block.size() ? (bytes - written) / 64 * 64 : block.size();
+			file.write(written, block.data(), count);
+			written += count;
+		}
+		return written / 64;
+	}
+}
+
+/**
+ * Counting the lines of a 4 GB file (at a scale of 1) through a mapped File, an unmapped File read with pread and std::ifstream
+ * The file is written first so it is in the page cache, which measures the cost of each way of getting at the bytes rather
+ * than the disk, rates are in millions of bytes per second
+ */
+ESSENTIALS_BENCHMARK(fileScan) {
+	const char* directory = std::getenv("TMPDIR");
+	std::string path = std::string(directory != nullptr ? directory : "/tmp") + "/essentials-file-benchmark";
+	size_t lines = writeLines(path.c_str(), scaled(static_cast<size_t>(4) << 30));
+	double bytes = static_cast<double>(lines * 64);
+
+	report("File mapped, memchr", measure([&] {
+		Files::File file(path.c_str(), Files::FileMode::read, Files::FileOptions{true, false, false, Files::FileAccess::sequential});
+		size_t found = countLines(file.data(), file.length());
+		keep(found);
+		if (found != lines) std::printf("  mapped scan counted %zu lines, expected %zu\n", found, lines);
+	}), bytes);
+	report("File with pread, 1 MB blocks", measure([&] {
+		Files::File file(path.c_str(), Files::FileMode::read, Files::FileOptions{false, false, false, Files::FileAccess::sequential});
+		DataStructures::ArrayList<char> block;
+		block.resize(blockSize);
+		size_t found = 0, offset = 0, got;
+		while ((got = file.read(offset, block.data(), blockSize)) != 0) {
+			found += countLines(block.data(), got);
+			offset += got;
+		}
+		keep(found);
+		if (found != lines) std::printf("  pread scan counted %zu lines, expected %zu\n", found, lines);
+	}), bytes);
+	report("std::ifstream, 1 MB blocks", measure([&] {
+		std::ifstream stream(path, std::ios::binary);
+		DataStructures::ArrayList<char> block;
+		block.resize(blockSize);
+		size_t found = 0;
+		while (stream.read(block.data(), static_cast<std::streamsize>(blockSize)) || stream.gcount() > 0)
+			found += countLines(block.data(), static_cast<size_t>(stream.gcount()));
+		keep(found);
+		if (found != lines) std::printf("  ifstream scan counted %zu lines, expected %zu\n", found, lines);
+	}), bytes);
+	std::remove(path.c_str());
+}
\ No newline at end of file
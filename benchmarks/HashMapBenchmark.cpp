@@ -0,0 +1,105 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "DataStructures/HashMap.h"
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+namespace {
+	/**
+	 * Makes keys spread evenly over 64 bits
+	 * @param count The number of keys
+	 * @returns The keys
+	 */
+	DataStructures::ArrayList<uint64_t> uniformKeys(size_t count) {
+		DataStructures::ArrayList<uint64_t> keys;
+		uint64_t state = 0x9E3779B97F4A7C15ull;
+		for (size_t i = 0; i < count; i++) {
+			state += 0x9E3779B97F4A7C15ull;
+			uint64_t z = state;
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			keys.push(z ^ (z >> 31));
+		}
+		return keys;
+	}
+
+	/**
+	 * Makes a trace where key k turns up with a probability of about 1/k (a Zipf distribution), so a few keys take most of the operations
+	 * @param count The number of keys in the trace
+	 * @param distinct The number of different keys
+	 * @returns The trace
+	 */
+	DataStructures::ArrayList<uint64_t> skewedKeys(size_t count, size_t distinct) {
+		DataStructures::ArrayList<uint64_t> random = uniformKeys(count);
+		DataStructures::ArrayList<uint64_t> keys;
+		double range = std::log(static_cast<double>(distinct));
+		for (size_t i = 0; i < count; i++) {
+			double unit = static_cast<double>(random[i] >> 11) * 0x1.0p-53;
+			// Spread the ranks over the key space so hot keys don't sit in neighbouring buckets
+			keys.push(static_cast<uint64_t>(std::exp(unit * range)) * 0x9E3779B97F4A7C15ull);
+		}
+		return keys;
+	}
+
+	/**
+	 * Times inserting, finding and counting keys with one map type
+	 * @param name The name of the map type
+	 * @param keys Distinct keys to insert and look up
+	 * @param trace The skewed trace to count occurrences of
+	 */
+	template<typename Map> void run(const char* name, const DataStructures::ArrayList<uint64_t>& keys, const DataStructures::ArrayList<uint64_t>& trace) {
+		char label[64];
+		Map map;
+		std::snprintf(label, sizeof(label), "%s uniform insert", name);
+		report(label, measure([&] {
+			map = Map();
+			for (size_t i = 0; i < keys.length(); i++)
+				map[keys[i]] = i;
+			keep(map);
+		}), static_cast<double>(keys.length()));
+		std::snprintf(label, sizeof(label), "%s uniform lookup", name);
+		report(label, measure([&] {
+			size_t sum = 0;
+			for (size_t i = 0; i < keys.length(); i++)
+				sum += map[keys[i]];
+			keep(sum);
+		}), static_cast<double>(keys.length()));
+		std::snprintf(label, sizeof(label), "%s skewed count", name);
+		report(label, measure([&] {
+			Map counts;
+			for (size_t i = 0; i < trace.length(); i++)
+				counts[trace[i]]++;
+			keep(counts);
+		}), static_cast<double>(trace.length()));
+	}
+}
+
+/**
+ * HashMap against std::unordered_map on uniform keys (insert then lookup) and on a Zipf-skewed trace (counting occurrences)
+ */
+ESSENTIALS_BENCHMARK(hashMap) {
+	size_t count = scaled(1000000);
+	DataStructures::ArrayList<uint64_t> keys = uniformKeys(count);
+	DataStructures::ArrayList<uint64_t> trace = skewedKeys(count * 4, count);
+	run<DataStructures::HashMap<uint64_t, size_t>>("HashMap", keys, trace);
+	run<std::unordered_map<uint64_t, size_t>>("std::unordered_map", keys, trace);
+}
\ No newline at end of file
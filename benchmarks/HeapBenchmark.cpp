@@ -0,0 +1,174 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "DataStructures/Heap.h"
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+namespace {
+	/**
+	 * A small xorshift generator so every container sees the same trace
+	 */
+	struct Trace {
+		/**
+		 * The state of the generator
+		 */
+		uint64_t state = 88172645463325252ull;
+
+		/**
+		 * Gets the next number of the trace
+		 * @returns The number
+		 */
+		uint64_t next() {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return state;
+		}
+	};
+
+	/**
+	 * Fills a priority queue, then alternates a pop with a push for as many operations again, then drains it
+	 * @param count The number of elements to start with
+	 * @param push Adds an element
+	 * @param pop Removes and returns the top element
+	 * @returns The sum of the popped elements
+	 */
+	template<typename Push, typename Pop> uint64_t pushPop(size_t count, Push push, Pop pop) {
+		Trace trace;
+		uint64_t sum = 0;
+		for (size_t i = 0; i < count; i++)
+			push(trace.next() >> 1);
+		for (size_t i = 0; i < count; i++) {
+			uint64_t top = pop();
+			sum += top;
+			push(top + (trace.next() >> 40));
+		}
+		for (size_t i = 0; i < count; i++)
+			sum += pop();
+		return sum;
+	}
+
+	/**
+	 * The number of low bits of a key holding its node, which keeps keys unique so every container pops in the same order
+	 */
+	constexpr unsigned nodeBits = 20;
+}
+
+/**
+ * Heap (4-ary and binary) against std::priority_queue on a push/pop-heavy trace
+ */
+ESSENTIALS_BENCHMARK(heapPushPop) {
+	size_t count = scaled(1000000);
+	report("Heap<4> push/pop", measure([&] {
+		DataStructures::Heap<uint64_t> heap;
+		keep(pushPop(count, [&](uint64_t item) { heap.push(item); }, [&] { return heap.dequeue(); }));
+	}), static_cast<double>(count * 4));
+	report("Heap<2> push/pop", measure([&] {
+		DataStructures::Heap<uint64_t, std::less<uint64_t>, 2> heap;
+		keep(pushPop(count, [&](uint64_t item) { heap.push(item); }, [&] { return heap.dequeue(); }));
+	}), static_cast<double>(count * 4));
+	report("std::priority_queue push/pop", measure([&] {
+		std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> heap;
+		keep(pushPop(count, [&](uint64_t item) { heap.push(item); }, [&] {
+			uint64_t top = heap.top();
+			heap.pop();
+			return top;
+		}));
+	}), static_cast<double>(count * 4));
+}
+
+/**
+ * IndexedHeap::decreaseKey against std::priority_queue with lazy deletion (push a new entry, skip stale ones when popping)
+ * The trace lowers random keys and pops the top after every eighth change, like a shortest path search on a dense graph
+ */
+ESSENTIALS_BENCHMARK(heapDecreaseKey) {
+	size_t nodes = scaled(200000);
+	if (nodes > (size_t(1) << nodeBits)) nodes = size_t(1) << nodeBits;
+	size_t operations = nodes * 8;
+	uint64_t results[2] = {};
+
+	report("IndexedHeap decreaseKey", measure([&] {
+		Trace trace;
+		DataStructures::IndexedHeap<uint64_t> heap;
+		DataStructures::ArrayList<uint64_t> keys;
+		DataStructures::ArrayList<size_t> handles;
+		DataStructures::ArrayList<bool> alive;
+		for (size_t i = 0; i < nodes; i++) {
+			keys.push(((trace.next() >> 24) << nodeBits) | i);
+			handles.push(heap.push(keys[i]));
+			alive.push(true);
+		}
+		uint64_t sum = 0;
+		for (size_t i = 0; i < operations; i++) {
+			size_t node = static_cast<size_t>(trace.next() % nodes);
+			if (alive[node]) {
+				uint64_t value = keys[node] >> nodeBits;
+				keys[node] = ((value - trace.next() % (value + 1)) << nodeBits) | node;
+				heap.decreaseKey(handles[node], keys[node]);
+			}
+			if (i % 8 == 7 && heap.length() > 0) {
+				uint64_t top = heap.dequeue();
+				alive[static_cast<size_t>(top & ((1u << nodeBits) - 1))] = false;
+				sum += top;
+			}
+		}
+		results[0] = sum;
+		keep(sum);
+	}), static_cast<double>(operations));
+
+	report("std::priority_queue lazy decrease", measure([&] {
+		Trace trace;
+		std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> heap;
+		DataStructures::ArrayList<uint64_t> keys;
+		DataStructures::ArrayList<bool> alive;
+		for (size_t i = 0; i < nodes; i++) {
+			keys.push(((trace.next() >> 24) << nodeBits) | i);
+			heap.push(keys[i]);
+			alive.push(true);
+		}
+		uint64_t sum = 0;
+		for (size_t i = 0; i < operations; i++) {
+			size_t node = static_cast<size_t>(trace.next() % nodes);
+			if (alive[node]) {
+				uint64_t value = keys[node] >> nodeBits;
+				keys[node] = ((value - trace.next() % (value + 1)) << nodeBits) | node;
+				heap.push(keys[node]);
+			}
+			if (i % 8 == 7) {
+				while (!heap.empty() && heap.top() != keys[static_cast<size_t>(heap.top() & ((1u << nodeBits) - 1))])
+					heap.pop();
+				if (!heap.empty()) {
+					uint64_t top = heap.top();
+					heap.pop();
+					alive[static_cast<size_t>(top & ((1u << nodeBits) - 1))] = false;
+					sum += top;
+				}
+			}
+		}
+		results[1] = sum;
+		keep(sum);
+	}), static_cast<double>(operations));
+
+	if (results[0] != results[1])
+		std::printf("  traces diverged (%llu != %llu)\n", static_cast<unsigned long long>(results[0]), static_cast<unsigned long long>(results[1]));
+}
\ No newline at end of file
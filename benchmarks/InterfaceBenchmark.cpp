@@ -0,0 +1,73 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "DataStructures/ArrayList.h"
+#include "DataStructures/List.h"
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+namespace {
+	/**
+	 * Hides where a pointer came from, so the compiler cannot devirtualize calls through it
+	 * @param pointer The pointer
+	 * @returns The same pointer
+	 */
+	template<typename T> T* hide(T* pointer) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : "+r"(pointer));
+#endif
+		return pointer;
+	}
+}
+
+/**
+ * Indexed iteration and push on an ArrayList called directly (inlined) and through the List<T> interface (virtual)
+ */
+ESSENTIALS_BENCHMARK(interfaceDispatch) {
+	size_t count = scaled(10000000);
+	DataStructures::ArrayList<int> values;
+	for (size_t i = 0; i < count; i++)
+		values.push(static_cast<int>(i));
+	DataStructures::ListReference<DataStructures::ArrayList<int>> reference(values);
+	DataStructures::List<int>* list = hide(static_cast<DataStructures::List<int>*>(&reference));
+
+	report("static operator[] sum", measure([&] {
+		long long sum = 0;
+		for (size_t i = 0; i < values.length(); i++)
+			sum += values[i];
+		keep(sum);
+	}), static_cast<double>(count));
+	report("virtual operator[] sum", measure([&] {
+		long long sum = 0;
+		for (size_t i = 0; i < list->length(); i++)
+			sum += (*list)[i];
+		keep(sum);
+	}), static_cast<double>(count));
+	report("static push", measure([&] {
+		values.clear();
+		for (size_t i = 0; i < count; i++)
+			values.push(static_cast<int>(i));
+		keep(values.data());
+	}), static_cast<double>(count));
+	report("virtual push", measure([&] {
+		values.clear();
+		for (size_t i = 0; i < count; i++)
+			list->push(static_cast<int>(i));
+		keep(values.data());
+	}), static_cast<double>(count));
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "DataStructures/ArrayList.h"
+#include "DataStructures/LinkedList.h"
+#include <list>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+/**
+ * Repeated inserts in the middle of a list: LinkedList and std::list through an iterator kept near the middle,
+ * LinkedList and ArrayList by index
+ */
+ESSENTIALS_BENCHMARK(linkedListInsert) {
+	size_t count = scaled(100000);
+	report("LinkedList::insert (iterator)", measure([&] {
+		DataStructures::LinkedList<int> list;
+		list.push(0);
+		list.push(1);
+		auto position = ++list.begin();
+		for (size_t i = 0; i < count; i++) {
+			position = list.insert(position, static_cast<int>(i));
+			if (i % 2 == 0) ++position;
+		}
+		keep(list.length());
+	}), static_cast<double>(count));
+	report("std::list::insert (iterator)", measure([&] {
+		std::list<int> list{ 0, 1 };
+		auto position = ++list.begin();
+		for (size_t i = 0; i < count; i++) {
+			position = list.insert(position, static_cast<int>(i));
+			if (i % 2 == 0) ++position;
+		}
+		keep(list.size());
+	}), static_cast<double>(count));
+	report("LinkedList::add (middle index)", measure([&] {
+		DataStructures::LinkedList<int> list;
+		for (size_t i = 0; i < count; i++)
+			list.add(static_cast<int>(i), list.length() / 2);
+		keep(list.length());
+	}), static_cast<double>(count));
+	report("ArrayList::add (middle index)", measure([&] {
+		DataStructures::ArrayList<int> list;
+		for (size_t i = 0; i < count; i++)
+			list.add(static_cast<int>(i), list.length() / 2);
+		keep(list.length());
+	}), static_cast<double>(count));
+}
+
+/**
+ * Iterating over a list built by pushing to the back
+ */
+ESSENTIALS_BENCHMARK(linkedListIterate) {
+	size_t count = scaled(10000000);
+	DataStructures::LinkedList<int> linked;
+	std::list<int> standard;
+	DataStructures::ArrayList<int> array;
+	for (size_t i = 0; i < count; i++) {
+		linked.push(static_cast<int>(i));
+		standard.push_back(static_cast<int>(i));
+		array.push(static_cast<int>(i));
+	}
+	report("LinkedList iterate", measure([&] {
+		long long sum = 0;
+		for (int value : linked)
+			sum += value;
+		keep(sum);
+	}), static_cast<double>(count));
+	report("std::list iterate", measure([&] {
+		long long sum = 0;
+		for (int value : standard)
+			sum += value;
+		keep(sum);
+	}), static_cast<double>(count));
+	report("ArrayList iterate", measure([&] {
+		long long sum = 0;
+		for (size_t i = 0; i < array.length(); i++)
+			sum += array[i];
+		keep(sum);
+	}), static_cast<double>(count));
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include <cstring>
+
+/**
+ * Runs the benchmarks whose name contains any of the arguments (every benchmark when there are none)
+ * Problem sizes are multiplied by the ESSENTIALS_BENCH_SCALE environment variable
+ */
+int main(int argc, char** argv) {
+	Essentials::DataStructures::ArrayList<Essentials::Benchmarks::Benchmark>& benchmarks = Essentials::Benchmarks::registry();
+	for (size_t i = 0; i < benchmarks.length(); i++) {
+		bool selected = argc < 2;
+		for (int j = 1; j < argc && !selected; j++)
+			selected = std::strstr(benchmarks[i].name, argv[j]) != nullptr;
+		if (!selected) continue;
+		std::printf("%s\n", benchmarks[i].name);
+		benchmarks[i].run();
+		std::fflush(stdout);
+	}
+	return 0;
+}
\ No newline at end of file
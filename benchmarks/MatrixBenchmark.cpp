@@ -0,0 +1,103 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "Math/Matrix.h"
+#include <cmath>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+namespace {
+	/**
+	 * Fills a matrix with small pseudo random values
+	 * @param matrix The matrix
+	 */
+	template<typename T> void fill(Math::Matrix<T>& matrix) {
+		uint32_t state = 1;
+		for (size_t i = 0; i < matrix.rows() * matrix.columns(); i++) {
+			state = state * 1664525u + 1013904223u;
+			matrix.data()[i] = static_cast<T>(state >> 8) / static_cast<T>(1 << 24) - T(0.5);
+		}
+	}
+
+	/**
+	 * Times C = A * B for square matrices with gemm and two naive loops (i-j-k dot products and i-k-j row updates)
+	 * @param name The name of the element type
+	 * @param size The number of rows and columns
+	 */
+	template<typename T> void multiply(const char* name, size_t size) {
+		Math::Matrix<T> a(size, size);
+		Math::Matrix<T> b(size, size);
+		Math::Matrix<T> c(size, size);
+		fill(a);
+		fill(b);
+		double flops = 2.0 * static_cast<double>(size) * static_cast<double>(size) * static_cast<double>(size);
+		// The naive loops take seconds on large matrices, so they are only run once there (and i-j-k not at all past 512)
+		size_t repeats = size > 256 ? 1 : 3;
+		char label[64];
+
+		std::snprintf(label, sizeof(label), "gemm %s %zux%zu", name, size, size);
+		report(label, measure([&] {
+			c = a * b;
+			keep(c.data());
+		}), flops);
+		T reference = c(size / 2, size / 3);
+
+		if (size <= 512) {
+			std::snprintf(label, sizeof(label), "naive i-j-k %s %zux%zu", name, size, size);
+			report(label, measure([&] {
+				for (size_t i = 0; i < size; i++)
+					for (size_t j = 0; j < size; j++) {
+						T sum = 0;
+						for (size_t k = 0; k < size; k++)
+							sum += a(i, k) * b(k, j);
+						c(i, j) = sum;
+					}
+				keep(c.data());
+			}, repeats), flops);
+		}
+
+		std::snprintf(label, sizeof(label), "naive i-k-j %s %zux%zu", name, size, size);
+		report(label, measure([&] {
+			for (size_t i = 0; i < size; i++) {
+				for (size_t j = 0; j < size; j++)
+					c(i, j) = 0;
+				for (size_t k = 0; k < size; k++) {
+					T value = a(i, k);
+					for (size_t j = 0; j < size; j++)
+						c(i, j) += value * b(k, j);
+				}
+			}
+			keep(c.data());
+		}, repeats), flops);
+
+		T difference = std::abs(c(size / 2, size / 3) - reference);
+		if (difference > T(1e-2) * (std::abs(reference) + 1))
+			std::printf("  gemm and the naive loops disagree by %g\n", static_cast<double>(difference));
+	}
+}
+
+/**
+ * Matrix multiplication with the blocked gemm against naive triple loops (Mops/s here counts floating point operations, so 1000 is 1 GFLOPS)
+ */
+ESSENTIALS_BENCHMARK(gemm) {
+	size_t sizes[] = { 128, 512, scaled(1024) };
+	for (size_t size : sizes) {
+		multiply<float>("float", size);
+		multiply<double>("double", size);
+	}
+}
\ No newline at end of file
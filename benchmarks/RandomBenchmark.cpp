@@ -0,0 +1,115 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "Math/Random.h"
+#include <random>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+namespace {
+	/**
+	 * Times raw output and the uniform and normal distributions of one of the library's engines
+	 * @param name The name of the engine
+	 * @param count The number of values to draw in each test
+	 */
+	template<typename E> void engine(const char* name, size_t count) {
+		E random(42);
+		char label[64];
+		std::snprintf(label, sizeof(label), "%s next", name);
+		report(label, measure([&] {
+			uint64_t sum = 0;
+			for (size_t i = 0; i < count; i++)
+				sum += random.next();
+			keep(sum);
+		}), static_cast<double>(count));
+		std::snprintf(label, sizeof(label), "%s uniformInt [0, 999]", name);
+		report(label, measure([&] {
+			uint64_t sum = 0;
+			for (size_t i = 0; i < count; i++)
+				sum += Math::uniformInt(random, 0, 999);
+			keep(sum);
+		}), static_cast<double>(count));
+		std::snprintf(label, sizeof(label), "%s uniformDouble", name);
+		report(label, measure([&] {
+			double sum = 0;
+			for (size_t i = 0; i < count; i++)
+				sum += Math::uniformDouble(random);
+			keep(sum);
+		}), static_cast<double>(count));
+		std::snprintf(label, sizeof(label), "%s normal", name);
+		report(label, measure([&] {
+			double sum = 0;
+			for (size_t i = 0; i < count; i++)
+				sum += Math::normal(random);
+			keep(sum);
+		}), static_cast<double>(count));
+	}
+
+	/**
+	 * Times raw output and the standard uniform_int, uniform_real and normal distributions of a standard engine
+	 * @param name The name of the engine
+	 * @param count The number of values to draw in each test
+	 */
+	template<typename E> void standardEngine(const char* name, size_t count) {
+		E random(42);
+		char label[64];
+		std::snprintf(label, sizeof(label), "%s operator()", name);
+		report(label, measure([&] {
+			uint64_t sum = 0;
+			for (size_t i = 0; i < count; i++)
+				sum += random();
+			keep(sum);
+		}), static_cast<double>(count));
+		std::snprintf(label, sizeof(label), "%s uniform_int [0, 999]", name);
+		report(label, measure([&] {
+			std::uniform_int_distribution<int> distribution(0, 999);
+			uint64_t sum = 0;
+			for (size_t i = 0; i < count; i++)
+				sum += distribution(random);
+			keep(sum);
+		}), static_cast<double>(count));
+		std::snprintf(label, sizeof(label), "%s uniform_real", name);
+		report(label, measure([&] {
+			std::uniform_real_distribution<double> distribution;
+			double sum = 0;
+			for (size_t i = 0; i < count; i++)
+				sum += distribution(random);
+			keep(sum);
+		}), static_cast<double>(count));
+		std::snprintf(label, sizeof(label), "%s normal_distribution", name);
+		report(label, measure([&] {
+			std::normal_distribution<double> distribution;
+			double sum = 0;
+			for (size_t i = 0; i < count; i++)
+				sum += distribution(random);
+			keep(sum);
+		}), static_cast<double>(count));
+	}
+}
+
+/**
+ * The library's engines and distributions against std::mt19937 and std::mt19937_64 with the standard distributions
+ */
+ESSENTIALS_BENCHMARK(randomEngines) {
+	size_t count = scaled(10000000);
+	standardEngine<std::mt19937>("mt19937", count);
+	standardEngine<std::mt19937_64>("mt19937_64", count);
+	engine<Math::Xoshiro256>("Xoshiro256", count);
+	engine<Math::Pcg64>("Pcg64", count);
+	engine<Math::Philox>("Philox", count);
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "Files/File.h"
+#include "Files/RecordReader.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+namespace {
+	/**
+	 * Writes a file of log like lines from 20 to about 200 bytes long
+	 * @param path The path of the file
+	 * @param bytes The length of the file (rounded down to whole blocks of lines)
+	 * @param records Set to the number of lines written
+	 * @returns The number of bytes written
+	 */
+	size_t writeRecords(const char* path, size_t bytes, size_t& records) {
+		std::string block;
+		size_t blockRecords = 0;
+		uint32_t state = 1;
+		while (block.size() < (static_cast<size_t>(1) << 20)) {
+			state = state * 1664525 + 1013904223;
+			std::string line = "2024-01-01 12:00:00 INFO request " + std::to_string(blockRecords) + " ";
+			line.resize(20 + (state >> 8) % 180, 'x');
+			block += line + "\n";
+			blockRecords++;
+		}
+		Files::File file(path, Files::FileMode::create, Files::FileOptions{false});
+		size_t written = 0;
+		records = 0;
+		do {
+			file.write(written, block.data(), block.size());
+			written += block.size();
+			records += blockRecords;
+		} while (written + block.size() <= bytes);
+		return written;
+	}
+
+	/**
+	 * Reads every record of a file, adding up their lengths so the records are used
+	 * @param file The file
+	 * @param options The options of the reader
+	 * @param records Set to the number of records read
+	 * @returns The sum of the record lengths
+	 */
+	size_t readAll(Files::File& file, const Files::RecordOptions& options, size_t& records) {
+		Files::RecordReader reader(file, '\n', Files::FileRange(), options);
+		Strings::StringView record;
+		size_t total = 0;
+		records = 0;
+		while (reader.next(record)) {
+			total += record.length();
+			records++;
+		}
+		return total;
+	}
+}
+
+/**
+ * Reading the lines of a 1 GB file (at a scale of 1) through RecordReader over a mapped File, over an unmapped File read
+ * with pread (with and without reading the next chunk ahead) and with std::getline on a std::ifstream
+ * The file is written first so it is in the page cache, rates are in millions of lines per second
+ */
+ESSENTIALS_BENCHMARK(recordReader) {
+	const char* directory = std::getenv("TMPDIR");
+	std::string path = std::string(directory != nullptr ? directory : "/tmp") + "/essentials-record-reader-benchmark";
+	size_t lines;
+	size_t bytes = writeRecords(path.c_str(), scaled(static_cast<size_t>(1) << 30), lines);
+	// Every line is its bytes and a newline
+	size_t expected = bytes - lines;
+	double count = static_cast<double>(lines);
+
+	report("RecordReader, mapped", measure([&] {
+		Files::File file(path.c_str(), Files::FileMode::read, Files::FileOptions{true, false, false, Files::FileAccess::sequential});
+		size_t records;
+		size_t total = readAll(file, Files::RecordOptions(), records);
+		keep(total);
+		if (records != lines || total != expected) std::printf("  mapped reader read %zu lines, expected %zu\n", records, lines);
+	}), count);
+	report("RecordReader, pread with prefetch", measure([&] {
+		Files::File file(path.c_str(), Files::FileMode::read, Files::FileOptions{false, false, false, Files::FileAccess::sequential});
+		size_t records;
+		size_t total = readAll(file, Files::RecordOptions(), records);
+		keep(total);
+		if (records != lines || total != expected) std::printf("  pread reader read %zu lines, expected %zu\n", records, lines);
+	}), count);
+	report("RecordReader, pread without prefetch", measure([&] {
+		Files::File file(path.c_str(), Files::FileMode::read, Files::FileOptions{false, false, false, Files::FileAccess::sequential});
+		Files::RecordOptions options;
+		options.prefetch = false;
+		size_t records;
+		size_t total = readAll(file, options, records);
+		keep(total);
+		if (records != lines || total != expected) std::printf("  pread reader read %zu lines, expected %zu\n", records, lines);
+	}), count);
+	report("std::getline", measure([&] {
+		std::ifstream stream(path, std::ios::binary);
+		std::string line;
+		size_t records = 0, total = 0;
+		while (std::getline(stream, line)) {
+			total += line.size();
+			records++;
+		}
+		keep(total);
+		if (records != lines || total != expected) std::printf("  std::getline read %zu lines, expected %zu\n", records, lines);
+	}), count);
+	std::remove(path.c_str());
+}
\ No newline at end of file
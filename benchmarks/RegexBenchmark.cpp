@@ -0,0 +1,148 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "String/Regex.h"
+#include <regex>
+#include <string>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+namespace {
+	/**
+	 * Makes log lines like "2021-03-05T12:34:56.789Z INFO [worker-12] GET /api/v1/users/42 status=200 latency=35ms"
+	 * @param count The number of lines
+	 * @param text Where to store the lines
+	 * @param lines Set to a view of every line (without the newline)
+	 */
+	void makeLog(size_t count, std::string& text, DataStructures::ArrayList<Strings::StringView>& lines) {
+		static const char* levels[] = { "INFO", "INFO", "INFO", "DEBUG", "WARN", "ERROR" };
+		static const char* methods[] = { "GET", "GET", "POST", "PUT", "DELETE" };
+		static const char* paths[] = { "/api/v1/users/", "/api/v1/orders/", "/static/app.js?v=", "/health", "/api/v2/search?q=" };
+		static const int statuses[] = { 200, 200, 200, 201, 204, 301, 404, 500, 503 };
+		uint32_t state = 12345;
+		auto next = [&] {
+			state = state * 1664525u + 1013904223u;
+			return state >> 8;
+		};
+		DataStructures::ArrayList<size_t> ends;
+		char line[256];
+		for (size_t i = 0; i < count; i++) {
+			int length = std::snprintf(line, sizeof(line), "2021-03-%02uT%02u:%02u:%02u.%03uZ %s [worker-%u] %s %s%u status=%d latency=%ums%s\n",
+				next() % 28 + 1, next() % 24, next() % 60, next() % 60, next() % 1000, levels[next() % 6], next() % 32,
+				methods[next() % 5], paths[next() % 5], next() % 100000, statuses[next() % 9], next() % 2000,
+				next() % 50 == 0 ? " upstream timeout" : "");
+			text.append(line, static_cast<size_t>(length));
+			ends.push(text.length() - 1);
+		}
+		size_t start = 0;
+		for (size_t i = 0; i < ends.length(); i++) {
+			lines.push(Strings::StringView(text.data() + start, ends[i] - start));
+			start = ends[i] + 1;
+		}
+	}
+}
+
+/**
+ * Regex and RegexSet against std::regex (ECMAScript) on generated log lines: counting matching lines for several kinds of
+ * pattern, extracting a field, and checking three patterns at once. Counts that differ between the two are reported.
+ */
+ESSENTIALS_BENCHMARK(regexLogLines) {
+	size_t count = scaled(200000);
+	std::string text;
+	DataStructures::ArrayList<Strings::StringView> lines;
+	makeLog(count, text, lines);
+
+	const char* patterns[] = {
+		"status=5\\d\\d",
+		"^\\d{4}-\\d\\d-\\d\\dT\\d\\d:\\d\\d:\\d\\d\\.\\d+Z ERROR",
+		"ERROR|WARN|timeout",
+		"/api/v\\d/[a-z]+/\\d+ status=4",
+		"latency=\\d{4}ms"
+	};
+	for (const char* pattern : patterns) {
+		Strings::Regex regex(pattern);
+		std::regex standard(pattern);
+		size_t found = 0;
+		size_t standardFound = 0;
+		char label[64];
+		std::snprintf(label, sizeof(label), "Regex::contains %.32s", pattern);
+		report(label, measure([&] {
+			found = 0;
+			for (size_t i = 0; i < lines.length(); i++)
+				found += regex.contains(lines[i]);
+			keep(found);
+		}), static_cast<double>(count));
+		std::snprintf(label, sizeof(label), "std::regex_search %.30s", pattern);
+		report(label, measure([&] {
+			standardFound = 0;
+			for (size_t i = 0; i < lines.length(); i++)
+				standardFound += std::regex_search(lines[i].data(), lines[i].data() + lines[i].length(), standard);
+			keep(standardFound);
+		}, 1), static_cast<double>(count));
+		if (found != standardFound)
+			std::printf("  %s: %zu matching lines, std::regex found %zu\n", pattern, found, standardFound);
+	}
+
+	// Extract the latency field of every line
+	Strings::Regex latency("latency=\\d+");
+	std::regex standardLatency("latency=\\d+");
+	size_t total = 0;
+	size_t standardTotal = 0;
+	report("Regex::find latency=\\d+", measure([&] {
+		total = 0;
+		for (size_t i = 0; i < lines.length(); i++) {
+			Strings::RegexMatch match = latency.find(lines[i]);
+			if (match.found()) total += match.end - match.start;
+		}
+		keep(total);
+	}), static_cast<double>(count));
+	report("std::regex_search + match_results latency=\\d+", measure([&] {
+		standardTotal = 0;
+		std::cmatch match;
+		for (size_t i = 0; i < lines.length(); i++)
+			if (std::regex_search(lines[i].data(), lines[i].data() + lines[i].length(), match, standardLatency))
+				standardTotal += static_cast<size_t>(match.length(0));
+		keep(standardTotal);
+	}, 1), static_cast<double>(count));
+	if (total != standardTotal)
+		std::printf("  latency: %zu matched characters, std::regex matched %zu\n", total, standardTotal);
+
+	// Which of three patterns each line matches, in one pass against one search per pattern
+	Strings::RegexSet set;
+	std::regex standardSet[3] = { std::regex(patterns[0]), std::regex(patterns[2]), std::regex(patterns[4]) };
+	set.add(patterns[0]);
+	set.add(patterns[2]);
+	set.add(patterns[4]);
+	size_t hits = 0;
+	size_t standardHits = 0;
+	report("RegexSet::matches (3 patterns)", measure([&] {
+		hits = 0;
+		for (size_t i = 0; i < lines.length(); i++)
+			hits += set.matches(lines[i]).length();
+		keep(hits);
+	}), static_cast<double>(count));
+	report("std::regex_search x3", measure([&] {
+		standardHits = 0;
+		for (size_t i = 0; i < lines.length(); i++)
+			for (const std::regex& regex : standardSet)
+				standardHits += std::regex_search(lines[i].data(), lines[i].data() + lines[i].length(), regex);
+		keep(standardHits);
+	}, 1), static_cast<double>(count));
+	if (hits != standardHits)
+		std::printf("  set: %zu pattern matches, std::regex found %zu\n", hits, standardHits);
+}
\ No newline at end of file
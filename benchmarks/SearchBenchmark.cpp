@@ -0,0 +1,88 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "DataStructures/Search.h"
+#include <cstdint>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+namespace {
+	/**
+	 * Finds an item one element at a time (compilers do not vectorize loops that exit early)
+	 * @param data The elements to search
+	 * @param count The number of elements to search
+	 * @param item The item to search for
+	 * @returns The index of the first match (count if not found)
+	 */
+	template<typename T> size_t scalarFind(const T* data, size_t count, const T& item) {
+		for (size_t i = 0; i < count; i++) {
+			if (item == data[i]) return i;
+		}
+		return count;
+	}
+
+	/**
+	 * Times full scans of a range which only holds the item in its last element, with each search kernel
+	 * @param name The element type
+	 * @param count The number of elements in the range
+	 */
+	template<typename T> void scanType(const char* name, size_t count) {
+		DataStructures::ArrayList<T> values;
+		for (size_t i = 0; i < count; i++)
+			values.push(static_cast<T>(i % 100));
+		values[count - 1] = static_cast<T>(101);
+		T item = static_cast<T>(101);
+		size_t scans = scaled(static_cast<size_t>(1) << 28) / count;
+		double elements = static_cast<double>(scans * count);
+		char label[64];
+
+		auto time = [&](const char* kernel, size_t (*find)(const T*, size_t, const T&)) {
+			std::snprintf(label, sizeof(label), "%s %s", name, kernel);
+			report(label, measure([&] {
+				size_t found = 0;
+				for (size_t i = 0; i < scans; i++) {
+					keep(values.data());
+					found += find(values.data(), count, item);
+				}
+				keep(found);
+			}), elements);
+		};
+		time("scalar loop", &scalarFind<T>);
+		time("findFirst", &DataStructures::findFirst<T>);
+#ifdef ESSENTIALS_SEARCH_SSE2
+		time("SSE2", &DataStructures::findFirstSse2<T>);
+#endif
+#ifdef ESSENTIALS_SEARCH_AVX2
+		if (DataStructures::cpuSupportsAvx2())
+			time("AVX2", &DataStructures::findFirstAvx2<T>);
+#endif
+	}
+}
+
+/**
+ * Scanning a range which stays in L1 (16 KB) for an item in its last element, with the scalar loop and the vector kernels
+ * Rates are in millions of elements per second
+ */
+ESSENTIALS_BENCHMARK(search) {
+	scanType<char>("char", 16384);
+	scanType<int16_t>("int16_t", 8192);
+	scanType<int32_t>("int32_t", 4096);
+	scanType<float>("float", 4096);
+	scanType<int64_t>("int64_t", 2048);
+	scanType<double>("double", 2048);
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "DataStructures/Allocator.h"
+#include "DataStructures/ArrayList.h"
+#include <vector>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+namespace {
+	/**
+	 * Builds many short lists (0 to 8 elements) side by side, then frees them, counting the allocator calls
+	 * @param label What is measured
+	 * @param count The number of lists
+	 */
+	template<typename L> void shortLists(const char* label, size_t count) {
+		DataStructures::AllocationCounts counts;
+		double seconds = measure([&] {
+			counts = DataStructures::AllocationCounts();
+			DataStructures::CountingAllocator<> allocator(counts);
+			std::vector<L> lists;
+			lists.reserve(count);
+			for (size_t i = 0; i < count; i++) {
+				L& list = lists.emplace_back(allocator);
+				for (size_t j = 0; j < i % 9; j++)
+					list.push(static_cast<int>(j));
+			}
+			keep(lists.data());
+		});
+		report(label, seconds, static_cast<double>(count));
+		std::printf("  %-48s %10.2f allocs/list %8zu KB peak\n", "", static_cast<double>(counts.allocations + counts.reallocations) / static_cast<double>(count), counts.peakBytes / 1024);
+	}
+}
+
+/**
+ * Allocator calls made by ArrayList with and without inline capacity for lists of 0 to 8 elements, with std::vector's time for reference
+ */
+ESSENTIALS_BENCHMARK(smallArrayList) {
+	size_t count = scaled(1000000);
+	shortLists<DataStructures::ArrayList<int, DataStructures::CountingAllocator<>>>("ArrayList<int>", count);
+	shortLists<DataStructures::SmallArrayList<int, 4, DataStructures::CountingAllocator<>>>("SmallArrayList<int, 4>", count);
+	shortLists<DataStructures::SmallArrayList<int, 8, DataStructures::CountingAllocator<>>>("SmallArrayList<int, 8>", count);
+	report("std::vector<int>", measure([&] {
+		std::vector<std::vector<int>> lists;
+		lists.reserve(count);
+		for (size_t i = 0; i < count; i++) {
+			std::vector<int>& list = lists.emplace_back();
+			for (size_t j = 0; j < i % 9; j++)
+				list.push_back(static_cast<int>(j));
+		}
+		keep(lists.data());
+	}), static_cast<double>(count));
+}
\ No newline at end of file
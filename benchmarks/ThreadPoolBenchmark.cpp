@@ -0,0 +1,81 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Benchmark.h"
+#include "Threading/Parallel.h"
+#include <algorithm>
+#include <thread>
+
+using namespace Essentials;
+using namespace Essentials::Benchmarks;
+
+/**
+ * Scaling of the parallel algorithms from 1 worker to one per hardware thread (doubling, plus the hardware thread count itself), with sequential loops as the baseline
+ */
+ESSENTIALS_BENCHMARK(threadPoolScaling) {
+	size_t count = scaled(20000000);
+	size_t sortCount = count / 5 > 0 ? count / 5 : 1;
+	DataStructures::ArrayList<int> values;
+	uint32_t state = 12345;
+	for (size_t i = 0; i < count; i++) {
+		state = state * 1664525u + 1013904223u;
+		values.push(static_cast<int>(state >> 8));
+	}
+	DataStructures::ArrayList<int> unsorted;
+	for (size_t i = 0; i < sortCount; i++)
+		unsorted.push(values[i]);
+	DataStructures::ArrayList<int> sorting;
+
+	report("sequential sum", measure([&] {
+		long long sum = 0;
+		for (size_t i = 0; i < values.length(); i++)
+			sum += values[i];
+		keep(sum);
+	}), static_cast<double>(count));
+	report("sequential contains (miss)", measure([&] {
+		keep(std::find(values.data(), values.data() + count, -1) != values.data() + count);
+	}), static_cast<double>(count));
+	report("std::sort", measure([&] {
+		sorting = unsorted;
+		std::sort(sorting.data(), sorting.data() + sortCount);
+		keep(sorting.data());
+	}), static_cast<double>(sortCount));
+
+	size_t hardware = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+	DataStructures::ArrayList<size_t> counts;
+	for (size_t threads = 1; threads < hardware; threads *= 2)
+		counts.push(threads);
+	counts.push(hardware);
+
+	for (size_t c = 0; c < counts.length(); c++) {
+		Threading::ThreadPool pool(counts[c]);
+		char label[64];
+		std::snprintf(label, sizeof(label), "parallelReduce sum, %zu thread%s", counts[c], counts[c] == 1 ? "" : "s");
+		report(label, measure([&] {
+			keep(Threading::parallelReduce(values, 0ll, std::plus<>(), pool));
+		}), static_cast<double>(count));
+		std::snprintf(label, sizeof(label), "parallelContains (miss), %zu thread%s", counts[c], counts[c] == 1 ? "" : "s");
+		report(label, measure([&] {
+			keep(Threading::parallelContains(values, -1, pool));
+		}), static_cast<double>(count));
+		std::snprintf(label, sizeof(label), "parallelSort, %zu thread%s", counts[c], counts[c] == 1 ? "" : "s");
+		report(label, measure([&] {
+			sorting = unsorted;
+			Threading::parallelSort(sorting, std::less<>(), pool);
+			keep(sorting.data());
+		}), static_cast<double>(sortCount));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,659 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <assert.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+/**
+ * The main namespace for data structures in the essentials library
+ */
+namespace Essentials::DataStructures {
+
+	/**
+	 * A namespace alias to the data structures namespace
+	 */
+	namespace ds = DataStructures;
+
+	/**
+	 * The default allocator for containers, backed by the global heap
+	 *
+	 * Every allocator used by a container must provide allocate, deallocate and reallocate with these signatures.
+	 * Allocators are cheap copyable handles, a container keeps its own copy for its whole lifetime.
+	 */
+	class HeapAllocator {
+	public:
+		/**
+		 * Allocates uninitialized memory
+		 * @param bytes The number of bytes to allocate
+		 * @param alignment The alignment of the memory
+		 * @returns The allocated memory
+		 */
+		void* allocate(size_t bytes, size_t alignment) {
+			if (alignment <= alignof(std::max_align_t)) {
+				void* block = std::malloc(bytes);
+				if (block == nullptr) throw std::bad_alloc();
+				return block;
+			}
+			return ::operator new(bytes, std::align_val_t(alignment));
+		}
+
+		/**
+		 * Frees memory allocated with allocate
+		 * @param block The memory to free
+		 * @param bytes The number of bytes the memory was allocated with
+		 * @param alignment The alignment the memory was allocated with
+		 */
+		void deallocate(void* block, size_t bytes, size_t alignment) {
+			(void)bytes;
+			if (alignment <= alignof(std::max_align_t))
+				std::free(block);
+			else
+				::operator delete(block, std::align_val_t(alignment));
+		}
+
+		/**
+		 * Resizes memory allocated with allocate, the contents are copied bytewise if it has to move
+		 * @param block The memory to resize
+		 * @param oldBytes The number of bytes the memory was allocated with
+		 * @param newBytes The new number of bytes
+		 * @param alignment The alignment the memory was allocated with
+		 * @returns The resized memory
+		 */
+		void* reallocate(void* block, size_t oldBytes, size_t newBytes, size_t alignment) {
+			if (alignment <= alignof(std::max_align_t)) {
+				void* newBlock = std::realloc(block, newBytes);
+				if (newBlock == nullptr) throw std::bad_alloc();
+				return newBlock;
+			}
+			void* newBlock = allocate(newBytes, alignment);
+			std::memcpy(newBlock, block, oldBytes < newBytes ? oldBytes : newBytes);
+			deallocate(block, oldBytes, alignment);
+			return newBlock;
+		}
+	};
+
+	/**
+	 * A bump allocator which hands out memory from large blocks and frees everything at once with reset
+	 * Individual frees are ignored (except for the most recent allocation), not thread safe
+	 */
+	class Arena {
+	private:
+		/**
+		 * The header of every block owned by the arena
+		 */
+		struct Block {
+			/**
+			 * The previously allocated block
+			 */
+			Block* previous;
+
+			/**
+			 * The size of the block in bytes (including this header)
+			 */
+			size_t size;
+		};
+
+		/**
+		 * The most recently allocated block
+		 */
+		Block* current = nullptr;
+
+		/**
+		 * The next free byte of the current block
+		 */
+		char* cursor = nullptr;
+
+		/**
+		 * The end of the current block
+		 */
+		char* end = nullptr;
+
+		/**
+		 * The start of the most recent allocation
+		 */
+		char* last = nullptr;
+
+		/**
+		 * The default size of a new block
+		 */
+		size_t blockSize;
+
+		/**
+		 * The number of bytes handed out since the last reset
+		 */
+		size_t used = 0;
+
+		/**
+		 * Allocates a new block large enough for an allocation
+		 * @param bytes The size of the allocation which didn't fit
+		 * @param alignment The alignment of the allocation which didn't fit
+		 */
+		void addBlock(size_t bytes, size_t alignment) {
+			size_t size = blockSize;
+			size_t needed = sizeof(Block) + bytes + alignment;
+			if (size < needed)
+				size = needed;
+
+			Block* block = static_cast<Block*>(std::malloc(size));
+			if (block == nullptr) throw std::bad_alloc();
+			block->previous = current;
+			block->size = size;
+			current = block;
+			cursor = reinterpret_cast<char*>(block) + sizeof(Block);
+			end = reinterpret_cast<char*>(block) + size;
+			last = nullptr;
+		}
+
+		/**
+		 * Frees every block older than the current one
+		 */
+		void freePrevious() {
+			Block* block = current->previous;
+			while (block != nullptr) {
+				Block* previous = block->previous;
+				std::free(block);
+				block = previous;
+			}
+			current->previous = nullptr;
+		}
+
+	public:
+		/**
+		 * Creates a new arena, no memory is allocated until the first allocation
+		 * @param blockSize The number of bytes to request from the heap at a time
+		 */
+		Arena(size_t blockSize = 64 * 1024) : blockSize(blockSize) {}
+
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		/**
+		 * Frees all memory owned by the arena
+		 */
+		~Arena() {
+			if (current == nullptr) return;
+			freePrevious();
+			std::free(current);
+		}
+
+		/**
+		 * Allocates uninitialized memory from the arena
+		 * @param bytes The number of bytes to allocate
+		 * @param alignment The alignment of the memory (must be a power of two)
+		 * @returns The allocated memory
+		 */
+		void* allocate(size_t bytes, size_t alignment) {
+			uintptr_t address = (reinterpret_cast<uintptr_t>(cursor) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+			if (current == nullptr || address + bytes > reinterpret_cast<uintptr_t>(end)) {
+				addBlock(bytes, alignment);
+				address = (reinterpret_cast<uintptr_t>(cursor) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+			}
+			last = reinterpret_cast<char*>(address);
+			cursor = last + bytes;
+			used += bytes;
+			return last;
+		}
+
+		/**
+		 * Frees memory from the arena, only the most recent allocation is actually reclaimed
+		 * @param block The memory to free
+		 * @param bytes The number of bytes the memory was allocated with
+		 */
+		void deallocate(void* block, size_t bytes) {
+			if (block != nullptr && block == last) {
+				cursor = last;
+				last = nullptr;
+				used -= bytes;
+			}
+		}
+
+		/**
+		 * Resizes memory from the arena, growing in place when it is the most recent allocation
+		 * @param block The memory to resize
+		 * @param oldBytes The number of bytes the memory was allocated with
+		 * @param newBytes The new number of bytes
+		 * @param alignment The alignment the memory was allocated with
+		 * @returns The resized memory
+		 */
+		void* reallocate(void* block, size_t oldBytes, size_t newBytes, size_t alignment) {
+			if (block != nullptr && block == last && last + newBytes <= end) {
+				cursor = last + newBytes;
+				used = used - oldBytes + newBytes;
+				return block;
+			}
+			void* newBlock = allocate(newBytes, alignment);
+			if (block != nullptr)
+				std::memcpy(newBlock, block, oldBytes < newBytes ? oldBytes : newBytes);
+			return newBlock;
+		}
+
+		/**
+		 * Frees every allocation made from the arena at once
+		 * The most recent block is kept for reuse, anything still using arena memory must not be touched afterwards
+		 */
+		void reset() {
+			if (current == nullptr) return;
+			freePrevious();
+			cursor = reinterpret_cast<char*>(current) + sizeof(Block);
+			last = nullptr;
+			used = 0;
+		}
+
+		/**
+		 * Returns the number of bytes handed out since the last reset
+		 * @returns The number of bytes in use
+		 */
+		inline size_t bytesUsed() const {
+			return used;
+		}
+	};
+
+	/**
+	 * A container allocator handle which allocates from an Arena
+	 */
+	class ArenaAllocator {
+	private:
+		/**
+		 * The arena to allocate from
+		 */
+		Arena* arena;
+
+	public:
+		/**
+		 * Creates a handle to an arena, the arena must outlive every container using it
+		 * @param arena The arena to allocate from
+		 */
+		ArenaAllocator(Arena& arena) : arena(&arena) {}
+
+		/**
+		 * Allocates uninitialized memory
+		 * @param bytes The number of bytes to allocate
+		 * @param alignment The alignment of the memory
+		 * @returns The allocated memory
+		 */
+		void* allocate(size_t bytes, size_t alignment) {
+			return arena->allocate(bytes, alignment);
+		}
+
+		/**
+		 * Frees memory allocated with allocate
+		 * @param block The memory to free
+		 * @param bytes The number of bytes the memory was allocated with
+		 * @param alignment The alignment the memory was allocated with
+		 */
+		void deallocate(void* block, size_t bytes, size_t alignment) {
+			(void)alignment;
+			arena->deallocate(block, bytes);
+		}
+
+		/**
+		 * Resizes memory allocated with allocate, the contents are copied bytewise if it has to move
+		 * @param block The memory to resize
+		 * @param oldBytes The number of bytes the memory was allocated with
+		 * @param newBytes The new number of bytes
+		 * @param alignment The alignment the memory was allocated with
+		 * @returns The resized memory
+		 */
+		void* reallocate(void* block, size_t oldBytes, size_t newBytes, size_t alignment) {
+			return arena->reallocate(block, oldBytes, newBytes, alignment);
+		}
+	};
+
+	/**
+	 * A free list allocator for fixed size blocks, memory is requested from the heap in chunks of blocks
+	 * Not thread safe
+	 */
+	class Pool {
+	private:
+		/**
+		 * A free block, stored inside the block's own memory
+		 */
+		struct FreeBlock {
+			/**
+			 * The next free block
+			 */
+			FreeBlock* next;
+		};
+
+		/**
+		 * The header of every chunk of blocks
+		 */
+		struct Chunk {
+			/**
+			 * The previously allocated chunk
+			 */
+			Chunk* previous;
+		};
+
+		/**
+		 * The size of each block in bytes
+		 */
+		size_t blockSize;
+
+		/**
+		 * The alignment of each block
+		 */
+		size_t blockAlignment;
+
+		/**
+		 * The number of blocks allocated in each chunk
+		 */
+		size_t blocksPerChunk;
+
+		/**
+		 * The first free block
+		 */
+		FreeBlock* freeList = nullptr;
+
+		/**
+		 * The most recently allocated chunk
+		 */
+		Chunk* chunks = nullptr;
+
+		/**
+		 * The offset of the first block from the start of a chunk
+		 */
+		size_t headerSize() const {
+			return (sizeof(Chunk) + blockAlignment - 1) & ~(blockAlignment - 1);
+		}
+
+		/**
+		 * Allocates a new chunk and threads all of its blocks onto the free list
+		 */
+		void addChunk() {
+			void* memory = ::operator new(headerSize() + blockSize * blocksPerChunk, std::align_val_t(blockAlignment));
+			Chunk* chunk = static_cast<Chunk*>(memory);
+			chunk->previous = chunks;
+			chunks = chunk;
+
+			char* first = static_cast<char*>(memory) + headerSize();
+			for (size_t i = blocksPerChunk; i > 0; i--) {
+				FreeBlock* block = reinterpret_cast<FreeBlock*>(first + (i - 1) * blockSize);
+				block->next = freeList;
+				freeList = block;
+			}
+		}
+
+		/**
+		 * Frees every chunk
+		 */
+		void freeChunks() {
+			while (chunks != nullptr) {
+				Chunk* previous = chunks->previous;
+				::operator delete(chunks, std::align_val_t(blockAlignment));
+				chunks = previous;
+			}
+			freeList = nullptr;
+		}
+
+	public:
+		/**
+		 * Creates a new pool, no memory is allocated until the first allocation
+		 * @param blockSize The size of every block in bytes
+		 * @param blocksPerChunk The number of blocks to request from the heap at a time
+		 * @param blockAlignment The alignment of every block (must be a power of two)
+		 */
+		Pool(size_t blockSize, size_t blocksPerChunk = 64, size_t blockAlignment = alignof(std::max_align_t)) :
+			blockSize(blockSize), blockAlignment(blockAlignment), blocksPerChunk(blocksPerChunk) {
+			if (this->blockAlignment < alignof(FreeBlock))
+				this->blockAlignment = alignof(FreeBlock);
+			if (this->blockSize < sizeof(FreeBlock))
+				this->blockSize = sizeof(FreeBlock);
+			this->blockSize = (this->blockSize + this->blockAlignment - 1) & ~(this->blockAlignment - 1);
+		}
+
+		Pool(const Pool&) = delete;
+		Pool& operator=(const Pool&) = delete;
+
+		/**
+		 * Frees all memory owned by the pool
+		 */
+		~Pool() {
+			freeChunks();
+		}
+
+		/**
+		 * Takes a block from the pool
+		 * @returns An uninitialized block of blockSize bytes
+		 */
+		void* allocate() {
+			if (freeList == nullptr)
+				addChunk();
+			FreeBlock* block = freeList;
+			freeList = block->next;
+			return block;
+		}
+
+		/**
+		 * Returns a block to the pool
+		 * @param block The block to return
+		 */
+		void deallocate(void* block) {
+			FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+			freeBlock->next = freeList;
+			freeList = freeBlock;
+		}
+
+		/**
+		 * Frees every block at once, anything still using pool memory must not be touched afterwards
+		 */
+		void reset() {
+			freeChunks();
+		}
+
+		/**
+		 * Returns the size of the blocks handed out by the pool
+		 * @returns The block size in bytes
+		 */
+		inline size_t size() const {
+			return blockSize;
+		}
+
+		/**
+		 * Returns the alignment of the blocks handed out by the pool
+		 * @returns The block alignment in bytes
+		 */
+		inline size_t alignment() const {
+			return blockAlignment;
+		}
+	};
+
+	/**
+	 * A container allocator handle which allocates from a Pool
+	 * Requests which do not fit in a pool block fall back to the heap
+	 */
+	class PoolAllocator {
+	private:
+		/**
+		 * The pool to allocate from
+		 */
+		Pool* pool;
+
+		/**
+		 * Checks if an allocation is served by the pool
+		 * @param bytes The size of the allocation
+		 * @param alignment The alignment of the allocation
+		 * @returns Whether or not the allocation fits in a pool block
+		 */
+		bool fits(size_t bytes, size_t alignment) const {
+			return bytes <= pool->size() && alignment <= pool->alignment();
+		}
+
+	public:
+		/**
+		 * Creates a handle to a pool, the pool must outlive every container using it
+		 * @param pool The pool to allocate from
+		 */
+		PoolAllocator(Pool& pool) : pool(&pool) {}
+
+		/**
+		 * Allocates uninitialized memory
+		 * @param bytes The number of bytes to allocate
+		 * @param alignment The alignment of the memory
+		 * @returns The allocated memory
+		 */
+		void* allocate(size_t bytes, size_t alignment) {
+			if (fits(bytes, alignment))
+				return pool->allocate();
+			return HeapAllocator().allocate(bytes, alignment);
+		}
+
+		/**
+		 * Frees memory allocated with allocate
+		 * @param block The memory to free
+		 * @param bytes The number of bytes the memory was allocated with
+		 * @param alignment The alignment the memory was allocated with
+		 */
+		void deallocate(void* block, size_t bytes, size_t alignment) {
+			if (fits(bytes, alignment))
+				pool->deallocate(block);
+			else
+				HeapAllocator().deallocate(block, bytes, alignment);
+		}
+
+		/**
+		 * Resizes memory allocated with allocate, the contents are copied bytewise if it has to move
+		 * @param block The memory to resize
+		 * @param oldBytes The number of bytes the memory was allocated with
+		 * @param newBytes The new number of bytes
+		 * @param alignment The alignment the memory was allocated with
+		 * @returns The resized memory
+		 */
+		void* reallocate(void* block, size_t oldBytes, size_t newBytes, size_t alignment) {
+			if (fits(oldBytes, alignment) && fits(newBytes, alignment))
+				return block;
+			if (!fits(oldBytes, alignment) && !fits(newBytes, alignment))
+				return HeapAllocator().reallocate(block, oldBytes, newBytes, alignment);
+			void* newBlock = allocate(newBytes, alignment);
+			std::memcpy(newBlock, block, oldBytes < newBytes ? oldBytes : newBytes);
+			deallocate(block, oldBytes, alignment);
+			return newBlock;
+		}
+	};
+
+	/**
+	 * The allocation statistics collected by CountingAllocator handles
+	 */
+	struct AllocationCounts {
+		/**
+		 * The number of calls to allocate
+		 */
+		size_t allocations = 0;
+
+		/**
+		 * The number of calls to deallocate
+		 */
+		size_t deallocations = 0;
+
+		/**
+		 * The number of calls to reallocate
+		 */
+		size_t reallocations = 0;
+
+		/**
+		 * The number of bytes currently allocated
+		 */
+		size_t bytes = 0;
+
+		/**
+		 * The largest number of bytes allocated at once
+		 */
+		size_t peakBytes = 0;
+	};
+
+	/**
+	 * A container allocator handle which records every request in an AllocationCounts before passing it on
+	 * Used to measure how often containers reach the allocator, not thread safe
+	 * @tparam Allocator The allocator the requests are passed to
+	 */
+	template<typename Allocator = HeapAllocator> class CountingAllocator : private Allocator {
+	private:
+		/**
+		 * The statistics to record in
+		 */
+		AllocationCounts* counts;
+
+		/**
+		 * Records a change in the number of bytes allocated
+		 * @param added The number of bytes allocated
+		 * @param removed The number of bytes freed
+		 */
+		void track(size_t added, size_t removed) {
+			counts->bytes = counts->bytes + added - removed;
+			if (counts->bytes > counts->peakBytes)
+				counts->peakBytes = counts->bytes;
+		}
+
+	public:
+		/**
+		 * Creates a handle which records in counts, the counts must outlive every container using it
+		 * @param counts The statistics to record in
+		 * @param allocator The allocator to pass the requests to
+		 */
+		CountingAllocator(AllocationCounts& counts, const Allocator& allocator = Allocator()) : Allocator(allocator), counts(&counts) {}
+
+		/**
+		 * Allocates uninitialized memory
+		 * @param bytes The number of bytes to allocate
+		 * @param alignment The alignment of the memory
+		 * @returns The allocated memory
+		 */
+		void* allocate(size_t bytes, size_t alignment) {
+			void* block = Allocator::allocate(bytes, alignment);
+			counts->allocations++;
+			track(bytes, 0);
+			return block;
+		}
+
+		/**
+		 * Frees memory allocated with allocate
+		 * @param block The memory to free
+		 * @param bytes The number of bytes the memory was allocated with
+		 * @param alignment The alignment the memory was allocated with
+		 */
+		void deallocate(void* block, size_t bytes, size_t alignment) {
+			Allocator::deallocate(block, bytes, alignment);
+			counts->deallocations++;
+			track(0, bytes);
+		}
+
+		/**
+		 * Resizes memory allocated with allocate
+		 * @param block The memory to resize
+		 * @param oldBytes The number of bytes the memory was allocated with
+		 * @param newBytes The new number of bytes
+		 * @param alignment The alignment the memory was allocated with
+		 * @returns The resized memory
+		 */
+		void* reallocate(void* block, size_t oldBytes, size_t newBytes, size_t alignment) {
+			void* newBlock = Allocator::reallocate(block, oldBytes, newBytes, alignment);
+			counts->reallocations++;
+			track(newBytes, oldBytes);
+			return newBlock;
+		}
+	};
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include "Search.h"
+#include "Iterator.h"
 #include <assert.h>
 
 /**
@@ -67,6 +69,38 @@ namespace Essentials::DataStructures {
 			return L;
 		}
 
+		/**
+		 * Gets an iterator at the first element
+		 * @returns The iterator
+		 */
+		Iterator<T> begin() {
+			return Iterator<T>(data);
+		}
+
+		/**
+		 * Gets an iterator past the last element
+		 * @returns The iterator
+		 */
+		Iterator<T> end() {
+			return Iterator<T>(data + L);
+		}
+
+		/**
+		 * Gets an iterator at the first element
+		 * @returns The iterator
+		 */
+		Iterator<const T> begin() const {
+			return Iterator<const T>(data);
+		}
+
+		/**
+		 * Gets an iterator past the last element
+		 * @returns The iterator
+		 */
+		Iterator<const T> end() const {
+			return Iterator<const T>(data + L);
+		}
+
 		/**
 		 * Checks if an index is valid for the list
 		 * @param index The index to check
@@ -82,10 +116,7 @@ namespace Essentials::DataStructures {
 		 * @returns Whether or not the list contains the element
 		 */
 		bool contains(const T& item) const {
-			for (size_t i = 0; i < L; i++) {
-				if (item == data[i]) return true;
-			}
-			return false;
+			return findFirst(data, L, item) != L;
 		}
 
 		/**
@@ -94,10 +125,8 @@ namespace Essentials::DataStructures {
 		 * @returns The index of the element (-1 if not found)
 		 */
 		int indexOf(const T& item) const {
-			for (size_t i = 0; i < L; i++) {
-				if (item == data[i]) return static_cast<int>(i);
-			}
-			return -1;
+			size_t i = findFirst(data, L, item);
+			return i == L ? -1 : static_cast<int>(i);
 		}
 
 		/**
@@ -106,10 +135,8 @@ namespace Essentials::DataStructures {
 		 * @returns The index of the element (-1 if not found)
 		 */
 		int lastIndexOf(const T& item) const {
-			for (size_t i = L - 1; i >= 0; i--) {
-				if (item == data[i]) return static_cast<int>(i);
-			}
-			return -1;
+			size_t i = findLast(data, L, item);
+			return i == L ? -1 : static_cast<int>(i);
 		}
 	};
 }
@@ -17,7 +17,13 @@
 #pragma once
 
 #include "List.h"
+#include "Memory.h"
+#include "Allocator.h"
+#include "Search.h"
+#include "Iterator.h"
 #include <assert.h>
+#include <iterator>
+#include <memory>
 
 /**
  * The main namespace for data structures in the essentials library
@@ -29,15 +35,55 @@ namespace Essentials::DataStructures {
 	 */
 	namespace ds = DataStructures;
 
+	/**
+	 * Uninitialized storage for the elements a list keeps inside itself before it allocates
+	 * @tparam N The number of elements the storage holds
+	 */
+	template<typename T, size_t N> class InlineStorage {
+	private:
+		/**
+		 * The storage of the elements
+		 */
+		alignas(T) unsigned char storage[N * sizeof(T)];
+
+	protected:
+		/**
+		 * Gets the inline element slots
+		 * @returns The first slot
+		 */
+		T* inlineSlots() {
+			return reinterpret_cast<T*>(storage);
+		}
+	};
+
+	/**
+	 * Inline storage for lists without any inline capacity (takes no space)
+	 */
+	template<typename T> class InlineStorage<T, 0> {
+	protected:
+		/**
+		 * Gets the inline element slots
+		 * @returns nullptr, as there are none
+		 */
+		T* inlineSlots() {
+			return nullptr;
+		}
+	};
+
 	/**
 	 * An array based heap storage list implementation
+	 * Only the first length() slots of the storage are ever constructed
+	 * Satisfies the List<T> contract statically, wrap it in a ListReference for runtime polymorphism
+	 * @tparam Allocator The allocator the storage is requested from (see HeapAllocator), stored as a base so empty allocators take no space
+	 * @tparam InlineCapacity The number of elements stored inside the list itself before anything is allocated (see SmallArrayList)
 	 */
-	template<typename T> class ArrayList : public List<T> {
+	template<typename T, typename Allocator = HeapAllocator, size_t InlineCapacity = 0> class ArrayList : private Allocator, private InlineStorage<T, InlineCapacity> {
 	private:
+
 		/**
-		 * The data of the array list
+		 * The data of the array list (the inline slots until it outgrows them)
 		 */
-		T* data = nullptr;
+		T* buffer = this->inlineSlots();
 
 		/**
 		 * The length of the array list
@@ -47,54 +93,190 @@ namespace Essentials::DataStructures {
 		/**
 		 * The capacity of the array list
 		 */
-		size_t cap = 0;
-	
+		size_t cap = InlineCapacity;
+
+		/**
+		 * Returns the allocator the storage is requested from
+		 * @returns The allocator of the list
+		 */
+		Allocator& allocator() {
+			return *this;
+		}
+
+		/**
+		 * Checks if the elements are stored in the inline slots
+		 * @returns Whether or not the list has no heap storage
+		 */
+		inline bool isInline() const {
+			return InlineCapacity > 0 && cap == InlineCapacity;
+		}
+
+		/**
+		 * Frees the storage (does not destroy any elements)
+		 */
+		void freeStorage() {
+			if (buffer != nullptr && !isInline())
+				allocator().deallocate(buffer, cap * sizeof(T), alignof(T));
+		}
+
+		/**
+		 * Takes the elements of another list whose storage belongs to neither list yet, leaving it empty
+		 * This list must be empty and without heap storage
+		 * @param other The list to take the elements of
+		 */
+		void steal(ArrayList& other) {
+			if (other.isInline()) {
+				relocate(buffer, other.buffer, other.size);
+				size = other.size;
+			}
+			else {
+				buffer = other.buffer;
+				size = other.size;
+				cap = other.cap;
+				other.buffer = other.inlineSlots();
+				other.cap = InlineCapacity;
+			}
+			other.size = 0;
+		}
+
 		/**
 		 * Reallocates the memory of the array list
 		 * @param newCap the size of the new allocation
 		 */
 		void realloc(size_t newCap) {
-			T* newBlock = new T[newCap];
-
-			if (newCap < size)
+			if (newCap < size) {
+				destroy(buffer + newCap, size - newCap);
 				size = newCap;
+			}
 
-			for (size_t i = 0; i < size; i++) {
-				newBlock[i] = std::move(data[i]);
+			if (newCap <= InlineCapacity) {
+				// Everything fits in the inline slots again (or the list is emptied when it has none)
+				if (!isInline()) {
+					T* slots = this->inlineSlots();
+					if (InlineCapacity > 0 && size > 0)
+						relocate(slots, buffer, size);
+					freeStorage();
+					buffer = slots;
+					cap = InlineCapacity;
+				}
+				return;
 			}
 
-			for (size_t i = 0; i < size; i++) {
-				data[i].~T();
+			if (buffer != nullptr && !isInline() && isTriviallyRelocatable<T>) {
+				buffer = static_cast<T*>(allocator().reallocate(buffer, cap * sizeof(T), newCap * sizeof(T), alignof(T)));
+			}
+			else {
+				T* newBlock = static_cast<T*>(allocator().allocate(newCap * sizeof(T), alignof(T)));
+				relocate(newBlock, buffer, size);
+				freeStorage();
+				buffer = newBlock;
 			}
-			
-			delete[] data;
-			data = newBlock;
 			cap = newCap;
 		}
 
-	public:
+		/**
+		 * Grows the capacity geometrically so that at least minCap elements fit
+		 * @param minCap The minimum capacity required
+		 */
+		void grow(size_t minCap) {
+			size_t newCap = cap + cap / 2;
+			if (newCap < 4)
+				newCap = 4;
+			if (newCap < minCap)
+				newCap = minCap;
+			realloc(newCap);
+		}
 
 		/**
-		 * Creates a new empty ArrayList with enough space for 2 elements by default
+		 * Opens an uninitialized gap of count slots at an index, growing the storage if needed
+		 * @param index The index to open the gap at
+		 * @param count The number of slots to open
 		 */
-		ArrayList() {
-			realloc(2);
+		void openGap(size_t index, size_t count) {
+			assert(index <= size);
+			if (size + count > cap)
+				grow(size + count);
+			relocateOverlapping(buffer + index + count, buffer + index, size - index);
 		}
 
+	public:
+
+		/**
+		 * Creates a new empty ArrayList (Does not allocate until the first item is added)
+		 */
+		ArrayList() = default;
+
+		/**
+		 * Creates a new empty ArrayList which allocates from an allocator
+		 * @param allocator The allocator to request storage from
+		 */
+		ArrayList(const Allocator& allocator) : Allocator(allocator) {}
+
 		/**
 		 * Creates a new empty ArrayList with enough space for num elements
 		 * @param num The number of elements to prepare for
+		 * @param allocator The allocator to request storage from
 		 */
-		ArrayList(size_t num) {
+		ArrayList(size_t num, const Allocator& allocator = Allocator()) : Allocator(allocator) {
 			realloc(num);
 		}
 
+		/**
+		 * Creates a copy of another ArrayList (Using the same allocator)
+		 * @param other The list to copy
+		 */
+		ArrayList(const ArrayList& other) : Allocator(other) {
+			realloc(other.size);
+			for (; size < other.size; size++)
+				new(&buffer[size]) T(other.buffer[size]);
+		}
+
+		/**
+		 * Takes the storage of another ArrayList, leaving it empty (inline elements are moved one by one)
+		 * @param other The list to move from
+		 */
+		ArrayList(ArrayList&& other) noexcept : Allocator(other) {
+			steal(other);
+		}
+
+		/**
+		 * Replaces the contents of this list with a copy of another ArrayList
+		 * @param other The list to copy
+		 * @returns This list
+		 */
+		ArrayList& operator=(const ArrayList& other) {
+			if (this != &other) {
+				clear();
+				prepare(other.size);
+				for (; size < other.size; size++)
+					new(&buffer[size]) T(other.buffer[size]);
+			}
+			return *this;
+		}
+
+		/**
+		 * Replaces the contents of this list with the storage (and allocator) of another ArrayList
+		 * @param other The list to move from
+		 * @returns This list
+		 */
+		ArrayList& operator=(ArrayList&& other) noexcept {
+			if (this != &other) {
+				clear();
+				freeStorage();
+				allocator() = static_cast<Allocator&>(other);
+				buffer = this->inlineSlots();
+				cap = InlineCapacity;
+				steal(other);
+			}
+			return *this;
+		}
+
 		/**
 		 * Frees resources
 		 */
 		~ArrayList() {
 			clear();
-			delete[] data;
+			freeStorage();
 		}
 
 		/**
@@ -104,7 +286,7 @@ namespace Essentials::DataStructures {
 		 */
 		T& operator[](size_t index) {
 			assert(index < size);
-			return data[index];
+			return buffer[index];
 		}
 
 		/**
@@ -114,7 +296,7 @@ namespace Essentials::DataStructures {
 		 */
 		const T& operator[](size_t index) const {
 			assert(index < size);
-			return data[index];
+			return buffer[index];
 		}
 
 		/**
@@ -122,10 +304,7 @@ namespace Essentials::DataStructures {
 		 * @param item The item to add to the list
 		 */
 		void push(const T& item) {
-			if (size >= cap)
-				realloc(cap + cap / 2);
-			data[size] = item;
-			size++;
+			emplace(item);
 		}
 
 		/**
@@ -133,20 +312,19 @@ namespace Essentials::DataStructures {
 		 * @param item The item to add to the list
 		 */
 		void push(T&& item) {
-			if (size >= cap)
-				realloc(cap + cap / 2);
-			data[size] = std::move(item);
-			size++;
+			emplace(std::move(item));
 		}
 
 		/**
 		 * Adds multiple new items to the end of the list
-		 * @param items The items to add to the list
+		 * @param items The items to add to the list (any type satisfying the list contract)
 		 */
-		void push(const List<T>& items) {
-			prepare(items.length());
-			for (size_t i = 0; i < items.length(); i++) {
-				data[size] = items[i];
+		template<typename L, typename = std::enable_if_t<isList<L>>>
+		void push(const L& items) {
+			size_t count = items.length();
+			prepare(count);
+			for (size_t i = 0; i < count; i++) {
+				new(&buffer[size]) T(items[i]);
 				size++;
 			}
 		}
@@ -157,14 +335,8 @@ namespace Essentials::DataStructures {
 		 * @param index The index to add after (ie [0, 1, 2] .add(3, 1) -> [0, 1, 3, 2])
 		 */
 		void add(const T& item, size_t index) {
-			if (size >= cap)
-				realloc(cap + cap / 2);
-			
-			for (size_t i = size - 1; i >= index; i--)
-				data[i+1] = std::move(data[i]);
-			
-			data[index] = item;
-			size++;
+			T copy(item);
+			add(std::move(copy), index);
 		}
 
 		/**
@@ -173,26 +345,67 @@ namespace Essentials::DataStructures {
 		 * @param index The index to add after (ie [0, 1, 2] .add(3, 1) -> [0, 1, 3, 2])
 		 */
 		void add(T&& item, size_t index) {
-			if (size >= cap)
-				realloc(cap + cap / 2);
-			
-			for (size_t i = size - 1; i >= index; i--)
-				data[i+1] = std::move(data[i]);
-			
-			data[index] = std::move(item);
+			openGap(index, 1);
+			new(&buffer[index]) T(std::move(item));
 			size++;
 		}
 
+		/**
+		 * Adds a range of items at any position in the list with a single shift of the following elements
+		 * @param index The index the first item will be at
+		 * @param first The iterator at the first item (must not refer to this list)
+		 * @param last The iterator past the last item
+		 */
+		template<typename It, typename = std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>>>
+		void insertRange(size_t index, It first, It last) {
+			size_t count = static_cast<size_t>(std::distance(first, last));
+			openGap(index, count);
+			try {
+				std::uninitialized_copy(first, last, buffer + index);
+			}
+			catch (...) {
+				// The copies already made were destroyed, close the gap so the list is as it was
+				relocateOverlapping(buffer + index, buffer + index + count, size - index);
+				throw;
+			}
+			size += count;
+		}
+
+		/**
+		 * Adds an array of items at any position in the list with a single shift of the following elements
+		 * @param index The index the first item will be at
+		 * @param items The items to add (must not refer to this list)
+		 * @param count The number of items
+		 */
+		void insertRange(size_t index, const T* items, size_t count) {
+			insertRange(index, items, items + count);
+		}
+
+		/**
+		 * Adds an array of items to the end of the list
+		 * @param items The items to add (must not refer to this list)
+		 * @param count The number of items
+		 */
+		void append(const T* items, size_t count) {
+			insertRange(size, items, items + count);
+		}
+
 		/**
 		 * Adds a new element to the back of the ArrayList given the arguments to the constructor of the element
 		 */
 		template<typename... Args>
 		T& emplace(Args&&... args) {
-			if (size >= cap)
-				realloc(cap + cap / 2);
-			new(&data[size]) T(std::forward<Args>(args)...);
+			if (size >= cap) {
+				// The arguments may refer to elements of this list, so construct before the storage moves
+				T item(std::forward<Args>(args)...);
+				grow(size + 1);
+				new(&buffer[size]) T(std::move(item));
+			}
+			else {
+				new(&buffer[size]) T(std::forward<Args>(args)...);
+			}
 			size++;
-			return data[size - 1];
+			return buffer[size - 1];
 		}
 
 		/**
@@ -200,12 +413,7 @@ namespace Essentials::DataStructures {
 		 * @param index The index to remove
 		 */
 		void remove(size_t index) {
-			assert(index < size);
-			data[index].~T();
-			for (size_t i = index+1; i < size; i++) {
-				data[i-1] = std::move(data[i]);
-			}
-			size--;
+			remove(index, 1);
 		}
 
 		/**
@@ -215,22 +423,80 @@ namespace Essentials::DataStructures {
 		 */
 		void remove(size_t index, size_t count) {
 			assert(index < size);
-			for (size_t i = index; i < size; i++) {
-				if (i < index + count)
-					data[index].~T();
-				else
-					data[i-count] = std::move(data[i]);
-			}
+			if (count > size - index)
+				count = size - index;
+			destroy(buffer + index, count);
+			relocateOverlapping(buffer + index, buffer + index + count, size - index - count);
 			size -= count;
 		}
 
+		/**
+		 * Removes every element matching a predicate, compacting the kept elements in a single pass
+		 * @param predicate Called with each element, returns whether or not to remove it
+		 * @returns The number of elements removed
+		 */
+		template<typename P>
+		size_t removeIf(P predicate) {
+			size_t kept = 0;
+			size_t run = 0;
+			for (size_t i = 0; i <= size; i++) {
+				if (i < size && !predicate(static_cast<const T&>(buffer[i])))
+					continue;
+				// Relocate the run of kept elements before the removed one at once
+				if (kept != run)
+					relocateOverlapping(buffer + kept, buffer + run, i - run);
+				kept += i - run;
+				if (i < size)
+					buffer[i].~T();
+				run = i + 1;
+			}
+			size_t removed = size - kept;
+			size = kept;
+			return removed;
+		}
+
+		/**
+		 * Changes the length of the list, value initializing new elements or destroying the extra ones
+		 * @param num The new length
+		 */
+		void resize(size_t num) {
+			if (num > cap)
+				realloc(num);
+			if (num > size)
+				std::uninitialized_value_construct(buffer + size, buffer + num);
+			else
+				destroy(buffer + num, size - num);
+			size = num;
+		}
+
+		/**
+		 * Changes the length of the list, copying an item into new elements or destroying the extra ones
+		 * @param num The new length
+		 * @param item The item to copy into new elements (must not refer to this list)
+		 */
+		void resize(size_t num, const T& item) {
+			if (num > cap)
+				realloc(num);
+			if (num > size)
+				std::uninitialized_fill(buffer + size, buffer + num, item);
+			else
+				destroy(buffer + num, size - num);
+			size = num;
+		}
+
+		/**
+		 * Reduces the capacity to the length of the list, freeing the storage if it is empty (or moving back inline)
+		 */
+		void shrinkToFit() {
+			if (cap > size)
+				realloc(size);
+		}
+
 		/**
 		 * Completely removes all items in the list
 		 */
 		void clear() {
-			for (size_t i = 0; i < size; i++) {
-				data[i].~T();
-			}
+			destroy(buffer, size);
 			size = 0;
 		}
 
@@ -242,6 +508,72 @@ namespace Essentials::DataStructures {
 			return size;
 		}
 
+		/**
+		 * Returns the number of elements the list can hold before reallocating
+		 * @returns The capacity of the arraylist
+		 */
+		inline size_t capacity() const {
+			return cap;
+		}
+
+		/**
+		 * Gets the contiguous storage of the list
+		 * @returns A pointer to the first element (nullptr if nothing has been allocated)
+		 */
+		inline T* data() {
+			return buffer;
+		}
+
+		/**
+		 * Gets the contiguous storage of the list
+		 * @returns A pointer to the first element (nullptr if nothing has been allocated)
+		 */
+		inline const T* data() const {
+			return buffer;
+		}
+
+		/**
+		 * Gets an iterator at the first element
+		 * @returns The iterator
+		 */
+		Iterator<T> begin() {
+			return Iterator<T>(buffer);
+		}
+
+		/**
+		 * Gets an iterator past the last element
+		 * @returns The iterator
+		 */
+		Iterator<T> end() {
+			return Iterator<T>(buffer + size);
+		}
+
+		/**
+		 * Gets an iterator at the first element
+		 * @returns The iterator
+		 */
+		Iterator<const T> begin() const {
+			return Iterator<const T>(buffer);
+		}
+
+		/**
+		 * Gets an iterator past the last element
+		 * @returns The iterator
+		 */
+		Iterator<const T> end() const {
+			return Iterator<const T>(buffer + size);
+		}
+
+		/**
+		 * Changes the length without constructing or destroying any elements, for code which fills the storage in place
+		 * The caller must construct (or has already destroyed) the affected slots through data()
+		 * @param num The new length (at most the capacity)
+		 */
+		void resizeUninitialized(size_t num) {
+			assert(num <= cap);
+			size = num;
+		}
+
 		/**
 		 * Expands the ArrayList's capacity for an amount of new items
 		 * @param num The number of items to prepare for
@@ -266,10 +598,7 @@ namespace Essentials::DataStructures {
 		 * @returns Whether or not the list contains the element
 		 */
 		bool contains(const T& item) const {
-			for (size_t i = 0; i < size; i++) {
-				if (item == data[i]) return true;
-			}
-			return false;
+			return findFirst(buffer, size, item) != size;
 		}
 
 		/**
@@ -278,10 +607,8 @@ namespace Essentials::DataStructures {
 		 * @returns The index of the element (-1 if not found)
 		 */
 		int indexOf(const T& item) const {
-			for (size_t i = 0; i < size; i++) {
-				if (item == data[i]) return static_cast<int>(i);
-			}
-			return -1;
+			size_t i = findFirst(buffer, size, item);
+			return i == size ? -1 : static_cast<int>(i);
 		}
 
 		/**
@@ -290,12 +617,17 @@ namespace Essentials::DataStructures {
 		 * @returns The index of the element (-1 if not found)
 		 */
 		int lastIndexOf(const T& item) const {
-			for (size_t i = size - 1; i >= 0; i--) {
-				if (item == data[i]) return static_cast<int>(i);
-			}
-			return -1;
+			size_t i = findLast(buffer, size, item);
+			return i == size ? -1 : static_cast<int>(i);
 		}
 	};
+
+	/**
+	 * An ArrayList which keeps up to N elements inside itself, only allocating once it grows past them
+	 * @tparam N The number of elements stored inline
+	 * @tparam Allocator The allocator the storage is requested from once the list spills
+	 */
+	template<typename T, size_t N, typename Allocator = HeapAllocator> using SmallArrayList = ArrayList<T, Allocator, N>;
 }
 
 /**
@@ -0,0 +1,539 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "Queue.h"
+#include "List.h"
+#include "Memory.h"
+#include "Allocator.h"
+#include <assert.h>
+#include <atomic>
+
+/**
+ * The main namespace for data structures in the essentials library
+ */
+namespace Essentials::DataStructures {
+
+	/**
+	 * A namespace alias to the data structures namespace
+	 */
+	namespace ds = DataStructures;
+
+	/**
+	 * Rounds a number up to a power of two
+	 * @param num The number to round
+	 * @returns The smallest power of two which is at least num (1 for 0)
+	 */
+	inline size_t nextPowerOfTwo(size_t num) {
+		size_t power = 1;
+		while (power < num)
+			power <<= 1;
+		return power;
+	}
+
+	/**
+	 * A single threaded queue stored in a power of two ring buffer, which doubles when it is full
+	 * Satisfies the Queue<T> contract statically, use ConcurrentArrayQueue to share a queue between threads
+	 * @tparam Allocator The allocator the ring is requested from (see HeapAllocator)
+	 */
+	template<typename T, typename Allocator = HeapAllocator> class ArrayQueue : private Allocator {
+	private:
+		/**
+		 * The ring buffer
+		 */
+		T* data = nullptr;
+
+		/**
+		 * The index of the first element
+		 */
+		size_t head = 0;
+
+		/**
+		 * The number of elements in the queue
+		 */
+		size_t size = 0;
+
+		/**
+		 * The capacity of the ring (0 or a power of two)
+		 */
+		size_t cap = 0;
+
+		/**
+		 * Returns the allocator the ring is requested from
+		 * @returns The allocator of the queue
+		 */
+		Allocator& allocator() {
+			return *this;
+		}
+
+		/**
+		 * Gets the slot of an element
+		 * @param index The position of the element from the front of the queue
+		 * @returns The element's slot in the ring
+		 */
+		inline T* slot(size_t index) const {
+			return data + ((head + index) & (cap - 1));
+		}
+
+		/**
+		 * Moves every element into a new ring, starting at index 0
+		 * @param newCap The capacity of the new ring (a power of two, at least size)
+		 */
+		void realloc(size_t newCap) {
+			T* newBlock = static_cast<T*>(allocator().allocate(newCap * sizeof(T), alignof(T)));
+			if (data != nullptr) {
+				size_t first = cap - head < size ? cap - head : size;
+				relocate(newBlock, data + head, first);
+				relocate(newBlock + first, data, size - first);
+				allocator().deallocate(data, cap * sizeof(T), alignof(T));
+			}
+			data = newBlock;
+			head = 0;
+			cap = newCap;
+		}
+
+	public:
+		/**
+		 * Creates a new empty ArrayQueue (Does not allocate until the first item is added)
+		 */
+		ArrayQueue() = default;
+
+		/**
+		 * Creates a new empty ArrayQueue with enough space for num elements
+		 * @param num The number of elements to prepare for (rounded up to a power of two)
+		 * @param allocator The allocator to request the ring from
+		 */
+		ArrayQueue(size_t num, const Allocator& allocator = Allocator()) : Allocator(allocator) {
+			if (num > 0)
+				realloc(nextPowerOfTwo(num));
+		}
+
+		/**
+		 * Creates a copy of another ArrayQueue (Using the same allocator)
+		 * @param other The queue to copy
+		 */
+		ArrayQueue(const ArrayQueue& other) : Allocator(other) {
+			if (other.size == 0) return;
+			realloc(nextPowerOfTwo(other.size));
+			for (; size < other.size; size++)
+				new(&data[size]) T(*other.slot(size));
+		}
+
+		/**
+		 * Takes the ring of another ArrayQueue, leaving it empty
+		 * @param other The queue to move from
+		 */
+		ArrayQueue(ArrayQueue&& other) noexcept : Allocator(other), data(other.data), head(other.head), size(other.size), cap(other.cap) {
+			other.data = nullptr;
+			other.head = 0;
+			other.size = 0;
+			other.cap = 0;
+		}
+
+		/**
+		 * Replaces the contents of this queue with a copy of another ArrayQueue
+		 * @param other The queue to copy
+		 * @returns This queue
+		 */
+		ArrayQueue& operator=(const ArrayQueue& other) {
+			if (this != &other) {
+				clear();
+				for (size_t i = 0; i < other.size; i++)
+					push(*other.slot(i));
+			}
+			return *this;
+		}
+
+		/**
+		 * Replaces the contents of this queue with the ring (and allocator) of another ArrayQueue
+		 * @param other The queue to move from
+		 * @returns This queue
+		 */
+		ArrayQueue& operator=(ArrayQueue&& other) noexcept {
+			if (this != &other) {
+				clear();
+				if (data != nullptr)
+					allocator().deallocate(data, cap * sizeof(T), alignof(T));
+				allocator() = static_cast<Allocator&>(other);
+				data = other.data;
+				head = other.head;
+				size = other.size;
+				cap = other.cap;
+				other.data = nullptr;
+				other.head = 0;
+				other.size = 0;
+				other.cap = 0;
+			}
+			return *this;
+		}
+
+		/**
+		 * Frees resources
+		 */
+		~ArrayQueue() {
+			clear();
+			if (data != nullptr)
+				allocator().deallocate(data, cap * sizeof(T), alignof(T));
+		}
+
+		/**
+		 * Adds a new item to the end of the queue
+		 * @param item The item to add
+		 */
+		void push(const T& item) {
+			emplace(item);
+		}
+
+		/**
+		 * Adds a new item to the end of the queue
+		 * @param item The item to add
+		 */
+		void push(T&& item) {
+			emplace(std::move(item));
+		}
+
+		/**
+		 * Adds multiple items to the end of the queue
+		 * @param items The items to add to the queue
+		 * @param count The number of items
+		 */
+		void push(const T* items, size_t count) {
+			prepare(count);
+			for (size_t i = 0; i < count; i++)
+				new(slot(size + i)) T(items[i]);
+			size += count;
+		}
+
+		/**
+		 * Adds multiple items to the end of the queue
+		 * @param items The items to add to the queue (any type satisfying the list contract)
+		 */
+		template<typename L, typename = std::enable_if_t<isList<L>>>
+		void push(const L& items) {
+			size_t count = items.length();
+			prepare(count);
+			for (size_t i = 0; i < count; i++)
+				new(slot(size + i)) T(items[i]);
+			size += count;
+		}
+
+		/**
+		 * Adds a new element to the end of the queue given the arguments to the constructor of the element
+		 */
+		template<typename... Args>
+		T& emplace(Args&&... args) {
+			if (size == cap) {
+				// The arguments may refer to elements of this queue, so construct before the ring moves
+				T item(std::forward<Args>(args)...);
+				realloc(cap == 0 ? 4 : cap * 2);
+				new(slot(size)) T(std::move(item));
+			}
+			else {
+				new(slot(size)) T(std::forward<Args>(args)...);
+			}
+			size++;
+			return *slot(size - 1);
+		}
+
+		/**
+		 * Removes the first element from the queue
+		 * @returns The element removed
+		 */
+		T dequeue() {
+			assert(size > 0);
+			T item(std::move(data[head]));
+			data[head].~T();
+			head = (head + 1) & (cap - 1);
+			size--;
+			return item;
+		}
+
+		/**
+		 * Removes multiple elements from the front of the queue
+		 * @param items Where to move the removed elements to (must hold count constructed elements)
+		 * @param count The maximum number of elements to remove
+		 * @returns The number of elements removed
+		 */
+		size_t dequeue(T* items, size_t count) {
+			if (count > size)
+				count = size;
+			for (size_t i = 0; i < count; i++) {
+				T* item = slot(i);
+				items[i] = std::move(*item);
+				item->~T();
+			}
+			if (count > 0)
+				head = (head + count) & (cap - 1);
+			size -= count;
+			return count;
+		}
+
+		/**
+		 * Returns the first element of the queue without removing it
+		 * @returns The first element of the queue
+		 */
+		T& peek() {
+			assert(size > 0);
+			return data[head];
+		}
+
+		/**
+		 * Completely removes all items in the queue
+		 */
+		void clear() {
+			for (size_t i = 0; i < size; i++)
+				slot(i)->~T();
+			head = 0;
+			size = 0;
+		}
+
+		/**
+		 * Returns the length of the data structure
+		 * @returns The number of elements in the queue
+		 */
+		inline size_t length() const {
+			return size;
+		}
+
+		/**
+		 * Returns the number of elements the queue can hold before reallocating
+		 * @returns The capacity of the ring
+		 */
+		inline size_t capacity() const {
+			return cap;
+		}
+
+		/**
+		 * Expands the ring's capacity for an amount of new items
+		 * @param num The number of items to prepare for
+		 */
+		void prepare(size_t num) {
+			if (size + num > cap)
+				realloc(nextPowerOfTwo(size + num));
+		}
+	};
+
+	/**
+	 * A bounded lock free queue which any number of threads may push to and dequeue from at once
+	 *
+	 * The ring is a power of two and every slot carries a sequence number which tells producers and consumers
+	 * whose turn it is to use the slot, so the only shared writes are to the head and tail positions
+	 * (which are kept on separate cache lines). Pushing to a full queue or dequeuing from an empty one fails instead of blocking.
+	 */
+	template<typename T> class ConcurrentArrayQueue {
+	private:
+		/**
+		 * A slot of the ring
+		 */
+		struct Cell {
+			/**
+			 * The position a producer may fill this slot at, or that position + 1 once it is filled
+			 */
+			std::atomic<size_t> sequence;
+
+			/**
+			 * The storage of the element
+			 */
+			alignas(T) unsigned char storage[sizeof(T)];
+
+			/**
+			 * Gets the element stored in the slot
+			 * @returns The element
+			 */
+			T* item() {
+				return reinterpret_cast<T*>(storage);
+			}
+		};
+
+		/**
+		 * The ring buffer
+		 */
+		Cell* cells;
+
+		/**
+		 * The capacity of the ring minus one
+		 */
+		size_t mask;
+
+		/**
+		 * The position the next element is pushed at
+		 */
+		alignas(cacheLineSize) std::atomic<size_t> tail;
+
+		/**
+		 * The position the next element is dequeued from
+		 */
+		alignas(cacheLineSize) std::atomic<size_t> head;
+
+		/**
+		 * Claims up to count consecutive slots which are ready for a role
+		 * @param position The position counter of the role (tail for producers, head for consumers)
+		 * @param offset The difference between a ready slot's sequence and its position (0 for producers, 1 for consumers)
+		 * @param count The maximum number of slots to claim
+		 * @param start Set to the first claimed position
+		 * @returns The number of slots claimed
+		 */
+		size_t claim(std::atomic<size_t>& position, size_t offset, size_t count, size_t& start) {
+			size_t pos = position.load(std::memory_order_relaxed);
+			while (true) {
+				size_t ready = 0;
+				bool behind = false;
+				while (ready < count) {
+					size_t sequence = cells[(pos + ready) & mask].sequence.load(std::memory_order_acquire);
+					intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + ready + offset);
+					if (difference != 0) {
+						// A positive difference means another thread already claimed this position
+						behind = difference > 0;
+						break;
+					}
+					ready++;
+				}
+
+				if (ready > 0) {
+					// On failure pos is refreshed and the slots are checked again
+					if (position.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) {
+						start = pos;
+						return ready;
+					}
+				}
+				else if (behind) {
+					pos = position.load(std::memory_order_relaxed);
+				}
+				else {
+					return 0;
+				}
+			}
+		}
+
+	public:
+		/**
+		 * Creates a new empty queue
+		 * @param num The number of elements the queue can hold (rounded up to a power of two, at least 2)
+		 */
+		ConcurrentArrayQueue(size_t num) : tail(0), head(0) {
+			size_t cap = nextPowerOfTwo(num < 2 ? 2 : num);
+			mask = cap - 1;
+			cells = static_cast<Cell*>(::operator new(cap * sizeof(Cell), std::align_val_t(alignof(Cell))));
+			for (size_t i = 0; i < cap; i++)
+				new(&cells[i].sequence) std::atomic<size_t>(i);
+		}
+
+		ConcurrentArrayQueue(const ConcurrentArrayQueue&) = delete;
+		ConcurrentArrayQueue& operator=(const ConcurrentArrayQueue&) = delete;
+
+		/**
+		 * Frees resources (no other thread may be using the queue)
+		 */
+		~ConcurrentArrayQueue() {
+			size_t end = tail.load(std::memory_order_relaxed);
+			for (size_t pos = head.load(std::memory_order_relaxed); pos != end; pos++)
+				cells[pos & mask].item()->~T();
+			::operator delete(cells, std::align_val_t(alignof(Cell)));
+		}
+
+		/**
+		 * Adds a new item to the end of the queue if there is room
+		 * @param item The item to add
+		 * @returns Whether or not the item was added
+		 */
+		bool tryPush(const T& item) {
+			return tryPush(&item, 1) == 1;
+		}
+
+		/**
+		 * Adds a new item to the end of the queue if there is room
+		 * @param item The item to add (only moved from if it was added)
+		 * @returns Whether or not the item was added
+		 */
+		bool tryPush(T&& item) {
+			size_t start;
+			if (claim(tail, 0, 1, start) == 0)
+				return false;
+			Cell& cell = cells[start & mask];
+			new(cell.item()) T(std::move(item));
+			cell.sequence.store(start + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * Adds as many items as fit to the end of the queue, the added items are consecutive in the queue
+		 * @param items The items to add
+		 * @param count The number of items
+		 * @returns The number of items added (always a prefix of items)
+		 */
+		size_t tryPush(const T* items, size_t count) {
+			size_t start;
+			size_t claimed = claim(tail, 0, count, start);
+			for (size_t i = 0; i < claimed; i++) {
+				Cell& cell = cells[(start + i) & mask];
+				new(cell.item()) T(items[i]);
+				cell.sequence.store(start + i + 1, std::memory_order_release);
+			}
+			return claimed;
+		}
+
+		/**
+		 * Removes the first element from the queue if there is one
+		 * @param item Where to move the removed element to
+		 * @returns Whether or not an element was removed
+		 */
+		bool tryDequeue(T& item) {
+			return tryDequeue(&item, 1) == 1;
+		}
+
+		/**
+		 * Removes up to count consecutive elements from the front of the queue
+		 * @param items Where to move the removed elements to (must hold count constructed elements)
+		 * @param count The maximum number of elements to remove
+		 * @returns The number of elements removed
+		 */
+		size_t tryDequeue(T* items, size_t count) {
+			size_t start;
+			size_t claimed = claim(head, 1, count, start);
+			for (size_t i = 0; i < claimed; i++) {
+				Cell& cell = cells[(start + i) & mask];
+				items[i] = std::move(*cell.item());
+				cell.item()->~T();
+				cell.sequence.store(start + i + mask + 1, std::memory_order_release);
+			}
+			return claimed;
+		}
+
+		/**
+		 * Returns the number of elements in the queue (only approximate while other threads are using it)
+		 * @returns The length of the queue
+		 */
+		size_t length() const {
+			size_t end = tail.load(std::memory_order_relaxed);
+			size_t start = head.load(std::memory_order_relaxed);
+			return end > start ? end - start : 0;
+		}
+
+		/**
+		 * Returns the maximum number of elements the queue can hold
+		 * @returns The capacity of the queue
+		 */
+		inline size_t capacity() const {
+			return mask + 1;
+		}
+	};
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
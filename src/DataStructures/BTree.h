@@ -0,0 +1,1208 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "List.h"
+#include "ArrayList.h"
+#include "Iterable.h"
+#include "Memory.h"
+#include "Allocator.h"
+#include <assert.h>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/**
+ * The main namespace for data structures in the essentials library
+ */
+namespace Essentials::DataStructures {
+
+	/**
+	 * A namespace alias to the data structures namespace
+	 */
+	namespace ds = DataStructures;
+
+	/**
+	 * An ordered map (or set when V is void) stored as a B+ tree
+	 *
+	 * Every node holds many keys in a few cache lines, so a lookup touches a handful of nodes rather than one per level of a binary tree.
+	 * Elements are only stored in the leaves, which are chained in order for iteration and range queries.
+	 * Keys and values are stored in separate arrays so searching a leaf only reads keys. Inserting or removing invalidates iterators.
+	 * @tparam V The type of the values (void for a set of keys)
+	 * @tparam Compare The strict weak ordering of the keys
+	 * @tparam Allocator The allocator the nodes are requested from (see HeapAllocator)
+	 */
+	template<typename K, typename V, typename Compare = std::less<K>, typename Allocator = HeapAllocator>
+	class BTree : private Allocator {
+	public:
+		/**
+		 * Whether or not the tree stores a value with every key
+		 */
+		static constexpr bool isMap = !std::is_void_v<V>;
+
+	private:
+		/**
+		 * The stored value type (a placeholder which is never constructed for sets)
+		 */
+		using Value = std::conditional_t<isMap, V, char>;
+
+		/**
+		 * The number of bytes of keys a node is sized for
+		 */
+		static constexpr size_t nodeBytes = 4 * cacheLineSize;
+
+		/**
+		 * Clamps a number of slots to a usable node size
+		 * @param slots The number of slots which fit in a node
+		 * @returns The number of slots of the node
+		 */
+		static constexpr size_t clampSlots(size_t slots) {
+			return slots < 4 ? 4 : (slots > 1024 ? 1024 : slots);
+		}
+
+		/**
+		 * The maximum number of elements in a leaf
+		 */
+		static constexpr size_t leafSlots = clampSlots(nodeBytes / sizeof(K));
+
+		/**
+		 * The maximum number of keys in an inner node (which has one more child than keys)
+		 */
+		static constexpr size_t innerSlots = clampSlots(nodeBytes / (sizeof(K) + sizeof(void*)));
+
+		/**
+		 * The minimum number of elements in a leaf other than the root
+		 */
+		static constexpr size_t leafMin = leafSlots / 2;
+
+		/**
+		 * The minimum number of keys in an inner node other than the root
+		 */
+		static constexpr size_t innerMin = (innerSlots - 1) / 2;
+
+		/**
+		 * The header shared by leaves and inner nodes
+		 */
+		struct Node {
+			/**
+			 * The number of keys in the node
+			 */
+			uint16_t count = 0;
+
+			/**
+			 * Whether or not the node is a leaf
+			 */
+			bool leaf;
+
+			/**
+			 * Creates a new empty node
+			 * @param leaf Whether or not the node is a leaf
+			 */
+			Node(bool leaf) : leaf(leaf) {}
+		};
+
+		/**
+		 * A node holding elements, chained to the next leaf in order
+		 */
+		struct Leaf : Node {
+			/**
+			 * The next leaf in order (nullptr for the last leaf)
+			 */
+			Leaf* next = nullptr;
+
+			/**
+			 * The storage of the keys (the first count are constructed)
+			 */
+			alignas(K) unsigned char keyStorage[leafSlots * sizeof(K)];
+
+			/**
+			 * The storage of the values (the first count are constructed, unused for sets)
+			 */
+			alignas(Value) unsigned char valueStorage[(isMap ? leafSlots : 1) * sizeof(Value)];
+
+			/**
+			 * Creates a new empty leaf
+			 */
+			Leaf() : Node(true) {}
+
+			/**
+			 * Gets the keys of the leaf
+			 * @returns The keys
+			 */
+			K* keys() {
+				return reinterpret_cast<K*>(keyStorage);
+			}
+
+			/**
+			 * Gets the values of the leaf
+			 * @returns The values
+			 */
+			Value* values() {
+				return reinterpret_cast<Value*>(valueStorage);
+			}
+		};
+
+		/**
+		 * A node holding separator keys, every key in children[i] is less than keys[i] which is not greater than any key in children[i + 1]
+		 */
+		struct Inner : Node {
+			/**
+			 * The children of the node (the first count + 1 are set)
+			 */
+			Node* children[innerSlots + 1];
+
+			/**
+			 * The storage of the separator keys (the first count are constructed)
+			 */
+			alignas(K) unsigned char keyStorage[innerSlots * sizeof(K)];
+
+			/**
+			 * Creates a new empty inner node
+			 */
+			Inner() : Node(false) {}
+
+			/**
+			 * Gets the separator keys of the node
+			 * @returns The keys
+			 */
+			K* keys() {
+				return reinterpret_cast<K*>(keyStorage);
+			}
+		};
+
+		/**
+		 * An element of the map as seen through an iterator
+		 */
+		template<bool Const> struct EntryReference {
+			/**
+			 * The key of the entry
+			 */
+			const K& key;
+
+			/**
+			 * The value of the entry
+			 */
+			std::conditional_t<Const, const Value, Value>& value;
+		};
+
+		/**
+		 * An iterator over the elements of a tree in order (dereferences to an entry for maps and a key for sets)
+		 */
+		template<bool Const> class EntryIterator {
+		private:
+			/**
+			 * The current leaf (nullptr at the end)
+			 */
+			Leaf* leaf;
+
+			/**
+			 * The index of the current element in the leaf
+			 */
+			size_t index;
+
+		public:
+			/**
+			 * The iterator category
+			 */
+			using iterator_category = std::forward_iterator_tag;
+
+			/**
+			 * The type of the elements (an entry for maps and a key for sets)
+			 */
+			using value_type = std::conditional_t<isMap, EntryReference<Const>, K>;
+
+			/**
+			 * The type of the distance between two iterators
+			 */
+			using difference_type = std::ptrdiff_t;
+
+			/**
+			 * A pointer to an element (entries are made when dereferenced, so there is none)
+			 */
+			using pointer = void;
+
+			/**
+			 * The type the iterator dereferences to
+			 */
+			using reference = std::conditional_t<isMap, EntryReference<Const>, const K&>;
+
+			/**
+			 * Creates an iterator at an element
+			 * @param leaf The leaf of the element (nullptr for the end)
+			 * @param index The index of the element in the leaf
+			 */
+			EntryIterator(Leaf* leaf, size_t index) : leaf(leaf), index(index) {}
+
+			/**
+			 * Gets the current element
+			 * @returns The entry (maps) or key (sets)
+			 */
+			decltype(auto) operator*() const {
+				if constexpr (isMap) return EntryReference<Const>{ leaf->keys()[index], leaf->values()[index] };
+				else return static_cast<const K&>(leaf->keys()[index]);
+			}
+
+			/**
+			 * Gets the key of the current element
+			 * @returns The key
+			 */
+			const K& key() const {
+				return leaf->keys()[index];
+			}
+
+			/**
+			 * Gets the value of the current element (maps only)
+			 * @returns The value
+			 */
+			std::conditional_t<Const, const Value, Value>& value() const {
+				static_assert(isMap, "Sets do not store values");
+				return leaf->values()[index];
+			}
+
+			/**
+			 * Advances to the next element in order
+			 * @returns This iterator
+			 */
+			EntryIterator& operator++() {
+				if (++index == leaf->count) {
+					leaf = leaf->next;
+					index = 0;
+				}
+				return *this;
+			}
+
+			/**
+			 * Advances to the next element in order
+			 * @returns The iterator before advancing
+			 */
+			EntryIterator operator++(int) {
+				EntryIterator previous = *this;
+				++*this;
+				return previous;
+			}
+
+			/**
+			 * Checks if two iterators are at the same element
+			 * @param other The iterator to compare with
+			 * @returns Whether or not the iterators are equal
+			 */
+			bool operator==(const EntryIterator& other) const {
+				return leaf == other.leaf && index == other.index;
+			}
+
+			/**
+			 * Checks if two iterators are at different elements
+			 * @param other The iterator to compare with
+			 * @returns Whether or not the iterators are different
+			 */
+			bool operator!=(const EntryIterator& other) const {
+				return !(*this == other);
+			}
+		};
+
+		/**
+		 * The ordering of the keys
+		 */
+		Compare compare;
+
+		/**
+		 * The root of the tree (nullptr when empty)
+		 */
+		Node* root = nullptr;
+
+		/**
+		 * The first leaf in order (nullptr when empty)
+		 */
+		Leaf* head = nullptr;
+
+		/**
+		 * The number of elements in the tree
+		 */
+		size_t size = 0;
+
+		/**
+		 * Returns the allocator the nodes are requested from
+		 * @returns The allocator of the tree
+		 */
+		Allocator& allocator() {
+			return *this;
+		}
+
+		/**
+		 * Allocates a new empty node
+		 * @returns The node
+		 */
+		template<typename N> N* createNode() {
+			return new(allocator().allocate(sizeof(N), alignof(N))) N();
+		}
+
+		/**
+		 * Frees a node (its keys and values must already be destroyed)
+		 * @param node The node to free
+		 */
+		void freeNode(Node* node) {
+			if (node->leaf) allocator().deallocate(node, sizeof(Leaf), alignof(Leaf));
+			else allocator().deallocate(node, sizeof(Inner), alignof(Inner));
+		}
+
+		/**
+		 * Destroys and frees a subtree
+		 * @param node The root of the subtree
+		 */
+		void freeTree(Node* node) {
+			if (node->leaf) {
+				Leaf* leaf = static_cast<Leaf*>(node);
+				destroy(leaf->keys(), leaf->count);
+				if constexpr (isMap) destroy(leaf->values(), leaf->count);
+			}
+			else {
+				Inner* inner = static_cast<Inner*>(node);
+				for (size_t i = 0; i <= inner->count; i++)
+					freeTree(inner->children[i]);
+				destroy(inner->keys(), inner->count);
+			}
+			freeNode(node);
+		}
+
+		/**
+		 * Copies a subtree, chaining its leaves after the previously copied leaf
+		 * @param node The root of the subtree to copy
+		 * @param previous The last leaf copied so far (updated to the last leaf of the copy)
+		 * @returns The root of the copy
+		 */
+		Node* copyTree(Node* node, Leaf*& previous) {
+			if (node->leaf) {
+				Leaf* source = static_cast<Leaf*>(node);
+				Leaf* leaf = createNode<Leaf>();
+				for (size_t i = 0; i < source->count; i++) {
+					new(&leaf->keys()[i]) K(source->keys()[i]);
+					if constexpr (isMap) new(&leaf->values()[i]) V(source->values()[i]);
+				}
+				leaf->count = source->count;
+				if (previous == nullptr) head = leaf;
+				else previous->next = leaf;
+				previous = leaf;
+				return leaf;
+			}
+			Inner* source = static_cast<Inner*>(node);
+			Inner* inner = createNode<Inner>();
+			for (size_t i = 0; i < source->count; i++)
+				new(&inner->keys()[i]) K(source->keys()[i]);
+			for (size_t i = 0; i <= source->count; i++)
+				inner->children[i] = copyTree(source->children[i], previous);
+			inner->count = source->count;
+			return inner;
+		}
+
+		/**
+		 * Copies the elements of another tree into this empty tree
+		 * @param other The tree to copy
+		 */
+		void copyFrom(const BTree& other) {
+			Leaf* previous = nullptr;
+			if (other.root != nullptr)
+				root = copyTree(other.root, previous);
+			size = other.size;
+		}
+
+		/**
+		 * Finds the first key of a node which is not less than a key
+		 * @param keys The keys of the node
+		 * @param count The number of keys in the node
+		 * @param key The key to search for
+		 * @returns The index of the first key not less than the key (count if there is none)
+		 */
+		size_t lowerIndex(const K* keys, size_t count, const K& key) const {
+			size_t first = 0;
+			while (count > 0) {
+				size_t half = count / 2;
+				if (compare(keys[first + half], key)) {
+					first += half + 1;
+					count -= half + 1;
+				}
+				else count = half;
+			}
+			return first;
+		}
+
+		/**
+		 * Finds the first key of a node which is greater than a key
+		 * @param keys The keys of the node
+		 * @param count The number of keys in the node
+		 * @param key The key to search for
+		 * @returns The index of the first key greater than the key (count if there is none)
+		 */
+		size_t upperIndex(const K* keys, size_t count, const K& key) const {
+			size_t first = 0;
+			while (count > 0) {
+				size_t half = count / 2;
+				if (!compare(key, keys[first + half])) {
+					first += half + 1;
+					count -= half + 1;
+				}
+				else count = half;
+			}
+			return first;
+		}
+
+		/**
+		 * Finds the leaf which a key belongs in
+		 * @param key The key to search for
+		 * @returns The leaf (nullptr when the tree is empty)
+		 */
+		Leaf* findLeaf(const K& key) const {
+			Node* node = root;
+			if (node == nullptr) return nullptr;
+			while (!node->leaf) {
+				Inner* inner = static_cast<Inner*>(node);
+				node = inner->children[upperIndex(inner->keys(), inner->count, key)];
+			}
+			return static_cast<Leaf*>(node);
+		}
+
+		/**
+		 * Gets an iterator position, moving past the end of a leaf to the start of the next
+		 * @param leaf The leaf of the position
+		 * @param index The index in the leaf
+		 * @returns The position
+		 */
+		template<bool Const> static EntryIterator<Const> position(Leaf* leaf, size_t index) {
+			if (leaf != nullptr && index == leaf->count) return EntryIterator<Const>(leaf->next, 0);
+			return EntryIterator<Const>(leaf, index);
+		}
+
+		/**
+		 * Finds the first element not less than a key
+		 * @param key The key to search for
+		 * @returns The position of the element
+		 */
+		template<bool Const> EntryIterator<Const> lowerPosition(const K& key) const {
+			Leaf* leaf = findLeaf(key);
+			if (leaf == nullptr) return EntryIterator<Const>(nullptr, 0);
+			return position<Const>(leaf, lowerIndex(leaf->keys(), leaf->count, key));
+		}
+
+		/**
+		 * Finds the first element greater than a key
+		 * @param key The key to search for
+		 * @returns The position of the element
+		 */
+		template<bool Const> EntryIterator<Const> upperPosition(const K& key) const {
+			Leaf* leaf = findLeaf(key);
+			if (leaf == nullptr) return EntryIterator<Const>(nullptr, 0);
+			return position<Const>(leaf, upperIndex(leaf->keys(), leaf->count, key));
+		}
+
+		/**
+		 * Finds the element with a key
+		 * @param key The key to search for
+		 * @returns The position of the element (the end if not found)
+		 */
+		template<bool Const> EntryIterator<Const> findPosition(const K& key) const {
+			Leaf* leaf = findLeaf(key);
+			if (leaf == nullptr) return EntryIterator<Const>(nullptr, 0);
+			size_t index = lowerIndex(leaf->keys(), leaf->count, key);
+			if (index == leaf->count || compare(key, leaf->keys()[index])) return EntryIterator<Const>(nullptr, 0);
+			return EntryIterator<Const>(leaf, index);
+		}
+
+		/**
+		 * Splits a full child of a node in half, adding the new right half as the next child
+		 * @param parent The node of the child (must not be full)
+		 * @param index The index of the child
+		 */
+		void splitChild(Inner* parent, size_t index) {
+			Node* child = parent->children[index];
+			Node* right;
+			K* parentKeys = parent->keys();
+			relocateOverlapping(parentKeys + index + 1, parentKeys + index, parent->count - index);
+
+			if (child->leaf) {
+				Leaf* left = static_cast<Leaf*>(child);
+				Leaf* leaf = createNode<Leaf>();
+				size_t mid = leafSlots / 2;
+				relocate(leaf->keys(), left->keys() + mid, left->count - mid);
+				if constexpr (isMap) relocate(leaf->values(), left->values() + mid, left->count - mid);
+				leaf->count = static_cast<uint16_t>(left->count - mid);
+				left->count = static_cast<uint16_t>(mid);
+				leaf->next = left->next;
+				left->next = leaf;
+				new(&parentKeys[index]) K(leaf->keys()[0]);
+				right = leaf;
+			}
+			else {
+				Inner* left = static_cast<Inner*>(child);
+				Inner* inner = createNode<Inner>();
+				size_t mid = innerSlots / 2;
+				relocate(inner->keys(), left->keys() + mid + 1, left->count - mid - 1);
+				for (size_t i = mid + 1; i <= left->count; i++)
+					inner->children[i - mid - 1] = left->children[i];
+				inner->count = static_cast<uint16_t>(left->count - mid - 1);
+				relocate(&parentKeys[index], left->keys() + mid, 1);
+				left->count = static_cast<uint16_t>(mid);
+				right = inner;
+			}
+
+			for (size_t i = parent->count + 1; i > index + 1; i--)
+				parent->children[i] = parent->children[i - 1];
+			parent->children[index + 1] = right;
+			parent->count++;
+		}
+
+		/**
+		 * Checks if a node has no room for another key
+		 * @param node The node to check
+		 * @returns Whether or not the node is full
+		 */
+		static bool full(const Node* node) {
+			return node->count == (node->leaf ? leafSlots : innerSlots);
+		}
+
+		/**
+		 * Finds the element with a key, adding it if it isn't in the tree (splits full nodes on the way down)
+		 * The new element is constructed in a gap made in its leaf and only counted once it exists, if constructing it throws the
+		 * gap is closed again so the tree is left as it was
+		 * @param key The key to search for, moved into the new element if one is added
+		 * @param constructValue Constructs the value of a new element in uninitialized memory (maps only, not called for sets)
+		 * @returns The position of the element, and whether or not it was added
+		 */
+		template<typename F> std::pair<EntryIterator<false>, bool> findOrClaim(K& key, F&& constructValue) {
+			if (root == nullptr) {
+				head = createNode<Leaf>();
+				root = head;
+			}
+			if (full(root)) {
+				Inner* inner = createNode<Inner>();
+				inner->children[0] = root;
+				root = inner;
+				splitChild(inner, 0);
+			}
+
+			Node* node = root;
+			while (!node->leaf) {
+				Inner* inner = static_cast<Inner*>(node);
+				size_t index = upperIndex(inner->keys(), inner->count, key);
+				if (full(inner->children[index])) {
+					splitChild(inner, index);
+					if (!compare(key, inner->keys()[index])) index++;
+				}
+				node = inner->children[index];
+			}
+
+			Leaf* leaf = static_cast<Leaf*>(node);
+			size_t index = lowerIndex(leaf->keys(), leaf->count, key);
+			if (index < leaf->count && !compare(key, leaf->keys()[index]))
+				return { EntryIterator<false>(leaf, index), false };
+
+			size_t after = leaf->count - index;
+			relocateOverlapping(leaf->keys() + index + 1, leaf->keys() + index, after);
+			if constexpr (isMap) relocateOverlapping(leaf->values() + index + 1, leaf->values() + index, after);
+			bool keyConstructed = false;
+			try {
+				new(&leaf->keys()[index]) K(std::move(key));
+				keyConstructed = true;
+				if constexpr (isMap) constructValue(&leaf->values()[index]);
+			}
+			catch (...) {
+				if (keyConstructed) destroy(leaf->keys() + index, 1);
+				relocateOverlapping(leaf->keys() + index, leaf->keys() + index + 1, after);
+				if constexpr (isMap) relocateOverlapping(leaf->values() + index, leaf->values() + index + 1, after);
+				if (size == 0) {
+					freeNode(root);
+					root = nullptr;
+					head = nullptr;
+				}
+				throw;
+			}
+			leaf->count++;
+			size++;
+			return { EntryIterator<false>(leaf, index), true };
+		}
+
+		/**
+		 * Moves the last element of the left sibling of a child into the child
+		 * @param parent The node of the child
+		 * @param index The index of the child (greater than 0)
+		 */
+		void borrowFromLeft(Inner* parent, size_t index) {
+			K* parentKeys = parent->keys();
+			if (parent->children[index]->leaf) {
+				Leaf* left = static_cast<Leaf*>(parent->children[index - 1]);
+				Leaf* child = static_cast<Leaf*>(parent->children[index]);
+				relocateOverlapping(child->keys() + 1, child->keys(), child->count);
+				relocate(child->keys(), left->keys() + left->count - 1, 1);
+				if constexpr (isMap) {
+					relocateOverlapping(child->values() + 1, child->values(), child->count);
+					relocate(child->values(), left->values() + left->count - 1, 1);
+				}
+				left->count--;
+				child->count++;
+				parentKeys[index - 1] = child->keys()[0];
+			}
+			else {
+				Inner* left = static_cast<Inner*>(parent->children[index - 1]);
+				Inner* child = static_cast<Inner*>(parent->children[index]);
+				relocateOverlapping(child->keys() + 1, child->keys(), child->count);
+				for (size_t i = child->count + 1; i > 0; i--)
+					child->children[i] = child->children[i - 1];
+				relocate(child->keys(), &parentKeys[index - 1], 1);
+				child->children[0] = left->children[left->count];
+				relocate(&parentKeys[index - 1], left->keys() + left->count - 1, 1);
+				left->count--;
+				child->count++;
+			}
+		}
+
+		/**
+		 * Moves the first element of the right sibling of a child into the child
+		 * @param parent The node of the child
+		 * @param index The index of the child (less than the number of keys of the parent)
+		 */
+		void borrowFromRight(Inner* parent, size_t index) {
+			K* parentKeys = parent->keys();
+			if (parent->children[index]->leaf) {
+				Leaf* child = static_cast<Leaf*>(parent->children[index]);
+				Leaf* right = static_cast<Leaf*>(parent->children[index + 1]);
+				relocate(child->keys() + child->count, right->keys(), 1);
+				relocateOverlapping(right->keys(), right->keys() + 1, right->count - 1);
+				if constexpr (isMap) {
+					relocate(child->values() + child->count, right->values(), 1);
+					relocateOverlapping(right->values(), right->values() + 1, right->count - 1);
+				}
+				child->count++;
+				right->count--;
+				parentKeys[index] = right->keys()[0];
+			}
+			else {
+				Inner* child = static_cast<Inner*>(parent->children[index]);
+				Inner* right = static_cast<Inner*>(parent->children[index + 1]);
+				relocate(child->keys() + child->count, &parentKeys[index], 1);
+				child->children[child->count + 1] = right->children[0];
+				relocate(&parentKeys[index], right->keys(), 1);
+				relocateOverlapping(right->keys(), right->keys() + 1, right->count - 1);
+				for (size_t i = 0; i < right->count; i++)
+					right->children[i] = right->children[i + 1];
+				child->count++;
+				right->count--;
+			}
+		}
+
+		/**
+		 * Merges the right sibling of a child into the child and removes their separator from the parent
+		 * @param parent The node of the child
+		 * @param index The index of the child (less than the number of keys of the parent)
+		 */
+		void mergeChildren(Inner* parent, size_t index) {
+			K* parentKeys = parent->keys();
+			if (parent->children[index]->leaf) {
+				Leaf* child = static_cast<Leaf*>(parent->children[index]);
+				Leaf* right = static_cast<Leaf*>(parent->children[index + 1]);
+				relocate(child->keys() + child->count, right->keys(), right->count);
+				if constexpr (isMap) relocate(child->values() + child->count, right->values(), right->count);
+				child->count = static_cast<uint16_t>(child->count + right->count);
+				child->next = right->next;
+				destroy(&parentKeys[index], 1);
+			}
+			else {
+				Inner* child = static_cast<Inner*>(parent->children[index]);
+				Inner* right = static_cast<Inner*>(parent->children[index + 1]);
+				relocate(child->keys() + child->count, &parentKeys[index], 1);
+				relocate(child->keys() + child->count + 1, right->keys(), right->count);
+				for (size_t i = 0; i <= right->count; i++)
+					child->children[child->count + 1 + i] = right->children[i];
+				child->count = static_cast<uint16_t>(child->count + 1 + right->count);
+			}
+
+			freeNode(parent->children[index + 1]);
+			relocateOverlapping(parentKeys + index, parentKeys + index + 1, parent->count - index - 1);
+			for (size_t i = index + 1; i < parent->count; i++)
+				parent->children[i] = parent->children[i + 1];
+			parent->count--;
+		}
+
+		/**
+		 * Makes sure a child has more than the minimum number of keys before descending into it
+		 * @param parent The node of the child
+		 * @param index The index of the child
+		 * @returns The index of the child which now covers the same keys
+		 */
+		size_t fillChild(Inner* parent, size_t index) {
+			size_t minimum = parent->children[index]->leaf ? leafMin : innerMin;
+			if (index > 0 && parent->children[index - 1]->count > minimum) {
+				borrowFromLeft(parent, index);
+				return index;
+			}
+			if (index < parent->count && parent->children[index + 1]->count > minimum) {
+				borrowFromRight(parent, index);
+				return index;
+			}
+			if (index > 0) {
+				mergeChildren(parent, index - 1);
+				return index - 1;
+			}
+			mergeChildren(parent, index);
+			return index;
+		}
+
+		/**
+		 * Builds the tree from sorted keys, keeping the first of any equal keys
+		 * @param keys The sorted keys
+		 * @param fillValue Constructs the value of the key at an index of the list in uninitialized memory
+		 */
+		template<typename L, typename F> void build(const L& keys, F fillValue) {
+			clear();
+			size_t count = keys.length();
+			size_t unique = 0;
+			for (size_t i = 0; i < count; i++) {
+				assert(i == 0 || !compare(keys[i], keys[i - 1]));
+				if (i == 0 || compare(keys[i - 1], keys[i])) unique++;
+			}
+			if (unique == 0) return;
+
+			// Spread the elements evenly so every node is at least half full
+			ArrayList<Node*> level;
+			ArrayList<const K*> lowest;
+			size_t leaves = (unique + leafSlots - 1) / leafSlots;
+			size_t source = 0;
+			Leaf* previous = nullptr;
+			for (size_t l = 0; l < leaves; l++) {
+				size_t take = unique / leaves + (l < unique % leaves ? 1 : 0);
+				Leaf* leaf = createNode<Leaf>();
+				for (size_t i = 0; i < take; i++) {
+					new(&leaf->keys()[i]) K(keys[source]);
+					if constexpr (isMap) fillValue(&leaf->values()[i], source);
+					source++;
+					while (source < count && !compare(keys[source - 1], keys[source]))
+						source++;
+				}
+				leaf->count = static_cast<uint16_t>(take);
+				if (previous == nullptr) head = leaf;
+				else previous->next = leaf;
+				previous = leaf;
+				level.push(leaf);
+				lowest.push(&leaf->keys()[0]);
+			}
+
+			while (level.length() > 1) {
+				ArrayList<Node*> parents;
+				ArrayList<const K*> parentLowest;
+				size_t children = level.length();
+				size_t groups = (children + innerSlots) / (innerSlots + 1);
+				size_t child = 0;
+				for (size_t g = 0; g < groups; g++) {
+					size_t take = children / groups + (g < children % groups ? 1 : 0);
+					Inner* inner = createNode<Inner>();
+					inner->children[0] = level[child];
+					for (size_t i = 1; i < take; i++) {
+						new(&inner->keys()[i - 1]) K(*lowest[child + i]);
+						inner->children[i] = level[child + i];
+					}
+					inner->count = static_cast<uint16_t>(take - 1);
+					parents.push(inner);
+					parentLowest.push(lowest[child]);
+					child += take;
+				}
+				level = std::move(parents);
+				lowest = std::move(parentLowest);
+			}
+
+			root = level[0];
+			size = unique;
+		}
+
+	public:
+		/**
+		 * An iterator over the elements of the tree in order
+		 */
+		using Iterator = EntryIterator<false>;
+
+		/**
+		 * An iterator over the elements of a constant tree in order
+		 */
+		using ConstIterator = EntryIterator<true>;
+
+		/**
+		 * Creates a new empty BTree (Does not allocate until the first element is added)
+		 */
+		BTree() = default;
+
+		/**
+		 * Creates a new empty BTree which allocates from an allocator
+		 * @param allocator The allocator to request the nodes from
+		 */
+		BTree(const Allocator& allocator) : Allocator(allocator) {}
+
+		/**
+		 * Creates a new set from sorted keys in linear time (sets only)
+		 * @param keys The keys, sorted by Compare (only the first of equal keys is kept)
+		 * @param allocator The allocator to request the nodes from
+		 */
+		template<typename L, typename = std::enable_if_t<isList<L> && !isMap>>
+		BTree(const L& keys, const Allocator& allocator = Allocator()) : Allocator(allocator) {
+			build(keys, [](Value*, size_t) {});
+		}
+
+		/**
+		 * Creates a new map from sorted keys and their values in linear time (maps only)
+		 * @param keys The keys, sorted by Compare (only the first of equal keys is kept)
+		 * @param values The values of the keys (the same length as keys)
+		 * @param allocator The allocator to request the nodes from
+		 */
+		template<typename KL, typename VL, typename = std::enable_if_t<isList<KL> && isList<VL> && isMap>>
+		BTree(const KL& keys, const VL& values, const Allocator& allocator = Allocator()) : Allocator(allocator) {
+			assert(keys.length() == values.length());
+			build(keys, [&](Value* value, size_t index) { new(value) Value(values[index]); });
+		}
+
+		/**
+		 * Creates a copy of another BTree (Using the same allocator)
+		 * @param other The tree to copy
+		 */
+		BTree(const BTree& other) : Allocator(other), compare(other.compare) {
+			copyFrom(other);
+		}
+
+		/**
+		 * Takes the nodes of another BTree, leaving it empty
+		 * @param other The tree to move from
+		 */
+		BTree(BTree&& other) noexcept : Allocator(other), compare(other.compare), root(other.root), head(other.head), size(other.size) {
+			other.root = nullptr;
+			other.head = nullptr;
+			other.size = 0;
+		}
+
+		/**
+		 * Replaces the contents of this tree with a copy of another BTree
+		 * @param other The tree to copy
+		 * @returns This tree
+		 */
+		BTree& operator=(const BTree& other) {
+			if (this != &other) {
+				clear();
+				compare = other.compare;
+				copyFrom(other);
+			}
+			return *this;
+		}
+
+		/**
+		 * Replaces the contents of this tree with the nodes (and allocator) of another BTree
+		 * @param other The tree to move from
+		 * @returns This tree
+		 */
+		BTree& operator=(BTree&& other) noexcept {
+			if (this != &other) {
+				clear();
+				allocator() = static_cast<Allocator&>(other);
+				compare = other.compare;
+				std::swap(root, other.root);
+				std::swap(head, other.head);
+				std::swap(size, other.size);
+			}
+			return *this;
+		}
+
+		/**
+		 * Frees resources
+		 */
+		~BTree() {
+			clear();
+		}
+
+		/**
+		 * Gets the value of a key, inserting a default constructed value if it isn't in the map (maps only)
+		 * @param key The key of the value
+		 * @returns The value of the key
+		 */
+		template<typename U = V, typename = std::enable_if_t<!std::is_void_v<U>>>
+		U& operator[](const K& key) {
+			return emplace(key);
+		}
+
+		/**
+		 * Gets the value of a key, constructing a new value from the arguments if it isn't in the map (maps only)
+		 * @param key The key of the value
+		 * @param args The arguments to construct the value with (unused if the key exists)
+		 * @returns The value of the key
+		 */
+		template<typename KK, typename... Args, typename U = V, typename = std::enable_if_t<!std::is_void_v<U>>>
+		U& emplace(KK&& key, Args&&... args) {
+			K converted(std::forward<KK>(key));
+			if constexpr (sizeof...(Args) == 0) {
+				return findOrClaim(converted, [](Value* slot) { new(slot) V(); }).first.value();
+			}
+			else {
+				Iterator found = findPosition<false>(converted);
+				if (found != end()) return found.value();
+				// Built before the tree changes, as the arguments may refer to elements which splitting or the gap would move
+				V value(std::forward<Args>(args)...);
+				return findOrClaim(converted, [&](Value* slot) { new(slot) V(std::move(value)); }).first.value();
+			}
+		}
+
+		/**
+		 * Adds a new element to the tree if the key isn't already in it
+		 * @param key The key of the element
+		 * @param value The value of the element (maps only)
+		 * @returns Whether or not the element was added
+		 */
+		template<typename KK, typename... VV>
+		bool insert(KK&& key, VV&&... value) {
+			static_assert(sizeof...(VV) == (isMap ? 1 : 0), "Maps insert a key and a value, sets insert only a key");
+			K converted(std::forward<KK>(key));
+			if constexpr (isMap) {
+				// Built before the tree changes, as the value may refer to an element which splitting or the gap would move
+				V built(std::forward<VV>(value)...);
+				return findOrClaim(converted, [&](Value* slot) { new(slot) V(std::move(built)); }).second;
+			}
+			else return findOrClaim(converted, [](Value*) {}).second;
+		}
+
+		/**
+		 * Sets the value of a key, adding it if it isn't in the map (maps only)
+		 * @param key The key of the element
+		 * @param value The new value of the element
+		 */
+		template<typename KK, typename VV, typename U = V, typename = std::enable_if_t<!std::is_void_v<U>>>
+		void set(KK&& key, VV&& value) {
+			K converted(std::forward<KK>(key));
+			// Built before the tree changes, as the value may refer to an element which splitting or the gap would move
+			V built(std::forward<VV>(value));
+			std::pair<Iterator, bool> slot = findOrClaim(converted, [&](Value* slot) { new(slot) V(std::move(built)); });
+			if (!slot.second)
+				slot.first.value() = std::move(built);
+		}
+
+		/**
+		 * Gets the value of a key (maps only)
+		 * @param key The key of the value
+		 * @returns The value (nullptr if the key isn't in the map)
+		 */
+		template<typename U = V, typename = std::enable_if_t<!std::is_void_v<U>>>
+		U* get(const K& key) {
+			Iterator position = findPosition<false>(key);
+			return position == end() ? nullptr : &position.value();
+		}
+
+		/**
+		 * Gets the value of a key (maps only)
+		 * @param key The key of the value
+		 * @returns The value (nullptr if the key isn't in the map)
+		 */
+		template<typename U = V, typename = std::enable_if_t<!std::is_void_v<U>>>
+		const U* get(const K& key) const {
+			ConstIterator position = findPosition<true>(key);
+			return position == end() ? nullptr : &position.value();
+		}
+
+		/**
+		 * Checks if a key is in the tree
+		 * @param key The key to check for
+		 * @returns Whether or not the tree contains the key
+		 */
+		bool contains(const K& key) const {
+			return findPosition<true>(key) != end();
+		}
+
+		/**
+		 * Removes the element with a key (rebalances on the way down so no node is left less than half full)
+		 * @param key The key of the element to remove
+		 * @returns Whether or not an element was removed
+		 */
+		bool remove(const K& key) {
+			if (root == nullptr) return false;
+			Node* node = root;
+			while (!node->leaf) {
+				Inner* inner = static_cast<Inner*>(node);
+				size_t index = upperIndex(inner->keys(), inner->count, key);
+				Node* child = inner->children[index];
+				if (child->count <= (child->leaf ? leafMin : innerMin))
+					index = fillChild(inner, index);
+				node = inner->children[index];
+				if (inner == root && inner->count == 0) {
+					root = node;
+					freeNode(inner);
+				}
+			}
+
+			Leaf* leaf = static_cast<Leaf*>(node);
+			size_t index = lowerIndex(leaf->keys(), leaf->count, key);
+			if (index == leaf->count || compare(key, leaf->keys()[index])) return false;
+			destroy(leaf->keys() + index, 1);
+			relocateOverlapping(leaf->keys() + index, leaf->keys() + index + 1, leaf->count - index - 1);
+			if constexpr (isMap) {
+				destroy(leaf->values() + index, 1);
+				relocateOverlapping(leaf->values() + index, leaf->values() + index + 1, leaf->count - index - 1);
+			}
+			leaf->count--;
+			size--;
+			if (size == 0) {
+				freeNode(root);
+				root = nullptr;
+				head = nullptr;
+			}
+			return true;
+		}
+
+		/**
+		 * Removes every element from the tree and frees the nodes
+		 */
+		void clear() {
+			if (root != nullptr)
+				freeTree(root);
+			root = nullptr;
+			head = nullptr;
+			size = 0;
+		}
+
+		/**
+		 * Gets the first element not less than a key
+		 * @param key The key to search for
+		 * @returns An iterator at the element (the end if every key is less)
+		 */
+		Iterator lowerBound(const K& key) {
+			return lowerPosition<false>(key);
+		}
+
+		/**
+		 * Gets the first element not less than a key
+		 * @param key The key to search for
+		 * @returns An iterator at the element (the end if every key is less)
+		 */
+		ConstIterator lowerBound(const K& key) const {
+			return lowerPosition<true>(key);
+		}
+
+		/**
+		 * Gets the first element greater than a key
+		 * @param key The key to search for
+		 * @returns An iterator at the element (the end if no key is greater)
+		 */
+		Iterator upperBound(const K& key) {
+			return upperPosition<false>(key);
+		}
+
+		/**
+		 * Gets the first element greater than a key
+		 * @param key The key to search for
+		 * @returns An iterator at the element (the end if no key is greater)
+		 */
+		ConstIterator upperBound(const K& key) const {
+			return upperPosition<true>(key);
+		}
+
+		/**
+		 * Gets the element with a key
+		 * @param key The key to search for
+		 * @returns An iterator at the element (the end if the key isn't in the tree)
+		 */
+		Iterator find(const K& key) {
+			return findPosition<false>(key);
+		}
+
+		/**
+		 * Gets the element with a key
+		 * @param key The key to search for
+		 * @returns An iterator at the element (the end if the key isn't in the tree)
+		 */
+		ConstIterator find(const K& key) const {
+			return findPosition<true>(key);
+		}
+
+		/**
+		 * Gets the elements with keys in a range, in order
+		 * @param low The smallest key of the range
+		 * @param high One past the largest key of the range (excluded)
+		 * @returns A view of the elements (see Iterable)
+		 */
+		Iterable<Iterator> range(const K& low, const K& high) {
+			if (!compare(low, high)) return Iterable<Iterator>(end(), end());
+			return Iterable<Iterator>(lowerPosition<false>(low), lowerPosition<false>(high));
+		}
+
+		/**
+		 * Gets the elements with keys in a range, in order
+		 * @param low The smallest key of the range
+		 * @param high One past the largest key of the range (excluded)
+		 * @returns A view of the elements (see Iterable)
+		 */
+		Iterable<ConstIterator> range(const K& low, const K& high) const {
+			if (!compare(low, high)) return Iterable<ConstIterator>(end(), end());
+			return Iterable<ConstIterator>(lowerPosition<true>(low), lowerPosition<true>(high));
+		}
+
+		/**
+		 * Returns the length of the data structure
+		 * @returns The number of elements in the tree
+		 */
+		size_t length() const {
+			return size;
+		}
+
+		/**
+		 * Gets an iterator at the smallest element
+		 * @returns The iterator
+		 */
+		Iterator begin() {
+			return Iterator(head, 0);
+		}
+
+		/**
+		 * Gets an iterator past the largest element
+		 * @returns The iterator
+		 */
+		Iterator end() {
+			return Iterator(nullptr, 0);
+		}
+
+		/**
+		 * Gets an iterator at the smallest element
+		 * @returns The iterator
+		 */
+		ConstIterator begin() const {
+			return ConstIterator(head, 0);
+		}
+
+		/**
+		 * Gets an iterator past the largest element
+		 * @returns The iterator
+		 */
+		ConstIterator end() const {
+			return ConstIterator(nullptr, 0);
+		}
+	};
+
+	/**
+	 * An ordered map stored as a B+ tree (see BTree)
+	 */
+	template<typename K, typename V, typename Compare = std::less<K>, typename Allocator = HeapAllocator>
+	using BTreeMap = BTree<K, V, Compare, Allocator>;
+
+	/**
+	 * An ordered set stored as a B+ tree (see BTree)
+	 */
+	template<typename K, typename Compare = std::less<K>, typename Allocator = HeapAllocator>
+	using BTreeSet = BTree<K, void, Compare, Allocator>;
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
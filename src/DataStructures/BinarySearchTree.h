@@ -0,0 +1,288 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "List.h"
+#include "Memory.h"
+#include "Allocator.h"
+#include <assert.h>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+/**
+ * The main namespace for data structures in the essentials library
+ */
+namespace Essentials::DataStructures {
+
+	/**
+	 * A namespace alias to the data structures namespace
+	 */
+	namespace ds = DataStructures;
+
+	/**
+	 * A read only binary search tree stored implicitly in an array in Eytzinger (breadth first) order
+	 *
+	 * Node k has its children at 2k and 2k + 1, so the top levels of the tree share a few cache lines and
+	 * the descendants of a node several levels down are contiguous and can be prefetched while comparing.
+	 * Built once from sorted elements, use BTree for a tree which is modified after it is built.
+	 * @tparam Compare The strict weak ordering of the elements
+	 * @tparam Allocator The allocator the nodes are requested from (see HeapAllocator)
+	 */
+	template<typename T, typename Compare = std::less<T>, typename Allocator = HeapAllocator>
+	class BinarySearchTree : private Allocator {
+	private:
+		/**
+		 * The number of nodes whose descendants are prefetched together (the elements of one cache line)
+		 */
+		static constexpr size_t prefetchBlock = sizeof(T) >= cacheLineSize ? 1 : cacheLineSize / sizeof(T);
+
+		/**
+		 * The ordering of the elements
+		 */
+		Compare compare;
+
+		/**
+		 * The nodes of the tree (1 indexed, the root is nodes[1] and nodes[0] is never constructed)
+		 */
+		T* nodes = nullptr;
+
+		/**
+		 * The number of elements in the tree
+		 */
+		size_t size = 0;
+
+		/**
+		 * Returns the allocator the nodes are requested from
+		 * @returns The allocator of the tree
+		 */
+		Allocator& allocator() {
+			return *this;
+		}
+
+		/**
+		 * Allocates the nodes for a number of elements
+		 * @param num The number of elements
+		 */
+		void allocateNodes(size_t num) {
+			size = num;
+			if (num != 0)
+				nodes = static_cast<T*>(allocator().allocate((num + 1) * sizeof(T), alignof(T) > cacheLineSize ? alignof(T) : cacheLineSize));
+		}
+
+		/**
+		 * Destroys the elements and frees the nodes
+		 */
+		void freeNodes() {
+			if (nodes != nullptr) {
+				destroy(nodes + 1, size);
+				allocator().deallocate(nodes, (size + 1) * sizeof(T), alignof(T) > cacheLineSize ? alignof(T) : cacheLineSize);
+			}
+			nodes = nullptr;
+			size = 0;
+		}
+
+		/**
+		 * Fills the subtree rooted at a node with the next elements of a sorted list (in order traversal)
+		 * @param sorted The sorted elements
+		 * @param next The index of the next element of the list to place
+		 * @param node The root of the subtree to fill
+		 * @returns The index of the next element of the list after the subtree is filled
+		 */
+		template<typename L> size_t fill(const L& sorted, size_t next, size_t node) {
+			if (node <= size) {
+				next = fill(sorted, next, 2 * node);
+				new(&nodes[node]) T(sorted[next++]);
+				next = fill(sorted, next, 2 * node + 1);
+			}
+			return next;
+		}
+
+		/**
+		 * Finds the first node which the predicate is false for, with every node before it in order being true
+		 * @param goRight Checks if a node is before the searched position
+		 * @returns The index of the node (0 if every node is before the position)
+		 */
+		template<typename P> size_t search(P goRight) const {
+			size_t node = 1;
+			while (node <= size) {
+#if defined(__GNUC__) || defined(__clang__)
+				__builtin_prefetch(nodes + node * prefetchBlock);
+#endif
+				node = 2 * node + static_cast<size_t>(goRight(nodes[node]));
+			}
+			// The path ends with a run of right turns after the last left turn, which is the answer
+#if defined(__GNUC__) || defined(__clang__)
+			return node >> __builtin_ffsll(static_cast<long long>(~node));
+#else
+			while (node & 1)
+				node >>= 1;
+			return node >> 1;
+#endif
+		}
+
+		/**
+		 * Counts the nodes of a subtree of the complete tree
+		 * @param node The root of the subtree
+		 * @returns The number of nodes in the subtree
+		 */
+		size_t subtreeSize(size_t node) const {
+			size_t count = 0;
+			for (size_t first = node, last = node; first <= size; first = 2 * first, last = 2 * last + 1)
+				count += (last <= size ? last : size) - first + 1;
+			return count;
+		}
+
+	public:
+		/**
+		 * Creates a new empty BinarySearchTree
+		 */
+		BinarySearchTree() = default;
+
+		/**
+		 * Creates a new BinarySearchTree from sorted elements
+		 * @param sorted The elements of the tree, sorted by Compare (duplicates are allowed)
+		 * @param allocator The allocator to request the nodes from
+		 */
+		template<typename L, typename = std::enable_if_t<isList<L>>>
+		BinarySearchTree(const L& sorted, const Allocator& allocator = Allocator()) : Allocator(allocator) {
+			for (size_t i = 1; i < sorted.length(); i++)
+				assert(!compare(sorted[i], sorted[i - 1]));
+			allocateNodes(sorted.length());
+			fill(sorted, 0, 1);
+		}
+
+		/**
+		 * Creates a copy of another BinarySearchTree (Using the same allocator)
+		 * @param other The tree to copy
+		 */
+		BinarySearchTree(const BinarySearchTree& other) : Allocator(other), compare(other.compare) {
+			allocateNodes(other.size);
+			for (size_t i = 1; i <= size; i++)
+				new(&nodes[i]) T(other.nodes[i]);
+		}
+
+		/**
+		 * Takes the nodes of another BinarySearchTree, leaving it empty
+		 * @param other The tree to move from
+		 */
+		BinarySearchTree(BinarySearchTree&& other) noexcept : Allocator(other), compare(other.compare), nodes(other.nodes), size(other.size) {
+			other.nodes = nullptr;
+			other.size = 0;
+		}
+
+		/**
+		 * Replaces the contents of this tree with a copy of another BinarySearchTree
+		 * @param other The tree to copy
+		 * @returns This tree
+		 */
+		BinarySearchTree& operator=(const BinarySearchTree& other) {
+			if (this != &other) {
+				freeNodes();
+				compare = other.compare;
+				allocateNodes(other.size);
+				for (size_t i = 1; i <= size; i++)
+					new(&nodes[i]) T(other.nodes[i]);
+			}
+			return *this;
+		}
+
+		/**
+		 * Replaces the contents of this tree with the nodes (and allocator) of another BinarySearchTree
+		 * @param other The tree to move from
+		 * @returns This tree
+		 */
+		BinarySearchTree& operator=(BinarySearchTree&& other) noexcept {
+			if (this != &other) {
+				freeNodes();
+				allocator() = static_cast<Allocator&>(other);
+				compare = other.compare;
+				std::swap(nodes, other.nodes);
+				std::swap(size, other.size);
+			}
+			return *this;
+		}
+
+		/**
+		 * Frees resources
+		 */
+		~BinarySearchTree() {
+			freeNodes();
+		}
+
+		/**
+		 * Finds the smallest element which is not less than an item
+		 * @param item The item to search for
+		 * @returns The element (nullptr if every element is less than the item)
+		 */
+		const T* lowerBound(const T& item) const {
+			size_t node = search([&](const T& element) { return compare(element, item); });
+			return node == 0 ? nullptr : &nodes[node];
+		}
+
+		/**
+		 * Finds the smallest element which is greater than an item
+		 * @param item The item to search for
+		 * @returns The element (nullptr if no element is greater than the item)
+		 */
+		const T* upperBound(const T& item) const {
+			size_t node = search([&](const T& element) { return !compare(item, element); });
+			return node == 0 ? nullptr : &nodes[node];
+		}
+
+		/**
+		 * Checks if an element is in the tree (Uses Compare to check for equivalence)
+		 * @param item The item to check for
+		 * @returns Whether or not the tree contains the element
+		 */
+		bool contains(const T& item) const {
+			const T* element = lowerBound(item);
+			return element != nullptr && !compare(item, *element);
+		}
+
+		/**
+		 * Counts the elements which are less than an item
+		 * @param item The item to compare against
+		 * @returns The number of elements less than the item
+		 */
+		size_t rank(const T& item) const {
+			size_t count = 0;
+			size_t node = 1;
+			while (node <= size) {
+				if (compare(nodes[node], item)) {
+					count += 1 + subtreeSize(2 * node);
+					node = 2 * node + 1;
+				}
+				else node = 2 * node;
+			}
+			return count;
+		}
+
+		/**
+		 * Returns the length of the data structure
+		 * @returns The number of elements in the tree
+		 */
+		size_t length() const {
+			return size;
+		}
+	};
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
 /**
  * The main namespace for data structures in the essentials library
  */
@@ -27,16 +31,46 @@ namespace Essentials::DataStructures {
 	namespace ds = DataStructures;
 
 	/**
-	 * All data structures must inherit from this class
+	 * The runtime polymorphic interface of every container
+	 * Containers don't inherit from this class (so their calls can be inlined), wrap them in a reference type instead
 	 */
 	template<typename T> class Container {
 	public:
+		/**
+		 * Destroys the container interface
+		 */
+		virtual ~Container() = default;
+
 		/**
 		 * Returns the length of the data structure
 		 * @returns The length of the data structure
 		 */
 		virtual size_t length() const = 0;
 	};
+
+	/**
+	 * Checks at compile time if a type satisfies the container contract (has a length)
+	 */
+	template<typename C, typename = void> struct IsContainer : std::false_type {};
+
+	/**
+	 * Checks at compile time if a type satisfies the container contract (has a length)
+	 */
+	template<typename C> struct IsContainer<C, std::void_t<
+		decltype(static_cast<size_t>(std::declval<const C&>().length()))
+	>> : std::true_type {};
+
+	/**
+	 * Whether or not a type satisfies the container contract
+	 */
+	template<typename C> inline constexpr bool isContainer = IsContainer<C>::value;
+
+#ifdef __cpp_concepts
+	/**
+	 * A type which satisfies the container contract
+	 */
+	template<typename C> concept ContainerType = isContainer<C>;
+#endif
 }
 
 /**
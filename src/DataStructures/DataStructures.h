@@ -16,6 +16,11 @@
 
 #pragma once
 
+// Memory
+#include "Memory.h"
+#include "Allocator.h"
+#include "Search.h"
+
 // Iterators
 #include "Iterator.h"
 #include "Iterable.h"
@@ -43,6 +48,7 @@
 #include "Tree.h"
 #include "BinaryTree.h"
 #include "BinarySearchTree.h"
+#include "BTree.h"
 #include "Heap.h"
 
 // Other
@@ -0,0 +1,1017 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "ArrayList.h"
+#include "../Threading/Parallel.h"
+#include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+
+/**
+ * The main namespace for data structures in the essentials library
+ */
+namespace Essentials::DataStructures {
+
+	/**
+	 * A namespace alias to the data structures namespace
+	 */
+	namespace ds = DataStructures;
+
+	/**
+	 * The id of a vertex of a graph (vertices are numbered from 0)
+	 */
+	using Vertex = uint32_t;
+
+	/**
+	 * The amount of work done by a graph algorithm
+	 */
+	struct TraversalStats {
+		/**
+		 * The number of edges the algorithm looked at
+		 */
+		size_t edgesVisited = 0;
+
+		/**
+		 * The wall clock time the algorithm took in seconds
+		 */
+		double seconds = 0;
+
+		/**
+		 * Gets the traversal rate of the algorithm
+		 * @returns The number of edges visited per second
+		 */
+		double edgesPerSecond() const {
+			return seconds > 0 ? static_cast<double>(edgesVisited) / seconds : 0;
+		}
+	};
+
+	template<typename W> class Graph;
+
+	/**
+	 * Collects the edges of a graph before it is frozen into a Graph
+	 * @tparam W The type of the edge weights (void for an unweighted graph)
+	 */
+	template<typename W = void> class GraphBuilder {
+	private:
+		friend class Graph<W>;
+
+		/**
+		 * Whether or not the graph stores weights
+		 */
+		static constexpr bool weighted = !std::is_void_v<W>;
+
+		/**
+		 * The stored weight type (a placeholder which is never stored for unweighted graphs)
+		 */
+		using Weight = std::conditional_t<weighted, W, char>;
+
+		/**
+		 * Whether or not edges only go from their source to their target
+		 */
+		bool directed;
+
+		/**
+		 * The number of vertices of the graph
+		 */
+		size_t vertices = 0;
+
+		/**
+		 * The source of every edge
+		 */
+		ArrayList<Vertex> sources;
+
+		/**
+		 * The target of every edge
+		 */
+		ArrayList<Vertex> targets;
+
+		/**
+		 * The weight of every edge (empty for unweighted graphs)
+		 */
+		ArrayList<Weight> weights;
+
+		/**
+		 * Parses an unsigned integer
+		 * @param text The text to parse from (advanced past the number)
+		 * @param value The parsed number
+		 * @returns Whether or not a number was parsed
+		 */
+		static bool parseVertex(const char*& text, uint64_t& value) {
+			while (*text == ' ' || *text == '\t' || *text == ',') text++;
+			if (*text < '0' || *text > '9') return false;
+			value = 0;
+			while (*text >= '0' && *text <= '9')
+				value = value * 10 + static_cast<uint64_t>(*text++ - '0');
+			return true;
+		}
+
+		/**
+		 * Checks if a character ends a field of an edge list line
+		 * @param c The character
+		 * @returns Whether or not it is a separator or the end of the line
+		 */
+		static bool fieldEnd(char c) {
+			return c == ' ' || c == '\t' || c == ',' || c == '\0' || c == '\r';
+		}
+
+		/**
+		 * Parses a line of an edge list as "source target [weight]"
+		 * The same rule holds for weighted and unweighted graphs: the weight is optional (and ignored by unweighted graphs),
+		 * every field must be a whole number, and anything after the weight makes the line invalid
+		 * @param line The line (null terminated, without the newline)
+		 * @returns Whether or not the line was valid
+		 */
+		bool parseLine(const char* line) {
+			while (*line == ' ' || *line == '\t') line++;
+			if (*line == '\0' || *line == '\r' || *line == '#' || *line == '%') return true;
+
+			uint64_t from;
+			uint64_t to;
+			if (!parseVertex(line, from) || !parseVertex(line, to) || !fieldEnd(*line)) return false;
+			if (from >= std::numeric_limits<Vertex>::max() || to >= std::numeric_limits<Vertex>::max()) return false;
+
+			double weight = 1;
+			while (*line == ' ' || *line == '\t' || *line == ',') line++;
+			if (*line != '\0' && *line != '\r') {
+				char* end;
+				weight = std::strtod(line, &end);
+				if (end == line || !fieldEnd(*end) || !(weight >= 0)) return false;
+				line = end;
+				while (*line == ' ' || *line == '\t' || *line == ',') line++;
+				if (*line != '\0' && *line != '\r') return false;
+			}
+
+			if constexpr (weighted) addEdge(static_cast<Vertex>(from), static_cast<Vertex>(to), static_cast<W>(weight));
+			else addEdge(static_cast<Vertex>(from), static_cast<Vertex>(to));
+			return true;
+		}
+
+	public:
+		/**
+		 * Creates a new empty GraphBuilder
+		 * @param directed Whether or not edges only go from their source to their target
+		 */
+		GraphBuilder(bool directed = true) : directed(directed) {}
+
+		/**
+		 * Adds a new vertex with no edges
+		 * @returns The id of the vertex
+		 */
+		Vertex addVertex() {
+			return static_cast<Vertex>(vertices++);
+		}
+
+		/**
+		 * Makes sure the graph has at least a number of vertices
+		 * @param count The number of vertices
+		 */
+		void addVertices(size_t count) {
+			if (count > vertices) vertices = count;
+		}
+
+		/**
+		 * Adds an edge (with a weight of 1 for weighted graphs), adding its vertices if needed
+		 * @param from The source of the edge
+		 * @param to The target of the edge
+		 */
+		void addEdge(Vertex from, Vertex to) {
+			sources.push(from);
+			targets.push(to);
+			if constexpr (weighted) weights.push(Weight(1));
+			addVertices(static_cast<size_t>(from > to ? from : to) + 1);
+		}
+
+		/**
+		 * Adds a weighted edge, adding its vertices if needed (weighted graphs only)
+		 * @param from The source of the edge
+		 * @param to The target of the edge
+		 * @param weight The weight of the edge (must not be negative)
+		 */
+		template<typename U = W, typename = std::enable_if_t<!std::is_void_v<U>>>
+		void addEdge(Vertex from, Vertex to, const U& weight) {
+			assert(!(weight < U(0)));
+			sources.push(from);
+			targets.push(to);
+			weights.push(weight);
+			addVertices(static_cast<size_t>(from > to ? from : to) + 1);
+		}
+
+		/**
+		 * Adds the edges of a text file with one edge per line as "source target [weight]"
+		 * Fields are separated by spaces, tabs or commas. Blank lines and lines starting with # or % are skipped, a missing weight is 1.
+		 * A line with a malformed field, a negative weight or a field after the weight is invalid, whether or not the graph is weighted
+		 * @param path The path of the file
+		 * @returns Whether or not the file could be read and every line was valid (edges before an invalid line are kept)
+		 */
+		bool readEdgeList(const char* path) {
+			FILE* file = std::fopen(path, "rb");
+			if (file == nullptr) return false;
+
+			const size_t chunk = 1 << 20;
+			ArrayList<char> buffer(chunk + 1);
+			buffer.resizeUninitialized(chunk + 1);
+			size_t kept = 0;
+			bool valid = true;
+			while (valid) {
+				if (kept == chunk) {
+					// A single line longer than the buffer
+					valid = false;
+					break;
+				}
+				size_t read = std::fread(buffer.data() + kept, 1, chunk - kept, file);
+				size_t filled = kept + read;
+				bool last = read == 0;
+				if (last && filled == 0) break;
+
+				char* line = buffer.data();
+				char* end = buffer.data() + filled;
+				while (valid) {
+					char* newline = static_cast<char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+					if (newline == nullptr) {
+						if (!last) break;
+						newline = end;
+					}
+					*newline = '\0';
+					valid = parseLine(line);
+					line = newline + 1;
+					if (line >= end) break;
+				}
+				if (last) break;
+
+				kept = line < end ? static_cast<size_t>(end - line) : 0;
+				std::memmove(buffer.data(), line, kept);
+			}
+
+			std::fclose(file);
+			return valid;
+		}
+
+		/**
+		 * Gets the number of vertices
+		 * @returns The number of vertices of the graph
+		 */
+		size_t vertexCount() const {
+			return vertices;
+		}
+
+		/**
+		 * Gets the number of edges added
+		 * @returns The number of edges of the graph
+		 */
+		size_t edgeCount() const {
+			return sources.length();
+		}
+
+		/**
+		 * Prepares the builder for a number of edges
+		 * @param num The number of edges to prepare for
+		 */
+		void prepare(size_t num) {
+			sources.prepare(num);
+			targets.prepare(num);
+			if constexpr (weighted) weights.prepare(num);
+		}
+
+		/**
+		 * Creates the compressed form of the graph (the builder is left unchanged)
+		 * @returns The graph
+		 */
+		Graph<W> freeze() const {
+			return Graph<W>(*this);
+		}
+	};
+
+	/**
+	 * An immutable graph stored in compressed sparse row form, built with a GraphBuilder
+	 *
+	 * The targets of every edge are stored in one array ordered by source, with an offset per vertex into it,
+	 * so the graph takes two words per vertex and one per edge and scanning the edges of a vertex is a linear read.
+	 * Directed graphs also store the reverse edges so traversals can search backwards (undirected graphs store every edge both ways).
+	 * The algorithms run on a thread pool and can report how much work they did (see TraversalStats).
+	 * @tparam W The type of the edge weights (void for an unweighted graph)
+	 */
+	template<typename W = void> class Graph {
+	public:
+		/**
+		 * Whether or not the graph stores weights
+		 */
+		static constexpr bool weighted = !std::is_void_v<W>;
+
+		/**
+		 * The type of path lengths (hop counts for unweighted graphs)
+		 */
+		using Distance = std::conditional_t<weighted, W, uint32_t>;
+
+		/**
+		 * The depth or distance of a vertex which can't be reached
+		 */
+		static constexpr Distance unreachable = std::numeric_limits<Distance>::max();
+
+		/**
+		 * The breadth first search depth of a vertex which can't be reached
+		 */
+		static constexpr uint32_t unreachableDepth = std::numeric_limits<uint32_t>::max();
+
+		/**
+		 * The edges of a vertex, usable in a range based for loop
+		 */
+		class Neighbors {
+		private:
+			/**
+			 * The first edge target
+			 */
+			const Vertex* first;
+
+			/**
+			 * One past the last edge target
+			 */
+			const Vertex* last;
+
+		public:
+			/**
+			 * Creates a range of edge targets
+			 * @param first The first edge target
+			 * @param last One past the last edge target
+			 */
+			Neighbors(const Vertex* first, const Vertex* last) : first(first), last(last) {}
+
+			/**
+			 * Gets the start of the range
+			 * @returns The first edge target
+			 */
+			const Vertex* begin() const {
+				return first;
+			}
+
+			/**
+			 * Gets the end of the range
+			 * @returns One past the last edge target
+			 */
+			const Vertex* end() const {
+				return last;
+			}
+
+			/**
+			 * Returns the length of the data structure
+			 * @returns The number of edges
+			 */
+			size_t length() const {
+				return static_cast<size_t>(last - first);
+			}
+		};
+
+	private:
+		friend class GraphBuilder<W>;
+
+		/**
+		 * The stored weight type (a placeholder which is never stored for unweighted graphs)
+		 */
+		using Weight = typename GraphBuilder<W>::Weight;
+
+		/**
+		 * A fixed size array of atomics used as scratch space by the parallel algorithms
+		 */
+		template<typename T> class AtomicArray {
+		private:
+			/**
+			 * The elements of the array
+			 */
+			std::atomic<T>* items;
+
+		public:
+			/**
+			 * Creates a new array
+			 * @param count The number of elements
+			 * @param value The value of every element
+			 * @param pool The pool to initialize the elements on
+			 */
+			AtomicArray(size_t count, T value, Threading::ThreadPool& pool) : items(new std::atomic<T>[count]) {
+				Threading::parallelFor(0, count, [&](size_t begin, size_t end) {
+					for (size_t i = begin; i < end; i++)
+						items[i].store(value, std::memory_order_relaxed);
+				}, 0, pool);
+			}
+
+			AtomicArray(const AtomicArray&) = delete;
+			AtomicArray& operator=(const AtomicArray&) = delete;
+
+			/**
+			 * Frees resources
+			 */
+			~AtomicArray() {
+				delete[] items;
+			}
+
+			/**
+			 * Gets an element of the array
+			 * @param index The index of the element
+			 * @returns The element
+			 */
+			std::atomic<T>& operator[](size_t index) {
+				return items[index];
+			}
+		};
+
+		/**
+		 * Whether or not edges only go from their source to their target
+		 */
+		bool directed = true;
+
+		/**
+		 * The number of vertices
+		 */
+		size_t vertices = 0;
+
+		/**
+		 * The index of the first edge of every vertex, followed by the number of edges
+		 */
+		ArrayList<size_t> offsets;
+
+		/**
+		 * The target of every edge, ordered by source
+		 */
+		ArrayList<Vertex> targets;
+
+		/**
+		 * The weight of every edge, ordered by source (empty for unweighted graphs)
+		 */
+		ArrayList<Weight> weights;
+
+		/**
+		 * The index of the first reverse edge of every vertex, followed by the number of edges (directed graphs only)
+		 */
+		ArrayList<size_t> reverseOffsets;
+
+		/**
+		 * The source of every edge, ordered by target (directed graphs only)
+		 */
+		ArrayList<Vertex> reverseTargets;
+
+		/**
+		 * Sorts edges by one of their endpoints with a counting sort
+		 * @param count The number of edges
+		 * @param keys The endpoint to sort by of every edge
+		 * @param values The other endpoint of every edge
+		 * @param edgeWeights The weight of every edge (nullptr to skip weights)
+		 * @param both Whether or not every edge is also added in the opposite direction
+		 * @param outOffsets The offsets of each vertex to fill
+		 * @param outTargets The sorted endpoints to fill
+		 * @param outWeights The sorted weights to fill (unused when edgeWeights is nullptr)
+		 */
+		void compress(size_t count, const Vertex* keys, const Vertex* values, const Weight* edgeWeights, bool both,
+			ArrayList<size_t>& outOffsets, ArrayList<Vertex>& outTargets, ArrayList<Weight>& outWeights) {
+			ArrayList<size_t> cursor(vertices + 1);
+			for (size_t v = 0; v <= vertices; v++)
+				cursor.push(0);
+			for (size_t i = 0; i < count; i++) {
+				cursor[keys[i]]++;
+				if (both && keys[i] != values[i]) cursor[values[i]]++;
+			}
+
+			outOffsets = ArrayList<size_t>(vertices + 1);
+			size_t total = 0;
+			for (size_t v = 0; v <= vertices; v++) {
+				outOffsets.push(total);
+				size_t degree = cursor[v];
+				cursor[v] = total;
+				total += degree;
+			}
+
+			outTargets = ArrayList<Vertex>(total);
+			outTargets.resizeUninitialized(total);
+			if (edgeWeights != nullptr) {
+				outWeights = ArrayList<Weight>(total);
+				outWeights.resizeUninitialized(total);
+			}
+			for (size_t i = 0; i < count; i++) {
+				size_t at = cursor[keys[i]]++;
+				outTargets[at] = values[i];
+				if (edgeWeights != nullptr) outWeights[at] = edgeWeights[i];
+				if (both && keys[i] != values[i]) {
+					at = cursor[values[i]]++;
+					outTargets[at] = keys[i];
+					if (edgeWeights != nullptr) outWeights[at] = edgeWeights[i];
+				}
+			}
+		}
+
+		/**
+		 * Creates the compressed form of the edges of a builder
+		 * @param builder The builder to read the edges from
+		 */
+		Graph(const GraphBuilder<W>& builder) : directed(builder.directed), vertices(builder.vertices) {
+			size_t count = builder.sources.length();
+			const Weight* edgeWeights = weighted ? builder.weights.data() : nullptr;
+			compress(count, builder.sources.data(), builder.targets.data(), edgeWeights, !directed, offsets, targets, weights);
+			if (directed) {
+				ArrayList<Weight> unused;
+				compress(count, builder.targets.data(), builder.sources.data(), nullptr, false, reverseOffsets, reverseTargets, unused);
+			}
+		}
+
+		/**
+		 * Gets the edges pointing into a vertex
+		 * @param vertex The vertex
+		 * @returns The sources of the edges
+		 */
+		Neighbors incoming(Vertex vertex) const {
+			if (!directed) return neighbors(vertex);
+			const Vertex* data = reverseTargets.data();
+			return Neighbors(data + reverseOffsets[vertex], data + reverseOffsets[vertex + 1]);
+		}
+
+		/**
+		 * Gets the weight of an edge
+		 * @param edge The index of the edge
+		 * @returns The weight (1 for unweighted graphs)
+		 */
+		Distance weightOf(size_t edge) const {
+			if constexpr (weighted) return weights[edge];
+			else return 1;
+		}
+
+		/**
+		 * Gets the seconds elapsed since a point in time
+		 * @param start The point in time
+		 * @returns The elapsed seconds
+		 */
+		static double secondsSince(std::chrono::steady_clock::time_point start) {
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		/**
+		 * Appends the items of a chunk to a shared output array
+		 * @param local The items of the chunk
+		 * @param output The shared output (with room for every item)
+		 * @param cursor The number of items in the output so far
+		 */
+		static void flush(const ArrayList<Vertex>& local, Vertex* output, std::atomic<size_t>& cursor) {
+			if (local.length() == 0) return;
+			size_t at = cursor.fetch_add(local.length(), std::memory_order_relaxed);
+			std::memcpy(output + at, local.data(), local.length() * sizeof(Vertex));
+		}
+
+		/**
+		 * Gets the index of the lowest set bit of a non zero mask
+		 * @param mask The mask to check
+		 * @returns The index of the lowest set bit
+		 */
+		static size_t lowestBit(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+			return static_cast<size_t>(__builtin_ctzll(mask));
+#else
+			size_t i = 0;
+			while (!(mask & 1)) { mask >>= 1; i++; }
+			return i;
+#endif
+		}
+
+		/**
+		 * Finds the root of a vertex in a union find forest, halving the path on the way
+		 * @param parents The parent of every vertex
+		 * @param vertex The vertex
+		 * @returns The root of the vertex
+		 */
+		static Vertex findRoot(AtomicArray<Vertex>& parents, Vertex vertex) {
+			Vertex parent = parents[vertex].load(std::memory_order_relaxed);
+			while (parent != vertex) {
+				Vertex grandparent = parents[parent].load(std::memory_order_relaxed);
+				if (grandparent != parent)
+					parents[vertex].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+				vertex = parent;
+				parent = parents[vertex].load(std::memory_order_relaxed);
+			}
+			return vertex;
+		}
+
+	public:
+		/**
+		 * Creates a new empty Graph
+		 */
+		Graph() = default;
+
+		/**
+		 * Gets the number of vertices
+		 * @returns The number of vertices
+		 */
+		size_t vertexCount() const {
+			return vertices;
+		}
+
+		/**
+		 * Gets the number of stored edges (undirected edges count once per direction)
+		 * @returns The number of edges
+		 */
+		size_t edgeCount() const {
+			return targets.length();
+		}
+
+		/**
+		 * Checks if the edges only go from their source to their target
+		 * @returns Whether or not the graph is directed
+		 */
+		bool isDirected() const {
+			return directed;
+		}
+
+		/**
+		 * Gets the number of edges leaving a vertex
+		 * @param vertex The vertex
+		 * @returns The number of edges
+		 */
+		size_t degree(Vertex vertex) const {
+			assert(vertex < vertices);
+			return offsets[vertex + 1] - offsets[vertex];
+		}
+
+		/**
+		 * Gets the edges leaving a vertex
+		 * @param vertex The vertex
+		 * @returns The targets of the edges
+		 */
+		Neighbors neighbors(Vertex vertex) const {
+			assert(vertex < vertices);
+			const Vertex* data = targets.data();
+			return Neighbors(data + offsets[vertex], data + offsets[vertex + 1]);
+		}
+
+		/**
+		 * Gets the weights of the edges leaving a vertex, in the same order as neighbors (weighted graphs only)
+		 * @param vertex The vertex
+		 * @returns The weights of the edges
+		 */
+		template<typename U = W, typename = std::enable_if_t<!std::is_void_v<U>>>
+		const U* edgeWeights(Vertex vertex) const {
+			assert(vertex < vertices);
+			return weights.data() + offsets[vertex];
+		}
+
+		/**
+		 * Gets the number of bytes used by the graph
+		 * @returns The size of the vertex and edge arrays
+		 */
+		size_t memoryUsage() const {
+			return sizeof(Graph) +
+				offsets.capacity() * sizeof(size_t) + targets.capacity() * sizeof(Vertex) + weights.capacity() * sizeof(Weight) +
+				reverseOffsets.capacity() * sizeof(size_t) + reverseTargets.capacity() * sizeof(Vertex);
+		}
+
+		/**
+		 * Finds the number of edges on the shortest path from a vertex to every vertex with a direction optimizing breadth first search
+		 *
+		 * Small frontiers are expanded top down (scanning the edges of the frontier), once the frontier has more edges than a fraction
+		 * of the unvisited vertices the search switches to bottom up (every unvisited vertex scans its incoming edges for a frontier vertex).
+		 * @param source The vertex to search from
+		 * @param stats Where to report the work done (nullptr to skip)
+		 * @param pool The pool to run on
+		 * @returns The depth of every vertex (unreachableDepth if there is no path)
+		 */
+		ArrayList<uint32_t> breadthFirstSearch(Vertex source, TraversalStats* stats = nullptr, Threading::ThreadPool& pool = Threading::ThreadPool::global()) const {
+			assert(source < vertices);
+			const size_t alpha = 15;
+			const size_t beta = 18;
+			auto start = std::chrono::steady_clock::now();
+			std::atomic<size_t> visited(0);
+
+			AtomicArray<uint32_t> depths(vertices, unreachableDepth, pool);
+			depths[source].store(0, std::memory_order_relaxed);
+
+			ArrayList<Vertex> frontier(vertices);
+			frontier.push(source);
+			ArrayList<Vertex> next(vertices);
+			size_t words = (vertices + 63) / 64;
+			AtomicArray<uint64_t> frontierBits(words, 0, pool);
+			AtomicArray<uint64_t> nextBits(words, 0, pool);
+
+			size_t edgesToCheck = targets.length();
+			size_t scoutCount = degree(source);
+			bool bottomUp = false;
+			size_t frontierSize = 1;
+
+			for (uint32_t depth = 0; frontierSize > 0; depth++) {
+				if (!bottomUp && scoutCount > edgesToCheck / alpha) {
+					// Switch to bottom up, converting the frontier list to a bitmap
+					Threading::parallelFor(0, words, [&](size_t begin, size_t end) {
+						for (size_t w = begin; w < end; w++)
+							frontierBits[w].store(0, std::memory_order_relaxed);
+					}, 0, pool);
+					Threading::parallelFor(0, frontier.length(), [&](size_t begin, size_t end) {
+						for (size_t i = begin; i < end; i++)
+							frontierBits[frontier[i] / 64].fetch_or(uint64_t(1) << (frontier[i] % 64), std::memory_order_relaxed);
+					}, 0, pool);
+					bottomUp = true;
+				}
+
+				if (bottomUp) {
+					std::atomic<size_t> awake(0);
+					Threading::parallelFor(0, words, [&](size_t begin, size_t end) {
+						size_t localAwake = 0;
+						size_t localVisited = 0;
+						for (size_t w = begin; w < end; w++) {
+							uint64_t bits = 0;
+							size_t last = (w + 1) * 64 < vertices ? (w + 1) * 64 : vertices;
+							for (size_t v = w * 64; v < last; v++) {
+								if (depths[v].load(std::memory_order_relaxed) != unreachableDepth) continue;
+								for (Vertex u : incoming(static_cast<Vertex>(v))) {
+									localVisited++;
+									if (frontierBits[u / 64].load(std::memory_order_relaxed) & (uint64_t(1) << (u % 64))) {
+										depths[v].store(depth + 1, std::memory_order_relaxed);
+										bits |= uint64_t(1) << (v % 64);
+										localAwake++;
+										break;
+									}
+								}
+							}
+							nextBits[w].store(bits, std::memory_order_relaxed);
+						}
+						awake.fetch_add(localAwake, std::memory_order_relaxed);
+						visited.fetch_add(localVisited, std::memory_order_relaxed);
+					}, 0, pool);
+
+					size_t previous = frontierSize;
+					frontierSize = awake.load();
+					for (size_t w = 0; w < words; w++)
+						frontierBits[w].store(nextBits[w].load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+					if (frontierSize < previous && frontierSize <= vertices / beta) {
+						// Switch back to top down, converting the bitmap to a frontier list
+						std::atomic<size_t> cursor(0);
+						Threading::parallelFor(0, words, [&](size_t begin, size_t end) {
+							ArrayList<Vertex> local;
+							for (size_t w = begin; w < end; w++) {
+								for (uint64_t bits = frontierBits[w].load(std::memory_order_relaxed); bits != 0; bits &= bits - 1)
+									local.push(static_cast<Vertex>(w * 64 + lowestBit(bits)));
+							}
+							flush(local, frontier.data(), cursor);
+						}, 0, pool);
+						frontier.clear();
+						frontier.resizeUninitialized(cursor.load());
+						scoutCount = 0;
+						bottomUp = false;
+					}
+					continue;
+				}
+
+				// Top down
+				std::atomic<size_t> cursor(0);
+				std::atomic<size_t> scouts(0);
+				Threading::parallelFor(0, frontier.length(), [&](size_t begin, size_t end) {
+					ArrayList<Vertex> local;
+					size_t localScouts = 0;
+					size_t localVisited = 0;
+					for (size_t i = begin; i < end; i++) {
+						for (Vertex v : neighbors(frontier[i])) {
+							localVisited++;
+							uint32_t expected = unreachableDepth;
+							if (depths[v].load(std::memory_order_relaxed) == expected &&
+								depths[v].compare_exchange_strong(expected, depth + 1, std::memory_order_relaxed)) {
+								local.push(v);
+								localScouts += degree(v);
+							}
+						}
+					}
+					flush(local, next.data(), cursor);
+					scouts.fetch_add(localScouts, std::memory_order_relaxed);
+					visited.fetch_add(localVisited, std::memory_order_relaxed);
+				}, 64, pool);
+
+				edgesToCheck = edgesToCheck > scoutCount ? edgesToCheck - scoutCount : 0;
+				scoutCount = scouts.load();
+				next.clear();
+				next.resizeUninitialized(cursor.load());
+				std::swap(frontier, next);
+				frontierSize = frontier.length();
+			}
+
+			ArrayList<uint32_t> result(vertices);
+			result.resizeUninitialized(vertices);
+			Threading::parallelFor(0, vertices, [&](size_t begin, size_t end) {
+				for (size_t v = begin; v < end; v++)
+					result[v] = depths[v].load(std::memory_order_relaxed);
+			}, 0, pool);
+
+			if (stats != nullptr) {
+				stats->edgesVisited = visited.load();
+				stats->seconds = secondsSince(start);
+			}
+			return result;
+		}
+
+		/**
+		 * Finds the length of the shortest path from a vertex to every vertex with parallel delta stepping
+		 *
+		 * Vertices are kept in buckets of width delta by tentative distance, the lowest bucket is relaxed in parallel until it stays empty.
+		 * Small deltas behave like Dijkstra's algorithm (little wasted work, little parallelism), large deltas like Bellman-Ford.
+		 * @param source The vertex to search from
+		 * @param delta The width of a bucket (0 uses the average edge weight)
+		 * @param stats Where to report the work done (nullptr to skip)
+		 * @param pool The pool to run on
+		 * @returns The distance to every vertex (unreachable if there is no path)
+		 */
+		ArrayList<Distance> shortestPaths(Vertex source, Distance delta = 0, TraversalStats* stats = nullptr, Threading::ThreadPool& pool = Threading::ThreadPool::global()) const {
+			assert(source < vertices);
+			auto start = std::chrono::steady_clock::now();
+			std::atomic<size_t> visited(0);
+
+			if (!(delta > 0)) {
+				if constexpr (weighted) {
+					double total = 0;
+					for (size_t i = 0; i < weights.length(); i++)
+						total += static_cast<double>(weights[i]);
+					double average = weights.length() > 0 ? total / static_cast<double>(weights.length()) : 1;
+					delta = static_cast<Distance>(average);
+				}
+				if (!(delta > 0)) delta = 1;
+			}
+
+			AtomicArray<Distance> distances(vertices, unreachable, pool);
+			distances[source].store(0, std::memory_order_relaxed);
+
+			ArrayList<ArrayList<Vertex>> buckets;
+			std::mutex bucketsMutex;
+			ArrayList<Vertex> frontier;
+			frontier.push(source);
+			size_t bucket = 0;
+
+			while (true) {
+				Distance floor = static_cast<Distance>(delta * static_cast<Distance>(bucket));
+				Threading::parallelFor(0, frontier.length(), [&](size_t begin, size_t end) {
+					ArrayList<ArrayList<Vertex>> local;
+					size_t localVisited = 0;
+					for (size_t i = begin; i < end; i++) {
+						Vertex u = frontier[i];
+						Distance base = distances[u].load(std::memory_order_relaxed);
+						// Vertices which moved to an earlier bucket since they were added were already relaxed
+						if (base < floor) continue;
+						size_t first = offsets[u];
+						size_t last = offsets[u + 1];
+						for (size_t e = first; e < last; e++) {
+							localVisited++;
+							Vertex v = targets[e];
+							Distance candidate = static_cast<Distance>(base + weightOf(e));
+							Distance current = distances[v].load(std::memory_order_relaxed);
+							while (candidate < current) {
+								if (distances[v].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+									size_t index = static_cast<size_t>(candidate / delta);
+									while (local.length() <= index) local.push(ArrayList<Vertex>());
+									local[index].push(v);
+									break;
+								}
+							}
+						}
+					}
+					visited.fetch_add(localVisited, std::memory_order_relaxed);
+					if (local.length() == 0) return;
+					std::lock_guard<std::mutex> lock(bucketsMutex);
+					while (buckets.length() < local.length()) buckets.push(ArrayList<Vertex>());
+					for (size_t b = 0; b < local.length(); b++) {
+						if (local[b].length() > 0) buckets[b].push(local[b]);
+					}
+				}, 64, pool);
+
+				while (bucket < buckets.length() && buckets[bucket].length() == 0)
+					bucket++;
+				if (bucket == buckets.length()) break;
+				frontier = std::move(buckets[bucket]);
+				buckets[bucket] = ArrayList<Vertex>();
+			}
+
+			ArrayList<Distance> result(vertices);
+			result.resizeUninitialized(vertices);
+			Threading::parallelFor(0, vertices, [&](size_t begin, size_t end) {
+				for (size_t v = begin; v < end; v++)
+					result[v] = distances[v].load(std::memory_order_relaxed);
+			}, 0, pool);
+
+			if (stats != nullptr) {
+				stats->edgesVisited = visited.load();
+				stats->seconds = secondsSince(start);
+			}
+			return result;
+		}
+
+		/**
+		 * Labels every vertex with its (weakly) connected component using a lock free union find
+		 * @param stats Where to report the work done (nullptr to skip)
+		 * @param pool The pool to run on
+		 * @returns The component of every vertex, identified by its smallest vertex
+		 */
+		ArrayList<Vertex> connectedComponents(TraversalStats* stats = nullptr, Threading::ThreadPool& pool = Threading::ThreadPool::global()) const {
+			auto start = std::chrono::steady_clock::now();
+			AtomicArray<Vertex> parents(vertices, 0, pool);
+			Threading::parallelFor(0, vertices, [&](size_t begin, size_t end) {
+				for (size_t v = begin; v < end; v++)
+					parents[v].store(static_cast<Vertex>(v), std::memory_order_relaxed);
+			}, 0, pool);
+
+			Threading::parallelFor(0, vertices, [&](size_t begin, size_t end) {
+				for (size_t u = begin; u < end; u++) {
+					for (Vertex v : neighbors(static_cast<Vertex>(u))) {
+						// Link the larger root under the smaller so every root is the smallest vertex of its tree
+						while (true) {
+							Vertex a = findRoot(parents, static_cast<Vertex>(u));
+							Vertex b = findRoot(parents, v);
+							if (a == b) break;
+							Vertex high = a > b ? a : b;
+							Vertex low = a > b ? b : a;
+							Vertex expected = high;
+							if (parents[high].compare_exchange_strong(expected, low, std::memory_order_relaxed)) break;
+						}
+					}
+				}
+			}, 0, pool);
+
+			ArrayList<Vertex> result(vertices);
+			result.resizeUninitialized(vertices);
+			Threading::parallelFor(0, vertices, [&](size_t begin, size_t end) {
+				for (size_t v = begin; v < end; v++)
+					result[v] = findRoot(parents, static_cast<Vertex>(v));
+			}, 0, pool);
+
+			if (stats != nullptr) {
+				stats->edgesVisited = targets.length();
+				stats->seconds = secondsSince(start);
+			}
+			return result;
+		}
+
+		/**
+		 * Orders the vertices of a directed graph so every edge goes from an earlier vertex to a later one (parallel Kahn's algorithm)
+		 * @param order Where to write the order (replaced)
+		 * @param stats Where to report the work done (nullptr to skip)
+		 * @param pool The pool to run on
+		 * @returns Whether or not the graph has no cycles (the order only holds the vertices outside of cycles if it does)
+		 */
+		bool topologicalSort(ArrayList<Vertex>& order, TraversalStats* stats = nullptr, Threading::ThreadPool& pool = Threading::ThreadPool::global()) const {
+			assert(directed);
+			auto start = std::chrono::steady_clock::now();
+			AtomicArray<size_t> remaining(vertices, 0, pool);
+			Threading::parallelFor(0, vertices, [&](size_t begin, size_t end) {
+				for (size_t v = begin; v < end; v++)
+					remaining[v].store(reverseOffsets[v + 1] - reverseOffsets[v], std::memory_order_relaxed);
+			}, 0, pool);
+
+			order = ArrayList<Vertex>(vertices);
+			order.resizeUninitialized(vertices);
+			std::atomic<size_t> cursor(0);
+			Threading::parallelFor(0, vertices, [&](size_t begin, size_t end) {
+				ArrayList<Vertex> local;
+				for (size_t v = begin; v < end; v++) {
+					if (remaining[v].load(std::memory_order_relaxed) == 0) local.push(static_cast<Vertex>(v));
+				}
+				flush(local, order.data(), cursor);
+			}, 0, pool);
+
+			// Every level of the order is the vertices whose last incoming edge was removed by the level before it
+			size_t levelStart = 0;
+			while (levelStart < cursor.load()) {
+				size_t levelEnd = cursor.load();
+				Threading::parallelFor(levelStart, levelEnd, [&](size_t begin, size_t end) {
+					ArrayList<Vertex> local;
+					for (size_t i = begin; i < end; i++) {
+						for (Vertex v : neighbors(order[i])) {
+							if (remaining[v].fetch_sub(1, std::memory_order_acq_rel) == 1) local.push(v);
+						}
+					}
+					flush(local, order.data(), cursor);
+				}, 64, pool);
+				levelStart = levelEnd;
+			}
+
+			size_t sorted = cursor.load();
+			order.resizeUninitialized(sorted);
+			if (stats != nullptr) {
+				stats->edgesVisited = targets.length();
+				stats->seconds = secondsSince(start);
+			}
+			return sorted == vertices;
+		}
+	};
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
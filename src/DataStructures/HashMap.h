@@ -0,0 +1,976 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "Memory.h"
+#include "Allocator.h"
+#include <assert.h>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ESSENTIALS_HASHMAP_SSE2
+#endif
+
+/**
+ * The main namespace for data structures in the essentials library
+ */
+namespace Essentials::DataStructures {
+
+	/**
+	 * A namespace alias to the data structures namespace
+	 */
+	namespace ds = DataStructures;
+
+	/**
+	 * A group of 16 control bytes of a HashMap which are probed at once (with SSE2 when available)
+	 * Each control byte is either empty, deleted, or holds the low 7 bits of the hash of a full slot
+	 */
+	class HashGroup {
+	private:
+#ifdef ESSENTIALS_HASHMAP_SSE2
+		/**
+		 * The control bytes of the group
+		 */
+		__m128i ctrl;
+#else
+		/**
+		 * The control bytes of the group
+		 */
+		int8_t ctrl[16];
+#endif
+
+	public:
+		/**
+		 * The number of slots in a group
+		 */
+		static constexpr size_t width = 16;
+
+		/**
+		 * The control byte of a slot which has never held an element
+		 */
+		static constexpr int8_t empty = -128;
+
+		/**
+		 * The control byte of a slot whose element was removed
+		 */
+		static constexpr int8_t deleted = -2;
+
+		/**
+		 * Loads a group of control bytes (the address doesn't need to be aligned)
+		 * @param pos The first control byte of the group
+		 */
+		explicit HashGroup(const int8_t* pos) {
+#ifdef ESSENTIALS_HASHMAP_SSE2
+			ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+#else
+			for (size_t i = 0; i < width; i++)
+				ctrl[i] = pos[i];
+#endif
+		}
+
+		/**
+		 * Finds the slots of the group whose control byte is a hash fragment
+		 * @param hash The 7 bit hash fragment to look for
+		 * @returns A bit mask of the matching slots
+		 */
+		uint32_t match(int8_t hash) const {
+#ifdef ESSENTIALS_HASHMAP_SSE2
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash), ctrl)));
+#else
+			uint32_t mask = 0;
+			for (size_t i = 0; i < width; i++)
+				mask |= static_cast<uint32_t>(ctrl[i] == hash) << i;
+			return mask;
+#endif
+		}
+
+		/**
+		 * Finds the empty slots of the group
+		 * @returns A bit mask of the empty slots
+		 */
+		uint32_t matchEmpty() const {
+			return match(empty);
+		}
+
+		/**
+		 * Finds the slots of the group which don't hold an element
+		 * @returns A bit mask of the empty and deleted slots
+		 */
+		uint32_t matchEmptyOrDeleted() const {
+#ifdef ESSENTIALS_HASHMAP_SSE2
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl)));
+#else
+			uint32_t mask = 0;
+			for (size_t i = 0; i < width; i++)
+				mask |= static_cast<uint32_t>(ctrl[i] < -1) << i;
+			return mask;
+#endif
+		}
+
+		/**
+		 * Gets the index of the lowest set bit of a non zero mask
+		 * @param mask The mask to search
+		 * @returns The index of the lowest set bit
+		 */
+		static inline uint32_t lowestBit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+			return static_cast<uint32_t>(__builtin_ctz(mask));
+#else
+			uint32_t index = 0;
+			while ((mask & 1) == 0) {
+				mask >>= 1;
+				index++;
+			}
+			return index;
+#endif
+		}
+
+		/**
+		 * Gets the number of leading zero bits of a 16 bit mask
+		 * @param mask The mask to search
+		 * @returns The number of leading zeros (16 if the mask is 0)
+		 */
+		static inline uint32_t leadingZeros(uint32_t mask) {
+			uint32_t count = 0;
+			for (uint32_t bit = 1u << (width - 1); bit != 0 && (mask & bit) == 0; bit >>= 1)
+				count++;
+			return count;
+		}
+	};
+
+	/**
+	 * An open addressing hash map which stores its elements inline (Swiss table layout)
+	 *
+	 * Every slot has a control byte holding 7 bits of its hash, lookups compare 16 control bytes at a time
+	 * and only compare keys whose hash fragment matches. The table is kept at most 7/8 full.
+	 * For heterogeneous lookup (ie std::string keys searched with a string view) both Hash and Equal must define is_transparent.
+	 * @tparam Allocator The allocator the table is requested from (see HeapAllocator)
+	 */
+	template<typename K, typename V, typename Hash = std::hash<K>, typename Equal = std::equal_to<K>, typename Allocator = HeapAllocator>
+	class HashMap : private Allocator {
+	public:
+		/**
+		 * An element of the map (the key must not be modified while the entry is in the map)
+		 */
+		struct Entry {
+			/**
+			 * The key of the entry
+			 */
+			K key;
+
+			/**
+			 * The value of the entry
+			 */
+			V value;
+		};
+
+		/**
+		 * An iterator over the entries of a map, in no particular order
+		 */
+		template<typename E> class EntryIterator {
+		private:
+			/**
+			 * The control byte of the current slot
+			 */
+			const int8_t* ctrl;
+
+			/**
+			 * The current slot
+			 */
+			E* slot;
+
+			/**
+			 * One past the last slot of the table
+			 */
+			E* last;
+
+			/**
+			 * Advances to the next full slot (stays if the current slot is full)
+			 */
+			void skip() {
+				while (slot != last && *ctrl < 0) {
+					ctrl++;
+					slot++;
+				}
+			}
+
+		public:
+			/**
+			 * The iterator category
+			 */
+			using iterator_category = std::forward_iterator_tag;
+
+			/**
+			 * The type of the entries
+			 */
+			using value_type = std::remove_const_t<E>;
+
+			/**
+			 * The type of the distance between two iterators
+			 */
+			using difference_type = std::ptrdiff_t;
+
+			/**
+			 * A pointer to an entry
+			 */
+			using pointer = E*;
+
+			/**
+			 * A reference to an entry
+			 */
+			using reference = E&;
+
+			/**
+			 * Creates an iterator starting at a slot
+			 * @param ctrl The control byte of the slot
+			 * @param slot The slot to start at
+			 * @param last One past the last slot of the table
+			 */
+			EntryIterator(const int8_t* ctrl, E* slot, E* last) : ctrl(ctrl), slot(slot), last(last) {
+				skip();
+			}
+
+			/**
+			 * Gets the current entry
+			 * @returns The entry
+			 */
+			E& operator*() const {
+				return *slot;
+			}
+
+			/**
+			 * Gets the current entry
+			 * @returns The entry
+			 */
+			E* operator->() const {
+				return slot;
+			}
+
+			/**
+			 * Advances to the next entry
+			 * @returns This iterator
+			 */
+			EntryIterator& operator++() {
+				ctrl++;
+				slot++;
+				skip();
+				return *this;
+			}
+
+			/**
+			 * Advances to the next entry
+			 * @returns The iterator before advancing
+			 */
+			EntryIterator operator++(int) {
+				EntryIterator previous = *this;
+				++*this;
+				return previous;
+			}
+
+			/**
+			 * Checks if two iterators point to the same slot
+			 * @param other The iterator to compare to
+			 * @returns Whether or not the iterators are equal
+			 */
+			bool operator==(const EntryIterator& other) const {
+				return slot == other.slot;
+			}
+
+			/**
+			 * Checks if two iterators point to different slots
+			 * @param other The iterator to compare to
+			 * @returns Whether or not the iterators are different
+			 */
+			bool operator!=(const EntryIterator& other) const {
+				return slot != other.slot;
+			}
+		};
+
+	private:
+		/**
+		 * Whether or not heterogeneous lookup is enabled
+		 */
+		template<typename H, typename E, typename = void> struct IsTransparent : std::false_type {};
+
+		/**
+		 * Whether or not heterogeneous lookup is enabled
+		 */
+		template<typename H, typename E> struct IsTransparent<H, E, std::void_t<typename H::is_transparent, typename E::is_transparent>> : std::true_type {};
+
+		/**
+		 * The index returned when a key isn't found
+		 */
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		/**
+		 * The hash function
+		 */
+		Hash hasher;
+
+		/**
+		 * The key equality function
+		 */
+		Equal equal;
+
+		/**
+		 * The control bytes (capacity + 16, the first 16 are cloned at the end so groups can be loaded without wrapping)
+		 */
+		int8_t* ctrl = nullptr;
+
+		/**
+		 * The slots of the table
+		 */
+		Entry* slots = nullptr;
+
+		/**
+		 * The number of elements in the map
+		 */
+		size_t size = 0;
+
+		/**
+		 * The number of slots (0 or a power of two, at least 16)
+		 */
+		size_t cap = 0;
+
+		/**
+		 * The number of empty slots which can be filled before the table must be rehashed
+		 */
+		size_t growthLeft = 0;
+
+		/**
+		 * Returns the allocator the table is requested from
+		 * @returns The allocator of the map
+		 */
+		Allocator& allocator() {
+			return *this;
+		}
+
+		/**
+		 * Gets the maximum number of elements a table can hold
+		 * @param capacity The number of slots of the table
+		 * @returns The maximum number of elements
+		 */
+		static size_t maxLoad(size_t capacity) {
+			return capacity - capacity / 8;
+		}
+
+		/**
+		 * Gets the byte offset of the slots in an allocation
+		 * @param capacity The number of slots of the table
+		 * @returns The offset of the first slot
+		 */
+		static size_t slotOffset(size_t capacity) {
+			return (capacity + HashGroup::width + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+		}
+
+		/**
+		 * Gets the number of bytes of an allocation
+		 * @param capacity The number of slots of the table
+		 * @returns The size of the allocation
+		 */
+		static size_t allocationSize(size_t capacity) {
+			return slotOffset(capacity) + capacity * sizeof(Entry);
+		}
+
+		/**
+		 * Mixes the bits of a hash so both the low and high bits are usable
+		 * @param hash The hash to mix
+		 * @returns The mixed hash
+		 */
+		static size_t mix(size_t hash) {
+			uint64_t h = static_cast<uint64_t>(hash);
+			h ^= h >> 33;
+			h *= 0xff51afd7ed558ccdull;
+			h ^= h >> 33;
+			h *= 0xc4ceb9fe1a85ec53ull;
+			h ^= h >> 33;
+			return static_cast<size_t>(h);
+		}
+
+		/**
+		 * Gets the mixed hash of a key
+		 * @param key The key to hash
+		 * @returns The hash of the key
+		 */
+		template<typename Q> size_t hashOf(const Q& key) const {
+			return mix(static_cast<size_t>(hasher(key)));
+		}
+
+		/**
+		 * Gets the 7 bit fragment of a hash stored in the control bytes
+		 * @param hash The hash
+		 * @returns The hash fragment
+		 */
+		static int8_t fragment(size_t hash) {
+			return static_cast<int8_t>(hash & 0x7F);
+		}
+
+		/**
+		 * Sets the control byte of a slot (and its clone)
+		 * @param index The index of the slot
+		 * @param value The new control byte
+		 */
+		void setCtrl(size_t index, int8_t value) {
+			ctrl[index] = value;
+			if (index < HashGroup::width)
+				ctrl[cap + index] = value;
+		}
+
+		/**
+		 * Finds the slot of a key
+		 * @param key The key to search for
+		 * @param hash The hash of the key
+		 * @returns The index of the slot (npos if not found)
+		 */
+		template<typename Q> size_t find(const Q& key, size_t hash) const {
+			if (cap == 0) return npos;
+			size_t mask = cap - 1;
+			size_t pos = (hash >> 7) & mask;
+			int8_t h2 = fragment(hash);
+			for (size_t step = HashGroup::width; ; step += HashGroup::width) {
+				HashGroup group(ctrl + pos);
+				for (uint32_t matches = group.match(h2); matches != 0; matches &= matches - 1) {
+					size_t index = (pos + HashGroup::lowestBit(matches)) & mask;
+					if (equal(slots[index].key, key)) return index;
+				}
+				if (group.matchEmpty() != 0) return npos;
+				pos = (pos + step) & mask;
+			}
+		}
+
+		/**
+		 * Finds the first slot without an element on the probe sequence of a hash
+		 * @param hash The hash to probe for
+		 * @returns The index of the slot
+		 */
+		size_t findFreeSlot(size_t hash) const {
+			size_t mask = cap - 1;
+			size_t pos = (hash >> 7) & mask;
+			for (size_t step = HashGroup::width; ; step += HashGroup::width) {
+				uint32_t free = HashGroup(ctrl + pos).matchEmptyOrDeleted();
+				if (free != 0) return (pos + HashGroup::lowestBit(free)) & mask;
+				pos = (pos + step) & mask;
+			}
+		}
+
+		/**
+		 * Where a key was found, or the free slot it would go in
+		 */
+		struct Claim {
+			/**
+			 * The index of the slot
+			 */
+			size_t index;
+
+			/**
+			 * The control byte to mark the slot with once its entry is constructed
+			 */
+			int8_t control;
+
+			/**
+			 * Whether or not the slot is free (the key isn't in the map)
+			 */
+			bool claimed;
+		};
+
+		/**
+		 * Finds the slot of a key, or a free slot for it if it isn't in the map
+		 * A free slot is left unmarked so a throwing constructor leaves the map unchanged, call occupy once its entry is constructed
+		 * @param key The key to search for
+		 * @returns The slot and whether or not it is free
+		 */
+		template<typename Q> Claim findOrClaim(const Q& key) {
+			size_t hash = hashOf(key);
+			size_t index = find(key, hash);
+			if (index != npos) return { index, 0, false };
+
+			if (growthLeft == 0)
+				grow();
+			return { findFreeSlot(hash), fragment(hash), true };
+		}
+
+		/**
+		 * Marks a claimed slot as holding an element, after its entry has been constructed
+		 * @param claim The slot returned by findOrClaim
+		 */
+		void occupy(const Claim& claim) {
+			if (ctrl[claim.index] == HashGroup::empty)
+				growthLeft--;
+			setCtrl(claim.index, claim.control);
+			size++;
+		}
+
+		/**
+		 * Makes room for a new element, either by clearing out deleted slots or doubling the capacity
+		 */
+		void grow() {
+			if (cap == 0)
+				resize(HashGroup::width);
+			else if (size <= maxLoad(cap) / 2)
+				resize(cap);
+			else
+				resize(cap * 2);
+		}
+
+		/**
+		 * Moves every element into a new table
+		 * @param newCap The number of slots of the new table (a power of two, at least 16)
+		 */
+		void resize(size_t newCap) {
+			int8_t* oldCtrl = ctrl;
+			Entry* oldSlots = slots;
+			size_t oldCap = cap;
+
+			char* block = static_cast<char*>(allocator().allocate(allocationSize(newCap), alignof(Entry)));
+			ctrl = reinterpret_cast<int8_t*>(block);
+			slots = reinterpret_cast<Entry*>(block + slotOffset(newCap));
+			cap = newCap;
+			std::memset(ctrl, static_cast<unsigned char>(HashGroup::empty), newCap + HashGroup::width);
+			growthLeft = maxLoad(newCap) - size;
+
+			for (size_t i = 0; i < oldCap; i++) {
+				if (oldCtrl[i] < 0) continue;
+				size_t hash = hashOf(oldSlots[i].key);
+				size_t index = findFreeSlot(hash);
+				setCtrl(index, fragment(hash));
+				relocate(&slots[index], &oldSlots[i], 1);
+			}
+
+			if (oldCtrl != nullptr)
+				allocator().deallocate(oldCtrl, allocationSize(oldCap), alignof(Entry));
+		}
+
+		/**
+		 * Destroys every element and frees the table
+		 */
+		void freeTable() {
+			if (ctrl == nullptr) return;
+			for (size_t i = 0; i < cap; i++) {
+				if (ctrl[i] >= 0)
+					slots[i].~Entry();
+			}
+			allocator().deallocate(ctrl, allocationSize(cap), alignof(Entry));
+			ctrl = nullptr;
+			slots = nullptr;
+			size = 0;
+			cap = 0;
+			growthLeft = 0;
+		}
+
+		/**
+		 * Copies the table of another map (this map must not have a table)
+		 * @param other The map to copy
+		 */
+		void copyFrom(const HashMap& other) {
+			if (other.cap == 0) return;
+			char* block = static_cast<char*>(allocator().allocate(allocationSize(other.cap), alignof(Entry)));
+			ctrl = reinterpret_cast<int8_t*>(block);
+			slots = reinterpret_cast<Entry*>(block + slotOffset(other.cap));
+			cap = other.cap;
+			growthLeft = other.growthLeft;
+			std::memcpy(ctrl, other.ctrl, cap + HashGroup::width);
+			for (size_t i = 0; i < cap; i++) {
+				if (ctrl[i] >= 0)
+					new(&slots[i]) Entry(other.slots[i]);
+			}
+			size = other.size;
+		}
+
+		/**
+		 * Removes the element in a slot
+		 * @param index The index of the slot
+		 */
+		void erase(size_t index) {
+			slots[index].~Entry();
+			size--;
+
+			// If no probe sequence ever saw a full group around this slot, it can go back to empty instead of deleted
+			size_t mask = cap - 1;
+			uint32_t emptyBefore = HashGroup(ctrl + ((index - HashGroup::width) & mask)).matchEmpty();
+			uint32_t emptyAfter = HashGroup(ctrl + index).matchEmpty();
+			bool neverFull = emptyBefore != 0 && emptyAfter != 0 &&
+				HashGroup::lowestBit(emptyAfter) + HashGroup::leadingZeros(emptyBefore) < HashGroup::width;
+
+			setCtrl(index, neverFull ? HashGroup::empty : HashGroup::deleted);
+			if (neverFull)
+				growthLeft++;
+		}
+
+	public:
+		/**
+		 * An iterator over the entries of the map
+		 */
+		using Iterator = EntryIterator<Entry>;
+
+		/**
+		 * An iterator over the entries of a constant map
+		 */
+		using ConstIterator = EntryIterator<const Entry>;
+
+		/**
+		 * Creates a new empty HashMap (Does not allocate until the first element is added)
+		 */
+		HashMap() = default;
+
+		/**
+		 * Creates a new empty HashMap which allocates from an allocator
+		 * @param allocator The allocator to request the table from
+		 */
+		HashMap(const Allocator& allocator) : Allocator(allocator) {}
+
+		/**
+		 * Creates a new empty HashMap with enough space for num elements
+		 * @param num The number of elements to prepare for
+		 * @param allocator The allocator to request the table from
+		 */
+		HashMap(size_t num, const Allocator& allocator = Allocator()) : Allocator(allocator) {
+			reserve(num);
+		}
+
+		/**
+		 * Creates a copy of another HashMap (Using the same allocator)
+		 * @param other The map to copy
+		 */
+		HashMap(const HashMap& other) : Allocator(other), hasher(other.hasher), equal(other.equal) {
+			copyFrom(other);
+		}
+
+		/**
+		 * Takes the table of another HashMap, leaving it empty
+		 * @param other The map to move from
+		 */
+		HashMap(HashMap&& other) noexcept : Allocator(other), hasher(other.hasher), equal(other.equal),
+			ctrl(other.ctrl), slots(other.slots), size(other.size), cap(other.cap), growthLeft(other.growthLeft) {
+			other.ctrl = nullptr;
+			other.slots = nullptr;
+			other.size = 0;
+			other.cap = 0;
+			other.growthLeft = 0;
+		}
+
+		/**
+		 * Replaces the contents of this map with a copy of another HashMap
+		 * @param other The map to copy
+		 * @returns This map
+		 */
+		HashMap& operator=(const HashMap& other) {
+			if (this != &other) {
+				freeTable();
+				hasher = other.hasher;
+				equal = other.equal;
+				copyFrom(other);
+			}
+			return *this;
+		}
+
+		/**
+		 * Replaces the contents of this map with the table (and allocator) of another HashMap
+		 * @param other The map to move from
+		 * @returns This map
+		 */
+		HashMap& operator=(HashMap&& other) noexcept {
+			if (this != &other) {
+				freeTable();
+				allocator() = static_cast<Allocator&>(other);
+				hasher = other.hasher;
+				equal = other.equal;
+				std::swap(ctrl, other.ctrl);
+				std::swap(slots, other.slots);
+				std::swap(size, other.size);
+				std::swap(cap, other.cap);
+				std::swap(growthLeft, other.growthLeft);
+			}
+			return *this;
+		}
+
+		/**
+		 * Frees resources
+		 */
+		~HashMap() {
+			freeTable();
+		}
+
+		/**
+		 * Gets the value of a key, inserting a default constructed value if it isn't in the map
+		 * @param key The key of the value
+		 * @returns The value of the key
+		 */
+		V& operator[](const K& key) {
+			return emplace(key);
+		}
+
+		/**
+		 * Gets the value of a key, inserting a default constructed value if it isn't in the map
+		 * @param key The key of the value
+		 * @returns The value of the key
+		 */
+		V& operator[](K&& key) {
+			return emplace(std::move(key));
+		}
+
+		/**
+		 * Gets the value of a key, constructing a new value from the arguments if it isn't in the map
+		 * @param key The key of the value
+		 * @param args The arguments to construct the value with (unused if the key exists)
+		 * @returns The value of the key
+		 */
+		template<typename KK, typename... Args>
+		V& emplace(KK&& key, Args&&... args) {
+			if constexpr (!std::is_same_v<std::decay_t<KK>, K> && !IsTransparent<Hash, Equal>::value) {
+				// Convert once up front rather than on every key comparison
+				return emplace(K(std::forward<KK>(key)), std::forward<Args>(args)...);
+			}
+			else {
+				Claim slot = findOrClaim(key);
+				if (slot.claimed) {
+					new(&slots[slot.index]) Entry{ K(std::forward<KK>(key)), V(std::forward<Args>(args)...) };
+					occupy(slot);
+				}
+				return slots[slot.index].value;
+			}
+		}
+
+		/**
+		 * Adds a new element to the map if the key isn't already in it
+		 * @param key The key of the element
+		 * @param value The value of the element
+		 * @returns Whether or not the element was added
+		 */
+		template<typename KK, typename VV>
+		bool insert(KK&& key, VV&& value) {
+			if constexpr (!std::is_same_v<std::decay_t<KK>, K> && !IsTransparent<Hash, Equal>::value) {
+				// Convert once up front rather than on every key comparison
+				return insert(K(std::forward<KK>(key)), std::forward<VV>(value));
+			}
+			else {
+				Claim slot = findOrClaim(key);
+				if (slot.claimed) {
+					new(&slots[slot.index]) Entry{ K(std::forward<KK>(key)), V(std::forward<VV>(value)) };
+					occupy(slot);
+				}
+				return slot.claimed;
+			}
+		}
+
+		/**
+		 * Sets the value of a key, replacing the old value if the key is already in the map
+		 * @param key The key of the element
+		 * @param value The value of the element
+		 */
+		template<typename KK, typename VV>
+		void set(KK&& key, VV&& value) {
+			if constexpr (!std::is_same_v<std::decay_t<KK>, K> && !IsTransparent<Hash, Equal>::value) {
+				// Convert once up front rather than on every key comparison
+				set(K(std::forward<KK>(key)), std::forward<VV>(value));
+			}
+			else {
+				Claim slot = findOrClaim(key);
+				if (slot.claimed) {
+					new(&slots[slot.index]) Entry{ K(std::forward<KK>(key)), V(std::forward<VV>(value)) };
+					occupy(slot);
+				}
+				else
+					slots[slot.index].value = std::forward<VV>(value);
+			}
+		}
+
+		/**
+		 * Gets the value of a key
+		 * @param key The key to search for
+		 * @returns The value of the key (nullptr if it isn't in the map)
+		 */
+		V* get(const K& key) {
+			size_t index = find(key, hashOf(key));
+			return index == npos ? nullptr : &slots[index].value;
+		}
+
+		/**
+		 * Gets the value of a key
+		 * @param key The key to search for
+		 * @returns The value of the key (nullptr if it isn't in the map)
+		 */
+		const V* get(const K& key) const {
+			size_t index = find(key, hashOf(key));
+			return index == npos ? nullptr : &slots[index].value;
+		}
+
+		/**
+		 * Gets the value of a key using a key of another type (requires a transparent Hash and Equal)
+		 * @param key The key to search for
+		 * @returns The value of the key (nullptr if it isn't in the map)
+		 */
+		template<typename Q, typename H = Hash, typename = std::enable_if_t<IsTransparent<H, Equal>::value>>
+		V* get(const Q& key) {
+			size_t index = find(key, hashOf(key));
+			return index == npos ? nullptr : &slots[index].value;
+		}
+
+		/**
+		 * Gets the value of a key using a key of another type (requires a transparent Hash and Equal)
+		 * @param key The key to search for
+		 * @returns The value of the key (nullptr if it isn't in the map)
+		 */
+		template<typename Q, typename H = Hash, typename = std::enable_if_t<IsTransparent<H, Equal>::value>>
+		const V* get(const Q& key) const {
+			size_t index = find(key, hashOf(key));
+			return index == npos ? nullptr : &slots[index].value;
+		}
+
+		/**
+		 * Checks if a key is in the map
+		 * @param key The key to search for
+		 * @returns Whether or not the map contains the key
+		 */
+		bool contains(const K& key) const {
+			return find(key, hashOf(key)) != npos;
+		}
+
+		/**
+		 * Checks if a key is in the map using a key of another type (requires a transparent Hash and Equal)
+		 * @param key The key to search for
+		 * @returns Whether or not the map contains the key
+		 */
+		template<typename Q, typename H = Hash, typename = std::enable_if_t<IsTransparent<H, Equal>::value>>
+		bool contains(const Q& key) const {
+			return find(key, hashOf(key)) != npos;
+		}
+
+		/**
+		 * Removes a key and its value from the map
+		 * @param key The key to remove
+		 * @returns Whether or not the key was in the map
+		 */
+		bool remove(const K& key) {
+			size_t index = find(key, hashOf(key));
+			if (index == npos) return false;
+			erase(index);
+			return true;
+		}
+
+		/**
+		 * Removes a key and its value from the map using a key of another type (requires a transparent Hash and Equal)
+		 * @param key The key to remove
+		 * @returns Whether or not the key was in the map
+		 */
+		template<typename Q, typename H = Hash, typename = std::enable_if_t<IsTransparent<H, Equal>::value>>
+		bool remove(const Q& key) {
+			size_t index = find(key, hashOf(key));
+			if (index == npos) return false;
+			erase(index);
+			return true;
+		}
+
+		/**
+		 * Completely removes all elements in the map (keeps the table allocated)
+		 */
+		void clear() {
+			if (cap == 0) return;
+			for (size_t i = 0; i < cap; i++) {
+				if (ctrl[i] >= 0)
+					slots[i].~Entry();
+			}
+			std::memset(ctrl, static_cast<unsigned char>(HashGroup::empty), cap + HashGroup::width);
+			size = 0;
+			growthLeft = maxLoad(cap);
+		}
+
+		/**
+		 * Returns the length of the data structure
+		 * @returns The number of elements in the map
+		 */
+		inline size_t length() const {
+			return size;
+		}
+
+		/**
+		 * Returns the number of slots in the table
+		 * @returns The capacity of the map
+		 */
+		inline size_t capacity() const {
+			return cap;
+		}
+
+		/**
+		 * Expands the table so num elements fit without rehashing
+		 * @param num The total number of elements to prepare for
+		 */
+		void reserve(size_t num) {
+			if (num <= size + growthLeft) return;
+			rehash(num);
+		}
+
+		/**
+		 * Rebuilds the table with the smallest capacity which fits max(num, length()) elements
+		 * Clears out deleted slots, rehash(0) shrinks the table to fit
+		 * @param num The number of elements to prepare for
+		 */
+		void rehash(size_t num) {
+			if (num < size)
+				num = size;
+			if (num == 0) {
+				freeTable();
+				return;
+			}
+			size_t newCap = HashGroup::width;
+			while (maxLoad(newCap) < num)
+				newCap *= 2;
+			resize(newCap);
+		}
+
+		/**
+		 * Gets an iterator to the first entry of the map
+		 * @returns The iterator
+		 */
+		Iterator begin() {
+			return Iterator(ctrl, slots, slots + cap);
+		}
+
+		/**
+		 * Gets an iterator past the last entry of the map
+		 * @returns The iterator
+		 */
+		Iterator end() {
+			return Iterator(ctrl + cap, slots + cap, slots + cap);
+		}
+
+		/**
+		 * Gets an iterator to the first entry of the map
+		 * @returns The iterator
+		 */
+		ConstIterator begin() const {
+			return ConstIterator(ctrl, slots, slots + cap);
+		}
+
+		/**
+		 * Gets an iterator past the last entry of the map
+		 * @returns The iterator
+		 */
+		ConstIterator end() const {
+			return ConstIterator(ctrl + cap, slots + cap, slots + cap);
+		}
+	};
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
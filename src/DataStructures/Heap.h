@@ -0,0 +1,567 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "List.h"
+#include "ArrayList.h"
+#include "Allocator.h"
+#include <assert.h>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+/**
+ * The main namespace for data structures in the essentials library
+ */
+namespace Essentials::DataStructures {
+
+	/**
+	 * A namespace alias to the data structures namespace
+	 */
+	namespace ds = DataStructures;
+
+	/**
+	 * A priority queue stored implicitly in an array as a d-ary heap (satisfies the queue contract, see IsQueue)
+	 *
+	 * The element at the top is the one no other element compares less than (a min heap with std::less).
+	 * With 4 children per node the heap is half as deep as a binary heap and the children of a node share a cache line.
+	 * @tparam Compare The strict weak ordering of the elements
+	 * @tparam Arity The number of children of every node
+	 * @tparam Allocator The allocator the elements are requested from (see HeapAllocator)
+	 */
+	template<typename T, typename Compare = std::less<T>, size_t Arity = 4, typename Allocator = HeapAllocator>
+	class Heap {
+	private:
+		static_assert(Arity >= 2, "A heap needs at least 2 children per node");
+
+		/**
+		 * The elements in heap order
+		 */
+		ArrayList<T, Allocator> items;
+
+		/**
+		 * The ordering of the elements
+		 */
+		Compare compare;
+
+		/**
+		 * Moves an element towards the top until its parent is not greater than it
+		 * @param index The index of the element
+		 */
+		void siftUp(size_t index) {
+			T item(std::move(items[index]));
+			while (index > 0) {
+				size_t parent = (index - 1) / Arity;
+				if (!compare(item, items[parent])) break;
+				items[index] = std::move(items[parent]);
+				index = parent;
+			}
+			items[index] = std::move(item);
+		}
+
+		/**
+		 * Moves an element towards the bottom until none of its children are less than it
+		 * @param index The index of the element
+		 */
+		void siftDown(size_t index) {
+			size_t count = items.length();
+			T item(std::move(items[index]));
+			while (true) {
+				size_t first = index * Arity + 1;
+				if (first >= count) break;
+				size_t last = first + Arity < count ? first + Arity : count;
+				size_t best = first;
+				for (size_t child = first + 1; child < last; child++) {
+					if (compare(items[child], items[best])) best = child;
+				}
+				if (!compare(items[best], item)) break;
+				items[index] = std::move(items[best]);
+				index = best;
+			}
+			items[index] = std::move(item);
+		}
+
+		/**
+		 * Restores the heap order of every element in linear time
+		 */
+		void heapify() {
+			size_t count = items.length();
+			if (count < 2) return;
+			for (size_t i = (count - 2) / Arity + 1; i-- > 0;)
+				siftDown(i);
+		}
+
+	public:
+		/**
+		 * Creates a new empty Heap (Does not allocate until the first element is added)
+		 * @param compare The ordering of the elements
+		 * @param allocator The allocator to request the elements from
+		 */
+		Heap(const Compare& compare = Compare(), const Allocator& allocator = Allocator()) : items(allocator), compare(compare) {}
+
+		/**
+		 * Creates a new empty Heap with enough space for num elements
+		 * @param num The number of elements to prepare for
+		 * @param compare The ordering of the elements
+		 * @param allocator The allocator to request the elements from
+		 */
+		Heap(size_t num, const Compare& compare = Compare(), const Allocator& allocator = Allocator()) : items(allocator), compare(compare) {
+			items.prepare(num);
+		}
+
+		/**
+		 * Creates a new Heap from the elements of a list in linear time
+		 * @param list The elements to add
+		 * @param compare The ordering of the elements
+		 * @param allocator The allocator to request the elements from
+		 */
+		template<typename L, typename = std::enable_if_t<isList<L>>>
+		Heap(const L& list, const Compare& compare = Compare(), const Allocator& allocator = Allocator()) : items(allocator), compare(compare) {
+			items.push(list);
+			heapify();
+		}
+
+		/**
+		 * Creates a new Heap which takes the elements of a list in linear time (without copying them)
+		 * @param list The elements to take
+		 * @param compare The ordering of the elements
+		 */
+		Heap(ArrayList<T, Allocator>&& list, const Compare& compare = Compare()) : items(std::move(list)), compare(compare) {
+			heapify();
+		}
+
+		/**
+		 * Adds an element to the heap
+		 * @param item The element to add
+		 */
+		void push(const T& item) {
+			items.push(item);
+			siftUp(items.length() - 1);
+		}
+
+		/**
+		 * Adds an element to the heap
+		 * @param item The element to add
+		 */
+		void push(T&& item) {
+			items.push(std::move(item));
+			siftUp(items.length() - 1);
+		}
+
+		/**
+		 * Adds every element of a list to the heap (rebuilds the heap when that is cheaper than adding them one by one)
+		 * @param list The elements to add
+		 */
+		template<typename L, typename = std::enable_if_t<isList<L>>>
+		void push(const L& list) {
+			size_t start = items.length();
+			items.push(list);
+			size_t added = items.length() - start;
+			if (added * 4 >= items.length()) heapify();
+			else for (size_t i = start; i < items.length(); i++) siftUp(i);
+		}
+
+		/**
+		 * Constructs a new element in the heap
+		 * @param args The arguments to construct the element with
+		 */
+		template<typename... Args>
+		void emplace(Args&&... args) {
+			items.emplace(std::forward<Args>(args)...);
+			siftUp(items.length() - 1);
+		}
+
+		/**
+		 * Removes the top element from the heap
+		 * @returns The element removed
+		 */
+		T dequeue() {
+			assert(items.length() > 0);
+			size_t last = items.length() - 1;
+			T top(std::move(items[0]));
+			if (last > 0) {
+				items[0] = std::move(items[last]);
+				items.remove(last);
+				siftDown(0);
+			}
+			else items.remove(last);
+			return top;
+		}
+
+		/**
+		 * Returns the top element of the heap without removing it
+		 * @returns The top element (must not be modified in a way that changes its order)
+		 */
+		const T& peek() const {
+			assert(items.length() > 0);
+			return items[0];
+		}
+
+		/**
+		 * Replaces the top element with a new element (cheaper than a dequeue followed by a push)
+		 * @param item The element to add
+		 * @returns The previous top element
+		 */
+		T replace(T item) {
+			assert(items.length() > 0);
+			std::swap(item, items[0]);
+			siftDown(0);
+			return item;
+		}
+
+		/**
+		 * Completely removes all items in the heap
+		 */
+		void clear() {
+			items.clear();
+		}
+
+		/**
+		 * Returns the length of the data structure
+		 * @returns The number of elements in the heap
+		 */
+		inline size_t length() const {
+			return items.length();
+		}
+
+		/**
+		 * Prepares the heap for a set number of elements
+		 * @param num The number of elements to prepare for
+		 */
+		void prepare(size_t num) {
+			items.prepare(num);
+		}
+	};
+
+	/**
+	 * A d-ary heap whose elements can be found, changed and removed through the handle returned when they were added
+	 *
+	 * The heap stores each element next to its handle, and a table maps every handle to the current position of its element.
+	 * Handles are reused after their element is removed.
+	 * @tparam Compare The strict weak ordering of the elements
+	 * @tparam Arity The number of children of every node
+	 * @tparam Allocator The allocator the elements are requested from (see HeapAllocator)
+	 */
+	template<typename T, typename Compare = std::less<T>, size_t Arity = 4, typename Allocator = HeapAllocator>
+	class IndexedHeap {
+	public:
+		/**
+		 * Identifies an element of the heap
+		 */
+		using Handle = size_t;
+
+	private:
+		static_assert(Arity >= 2, "A heap needs at least 2 children per node");
+
+		/**
+		 * The position of a handle which has no element
+		 */
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		/**
+		 * An element of the heap and its handle
+		 */
+		struct Entry {
+			/**
+			 * The element
+			 */
+			T item;
+
+			/**
+			 * The handle of the element
+			 */
+			Handle handle;
+		};
+
+		/**
+		 * The entries in heap order
+		 */
+		ArrayList<Entry, Allocator> entries;
+
+		/**
+		 * The index in entries of the element of every handle (npos for unused handles)
+		 */
+		ArrayList<size_t, Allocator> positions;
+
+		/**
+		 * Handles which are free to be reused
+		 */
+		ArrayList<Handle, Allocator> freeHandles;
+
+		/**
+		 * The ordering of the elements
+		 */
+		Compare compare;
+
+		/**
+		 * Moves an entry into a position, updating its handle
+		 * @param index The position to move to
+		 * @param entry The entry to move
+		 */
+		void place(size_t index, Entry&& entry) {
+			positions[entry.handle] = index;
+			entries[index] = std::move(entry);
+		}
+
+		/**
+		 * Moves an element towards the top until its parent is not greater than it
+		 * @param index The index of the element
+		 */
+		void siftUp(size_t index) {
+			Entry entry(std::move(entries[index]));
+			while (index > 0) {
+				size_t parent = (index - 1) / Arity;
+				if (!compare(entry.item, entries[parent].item)) break;
+				place(index, std::move(entries[parent]));
+				index = parent;
+			}
+			place(index, std::move(entry));
+		}
+
+		/**
+		 * Moves an element towards the bottom until none of its children are less than it
+		 * @param index The index of the element
+		 */
+		void siftDown(size_t index) {
+			size_t count = entries.length();
+			Entry entry(std::move(entries[index]));
+			while (true) {
+				size_t first = index * Arity + 1;
+				if (first >= count) break;
+				size_t last = first + Arity < count ? first + Arity : count;
+				size_t best = first;
+				for (size_t child = first + 1; child < last; child++) {
+					if (compare(entries[child].item, entries[best].item)) best = child;
+				}
+				if (!compare(entries[best].item, entry.item)) break;
+				place(index, std::move(entries[best]));
+				index = best;
+			}
+			place(index, std::move(entry));
+		}
+
+		/**
+		 * Gets an unused handle
+		 * @returns The handle
+		 */
+		Handle claimHandle() {
+			if (freeHandles.length() > 0) {
+				Handle handle = freeHandles[freeHandles.length() - 1];
+				freeHandles.remove(freeHandles.length() - 1);
+				return handle;
+			}
+			positions.push(npos);
+			return positions.length() - 1;
+		}
+
+		/**
+		 * Removes the element at a position of the heap
+		 * @param index The position of the element
+		 * @returns The element removed
+		 */
+		T removeAt(size_t index) {
+			size_t last = entries.length() - 1;
+			Handle handle = entries[index].handle;
+			T item(std::move(entries[index].item));
+			positions[handle] = npos;
+			freeHandles.push(handle);
+			if (index != last) {
+				place(index, std::move(entries[last]));
+				entries.remove(last);
+				if (index > 0 && compare(entries[index].item, entries[(index - 1) / Arity].item)) siftUp(index);
+				else siftDown(index);
+			}
+			else entries.remove(last);
+			return item;
+		}
+
+	public:
+		/**
+		 * Creates a new empty IndexedHeap (Does not allocate until the first element is added)
+		 * @param compare The ordering of the elements
+		 * @param allocator The allocator to request the elements from
+		 */
+		IndexedHeap(const Compare& compare = Compare(), const Allocator& allocator = Allocator()) :
+			entries(allocator), positions(allocator), freeHandles(allocator), compare(compare) {}
+
+		/**
+		 * Creates a new IndexedHeap from the elements of a list in linear time (the element at index i gets handle i)
+		 * @param list The elements to add
+		 * @param compare The ordering of the elements
+		 * @param allocator The allocator to request the elements from
+		 */
+		template<typename L, typename = std::enable_if_t<isList<L>>>
+		IndexedHeap(const L& list, const Compare& compare = Compare(), const Allocator& allocator = Allocator()) :
+			entries(allocator), positions(allocator), freeHandles(allocator), compare(compare) {
+			size_t count = list.length();
+			entries.prepare(count);
+			positions.prepare(count);
+			for (size_t i = 0; i < count; i++) {
+				entries.push(Entry{ list[i], i });
+				positions.push(i);
+			}
+			if (count < 2) return;
+			for (size_t i = (count - 2) / Arity + 1; i-- > 0;)
+				siftDown(i);
+		}
+
+		/**
+		 * Adds an element to the heap
+		 * @param item The element to add
+		 * @returns The handle of the element
+		 */
+		Handle push(const T& item) {
+			return emplace(item);
+		}
+
+		/**
+		 * Adds an element to the heap
+		 * @param item The element to add
+		 * @returns The handle of the element
+		 */
+		Handle push(T&& item) {
+			return emplace(std::move(item));
+		}
+
+		/**
+		 * Constructs a new element in the heap
+		 * @param args The arguments to construct the element with
+		 * @returns The handle of the element
+		 */
+		template<typename... Args>
+		Handle emplace(Args&&... args) {
+			Handle handle = claimHandle();
+			entries.push(Entry{ T(std::forward<Args>(args)...), handle });
+			siftUp(entries.length() - 1);
+			return handle;
+		}
+
+		/**
+		 * Removes the top element from the heap
+		 * @returns The element removed
+		 */
+		T dequeue() {
+			assert(entries.length() > 0);
+			return removeAt(0);
+		}
+
+		/**
+		 * Returns the top element of the heap without removing it
+		 * @returns The top element
+		 */
+		const T& peek() const {
+			assert(entries.length() > 0);
+			return entries[0].item;
+		}
+
+		/**
+		 * Returns the handle of the top element of the heap
+		 * @returns The handle of the top element
+		 */
+		Handle peekHandle() const {
+			assert(entries.length() > 0);
+			return entries[0].handle;
+		}
+
+		/**
+		 * Gets the element of a handle
+		 * @param handle The handle of the element (must be in the heap)
+		 * @returns The element
+		 */
+		const T& get(Handle handle) const {
+			assert(contains(handle));
+			return entries[positions[handle]].item;
+		}
+
+		/**
+		 * Checks if a handle has an element in the heap
+		 * @param handle The handle to check
+		 * @returns Whether or not the handle is in the heap
+		 */
+		bool contains(Handle handle) const {
+			return handle < positions.length() && positions[handle] != npos;
+		}
+
+		/**
+		 * Replaces an element with one which is not greater than it, moving it towards the top
+		 * @param handle The handle of the element (must be in the heap)
+		 * @param item The new element
+		 */
+		void decreaseKey(Handle handle, T item) {
+			assert(contains(handle));
+			size_t index = positions[handle];
+			assert(!compare(entries[index].item, item));
+			entries[index].item = std::move(item);
+			siftUp(index);
+		}
+
+		/**
+		 * Replaces an element, moving it up or down the heap as needed
+		 * @param handle The handle of the element (must be in the heap)
+		 * @param item The new element
+		 */
+		void update(Handle handle, T item) {
+			assert(contains(handle));
+			size_t index = positions[handle];
+			bool up = compare(item, entries[index].item);
+			entries[index].item = std::move(item);
+			if (up) siftUp(index);
+			else siftDown(index);
+		}
+
+		/**
+		 * Removes the element of a handle (the handle may be reused afterwards)
+		 * @param handle The handle of the element (must be in the heap)
+		 * @returns The element removed
+		 */
+		T erase(Handle handle) {
+			assert(contains(handle));
+			return removeAt(positions[handle]);
+		}
+
+		/**
+		 * Completely removes all items in the heap (every handle becomes unused)
+		 */
+		void clear() {
+			entries.clear();
+			positions.clear();
+			freeHandles.clear();
+		}
+
+		/**
+		 * Returns the length of the data structure
+		 * @returns The number of elements in the heap
+		 */
+		inline size_t length() const {
+			return entries.length();
+		}
+
+		/**
+		 * Prepares the heap for a set number of elements
+		 * @param num The number of elements to prepare for
+		 */
+		void prepare(size_t num) {
+			entries.prepare(num);
+			positions.prepare(num);
+		}
+	};
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
@@ -17,6 +17,12 @@
 #pragma once
 
 #include "Iterator.h"
+#include "ArrayList.h"
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 /**
  * The main namespace for data structures in the essentials library
@@ -28,10 +34,750 @@ namespace Essentials::DataStructures {
 	 */
 	namespace ds = DataStructures;
 
-	class Iterable {
+	template<typename I> class Iterable;
+
+	/**
+	 * A function (usually a lambda) held by a view iterator
+	 * Lambdas can't be assigned, so assigning replaces the function by copy constructing it in place
+	 */
+	template<typename F> class StoredFunction {
+	private:
+		/**
+		 * The function
+		 */
+		F function;
+
+	public:
+		/**
+		 * Stores a function
+		 * @param function The function to store
+		 */
+		StoredFunction(F function) : function(std::move(function)) {}
+
+		/**
+		 * Copies a stored function
+		 * @param other The function to copy
+		 */
+		StoredFunction(const StoredFunction& other) = default;
+
+		/**
+		 * Replaces the function with a copy of another
+		 * @param other The function to copy
+		 * @returns This function
+		 */
+		StoredFunction& operator=(const StoredFunction& other) {
+			if (this != &other) {
+				function.~F();
+				new(&function) F(other.function);
+			}
+			return *this;
+		}
+
+		/**
+		 * Calls the function
+		 * @param args The arguments to call the function with
+		 * @returns The result of the function
+		 */
+		template<typename... Args>
+		decltype(auto) operator()(Args&&... args) const {
+			return function(std::forward<Args>(args)...);
+		}
+	};
+
+	/**
+	 * An iterator over the elements of another iterator which match a predicate
+	 */
+	template<typename I, typename P> class FilterIterator {
+	private:
+		/**
+		 * The current element
+		 */
+		I current;
+
+		/**
+		 * The end of the underlying range
+		 */
+		I last;
+
+		/**
+		 * Whether or not an element is kept
+		 */
+		StoredFunction<P> predicate;
+
+		/**
+		 * Advances to the next kept element (stays if the current element is kept)
+		 */
+		void skip() {
+			while (current != last && !predicate(*current))
+				++current;
+		}
+
+	public:
+		/**
+		 * The iterator category
+		 */
+		using iterator_category = std::forward_iterator_tag;
+
+		/**
+		 * The type of the elements
+		 */
+		using value_type = typename std::iterator_traits<I>::value_type;
+
+		/**
+		 * The type of the distance between two iterators
+		 */
+		using difference_type = std::ptrdiff_t;
+
+		/**
+		 * A pointer to an element
+		 */
+		using pointer = typename std::iterator_traits<I>::pointer;
+
+		/**
+		 * The type the iterator dereferences to
+		 */
+		using reference = typename std::iterator_traits<I>::reference;
+
+		/**
+		 * Creates an iterator at the first kept element from a position
+		 * @param current The position to start at
+		 * @param last The end of the underlying range
+		 * @param predicate Whether or not an element is kept
+		 */
+		FilterIterator(I current, I last, const P& predicate) : current(current), last(last), predicate(predicate) {
+			skip();
+		}
+
+		/**
+		 * Gets the current element
+		 * @returns The element
+		 */
+		reference operator*() const {
+			return *current;
+		}
+
+		/**
+		 * Advances to the next kept element
+		 * @returns This iterator
+		 */
+		FilterIterator& operator++() {
+			++current;
+			skip();
+			return *this;
+		}
+
+		/**
+		 * Advances to the next kept element
+		 * @returns The iterator before advancing
+		 */
+		FilterIterator operator++(int) {
+			FilterIterator previous = *this;
+			++*this;
+			return previous;
+		}
+
+		/**
+		 * Checks if two iterators are at the same element
+		 * @param other The iterator to compare with
+		 * @returns Whether or not the iterators are equal
+		 */
+		bool operator==(const FilterIterator& other) const {
+			return current == other.current;
+		}
+
+		/**
+		 * Checks if two iterators are at different elements
+		 * @param other The iterator to compare with
+		 * @returns Whether or not the iterators are different
+		 */
+		bool operator!=(const FilterIterator& other) const {
+			return current != other.current;
+		}
+	};
+
+	/**
+	 * An iterator over the results of a function applied to the elements of another iterator (computed when dereferenced)
+	 */
+	template<typename I, typename F> class MapIterator {
+	private:
+		/**
+		 * The current element
+		 */
+		I current;
+
+		/**
+		 * The function applied to each element
+		 */
+		StoredFunction<F> function;
+
+	public:
+		/**
+		 * The iterator category
+		 */
+		using iterator_category = std::forward_iterator_tag;
+
+		/**
+		 * The type the iterator dereferences to
+		 */
+		using reference = decltype(std::declval<const StoredFunction<F>&>()(*std::declval<I&>()));
+
+		/**
+		 * The type of the elements
+		 */
+		using value_type = std::decay_t<reference>;
+
+		/**
+		 * The type of the distance between two iterators
+		 */
+		using difference_type = std::ptrdiff_t;
+
+		/**
+		 * A pointer to an element
+		 */
+		using pointer = void;
+
+		/**
+		 * Creates an iterator at an element
+		 * @param current The element
+		 * @param function The function applied to each element
+		 */
+		MapIterator(I current, const F& function) : current(current), function(function) {}
+
+		/**
+		 * Applies the function to the current element
+		 * @returns The result of the function
+		 */
+		reference operator*() const {
+			return function(*current);
+		}
+
+		/**
+		 * Advances to the next element
+		 * @returns This iterator
+		 */
+		MapIterator& operator++() {
+			++current;
+			return *this;
+		}
+
+		/**
+		 * Advances to the next element
+		 * @returns The iterator before advancing
+		 */
+		MapIterator operator++(int) {
+			MapIterator previous = *this;
+			++current;
+			return previous;
+		}
+
+		/**
+		 * Checks if two iterators are at the same element
+		 * @param other The iterator to compare with
+		 * @returns Whether or not the iterators are equal
+		 */
+		bool operator==(const MapIterator& other) const {
+			return current == other.current;
+		}
+
+		/**
+		 * Checks if two iterators are at different elements
+		 * @param other The iterator to compare with
+		 * @returns Whether or not the iterators are different
+		 */
+		bool operator!=(const MapIterator& other) const {
+			return current != other.current;
+		}
+	};
+
+	/**
+	 * An iterator over at most a number of elements of another iterator
+	 */
+	template<typename I> class TakeIterator {
+	private:
+		/**
+		 * The current element
+		 */
+		I current;
+
+		/**
+		 * The end of the underlying range
+		 */
+		I last;
+
+		/**
+		 * The number of elements left to take
+		 */
+		size_t remaining;
+
+		/**
+		 * Checks if the iterator is past the last taken element
+		 * @returns Whether or not the iteration is over
+		 */
+		bool done() const {
+			return remaining == 0 || current == last;
+		}
+
+	public:
+		/**
+		 * The iterator category
+		 */
+		using iterator_category = std::forward_iterator_tag;
+
+		/**
+		 * The type of the elements
+		 */
+		using value_type = typename std::iterator_traits<I>::value_type;
+
+		/**
+		 * The type of the distance between two iterators
+		 */
+		using difference_type = std::ptrdiff_t;
+
+		/**
+		 * A pointer to an element
+		 */
+		using pointer = typename std::iterator_traits<I>::pointer;
+
+		/**
+		 * The type the iterator dereferences to
+		 */
+		using reference = typename std::iterator_traits<I>::reference;
+
+		/**
+		 * Creates an iterator at an element
+		 * @param current The element
+		 * @param last The end of the underlying range
+		 * @param remaining The number of elements left to take (0 for the end)
+		 */
+		TakeIterator(I current, I last, size_t remaining) : current(current), last(last), remaining(remaining) {}
+
+		/**
+		 * Gets the current element
+		 * @returns The element
+		 */
+		reference operator*() const {
+			return *current;
+		}
+
+		/**
+		 * Advances to the next element
+		 * @returns This iterator
+		 */
+		TakeIterator& operator++() {
+			++current;
+			remaining--;
+			return *this;
+		}
+
+		/**
+		 * Advances to the next element
+		 * @returns The iterator before advancing
+		 */
+		TakeIterator operator++(int) {
+			TakeIterator previous = *this;
+			++*this;
+			return previous;
+		}
+
+		/**
+		 * Checks if two iterators are at the same element (every finished iterator is equal)
+		 * @param other The iterator to compare with
+		 * @returns Whether or not the iterators are equal
+		 */
+		bool operator==(const TakeIterator& other) const {
+			if (done() || other.done()) return done() == other.done();
+			return current == other.current;
+		}
+
+		/**
+		 * Checks if two iterators are at different elements
+		 * @param other The iterator to compare with
+		 * @returns Whether or not the iterators are different
+		 */
+		bool operator!=(const TakeIterator& other) const {
+			return !(*this == other);
+		}
+	};
+
+	/**
+	 * An iterator over pairs of elements from two iterators, ending with the shorter range
+	 */
+	template<typename I, typename J> class ZipIterator {
+	private:
+		/**
+		 * The current element of the first range
+		 */
+		I first;
+
+		/**
+		 * The current element of the second range
+		 */
+		J second;
+
+	public:
+		/**
+		 * The iterator category
+		 */
+		using iterator_category = std::forward_iterator_tag;
+
+		/**
+		 * The type the iterator dereferences to
+		 */
+		using reference = std::pair<typename std::iterator_traits<I>::reference, typename std::iterator_traits<J>::reference>;
+
+		/**
+		 * The type of the elements
+		 */
+		using value_type = std::pair<typename std::iterator_traits<I>::value_type, typename std::iterator_traits<J>::value_type>;
+
+		/**
+		 * The type of the distance between two iterators
+		 */
+		using difference_type = std::ptrdiff_t;
+
+		/**
+		 * A pointer to an element
+		 */
+		using pointer = void;
+
+		/**
+		 * Creates an iterator at a pair of elements
+		 * @param first The element of the first range
+		 * @param second The element of the second range
+		 */
+		ZipIterator(I first, J second) : first(first), second(second) {}
+
+		/**
+		 * Gets the current pair of elements
+		 * @returns The elements, as references
+		 */
+		reference operator*() const {
+			return reference(*first, *second);
+		}
+
+		/**
+		 * Advances both ranges to their next element
+		 * @returns This iterator
+		 */
+		ZipIterator& operator++() {
+			++first;
+			++second;
+			return *this;
+		}
+
+		/**
+		 * Advances both ranges to their next element
+		 * @returns The iterator before advancing
+		 */
+		ZipIterator operator++(int) {
+			ZipIterator previous = *this;
+			++*this;
+			return previous;
+		}
+
+		/**
+		 * Checks if both ranges are at the same elements as in another iterator
+		 * @param other The iterator to compare with
+		 * @returns Whether or not the iterators are equal
+		 */
+		bool operator==(const ZipIterator& other) const {
+			return first == other.first && second == other.second;
+		}
+
+		/**
+		 * Checks if either range is at a different element than in another iterator
+		 * @param other The iterator to compare with
+		 * @returns Whether or not the iterators are different
+		 */
+		bool operator!=(const ZipIterator& other) const {
+			return !(*this == other);
+		}
+	};
+
+	/**
+	 * An iterator over consecutive groups of elements of another iterator (the last group may be shorter)
+	 */
+	template<typename I> class ChunkIterator {
+	private:
+		/**
+		 * The current group (stored so dereferencing can return a reference to it)
+		 */
+		Iterable<I> group;
+
+		/**
+		 * The end of the underlying range
+		 */
+		I last;
+
+		/**
+		 * The number of elements in a group
+		 */
+		size_t size;
+
+		/**
+		 * Finds the group starting at an element
+		 * @param start The first element of the group
+		 */
+		void findGroup(I start) {
+			I next = start;
+			for (size_t i = 0; i < size && next != last; i++)
+				++next;
+			group = Iterable<I>(start, next);
+		}
+
+	public:
+		/**
+		 * The iterator category
+		 */
+		using iterator_category = std::forward_iterator_tag;
+
+		/**
+		 * The type of the elements
+		 */
+		using value_type = Iterable<I>;
+
+		/**
+		 * The type of the distance between two iterators
+		 */
+		using difference_type = std::ptrdiff_t;
+
+		/**
+		 * A pointer to an element
+		 */
+		using pointer = const Iterable<I>*;
+
+		/**
+		 * The type the iterator dereferences to
+		 */
+		using reference = const Iterable<I>&;
+
+		/**
+		 * Creates an iterator at the group starting at an element
+		 * @param current The first element of the group
+		 * @param last The end of the underlying range
+		 * @param size The number of elements in a group
+		 */
+		ChunkIterator(I current, I last, size_t size) : group(current, current), last(last), size(size) {
+			findGroup(current);
+		}
+
+		/**
+		 * Gets the current group
+		 * @returns The elements of the group
+		 */
+		const Iterable<I>& operator*() const {
+			return group;
+		}
+
+		/**
+		 * Gets the current group
+		 * @returns The elements of the group
+		 */
+		const Iterable<I>* operator->() const {
+			return &group;
+		}
+
+		/**
+		 * Advances to the next group
+		 * @returns This iterator
+		 */
+		ChunkIterator& operator++() {
+			findGroup(group.end());
+			return *this;
+		}
+
+		/**
+		 * Advances to the next group
+		 * @returns The iterator before advancing
+		 */
+		ChunkIterator operator++(int) {
+			ChunkIterator previous = *this;
+			++*this;
+			return previous;
+		}
+
+		/**
+		 * Checks if two iterators are at the same group
+		 * @param other The iterator to compare with
+		 * @returns Whether or not the iterators are equal
+		 */
+		bool operator==(const ChunkIterator& other) const {
+			return group.begin() == other.group.begin();
+		}
+
+		/**
+		 * Checks if two iterators are at different groups
+		 * @param other The iterator to compare with
+		 * @returns Whether or not the iterators are different
+		 */
+		bool operator!=(const ChunkIterator& other) const {
+			return group.begin() != other.group.begin();
+		}
+	};
+
+	/**
+	 * A lazy view over a pair of iterators, usable in range based for loops and <algorithm>
+	 *
+	 * The stages (filter, map, take, zip and chunk) return new views whose iterators wrap the previous ones, so a
+	 * pipeline runs element by element in a single pass without building intermediate lists. Views don't own the
+	 * elements, the underlying container must outlive them.
+	 */
+	template<typename I> class Iterable {
+	private:
+		/**
+		 * The first element of the view
+		 */
+		I first;
+
+		/**
+		 * One past the last element of the view
+		 */
+		I last;
+
 	public:
+		/**
+		 * The type of the elements of the view
+		 */
+		using Element = typename std::iterator_traits<I>::value_type;
+
+		/**
+		 * Creates a view between two iterators
+		 * @param first The first element of the view
+		 * @param last One past the last element of the view
+		 */
+		Iterable(I first, I last) : first(first), last(last) {}
+
+		/**
+		 * Gets the start of the view
+		 * @returns The first element of the view
+		 */
+		I begin() const {
+			return first;
+		}
+
+		/**
+		 * Gets the end of the view
+		 * @returns One past the last element of the view
+		 */
+		I end() const {
+			return last;
+		}
+
+		/**
+		 * Creates a view of the elements which match a predicate
+		 * @param predicate Called with each element, returns whether or not to keep it
+		 * @returns The view
+		 */
+		template<typename P>
+		Iterable<FilterIterator<I, P>> filter(const P& predicate) const {
+			return Iterable<FilterIterator<I, P>>(FilterIterator<I, P>(first, last, predicate), FilterIterator<I, P>(last, last, predicate));
+		}
+
+		/**
+		 * Creates a view of the results of a function applied to each element
+		 * @param function Called with each element when it is read
+		 * @returns The view
+		 */
+		template<typename F>
+		Iterable<MapIterator<I, F>> map(const F& function) const {
+			return Iterable<MapIterator<I, F>>(MapIterator<I, F>(first, function), MapIterator<I, F>(last, function));
+		}
+
+		/**
+		 * Creates a view of at most the first count elements
+		 * @param count The maximum number of elements
+		 * @returns The view
+		 */
+		Iterable<TakeIterator<I>> take(size_t count) const {
+			return Iterable<TakeIterator<I>>(TakeIterator<I>(first, last, count), TakeIterator<I>(last, last, 0));
+		}
+
+		/**
+		 * Creates a view of pairs of elements from this view and another, as long as the shorter of the two
+		 * @param other The view to pair elements with
+		 * @returns The view
+		 */
+		template<typename J>
+		Iterable<ZipIterator<I, J>> zip(const Iterable<J>& other) const {
+			// The end pairs the ends of the two ranges trimmed to the shorter one, found in constant time for random access iterators
+			I firstEnd = first;
+			J secondEnd = other.begin();
+			if constexpr (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<I>::iterator_category> &&
+				std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<J>::iterator_category>) {
+				auto count = std::min<std::ptrdiff_t>(last - first, other.end() - other.begin());
+				firstEnd += count;
+				secondEnd += count;
+			}
+			else {
+				while (firstEnd != last && secondEnd != other.end()) {
+					++firstEnd;
+					++secondEnd;
+				}
+			}
+			return Iterable<ZipIterator<I, J>>(ZipIterator<I, J>(first, other.begin()), ZipIterator<I, J>(firstEnd, secondEnd));
+		}
 
+		/**
+		 * Creates a view of pairs of elements from this view and a container, as long as the shorter of the two
+		 * @param other The container to pair elements with
+		 * @returns The view
+		 */
+		template<typename C, typename = decltype(std::declval<C&>().begin())>
+		auto zip(C& other) const {
+			return zip(Iterable<decltype(other.begin())>(other.begin(), other.end()));
+		}
+
+		/**
+		 * Creates a view of consecutive groups of elements (each group is itself a view, the last may be shorter)
+		 * @param size The number of elements in a group (at least 1)
+		 * @returns The view
+		 */
+		Iterable<ChunkIterator<I>> chunk(size_t size) const {
+			return Iterable<ChunkIterator<I>>(ChunkIterator<I>(first, last, size), ChunkIterator<I>(last, last, size));
+		}
+
+		/**
+		 * Calls a function with every element of the view
+		 * @param function The function to call
+		 */
+		template<typename F>
+		void forEach(F function) const {
+			for (I i = first; i != last; ++i)
+				function(*i);
+		}
+
+		/**
+		 * Counts the elements of the view (walks the whole view)
+		 * @returns The number of elements
+		 */
+		size_t count() const {
+			size_t total = 0;
+			for (I i = first; i != last; ++i)
+				total++;
+			return total;
+		}
+
+		/**
+		 * Copies the elements of the view into a new list
+		 * @returns The list
+		 */
+		ArrayList<Element> collect() const {
+			ArrayList<Element> list;
+			for (I i = first; i != last; ++i)
+				list.emplace(*i);
+			return list;
+		}
 	};
+
+	/**
+	 * Creates a view over every element of a container (or any type with begin and end)
+	 * @param container The container to view (must outlive the view)
+	 * @returns The view
+	 */
+	template<typename C>
+	auto iterate(C& container) {
+		return Iterable<decltype(container.begin())>(container.begin(), container.end());
+	}
 }
 
 /**
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
 /**
  * The main namespace for data structures in the essentials library
  */
@@ -26,11 +30,241 @@ namespace Essentials::DataStructures {
 	 */
 	namespace ds = DataStructures;
 
+	/**
+	 * An iterator over contiguous elements (used by Array and ArrayList), works with range based for loops and <algorithm>
+	 * @tparam T The element type (const for iterators over constant containers)
+	 */
 	template<typename T> class Iterator {
 	private:
+		/**
+		 * The current element
+		 */
+		T* element;
 
 	public:
-		
+		/**
+		 * The iterator category (random access, contiguous since C++20)
+		 */
+		using iterator_category = std::random_access_iterator_tag;
+
+#if __cplusplus > 201703L
+		/**
+		 * The iterator concept (contiguous)
+		 */
+		using iterator_concept = std::contiguous_iterator_tag;
+#endif
+
+		/**
+		 * The type of the elements
+		 */
+		using value_type = std::remove_cv_t<T>;
+
+		/**
+		 * The type of the distance between two iterators
+		 */
+		using difference_type = std::ptrdiff_t;
+
+		/**
+		 * A pointer to an element
+		 */
+		using pointer = T*;
+
+		/**
+		 * A reference to an element
+		 */
+		using reference = T&;
+
+		/**
+		 * Creates an iterator at an element
+		 * @param element The element (nullptr for an iterator over nothing)
+		 */
+		Iterator(T* element = nullptr) : element(element) {}
+
+		/**
+		 * Converts to an iterator over constant elements
+		 * @returns The iterator
+		 */
+		operator Iterator<const T>() const {
+			return Iterator<const T>(element);
+		}
+
+		/**
+		 * Gets the address of the current element
+		 * @returns The address
+		 */
+		T* address() const {
+			return element;
+		}
+
+		/**
+		 * Gets the current element
+		 * @returns The element
+		 */
+		T& operator*() const {
+			return *element;
+		}
+
+		/**
+		 * Gets the current element
+		 * @returns The element
+		 */
+		T* operator->() const {
+			return element;
+		}
+
+		/**
+		 * Gets an element relative to the current one
+		 * @param offset The distance to the element
+		 * @returns The element
+		 */
+		T& operator[](difference_type offset) const {
+			return element[offset];
+		}
+
+		/**
+		 * Advances to the next element
+		 * @returns This iterator
+		 */
+		Iterator& operator++() {
+			element++;
+			return *this;
+		}
+
+		/**
+		 * Advances to the next element
+		 * @returns The iterator before advancing
+		 */
+		Iterator operator++(int) {
+			return Iterator(element++);
+		}
+
+		/**
+		 * Moves back to the previous element
+		 * @returns This iterator
+		 */
+		Iterator& operator--() {
+			element--;
+			return *this;
+		}
+
+		/**
+		 * Moves back to the previous element
+		 * @returns The iterator before moving
+		 */
+		Iterator operator--(int) {
+			return Iterator(element--);
+		}
+
+		/**
+		 * Advances by a number of elements
+		 * @param offset The number of elements to advance by
+		 * @returns This iterator
+		 */
+		Iterator& operator+=(difference_type offset) {
+			element += offset;
+			return *this;
+		}
+
+		/**
+		 * Moves back by a number of elements
+		 * @param offset The number of elements to move back by
+		 * @returns This iterator
+		 */
+		Iterator& operator-=(difference_type offset) {
+			element -= offset;
+			return *this;
+		}
+
+		/**
+		 * Gets an iterator a number of elements ahead
+		 * @param offset The number of elements to advance by
+		 * @returns The iterator
+		 */
+		Iterator operator+(difference_type offset) const {
+			return Iterator(element + offset);
+		}
+
+		/**
+		 * Gets an iterator a number of elements ahead
+		 * @param offset The number of elements to advance by
+		 * @param iterator The iterator to start at
+		 * @returns The iterator
+		 */
+		friend Iterator operator+(difference_type offset, const Iterator& iterator) {
+			return Iterator(iterator.element + offset);
+		}
+
+		/**
+		 * Gets an iterator a number of elements behind
+		 * @param offset The number of elements to move back by
+		 * @returns The iterator
+		 */
+		Iterator operator-(difference_type offset) const {
+			return Iterator(element - offset);
+		}
+
+		/**
+		 * Gets the number of elements between two iterators
+		 * @param other The iterator to measure from
+		 * @returns The distance from other to this iterator
+		 */
+		difference_type operator-(const Iterator& other) const {
+			return element - other.element;
+		}
+
+		/**
+		 * Checks if two iterators are at the same element
+		 * @param other The iterator to compare with
+		 * @returns Whether or not the iterators are equal
+		 */
+		bool operator==(const Iterator& other) const {
+			return element == other.element;
+		}
+
+		/**
+		 * Checks if two iterators are at different elements
+		 * @param other The iterator to compare with
+		 * @returns Whether or not the iterators are different
+		 */
+		bool operator!=(const Iterator& other) const {
+			return element != other.element;
+		}
+
+		/**
+		 * Checks if this iterator is before another
+		 * @param other The iterator to compare with
+		 * @returns Whether or not this iterator is before other
+		 */
+		bool operator<(const Iterator& other) const {
+			return element < other.element;
+		}
+
+		/**
+		 * Checks if this iterator is after another
+		 * @param other The iterator to compare with
+		 * @returns Whether or not this iterator is after other
+		 */
+		bool operator>(const Iterator& other) const {
+			return element > other.element;
+		}
+
+		/**
+		 * Checks if this iterator is not after another
+		 * @param other The iterator to compare with
+		 * @returns Whether or not this iterator is not after other
+		 */
+		bool operator<=(const Iterator& other) const {
+			return element <= other.element;
+		}
+
+		/**
+		 * Checks if this iterator is not before another
+		 * @param other The iterator to compare with
+		 * @returns Whether or not this iterator is not before other
+		 */
+		bool operator>=(const Iterator& other) const {
+			return element >= other.element;
+		}
 	};
 }
 
@@ -0,0 +1,1114 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "List.h"
+#include "Memory.h"
+#include "Allocator.h"
+#include "Search.h"
+#include <assert.h>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/**
+ * The main namespace for data structures in the essentials library
+ */
+namespace Essentials::DataStructures {
+
+	/**
+	 * A namespace alias to the data structures namespace
+	 */
+	namespace ds = DataStructures;
+
+	/**
+	 * A node of an unrolled linked list, holding a cache line of elements
+	 * The constructed elements are the slots [begin, end) so elements can be added and removed at either end without shifting
+	 */
+	template<typename T> struct LinkedNode {
+		/**
+		 * The number of element slots in a node
+		 */
+		static constexpr size_t capacity = cacheLineSize / sizeof(T) < 4 ? 4 : cacheLineSize / sizeof(T);
+
+		/**
+		 * The previous node of the list (nullptr for the first node)
+		 */
+		LinkedNode* previous = nullptr;
+
+		/**
+		 * The next node of the list (nullptr for the last node)
+		 */
+		LinkedNode* next = nullptr;
+
+		/**
+		 * The slot of the first element
+		 */
+		uint16_t begin = 0;
+
+		/**
+		 * One past the slot of the last element
+		 */
+		uint16_t end = 0;
+
+		/**
+		 * The storage of the elements
+		 */
+		alignas(T) unsigned char storage[capacity * sizeof(T)];
+
+		/**
+		 * Gets the element slots of the node
+		 * @returns The slots
+		 */
+		T* items() {
+			return reinterpret_cast<T*>(storage);
+		}
+
+		/**
+		 * Gets the number of elements in the node
+		 * @returns The number of elements
+		 */
+		size_t count() const {
+			return static_cast<size_t>(end - begin);
+		}
+	};
+
+	/**
+	 * Recycles the nodes of linked lists, stacks and queues so adding and removing elements rarely reaches the allocator
+	 * Containers which share a pool can splice nodes between each other, the pool must outlive every container using it
+	 * @tparam Allocator The allocator the chunks of nodes are requested from (see HeapAllocator)
+	 */
+	template<typename T, typename Allocator = HeapAllocator> class LinkedNodePool : private Allocator {
+	private:
+		/**
+		 * A node of the containers using the pool
+		 */
+		using Node = LinkedNode<T>;
+
+		/**
+		 * A free node, stored inside the node's own memory
+		 */
+		struct FreeNode {
+			/**
+			 * The next free node
+			 */
+			FreeNode* next;
+		};
+
+		/**
+		 * The header of every chunk of nodes
+		 */
+		struct Chunk {
+			/**
+			 * The previously allocated chunk
+			 */
+			Chunk* previous;
+		};
+
+		/**
+		 * The offset of the first node from the start of a chunk
+		 */
+		static constexpr size_t headerSize = (sizeof(Chunk) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+
+		/**
+		 * The alignment chunks are requested with
+		 */
+		static constexpr size_t chunkAlignment = alignof(Node) > alignof(Chunk) ? alignof(Node) : alignof(Chunk);
+
+		/**
+		 * The number of nodes allocated in each chunk
+		 */
+		size_t nodesPerChunk;
+
+		/**
+		 * The first free node
+		 */
+		FreeNode* freeList = nullptr;
+
+		/**
+		 * The most recently allocated chunk
+		 */
+		Chunk* chunks = nullptr;
+
+		/**
+		 * Allocates a new chunk and threads all of its nodes onto the free list
+		 */
+		void addChunk() {
+			void* memory = Allocator::allocate(headerSize + sizeof(Node) * nodesPerChunk, chunkAlignment);
+			Chunk* chunk = new(memory) Chunk{ chunks };
+			chunks = chunk;
+
+			char* first = static_cast<char*>(memory) + headerSize;
+			for (size_t i = nodesPerChunk; i > 0; i--)
+				freeList = new(first + (i - 1) * sizeof(Node)) FreeNode{ freeList };
+		}
+
+	public:
+		/**
+		 * Creates a new empty pool (Does not allocate until the first node is created)
+		 * @param nodesPerChunk The number of nodes to request from the allocator at a time
+		 * @param allocator The allocator to request the chunks of nodes from
+		 */
+		LinkedNodePool(size_t nodesPerChunk = 64, const Allocator& allocator = Allocator()) : Allocator(allocator), nodesPerChunk(nodesPerChunk) {}
+
+		/**
+		 * Creates a new empty pool which requests its nodes from an allocator (Does not allocate until the first node is created)
+		 * @param allocator The allocator to request the chunks of nodes from
+		 */
+		LinkedNodePool(const Allocator& allocator) : LinkedNodePool(64, allocator) {}
+
+		LinkedNodePool(const LinkedNodePool&) = delete;
+		LinkedNodePool& operator=(const LinkedNodePool&) = delete;
+
+		/**
+		 * Frees every chunk of nodes
+		 */
+		~LinkedNodePool() {
+			while (chunks != nullptr) {
+				Chunk* previous = chunks->previous;
+				Allocator::deallocate(chunks, headerSize + sizeof(Node) * nodesPerChunk, chunkAlignment);
+				chunks = previous;
+			}
+		}
+
+		/**
+		 * Creates a new empty node
+		 * @returns The node
+		 */
+		Node* create() {
+			if (freeList == nullptr)
+				addChunk();
+			FreeNode* node = freeList;
+			freeList = node->next;
+			return new(node) Node();
+		}
+
+		/**
+		 * Returns a node to the pool (its elements must already be destroyed)
+		 * @param node The node to return
+		 */
+		void recycle(Node* node) {
+			node->~Node();
+			freeList = new(node) FreeNode{ freeList };
+		}
+
+		/**
+		 * Returns the allocator the chunks of nodes are requested from
+		 * @returns The allocator of the pool
+		 */
+		const Allocator& allocator() const {
+			return *this;
+		}
+	};
+
+	/**
+	 * A list stored as an unrolled linked list (satisfies the list contract, see IsList)
+	 *
+	 * Every node holds a cache line of elements, so iterating reads mostly contiguous memory and inserting only shifts
+	 * the elements of one node. Nodes come from a LinkedNodePool, which is private to the list unless one is passed in.
+	 * Indexing walks the nodes from the closer end, iterate with begin and end for sequential access.
+	 * @tparam Allocator The allocator the private pool and its nodes are requested from (see HeapAllocator)
+	 */
+	template<typename T, typename Allocator = HeapAllocator> class LinkedList : private Allocator {
+	private:
+		/**
+		 * A node of the list
+		 */
+		using Node = LinkedNode<T>;
+
+		/**
+		 * The pool the nodes come from
+		 */
+		using NodePool = LinkedNodePool<T, Allocator>;
+
+		/**
+		 * The number of element slots in a node
+		 */
+		static constexpr size_t nodeCapacity = Node::capacity;
+
+		/**
+		 * A bidirectional iterator over the elements of a list
+		 * The end of a list is one past the last slot of its last node, so it can be stepped back from
+		 */
+		template<typename E> class ElementIterator {
+		private:
+			friend class LinkedList;
+
+			/**
+			 * The current node (nullptr for an empty list)
+			 */
+			Node* node;
+
+			/**
+			 * The slot of the current element in the node
+			 */
+			size_t slot;
+
+		public:
+			/**
+			 * The iterator category
+			 */
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			/**
+			 * The type of the elements
+			 */
+			using value_type = T;
+
+			/**
+			 * The type of the distance between two iterators
+			 */
+			using difference_type = std::ptrdiff_t;
+
+			/**
+			 * A pointer to an element
+			 */
+			using pointer = E*;
+
+			/**
+			 * A reference to an element
+			 */
+			using reference = E&;
+
+			/**
+			 * Creates an iterator at an element
+			 * @param node The node of the element (nullptr for an empty list)
+			 * @param slot The slot of the element in the node
+			 */
+			ElementIterator(Node* node, size_t slot) : node(node), slot(slot) {}
+
+			/**
+			 * Converts to an iterator over constant elements
+			 * @returns The iterator
+			 */
+			template<typename U = E, typename = std::enable_if_t<!std::is_const_v<U>>>
+			operator ElementIterator<const T>() const {
+				return ElementIterator<const T>(node, slot);
+			}
+
+			/**
+			 * Gets the current element
+			 * @returns The element
+			 */
+			E& operator*() const {
+				return node->items()[slot];
+			}
+
+			/**
+			 * Gets the current element
+			 * @returns The element
+			 */
+			E* operator->() const {
+				return &node->items()[slot];
+			}
+
+			/**
+			 * Advances to the next element
+			 * @returns This iterator
+			 */
+			ElementIterator& operator++() {
+				if (++slot == node->end && node->next != nullptr) {
+					node = node->next;
+					slot = node->begin;
+				}
+				return *this;
+			}
+
+			/**
+			 * Advances to the next element
+			 * @returns The iterator before advancing
+			 */
+			ElementIterator operator++(int) {
+				ElementIterator previous = *this;
+				++*this;
+				return previous;
+			}
+
+			/**
+			 * Moves back to the previous element
+			 * @returns This iterator
+			 */
+			ElementIterator& operator--() {
+				if (slot == node->begin) {
+					node = node->previous;
+					slot = node->end;
+				}
+				slot--;
+				return *this;
+			}
+
+			/**
+			 * Moves back to the previous element
+			 * @returns The iterator before moving
+			 */
+			ElementIterator operator--(int) {
+				ElementIterator previous = *this;
+				--*this;
+				return previous;
+			}
+
+			/**
+			 * Checks if two iterators are at the same element
+			 * @param other The iterator to compare with
+			 * @returns Whether or not the iterators are equal
+			 */
+			bool operator==(const ElementIterator& other) const {
+				return node == other.node && slot == other.slot;
+			}
+
+			/**
+			 * Checks if two iterators are at different elements
+			 * @param other The iterator to compare with
+			 * @returns Whether or not the iterators are different
+			 */
+			bool operator!=(const ElementIterator& other) const {
+				return !(*this == other);
+			}
+		};
+
+		/**
+		 * The pool the nodes come from (created on first use unless one was passed in)
+		 */
+		NodePool* pool = nullptr;
+
+		/**
+		 * Whether or not the list created (and must free) its pool
+		 */
+		bool ownsPool = false;
+
+		/**
+		 * The first node
+		 */
+		Node* head = nullptr;
+
+		/**
+		 * The last node
+		 */
+		Node* tail = nullptr;
+
+		/**
+		 * The number of elements in the list
+		 */
+		size_t size = 0;
+
+		/**
+		 * Gets the pool of the list, creating a private pool if it has none
+		 * @returns The pool
+		 */
+		NodePool& nodes() {
+			if (pool == nullptr) {
+				void* memory = Allocator::allocate(sizeof(NodePool), alignof(NodePool));
+				pool = new(memory) NodePool(allocator());
+				ownsPool = true;
+			}
+			return *pool;
+		}
+
+		/**
+		 * Returns the allocator the private pool is requested from
+		 * @returns The allocator of the list
+		 */
+		Allocator& allocator() {
+			return *this;
+		}
+
+		/**
+		 * Creates a new node and links it after another node
+		 * @param previous The node to link after (nullptr to link at the front)
+		 * @param slot The slot the node's (currently empty) range starts at
+		 * @returns The node
+		 */
+		Node* linkNode(Node* previous, size_t slot) {
+			Node* node = nodes().create();
+			node->begin = static_cast<uint16_t>(slot);
+			node->end = static_cast<uint16_t>(slot);
+			link(node, previous);
+			return node;
+		}
+
+		/**
+		 * Links a node after another node
+		 * @param node The node to link
+		 * @param previous The node to link after (nullptr to link at the front)
+		 */
+		void link(Node* node, Node* previous) {
+			node->previous = previous;
+			node->next = previous != nullptr ? previous->next : head;
+			if (node->next != nullptr) node->next->previous = node;
+			else tail = node;
+			if (previous != nullptr) previous->next = node;
+			else head = node;
+		}
+
+		/**
+		 * Unlinks an empty node and returns it to the pool
+		 * @param node The node to remove
+		 */
+		void unlinkNode(Node* node) {
+			if (node->previous != nullptr) node->previous->next = node->next;
+			else head = node->next;
+			if (node->next != nullptr) node->next->previous = node->previous;
+			else tail = node->previous;
+			pool->recycle(node);
+		}
+
+		/**
+		 * Finds the node of an index, walking from the closer end of the list
+		 * @param index The index of the element (may be size to find the end)
+		 * @param offset The offset of the element from the start of its node
+		 * @returns The node (nullptr for the end of the list)
+		 */
+		Node* locate(size_t index, size_t& offset) const {
+			assert(index <= size);
+			if (index == size) {
+				offset = 0;
+				return nullptr;
+			}
+			if (index < size / 2) {
+				Node* node = head;
+				while (index >= node->count()) {
+					index -= node->count();
+					node = node->next;
+				}
+				offset = index;
+				return node;
+			}
+			size_t remaining = size - index;
+			Node* node = tail;
+			while (remaining > node->count()) {
+				remaining -= node->count();
+				node = node->previous;
+			}
+			offset = node->count() - remaining;
+			return node;
+		}
+
+		/**
+		 * Opens an uninitialized slot in a node before an offset, splitting the node if it is full
+		 * Only elements of the node itself are moved
+		 * @param node The node (nullptr to add at the end of the list)
+		 * @param offset The offset from the start of the node of the element which will follow the new one
+		 * @returns The node and slot of the opened slot
+		 */
+		std::pair<Node*, size_t> openSlot(Node* node, size_t offset) {
+			if (node == nullptr) {
+				// Adding at the end fills the last node, then starts a new one
+				if (tail == nullptr || tail->end == nodeCapacity)
+					linkNode(tail, 0);
+				return { tail, tail->end++ };
+			}
+
+			size_t count = node->count();
+			if (count == nodeCapacity) {
+				if (offset == 0) {
+					// Adding before a full node goes after the previous node's last element if there is room,
+					// otherwise it starts a node which fills from the back so repeated front adds don't shift
+					Node* previous = node->previous;
+					if (previous != nullptr && previous->end < nodeCapacity)
+						return { previous, previous->end++ };
+					Node* front = linkNode(previous, nodeCapacity);
+					front->begin--;
+					return { front, front->begin };
+				}
+
+				// Split the node in half, moving the back half to a new node
+				size_t half = count / 2;
+				Node* back = linkNode(node, 0);
+				relocate(back->items(), node->items() + node->begin + half, count - half);
+				back->end = static_cast<uint16_t>(count - half);
+				node->end = static_cast<uint16_t>(node->begin + half);
+				if (offset > half) return openSlot(back, offset - half);
+				count = half;
+			}
+
+			T* items = node->items();
+			if (offset == count && node->end < nodeCapacity)
+				return { node, node->end++ };
+			if (offset == 0 && node->begin > 0)
+				return { node, --node->begin };
+			if (node->end < nodeCapacity && (count - offset <= offset || node->begin == 0)) {
+				size_t slot = node->begin + offset;
+				relocateOverlapping(items + slot + 1, items + slot, count - offset);
+				node->end++;
+				return { node, slot };
+			}
+			relocateOverlapping(items + node->begin - 1, items + node->begin, offset);
+			node->begin--;
+			return { node, node->begin + offset };
+		}
+
+		/**
+		 * Closes the slot of a destroyed element, shifting the shorter side of the node and merging small nodes
+		 * Only elements of the node itself are moved
+		 * @param node The node of the element
+		 * @param slot The slot of the destroyed element
+		 * @returns The position of the element which followed the removed one
+		 */
+		ElementIterator<T> closeSlot(Node* node, size_t slot) {
+			T* items = node->items();
+			if (slot - node->begin < node->end - slot - 1) {
+				relocateOverlapping(items + node->begin + 1, items + node->begin, slot - node->begin);
+				node->begin++;
+				slot++;
+			}
+			else {
+				relocateOverlapping(items + slot, items + slot + 1, node->end - slot - 1);
+				node->end--;
+			}
+			size--;
+
+			if (node->count() == 0) {
+				Node* next = node->next;
+				unlinkNode(node);
+				return next != nullptr ? ElementIterator<T>(next, next->begin) : end();
+			}
+
+			// Merge into a neighbour when both are at most a quarter full so sparse lists stay dense
+			// Only this node's elements move, after the previous node's elements or before the next node's
+			if (node->count() <= nodeCapacity / 4) {
+				size_t count = node->count();
+				size_t offset = slot - node->begin;
+				Node* previous = node->previous;
+				Node* next = node->next;
+				if (previous != nullptr && previous->count() <= nodeCapacity / 4 && nodeCapacity - previous->end >= count) {
+					relocate(previous->items() + previous->end, node->items() + node->begin, count);
+					slot = previous->end + offset;
+					previous->end = static_cast<uint16_t>(previous->end + count);
+					node->end = node->begin;
+					unlinkNode(node);
+					node = previous;
+				}
+				else if (next != nullptr && next->count() <= nodeCapacity / 4 && next->begin >= count) {
+					next->begin = static_cast<uint16_t>(next->begin - count);
+					relocate(next->items() + next->begin, node->items() + node->begin, count);
+					slot = next->begin + offset;
+					node->end = node->begin;
+					unlinkNode(node);
+					node = next;
+				}
+			}
+			if (slot == node->end && node->next != nullptr) return ElementIterator<T>(node->next, node->next->begin);
+			return ElementIterator<T>(node, slot);
+		}
+
+		/**
+		 * Destroys every element and returns every node to the pool
+		 */
+		void freeNodes() {
+			Node* node = head;
+			while (node != nullptr) {
+				Node* next = node->next;
+				destroy(node->items() + node->begin, node->count());
+				pool->recycle(node);
+				node = next;
+			}
+			head = nullptr;
+			tail = nullptr;
+			size = 0;
+		}
+
+		/**
+		 * Frees the pool if the list created it
+		 */
+		void releasePool() {
+			if (ownsPool) {
+				pool->~NodePool();
+				Allocator::deallocate(pool, sizeof(NodePool), alignof(NodePool));
+			}
+			pool = nullptr;
+			ownsPool = false;
+		}
+
+	public:
+		/**
+		 * An iterator over the elements of the list
+		 */
+		using Iterator = ElementIterator<T>;
+
+		/**
+		 * An iterator over the elements of a constant list
+		 */
+		using ConstIterator = ElementIterator<const T>;
+
+		/**
+		 * Creates a new empty LinkedList with a private node pool (Does not allocate until the first item is added)
+		 */
+		LinkedList() = default;
+
+		/**
+		 * Creates a new empty LinkedList whose private node pool is requested from an allocator (Does not allocate until the first item is added)
+		 * @param allocator The allocator to request the pool and its nodes from
+		 */
+		LinkedList(const Allocator& allocator) : Allocator(allocator) {}
+
+		/**
+		 * Creates a new empty LinkedList which takes its nodes from a shared pool
+		 * @param pool The pool to take nodes from (must outlive the list)
+		 */
+		LinkedList(NodePool& pool) : Allocator(pool.allocator()), pool(&pool) {}
+
+		/**
+		 * Creates a copy of another LinkedList (Using the same allocator, and sharing its pool if it uses a shared pool)
+		 * @param other The list to copy
+		 */
+		LinkedList(const LinkedList& other) : Allocator(other), pool(other.ownsPool ? nullptr : other.pool) {
+			for (const T& item : other)
+				push(item);
+		}
+
+		/**
+		 * Takes the nodes (and pool) of another LinkedList, leaving it empty
+		 * @param other The list to move from
+		 */
+		LinkedList(LinkedList&& other) noexcept : Allocator(other), pool(other.pool), ownsPool(other.ownsPool), head(other.head), tail(other.tail), size(other.size) {
+			if (other.ownsPool) other.pool = nullptr;
+			other.ownsPool = false;
+			other.head = nullptr;
+			other.tail = nullptr;
+			other.size = 0;
+		}
+
+		/**
+		 * Replaces the contents of this list with a copy of another LinkedList
+		 * @param other The list to copy
+		 * @returns This list
+		 */
+		LinkedList& operator=(const LinkedList& other) {
+			if (this != &other) {
+				clear();
+				for (const T& item : other)
+					push(item);
+			}
+			return *this;
+		}
+
+		/**
+		 * Replaces the contents of this list with the nodes (and pool and allocator) of another LinkedList
+		 * @param other The list to move from
+		 * @returns This list
+		 */
+		LinkedList& operator=(LinkedList&& other) noexcept {
+			if (this != &other) {
+				clear();
+				releasePool();
+				allocator() = static_cast<Allocator&>(other);
+				std::swap(pool, other.pool);
+				std::swap(ownsPool, other.ownsPool);
+				std::swap(head, other.head);
+				std::swap(tail, other.tail);
+				std::swap(size, other.size);
+			}
+			return *this;
+		}
+
+		/**
+		 * Frees resources
+		 */
+		~LinkedList() {
+			clear();
+			releasePool();
+		}
+
+		/**
+		 * Gets an element from the list at an index
+		 * @param index The index of the element to retrieve
+		 * @returns The element (null if it is out of range)
+		 */
+		T& operator[](size_t index) {
+			assert(index < size);
+			size_t offset;
+			Node* node = locate(index, offset);
+			return node->items()[node->begin + offset];
+		}
+
+		/**
+		 * Gets an element from the list at an index
+		 * @param index The index of the element to retrieve
+		 * @returns The element (null if it is out of range)
+		 */
+		const T& operator[](size_t index) const {
+			assert(index < size);
+			size_t offset;
+			Node* node = locate(index, offset);
+			return node->items()[node->begin + offset];
+		}
+
+		/**
+		 * Adds a new item to the end of the list
+		 * @param item The item to add to the list
+		 */
+		void push(const T& item) {
+			emplace(item);
+		}
+
+		/**
+		 * Adds a new item to the end of the list
+		 * @param item The item to add to the list
+		 */
+		void push(T&& item) {
+			emplace(std::move(item));
+		}
+
+		/**
+		 * Adds multiple new items to the end of the list
+		 * @param items The items to add to the list (any list, see IsList)
+		 */
+		template<typename L, typename = std::enable_if_t<isList<L>>>
+		void push(const L& items) {
+			size_t count = items.length();
+			for (size_t i = 0; i < count; i++)
+				emplace(items[i]);
+		}
+
+		/**
+		 * Adds a new element to the back of the list given the arguments to the constructor of the element
+		 * @param args The arguments to construct the element with
+		 * @returns The new element
+		 */
+		template<typename... Args>
+		T& emplace(Args&&... args) {
+			// Adding at the back never moves elements, so the arguments may refer to elements of this list
+			Node* node = tail;
+			if (node != nullptr && node->end < nodeCapacity) {
+				new(&node->items()[node->end]) T(std::forward<Args>(args)...);
+				node->end++;
+			}
+			else {
+				// Construct in the new node before linking it so a throwing constructor leaves the list unchanged
+				node = nodes().create();
+				try {
+					new(node->items()) T(std::forward<Args>(args)...);
+				}
+				catch (...) {
+					pool->recycle(node);
+					throw;
+				}
+				node->end = 1;
+				link(node, tail);
+			}
+			size++;
+			return node->items()[node->end - 1];
+		}
+
+		/**
+		 * Adds a new item to the front of the list
+		 * @param item The item to add
+		 */
+		void pushFront(T item) {
+			std::pair<Node*, size_t> slot = openSlot(head, 0);
+			new(&slot.first->items()[slot.second]) T(std::move(item));
+			size++;
+		}
+
+		/**
+		 * Adds an item at any position in the list
+		 * @param item The item to add
+		 * @param index The index the item will be at (ie [0, 1, 2] .add(3, 1) -> [0, 3, 1, 2])
+		 */
+		void add(const T& item, size_t index) {
+			T copy(item);
+			add(std::move(copy), index);
+		}
+
+		/**
+		 * Adds an item at any position in the list
+		 * @param item The item to add
+		 * @param index The index the item will be at (ie [0, 1, 2] .add(3, 1) -> [0, 3, 1, 2])
+		 */
+		void add(T&& item, size_t index) {
+			size_t offset;
+			Node* node = locate(index, offset);
+			std::pair<Node*, size_t> slot = openSlot(node, offset);
+			new(&slot.first->items()[slot.second]) T(std::move(item));
+			size++;
+		}
+
+		/**
+		 * Adds an item before an iterator
+		 * Only elements of the node it is added to move, so iterators at elements of other nodes stay valid
+		 * (iterators into that node and the end iterator may not)
+		 * @param position The element to add before (end to add at the back)
+		 * @param item The item to add
+		 * @returns An iterator at the new element
+		 */
+		Iterator insert(Iterator position, T item) {
+			Node* node = position.node;
+			if (node != nullptr && position.slot == node->end)
+				node = nullptr;
+			std::pair<Node*, size_t> slot = openSlot(node, node != nullptr ? position.slot - node->begin : 0);
+			new(&slot.first->items()[slot.second]) T(std::move(item));
+			size++;
+			return Iterator(slot.first, slot.second);
+		}
+
+		/**
+		 * Removes the element at an iterator
+		 * Only elements of the node it is removed from move, so iterators at elements of other nodes stay valid
+		 * (iterators into that node and the end iterator may not)
+		 * @param position The element to remove
+		 * @returns An iterator at the element which followed the removed one
+		 */
+		Iterator erase(Iterator position) {
+			assert(position.node != nullptr && position.slot != position.node->end);
+			position.node->items()[position.slot].~T();
+			return closeSlot(position.node, position.slot);
+		}
+
+		/**
+		 * Moves every element of another list before an iterator, leaving the other list empty
+		 * Takes constant time when both lists share a pool, otherwise the elements are moved one at a time
+		 * @param position The element to add before (end to add at the back)
+		 * @param other The list to take the elements of
+		 */
+		void splice(Iterator position, LinkedList& other) {
+			if (&other == this || other.size == 0) return;
+			if (other.pool != pool && pool != nullptr) {
+				for (T& item : other)
+					position = ++insert(position, std::move(item));
+				other.clear();
+				return;
+			}
+			if (pool == nullptr) {
+				// A list which never allocated adopts the other list's pool (and the allocator it came from) so the nodes can be relinked
+				allocator() = static_cast<Allocator&>(other);
+				pool = other.pool;
+				ownsPool = other.ownsPool;
+				if (other.ownsPool) {
+					other.pool = nullptr;
+					other.ownsPool = false;
+				}
+			}
+
+			Node* before = tail;
+			Node* node = position.node;
+			if (node != nullptr && position.slot == node->end)
+				node = nullptr;
+			if (node != nullptr) {
+				before = node->previous;
+				if (position.slot != node->begin) {
+					// Split the node so the other list can be linked between its halves
+					Node* back = linkNode(node, 0);
+					size_t count = node->end - position.slot;
+					relocate(back->items(), node->items() + position.slot, count);
+					back->end = static_cast<uint16_t>(count);
+					node->end = static_cast<uint16_t>(position.slot);
+					before = node;
+				}
+			}
+
+			Node* after = before != nullptr ? before->next : head;
+			other.head->previous = before;
+			other.tail->next = after;
+			if (before != nullptr) before->next = other.head;
+			else head = other.head;
+			if (after != nullptr) after->previous = other.tail;
+			else tail = other.tail;
+			size += other.size;
+			other.head = nullptr;
+			other.tail = nullptr;
+			other.size = 0;
+		}
+
+		/**
+		 * Moves every element of another list to the end of this list, leaving the other list empty
+		 * @param other The list to take the elements of
+		 */
+		void splice(LinkedList& other) {
+			splice(end(), other);
+		}
+
+		/**
+		 * Removes elements from the list at a certain index
+		 * @param index The index to remove
+		 */
+		void remove(size_t index) {
+			remove(index, 1);
+		}
+
+		/**
+		 * Removes elements from the list at a certain index
+		 * @param index The index to remove
+		 * @param count The number of elements to remove, by default is 1
+		 */
+		void remove(size_t index, size_t count) {
+			assert(index < size);
+			if (count > size - index)
+				count = size - index;
+			size_t offset;
+			Node* node = locate(index, offset);
+			while (count > 0) {
+				size_t slot = node->begin + offset;
+				size_t taken = node->end - slot < count ? node->end - slot : count;
+				destroy(node->items() + slot, taken);
+				relocateOverlapping(node->items() + slot, node->items() + slot + taken, node->end - slot - taken);
+				node->end = static_cast<uint16_t>(node->end - taken);
+				size -= taken;
+				count -= taken;
+				Node* next = node->next;
+				if (node->count() == 0) unlinkNode(node);
+				node = next;
+				offset = 0;
+			}
+		}
+
+		/**
+		 * Removes the first element of the list
+		 * @returns The element removed
+		 */
+		T popFront() {
+			assert(size > 0);
+			T* slot = &head->items()[head->begin];
+			T item(std::move(*slot));
+			slot->~T();
+			closeSlot(head, head->begin);
+			return item;
+		}
+
+		/**
+		 * Removes the last element of the list
+		 * @returns The element removed
+		 */
+		T popBack() {
+			assert(size > 0);
+			T* slot = &tail->items()[tail->end - 1];
+			T item(std::move(*slot));
+			slot->~T();
+			closeSlot(tail, tail->end - 1);
+			return item;
+		}
+
+		/**
+		 * Gets the first element of the list
+		 * @returns The first element
+		 */
+		T& front() {
+			assert(size > 0);
+			return head->items()[head->begin];
+		}
+
+		/**
+		 * Gets the last element of the list
+		 * @returns The last element
+		 */
+		T& back() {
+			assert(size > 0);
+			return tail->items()[tail->end - 1];
+		}
+
+		/**
+		 * Completely clears all items in the list (the nodes go back to the pool)
+		 */
+		void clear() {
+			if (head != nullptr)
+				freeNodes();
+		}
+
+		/**
+		 * Returns the length of the data structure
+		 * @returns The length of the list
+		 */
+		inline size_t length() const {
+			return size;
+		}
+
+		/**
+		 * Checks if an index is valid for the list
+		 * @param index The index to check
+		 * @returns Whether or not the index is valid for this list
+		 */
+		bool contains(size_t index) const {
+			return index < size;
+		}
+
+		/**
+		 * Checks if an element is in the list (Uses == to check)
+		 * @param item The item to check for
+		 * @returns Whether or not the list contains the element
+		 */
+		bool contains(const T& item) const {
+			return indexOf(item) != -1;
+		}
+
+		/**
+		 * Gets the index of the first match of an element (-1 if not found)
+		 * @param item The element to search for
+		 * @returns The index of the element (-1 if not found)
+		 */
+		int indexOf(const T& item) const {
+			size_t base = 0;
+			for (Node* node = head; node != nullptr; node = node->next) {
+				size_t found = findFirst(node->items() + node->begin, node->count(), item);
+				if (found != node->count()) return static_cast<int>(base + found);
+				base += node->count();
+			}
+			return -1;
+		}
+
+		/**
+		 * Gets the index of the last match of an element (-1 if not found)
+		 * @param item The element to search for
+		 * @returns The index of the element (-1 if not found)
+		 */
+		int lastIndexOf(const T& item) const {
+			size_t base = size;
+			for (Node* node = tail; node != nullptr; node = node->previous) {
+				base -= node->count();
+				size_t found = findLast(node->items() + node->begin, node->count(), item);
+				if (found != node->count()) return static_cast<int>(base + found);
+			}
+			return -1;
+		}
+
+		/**
+		 * Gets an iterator at the first element
+		 * @returns The iterator
+		 */
+		Iterator begin() {
+			return Iterator(head, head != nullptr ? head->begin : 0);
+		}
+
+		/**
+		 * Gets an iterator past the last element
+		 * @returns The iterator
+		 */
+		Iterator end() {
+			return Iterator(tail, tail != nullptr ? tail->end : 0);
+		}
+
+		/**
+		 * Gets an iterator at the first element
+		 * @returns The iterator
+		 */
+		ConstIterator begin() const {
+			return ConstIterator(head, head != nullptr ? head->begin : 0);
+		}
+
+		/**
+		 * Gets an iterator past the last element
+		 * @returns The iterator
+		 */
+		ConstIterator end() const {
+			return ConstIterator(tail, tail != nullptr ? tail->end : 0);
+		}
+	};
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
@@ -0,0 +1,114 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#pragma once
+
+#include "LinkedList.h"
+
+/**
+ * The main namespace for data structures in the essentials library
+ */
+namespace Essentials::DataStructures {
+
+	/**
+	 * A namespace alias to the data structures namespace
+	 */
+	namespace ds = DataStructures;
+
+	/**
+	 * A stack stored as an unrolled linked list (satisfies the stack contract, see IsStack)
+	 * Nodes come from a LinkedNodePool, pass one in to share recycled nodes with other linked containers
+	 * @tparam Allocator The allocator the private pool and its nodes are requested from (see HeapAllocator)
+	 */
+	template<typename T, typename Allocator = HeapAllocator> class LinkedStack {
+	private:
+		/**
+		 * The elements, stored as an unrolled linked list
+		 */
+		LinkedList<T, Allocator> list;
+
+	public:
+		/**
+		 * Creates a new empty LinkedStack with a private node pool (Does not allocate until the first item is added)
+		 */
+		LinkedStack() = default;
+
+		/**
+		 * Creates a new empty LinkedStack whose private node pool is requested from an allocator (Does not allocate until the first item is added)
+		 * @param allocator The allocator to request the pool and its nodes from
+		 */
+		LinkedStack(const Allocator& allocator) : list(allocator) {}
+
+		/**
+		 * Creates a new empty LinkedStack which takes its nodes from a shared pool
+		 * @param pool The pool to take nodes from (must outlive the stack)
+		 */
+		LinkedStack(LinkedNodePool<T, Allocator>& pool) : list(pool) {}
+
+		/**
+		 * Adds a new item to the end of the stack
+		 * @param item The item to add
+		 */
+		void push(const T& item) {
+			list.push(item);
+		}
+
+		/**
+		 * Adds a new item to the end of the stack
+		 * @param item The item to add
+		 */
+		void push(T&& item) {
+			list.push(std::move(item));
+		}
+
+		/**
+		 * Removes the last item from the stack
+		 * @returns The element removed
+		 */
+		T pop() {
+			return list.popBack();
+		}
+
+		/**
+		 * Peeks at the last item from the stack without removing it
+		 * @returns The element
+		 */
+		T& peek() {
+			return list.back();
+		}
+
+		/**
+		 * Completely removes all items in the stack (the nodes go back to the pool)
+		 */
+		void clear() {
+			list.clear();
+		}
+
+		/**
+		 * Returns the length of the data structure
+		 * @returns The number of elements in the stack
+		 */
+		inline size_t length() const {
+			return list.length();
+		}
+	};
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
@@ -29,7 +29,8 @@ namespace Essentials::DataStructures {
 	namespace ds = DataStructures;
 
 	/**
-	 * A data structure representing a list
+	 * The runtime polymorphic interface of a list
+	 * Lists satisfy this contract statically (see IsList), use ListReference to pass one where a List<T>& is needed
 	 */
 	template<typename T> class List : public Container<T> {
 	public:
@@ -125,6 +126,202 @@ namespace Essentials::DataStructures {
 		 */
 		virtual int lastIndexOf(const T& item) const = 0;
 	};
+
+	/**
+	 * Checks at compile time if a type satisfies the list contract (indexing, length and push)
+	 */
+	template<typename L, typename = void> struct IsList : std::false_type {};
+
+	/**
+	 * Checks at compile time if a type satisfies the list contract (indexing, length and push)
+	 */
+	template<typename L> struct IsList<L, std::void_t<
+		decltype(static_cast<size_t>(std::declval<const L&>().length())),
+		decltype(std::declval<L&>()[size_t()]),
+		decltype(std::declval<const L&>()[size_t()]),
+		decltype(std::declval<L&>().push(std::declval<const L&>()[size_t()]))
+	>> : std::true_type {};
+
+	/**
+	 * Whether or not a type satisfies the list contract
+	 */
+	template<typename L> inline constexpr bool isList = IsList<L>::value;
+
+	/**
+	 * Checks at compile time if a container can push a whole List<T> in one call
+	 */
+	template<typename C, typename T, typename = void> struct HasListPush : std::false_type {};
+
+	/**
+	 * Checks at compile time if a container can push a whole List<T> in one call
+	 */
+	template<typename C, typename T> struct HasListPush<C, T, std::void_t<
+		decltype(std::declval<C&>().push(std::declval<const List<T>&>()))
+	>> : std::true_type {};
+
+	/**
+	 * The element type of a list
+	 */
+	template<typename L> using ListElement = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<L&>()[size_t()])>>;
+
+#ifdef __cpp_concepts
+	/**
+	 * A type which satisfies the list contract
+	 */
+	template<typename L> concept ListType = isList<L>;
+#endif
+
+	/**
+	 * A type erased reference to a list, for callers which need runtime polymorphism
+	 * Every call is forwarded to the referenced list through List<T>'s vtable
+	 */
+	template<typename L> class ListReference final : public List<ListElement<L>> {
+	private:
+		/**
+		 * The element type of the referenced list
+		 */
+		using T = ListElement<L>;
+
+		/**
+		 * The referenced list
+		 */
+		L& list;
+
+	public:
+		/**
+		 * Creates a reference to a list, the list must outlive the reference
+		 * @param list The list to reference
+		 */
+		ListReference(L& list) : list(list) {}
+
+		/**
+		 * Gets an element from the list at an index
+		 * @param index The index of the element to retrieve
+		 * @returns The element (null if it is out of range)
+		 */
+		T& operator[](size_t index) override {
+			return list[index];
+		}
+
+		/**
+		 * Gets an element from the list at an index
+		 * @param index The index of the element to retrieve
+		 * @returns The element (null if it is out of range)
+		 */
+		const T& operator[](size_t index) const override {
+			return list[index];
+		}
+
+		/**
+		 * Returns the length of the data structure
+		 * @returns The length of the data structure
+		 */
+		size_t length() const override {
+			return list.length();
+		}
+
+		/**
+		 * Adds a new item to the end of the list
+		 * @param item The item to add to the list
+		 */
+		void push(const T& item) override {
+			list.push(item);
+		}
+
+		/**
+		 * Adds a new item to the end of the list
+		 * @param item The item to add to the list
+		 */
+		void push(T&& item) override {
+			list.push(std::move(item));
+		}
+
+		/**
+		 * Adds multiple new items to the end of the list
+		 * @param items The items to add to the list
+		 */
+		void push(const List<T>& items) override {
+			list.push(items);
+		}
+
+		/**
+		 * Adds an item at any position in the list
+		 * @param item The item to add
+		 * @param index The index to add after (ie [0, 1, 2] .add(3, 1) -> [0, 1, 3, 2])
+		 */
+		void add(const T& item, size_t index) override {
+			list.add(item, index);
+		}
+
+		/**
+		 * Adds an item at any position in the list
+		 * @param item The item to add
+		 * @param index The index to add after (ie [0, 1, 2] .add(3, 1) -> [0, 1, 3, 2])
+		 */
+		void add(T&& item, size_t index) override {
+			list.add(std::move(item), index);
+		}
+
+		/**
+		 * Removes an element from the list at a certain index
+		 * @param index The index to remove
+		 */
+		void remove(size_t index) override {
+			list.remove(index);
+		}
+
+		/**
+		 * Removes elements from the list at a certain index
+		 * @param index The index to remove
+		 * @param count The number of elements to remove, by default is 1
+		 */
+		void remove(size_t index, size_t count) override {
+			list.remove(index, count);
+		}
+
+		/**
+		 * Completely clears all items in the list
+		 */
+		void clear() override {
+			list.clear();
+		}
+
+		/**
+		 * Checks if an index is valid for the list
+		 * @param index The index to check
+		 * @returns Whether or not the index is valid for this list
+		 */
+		bool contains(size_t index) const override {
+			return list.contains(index);
+		}
+
+		/**
+		 * Checks if an element is in the list (Uses == to check)
+		 * @param item The item to check for
+		 * @returns Whether or not the list contains the element
+		 */
+		bool contains(const T& item) const override {
+			return list.contains(item);
+		}
+
+		/**
+		 * Gets the index of the first match of an element (-1 if not found)
+		 * @param item The element to search for
+		 * @returns The index of the element (-1 if not found)
+		 */
+		int indexOf(const T& item) const override {
+			return list.indexOf(item);
+		}
+
+		/**
+		 * Gets the index of the last match of an element (-1 if not found)
+		 * @param item The element to search for
+		 * @returns The index of the element (-1 if not found)
+		 */
+		int lastIndexOf(const T& item) const override {
+			return list.lastIndexOf(item);
+		}
+	};
 }
 
 /**
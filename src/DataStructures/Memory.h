@@ -0,0 +1,112 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * The main namespace for data structures in the essentials library
+ */
+namespace Essentials::DataStructures {
+
+	/**
+	 * A namespace alias to the data structures namespace
+	 */
+	namespace ds = DataStructures;
+
+	/**
+	 * The assumed size of a cache line in bytes, used to pad data shared between threads and to size nodes
+	 */
+	inline constexpr size_t cacheLineSize = 64;
+
+	/**
+	 * Whether or not a type can be moved to a new address with a plain memcpy (and the source forgotten about)
+	 * Trivially copyable types are always relocatable, other types (ie owning pointers) may specialize this to opt in
+	 */
+	template<typename T> struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+	/**
+	 * Whether or not a type can be moved to a new address with a plain memcpy
+	 */
+	template<typename T> inline constexpr bool isTriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+	/**
+	 * Destroys count constructed elements (does not free the memory)
+	 * @param data The elements to destroy
+	 * @param count The number of elements to destroy
+	 */
+	template<typename T> void destroy(T* data, size_t count) {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			for (size_t i = 0; i < count; i++)
+				data[i].~T();
+		}
+	}
+
+	/**
+	 * Moves count elements into uninitialized memory and destroys the originals (ranges must not overlap)
+	 * @param dest The uninitialized memory to move the elements to
+	 * @param src The constructed elements to move from, left uninitialized afterwards
+	 * @param count The number of elements to relocate
+	 */
+	template<typename T> void relocate(T* dest, T* src, size_t count) {
+		if (count == 0) return;
+		if constexpr (isTriviallyRelocatable<T>) {
+			std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(T));
+		}
+		else {
+			for (size_t i = 0; i < count; i++) {
+				new(&dest[i]) T(std::move(src[i]));
+				src[i].~T();
+			}
+		}
+	}
+
+	/**
+	 * Moves count elements to a possibly overlapping location and destroys the originals
+	 * Slots of dest which do not overlap src must be uninitialized, slots of src not covered by dest are left uninitialized
+	 * @param dest The memory to move the elements to
+	 * @param src The constructed elements to move from
+	 * @param count The number of elements to relocate
+	 */
+	template<typename T> void relocateOverlapping(T* dest, T* src, size_t count) {
+		if (count == 0 || dest == src) return;
+		if constexpr (isTriviallyRelocatable<T>) {
+			std::memmove(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(T));
+		}
+		else if (dest < src) {
+			for (size_t i = 0; i < count; i++) {
+				new(&dest[i]) T(std::move(src[i]));
+				src[i].~T();
+			}
+		}
+		else {
+			for (size_t i = count; i > 0; i--) {
+				new(&dest[i - 1]) T(std::move(src[i - 1]));
+				src[i - 1].~T();
+			}
+		}
+	}
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
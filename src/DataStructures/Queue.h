@@ -17,7 +17,7 @@
 #pragma once
 
 #include "Container.h"
-
+#include "List.h"
 
 /**
  * The main namespace for data structures in the essentials library
@@ -30,7 +30,8 @@ namespace Essentials::DataStructures {
 	namespace ds = DataStructures;
 
 	/**
-	 * A Data structure representing a Queue
+	 * The runtime polymorphic interface of a queue
+	 * Queues satisfy this contract statically (see IsQueue), use QueueReference to pass one where a Queue<T>& is needed
 	 */
 	template<typename T> class Queue : public Container<T> {
 	public:
@@ -38,26 +39,133 @@ namespace Essentials::DataStructures {
 		 * Adds a new item to the end of the queue
 		 * @param item The item to add
 		 */
-		virtual void push(T& item) = 0;
+		virtual void push(const T& item) = 0;
 
 		/**
-		 * Adds multiple items to the end of the queue
-		 * @param items The items to add to the container
+		 * Adds a new item to the end of the queue
+		 * @param item The item to add
 		 */
-		virtual void push(Container<T>& items) = 0;
+		virtual void push(T&& item) = 0;
+
+		/**
+		 * Adds multiple new items to the end of the queue, in order
+		 * @param items The items to add
+		 */
+		virtual void push(const List<T>& items) = 0;
 
 		/**
 		 * Removes the first element from the queue
 		 * @returns The element removed
 		 */
-		virtual T& dequeue() = 0;
+		virtual T dequeue() = 0;
 
 		/**
-		 * Returns the first element of the queue without returning it
+		 * Returns the first element of the queue without removing it
 		 * @returns The first element of the queue
 		 */
 		virtual T& peek() = 0;
 	};
+
+	/**
+	 * Checks at compile time if a type satisfies the queue contract (push, dequeue, peek and length)
+	 */
+	template<typename Q, typename = void> struct IsQueue : std::false_type {};
+
+	/**
+	 * Checks at compile time if a type satisfies the queue contract (push, dequeue, peek and length)
+	 */
+	template<typename Q> struct IsQueue<Q, std::void_t<
+		decltype(static_cast<size_t>(std::declval<const Q&>().length())),
+		decltype(std::declval<Q&>().push(std::declval<Q&>().dequeue())),
+		decltype(std::declval<Q&>().peek())
+	>> : std::true_type {};
+
+	/**
+	 * Whether or not a type satisfies the queue contract
+	 */
+	template<typename Q> inline constexpr bool isQueue = IsQueue<Q>::value;
+
+#ifdef __cpp_concepts
+	/**
+	 * A type which satisfies the queue contract
+	 */
+	template<typename Q> concept QueueType = isQueue<Q>;
+#endif
+
+	/**
+	 * A type erased reference to a queue, for callers which need runtime polymorphism
+	 */
+	template<typename Q> class QueueReference final : public Queue<std::remove_reference_t<decltype(std::declval<Q&>().peek())>> {
+	private:
+		/**
+		 * The element type of the referenced queue
+		 */
+		using T = std::remove_reference_t<decltype(std::declval<Q&>().peek())>;
+
+		/**
+		 * The referenced queue
+		 */
+		Q& queue;
+
+	public:
+		/**
+		 * Creates a reference to a queue, the queue must outlive the reference
+		 * @param queue The queue to reference
+		 */
+		QueueReference(Q& queue) : queue(queue) {}
+
+		/**
+		 * Returns the length of the data structure
+		 * @returns The length of the data structure
+		 */
+		size_t length() const override {
+			return queue.length();
+		}
+
+		/**
+		 * Adds a new item to the end of the queue
+		 * @param item The item to add
+		 */
+		void push(const T& item) override {
+			queue.push(item);
+		}
+
+		/**
+		 * Adds a new item to the end of the queue
+		 * @param item The item to add
+		 */
+		void push(T&& item) override {
+			queue.push(std::move(item));
+		}
+
+		/**
+		 * Adds multiple new items to the end of the queue, in order
+		 * @param items The items to add
+		 */
+		void push(const List<T>& items) override {
+			if constexpr (HasListPush<Q, T>::value)
+				queue.push(items);
+			else
+				for (size_t i = 0; i < items.length(); i++)
+					queue.push(items[i]);
+		}
+
+		/**
+		 * Removes the first element from the queue
+		 * @returns The element removed
+		 */
+		T dequeue() override {
+			return queue.dequeue();
+		}
+
+		/**
+		 * Returns the first element of the queue without removing it
+		 * @returns The first element of the queue
+		 */
+		T& peek() override {
+			return queue.peek();
+		}
+	};
 }
 
 /**
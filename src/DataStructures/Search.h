@@ -0,0 +1,335 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ESSENTIALS_SEARCH_SSE2
+#endif
+
+#if defined(ESSENTIALS_SEARCH_SSE2) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ESSENTIALS_SEARCH_AVX2
+#endif
+
+/**
+ * The main namespace for data structures in the essentials library
+ */
+namespace Essentials::DataStructures {
+
+	/**
+	 * A namespace alias to the data structures namespace
+	 */
+	namespace ds = DataStructures;
+
+	/**
+	 * Whether or not a type can be searched with vector compares, requires that == on the type is equivalent to comparing bits
+	 * (or is a float/double, which use an ordered floating point compare so that 0.0 == -0.0 and NaN never matches)
+	 */
+	template<typename T> inline constexpr bool isSimdSearchable =
+		(std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+		(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+	/**
+	 * Checks if the current cpu supports AVX2 (checked once and cached)
+	 * @returns Whether or not AVX2 kernels may be used
+	 */
+	inline bool cpuSupportsAvx2() {
+#if defined(__AVX2__)
+		return true;
+#elif defined(ESSENTIALS_SEARCH_AVX2)
+		static const bool supported = __builtin_cpu_supports("avx2");
+		return supported;
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * Gets the index of the lowest set bit of a non zero mask
+	 * @param mask The mask to check
+	 * @returns The index of the lowest set bit
+	 */
+	inline unsigned searchLowestBit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+		unsigned i = 0;
+		while (!(mask & 1)) { mask >>= 1; i++; }
+		return i;
+#endif
+	}
+
+	/**
+	 * Gets the index of the highest set bit of a non zero mask
+	 * @param mask The mask to check
+	 * @returns The index of the highest set bit
+	 */
+	inline unsigned searchHighestBit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+		return 31u - static_cast<unsigned>(__builtin_clz(mask));
+#else
+		unsigned i = 31;
+		while (!(mask & 0x80000000u)) { mask <<= 1; i--; }
+		return i;
+#endif
+	}
+
+#ifdef ESSENTIALS_SEARCH_SSE2
+	/**
+	 * Broadcasts an item into every lane of an SSE register
+	 * @param item The item to broadcast
+	 * @returns The register holding the item in every lane
+	 */
+	template<typename T> inline __m128i searchBroadcast128(const T& item) {
+		if constexpr (std::is_same_v<T, float>) return _mm_castps_si128(_mm_set1_ps(item));
+		else if constexpr (std::is_same_v<T, double>) return _mm_castpd_si128(_mm_set1_pd(item));
+		else if constexpr (sizeof(T) == 1) { int8_t bits; std::memcpy(&bits, &item, 1); return _mm_set1_epi8(bits); }
+		else if constexpr (sizeof(T) == 2) { int16_t bits; std::memcpy(&bits, &item, 2); return _mm_set1_epi16(bits); }
+		else if constexpr (sizeof(T) == 4) { int32_t bits; std::memcpy(&bits, &item, 4); return _mm_set1_epi32(bits); }
+		else { int64_t bits; std::memcpy(&bits, &item, 8); return _mm_set1_epi64x(bits); }
+	}
+
+	/**
+	 * Compares every lane of a block of 16 bytes with a broadcast needle
+	 * @param block The elements to compare
+	 * @param needle The broadcast item
+	 * @returns A register with every matching lane set to all ones
+	 */
+	template<typename T> inline __m128i searchCompare128(__m128i block, __m128i needle) {
+		if constexpr (std::is_same_v<T, float>) return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(block), _mm_castsi128_ps(needle)));
+		else if constexpr (std::is_same_v<T, double>) return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(block), _mm_castsi128_pd(needle)));
+		else if constexpr (sizeof(T) == 1) return _mm_cmpeq_epi8(block, needle);
+		else if constexpr (sizeof(T) == 2) return _mm_cmpeq_epi16(block, needle);
+		else if constexpr (sizeof(T) == 4) return _mm_cmpeq_epi32(block, needle);
+		else {
+			// SSE2 has no 64 bit compare, a lane matches when both of its halves match
+			__m128i halves = _mm_cmpeq_epi32(block, needle);
+			return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+		}
+	}
+
+	/**
+	 * Finds the first match in a block of 64 bytes
+	 * @param bytes The start of the block
+	 * @param needle The broadcast item
+	 * @returns A 64 bit mask with a bit set for every matching byte
+	 */
+	template<typename T> inline uint64_t searchBlock128(const char* bytes, __m128i needle) {
+		uint64_t m0 = static_cast<uint32_t>(_mm_movemask_epi8(searchCompare128<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes)), needle)));
+		uint64_t m1 = static_cast<uint32_t>(_mm_movemask_epi8(searchCompare128<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 16)), needle)));
+		uint64_t m2 = static_cast<uint32_t>(_mm_movemask_epi8(searchCompare128<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 32)), needle)));
+		uint64_t m3 = static_cast<uint32_t>(_mm_movemask_epi8(searchCompare128<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 48)), needle)));
+		return m0 | (m1 << 16) | (m2 << 32) | (m3 << 48);
+	}
+
+	/**
+	 * Finds the first match of an item with SSE2, 64 bytes at a time
+	 * @param data The elements to search
+	 * @param count The number of elements to search
+	 * @param item The item to search for
+	 * @returns The index of the first match (count if not found)
+	 */
+	template<typename T> size_t findFirstSse2(const T* data, size_t count, const T& item) {
+		constexpr size_t perBlock = 64 / sizeof(T);
+		__m128i needle = searchBroadcast128(item);
+		const char* bytes = reinterpret_cast<const char*>(data);
+		size_t i = 0;
+		for (; i + perBlock <= count; i += perBlock) {
+			uint64_t mask = searchBlock128<T>(bytes + i * sizeof(T), needle);
+			if (mask) {
+				uint32_t low = static_cast<uint32_t>(mask);
+				unsigned bit = low ? searchLowestBit(low) : 32 + searchLowestBit(static_cast<uint32_t>(mask >> 32));
+				return i + bit / sizeof(T);
+			}
+		}
+		for (; i < count; i++) {
+			if (item == data[i]) return i;
+		}
+		return count;
+	}
+
+	/**
+	 * Finds the last match of an item with SSE2, 64 bytes at a time
+	 * @param data The elements to search
+	 * @param count The number of elements to search
+	 * @param item The item to search for
+	 * @returns The index of the last match (count if not found)
+	 */
+	template<typename T> size_t findLastSse2(const T* data, size_t count, const T& item) {
+		constexpr size_t perBlock = 64 / sizeof(T);
+		__m128i needle = searchBroadcast128(item);
+		const char* bytes = reinterpret_cast<const char*>(data);
+		size_t i = count;
+		for (; i >= perBlock; i -= perBlock) {
+			uint64_t mask = searchBlock128<T>(bytes + (i - perBlock) * sizeof(T), needle);
+			if (mask) {
+				uint32_t high = static_cast<uint32_t>(mask >> 32);
+				unsigned bit = high ? 32 + searchHighestBit(high) : searchHighestBit(static_cast<uint32_t>(mask));
+				return i - perBlock + bit / sizeof(T);
+			}
+		}
+		while (i-- > 0) {
+			if (item == data[i]) return i;
+		}
+		return count;
+	}
+#endif
+
+#ifdef ESSENTIALS_SEARCH_AVX2
+	/**
+	 * Compares every lane of a block of 32 bytes with a broadcast needle
+	 * @param block The elements to compare
+	 * @param needle The broadcast item
+	 * @returns A register with every matching lane set to all ones
+	 */
+	template<typename T> __attribute__((target("avx2"))) inline __m256i searchCompare256(__m256i block, __m256i needle) {
+		if constexpr (std::is_same_v<T, float>) return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(block), _mm256_castsi256_ps(needle), _CMP_EQ_OQ));
+		else if constexpr (std::is_same_v<T, double>) return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(block), _mm256_castsi256_pd(needle), _CMP_EQ_OQ));
+		else if constexpr (sizeof(T) == 1) return _mm256_cmpeq_epi8(block, needle);
+		else if constexpr (sizeof(T) == 2) return _mm256_cmpeq_epi16(block, needle);
+		else if constexpr (sizeof(T) == 4) return _mm256_cmpeq_epi32(block, needle);
+		else return _mm256_cmpeq_epi64(block, needle);
+	}
+
+	/**
+	 * Finds matches in a block of 64 bytes with AVX2
+	 * @param bytes The start of the block
+	 * @param needle The broadcast item
+	 * @returns A 64 bit mask with a bit set for every matching byte
+	 */
+	template<typename T> __attribute__((target("avx2"))) inline uint64_t searchBlock256(const char* bytes, __m256i needle) {
+		uint64_t m0 = static_cast<uint32_t>(_mm256_movemask_epi8(searchCompare256<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes)), needle)));
+		uint64_t m1 = static_cast<uint32_t>(_mm256_movemask_epi8(searchCompare256<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + 32)), needle)));
+		return m0 | (m1 << 32);
+	}
+
+	/**
+	 * Finds the first match of an item with AVX2, 64 bytes at a time
+	 * @param data The elements to search
+	 * @param count The number of elements to search
+	 * @param item The item to search for
+	 * @returns The index of the first match (count if not found)
+	 */
+	template<typename T> __attribute__((target("avx2"))) size_t findFirstAvx2(const T* data, size_t count, const T& item) {
+		constexpr size_t perBlock = 64 / sizeof(T);
+		__m256i needle = _mm256_castsi128_si256(searchBroadcast128(item));
+		needle = _mm256_inserti128_si256(needle, _mm256_castsi256_si128(needle), 1);
+		const char* bytes = reinterpret_cast<const char*>(data);
+		size_t i = 0;
+		for (; i + perBlock <= count; i += perBlock) {
+			uint64_t mask = searchBlock256<T>(bytes + i * sizeof(T), needle);
+			if (mask) {
+				uint32_t low = static_cast<uint32_t>(mask);
+				unsigned bit = low ? searchLowestBit(low) : 32 + searchLowestBit(static_cast<uint32_t>(mask >> 32));
+				return i + bit / sizeof(T);
+			}
+		}
+		for (; i < count; i++) {
+			if (item == data[i]) return i;
+		}
+		return count;
+	}
+
+	/**
+	 * Finds the last match of an item with AVX2, 64 bytes at a time
+	 * @param data The elements to search
+	 * @param count The number of elements to search
+	 * @param item The item to search for
+	 * @returns The index of the last match (count if not found)
+	 */
+	template<typename T> __attribute__((target("avx2"))) size_t findLastAvx2(const T* data, size_t count, const T& item) {
+		constexpr size_t perBlock = 64 / sizeof(T);
+		__m256i needle = _mm256_castsi128_si256(searchBroadcast128(item));
+		needle = _mm256_inserti128_si256(needle, _mm256_castsi256_si128(needle), 1);
+		const char* bytes = reinterpret_cast<const char*>(data);
+		size_t i = count;
+		for (; i >= perBlock; i -= perBlock) {
+			uint64_t mask = searchBlock256<T>(bytes + (i - perBlock) * sizeof(T), needle);
+			if (mask) {
+				uint32_t high = static_cast<uint32_t>(mask >> 32);
+				unsigned bit = high ? 32 + searchHighestBit(high) : searchHighestBit(static_cast<uint32_t>(mask));
+				return i - perBlock + bit / sizeof(T);
+			}
+		}
+		while (i-- > 0) {
+			if (item == data[i]) return i;
+		}
+		return count;
+	}
+#endif
+
+	/**
+	 * Finds the first element equal to an item (Uses == to check, vectorized for arithmetic types)
+	 * @param data The elements to search
+	 * @param count The number of elements to search
+	 * @param item The item to search for
+	 * @returns The index of the first match (count if not found)
+	 */
+	template<typename T> size_t findFirst(const T* data, size_t count, const T& item) {
+#ifdef ESSENTIALS_SEARCH_SSE2
+		if constexpr (isSimdSearchable<T>) {
+			constexpr size_t perBlock = 64 / sizeof(T);
+			if (count >= perBlock) {
+#ifdef ESSENTIALS_SEARCH_AVX2
+				if (cpuSupportsAvx2()) return findFirstAvx2(data, count, item);
+#endif
+				return findFirstSse2(data, count, item);
+			}
+		}
+#endif
+		for (size_t i = 0; i < count; i++) {
+			if (item == data[i]) return i;
+		}
+		return count;
+	}
+
+	/**
+	 * Finds the last element equal to an item (Uses == to check, vectorized for arithmetic types)
+	 * @param data The elements to search
+	 * @param count The number of elements to search
+	 * @param item The item to search for
+	 * @returns The index of the last match (count if not found)
+	 */
+	template<typename T> size_t findLast(const T* data, size_t count, const T& item) {
+#ifdef ESSENTIALS_SEARCH_SSE2
+		if constexpr (isSimdSearchable<T>) {
+			constexpr size_t perBlock = 64 / sizeof(T);
+			if (count >= perBlock) {
+#ifdef ESSENTIALS_SEARCH_AVX2
+				if (cpuSupportsAvx2()) return findLastAvx2(data, count, item);
+#endif
+				return findLastSse2(data, count, item);
+			}
+		}
+#endif
+		for (size_t i = count; i-- > 0;) {
+			if (item == data[i]) return i;
+		}
+		return count;
+	}
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "Container.h"
+#include "List.h"
 
 /**
  * The main namespace for data structures in the essentials library
@@ -29,7 +30,8 @@ namespace Essentials::DataStructures {
 	namespace ds = DataStructures;
 
 	/**
-	 * A data structure repsenting a Stack
+	 * The runtime polymorphic interface of a stack
+	 * Stacks satisfy this contract statically (see IsStack), use StackReference to pass one where a Stack<T>& is needed
 	 */
 	template<typename T> class Stack : public Container<T> {
 	public:
@@ -37,19 +39,25 @@ namespace Essentials::DataStructures {
 		 * Adds a new item to the end of the stack
 		 * @param item The item to add
 		 */
-		virtual void push(T& item) = 0;
+		virtual void push(const T& item) = 0;
 
 		/**
-		 * Adds multiple new items to the end of the stack
-		 * @param items The items to add to the stack
+		 * Adds a new item to the end of the stack
+		 * @param item The item to add
 		 */
-		virtual void push(Container<T>& items) = 0;
+		virtual void push(T&& item) = 0;
+
+		/**
+		 * Adds multiple new items to the end of the stack, in order
+		 * @param items The items to add
+		 */
+		virtual void push(const List<T>& items) = 0;
 
 		/**
 		 * Removes the last item from the stack
 		 * @returns the removed element
 		 */
-		virtual T& pop() = 0;
+		virtual T pop() = 0;
 
 		/**
 		 * Peeks at the last item from the stack without removing it
@@ -57,6 +65,107 @@ namespace Essentials::DataStructures {
 		 */
 		virtual T& peek() = 0;
 	};
+
+	/**
+	 * Checks at compile time if a type satisfies the stack contract (push, pop, peek and length)
+	 */
+	template<typename S, typename = void> struct IsStack : std::false_type {};
+
+	/**
+	 * Checks at compile time if a type satisfies the stack contract (push, pop, peek and length)
+	 */
+	template<typename S> struct IsStack<S, std::void_t<
+		decltype(static_cast<size_t>(std::declval<const S&>().length())),
+		decltype(std::declval<S&>().push(std::declval<S&>().pop())),
+		decltype(std::declval<S&>().peek())
+	>> : std::true_type {};
+
+	/**
+	 * Whether or not a type satisfies the stack contract
+	 */
+	template<typename S> inline constexpr bool isStack = IsStack<S>::value;
+
+#ifdef __cpp_concepts
+	/**
+	 * A type which satisfies the stack contract
+	 */
+	template<typename S> concept StackType = isStack<S>;
+#endif
+
+	/**
+	 * A type erased reference to a stack, for callers which need runtime polymorphism
+	 */
+	template<typename S> class StackReference final : public Stack<std::remove_reference_t<decltype(std::declval<S&>().peek())>> {
+	private:
+		/**
+		 * The element type of the referenced stack
+		 */
+		using T = std::remove_reference_t<decltype(std::declval<S&>().peek())>;
+
+		/**
+		 * The referenced stack
+		 */
+		S& stack;
+
+	public:
+		/**
+		 * Creates a reference to a stack, the stack must outlive the reference
+		 * @param stack The stack to reference
+		 */
+		StackReference(S& stack) : stack(stack) {}
+
+		/**
+		 * Returns the length of the data structure
+		 * @returns The length of the data structure
+		 */
+		size_t length() const override {
+			return stack.length();
+		}
+
+		/**
+		 * Adds a new item to the end of the stack
+		 * @param item The item to add
+		 */
+		void push(const T& item) override {
+			stack.push(item);
+		}
+
+		/**
+		 * Adds a new item to the end of the stack
+		 * @param item The item to add
+		 */
+		void push(T&& item) override {
+			stack.push(std::move(item));
+		}
+
+		/**
+		 * Adds multiple new items to the end of the stack, in order
+		 * @param items The items to add
+		 */
+		void push(const List<T>& items) override {
+			if constexpr (HasListPush<S, T>::value)
+				stack.push(items);
+			else
+				for (size_t i = 0; i < items.length(); i++)
+					stack.push(items[i]);
+		}
+
+		/**
+		 * Removes the last item from the stack
+		 * @returns the removed element
+		 */
+		T pop() override {
+			return stack.pop();
+		}
+
+		/**
+		 * Peeks at the last item from the stack without removing it
+		 * @returns The last element from the stack
+		 */
+		T& peek() override {
+			return stack.peek();
+		}
+	};
 }
 
 /**
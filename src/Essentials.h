@@ -18,5 +18,8 @@
 
 #include "Math/Math.h"
 #include "String/String.h"
+#include "String/Interner.h"
+#include "String/Regex.h"
 #include "DataStructures/DataStructures.h"
+#include "Threading/Threading.h"
 #include "Files/Files.h"
\ No newline at end of file
@@ -0,0 +1,785 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "File.h"
+#include "../DataStructures/ArrayList.h"
+#include "../Threading/ThreadPool.h"
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && (defined(__GNUC__) || defined(__clang__))
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(IO_URING_OP_SUPPORTED)
+#define ESSENTIALS_FILES_IO_URING
+#endif
+#endif
+
+/**
+ * The namespace for file support in the essentials library
+ */
+namespace Essentials::Files {
+
+	/**
+	 * A namespace alias to the files namespace
+	 */
+	namespace fi = Files;
+
+	/**
+	 * Called when a request finishes with the number of bytes transferred, or -errno if it failed
+	 */
+	using IoCallback = std::function<void(int64_t result)>;
+
+	class AsyncIO;
+
+	/**
+	 * The result of a request that will finish later
+	 */
+	class IoFuture {
+	private:
+		friend class AsyncIO;
+
+		/**
+		 * What the request and the future share
+		 */
+		struct Shared {
+			/**
+			 * Whether or not the request has finished
+			 */
+			bool done = false;
+
+			/**
+			 * The number of bytes transferred, or -errno
+			 */
+			int64_t result = 0;
+		};
+
+		/**
+		 * The engine running the request
+		 */
+		AsyncIO* engine = nullptr;
+
+		/**
+		 * The state shared with the request
+		 */
+		std::shared_ptr<Shared> shared;
+
+		/**
+		 * Makes a future for a request
+		 * @param engine The engine running the request
+		 * @param shared The state shared with the request
+		 */
+		IoFuture(AsyncIO* engine, std::shared_ptr<Shared> shared) : engine(engine), shared(std::move(shared)) {}
+
+	public:
+		/**
+		 * Makes a future with no request
+		 */
+		IoFuture() = default;
+
+		/**
+		 * Checks if the request has finished, without reaping completions
+		 * @returns Whether or not the result is ready
+		 */
+		bool ready() const {
+			return shared != nullptr && shared->done;
+		}
+
+		/**
+		 * Waits for the request, reaping completions (and running their callbacks) on this thread until it finishes
+		 * @returns The number of bytes transferred, or -errno if it failed
+		 */
+		inline int64_t get();
+	};
+
+	/**
+	 * Batched asynchronous reads and writes at offsets
+	 * Requests are queued without a system call, submit() hands every queued request to the kernel at once, and poll() or wait() reap completions
+	 * Uses io_uring where the kernel has it (with registered buffers for the fixed requests), otherwise runs requests on a thread pool
+	 * Callbacks always run on the thread calling poll, wait, drain or a request that had to wait for a free slot
+	 * An AsyncIO is driven from one thread at a time, and must not wait from inside tasks of its own thread pool
+	 */
+	class AsyncIO {
+	private:
+		/**
+		 * The largest number of requests sent to the pool in one task
+		 */
+		static constexpr size_t poolBatch = 16;
+
+		/**
+		 * A request in flight
+		 */
+		struct Operation {
+			/**
+			 * Called with the result
+			 */
+			IoCallback callback;
+
+			/**
+			 * The buffer to read into or write from
+			 */
+			void* buffer;
+
+			/**
+			 * The offset in the file
+			 */
+			uint64_t offset;
+
+			/**
+			 * The file descriptor
+			 */
+			int descriptor;
+
+			/**
+			 * The number of bytes to transfer
+			 */
+			uint32_t length;
+
+			/**
+			 * The registered buffer holding buffer (-1 if it is not registered)
+			 */
+			int32_t bufferIndex;
+
+			/**
+			 * Whether or not the request writes
+			 */
+			bool write;
+		};
+
+		/**
+		 * A finished request waiting to be reaped
+		 */
+		struct Completion {
+			/**
+			 * The slot of the request
+			 */
+			uint32_t slot;
+
+			/**
+			 * The number of bytes transferred, or -errno
+			 */
+			int64_t result;
+		};
+
+		/**
+		 * The request slots, a request's slot index is its io_uring user data
+		 */
+		DataStructures::ArrayList<Operation> operations;
+
+		/**
+		 * The slots not in use
+		 */
+		DataStructures::ArrayList<uint32_t> freeSlots;
+
+		/**
+		 * The slots queued but not yet submitted
+		 */
+		DataStructures::ArrayList<uint32_t> queued;
+
+		/**
+		 * The pool requests run on without io_uring
+		 */
+		Threading::ThreadPool* pool;
+
+		/**
+		 * The pool tasks that have not finished
+		 */
+		Threading::TaskGroup tasks;
+
+		/**
+		 * Guards finished
+		 */
+		std::mutex mutex;
+
+		/**
+		 * Signalled when a pool task finishes a request
+		 */
+		std::condition_variable finishedSignal;
+
+		/**
+		 * Requests finished by the pool
+		 */
+		DataStructures::ArrayList<Completion> finished;
+
+#ifdef ESSENTIALS_FILES_IO_URING
+		/**
+		 * The io_uring file descriptor (-1 without io_uring)
+		 */
+		int ring = -1;
+
+		/**
+		 * The submission queue ring
+		 */
+		void* submissionRing = nullptr;
+
+		/**
+		 * The size of the submission queue ring mapping
+		 */
+		size_t submissionRingSize = 0;
+
+		/**
+		 * The completion queue ring (the same mapping as the submission ring on newer kernels)
+		 */
+		void* completionRing = nullptr;
+
+		/**
+		 * The size of the completion queue ring mapping
+		 */
+		size_t completionRingSize = 0;
+
+		/**
+		 * The submission queue entries
+		 */
+		io_uring_sqe* entries = nullptr;
+
+		/**
+		 * The size of the submission queue entries mapping
+		 */
+		size_t entriesSize = 0;
+
+		/**
+		 * The submission queue tail the kernel reads
+		 */
+		unsigned* submissionTail = nullptr;
+
+		/**
+		 * The submission queue index mask
+		 */
+		unsigned submissionMask = 0;
+
+		/**
+		 * The submission queue array of entry indices
+		 */
+		unsigned* submissionArray = nullptr;
+
+		/**
+		 * The completion queue head, advanced as completions are reaped
+		 */
+		unsigned* completionHead = nullptr;
+
+		/**
+		 * The completion queue tail the kernel writes
+		 */
+		unsigned* completionTail = nullptr;
+
+		/**
+		 * The completion queue index mask
+		 */
+		unsigned completionMask = 0;
+
+		/**
+		 * The completion queue entries
+		 */
+		io_uring_cqe* completions = nullptr;
+
+		/**
+		 * The submission queue tail including entries not yet published to the kernel
+		 */
+		unsigned localTail = 0;
+
+		/**
+		 * The number of published entries the kernel has not consumed
+		 */
+		unsigned unsubmitted = 0;
+
+		/**
+		 * Sets up the ring, leaving ring at -1 if io_uring is not available
+		 * @param depth The number of submission queue entries
+		 */
+		void setupRing(size_t depth) {
+			io_uring_params parameters;
+			std::memset(&parameters, 0, sizeof(parameters));
+			int descriptor = static_cast<int>(::syscall(__NR_io_uring_setup, static_cast<unsigned>(depth), &parameters));
+			if (descriptor < 0) return;
+
+			// Plain reads and writes need a 5.6 kernel
+			size_t probeSize = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+			DataStructures::ArrayList<char> probeStorage;
+			probeStorage.resize(probeSize, 0);
+			io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(probeStorage.data());
+			bool supported = ::syscall(__NR_io_uring_register, descriptor, IORING_REGISTER_PROBE, probe, 256) >= 0
+				&& probe->last_op >= IORING_OP_WRITE
+				&& (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED)
+				&& (probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED);
+			if (!supported) {
+				::close(descriptor);
+				return;
+			}
+
+			submissionRingSize = parameters.sq_off.array + parameters.sq_entries * sizeof(unsigned);
+			completionRingSize = parameters.cq_off.cqes + parameters.cq_entries * sizeof(io_uring_cqe);
+			bool single = parameters.features & IORING_FEAT_SINGLE_MMAP;
+			if (single)
+				submissionRingSize = completionRingSize = submissionRingSize > completionRingSize ? submissionRingSize : completionRingSize;
+			void* submissionMapping = ::mmap(nullptr, submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor, IORING_OFF_SQ_RING);
+			void* completionMapping = single ? submissionMapping : ::mmap(nullptr, completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor, IORING_OFF_CQ_RING);
+			entriesSize = parameters.sq_entries * sizeof(io_uring_sqe);
+			void* entryMapping = ::mmap(nullptr, entriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor, IORING_OFF_SQES);
+			if (submissionMapping == MAP_FAILED || completionMapping == MAP_FAILED || entryMapping == MAP_FAILED) {
+				if (submissionMapping != MAP_FAILED)
+					::munmap(submissionMapping, submissionRingSize);
+				if (!single && completionMapping != MAP_FAILED)
+					::munmap(completionMapping, completionRingSize);
+				if (entryMapping != MAP_FAILED)
+					::munmap(entryMapping, entriesSize);
+				::close(descriptor);
+				return;
+			}
+
+			ring = descriptor;
+			submissionRing = submissionMapping;
+			completionRing = completionMapping;
+			entries = static_cast<io_uring_sqe*>(entryMapping);
+			char* submissionBase = static_cast<char*>(submissionRing);
+			char* completionBase = static_cast<char*>(completionRing);
+			submissionTail = reinterpret_cast<unsigned*>(submissionBase + parameters.sq_off.tail);
+			submissionMask = *reinterpret_cast<unsigned*>(submissionBase + parameters.sq_off.ring_mask);
+			submissionArray = reinterpret_cast<unsigned*>(submissionBase + parameters.sq_off.array);
+			completionHead = reinterpret_cast<unsigned*>(completionBase + parameters.cq_off.head);
+			completionTail = reinterpret_cast<unsigned*>(completionBase + parameters.cq_off.tail);
+			completionMask = *reinterpret_cast<unsigned*>(completionBase + parameters.cq_off.ring_mask);
+			completions = reinterpret_cast<io_uring_cqe*>(completionBase + parameters.cq_off.cqes);
+			localTail = *submissionTail;
+		}
+
+		/**
+		 * Unmaps and closes the ring
+		 */
+		void closeRing() {
+			if (ring < 0) return;
+			::munmap(entries, entriesSize);
+			if (completionRing != submissionRing)
+				::munmap(completionRing, completionRingSize);
+			::munmap(submissionRing, submissionRingSize);
+			::close(ring);
+			ring = -1;
+		}
+
+		/**
+		 * Writes the submission queue entry of a request
+		 * @param slot The slot of the request
+		 */
+		void prepareEntry(uint32_t slot) {
+			const Operation& operation = operations[slot];
+			unsigned index = localTail & submissionMask;
+			io_uring_sqe& entry = entries[index];
+			std::memset(&entry, 0, sizeof(entry));
+			bool fixed = operation.bufferIndex >= 0;
+			if (operation.write)
+				entry.opcode = fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+			else
+				entry.opcode = fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+			entry.fd = operation.descriptor;
+			entry.off = operation.offset;
+			entry.addr = reinterpret_cast<uint64_t>(operation.buffer);
+			entry.len = operation.length;
+			if (fixed)
+				entry.buf_index = static_cast<uint16_t>(operation.bufferIndex);
+			entry.user_data = slot;
+			submissionArray[index] = index;
+			localTail++;
+		}
+
+		/**
+		 * Publishes the queued entries and enters the kernel to submit them, optionally waiting for a completion
+		 * @param waitForOne Whether or not to wait for at least one completion
+		 */
+		void enterRing(bool waitForOne) {
+			if (localTail != *submissionTail) {
+				unsigned published = localTail - *submissionTail;
+				__atomic_store_n(submissionTail, localTail, __ATOMIC_RELEASE);
+				unsubmitted += published;
+			}
+			if (unsubmitted == 0 && !waitForOne) return;
+			while (true) {
+				long result = ::syscall(__NR_io_uring_enter, ring, unsubmitted, waitForOne ? 1u : 0u, waitForOne ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+				if (result >= 0) {
+					unsubmitted -= static_cast<unsigned>(result);
+					return;
+				}
+				// EAGAIN and EBUSY mean completions have to be reaped first, which the callers do
+				if (errno != EINTR) return;
+			}
+		}
+
+		/**
+		 * Reaps every completion in the completion queue
+		 * @returns The number of requests reaped
+		 */
+		size_t reapRing() {
+			size_t count = 0;
+			unsigned head = *completionHead;
+			while (head != __atomic_load_n(completionTail, __ATOMIC_ACQUIRE)) {
+				const io_uring_cqe& completion = completions[head & completionMask];
+				uint32_t slot = static_cast<uint32_t>(completion.user_data);
+				int64_t result = completion.res;
+				head++;
+				// Hand the entry back before the callback, which may queue more requests or wait itself
+				__atomic_store_n(completionHead, head, __ATOMIC_RELEASE);
+				finish(slot, result);
+				count++;
+				head = *completionHead;
+			}
+			return count;
+		}
+#endif
+
+		/**
+		 * Checks if requests go through io_uring
+		 * @returns Whether or not the ring is set up
+		 */
+		bool hasRing() const {
+#ifdef ESSENTIALS_FILES_IO_URING
+			return ring >= 0;
+#else
+			return false;
+#endif
+		}
+
+		/**
+		 * Runs a request synchronously
+		 * @param operation The request
+		 * @returns The number of bytes transferred, or -errno
+		 */
+		static int64_t run(const Operation& operation) {
+			size_t total = 0;
+			char* buffer = static_cast<char*>(operation.buffer);
+			while (total < operation.length) {
+				ssize_t done = operation.write
+					? ::pwrite(operation.descriptor, buffer + total, operation.length - total, static_cast<off_t>(operation.offset + total))
+					: ::pread(operation.descriptor, buffer + total, operation.length - total, static_cast<off_t>(operation.offset + total));
+				if (done < 0 && errno == EINTR) continue;
+				if (done < 0) return total != 0 ? static_cast<int64_t>(total) : -static_cast<int64_t>(errno);
+				if (done == 0) break;
+				total += static_cast<size_t>(done);
+			}
+			return static_cast<int64_t>(total);
+		}
+
+		/**
+		 * Frees the slot of a finished request and calls its callback
+		 * @param slot The slot of the request
+		 * @param result The result of the request
+		 */
+		void finish(uint32_t slot, int64_t result) {
+			IoCallback callback = std::move(operations[slot].callback);
+			operations[slot].callback = nullptr;
+			freeSlots.push(slot);
+			if (callback)
+				callback(result);
+		}
+
+		/**
+		 * Reaps the requests the pool has finished
+		 * @returns The number of requests reaped
+		 */
+		size_t reapPool() {
+			size_t count = 0;
+			while (true) {
+				Completion completion;
+				{
+					// Take one completion at a time, so a callback that waits itself reaps the rest instead of waiting for them
+					std::lock_guard<std::mutex> lock(mutex);
+					if (finished.length() == 0) break;
+					completion = finished[finished.length() - 1];
+					finished.resizeUninitialized(finished.length() - 1);
+				}
+				finish(completion.slot, completion.result);
+				count++;
+			}
+			return count;
+		}
+
+		/**
+		 * Queues a request, waiting for a slot to free up if every slot is in use
+		 * @param operation The request
+		 */
+		void enqueue(Operation&& operation) {
+			while (freeSlots.length() == 0)
+				wait(1);
+			uint32_t slot = freeSlots[freeSlots.length() - 1];
+			freeSlots.resizeUninitialized(freeSlots.length() - 1);
+			operations[slot] = std::move(operation);
+#ifdef ESSENTIALS_FILES_IO_URING
+			if (hasRing()) {
+				prepareEntry(slot);
+				return;
+			}
+#endif
+			queued.push(slot);
+		}
+
+		/**
+		 * Queues a request for a future
+		 * @param operation The request (without a callback)
+		 * @returns The future of the request
+		 */
+		IoFuture enqueueFuture(Operation&& operation) {
+			std::shared_ptr<IoFuture::Shared> shared = std::make_shared<IoFuture::Shared>();
+			operation.callback = [shared](int64_t result) {
+				shared->result = result;
+				shared->done = true;
+			};
+			enqueue(std::move(operation));
+			return IoFuture(this, shared);
+		}
+
+	public:
+		/**
+		 * Sets up the engine
+		 * @param depth The most requests in flight at once (submitting more waits for some to finish)
+		 * @param pool The pool requests run on if io_uring is not available
+		 * @param useIoUring Whether or not to try io_uring (false forces the pool)
+		 */
+		AsyncIO(size_t depth = 256, Threading::ThreadPool& pool = Threading::ThreadPool::global(), bool useIoUring = true) : pool(&pool) {
+			if (depth == 0)
+				depth = 1;
+#ifdef ESSENTIALS_FILES_IO_URING
+			if (useIoUring)
+				setupRing(depth);
+#else
+			(void) useIoUring;
+#endif
+			operations.resize(depth);
+			freeSlots.prepare(depth);
+			for (size_t i = depth; i-- > 0;)
+				freeSlots.push(static_cast<uint32_t>(i));
+		}
+
+		AsyncIO(const AsyncIO&) = delete;
+		AsyncIO& operator=(const AsyncIO&) = delete;
+
+		/**
+		 * Finishes every request (running their callbacks) and tears the engine down
+		 */
+		~AsyncIO() {
+			drain();
+			pool->wait(tasks);
+#ifdef ESSENTIALS_FILES_IO_URING
+			closeRing();
+#endif
+		}
+
+		/**
+		 * Checks if requests go through io_uring rather than the thread pool
+		 * @returns Whether or not io_uring is in use
+		 */
+		bool usingIoUring() const {
+			return hasRing();
+		}
+
+		/**
+		 * Gets the number of requests queued or in flight
+		 * @returns The number of unfinished requests
+		 */
+		size_t pending() const {
+			return operations.length() - freeSlots.length();
+		}
+
+		/**
+		 * Registers buffers with the kernel so fixed requests skip mapping them on every request
+		 * Replaces any buffers registered before, the engine must have no requests pending
+		 * @param buffers The buffers
+		 * @param count The number of buffers
+		 * @returns Whether or not the buffers were registered (always true on the thread pool, where fixed requests are plain requests)
+		 */
+		bool registerBuffers(const Span<char>* buffers, size_t count) {
+#ifdef ESSENTIALS_FILES_IO_URING
+			if (!hasRing()) return true;
+			::syscall(__NR_io_uring_register, ring, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+			if (count == 0) return true;
+			DataStructures::ArrayList<iovec> vectors;
+			vectors.prepare(count);
+			for (size_t i = 0; i < count; i++)
+				vectors.push({buffers[i].data(), buffers[i].length()});
+			return ::syscall(__NR_io_uring_register, ring, IORING_REGISTER_BUFFERS, vectors.data(), static_cast<unsigned>(count)) >= 0;
+#else
+			(void) buffers;
+			(void) count;
+			return true;
+#endif
+		}
+
+		/**
+		 * Queues a read
+		 * @param file The file to read (must stay open until the request finishes)
+		 * @param offset The offset to read at
+		 * @param buffer Where to read to (must stay valid until the request finishes)
+		 * @param length The number of bytes to read
+		 * @param callback Called with the number of bytes read, or -errno
+		 */
+		void read(const File& file, uint64_t offset, void* buffer, uint32_t length, IoCallback callback) {
+			enqueue({std::move(callback), buffer, offset, file.handle(), length, -1, false});
+		}
+
+		/**
+		 * Queues a read into a registered buffer
+		 * @param file The file to read (must stay open until the request finishes)
+		 * @param offset The offset to read at
+		 * @param buffer Where to read to, inside the registered buffer
+		 * @param length The number of bytes to read
+		 * @param bufferIndex The index of the registered buffer
+		 * @param callback Called with the number of bytes read, or -errno
+		 */
+		void readFixed(const File& file, uint64_t offset, void* buffer, uint32_t length, uint32_t bufferIndex, IoCallback callback) {
+			enqueue({std::move(callback), buffer, offset, file.handle(), length, static_cast<int32_t>(bufferIndex), false});
+		}
+
+		/**
+		 * Queues a write
+		 * @param file The file to write (must stay open until the request finishes)
+		 * @param offset The offset to write at
+		 * @param buffer The bytes to write (must stay valid until the request finishes)
+		 * @param length The number of bytes to write
+		 * @param callback Called with the number of bytes written, or -errno
+		 */
+		void write(const File& file, uint64_t offset, const void* buffer, uint32_t length, IoCallback callback) {
+			enqueue({std::move(callback), const_cast<void*>(buffer), offset, file.handle(), length, -1, true});
+		}
+
+		/**
+		 * Queues a write from a registered buffer
+		 * @param file The file to write (must stay open until the request finishes)
+		 * @param offset The offset to write at
+		 * @param buffer The bytes to write, inside the registered buffer
+		 * @param length The number of bytes to write
+		 * @param bufferIndex The index of the registered buffer
+		 * @param callback Called with the number of bytes written, or -errno
+		 */
+		void writeFixed(const File& file, uint64_t offset, const void* buffer, uint32_t length, uint32_t bufferIndex, IoCallback callback) {
+			enqueue({std::move(callback), const_cast<void*>(buffer), offset, file.handle(), length, static_cast<int32_t>(bufferIndex), true});
+		}
+
+		/**
+		 * Queues a read whose result is collected through a future
+		 * @param file The file to read (must stay open until the request finishes)
+		 * @param offset The offset to read at
+		 * @param buffer Where to read to (must stay valid until the request finishes)
+		 * @param length The number of bytes to read
+		 * @returns The future of the number of bytes read, or -errno
+		 */
+		IoFuture read(const File& file, uint64_t offset, void* buffer, uint32_t length) {
+			return enqueueFuture({nullptr, buffer, offset, file.handle(), length, -1, false});
+		}
+
+		/**
+		 * Queues a write whose result is collected through a future
+		 * @param file The file to write (must stay open until the request finishes)
+		 * @param offset The offset to write at
+		 * @param buffer The bytes to write (must stay valid until the request finishes)
+		 * @param length The number of bytes to write
+		 * @returns The future of the number of bytes written, or -errno
+		 */
+		IoFuture write(const File& file, uint64_t offset, const void* buffer, uint32_t length) {
+			return enqueueFuture({nullptr, const_cast<void*>(buffer), offset, file.handle(), length, -1, true});
+		}
+
+		/**
+		 * Hands every queued request to the kernel (or the pool) without waiting
+		 */
+		void submit() {
+#ifdef ESSENTIALS_FILES_IO_URING
+			if (hasRing()) {
+				enterRing(false);
+				return;
+			}
+#endif
+			for (size_t start = 0; start < queued.length(); start += poolBatch) {
+				size_t count = queued.length() - start < poolBatch ? queued.length() - start : poolBatch;
+				uint32_t batch[poolBatch];
+				std::memcpy(batch, queued.data() + start, count * sizeof(uint32_t));
+				pool->submit(tasks, [this, batch, count] {
+					for (size_t i = 0; i < count; i++) {
+						int64_t result = run(operations[batch[i]]);
+						// Notify under the lock so the engine cannot be destroyed in between
+						std::lock_guard<std::mutex> lock(mutex);
+						finished.push({batch[i], result});
+						finishedSignal.notify_one();
+					}
+				});
+			}
+			queued.clear();
+		}
+
+		/**
+		 * Submits queued requests and reaps every finished request without blocking
+		 * @returns The number of requests reaped
+		 */
+		size_t poll() {
+			submit();
+#ifdef ESSENTIALS_FILES_IO_URING
+			if (hasRing()) return reapRing();
+#endif
+			return reapPool();
+		}
+
+		/**
+		 * Submits queued requests and waits until some requests finish, running their callbacks
+		 * @param minimum The number of requests to wait for (fewer if fewer are pending)
+		 * @returns The number of requests reaped
+		 */
+		size_t wait(size_t minimum = 1) {
+			size_t count = poll();
+			while (count < minimum && pending() != 0) {
+#ifdef ESSENTIALS_FILES_IO_URING
+				if (hasRing()) {
+					enterRing(true);
+					count += reapRing();
+					continue;
+				}
+#endif
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					finishedSignal.wait(lock, [this] {
+						return finished.length() != 0;
+					});
+				}
+				count += reapPool();
+			}
+			return count;
+		}
+
+		/**
+		 * Submits queued requests and waits for every pending request to finish
+		 */
+		void drain() {
+			while (pending() != 0)
+				wait(pending());
+		}
+	};
+
+	inline int64_t IoFuture::get() {
+		while (!shared->done)
+			engine->wait(1);
+		return shared->result;
+	}
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
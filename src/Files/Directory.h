@@ -0,0 +1,848 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "../DataStructures/ArrayList.h"
+#include "../String/String.h"
+#include "../Threading/ThreadPool.h"
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#if defined(SYS_getdents64)
+#define ESSENTIALS_FILES_GETDENTS
+#endif
+#endif
+
+/**
+ * The namespace for file support in the essentials library
+ */
+namespace Essentials::Files {
+
+	/**
+	 * A namespace alias to the files namespace
+	 */
+	namespace fi = Files;
+
+	/**
+	 * What kind of file a directory entry is
+	 */
+	enum class EntryType : uint8_t {
+		/**
+		 * The filesystem did not say and the entry could not be stat'd
+		 */
+		unknown,
+		/**
+		 * A regular file
+		 */
+		file,
+		/**
+		 * A directory
+		 */
+		directory,
+		/**
+		 * A symbolic link (never followed)
+		 */
+		symlink,
+		/**
+		 * A pipe, socket or device
+		 */
+		other
+	};
+
+	/**
+	 * Finds the end of a [class] in a glob pattern and checks a character against it
+	 * @param pattern The pattern
+	 * @param position The index of the opening bracket
+	 * @param character The character to check
+	 * @param matched Set to whether or not the character is in the class
+	 * @returns The index after the closing bracket, or notFound if there is none (so the bracket is a literal)
+	 */
+	inline size_t matchGlobClass(Strings::StringView pattern, size_t position, unsigned char character, bool& matched) {
+		size_t i = position + 1;
+		bool negate = false;
+		if (i < pattern.length() && (pattern[i] == '!' || pattern[i] == '^')) {
+			negate = true;
+			i++;
+		}
+		bool found = false;
+		// A ] right after the opening bracket is part of the class
+		for (size_t first = i; i < pattern.length() && (pattern[i] != ']' || i == first); i++) {
+			unsigned char low = static_cast<unsigned char>(pattern[i]);
+			if (low == '\\' && i + 1 < pattern.length())
+				low = static_cast<unsigned char>(pattern[++i]);
+			unsigned char high = low;
+			if (i + 2 < pattern.length() && pattern[i + 1] == '-' && pattern[i + 2] != ']') {
+				i += 2;
+				high = static_cast<unsigned char>(pattern[i]);
+				if (high == '\\' && i + 1 < pattern.length())
+					high = static_cast<unsigned char>(pattern[++i]);
+			}
+			if (character >= low && character <= high)
+				found = true;
+		}
+		if (i >= pattern.length()) return Strings::notFound;
+		matched = found != negate;
+		return i + 1;
+	}
+
+	/**
+	 * Matches a name against a shell glob pattern, supporting *, ?, [classes] (negated with ! or ^) and \ escapes
+	 * Runs in O(pattern * name) at worst by only ever backtracking to the last *
+	 * @param pattern The pattern
+	 * @param name The name to match
+	 * @returns Whether or not the whole name matches the pattern
+	 */
+	inline bool matchGlob(Strings::StringView pattern, Strings::StringView name) {
+		size_t p = 0;
+		size_t n = 0;
+		size_t star = Strings::notFound;
+		size_t starName = 0;
+		while (n < name.length()) {
+			if (p < pattern.length()) {
+				char c = pattern[p];
+				if (c == '*') {
+					star = ++p;
+					starName = n;
+					continue;
+				}
+				if (c == '?') {
+					p++;
+					n++;
+					continue;
+				}
+				size_t next = p + 1;
+				bool matched = false;
+				if (c == '[')
+					next = matchGlobClass(pattern, p, static_cast<unsigned char>(name[n]), matched);
+				if (c != '[' || next == Strings::notFound) {
+					next = p + 1;
+					if (c == '\\' && p + 1 < pattern.length())
+						c = pattern[next++];
+					matched = c == name[n];
+				}
+				if (matched) {
+					p = next;
+					n++;
+					continue;
+				}
+			}
+			if (star == Strings::notFound) return false;
+			p = star;
+			n = ++starName;
+		}
+		while (p < pattern.length() && pattern[p] == '*')
+			p++;
+		return p == pattern.length();
+	}
+
+	/**
+	 * A file found while walking a directory
+	 */
+	struct DirectoryEntry {
+		/**
+		 * The path of the entry, starting with the path of the directory being walked
+		 */
+		Strings::String path;
+
+		/**
+		 * The index in path where the name of the entry starts
+		 */
+		size_t nameStart = 0;
+
+		/**
+		 * How many directories below the walked directory the entry is (0 for its direct children)
+		 */
+		size_t depth = 0;
+
+		/**
+		 * What kind of file the entry is
+		 */
+		EntryType type = EntryType::unknown;
+
+		/**
+		 * Whether or not the entry was stat'd, the fields below are zero if it was not
+		 */
+		bool hasStat = false;
+
+		/**
+		 * The permission and type bits
+		 */
+		uint32_t mode = 0;
+
+		/**
+		 * The size in bytes
+		 */
+		uint64_t size = 0;
+
+		/**
+		 * The inode number
+		 */
+		uint64_t inode = 0;
+
+		/**
+		 * The last modification time in nanoseconds since the epoch
+		 */
+		int64_t modified = 0;
+
+		/**
+		 * Gets the name of the entry
+		 * @returns A view of the name in the path
+		 */
+		Strings::StringView name() const {
+			return path.substring(nameStart);
+		}
+	};
+
+	/**
+	 * Options for walking a directory
+	 */
+	struct DirectoryOptions {
+		/**
+		 * The deepest level to list, 0 lists only the children of the directory
+		 */
+		size_t maxDepth = static_cast<size_t>(-1);
+
+		/**
+		 * Whether or not to stat every entry, otherwise only entries the filesystem gives no type for are stat'd
+		 */
+		bool stat = false;
+
+		/**
+		 * Whether or not to list directories (they are walked either way)
+		 */
+		bool directories = true;
+
+		/**
+		 * Whether or not to list and walk entries whose name starts with a dot
+		 */
+		bool hidden = true;
+
+		/**
+		 * The number of entries waiting to be read after which the walk stops going deeper until some are read
+		 */
+		size_t maxBuffered = static_cast<size_t>(1) << 16;
+	};
+
+	class Directory;
+
+	/**
+	 * Reads the entries of a Directory one at a time as a range for loop
+	 */
+	class DirectoryIterator {
+	private:
+		/**
+		 * The directory being read (nullptr once there are no more entries)
+		 */
+		Directory* directory = nullptr;
+
+		/**
+		 * The current entry
+		 */
+		DirectoryEntry entry;
+
+	public:
+		/**
+		 * Makes the end iterator
+		 */
+		DirectoryIterator() = default;
+
+		/**
+		 * Makes an iterator at the next entry of a directory
+		 * @param directory The directory to read
+		 */
+		DirectoryIterator(Directory* directory);
+
+		/**
+		 * Gets the current entry
+		 * @returns The entry
+		 */
+		DirectoryEntry& operator*() {
+			return entry;
+		}
+
+		/**
+		 * Gets the current entry
+		 * @returns A pointer to the entry
+		 */
+		DirectoryEntry* operator->() {
+			return &entry;
+		}
+
+		/**
+		 * Moves to the next entry
+		 * @returns This iterator
+		 */
+		DirectoryIterator& operator++();
+
+		/**
+		 * Checks if two iterators are at different places, only meaningful against the end iterator
+		 * @param other The other iterator
+		 * @returns Whether or not the iterators differ
+		 */
+		bool operator!=(const DirectoryIterator& other) const {
+			return directory != other.directory;
+		}
+	};
+
+	/**
+	 * Walks a directory tree in parallel on a ThreadPool, each directory is read with getdents64 (readdir elsewhere) and
+	 * its subdirectories are opened relative to it with openat, handed to other workers as tasks while the pool has idle threads
+	 * Entries are filtered while walking and streamed to the reader in batches, when the reader falls behind the walk parks
+	 * directories instead of going deeper so memory stays bounded (a single directory is always listed whole)
+	 * Symbolic links are listed but never followed, entries come out in no particular order
+	 */
+	class Directory {
+	private:
+		/**
+		 * A directory waiting to be walked
+		 */
+		struct Pending {
+			/**
+			 * The path of the directory
+			 */
+			Strings::String path;
+
+			/**
+			 * The depth of its entries
+			 */
+			size_t depth;
+		};
+
+		/**
+		 * The number of entries a worker collects before handing them to the reader
+		 */
+		static constexpr size_t batchSize = 256;
+
+		/**
+		 * The size of the buffer each task reads entries into
+		 */
+		static constexpr size_t readSize = static_cast<size_t>(1) << 15;
+
+		/**
+		 * The number of directories a task opens below each other before handing deeper ones to new tasks
+		 */
+		static constexpr size_t maxNesting = 32;
+
+		/**
+		 * The directory to walk
+		 */
+		Strings::String root;
+
+		/**
+		 * The options of the walk
+		 */
+		DirectoryOptions options;
+
+		/**
+		 * The pool the walk runs on
+		 */
+		Threading::ThreadPool* pool;
+
+		/**
+		 * The glob patterns names are matched against
+		 */
+		DataStructures::ArrayList<Strings::String> globs;
+
+		/**
+		 * The extensions (without the dot) names are matched against
+		 */
+		DataStructures::ArrayList<Strings::String> extensions;
+
+		/**
+		 * Every task of the walk
+		 */
+		Threading::TaskGroup tasks;
+
+		/**
+		 * Guards results and parked
+		 */
+		std::mutex mutex;
+
+		/**
+		 * Signalled when results are added or the last task finishes
+		 */
+		std::condition_variable ready;
+
+		/**
+		 * Entries handed over by the workers
+		 */
+		DataStructures::ArrayList<DirectoryEntry> results;
+
+		/**
+		 * Entries taken by the reader
+		 */
+		DataStructures::ArrayList<DirectoryEntry> taken;
+
+		/**
+		 * The next entry of taken to read
+		 */
+		size_t takenIndex = 0;
+
+		/**
+		 * Directories not walked yet because the reader fell behind
+		 */
+		DataStructures::ArrayList<Pending> parked;
+
+		/**
+		 * The number of entries in results
+		 */
+		std::atomic<size_t> buffered{0};
+
+		/**
+		 * The number of tasks that have not finished
+		 */
+		std::atomic<size_t> active{0};
+
+		/**
+		 * Set to stop the walk early
+		 */
+		std::atomic<bool> cancelled{false};
+
+		/**
+		 * The errno of the first directory that could not be read (0 if none)
+		 */
+		std::atomic<int> firstError{0};
+
+		/**
+		 * Whether or not the walk has started
+		 */
+		bool started = false;
+
+		/**
+		 * Called with every entry on the workers instead of handing them to the reader (set by forEach)
+		 */
+		std::function<void(DirectoryEntry&)> visitor;
+
+		/**
+		 * Records an errno unless one was already recorded
+		 * @param error The errno
+		 */
+		void fail(int error) {
+			int expected = 0;
+			firstError.compare_exchange_strong(expected, error, std::memory_order_relaxed);
+		}
+
+		/**
+		 * Gets the number of tasks to keep running for the pool to stay busy
+		 * @returns The number of tasks
+		 */
+		size_t taskLimit() const {
+			return pool->threadCount() * 2;
+		}
+
+		/**
+		 * Converts the type the filesystem gave for an entry
+		 * @param type The d_type of the entry
+		 * @returns The type of the entry
+		 */
+		static EntryType typeOf(unsigned char type) {
+			switch (type) {
+				case DT_REG: return EntryType::file;
+				case DT_DIR: return EntryType::directory;
+				case DT_LNK: return EntryType::symlink;
+				case DT_UNKNOWN: return EntryType::unknown;
+				default: return EntryType::other;
+			}
+		}
+
+		/**
+		 * Converts the type bits of a stat
+		 * @param mode The st_mode of the entry
+		 * @returns The type of the entry
+		 */
+		static EntryType typeOfMode(mode_t mode) {
+			if (S_ISREG(mode)) return EntryType::file;
+			if (S_ISDIR(mode)) return EntryType::directory;
+			if (S_ISLNK(mode)) return EntryType::symlink;
+			return EntryType::other;
+		}
+
+		/**
+		 * Checks a name against the filters
+		 * @param name The name of the entry
+		 * @returns Whether or not the entry should be listed
+		 */
+		bool accepts(Strings::StringView name) const {
+			if (globs.length() == 0 && extensions.length() == 0) return true;
+			for (size_t i = 0; i < globs.length(); i++)
+				if (matchGlob(globs[i], name)) return true;
+			size_t dot = name.lastIndexOf('.');
+			// Like std::filesystem, a name that only starts with a dot has no extension
+			if (dot == Strings::notFound || dot == 0) return false;
+			Strings::StringView extension = name.substring(dot + 1);
+			for (size_t i = 0; i < extensions.length(); i++)
+				if (extensions[i] == extension) return true;
+			return false;
+		}
+
+		/**
+		 * Reads every entry of an open directory
+		 * @param descriptor The directory
+		 * @param buffer A buffer of readSize bytes
+		 * @param visit Called with the name, its length and its d_type for each entry except . and ..
+		 * @returns Whether or not the whole directory was read
+		 */
+		template<typename F>
+		bool readEntries(int descriptor, char* buffer, F&& visit) {
+#ifdef ESSENTIALS_FILES_GETDENTS
+			while (true) {
+				long count = ::syscall(SYS_getdents64, descriptor, buffer, readSize);
+				if (count == 0) return true;
+				if (count < 0) {
+					if (errno == EINTR) continue;
+					fail(errno);
+					return false;
+				}
+				// Each linux_dirent64 is a 64 bit inode, a 64 bit offset, a 16 bit record length, a type byte and the name
+				for (long offset = 0; offset < count;) {
+					const char* record = buffer + offset;
+					unsigned short length;
+					std::memcpy(&length, record + 16, sizeof(length));
+					const char* name = record + 19;
+					offset += length;
+					if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) continue;
+					visit(name, std::strlen(name), static_cast<unsigned char>(record[18]));
+				}
+			}
+#else
+			(void) buffer;
+			// fdopendir takes over the descriptor it is given, the caller still needs this one for openat
+			int copy = ::dup(descriptor);
+			DIR* stream = copy < 0 ? nullptr : ::fdopendir(copy);
+			if (stream == nullptr) {
+				fail(errno);
+				if (copy >= 0)
+					::close(copy);
+				return false;
+			}
+			errno = 0;
+			for (dirent* entry = ::readdir(stream); entry != nullptr; entry = ::readdir(stream)) {
+				const char* name = entry->d_name;
+				if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) continue;
+				visit(name, std::strlen(name), static_cast<unsigned char>(entry->d_type));
+			}
+			bool read = errno == 0;
+			if (!read)
+				fail(errno);
+			::closedir(stream);
+			return read;
+#endif
+		}
+
+		/**
+		 * Lists an entry, either through the visitor or the current batch
+		 * @param entry The entry
+		 * @param batch The batch of the task
+		 */
+		void emit(DirectoryEntry& entry, DataStructures::ArrayList<DirectoryEntry>& batch) {
+			if (visitor) {
+				visitor(entry);
+				return;
+			}
+			batch.push(std::move(entry));
+			if (batch.length() >= batchSize)
+				handOver(batch);
+		}
+
+		/**
+		 * Hands a batch of entries to the reader
+		 * @param batch The batch, left empty
+		 */
+		void handOver(DataStructures::ArrayList<DirectoryEntry>& batch) {
+			if (batch.length() == 0) return;
+			size_t count = batch.length();
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (results.length() == 0)
+					std::swap(results, batch);
+				else
+					for (size_t i = 0; i < count; i++)
+						results.push(std::move(batch[i]));
+				buffered.fetch_add(count, std::memory_order_relaxed);
+			}
+			batch.clear();
+			ready.notify_one();
+		}
+
+		/**
+		 * Starts a task walking a directory
+		 * @param path The path of the directory
+		 * @param depth The depth of its entries
+		 */
+		void spawn(Strings::String&& path, size_t depth) {
+			active.fetch_add(1, std::memory_order_relaxed);
+			pool->submit(tasks, [this, path = std::move(path), depth]() mutable {
+				run(path, depth);
+			});
+		}
+
+		/**
+		 * Walks a directory on a task
+		 * @param path The path of the directory
+		 * @param depth The depth of its entries
+		 */
+		void run(Strings::String& path, size_t depth) {
+			if (!cancelled.load(std::memory_order_relaxed)) {
+				std::unique_ptr<char[]> buffer(new char[readSize]);
+				DataStructures::ArrayList<DirectoryEntry> batch;
+				int descriptor = ::open(path.cString(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+				if (descriptor < 0)
+					fail(errno);
+				else
+					walk(descriptor, path, depth, 0, buffer.get(), batch);
+				handOver(batch);
+			}
+			{
+				// Decrementing under the lock so the reader cannot miss the last notification
+				std::lock_guard<std::mutex> lock(mutex);
+				active.fetch_sub(1, std::memory_order_relaxed);
+			}
+			ready.notify_all();
+		}
+
+		/**
+		 * Lists a directory and walks its subdirectories, closing it afterwards
+		 * @param descriptor The open directory
+		 * @param path The path of the directory
+		 * @param depth The depth of its entries
+		 * @param nesting The number of directories above it this task has open
+		 * @param buffer The read buffer of the task
+		 * @param batch The batch of the task
+		 */
+		void walk(int descriptor, const Strings::String& path, size_t depth, size_t nesting, char* buffer, DataStructures::ArrayList<DirectoryEntry>& batch) {
+			bool descend = depth < options.maxDepth;
+			size_t prefix = path.length() + (path.length() > 0 && path[path.length() - 1] == '/' ? 0 : 1);
+			// The names of the subdirectories, each followed by a null
+			DataStructures::ArrayList<char> subdirectories;
+			readEntries(descriptor, buffer, [&](const char* name, size_t length, unsigned char rawType) {
+				if (!options.hidden && name[0] == '.') return;
+				DirectoryEntry entry;
+				entry.type = typeOf(rawType);
+				struct stat info;
+				if ((options.stat || entry.type == EntryType::unknown) && ::fstatat(descriptor, name, &info, AT_SYMLINK_NOFOLLOW) == 0) {
+					entry.type = typeOfMode(info.st_mode);
+					if (options.stat) {
+						entry.hasStat = true;
+						entry.mode = static_cast<uint32_t>(info.st_mode);
+						entry.size = static_cast<uint64_t>(info.st_size);
+						entry.inode = static_cast<uint64_t>(info.st_ino);
+#ifdef __APPLE__
+						entry.modified = static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+						entry.modified = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+					}
+				}
+				if (entry.type == EntryType::directory && descend)
+					subdirectories.append(name, length + 1);
+				Strings::StringView view(name, length);
+				if ((entry.type == EntryType::directory && !options.directories) || !accepts(view)) return;
+				entry.path.reserve(prefix + length);
+				entry.path.append(path);
+				if (prefix > path.length())
+					entry.path.append('/');
+				entry.path.append(view);
+				entry.nameStart = prefix;
+				entry.depth = depth;
+				emit(entry, batch);
+			});
+			for (size_t offset = 0; offset < subdirectories.length() && !cancelled.load(std::memory_order_relaxed);) {
+				const char* name = subdirectories.data() + offset;
+				size_t length = std::strlen(name);
+				offset += length + 1;
+				Strings::String child;
+				child.reserve(prefix + length);
+				child.append(path);
+				if (prefix > path.length())
+					child.append('/');
+				child.append(Strings::StringView(name, length));
+				if (!visitor && buffered.load(std::memory_order_relaxed) >= options.maxBuffered) {
+					std::lock_guard<std::mutex> lock(mutex);
+					parked.push({std::move(child), depth + 1});
+					continue;
+				}
+				if (nesting + 1 >= maxNesting || active.load(std::memory_order_relaxed) < taskLimit()) {
+					spawn(std::move(child), depth + 1);
+					continue;
+				}
+				int next = ::openat(descriptor, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC | O_NOFOLLOW);
+				if (next < 0)
+					fail(errno);
+				else
+					walk(next, child, depth + 1, nesting + 1, buffer, batch);
+			}
+			::close(descriptor);
+		}
+
+		/**
+		 * Starts walking the directory
+		 */
+		void start() {
+			started = true;
+			spawn(Strings::String(root), 0);
+		}
+
+	public:
+		/**
+		 * Prepares a walk of a directory, nothing is read until the first entry is asked for
+		 * @param path The path of the directory
+		 * @param options The options of the walk
+		 * @param pool The pool to walk it on
+		 */
+		Directory(Strings::StringView path, const DirectoryOptions& options = DirectoryOptions(), Threading::ThreadPool& pool = Threading::ThreadPool::global()) : root(path), options(options), pool(&pool) {}
+
+		Directory(const Directory&) = delete;
+		Directory& operator=(const Directory&) = delete;
+
+		/**
+		 * Stops the walk and waits for its tasks to finish
+		 */
+		~Directory() {
+			cancelled.store(true);
+			pool->wait(tasks);
+		}
+
+		/**
+		 * Lists only entries whose name matches a glob pattern (or any other pattern or extension added)
+		 * @param pattern The pattern, see matchGlob
+		 * @returns This directory
+		 */
+		Directory& addGlob(Strings::StringView pattern) {
+			assert(!started);
+			globs.push(Strings::String(pattern));
+			return *this;
+		}
+
+		/**
+		 * Lists only entries with an extension (or any other extension or pattern added)
+		 * @param extension The extension, with or without its dot
+		 * @returns This directory
+		 */
+		Directory& addExtension(Strings::StringView extension) {
+			assert(!started);
+			if (extension.length() > 0 && extension[0] == '.')
+				extension = extension.substring(1);
+			extensions.push(Strings::String(extension));
+			return *this;
+		}
+
+		/**
+		 * Gets the next entry, waiting for the walk to find one
+		 * @param entry Set to the entry
+		 * @returns Whether or not there was another entry (false once the walk is done)
+		 */
+		bool next(DirectoryEntry& entry) {
+			if (!started)
+				start();
+			while (true) {
+				if (takenIndex < taken.length()) {
+					entry = std::move(taken[takenIndex++]);
+					return true;
+				}
+				taken.clear();
+				takenIndex = 0;
+				std::unique_lock<std::mutex> lock(mutex);
+				while (results.length() == 0 && active.load(std::memory_order_relaxed) > 0)
+					ready.wait(lock);
+				std::swap(taken, results);
+				buffered.fetch_sub(taken.length(), std::memory_order_relaxed);
+				// Everything buffered was just taken, so the parked directories can be walked again
+				while (parked.length() > 0 && !cancelled.load(std::memory_order_relaxed) && (active.load(std::memory_order_relaxed) < taskLimit() || taken.length() == 0)) {
+					Pending pending = std::move(parked[parked.length() - 1]);
+					parked.remove(parked.length() - 1);
+					spawn(std::move(pending.path), pending.depth);
+				}
+				if (taken.length() == 0 && active.load(std::memory_order_relaxed) == 0) return false;
+			}
+		}
+
+		/**
+		 * Calls a function with every entry on the workers as they are found, which skips handing entries to a reader
+		 * Helps run the walk on the calling thread, so it can be used from inside a task of the same pool
+		 * @param function Called with each entry (DirectoryEntry&) on many threads at once, must not throw
+		 * @returns Whether or not every directory could be read
+		 */
+		template<typename F>
+		bool forEach(F&& function) {
+			assert(!started);
+			visitor = std::forward<F>(function);
+			start();
+			pool->wait(tasks);
+			return error() == 0;
+		}
+
+		/**
+		 * Stops the walk early, can be called from any thread (entries already found can still be read)
+		 */
+		void stop() {
+			cancelled.store(true);
+		}
+
+		/**
+		 * Gets the error of the first directory that could not be read, those directories are skipped
+		 * @returns The errno (0 if every directory so far was read)
+		 */
+		int error() const {
+			return firstError.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * Gets an iterator at the first entry, which starts the walk
+		 * @returns The iterator
+		 */
+		DirectoryIterator begin() {
+			return DirectoryIterator(this);
+		}
+
+		/**
+		 * Gets the end iterator
+		 * @returns The iterator
+		 */
+		DirectoryIterator end() {
+			return DirectoryIterator();
+		}
+	};
+
+	inline DirectoryIterator::DirectoryIterator(Directory* directory) : directory(directory) {
+		++*this;
+	}
+
+	inline DirectoryIterator& DirectoryIterator::operator++() {
+		if (directory != nullptr && !directory->next(entry))
+			directory = nullptr;
+		return *this;
+	}
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
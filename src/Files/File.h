@@ -0,0 +1,719 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "../DataStructures/ArrayList.h"
+#include "../DataStructures/Iterator.h"
+#include "../String/String.h"
+#include <assert.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+/**
+ * The namespace for file support in the essentials library
+ */
+namespace Essentials::Files {
+
+	/**
+	 * A namespace alias to the files namespace
+	 */
+	namespace fi = Files;
+
+	/**
+	 * How a file is opened
+	 */
+	enum class FileMode : uint8_t {
+		/**
+		 * Reads an existing file
+		 */
+		read,
+		/**
+		 * Reads and writes an existing file
+		 */
+		readWrite,
+		/**
+		 * Reads and writes a file, creating it or emptying it if it exists
+		 */
+		create
+	};
+
+	/**
+	 * How a range of a file is going to be accessed, passed to the kernel so it can read ahead or drop pages
+	 */
+	enum class FileAccess : uint8_t {
+		/**
+		 * No particular pattern
+		 */
+		normal,
+		/**
+		 * From the start to the end, so read ahead aggressively and drop pages behind
+		 */
+		sequential,
+		/**
+		 * In no order, so do not read ahead
+		 */
+		random,
+		/**
+		 * Soon, so start reading it in now
+		 */
+		willNeed,
+		/**
+		 * Not again soon, so its pages can be dropped
+		 */
+		dontNeed
+	};
+
+	/**
+	 * Options for opening a file
+	 */
+	struct FileOptions {
+		/**
+		 * Whether or not to map regular files into memory (files that cannot be mapped are read with pread either way)
+		 */
+		bool map = true;
+
+		/**
+		 * Whether or not to read the whole mapping in while mapping it (Linux only)
+		 */
+		bool populate = false;
+
+		/**
+		 * Whether or not to ask for transparent huge pages for the mapping, which only takes effect on filesystems that support them
+		 */
+		bool hugePages = false;
+
+		/**
+		 * The access pattern advised for the whole file once it is open
+		 */
+		FileAccess access = FileAccess::normal;
+	};
+
+	/**
+	 * A view over contiguous elements it does not own
+	 * @tparam T The element type (const for read only views)
+	 */
+	template<typename T> class Span {
+	private:
+		/**
+		 * The first element
+		 */
+		T* elements = nullptr;
+
+		/**
+		 * The number of elements
+		 */
+		size_t count = 0;
+
+	public:
+		/**
+		 * Makes an empty span
+		 */
+		Span() = default;
+
+		/**
+		 * Makes a span over elements
+		 * @param elements The first element
+		 * @param count The number of elements
+		 */
+		Span(T* elements, size_t count) : elements(elements), count(count) {}
+
+		/**
+		 * Gets the first element
+		 * @returns A pointer to the elements
+		 */
+		inline T* data() const {
+			return elements;
+		}
+
+		/**
+		 * Gets the number of elements
+		 * @returns The length of the span
+		 */
+		inline size_t length() const {
+			return count;
+		}
+
+		/**
+		 * Gets an element
+		 * @param index The index of the element
+		 * @returns A reference to the element
+		 */
+		inline T& operator[](size_t index) const {
+			assert(index < count);
+			return elements[index];
+		}
+
+		/**
+		 * Gets an iterator at the first element
+		 * @returns The iterator
+		 */
+		DataStructures::Iterator<T> begin() const {
+			return DataStructures::Iterator<T>(elements);
+		}
+
+		/**
+		 * Gets an iterator past the last element
+		 * @returns The iterator
+		 */
+		DataStructures::Iterator<T> end() const {
+			return DataStructures::Iterator<T>(elements + count);
+		}
+	};
+
+	/**
+	 * A file mapped into memory when possible, so reads are views straight into the page cache with no copies
+	 * Files that cannot be mapped (devices and files like those in /proc which report no size) fall back to pread, with views copied into a buffer owned by the File
+	 * Pipes, sockets and other descriptors that cannot seek are read in order with read, so reads and views of them can only move forwards
+	 */
+	class File {
+	private:
+		/**
+		 * The value of everything up to the end of the file
+		 */
+		static constexpr size_t whole = static_cast<size_t>(-1);
+
+		/**
+		 * The number of bytes read at once when the length of a file is not known
+		 */
+		static constexpr size_t chunkSize = static_cast<size_t>(1) << 16;
+
+		/**
+		 * The file descriptor (-1 if the file is closed)
+		 */
+		int descriptor = -1;
+
+		/**
+		 * The mapping (nullptr if the file is not mapped or is empty)
+		 */
+		char* mapping = nullptr;
+
+		/**
+		 * Whether or not the file is mapped
+		 */
+		bool isMapped = false;
+
+		/**
+		 * The number of bytes in the file
+		 */
+		size_t size = 0;
+
+		/**
+		 * How the file was opened
+		 */
+		FileMode mode = FileMode::read;
+
+		/**
+		 * The options the file was opened with
+		 */
+		FileOptions options;
+
+		/**
+		 * The errno of the last operation that failed (0 if none has)
+		 */
+		int lastError = 0;
+
+		/**
+		 * Holds the bytes of views of files that are not mapped
+		 */
+		DataStructures::ArrayList<char> buffer;
+
+		/**
+		 * Whether or not the file cannot seek (a pipe, socket or terminal), so it is read in order instead of with pread
+		 */
+		bool isStream = false;
+
+		/**
+		 * The number of bytes read from a file that cannot seek, the only offset it can be read from next
+		 */
+		size_t streamPosition = 0;
+
+		/**
+		 * Records errno as the last error
+		 * @returns false
+		 */
+		bool fail() {
+			lastError = errno;
+			return false;
+		}
+
+		/**
+		 * Checks if the file was opened for writing
+		 * @returns Whether or not the file is writable
+		 */
+		bool writable() const {
+			return mode != FileMode::read;
+		}
+
+		/**
+		 * Reads from a file that cannot seek, skipping bytes up to the offset (bytes already read cannot be read again)
+		 * @param offset The first byte to read
+		 * @param out Where to copy the bytes
+		 * @param count The number of bytes to read
+		 * @returns The number of bytes read (fewer if the file ends or a read fails, see error())
+		 */
+		size_t readStream(size_t offset, void* out, size_t count) {
+			if (offset < streamPosition) {
+				lastError = ESPIPE;
+				return 0;
+			}
+			char skipped[4096];
+			while (streamPosition < offset) {
+				size_t want = offset - streamPosition < sizeof(skipped) ? offset - streamPosition : sizeof(skipped);
+				ssize_t got = ::read(descriptor, skipped, want);
+				if (got < 0 && errno == EINTR) continue;
+				if (got < 0) fail();
+				if (got <= 0) return 0;
+				streamPosition += static_cast<size_t>(got);
+			}
+			size_t total = 0;
+			while (total < count) {
+				ssize_t got = ::read(descriptor, static_cast<char*>(out) + total, count - total);
+				if (got < 0 && errno == EINTR) continue;
+				if (got < 0) fail();
+				if (got <= 0) break;
+				total += static_cast<size_t>(got);
+			}
+			streamPosition += total;
+			return total;
+		}
+
+		/**
+		 * Maps the whole file
+		 * @returns Whether or not the file was mapped
+		 */
+		bool map() {
+			if (size == 0) {
+				// Nothing to map, views are empty until the file is resized
+				isMapped = true;
+				return true;
+			}
+			int protection = PROT_READ | (writable() ? PROT_WRITE : 0);
+			int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+			if (options.populate)
+				flags |= MAP_POPULATE;
+#endif
+			void* address = ::mmap(nullptr, size, protection, flags, descriptor, 0);
+			if (address == MAP_FAILED) return fail();
+			mapping = static_cast<char*>(address);
+			isMapped = true;
+#ifdef MADV_HUGEPAGE
+			if (options.hugePages)
+				::madvise(mapping, size, MADV_HUGEPAGE);
+#endif
+			return true;
+		}
+
+		/**
+		 * Unmaps the file
+		 */
+		void unmap() {
+			if (mapping != nullptr)
+				::munmap(mapping, size);
+			mapping = nullptr;
+			isMapped = false;
+		}
+
+	public:
+		/**
+		 * Makes a closed file
+		 */
+		File() = default;
+
+		/**
+		 * Opens a file, check isOpen() (or use open directly) to see if it worked
+		 * @param path The path of the file
+		 * @param mode How to open the file
+		 * @param options The options to open the file with
+		 */
+		File(const char* path, FileMode mode = FileMode::read, const FileOptions& options = FileOptions()) {
+			open(path, mode, options);
+		}
+
+		/**
+		 * Files own their descriptor and mapping, so they cannot be copied
+		 */
+		File(const File&) = delete;
+
+		/**
+		 * Moves a file
+		 * @param other The file to move, left closed
+		 */
+		File(File&& other) noexcept : descriptor(other.descriptor), mapping(other.mapping), isMapped(other.isMapped), size(other.size), mode(other.mode), options(other.options), lastError(other.lastError), buffer(std::move(other.buffer)), isStream(other.isStream), streamPosition(other.streamPosition) {
+			other.descriptor = -1;
+			other.mapping = nullptr;
+			other.isMapped = false;
+			other.size = 0;
+		}
+
+		/**
+		 * Files own their descriptor and mapping, so they cannot be copied
+		 */
+		File& operator=(const File&) = delete;
+
+		/**
+		 * Moves a file, closing this one first
+		 * @param other The file to move, left closed
+		 * @returns This file
+		 */
+		File& operator=(File&& other) noexcept {
+			if (this == &other) return *this;
+			close();
+			descriptor = other.descriptor;
+			mapping = other.mapping;
+			isMapped = other.isMapped;
+			size = other.size;
+			mode = other.mode;
+			options = other.options;
+			lastError = other.lastError;
+			buffer = std::move(other.buffer);
+			isStream = other.isStream;
+			streamPosition = other.streamPosition;
+			other.descriptor = -1;
+			other.mapping = nullptr;
+			other.isMapped = false;
+			other.size = 0;
+			return *this;
+		}
+
+		/**
+		 * Closes the file
+		 */
+		~File() {
+			close();
+		}
+
+		/**
+		 * Opens a file, closing any file that was open, a regular file is mapped unless the options say not to (or mapping fails)
+		 * @param path The path of the file
+		 * @param mode How to open the file
+		 * @param options The options to open the file with
+		 * @returns Whether or not the file was opened (see error() if not)
+		 */
+		bool open(const char* path, FileMode mode = FileMode::read, const FileOptions& options = FileOptions()) {
+			close();
+			int flags = O_CLOEXEC;
+			if (mode == FileMode::read)
+				flags |= O_RDONLY;
+			else if (mode == FileMode::readWrite)
+				flags |= O_RDWR;
+			else
+				flags |= O_RDWR | O_CREAT | O_TRUNC;
+			descriptor = ::open(path, flags, 0644);
+			if (descriptor < 0) return fail();
+
+			struct stat information;
+			if (::fstat(descriptor, &information) != 0) {
+				fail();
+				::close(descriptor);
+				descriptor = -1;
+				return false;
+			}
+			size = static_cast<size_t>(information.st_size);
+			this->mode = mode;
+			this->options = options;
+			lastError = 0;
+			isStream = S_ISFIFO(information.st_mode) || S_ISSOCK(information.st_mode);
+			streamPosition = 0;
+
+			// Files like those in /proc report no size but still have contents, so only map empty files that will be written
+			bool mappable = S_ISREG(information.st_mode) && (size != 0 || writable());
+			if (options.map && mappable && map())
+				advise(options.access);
+			else if (options.access != FileAccess::normal)
+				advise(options.access);
+			return true;
+		}
+
+		/**
+		 * Closes the file if it is open, unmapping it
+		 */
+		void close() {
+			unmap();
+			if (descriptor >= 0)
+				::close(descriptor);
+			descriptor = -1;
+			size = 0;
+			buffer.clear();
+			isStream = false;
+			streamPosition = 0;
+		}
+
+		/**
+		 * Checks if the file is open
+		 * @returns Whether or not the file is open
+		 */
+		bool isOpen() const {
+			return descriptor >= 0;
+		}
+
+		/**
+		 * Gets the file descriptor, for system calls the File does not wrap
+		 * @returns The descriptor (-1 if the file is closed)
+		 */
+		int handle() const {
+			return descriptor;
+		}
+
+		/**
+		 * Checks if the file is mapped, in which case views point into the mapping
+		 * @returns Whether or not the file is mapped
+		 */
+		bool mapped() const {
+			return isMapped;
+		}
+
+		/**
+		 * Checks if the file can be read at any offset, which pipes, sockets and terminals cannot (they are only read forwards)
+		 * @returns Whether or not the file can seek
+		 */
+		bool seekable() const {
+			return !isStream;
+		}
+
+		/**
+		 * Gets the number of bytes in the file (0 for files that do not report a size)
+		 * @returns The length of the file
+		 */
+		size_t length() const {
+			return size;
+		}
+
+		/**
+		 * Gets why the last operation failed
+		 * @returns The errno of the last failure (0 if none has failed)
+		 */
+		int error() const {
+			return lastError;
+		}
+
+		/**
+		 * Gets a description of why the last operation failed
+		 * @returns The message of the last errno
+		 */
+		const char* errorMessage() const {
+			return std::strerror(lastError);
+		}
+
+		/**
+		 * Gets the mapped bytes of the file
+		 * @returns The mapping (nullptr if the file is not mapped or empty)
+		 */
+		const char* data() const {
+			return mapping;
+		}
+
+		/**
+		 * Gets the mapped bytes of a file opened for writing, writes go straight to the page cache
+		 * @returns The mapping (nullptr if the file is read only, not mapped or empty)
+		 */
+		char* writableData() {
+			return writable() ? mapping : nullptr;
+		}
+
+		/**
+		 * Gets a view of part of the file, without copying if the file is mapped
+		 * Views of files that are not mapped are read into a buffer owned by the File, so they last until the next view or close
+		 * Views of files that cannot seek have to start at or after the end of the last view or read
+		 * @param offset The first byte of the view
+		 * @param count The number of bytes (clamped to the end of the file, everything by default)
+		 * @returns The view (shorter than asked for if the file ends first)
+		 */
+		Strings::StringView view(size_t offset = 0, size_t count = whole) {
+			if (isMapped) {
+				if (offset >= size) return Strings::StringView();
+				if (count > size - offset)
+					count = size - offset;
+				return Strings::StringView(mapping + offset, count);
+			}
+			buffer.clear();
+			while (count != 0) {
+				size_t want = count < chunkSize ? count : chunkSize;
+				size_t used = buffer.length();
+				buffer.resize(used + want);
+				size_t got = read(offset, buffer.data() + used, want);
+				buffer.resize(used + got);
+				if (got < want) break;
+				offset += got;
+				if (count != whole)
+					count -= got;
+			}
+			return Strings::StringView(buffer.data(), buffer.length());
+		}
+
+		/**
+		 * Gets part of a mapped file as an array of elements, without copying
+		 * @tparam T The element type (trivially copyable)
+		 * @param offset The byte offset of the first element (a multiple of the alignment of T)
+		 * @param count The number of elements (clamped to the end of the file, everything by default)
+		 * @returns The span (empty if the file is not mapped)
+		 */
+		template<typename T>
+		Span<const T> span(size_t offset = 0, size_t count = whole) const {
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be viewed in a file");
+			assert(offset % alignof(T) == 0);
+			if (mapping == nullptr || offset >= size) return Span<const T>();
+			size_t available = (size - offset) / sizeof(T);
+			return Span<const T>(reinterpret_cast<const T*>(mapping + offset), count < available ? count : available);
+		}
+
+		/**
+		 * Copies bytes out of the file
+		 * Files that cannot seek are read in order, so the offset has to be at or after the end of the last read (see seekable())
+		 * @param offset The first byte to read
+		 * @param out Where to copy the bytes
+		 * @param count The number of bytes to read
+		 * @returns The number of bytes read (fewer if the file ends or a read fails, see error())
+		 */
+		size_t read(size_t offset, void* out, size_t count) {
+			if (isMapped) {
+				if (offset >= size) return 0;
+				if (count > size - offset)
+					count = size - offset;
+				std::memcpy(out, mapping + offset, count);
+				return count;
+			}
+			if (isStream) return readStream(offset, out, count);
+			size_t total = 0;
+			while (total < count) {
+				ssize_t got = ::pread(descriptor, static_cast<char*>(out) + total, count - total, static_cast<off_t>(offset + total));
+				if (got < 0 && errno == EINTR) continue;
+				if (got < 0 && errno == ESPIPE) {
+					// Terminals and other character devices only show they cannot seek once pread fails, and nothing was read by it
+					isStream = true;
+					return total + readStream(offset + total, static_cast<char*>(out) + total, count - total);
+				}
+				if (got < 0) fail();
+				if (got <= 0) break;
+				total += static_cast<size_t>(got);
+			}
+			return total;
+		}
+
+		/**
+		 * Copies bytes into a file opened for writing, growing it if the bytes go past the end
+		 * @param offset The first byte to write
+		 * @param in The bytes to write
+		 * @param count The number of bytes to write
+		 * @returns The number of bytes written (fewer if a write fails, see error())
+		 */
+		size_t write(size_t offset, const void* in, size_t count) {
+			if (!writable()) {
+				lastError = EBADF;
+				return 0;
+			}
+			if (count == 0) return 0;
+			if (isMapped) {
+				if (offset + count > size && !resize(offset + count)) return 0;
+				std::memcpy(mapping + offset, in, count);
+				return count;
+			}
+			size_t total = 0;
+			while (total < count) {
+				ssize_t put = ::pwrite(descriptor, static_cast<const char*>(in) + total, count - total, static_cast<off_t>(offset + total));
+				if (put < 0 && errno == EINTR) continue;
+				if (put < 0) fail();
+				if (put <= 0) break;
+				total += static_cast<size_t>(put);
+			}
+			if (offset + total > size)
+				size = offset + total;
+			return total;
+		}
+
+		/**
+		 * Changes the length of a file opened for writing, remapping it if it is mapped
+		 * @param length The new length
+		 * @returns Whether or not the file was resized (see error() if not)
+		 */
+		bool resize(size_t length) {
+			if (!writable()) {
+				lastError = EBADF;
+				return false;
+			}
+			if (::ftruncate(descriptor, static_cast<off_t>(length)) != 0) return fail();
+			if (!isMapped) {
+				size = length;
+				return true;
+			}
+#ifdef MREMAP_MAYMOVE
+			if (mapping != nullptr && length != 0) {
+				void* address = ::mremap(mapping, size, length, MREMAP_MAYMOVE);
+				if (address == MAP_FAILED) return fail();
+				mapping = static_cast<char*>(address);
+				size = length;
+				return true;
+			}
+#endif
+			unmap();
+			size = length;
+			return map();
+		}
+
+		/**
+		 * Tells the kernel how part of the file is going to be accessed
+		 * @param access The access pattern
+		 * @param offset The first byte of the range
+		 * @param count The number of bytes in the range (everything by default)
+		 * @returns Whether or not the advice was taken (see error() if not)
+		 */
+		bool advise(FileAccess access, size_t offset = 0, size_t count = whole) {
+			if (isMapped && mapping != nullptr) {
+				if (offset >= size) return true;
+				if (count > size - offset)
+					count = size - offset;
+				// The range has to start on a page
+				size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+				size_t start = offset / page * page;
+				int advice = access == FileAccess::sequential ? MADV_SEQUENTIAL : access == FileAccess::random ? MADV_RANDOM : access == FileAccess::willNeed ? MADV_WILLNEED : access == FileAccess::dontNeed ? MADV_DONTNEED : MADV_NORMAL;
+				if (::madvise(mapping + start, count + offset - start, advice) != 0) return fail();
+				return true;
+			}
+#ifdef POSIX_FADV_SEQUENTIAL
+			int advice = access == FileAccess::sequential ? POSIX_FADV_SEQUENTIAL : access == FileAccess::random ? POSIX_FADV_RANDOM : access == FileAccess::willNeed ? POSIX_FADV_WILLNEED : access == FileAccess::dontNeed ? POSIX_FADV_DONTNEED : POSIX_FADV_NORMAL;
+			int result = ::posix_fadvise(descriptor, static_cast<off_t>(offset), count == whole ? 0 : static_cast<off_t>(count), advice);
+			if (result != 0) {
+				lastError = result;
+				return false;
+			}
+#endif
+			return true;
+		}
+
+		/**
+		 * Writes changes to the file out to storage
+		 * @returns Whether or not the changes were written (see error() if not)
+		 */
+		bool sync() {
+			if (mapping != nullptr && writable() && ::msync(mapping, size, MS_SYNC) != 0) return fail();
+			if (::fsync(descriptor) != 0) return fail();
+			return true;
+		}
+	};
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
@@ -0,0 +1,467 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "AsyncIO.h"
+#include "File.h"
+#include "../DataStructures/ArrayList.h"
+#include "../DataStructures/Search.h"
+#include "../String/String.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+/**
+ * The namespace for file support in the essentials library
+ */
+namespace Essentials::Files {
+
+	/**
+	 * A namespace alias to the files namespace
+	 */
+	namespace fi = Files;
+
+	/**
+	 * A range of bytes of a file
+	 */
+	struct FileRange {
+		/**
+		 * The first byte
+		 */
+		size_t begin = 0;
+
+		/**
+		 * The byte after the last (everything up to the end of the file by default)
+		 */
+		size_t end = static_cast<size_t>(-1);
+	};
+
+	/**
+	 * Options for reading records
+	 */
+	struct RecordOptions {
+		/**
+		 * The number of bytes read at once from files that are not mapped, and advised ahead of the reader for files that are
+		 */
+		size_t chunkSize = static_cast<size_t>(1) << 22;
+
+		/**
+		 * Whether or not to read the next chunk while the current one is parsed (through an AsyncIO engine for files that are
+		 * not mapped, or by advising the kernel to read the mapping ahead for files that are)
+		 */
+		bool prefetch = true;
+
+		/**
+		 * Whether or not to drop a \r before the delimiter, so files with \r\n line endings give the same lines
+		 */
+		bool trimCarriageReturn = false;
+	};
+
+	/**
+	 * Reads a file one record at a time, each record is a view of the bytes up to the next delimiter (not included)
+	 * Delimiters are found 64 bytes at a time with vector compares, the reader then walks the bits of the mask so short
+	 * records cost no search call each
+	 * Mapped files are read in place with no copies, other files are read in chunks into two buffers, the next chunk being
+	 * read while the current one is parsed, and a record spanning two chunks is moved to the front of the next one
+	 * Pipes and other files that cannot seek are read the same way without reading ahead, and only from the start of the range onwards
+	 * A reader can be limited to a range of the file, it then gives every record that starts inside the range, so readers
+	 * over the ranges from split() give every record of the file exactly once and can run on separate threads
+	 */
+	class RecordReader {
+	private:
+		/**
+		 * The file being read
+		 */
+		File* file;
+
+		/**
+		 * The byte records end at
+		 */
+		char delimiter;
+
+		/**
+		 * The options of the reader
+		 */
+		RecordOptions options;
+
+		/**
+		 * Records starting at or after this offset belong to the next range
+		 */
+		size_t rangeEnd;
+
+		/**
+		 * The bytes being parsed
+		 */
+		const char* base = nullptr;
+
+		/**
+		 * The file offset of the first byte of base
+		 */
+		size_t baseOffset = 0;
+
+		/**
+		 * The number of bytes in base
+		 */
+		size_t length = 0;
+
+		/**
+		 * The index in base where the next record starts
+		 */
+		size_t position = 0;
+
+		/**
+		 * The number of bytes of base whose delimiters have been put in a mask
+		 */
+		size_t scanned = 0;
+
+		/**
+		 * The index in base of the first byte of the mask
+		 */
+		size_t blockStart = 0;
+
+		/**
+		 * A bit for each delimiter of the current block that has not been reached yet
+		 */
+		uint64_t mask = 0;
+
+		/**
+		 * The file offset of the next chunk
+		 */
+		size_t readOffset = 0;
+
+		/**
+		 * The file offset at which the next chunk of the mapping is advised (-1 when there is nothing left to advise)
+		 */
+		size_t advised = static_cast<size_t>(-1);
+
+		/**
+		 * Whether or not the file ends after base
+		 */
+		bool lastChunk = false;
+
+		/**
+		 * Whether or not the first record is the end of one from the previous range and has to be skipped
+		 */
+		bool skipFirst = false;
+
+		/**
+		 * Whether or not every record has been read
+		 */
+		bool finished = false;
+
+		/**
+		 * The errno of a read that failed (0 if none has)
+		 */
+		int lastError = 0;
+
+		/**
+		 * The chunk buffers of files that are not mapped, each is a chunk for the end of the previous record followed by a chunk read from the file
+		 */
+		DataStructures::ArrayList<char> buffers[2];
+
+		/**
+		 * The index of the buffer being parsed
+		 */
+		size_t current = 0;
+
+		/**
+		 * Holds a record that is longer than a chunk while the rest of it is read
+		 */
+		DataStructures::ArrayList<char> spill;
+
+		/**
+		 * Reads the next chunk ahead (declared after the buffers so it is destroyed, and its reads finished, first)
+		 */
+		std::unique_ptr<AsyncIO> io;
+
+		/**
+		 * The read of the next chunk
+		 */
+		IoFuture prefetched;
+
+		/**
+		 * Whether or not the next chunk is being read
+		 */
+		bool prefetching = false;
+
+#ifdef ESSENTIALS_SEARCH_AVX2
+		/**
+		 * Finds the delimiters of a block of 64 bytes with AVX2
+		 * @param bytes The block
+		 * @param delimiter The delimiter
+		 * @returns A bit for every delimiter
+		 */
+		__attribute__((target("avx2"))) static uint64_t scanBlockAvx2(const char* bytes, char delimiter) {
+			return DataStructures::searchBlock256<char>(bytes, _mm256_set1_epi8(delimiter));
+		}
+#endif
+
+		/**
+		 * Finds the delimiters of a block of 64 bytes
+		 * @param bytes The block
+		 * @param delimiter The delimiter
+		 * @returns A bit for every delimiter
+		 */
+		static uint64_t scanBlock(const char* bytes, char delimiter) {
+#ifdef ESSENTIALS_SEARCH_AVX2
+			if (DataStructures::cpuSupportsAvx2()) return scanBlockAvx2(bytes, delimiter);
+#endif
+#ifdef ESSENTIALS_SEARCH_SSE2
+			return DataStructures::searchBlock128<char>(bytes, _mm_set1_epi8(delimiter));
+#else
+			uint64_t bits = 0;
+			for (size_t i = 0; i < 64; i++)
+				if (bytes[i] == delimiter)
+					bits |= static_cast<uint64_t>(1) << i;
+			return bits;
+#endif
+		}
+
+		/**
+		 * Finds the delimiters in up to 64 bytes
+		 * @param bytes The bytes
+		 * @param count The number of bytes (only the first 64 are scanned)
+		 * @param delimiter The delimiter
+		 * @returns A bit for every delimiter
+		 */
+		static uint64_t scanBytes(const char* bytes, size_t count, char delimiter) {
+			if (count >= 64) return scanBlock(bytes, delimiter);
+			// Padding with a byte that is not the delimiter leaves the bits past the end clear
+			char padded[64];
+			std::memset(padded, ~delimiter, sizeof(padded));
+			std::memcpy(padded, bytes, count);
+			return scanBlock(padded, delimiter);
+		}
+
+		/**
+		 * Asks the kernel to read the next chunk of the mapping
+		 */
+		void adviseAhead() {
+			size_t limit = rangeEnd < file->length() ? rangeEnd : file->length();
+			if (advised + options.chunkSize >= limit) {
+				advised = static_cast<size_t>(-1);
+				return;
+			}
+			file->advise(FileAccess::willNeed, advised + options.chunkSize, options.chunkSize);
+			advised += options.chunkSize;
+		}
+
+		/**
+		 * Starts reading the next chunk into the buffer that is not being parsed
+		 */
+		void startPrefetch() {
+			// Pipes and other files that cannot seek have to be read in order, so they are read when the chunk is needed
+			if (!options.prefetch || !file->seekable() || lastChunk || readOffset >= rangeEnd) return;
+			if (io == nullptr)
+				io = std::make_unique<AsyncIO>(2);
+			prefetched = io->read(*file, readOffset, buffers[1 - current].data() + options.chunkSize, static_cast<uint32_t>(options.chunkSize));
+			io->submit();
+			prefetching = true;
+		}
+
+		/**
+		 * Moves to the next chunk of a file that is not mapped, keeping the record that has not ended yet
+		 * @returns Whether or not there was another chunk
+		 */
+		bool refill() {
+			if (file->mapped() || lastChunk) return false;
+			size_t chunk = options.chunkSize;
+			size_t other = 1 - current;
+			char* target = buffers[other].data() + chunk;
+			size_t got = 0;
+			if (prefetching) {
+				prefetching = false;
+				int64_t result = prefetched.get();
+				if (result < 0)
+					lastError = static_cast<int>(-result);
+				else
+					got = static_cast<size_t>(result);
+			}
+			if (got < chunk && lastError == 0) {
+				got += file->read(readOffset + got, target + got, chunk - got);
+				if (got < chunk && file->error() != 0)
+					lastError = file->error();
+			}
+			lastChunk = got < chunk;
+			readOffset += got;
+			size_t tail = length - position;
+			const char* tailData = base + position;
+			if (tail <= chunk) {
+				if (tail > 0)
+					std::memcpy(target - tail, tailData, tail);
+				base = target - tail;
+			} else {
+				// The record is longer than a chunk, so it is gathered in the spill buffer until it ends
+				if (base == spill.data())
+					spill.remove(0, position);
+				else {
+					spill.clear();
+					spill.append(tailData, tail);
+				}
+				spill.append(target, got);
+				base = spill.data();
+			}
+			baseOffset += position;
+			length = tail + got;
+			position = 0;
+			// The end of the previous record was already scanned and holds no delimiter
+			scanned = tail;
+			mask = 0;
+			current = other;
+			startPrefetch();
+			return got > 0;
+		}
+
+	public:
+		/**
+		 * Makes a reader over an open file (which must stay open while the reader is used)
+		 * @param file The file to read
+		 * @param delimiter The byte records end at
+		 * @param range The range whose records are read (the whole file by default)
+		 * @param options The options of the reader
+		 */
+		RecordReader(File& file, char delimiter = '\n', FileRange range = FileRange(), const RecordOptions& options = RecordOptions()) : file(&file), delimiter(delimiter), options(options), rangeEnd(range.end) {
+			if (this->options.chunkSize < 64)
+				this->options.chunkSize = 64;
+			if (this->options.chunkSize > (static_cast<size_t>(1) << 30))
+				this->options.chunkSize = static_cast<size_t>(1) << 30;
+			// Starting one byte early makes the first record either the empty one after a delimiter just before the range or
+			// the end of a record of the previous range, both are skipped
+			size_t start = range.begin;
+			if (start > 0) {
+				start--;
+				skipFirst = true;
+			}
+			if (file.mapped()) {
+				base = file.data();
+				length = file.length();
+				position = start < length ? start : length;
+				scanned = position;
+				if (this->options.prefetch && position < length) {
+					file.advise(FileAccess::willNeed, position, this->options.chunkSize);
+					advised = position;
+					adviseAhead();
+				}
+				return;
+			}
+			for (DataStructures::ArrayList<char>& buffer : buffers) {
+				buffer.prepare(this->options.chunkSize * 2);
+				buffer.resizeUninitialized(this->options.chunkSize * 2);
+			}
+			baseOffset = start;
+			readOffset = start;
+			refill();
+		}
+
+		RecordReader(const RecordReader&) = delete;
+		RecordReader& operator=(const RecordReader&) = delete;
+
+		/**
+		 * Splits a file into ranges of about the same size to be read by separate readers
+		 * @param file The file to split
+		 * @param parts The number of ranges wanted
+		 * @param minimumSize The smallest range worth reading on its own, fewer ranges are made for small files
+		 * @returns The ranges, in order and covering the whole file
+		 */
+		static DataStructures::ArrayList<FileRange> split(const File& file, size_t parts, size_t minimumSize = static_cast<size_t>(1) << 20) {
+			DataStructures::ArrayList<FileRange> ranges;
+			size_t size = file.length();
+			if (minimumSize == 0)
+				minimumSize = 1;
+			if (parts > size / minimumSize)
+				parts = size / minimumSize;
+			if (parts <= 1) {
+				ranges.push(FileRange());
+				return ranges;
+			}
+			ranges.prepare(parts);
+			for (size_t i = 0; i < parts; i++)
+				ranges.push({size / parts * i, i + 1 == parts ? static_cast<size_t>(-1) : size / parts * (i + 1)});
+			return ranges;
+		}
+
+		/**
+		 * Gets the next record, which stays valid until the next call (or for as long as the file stays open if it is mapped)
+		 * @param record Set to the record, without its delimiter
+		 * @returns Whether or not there was another record (the last record of the file does not need a delimiter after it)
+		 */
+		bool next(Strings::StringView& record) {
+			while (!finished) {
+				if (mask == 0) {
+					if (scanned < length) {
+						blockStart = scanned;
+						mask = scanBytes(base + scanned, length - scanned, delimiter);
+						scanned += length - scanned < 64 ? length - scanned : 64;
+						if (baseOffset + scanned >= advised)
+							adviseAhead();
+						continue;
+					}
+					if (refill()) continue;
+					finished = true;
+					// Whatever is left after the last delimiter is the last record
+					if (skipFirst || position >= length || baseOffset + position >= rangeEnd) return false;
+					size_t end = length;
+					if (options.trimCarriageReturn && base[end - 1] == '\r')
+						end--;
+					record = Strings::StringView(base + position, end - position);
+					position = length;
+					return true;
+				}
+				uint32_t low = static_cast<uint32_t>(mask);
+				size_t end = blockStart + (low ? DataStructures::searchLowestBit(low) : 32 + DataStructures::searchLowestBit(static_cast<uint32_t>(mask >> 32)));
+				mask &= mask - 1;
+				size_t start = position;
+				position = end + 1;
+				if (skipFirst) {
+					skipFirst = false;
+					continue;
+				}
+				if (baseOffset + start >= rangeEnd) {
+					finished = true;
+					return false;
+				}
+				if (options.trimCarriageReturn && end > start && base[end - 1] == '\r')
+					end--;
+				record = Strings::StringView(base + start, end - start);
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * Gets the file offset of the next record
+		 * @returns The offset
+		 */
+		size_t offset() const {
+			return baseOffset + position;
+		}
+
+		/**
+		 * Gets why a read of the file failed, the reader stops at the failed chunk
+		 * @returns The errno (0 if no read has failed)
+		 */
+		int error() const {
+			return lastError;
+		}
+	};
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
@@ -0,0 +1,1037 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "Simd.h"
+#include "../DataStructures/ArrayList.h"
+#include "../Threading/Parallel.h"
+#include <assert.h>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+/**
+ * The namespace for math in the essentials library
+ */
+namespace Essentials::Math {
+
+	/**
+	 * A namespace alias to the math namespace
+	 */
+	namespace ma = Math;
+
+	/**
+	 * The number of elements a task processes when an elementwise operation is split across threads
+	 */
+	inline constexpr size_t elementwiseGrain = 1 << 16;
+
+	/**
+	 * Multiplies a value by a power of two in a constant expression
+	 * @param value The value
+	 * @param exponent The power of two (scaled in two steps so the result can be subnormal or the largest finite value)
+	 * @returns value * 2^exponent
+	 */
+	constexpr double scaleByPowerOfTwo(double value, long long exponent) {
+		long long halves[2] = { exponent / 2, exponent - exponent / 2 };
+		for (long long half : halves) {
+			double base = half < 0 ? 0.5 : 2.0;
+			double factor = 1;
+			for (long long n = half < 0 ? -half : half; n > 0; n >>= 1) {
+				if (n & 1) factor *= base;
+				if (n > 1) base *= base;
+			}
+			value *= factor;
+		}
+		return value;
+	}
+
+	/**
+	 * Rounds a value to the nearest integer in a constant expression (halfway cases away from zero)
+	 * @param value The value (within the range of long long)
+	 * @returns The nearest integer
+	 */
+	constexpr long long roundToInteger(double value) {
+		return static_cast<long long>(value < 0 ? value - 0.5 : value + 0.5);
+	}
+
+	/**
+	 * Computes root * root - value without rounding the product (Dekker's product)
+	 * @param root The candidate square root (at most 2^500)
+	 * @param value The value
+	 * @returns The residual, whose sign is exact when root is near the square root of value
+	 */
+	constexpr double squareResidual(double root, double value) {
+		double split = root * 134217729.0;
+		double high = split - (split - root);
+		double low = root - high;
+		double product = root * root;
+		double error = ((high * high - product) + 2 * high * low) + low * low;
+		return (product - value) + error;
+	}
+
+	/**
+	 * Computes a square root, usable in constant expressions (correctly rounded double at compile time, std::sqrt at
+	 * runtime)
+	 * @param value The value
+	 * @returns The square root (NaN for negative values)
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+	constexpr T sqrt(T value) {
+		if (!isConstantEvaluated()) return std::sqrt(value);
+		double x = static_cast<double>(value);
+		if (x != x || x < 0) return std::numeric_limits<T>::quiet_NaN();
+		if (x == 0 || x == std::numeric_limits<double>::infinity()) return value;
+		// Scale by powers of 4 into [1, 4) so Newton's method starts close and the residual does not underflow
+		long long e = 0;
+		while (x >= 0x1p64) { x *= 0x1p-64; e += 32; }
+		while (x < 0x1p-64) { x *= 0x1p64; e -= 32; }
+		while (x >= 4) { x *= 0.25; e++; }
+		while (x < 1) { x *= 4; e--; }
+		double root = 1.5;
+		for (int i = 0; i < 6; i++)
+			root = (root + x / root) / 2;
+		// Newton's method can end one ulp away, so pick the neighbour whose square is closest
+		double below = root - 0x1p-52, above = root + 0x1p-52;
+		double residual = squareResidual(root, x);
+		double belowResidual = squareResidual(below, x), aboveResidual = squareResidual(above, x);
+		if ((belowResidual < 0 ? -belowResidual : belowResidual) < (residual < 0 ? -residual : residual)) root = below, residual = belowResidual;
+		if ((aboveResidual < 0 ? -aboveResidual : aboveResidual) < (residual < 0 ? -residual : residual)) root = above;
+		return static_cast<T>(scaleByPowerOfTwo(root, e));
+	}
+
+	/**
+	 * Computes e raised to a power, usable in constant expressions (within 1 ulp of double at compile time, std::exp at
+	 * runtime)
+	 * @param value The power
+	 * @returns e^value
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+	constexpr T exp(T value) {
+		if (!isConstantEvaluated()) return std::exp(value);
+		double x = static_cast<double>(value);
+		if (x != x) return value;
+		if (x > 709.782712893384) return std::numeric_limits<T>::infinity();
+		if (x < -745.1332191019412) return T(0);
+		long long k = roundToInteger(x * 1.44269504088896340736);
+		double r = x - k * 6.93147180369123816490e-01 - k * 1.90821492927058770002e-10;
+		// Taylor series of e^r - 1 - r, which converges quickly since |r| <= ln(2) / 2
+		double term = r * r / 2;
+		double series = 0;
+		for (int n = 3; term != 0 && n < 30; n++) {
+			series += term;
+			term *= r / n;
+		}
+		return static_cast<T>(scaleByPowerOfTwo(1 + (r + series), k));
+	}
+
+	/**
+	 * Computes a natural logarithm, usable in constant expressions (within 1 ulp of double at compile time, std::log at
+	 * runtime)
+	 * @param value The value
+	 * @returns ln(value) (-infinity for 0 and NaN for negative values)
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+	constexpr T log(T value) {
+		if (!isConstantEvaluated()) return std::log(value);
+		double x = static_cast<double>(value);
+		if (x != x || x < 0) return std::numeric_limits<T>::quiet_NaN();
+		if (x == 0) return -std::numeric_limits<T>::infinity();
+		if (x == std::numeric_limits<double>::infinity()) return value;
+		// Split x into m * 2^e with m in [sqrt(1/2), sqrt(2))
+		long long e = 0;
+		while (x >= 0x1p64) { x *= 0x1p-64; e += 64; }
+		while (x < 0x1p-64) { x *= 0x1p64; e -= 64; }
+		while (x >= 2) { x *= 0.5; e++; }
+		while (x < 1) { x *= 2; e--; }
+		if (x > 1.41421356237309504880) { x *= 0.5; e++; }
+		// ln(1 + f) = f - f^2 / 2 + s (f^2 / 2 + R) with s = f / (2 + f) and R = 2 s^2 / 3 + 2 s^4 / 5 + ... as in fdlibm
+		double f = x - 1;
+		double s = f / (2 + f);
+		double square = s * s;
+		double power = square;
+		double series = 0;
+		for (int n = 3; n < 60; n += 2) {
+			double term = 2 * power / n;
+			if (series + term == series) break;
+			series += term;
+			power *= square;
+		}
+		double halfSquare = 0.5 * f * f;
+		return static_cast<T>(e * 6.93147180369123816490e-01 - ((halfSquare - (s * (halfSquare + series) + e * 1.90821492927058770002e-10)) - f));
+	}
+
+	/**
+	 * Evaluates sine on [-pi/4, pi/4] (the fdlibm kernel)
+	 * @param r The reduced argument
+	 * @param tail The part of the reduced argument below the precision of r
+	 * @returns sin(r + tail)
+	 */
+	constexpr double sinKernel(double r, double tail) {
+		double z = r * r;
+		double polynomial = -1.66666666666666324348e-01 + z * (8.33333333332248946124e-03 + z * (-1.98412698298579493134e-04
+			+ z * (2.75573137070700676789e-06 + z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10))));
+		return r + (r * z * polynomial + tail * (1 - 0.5 * z));
+	}
+
+	/**
+	 * Evaluates cosine on [-pi/4, pi/4] (the fdlibm kernel)
+	 * @param r The reduced argument
+	 * @param tail The part of the reduced argument below the precision of r
+	 * @returns cos(r + tail)
+	 */
+	constexpr double cosKernel(double r, double tail) {
+		double z = r * r;
+		double polynomial = 4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03 + z * (2.48015872894767294178e-05
+			+ z * (-2.75573143513906633035e-07 + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11))));
+		double halfZ = 0.5 * z;
+		double w = 1 - halfZ;
+		return w + (((1 - w) - halfZ) + (z * z * polynomial - r * tail));
+	}
+
+	/**
+	 * Computes sine or cosine in a constant expression by reducing the argument to [-pi/4, pi/4]
+	 * @param x The angle in radians (accurate for |x| < 1e5)
+	 * @param quadrantOffset 0 for sine and 1 for cosine
+	 * @returns The sine or cosine
+	 */
+	constexpr double sinCos(double x, long long quadrantOffset) {
+		if (x != x || x == std::numeric_limits<double>::infinity() || x == -std::numeric_limits<double>::infinity())
+			return std::numeric_limits<double>::quiet_NaN();
+		// pi / 2 split into 33 bit pieces so the products with k are exact, keeping the rounding of each subtraction
+		double k = static_cast<double>(roundToInteger(x * 6.36619772367581382433e-01));
+		double r = x - k * 1.57079632673412561417e+00;
+		double tail = 0;
+		for (double piece : { 6.07710050630396597660e-11, 2.02226624871116645580e-21 }) {
+			double product = k * piece;
+			double previous = r;
+			r = previous - product;
+			tail += (previous - r) - product;
+		}
+		tail -= k * 8.47842766036889956997e-32;
+		double reduced = r + tail;
+		tail = (r - reduced) + tail;
+		long long quadrant = ((static_cast<long long>(k) + quadrantOffset) % 4 + 4) % 4;
+		double result = quadrant % 2 == 0 ? sinKernel(reduced, tail) : cosKernel(reduced, tail);
+		return quadrant >= 2 ? -result : result;
+	}
+
+	/**
+	 * Computes a sine, usable in constant expressions (within 1 ulp of double for |value| < 1e5 at compile time, std::sin
+	 * at runtime)
+	 * @param value The angle in radians
+	 * @returns sin(value)
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+	constexpr T sin(T value) {
+		if (!isConstantEvaluated()) return std::sin(value);
+		return static_cast<T>(sinCos(static_cast<double>(value), 0));
+	}
+
+	/**
+	 * Computes a cosine, usable in constant expressions (within 1 ulp of double for |value| < 1e5 at compile time,
+	 * std::cos at runtime)
+	 * @param value The angle in radians
+	 * @returns cos(value)
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+	constexpr T cos(T value) {
+		if (!isConstantEvaluated()) return std::cos(value);
+		return static_cast<T>(sinCos(static_cast<double>(value), 1));
+	}
+
+#ifdef ESSENTIALS_MATH_AVX2
+	/**
+	 * Computes e^x for eight floats (Cephes polynomial, within 1.01 ulp of the exact result)
+	 */
+	struct ExpFloat {
+		/**
+		 * Computes the function
+		 * @param x The inputs
+		 * @returns The results
+		 */
+		__attribute__((target("avx2,fma"))) inline __m256 operator()(__m256 x) const {
+			const __m256 maxInput = _mm256_set1_ps(88.72283935546875f);
+			const __m256 minInput = _mm256_set1_ps(-103.972084045410f);
+			__m256 clamped = _mm256_min_ps(_mm256_max_ps(x, minInput), maxInput);
+			__m256 k = _mm256_round_ps(_mm256_mul_ps(clamped, _mm256_set1_ps(1.44269504088896341f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+			__m256 r = _mm256_fnmadd_ps(k, _mm256_set1_ps(0.693359375f), clamped);
+			r = _mm256_fnmadd_ps(k, _mm256_set1_ps(-2.12194440e-4f), r);
+
+			__m256 p = _mm256_set1_ps(1.9875691500E-4f);
+			p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.3981999507E-3f));
+			p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(8.3334519073E-3f));
+			p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(4.1665795894E-2f));
+			p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.6666665459E-1f));
+			p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(5.0000001201E-1f));
+			__m256 y = _mm256_add_ps(_mm256_fmadd_ps(p, _mm256_mul_ps(r, r), r), _mm256_set1_ps(1.0f));
+
+			// Scale by 2^k in two steps so subnormal results are rounded once
+			__m256i exponent = _mm256_cvtps_epi32(k);
+			__m256i half = _mm256_srai_epi32(exponent, 1);
+			__m256i rest = _mm256_sub_epi32(exponent, half);
+			const __m256i bias = _mm256_set1_epi32(127);
+			y = _mm256_mul_ps(y, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(half, bias), 23)));
+			y = _mm256_mul_ps(y, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(rest, bias), 23)));
+
+			y = _mm256_blendv_ps(y, _mm256_set1_ps(std::numeric_limits<float>::infinity()), _mm256_cmp_ps(x, maxInput, _CMP_GT_OQ));
+			y = _mm256_blendv_ps(y, _mm256_setzero_ps(), _mm256_cmp_ps(x, minInput, _CMP_LT_OQ));
+			return _mm256_blendv_ps(y, x, _mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+		}
+	};
+
+	/**
+	 * Computes e^x for four doubles (degree 13 Taylor polynomial, within 1 ulp of the exact result)
+	 */
+	struct ExpDouble {
+		/**
+		 * Computes the function
+		 * @param x The inputs
+		 * @returns The results
+		 */
+		__attribute__((target("avx2,fma"))) inline __m256d operator()(__m256d x) const {
+			const __m256d maxInput = _mm256_set1_pd(709.782712893384);
+			const __m256d minInput = _mm256_set1_pd(-745.1332191019412);
+			__m256d clamped = _mm256_min_pd(_mm256_max_pd(x, minInput), maxInput);
+			__m256d k = _mm256_round_pd(_mm256_mul_pd(clamped, _mm256_set1_pd(1.44269504088896340736)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+			__m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(6.93147180369123816490e-01), clamped);
+			r = _mm256_fnmadd_pd(k, _mm256_set1_pd(1.90821492927058770002e-10), r);
+
+			// Horner's rule over 1/n! from n = 13 down to n = 2
+			__m256d p = _mm256_set1_pd(1.0 / 6227020800.0);
+			constexpr double factorials[] = { 479001600.0, 39916800.0, 3628800.0, 362880.0, 40320.0, 5040.0, 720.0, 120.0, 24.0, 6.0, 2.0 };
+			for (double factorial : factorials)
+				p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / factorial));
+			__m256d y = _mm256_add_pd(_mm256_fmadd_pd(p, _mm256_mul_pd(r, r), r), _mm256_set1_pd(1.0));
+
+			// Scale by 2^k in two steps, converting through the 2^52 + 2^51 trick since AVX2 has no double to int64
+			const __m256d magic = _mm256_set1_pd(0x1.8p52);
+			const __m256i bias = _mm256_set1_epi64x(1023);
+			__m256d half = _mm256_round_pd(_mm256_mul_pd(k, _mm256_set1_pd(0.5)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+			__m256d rest = _mm256_sub_pd(k, half);
+			__m256i halfBits = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(half, magic)), _mm256_castpd_si256(magic));
+			__m256i restBits = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(rest, magic)), _mm256_castpd_si256(magic));
+			y = _mm256_mul_pd(y, _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(halfBits, bias), 52)));
+			y = _mm256_mul_pd(y, _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(restBits, bias), 52)));
+
+			y = _mm256_blendv_pd(y, _mm256_set1_pd(std::numeric_limits<double>::infinity()), _mm256_cmp_pd(x, maxInput, _CMP_GT_OQ));
+			y = _mm256_blendv_pd(y, _mm256_setzero_pd(), _mm256_cmp_pd(x, minInput, _CMP_LT_OQ));
+			return _mm256_blendv_pd(y, x, _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+		}
+	};
+
+	/**
+	 * Computes ln(x) for eight floats (Cephes polynomial, within 1 ulp of the exact result)
+	 */
+	struct LogFloat {
+		/**
+		 * Computes the function
+		 * @param x The inputs
+		 * @returns The results
+		 */
+		__attribute__((target("avx2,fma"))) inline __m256 operator()(__m256 x) const {
+			// Scale subnormals into the normal range
+			__m256 subnormal = _mm256_cmp_ps(x, _mm256_set1_ps(std::numeric_limits<float>::min()), _CMP_LT_OQ);
+			__m256 scaled = _mm256_blendv_ps(x, _mm256_mul_ps(x, _mm256_set1_ps(0x1p25f)), subnormal);
+			__m256 adjust = _mm256_and_ps(subnormal, _mm256_set1_ps(25.0f));
+
+			// Split into m * 2^e with m in [0.5, 1)
+			__m256i bits = _mm256_castps_si256(scaled);
+			__m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+			e = _mm256_sub_ps(e, adjust);
+			__m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F000000)));
+
+			// Move m into [sqrt(1/2), sqrt(2)) and subtract 1
+			__m256 small = _mm256_cmp_ps(m, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+			e = _mm256_sub_ps(e, _mm256_and_ps(small, _mm256_set1_ps(1.0f)));
+			m = _mm256_sub_ps(_mm256_add_ps(m, _mm256_and_ps(small, m)), _mm256_set1_ps(1.0f));
+
+			__m256 z = _mm256_mul_ps(m, m);
+			__m256 p = _mm256_set1_ps(7.0376836292E-2f);
+			p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-1.1514610310E-1f));
+			p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(1.1676998740E-1f));
+			p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-1.2420140846E-1f));
+			p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(1.4249322787E-1f));
+			p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-1.6668057665E-1f));
+			p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(2.0000714765E-1f));
+			p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-2.4999993993E-1f));
+			p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(3.3333331174E-1f));
+			__m256 y = _mm256_mul_ps(_mm256_mul_ps(p, m), z);
+			y = _mm256_fmadd_ps(e, _mm256_set1_ps(-2.12194440e-4f), y);
+			y = _mm256_fnmadd_ps(_mm256_set1_ps(0.5f), z, y);
+			y = _mm256_fmadd_ps(e, _mm256_set1_ps(0.693359375f), _mm256_add_ps(m, y));
+
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 infinity = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+			y = _mm256_blendv_ps(y, _mm256_set1_ps(-std::numeric_limits<float>::infinity()), _mm256_cmp_ps(x, zero, _CMP_EQ_OQ));
+			y = _mm256_blendv_ps(y, infinity, _mm256_cmp_ps(x, infinity, _CMP_EQ_OQ));
+			return _mm256_blendv_ps(y, _mm256_set1_ps(std::numeric_limits<float>::quiet_NaN()), _mm256_cmp_ps(x, zero, _CMP_NGE_UQ));
+		}
+	};
+
+	/**
+	 * Computes ln(x) for four doubles (fdlibm polynomial, within 1 ulp of the exact result)
+	 */
+	struct LogDouble {
+		/**
+		 * Computes the function
+		 * @param x The inputs
+		 * @returns The results
+		 */
+		__attribute__((target("avx2,fma"))) inline __m256d operator()(__m256d x) const {
+			// Scale subnormals into the normal range
+			__m256d subnormal = _mm256_cmp_pd(x, _mm256_set1_pd(std::numeric_limits<double>::min()), _CMP_LT_OQ);
+			__m256d scaled = _mm256_blendv_pd(x, _mm256_mul_pd(x, _mm256_set1_pd(0x1p54)), subnormal);
+			__m256d adjust = _mm256_and_pd(subnormal, _mm256_set1_pd(54.0));
+
+			// Split into m * 2^e with m in [1, 2), converting the exponent bits through the 2^52 trick
+			__m256i bits = _mm256_castpd_si256(scaled);
+			const __m256d magic = _mm256_set1_pd(0x1p52);
+			__m256d e = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_castpd_si256(magic))), magic);
+			e = _mm256_sub_pd(e, _mm256_add_pd(adjust, _mm256_set1_pd(1023.0)));
+			__m256d m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFF)), _mm256_set1_epi64x(0x3FF0000000000000)));
+
+			// Move m into [sqrt(1/2), sqrt(2))
+			__m256d large = _mm256_cmp_pd(m, _mm256_set1_pd(1.41421356237309504880), _CMP_GT_OQ);
+			m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), large);
+			e = _mm256_add_pd(e, _mm256_and_pd(large, _mm256_set1_pd(1.0)));
+
+			__m256d f = _mm256_sub_pd(m, _mm256_set1_pd(1.0));
+			__m256d s = _mm256_div_pd(f, _mm256_add_pd(f, _mm256_set1_pd(2.0)));
+			__m256d z = _mm256_mul_pd(s, s);
+			__m256d w = _mm256_mul_pd(z, z);
+			__m256d odd = _mm256_fmadd_pd(w, _mm256_set1_pd(1.479819860511658591e-01), _mm256_set1_pd(1.818357216161805012e-01));
+			odd = _mm256_fmadd_pd(w, odd, _mm256_set1_pd(2.857142874366239149e-01));
+			odd = _mm256_fmadd_pd(w, odd, _mm256_set1_pd(6.666666666666735130e-01));
+			__m256d even = _mm256_fmadd_pd(w, _mm256_set1_pd(1.531383769920937332e-01), _mm256_set1_pd(2.222219843214978396e-01));
+			even = _mm256_fmadd_pd(w, even, _mm256_set1_pd(3.999999999940941908e-01));
+			__m256d r = _mm256_fmadd_pd(z, odd, _mm256_mul_pd(w, even));
+			__m256d halfSquare = _mm256_mul_pd(_mm256_set1_pd(0.5), _mm256_mul_pd(f, f));
+			// e * ln2_hi - ((halfSquare - (s * (halfSquare + r) + e * ln2_lo)) - f)
+			__m256d correction = _mm256_fmadd_pd(s, _mm256_add_pd(halfSquare, r), _mm256_mul_pd(e, _mm256_set1_pd(1.90821492927058770002e-10)));
+			__m256d y = _mm256_fmsub_pd(e, _mm256_set1_pd(6.93147180369123816490e-01), _mm256_sub_pd(_mm256_sub_pd(halfSquare, correction), f));
+
+			const __m256d zero = _mm256_setzero_pd();
+			const __m256d infinity = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+			y = _mm256_blendv_pd(y, _mm256_set1_pd(-std::numeric_limits<double>::infinity()), _mm256_cmp_pd(x, zero, _CMP_EQ_OQ));
+			y = _mm256_blendv_pd(y, infinity, _mm256_cmp_pd(x, infinity, _CMP_EQ_OQ));
+			return _mm256_blendv_pd(y, _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN()), _mm256_cmp_pd(x, zero, _CMP_NGE_UQ));
+		}
+	};
+
+	/**
+	 * Computes sin(x) or cos(x) for eight floats (Cephes polynomials after reducing by pi/2 in double precision, within 1 ulp
+	 * of the exact result for |x| <= 8192, larger inputs fall back to std::sin and std::cos)
+	 */
+	struct SinCosFloat {
+	private:
+		/**
+		 * Reduces four angles to [-pi/4, pi/4] in double precision
+		 * @param x The angles
+		 * @param reduced Where to store the reduced angles rounded to float
+		 * @param tail Where to store what rounding the reduced angles to float lost
+		 * @param quadrant Where to store the number of quarter turns subtracted
+		 */
+		__attribute__((target("avx2,fma"))) static inline void reduce(__m128 x, __m128& reduced, __m128& tail, __m128i& quadrant) {
+			__m256d angle = _mm256_cvtps_pd(x);
+			__m256d k = _mm256_round_pd(_mm256_mul_pd(angle, _mm256_set1_pd(6.36619772367581382433e-01)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+			__m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(1.57079632673412561417e+00), angle);
+			r = _mm256_fnmadd_pd(k, _mm256_set1_pd(6.07710050650619224932e-11), r);
+			reduced = _mm256_cvtpd_ps(r);
+			tail = _mm256_cvtpd_ps(_mm256_sub_pd(r, _mm256_cvtps_pd(reduced)));
+			quadrant = _mm256_cvtpd_epi32(k);
+		}
+
+	public:
+		/**
+		 * Whether to compute cosine instead of sine
+		 */
+		bool cosine;
+
+		/**
+		 * Computes the function
+		 * @param x The inputs
+		 * @returns The results
+		 */
+		__attribute__((target("avx2,fma"))) inline __m256 operator()(__m256 x) const {
+			__m256 magnitude = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+			if (_mm256_movemask_ps(_mm256_cmp_ps(magnitude, _mm256_set1_ps(8192.0f), _CMP_NLE_UQ)) != 0) {
+				alignas(32) float lanes[8];
+				_mm256_store_ps(lanes, x);
+				for (float& lane : lanes)
+					lane = cosine ? std::cos(lane) : std::sin(lane);
+				return _mm256_load_ps(lanes);
+			}
+
+			__m128 lowReduced, highReduced, lowTail, highTail;
+			__m128i lowQuadrant, highQuadrant;
+			reduce(_mm256_castps256_ps128(x), lowReduced, lowTail, lowQuadrant);
+			reduce(_mm256_extractf128_ps(x, 1), highReduced, highTail, highQuadrant);
+			__m256 r = _mm256_set_m128(highReduced, lowReduced);
+			__m256 tail = _mm256_set_m128(highTail, lowTail);
+			__m256i quadrant = _mm256_add_epi32(_mm256_set_m128i(highQuadrant, lowQuadrant), _mm256_set1_epi32(cosine ? 1 : 0));
+
+			// sin(r + tail) = sin(r) + tail * cos(r) and cos(r + tail) = cos(r) - tail * sin(r) to first order
+			__m256 z = _mm256_mul_ps(r, r);
+			__m256 halfZ = _mm256_mul_ps(_mm256_set1_ps(0.5f), z);
+			__m256 s = _mm256_fmadd_ps(_mm256_set1_ps(-1.9515295891E-4f), z, _mm256_set1_ps(8.3321608736E-3f));
+			s = _mm256_fmadd_ps(s, z, _mm256_set1_ps(-1.6666654611E-1f));
+			s = _mm256_fmadd_ps(tail, _mm256_sub_ps(_mm256_set1_ps(1.0f), halfZ), _mm256_mul_ps(_mm256_mul_ps(s, z), r));
+			s = _mm256_add_ps(r, s);
+			__m256 c = _mm256_fmadd_ps(_mm256_set1_ps(2.443315711809948E-5f), z, _mm256_set1_ps(-1.388731625493765E-3f));
+			c = _mm256_fmadd_ps(c, z, _mm256_set1_ps(4.166664568298827E-2f));
+			__m256 w = _mm256_sub_ps(_mm256_set1_ps(1.0f), halfZ);
+			__m256 lost = _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), w), halfZ);
+			c = _mm256_add_ps(w, _mm256_fnmadd_ps(r, tail, _mm256_fmadd_ps(_mm256_mul_ps(c, z), z, lost)));
+
+			__m256 useCos = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+			__m256 sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(2)), 30));
+			return _mm256_xor_ps(_mm256_blendv_ps(s, c, useCos), sign);
+		}
+	};
+
+	/**
+	 * Computes sin(x) or cos(x) for four doubles (fdlibm polynomials after reducing by pi/2 with a tail term, within 1 ulp of
+	 * the exact result for |x| <= 1e5, larger inputs fall back to std::sin and std::cos)
+	 */
+	struct SinCosDouble {
+		/**
+		 * Whether to compute cosine instead of sine
+		 */
+		bool cosine;
+
+		/**
+		 * Computes the function
+		 * @param x The inputs
+		 * @returns The results
+		 */
+		__attribute__((target("avx2,fma"))) inline __m256d operator()(__m256d x) const {
+			__m256d magnitude = _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+			if (_mm256_movemask_pd(_mm256_cmp_pd(magnitude, _mm256_set1_pd(1e5), _CMP_NLE_UQ)) != 0) {
+				alignas(32) double lanes[4];
+				_mm256_store_pd(lanes, x);
+				for (double& lane : lanes)
+					lane = cosine ? std::cos(lane) : std::sin(lane);
+				return _mm256_load_pd(lanes);
+			}
+
+			// Reduce to r + tail with the first product exact (pio2_1 has 33 bits) and the rounding errors of the rest kept
+			__m256d k = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(6.36619772367581382433e-01)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+			__m256d first = _mm256_fnmadd_pd(k, _mm256_set1_pd(1.57079632673412561417e+00), x);
+			__m256d product = _mm256_mul_pd(k, _mm256_set1_pd(6.07710050630396597660e-11));
+			__m256d productError = _mm256_fmsub_pd(k, _mm256_set1_pd(6.07710050630396597660e-11), product);
+			__m256d second = _mm256_sub_pd(first, product);
+			__m256d tail = _mm256_sub_pd(_mm256_sub_pd(_mm256_sub_pd(first, second), product), productError);
+			tail = _mm256_fnmadd_pd(k, _mm256_set1_pd(2.02226624871116645580e-21), tail);
+			__m256d r = _mm256_add_pd(second, tail);
+			tail = _mm256_add_pd(_mm256_sub_pd(second, r), tail);
+			// The low bits of k + 2^52 + 2^51 hold k as an integer
+			__m256i quadrant = _mm256_castpd_si256(_mm256_add_pd(k, _mm256_set1_pd(0x1.8p52)));
+			quadrant = _mm256_add_epi64(quadrant, _mm256_set1_epi64x(cosine ? 1 : 0));
+
+			// sin(r + tail) = sin(r) + tail * cos(r) and cos(r + tail) = cos(r) - tail * sin(r) to first order
+			__m256d z = _mm256_mul_pd(r, r);
+			__m256d halfZ = _mm256_mul_pd(_mm256_set1_pd(0.5), z);
+			__m256d s = _mm256_fmadd_pd(_mm256_set1_pd(1.58969099521155010221e-10), z, _mm256_set1_pd(-2.50507602534068634195e-08));
+			s = _mm256_fmadd_pd(s, z, _mm256_set1_pd(2.75573137070700676789e-06));
+			s = _mm256_fmadd_pd(s, z, _mm256_set1_pd(-1.98412698298579493134e-04));
+			s = _mm256_fmadd_pd(s, z, _mm256_set1_pd(8.33333333332248946124e-03));
+			s = _mm256_fmadd_pd(s, z, _mm256_set1_pd(-1.66666666666666324348e-01));
+			s = _mm256_fmadd_pd(tail, _mm256_sub_pd(_mm256_set1_pd(1.0), halfZ), _mm256_mul_pd(_mm256_mul_pd(s, z), r));
+			s = _mm256_add_pd(r, s);
+			__m256d c = _mm256_fmadd_pd(_mm256_set1_pd(-1.13596475577881948265e-11), z, _mm256_set1_pd(2.08757232129817482790e-09));
+			c = _mm256_fmadd_pd(c, z, _mm256_set1_pd(-2.75573143513906633035e-07));
+			c = _mm256_fmadd_pd(c, z, _mm256_set1_pd(2.48015872894767294178e-05));
+			c = _mm256_fmadd_pd(c, z, _mm256_set1_pd(-1.38888888888741095749e-03));
+			c = _mm256_fmadd_pd(c, z, _mm256_set1_pd(4.16666666666666019037e-02));
+			// 1 - z / 2 loses the low bits of z / 2, so add them back as in fdlibm
+			__m256d w = _mm256_sub_pd(_mm256_set1_pd(1.0), halfZ);
+			__m256d lost = _mm256_sub_pd(_mm256_sub_pd(_mm256_set1_pd(1.0), w), halfZ);
+			c = _mm256_add_pd(w, _mm256_fnmadd_pd(r, tail, _mm256_fmadd_pd(_mm256_mul_pd(c, z), z, lost)));
+
+			const __m256i one = _mm256_set1_epi64x(1);
+			__m256d useCos = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(quadrant, one), one));
+			__m256d sign = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(quadrant, _mm256_set1_epi64x(2)), 62));
+			__m256d result = _mm256_xor_pd(_mm256_blendv_pd(s, c, useCos), sign);
+			// The reduction turns -0 into +0, and below 2^-27 sin(x) rounds to x anyway, so return those inputs as they are
+			if (!cosine)
+				result = _mm256_blendv_pd(result, x, _mm256_cmp_pd(magnitude, _mm256_set1_pd(0x1p-27), _CMP_LT_OQ));
+			return result;
+		}
+	};
+
+	/**
+	 * Applies an eight lane float function to an array, the remainder goes through a padded register
+	 * @param in The inputs
+	 * @param out Where to store the results (may be in)
+	 * @param count The number of elements
+	 * @param function The function
+	 */
+	template<typename F>
+	__attribute__((target("avx2,fma"))) void mapAvx2(const float* in, float* out, size_t count, F function) {
+		size_t i = 0;
+		for (; count - i >= 8; i += 8)
+			_mm256_storeu_ps(out + i, function(_mm256_loadu_ps(in + i)));
+		if (i < count) {
+			alignas(32) float lanes[8] = {};
+			for (size_t j = i; j < count; j++)
+				lanes[j - i] = in[j];
+			_mm256_store_ps(lanes, function(_mm256_load_ps(lanes)));
+			for (size_t j = i; j < count; j++)
+				out[j] = lanes[j - i];
+		}
+	}
+
+	/**
+	 * Applies a four lane double function to an array, the remainder goes through a padded register
+	 * @param in The inputs
+	 * @param out Where to store the results (may be in)
+	 * @param count The number of elements
+	 * @param function The function
+	 */
+	template<typename F>
+	__attribute__((target("avx2,fma"))) void mapAvx2(const double* in, double* out, size_t count, F function) {
+		size_t i = 0;
+		for (; count - i >= 4; i += 4)
+			_mm256_storeu_pd(out + i, function(_mm256_loadu_pd(in + i)));
+		if (i < count) {
+			alignas(32) double lanes[4] = {};
+			for (size_t j = i; j < count; j++)
+				lanes[j - i] = in[j];
+			_mm256_store_pd(lanes, function(_mm256_load_pd(lanes)));
+			for (size_t j = i; j < count; j++)
+				out[j] = lanes[j - i];
+		}
+	}
+#endif
+
+	/**
+	 * Applies a function to every element of an array, running the AVX2 kernel for float and double when the cpu
+	 * supports it and the scalar function otherwise, split across threads for large arrays
+	 * @param in The inputs
+	 * @param out Where to store the results (may be in)
+	 * @param count The number of elements
+	 * @param kernel The AVX2 kernel (only used if the target has them)
+	 * @param scalar The scalar function
+	 * @param pool The pool to run on
+	 */
+	template<typename T, typename K, typename S>
+	void mapElements(const T* in, T* out, size_t count, K kernel, S scalar, Threading::ThreadPool& pool) {
+		Threading::parallelFor(0, count, [&](size_t first, size_t last) {
+#ifdef ESSENTIALS_MATH_AVX2
+			if (cpuSupportsFma()) {
+				mapAvx2(in + first, out + first, last - first, kernel);
+				return;
+			}
+#else
+			(void) kernel;
+#endif
+			for (size_t i = first; i < last; i++)
+				out[i] = scalar(in[i]);
+		}, elementwiseGrain, pool);
+	}
+
+	/**
+	 * Computes e^x for every element of an array
+	 * With AVX2 the results are within 1 ulp of the exact result (1.01 ulp for float), without it std::exp is used
+	 * @param in The inputs
+	 * @param out Where to store the results (may be in)
+	 * @param count The number of elements
+	 * @param pool The pool large arrays are split across
+	 */
+	template<typename T>
+	void exp(const T* in, T* out, size_t count, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "Elementwise exp needs float or double elements");
+#ifdef ESSENTIALS_MATH_AVX2
+		using Kernel = std::conditional_t<std::is_same_v<T, float>, ExpFloat, ExpDouble>;
+#else
+		using Kernel = int;
+#endif
+		mapElements(in, out, count, Kernel(), [](T value) { return std::exp(value); }, pool);
+	}
+
+	/**
+	 * Computes ln(x) for every element of an array
+	 * With AVX2 the results are within 1 ulp of the exact result, without it std::log is used
+	 * @param in The inputs
+	 * @param out Where to store the results (may be in)
+	 * @param count The number of elements
+	 * @param pool The pool large arrays are split across
+	 */
+	template<typename T>
+	void log(const T* in, T* out, size_t count, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "Elementwise log needs float or double elements");
+#ifdef ESSENTIALS_MATH_AVX2
+		using Kernel = std::conditional_t<std::is_same_v<T, float>, LogFloat, LogDouble>;
+#else
+		using Kernel = int;
+#endif
+		mapElements(in, out, count, Kernel(), [](T value) { return std::log(value); }, pool);
+	}
+
+	/**
+	 * Computes sin(x) for every element of an array
+	 * With AVX2 the results are within 1 ulp of the exact result (beyond |x| of 8192 for float and 1e5 for double std::sin
+	 * is used), without it std::sin is used
+	 * @param in The inputs
+	 * @param out Where to store the results (may be in)
+	 * @param count The number of elements
+	 * @param pool The pool large arrays are split across
+	 */
+	template<typename T>
+	void sin(const T* in, T* out, size_t count, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "Elementwise sin needs float or double elements");
+#ifdef ESSENTIALS_MATH_AVX2
+		using Kernel = std::conditional_t<std::is_same_v<T, float>, SinCosFloat, SinCosDouble>;
+		mapElements(in, out, count, Kernel{ false }, [](T value) { return std::sin(value); }, pool);
+#else
+		mapElements(in, out, count, 0, [](T value) { return std::sin(value); }, pool);
+#endif
+	}
+
+	/**
+	 * Computes cos(x) for every element of an array
+	 * With AVX2 the results are within 1 ulp of the exact result (beyond |x| of 8192 for float and 1e5 for double std::cos
+	 * is used), without it std::cos is used
+	 * @param in The inputs
+	 * @param out Where to store the results (may be in)
+	 * @param count The number of elements
+	 * @param pool The pool large arrays are split across
+	 */
+	template<typename T>
+	void cos(const T* in, T* out, size_t count, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "Elementwise cos needs float or double elements");
+#ifdef ESSENTIALS_MATH_AVX2
+		using Kernel = std::conditional_t<std::is_same_v<T, float>, SinCosFloat, SinCosDouble>;
+		mapElements(in, out, count, Kernel{ true }, [](T value) { return std::cos(value); }, pool);
+#else
+		mapElements(in, out, count, 0, [](T value) { return std::cos(value); }, pool);
+#endif
+	}
+
+	/**
+	 * Computes the square root of every element of an array (correctly rounded)
+	 * @param in The inputs
+	 * @param out Where to store the results (may be in)
+	 * @param count The number of elements
+	 * @param pool The pool large arrays are split across
+	 */
+	template<typename T>
+	void sqrt(const T* in, T* out, size_t count, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		static_assert(std::is_floating_point_v<T>, "Elementwise sqrt needs floating point elements");
+		using Pack = SimdPack<T, simdMaxWidth<T>>;
+		Threading::parallelFor(0, count, [&](size_t first, size_t last) {
+			size_t i = first;
+			if constexpr (Pack::native)
+				for (; last - i >= Pack::width; i += Pack::width)
+					Pack::store(out + i, Pack::sqrt(Pack::load(in + i)));
+			for (; i < last; i++)
+				out[i] = std::sqrt(in[i]);
+		}, elementwiseGrain, pool);
+	}
+
+	/**
+	 * Limits every element of an array to a range
+	 * @param in The inputs
+	 * @param out Where to store the results (may be in)
+	 * @param count The number of elements
+	 * @param low The smallest allowed value
+	 * @param high The largest allowed value
+	 * @param pool The pool large arrays are split across
+	 */
+	template<typename T>
+	void clamp(const T* in, T* out, size_t count, T low, T high, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		using Pack = SimdPack<T, simdMaxWidth<T>>;
+		Threading::parallelFor(0, count, [&](size_t first, size_t last) {
+			size_t i = first;
+			if constexpr (Pack::native) {
+				typename Pack::Register lowRegister = Pack::broadcast(low);
+				typename Pack::Register highRegister = Pack::broadcast(high);
+				for (; last - i >= Pack::width; i += Pack::width)
+					Pack::store(out + i, Pack::min(Pack::max(Pack::load(in + i), lowRegister), highRegister));
+			}
+			for (; i < last; i++)
+				out[i] = in[i] < low ? low : high < in[i] ? high : in[i];
+		}, elementwiseGrain, pool);
+	}
+
+	/**
+	 * Reduces an array in fixed blocks (split across threads) and combines the block results in order, so the result does
+	 * not depend on the number of threads
+	 * @param count The number of elements
+	 * @param identity The result for an empty array
+	 * @param block Reduces a block, called as block(first, last)
+	 * @param combine Combines two results
+	 * @param pool The pool to run on
+	 * @returns The result
+	 */
+	template<typename T, typename B, typename C>
+	T reduceBlocks(size_t count, T identity, B block, C combine, Threading::ThreadPool& pool) {
+		if (count == 0) return identity;
+		size_t blocks = (count + elementwiseGrain - 1) / elementwiseGrain;
+		if (blocks == 1) return block(0, count);
+		DataStructures::ArrayList<T> partial;
+		partial.resize(blocks);
+		Threading::parallelFor(0, blocks, [&](size_t first, size_t last) {
+			for (size_t i = first; i < last; i++)
+				partial[i] = block(i * elementwiseGrain, i == blocks - 1 ? count : (i + 1) * elementwiseGrain);
+		}, 1, pool);
+		T result = partial[0];
+		for (size_t i = 1; i < blocks; i++)
+			result = combine(result, partial[i]);
+		return result;
+	}
+
+	/**
+	 * Adds the elements of an array, using several registers of partial sums
+	 * @param values The elements
+	 * @param count The number of elements
+	 * @param pool The pool large arrays are split across
+	 * @returns The sum
+	 */
+	template<typename T>
+	T sum(const T* values, size_t count, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		using Pack = SimdPack<T, simdMaxWidth<T>>;
+		return reduceBlocks(count, T(), [&](size_t first, size_t last) {
+			T total = T();
+			size_t i = first;
+			if constexpr (Pack::native) {
+				constexpr size_t width = Pack::width;
+				typename Pack::Register sum0 = Pack::broadcast(T()), sum1 = sum0, sum2 = sum0, sum3 = sum0;
+				for (; last - i >= width * 4; i += width * 4) {
+					sum0 = Pack::add(sum0, Pack::load(values + i));
+					sum1 = Pack::add(sum1, Pack::load(values + i + width));
+					sum2 = Pack::add(sum2, Pack::load(values + i + width * 2));
+					sum3 = Pack::add(sum3, Pack::load(values + i + width * 3));
+				}
+				for (; last - i >= width; i += width)
+					sum0 = Pack::add(sum0, Pack::load(values + i));
+				total = Pack::sum(Pack::add(Pack::add(sum0, sum1), Pack::add(sum2, sum3)));
+			}
+			for (; i < last; i++)
+				total += values[i];
+			return total;
+		}, std::plus<>(), pool);
+	}
+
+	/**
+	 * Computes the dot product of two arrays, using several registers of partial sums
+	 * @param a The first array
+	 * @param b The second array
+	 * @param count The number of elements in each array
+	 * @param pool The pool large arrays are split across
+	 * @returns The dot product
+	 */
+	template<typename T>
+	T dot(const T* a, const T* b, size_t count, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		using Pack = SimdPack<T, simdMaxWidth<T>>;
+		return reduceBlocks(count, T(), [&](size_t first, size_t last) {
+			T total = T();
+			size_t i = first;
+			if constexpr (Pack::native) {
+				constexpr size_t width = Pack::width;
+				typename Pack::Register sum0 = Pack::broadcast(T()), sum1 = sum0, sum2 = sum0, sum3 = sum0;
+				for (; last - i >= width * 4; i += width * 4) {
+					sum0 = Pack::multiplyAdd(Pack::load(a + i), Pack::load(b + i), sum0);
+					sum1 = Pack::multiplyAdd(Pack::load(a + i + width), Pack::load(b + i + width), sum1);
+					sum2 = Pack::multiplyAdd(Pack::load(a + i + width * 2), Pack::load(b + i + width * 2), sum2);
+					sum3 = Pack::multiplyAdd(Pack::load(a + i + width * 3), Pack::load(b + i + width * 3), sum3);
+				}
+				for (; last - i >= width; i += width)
+					sum0 = Pack::multiplyAdd(Pack::load(a + i), Pack::load(b + i), sum0);
+				total = Pack::sum(Pack::add(Pack::add(sum0, sum1), Pack::add(sum2, sum3)));
+			}
+			for (; i < last; i++)
+				total += a[i] * b[i];
+			return total;
+		}, std::plus<>(), pool);
+	}
+
+	/**
+	 * Finds the smallest element of an array (NaN elements give an unspecified result)
+	 * @param values The elements
+	 * @param count The number of elements
+	 * @param pool The pool large arrays are split across
+	 * @returns The smallest element (infinity, or the largest value for integers, if the array is empty)
+	 */
+	template<typename T>
+	T min(const T* values, size_t count, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		using Pack = SimdPack<T, simdMaxWidth<T>>;
+		T identity = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+		auto smaller = [](T a, T b) { return b < a ? b : a; };
+		return reduceBlocks(count, identity, [&](size_t first, size_t last) {
+			T result = values[first];
+			size_t i = first;
+			if constexpr (Pack::native) {
+				typename Pack::Register best = Pack::broadcast(result);
+				for (; last - i >= Pack::width; i += Pack::width)
+					best = Pack::min(best, Pack::load(values + i));
+				alignas(64) T lanes[Pack::width];
+				Pack::store(lanes, best);
+				for (T lane : lanes)
+					result = smaller(result, lane);
+			}
+			for (; i < last; i++)
+				result = smaller(result, values[i]);
+			return result;
+		}, smaller, pool);
+	}
+
+	/**
+	 * Finds the largest element of an array (NaN elements give an unspecified result)
+	 * @param values The elements
+	 * @param count The number of elements
+	 * @param pool The pool large arrays are split across
+	 * @returns The largest element (-infinity, or the smallest value for integers, if the array is empty)
+	 */
+	template<typename T>
+	T max(const T* values, size_t count, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		using Pack = SimdPack<T, simdMaxWidth<T>>;
+		T identity = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+		auto larger = [](T a, T b) { return a < b ? b : a; };
+		return reduceBlocks(count, identity, [&](size_t first, size_t last) {
+			T result = values[first];
+			size_t i = first;
+			if constexpr (Pack::native) {
+				typename Pack::Register best = Pack::broadcast(result);
+				for (; last - i >= Pack::width; i += Pack::width)
+					best = Pack::max(best, Pack::load(values + i));
+				alignas(64) T lanes[Pack::width];
+				Pack::store(lanes, best);
+				for (T lane : lanes)
+					result = larger(result, lane);
+			}
+			for (; i < last; i++)
+				result = larger(result, values[i]);
+			return result;
+		}, larger, pool);
+	}
+
+	/**
+	 * Computes e^x for every element of a list, in place
+	 * @param list The list
+	 * @param pool The pool large lists are split across
+	 */
+	template<typename T, typename A, size_t I>
+	void exp(DataStructures::ArrayList<T, A, I>& list, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		exp(list.data(), list.data(), list.length(), pool);
+	}
+
+	/**
+	 * Computes ln(x) for every element of a list, in place
+	 * @param list The list
+	 * @param pool The pool large lists are split across
+	 */
+	template<typename T, typename A, size_t I>
+	void log(DataStructures::ArrayList<T, A, I>& list, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		log(list.data(), list.data(), list.length(), pool);
+	}
+
+	/**
+	 * Computes sin(x) for every element of a list, in place
+	 * @param list The list
+	 * @param pool The pool large lists are split across
+	 */
+	template<typename T, typename A, size_t I>
+	void sin(DataStructures::ArrayList<T, A, I>& list, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		sin(list.data(), list.data(), list.length(), pool);
+	}
+
+	/**
+	 * Computes cos(x) for every element of a list, in place
+	 * @param list The list
+	 * @param pool The pool large lists are split across
+	 */
+	template<typename T, typename A, size_t I>
+	void cos(DataStructures::ArrayList<T, A, I>& list, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		cos(list.data(), list.data(), list.length(), pool);
+	}
+
+	/**
+	 * Computes the square root of every element of a list, in place
+	 * @param list The list
+	 * @param pool The pool large lists are split across
+	 */
+	template<typename T, typename A, size_t I>
+	void sqrt(DataStructures::ArrayList<T, A, I>& list, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		sqrt(list.data(), list.data(), list.length(), pool);
+	}
+
+	/**
+	 * Limits every element of a list to a range, in place
+	 * @param list The list
+	 * @param low The smallest allowed value
+	 * @param high The largest allowed value
+	 * @param pool The pool large lists are split across
+	 */
+	template<typename T, typename A, size_t I>
+	void clamp(DataStructures::ArrayList<T, A, I>& list, T low, T high, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		clamp(list.data(), list.data(), list.length(), low, high, pool);
+	}
+
+	/**
+	 * Adds the elements of a list
+	 * @param list The list
+	 * @param pool The pool large lists are split across
+	 * @returns The sum
+	 */
+	template<typename T, typename A, size_t I>
+	T sum(const DataStructures::ArrayList<T, A, I>& list, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		return sum(list.data(), list.length(), pool);
+	}
+
+	/**
+	 * Computes the dot product of two lists
+	 * @param a The first list
+	 * @param b The second list (with the same length)
+	 * @param pool The pool large lists are split across
+	 * @returns The dot product
+	 */
+	template<typename T, typename A, size_t I, typename B, size_t J>
+	T dot(const DataStructures::ArrayList<T, A, I>& a, const DataStructures::ArrayList<T, B, J>& b, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		assert(a.length() == b.length());
+		return dot(a.data(), b.data(), a.length(), pool);
+	}
+
+	/**
+	 * Finds the smallest element of a list
+	 * @param list The list
+	 * @param pool The pool large lists are split across
+	 * @returns The smallest element
+	 */
+	template<typename T, typename A, size_t I>
+	T min(const DataStructures::ArrayList<T, A, I>& list, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		return min(list.data(), list.length(), pool);
+	}
+
+	/**
+	 * Finds the largest element of a list
+	 * @param list The list
+	 * @param pool The pool large lists are split across
+	 * @returns The largest element
+	 */
+	template<typename T, typename A, size_t I>
+	T max(const DataStructures::ArrayList<T, A, I>& list, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		return max(list.data(), list.length(), pool);
+	}
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
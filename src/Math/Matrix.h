@@ -0,0 +1,1761 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "Simd.h"
+#include "../DataStructures/ArrayList.h"
+#include "../DataStructures/Allocator.h"
+#include "../DataStructures/Memory.h"
+#include "../Threading/Parallel.h"
+#include <assert.h>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+/**
+ * The namespace for math in the essentials library
+ */
+namespace Essentials::Math {
+
+	/**
+	 * A namespace alias to the math namespace
+	 */
+	namespace ma = Math;
+
+	/**
+	 * The dimension of a matrix whose size is chosen at runtime
+	 */
+	inline constexpr size_t dynamic = 0;
+
+	/**
+	 * A row major matrix, sized at compile time or (with both dimensions dynamic) at runtime
+	 */
+	template<typename T, size_t Rows = dynamic, size_t Columns = dynamic> class Matrix;
+
+	template<typename T> class MatrixProduct;
+
+	template<typename T, typename E> class MatrixProductSum;
+
+	/**
+	 * The block sizes used to multiply matrices of an element type
+	 * A depth x nr sliver of B stays in L1, an mc x kc block of A in L2 and a kc x nc panel of B in L3
+	 */
+	template<typename T> struct GemmBlocking {
+		/**
+		 * The number of rows of C computed by one kernel call
+		 */
+		static constexpr size_t mr = 6;
+
+		/**
+		 * The number of columns of C computed by one kernel call (two AVX registers for float and double)
+		 */
+		static constexpr size_t nr = std::is_same_v<T, float> ? 16 : std::is_same_v<T, double> ? 8 : 4;
+
+		/**
+		 * The depth of the packed blocks
+		 */
+		static constexpr size_t kc = 256;
+
+		/**
+		 * The largest number of rows of A packed at once (a multiple of mr)
+		 */
+		static constexpr size_t mc = 72;
+
+		/**
+		 * The largest number of columns of B packed at once (a multiple of nr)
+		 */
+		static constexpr size_t nc = 4080;
+	};
+
+	/**
+	 * Packs a block of A into panels of mr rows, each stored column by column (padded with zeros)
+	 * @param a The first element of the block
+	 * @param lda The distance between rows of A
+	 * @param rows The number of rows in the block
+	 * @param depth The number of columns in the block
+	 * @param packed Where to store the panels
+	 */
+	template<typename T> void gemmPackA(const T* a, size_t lda, size_t rows, size_t depth, T* packed) {
+		constexpr size_t mr = GemmBlocking<T>::mr;
+		for (size_t i = 0; i < rows; i += mr) {
+			size_t height = rows - i < mr ? rows - i : mr;
+			for (size_t k = 0; k < depth; k++) {
+				for (size_t r = 0; r < height; r++)
+					packed[r] = a[(i + r) * lda + k];
+				for (size_t r = height; r < mr; r++)
+					packed[r] = T();
+				packed += mr;
+			}
+		}
+	}
+
+	/**
+	 * Packs a panel of B into slivers of nr columns, each stored row by row (padded with zeros)
+	 * @param b The first element of the panel
+	 * @param ldb The distance between rows of B
+	 * @param depth The number of rows in the panel
+	 * @param columns The number of columns in the panel
+	 * @param packed Where to store the slivers
+	 */
+	template<typename T> void gemmPackB(const T* b, size_t ldb, size_t depth, size_t columns, T* packed) {
+		constexpr size_t nr = GemmBlocking<T>::nr;
+		for (size_t j = 0; j < columns; j += nr) {
+			size_t width = columns - j < nr ? columns - j : nr;
+			for (size_t k = 0; k < depth; k++) {
+				const T* row = b + k * ldb + j;
+				for (size_t c = 0; c < width; c++)
+					packed[c] = row[c];
+				for (size_t c = width; c < nr; c++)
+					packed[c] = T();
+				packed += nr;
+			}
+		}
+	}
+
+	/**
+	 * Adds a computed tile to part of C
+	 * @param tile The tile, stored row by row with nr columns
+	 * @param c The first element of C to add to
+	 * @param ldc The distance between rows of C
+	 * @param rows The number of rows to add
+	 * @param columns The number of columns to add
+	 */
+	template<typename T, size_t NR> void gemmAddTile(const T* tile, T* c, size_t ldc, size_t rows, size_t columns) {
+		for (size_t r = 0; r < rows; r++)
+			for (size_t j = 0; j < columns; j++)
+				c[r * ldc + j] += tile[r * NR + j];
+	}
+
+	/**
+	 * Multiplies a packed panel of A by a packed sliver of B and adds the result to C (portable kernel)
+	 * @param depth The shared dimension of the panels
+	 * @param a The packed panel of A (mr rows)
+	 * @param b The packed sliver of B (nr columns)
+	 * @param c The first element of C to add to
+	 * @param ldc The distance between rows of C
+	 * @param rows The number of rows of C to update (at most mr)
+	 * @param columns The number of columns of C to update (at most nr)
+	 */
+	template<typename T, size_t MR, size_t NR>
+	void gemmKernel(size_t depth, const T* a, const T* b, T* c, size_t ldc, size_t rows, size_t columns) {
+		T sums[MR * NR] = {};
+		for (size_t k = 0; k < depth; k++, a += MR, b += NR)
+			for (size_t r = 0; r < MR; r++)
+				for (size_t j = 0; j < NR; j++)
+					sums[r * NR + j] += a[r] * b[j];
+		gemmAddTile<T, NR>(sums, c, ldc, rows, columns);
+	}
+
+#ifdef ESSENTIALS_MATH_AVX2
+	/**
+	 * Multiplies a packed 6 row panel of A by a packed 16 column sliver of B and adds the result to C (AVX2 and FMA)
+	 * @param depth The shared dimension of the panels
+	 * @param a The packed panel of A
+	 * @param b The packed sliver of B (aligned to 32 bytes)
+	 * @param c The first element of C to add to
+	 * @param ldc The distance between rows of C
+	 * @param rows The number of rows of C to update (at most 6)
+	 * @param columns The number of columns of C to update (at most 16)
+	 */
+	__attribute__((target("avx2,fma"))) inline void gemmKernelFloat(size_t depth, const float* a, const float* b, float* c, size_t ldc, size_t rows, size_t columns) {
+		__m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+		__m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+		__m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+		__m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+		__m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+		__m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+		for (size_t k = 0; k < depth; k++, a += 6, b += 16) {
+			__m256 b0 = _mm256_load_ps(b);
+			__m256 b1 = _mm256_load_ps(b + 8);
+			__m256 value = _mm256_broadcast_ss(a);
+			c00 = _mm256_fmadd_ps(value, b0, c00);
+			c01 = _mm256_fmadd_ps(value, b1, c01);
+			value = _mm256_broadcast_ss(a + 1);
+			c10 = _mm256_fmadd_ps(value, b0, c10);
+			c11 = _mm256_fmadd_ps(value, b1, c11);
+			value = _mm256_broadcast_ss(a + 2);
+			c20 = _mm256_fmadd_ps(value, b0, c20);
+			c21 = _mm256_fmadd_ps(value, b1, c21);
+			value = _mm256_broadcast_ss(a + 3);
+			c30 = _mm256_fmadd_ps(value, b0, c30);
+			c31 = _mm256_fmadd_ps(value, b1, c31);
+			value = _mm256_broadcast_ss(a + 4);
+			c40 = _mm256_fmadd_ps(value, b0, c40);
+			c41 = _mm256_fmadd_ps(value, b1, c41);
+			value = _mm256_broadcast_ss(a + 5);
+			c50 = _mm256_fmadd_ps(value, b0, c50);
+			c51 = _mm256_fmadd_ps(value, b1, c51);
+		}
+
+		if (rows == 6 && columns == 16) {
+			float* row = c;
+			_mm256_storeu_ps(row, _mm256_add_ps(_mm256_loadu_ps(row), c00));
+			_mm256_storeu_ps(row + 8, _mm256_add_ps(_mm256_loadu_ps(row + 8), c01));
+			row += ldc;
+			_mm256_storeu_ps(row, _mm256_add_ps(_mm256_loadu_ps(row), c10));
+			_mm256_storeu_ps(row + 8, _mm256_add_ps(_mm256_loadu_ps(row + 8), c11));
+			row += ldc;
+			_mm256_storeu_ps(row, _mm256_add_ps(_mm256_loadu_ps(row), c20));
+			_mm256_storeu_ps(row + 8, _mm256_add_ps(_mm256_loadu_ps(row + 8), c21));
+			row += ldc;
+			_mm256_storeu_ps(row, _mm256_add_ps(_mm256_loadu_ps(row), c30));
+			_mm256_storeu_ps(row + 8, _mm256_add_ps(_mm256_loadu_ps(row + 8), c31));
+			row += ldc;
+			_mm256_storeu_ps(row, _mm256_add_ps(_mm256_loadu_ps(row), c40));
+			_mm256_storeu_ps(row + 8, _mm256_add_ps(_mm256_loadu_ps(row + 8), c41));
+			row += ldc;
+			_mm256_storeu_ps(row, _mm256_add_ps(_mm256_loadu_ps(row), c50));
+			_mm256_storeu_ps(row + 8, _mm256_add_ps(_mm256_loadu_ps(row + 8), c51));
+			return;
+		}
+
+		// Partial tiles at the edges of C go through a buffer
+		alignas(32) float tile[6 * 16];
+		_mm256_store_ps(tile, c00);
+		_mm256_store_ps(tile + 8, c01);
+		_mm256_store_ps(tile + 16, c10);
+		_mm256_store_ps(tile + 24, c11);
+		_mm256_store_ps(tile + 32, c20);
+		_mm256_store_ps(tile + 40, c21);
+		_mm256_store_ps(tile + 48, c30);
+		_mm256_store_ps(tile + 56, c31);
+		_mm256_store_ps(tile + 64, c40);
+		_mm256_store_ps(tile + 72, c41);
+		_mm256_store_ps(tile + 80, c50);
+		_mm256_store_ps(tile + 88, c51);
+		gemmAddTile<float, 16>(tile, c, ldc, rows, columns);
+	}
+
+	/**
+	 * Multiplies a packed 6 row panel of A by a packed 8 column sliver of B and adds the result to C (AVX2 and FMA)
+	 * @param depth The shared dimension of the panels
+	 * @param a The packed panel of A
+	 * @param b The packed sliver of B (aligned to 32 bytes)
+	 * @param c The first element of C to add to
+	 * @param ldc The distance between rows of C
+	 * @param rows The number of rows of C to update (at most 6)
+	 * @param columns The number of columns of C to update (at most 8)
+	 */
+	__attribute__((target("avx2,fma"))) inline void gemmKernelDouble(size_t depth, const double* a, const double* b, double* c, size_t ldc, size_t rows, size_t columns) {
+		__m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+		__m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+		__m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+		__m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+		__m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+		__m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+		for (size_t k = 0; k < depth; k++, a += 6, b += 8) {
+			__m256d b0 = _mm256_load_pd(b);
+			__m256d b1 = _mm256_load_pd(b + 4);
+			__m256d value = _mm256_broadcast_sd(a);
+			c00 = _mm256_fmadd_pd(value, b0, c00);
+			c01 = _mm256_fmadd_pd(value, b1, c01);
+			value = _mm256_broadcast_sd(a + 1);
+			c10 = _mm256_fmadd_pd(value, b0, c10);
+			c11 = _mm256_fmadd_pd(value, b1, c11);
+			value = _mm256_broadcast_sd(a + 2);
+			c20 = _mm256_fmadd_pd(value, b0, c20);
+			c21 = _mm256_fmadd_pd(value, b1, c21);
+			value = _mm256_broadcast_sd(a + 3);
+			c30 = _mm256_fmadd_pd(value, b0, c30);
+			c31 = _mm256_fmadd_pd(value, b1, c31);
+			value = _mm256_broadcast_sd(a + 4);
+			c40 = _mm256_fmadd_pd(value, b0, c40);
+			c41 = _mm256_fmadd_pd(value, b1, c41);
+			value = _mm256_broadcast_sd(a + 5);
+			c50 = _mm256_fmadd_pd(value, b0, c50);
+			c51 = _mm256_fmadd_pd(value, b1, c51);
+		}
+
+		if (rows == 6 && columns == 8) {
+			double* row = c;
+			_mm256_storeu_pd(row, _mm256_add_pd(_mm256_loadu_pd(row), c00));
+			_mm256_storeu_pd(row + 4, _mm256_add_pd(_mm256_loadu_pd(row + 4), c01));
+			row += ldc;
+			_mm256_storeu_pd(row, _mm256_add_pd(_mm256_loadu_pd(row), c10));
+			_mm256_storeu_pd(row + 4, _mm256_add_pd(_mm256_loadu_pd(row + 4), c11));
+			row += ldc;
+			_mm256_storeu_pd(row, _mm256_add_pd(_mm256_loadu_pd(row), c20));
+			_mm256_storeu_pd(row + 4, _mm256_add_pd(_mm256_loadu_pd(row + 4), c21));
+			row += ldc;
+			_mm256_storeu_pd(row, _mm256_add_pd(_mm256_loadu_pd(row), c30));
+			_mm256_storeu_pd(row + 4, _mm256_add_pd(_mm256_loadu_pd(row + 4), c31));
+			row += ldc;
+			_mm256_storeu_pd(row, _mm256_add_pd(_mm256_loadu_pd(row), c40));
+			_mm256_storeu_pd(row + 4, _mm256_add_pd(_mm256_loadu_pd(row + 4), c41));
+			row += ldc;
+			_mm256_storeu_pd(row, _mm256_add_pd(_mm256_loadu_pd(row), c50));
+			_mm256_storeu_pd(row + 4, _mm256_add_pd(_mm256_loadu_pd(row + 4), c51));
+			return;
+		}
+
+		// Partial tiles at the edges of C go through a buffer
+		alignas(32) double tile[6 * 8];
+		_mm256_store_pd(tile, c00);
+		_mm256_store_pd(tile + 4, c01);
+		_mm256_store_pd(tile + 8, c10);
+		_mm256_store_pd(tile + 12, c11);
+		_mm256_store_pd(tile + 16, c20);
+		_mm256_store_pd(tile + 20, c21);
+		_mm256_store_pd(tile + 24, c30);
+		_mm256_store_pd(tile + 28, c31);
+		_mm256_store_pd(tile + 32, c40);
+		_mm256_store_pd(tile + 36, c41);
+		_mm256_store_pd(tile + 40, c50);
+		_mm256_store_pd(tile + 44, c51);
+		gemmAddTile<double, 8>(tile, c, ldc, rows, columns);
+	}
+#endif
+
+	/**
+	 * Adds the product of two row major matrices to a third (C += A * B)
+	 *
+	 * B is packed a panel at a time and shared by every thread, each thread packs its own blocks of A and runs a
+	 * register tiled kernel over them (AVX2 and FMA for float and double when the cpu supports it). Small products
+	 * skip the packing and use a plain loop.
+	 * @param rows The number of rows of A and C
+	 * @param columns The number of columns of B and C
+	 * @param depth The number of columns of A and rows of B
+	 * @param a The first element of A
+	 * @param lda The distance between rows of A
+	 * @param b The first element of B
+	 * @param ldb The distance between rows of B
+	 * @param c The first element of C (must not overlap A or B)
+	 * @param ldc The distance between rows of C
+	 * @param pool The pool to run on
+	 */
+	template<typename T>
+	void gemm(size_t rows, size_t columns, size_t depth, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc,
+		Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+		using Blocking = GemmBlocking<T>;
+		constexpr size_t mr = Blocking::mr;
+		constexpr size_t nr = Blocking::nr;
+		if (rows == 0 || columns == 0 || depth == 0) return;
+
+		if (rows * columns * depth <= 32 * 32 * 32) {
+			for (size_t i = 0; i < rows; i++)
+				for (size_t k = 0; k < depth; k++) {
+					T value = a[i * lda + k];
+					for (size_t j = 0; j < columns; j++)
+						c[i * ldc + j] += value * b[k * ldb + j];
+				}
+			return;
+		}
+
+		void (*kernel)(size_t, const T*, const T*, T*, size_t, size_t, size_t) = gemmKernel<T, mr, nr>;
+#ifdef ESSENTIALS_MATH_AVX2
+		if constexpr (std::is_same_v<T, float>) {
+			if (cpuSupportsFma()) kernel = gemmKernelFloat;
+		}
+		else if constexpr (std::is_same_v<T, double>) {
+			if (cpuSupportsFma()) kernel = gemmKernelDouble;
+		}
+#endif
+
+		// Split the rows of C between the threads (counting the caller), in blocks of at most mc rows
+		size_t threads = pool.threadCount() + 1;
+		size_t blockRows = (rows + threads - 1) / threads;
+		blockRows = (blockRows + mr - 1) / mr * mr;
+		if (blockRows > Blocking::mc) blockRows = Blocking::mc;
+		size_t blocks = (rows + blockRows - 1) / blockRows;
+
+		size_t panelColumns = columns < Blocking::nc ? (columns + nr - 1) / nr * nr : Blocking::nc;
+		size_t panelDepth = depth < Blocking::kc ? depth : Blocking::kc;
+		DataStructures::HeapAllocator heap;
+		T* packedB = static_cast<T*>(heap.allocate(panelDepth * panelColumns * sizeof(T), DataStructures::cacheLineSize));
+
+		for (size_t jc = 0; jc < columns; jc += Blocking::nc) {
+			size_t width = columns - jc < Blocking::nc ? columns - jc : Blocking::nc;
+			for (size_t pc = 0; pc < depth; pc += Blocking::kc) {
+				size_t span = depth - pc < Blocking::kc ? depth - pc : Blocking::kc;
+				gemmPackB(b + pc * ldb + jc, ldb, span, width, packedB);
+
+				Threading::parallelFor(0, blocks, [&](size_t first, size_t last) {
+					DataStructures::HeapAllocator allocator;
+					T* packedA = static_cast<T*>(allocator.allocate(blockRows * span * sizeof(T), DataStructures::cacheLineSize));
+					for (size_t block = first; block < last; block++) {
+						size_t ic = block * blockRows;
+						size_t height = rows - ic < blockRows ? rows - ic : blockRows;
+						gemmPackA(a + ic * lda + pc, lda, height, span, packedA);
+						for (size_t jr = 0; jr < width; jr += nr)
+							for (size_t ir = 0; ir < height; ir += mr)
+								kernel(span, packedA + ir * span, packedB + jr * span, c + (ic + ir) * ldc + jc + jr, ldc,
+									height - ir < mr ? height - ir : mr, width - jr < nr ? width - jr : nr);
+					}
+					allocator.deallocate(packedA, blockRows * span * sizeof(T), DataStructures::cacheLineSize);
+				}, 1, pool);
+			}
+		}
+		heap.deallocate(packedB, panelDepth * panelColumns * sizeof(T), DataStructures::cacheLineSize);
+	}
+
+	/**
+	 * The base of lazily evaluated elementwise matrix expressions
+	 * Expressions are computed element by element straight into the matrix they are assigned to, without temporaries
+	 * @tparam E The expression type (which provides Element, rows(), columns() and element(index) over row major indices)
+	 */
+	template<typename E> class MatrixExpression {
+	public:
+		/**
+		 * Gets the expression as its actual type
+		 * @returns The expression
+		 */
+		const E& self() const {
+			return static_cast<const E&>(*this);
+		}
+	};
+
+	/**
+	 * How an expression stores one of its operands, matrices by reference and (temporary) expressions by value
+	 */
+	template<typename E> struct MatrixOperand {
+		/**
+		 * The type of the stored operand
+		 */
+		using Type = const E;
+	};
+
+	/**
+	 * How an expression stores one of its operands, matrices by reference and (temporary) expressions by value
+	 */
+	template<typename T> struct MatrixOperand<Matrix<T>> {
+		/**
+		 * The type of the stored operand
+		 */
+		using Type = const Matrix<T>&;
+	};
+
+	/**
+	 * A matrix with dimensions chosen at runtime, stored row major in cache line aligned memory
+	 * Matrices can be combined with +, - and scalar * into expressions evaluated in a single pass, and multiplied with *
+	 * (A * B + C accumulates into the destination without a temporary)
+	 */
+	template<typename T> class Matrix<T, dynamic, dynamic> : public MatrixExpression<Matrix<T>> {
+	private:
+		/**
+		 * The elements, row by row
+		 */
+		T* elements = nullptr;
+
+		/**
+		 * The number of rows
+		 */
+		size_t rowCount = 0;
+
+		/**
+		 * The number of columns
+		 */
+		size_t columnCount = 0;
+
+		/**
+		 * Changes the dimensions, reallocating if the number of elements changes (the elements are left uninitialized)
+		 * @param rows The new number of rows
+		 * @param columns The new number of columns
+		 */
+		void reset(size_t rows, size_t columns) {
+			if (rows * columns != rowCount * columnCount) {
+				free();
+				if (rows * columns > 0)
+					elements = static_cast<T*>(DataStructures::HeapAllocator().allocate(rows * columns * sizeof(T), DataStructures::cacheLineSize));
+			}
+			rowCount = rows;
+			columnCount = columns;
+		}
+
+		/**
+		 * Frees the elements
+		 */
+		void free() {
+			if (elements != nullptr)
+				DataStructures::HeapAllocator().deallocate(elements, rowCount * columnCount * sizeof(T), DataStructures::cacheLineSize);
+			elements = nullptr;
+		}
+
+		/**
+		 * Computes an elementwise expression into this matrix
+		 * @param expression The expression to compute
+		 */
+		template<typename E>
+		void assign(const MatrixExpression<E>& expression) {
+			const E& source = expression.self();
+			reset(source.rows(), source.columns());
+			size_t count = rowCount * columnCount;
+			for (size_t i = 0; i < count; i++)
+				elements[i] = source.element(i);
+		}
+
+	public:
+		static_assert(std::is_trivially_copyable_v<T>, "Matrix elements must be trivially copyable");
+
+		/**
+		 * The type of the elements
+		 */
+		using Element = T;
+
+		/**
+		 * Creates an empty matrix
+		 */
+		Matrix() = default;
+
+		/**
+		 * Creates a matrix filled with zeros
+		 * @param rows The number of rows
+		 * @param columns The number of columns
+		 */
+		Matrix(size_t rows, size_t columns) : Matrix(rows, columns, T()) {}
+
+		/**
+		 * Creates a matrix filled with a value
+		 * @param rows The number of rows
+		 * @param columns The number of columns
+		 * @param value The value of every element
+		 */
+		Matrix(size_t rows, size_t columns, const T& value) {
+			reset(rows, columns);
+			fill(value);
+		}
+
+		/**
+		 * Creates a matrix from nested lists of rows, ie { { 1, 2 }, { 3, 4 } }
+		 * @param rows The rows of the matrix (which must all be the same length)
+		 */
+		Matrix(std::initializer_list<std::initializer_list<T>> rows) {
+			reset(rows.size(), rows.size() > 0 ? rows.begin()->size() : 0);
+			T* element = elements;
+			for (const std::initializer_list<T>& row : rows) {
+				assert(row.size() == columnCount);
+				for (const T& value : row)
+					*element++ = value;
+			}
+		}
+
+		/**
+		 * Creates a copy of another matrix
+		 * @param other The matrix to copy
+		 */
+		Matrix(const Matrix& other) {
+			reset(other.rowCount, other.columnCount);
+			if (elements != nullptr)
+				std::memcpy(elements, other.elements, rowCount * columnCount * sizeof(T));
+		}
+
+		/**
+		 * Takes the elements of another matrix, leaving it empty
+		 * @param other The matrix to move from
+		 */
+		Matrix(Matrix&& other) noexcept : elements(other.elements), rowCount(other.rowCount), columnCount(other.columnCount) {
+			other.elements = nullptr;
+			other.rowCount = 0;
+			other.columnCount = 0;
+		}
+
+		/**
+		 * Creates a matrix by computing an elementwise expression
+		 * @param expression The expression to compute
+		 */
+		template<typename E>
+		Matrix(const MatrixExpression<E>& expression) {
+			assign(expression);
+		}
+
+		/**
+		 * Creates a matrix by computing a product
+		 * @param product The product to compute
+		 */
+		Matrix(const MatrixProduct<T>& product) {
+			reset(product.rows(), product.columns());
+			fill(T());
+			product.accumulateInto(*this);
+		}
+
+		/**
+		 * Creates a matrix by computing the sum of a product and an expression
+		 * @param sum The sum to compute
+		 */
+		template<typename E>
+		Matrix(const MatrixProductSum<T, E>& sum) {
+			sum.evaluateInto(*this);
+		}
+
+		/**
+		 * Replaces the elements with a copy of another matrix
+		 * @param other The matrix to copy
+		 * @returns This matrix
+		 */
+		Matrix& operator=(const Matrix& other) {
+			if (this != &other) {
+				reset(other.rowCount, other.columnCount);
+				if (elements != nullptr)
+					std::memcpy(elements, other.elements, rowCount * columnCount * sizeof(T));
+			}
+			return *this;
+		}
+
+		/**
+		 * Replaces the elements with the elements of another matrix, leaving it empty
+		 * @param other The matrix to move from
+		 * @returns This matrix
+		 */
+		Matrix& operator=(Matrix&& other) noexcept {
+			if (this != &other) {
+				free();
+				elements = other.elements;
+				rowCount = other.rowCount;
+				columnCount = other.columnCount;
+				other.elements = nullptr;
+				other.rowCount = 0;
+				other.columnCount = 0;
+			}
+			return *this;
+		}
+
+		/**
+		 * Replaces the elements with the result of an elementwise expression (which may refer to this matrix)
+		 * @param expression The expression to compute
+		 * @returns This matrix
+		 */
+		template<typename E>
+		Matrix& operator=(const MatrixExpression<E>& expression) {
+			assign(expression);
+			return *this;
+		}
+
+		/**
+		 * Replaces the elements with the result of a product (using a temporary if the product refers to this matrix)
+		 * @param product The product to compute
+		 * @returns This matrix
+		 */
+		Matrix& operator=(const MatrixProduct<T>& product) {
+			if (product.aliases(*this))
+				return *this = Matrix(product);
+			reset(product.rows(), product.columns());
+			fill(T());
+			product.accumulateInto(*this);
+			return *this;
+		}
+
+		/**
+		 * Replaces the elements with the sum of a product and an expression
+		 * @param sum The sum to compute
+		 * @returns This matrix
+		 */
+		template<typename E>
+		Matrix& operator=(const MatrixProductSum<T, E>& sum) {
+			if (sum.aliases(*this))
+				return *this = Matrix(sum);
+			sum.evaluateInto(*this);
+			return *this;
+		}
+
+		/**
+		 * Frees resources
+		 */
+		~Matrix() {
+			free();
+		}
+
+		/**
+		 * Creates an identity matrix
+		 * @param size The number of rows and columns
+		 * @returns The matrix
+		 */
+		static Matrix identity(size_t size) {
+			Matrix result(size, size);
+			for (size_t i = 0; i < size; i++)
+				result.elements[i * size + i] = T(1);
+			return result;
+		}
+
+		/**
+		 * Gets an element
+		 * @param row The row of the element
+		 * @param column The column of the element
+		 * @returns The element
+		 */
+		inline T& operator()(size_t row, size_t column) {
+			assert(row < rowCount && column < columnCount);
+			return elements[row * columnCount + column];
+		}
+
+		/**
+		 * Gets an element
+		 * @param row The row of the element
+		 * @param column The column of the element
+		 * @returns The element
+		 */
+		inline const T& operator()(size_t row, size_t column) const {
+			assert(row < rowCount && column < columnCount);
+			return elements[row * columnCount + column];
+		}
+
+		/**
+		 * Gets an element by its row major index (used by expressions)
+		 * @param index The index of the element
+		 * @returns The element
+		 */
+		inline const T& element(size_t index) const {
+			return elements[index];
+		}
+
+		/**
+		 * Gets the elements of a row
+		 * @param index The index of the row
+		 * @returns The first element of the row
+		 */
+		inline T* row(size_t index) {
+			assert(index < rowCount);
+			return elements + index * columnCount;
+		}
+
+		/**
+		 * Gets the elements of a row
+		 * @param index The index of the row
+		 * @returns The first element of the row
+		 */
+		inline const T* row(size_t index) const {
+			assert(index < rowCount);
+			return elements + index * columnCount;
+		}
+
+		/**
+		 * Gets the elements, row by row
+		 * @returns The first element (nullptr for an empty matrix)
+		 */
+		inline T* data() {
+			return elements;
+		}
+
+		/**
+		 * Gets the elements, row by row
+		 * @returns The first element (nullptr for an empty matrix)
+		 */
+		inline const T* data() const {
+			return elements;
+		}
+
+		/**
+		 * Gets the number of rows
+		 * @returns The number of rows
+		 */
+		inline size_t rows() const {
+			return rowCount;
+		}
+
+		/**
+		 * Gets the number of columns
+		 * @returns The number of columns
+		 */
+		inline size_t columns() const {
+			return columnCount;
+		}
+
+		/**
+		 * Sets every element to a value
+		 * @param value The value
+		 */
+		void fill(const T& value) {
+			size_t count = rowCount * columnCount;
+			for (size_t i = 0; i < count; i++)
+				elements[i] = value;
+		}
+
+		/**
+		 * Changes the dimensions of the matrix, setting every element to zero
+		 * @param rows The new number of rows
+		 * @param columns The new number of columns
+		 */
+		void resize(size_t rows, size_t columns) {
+			reset(rows, columns);
+			fill(T());
+		}
+
+		/**
+		 * Adds an elementwise expression to this matrix
+		 * @param expression The expression to add (with the same dimensions)
+		 * @returns This matrix
+		 */
+		template<typename E>
+		Matrix& operator+=(const MatrixExpression<E>& expression) {
+			const E& source = expression.self();
+			assert(source.rows() == rowCount && source.columns() == columnCount);
+			size_t count = rowCount * columnCount;
+			for (size_t i = 0; i < count; i++)
+				elements[i] += source.element(i);
+			return *this;
+		}
+
+		/**
+		 * Subtracts an elementwise expression from this matrix
+		 * @param expression The expression to subtract (with the same dimensions)
+		 * @returns This matrix
+		 */
+		template<typename E>
+		Matrix& operator-=(const MatrixExpression<E>& expression) {
+			const E& source = expression.self();
+			assert(source.rows() == rowCount && source.columns() == columnCount);
+			size_t count = rowCount * columnCount;
+			for (size_t i = 0; i < count; i++)
+				elements[i] -= source.element(i);
+			return *this;
+		}
+
+		/**
+		 * Adds a product to this matrix without a temporary (C += A * B)
+		 * @param product The product to add (with the same dimensions)
+		 * @returns This matrix
+		 */
+		Matrix& operator+=(const MatrixProduct<T>& product) {
+			assert(product.rows() == rowCount && product.columns() == columnCount);
+			if (product.aliases(*this))
+				return *this += Matrix(product);
+			product.accumulateInto(*this);
+			return *this;
+		}
+
+		/**
+		 * Multiplies every element by a value
+		 * @param value The value to multiply by
+		 * @returns This matrix
+		 */
+		Matrix& operator*=(const T& value) {
+			size_t count = rowCount * columnCount;
+			for (size_t i = 0; i < count; i++)
+				elements[i] *= value;
+			return *this;
+		}
+
+		/**
+		 * Checks if two matrices have the same dimensions and elements
+		 * @param other The matrix to compare with
+		 * @returns Whether or not the matrices are equal
+		 */
+		bool operator==(const Matrix& other) const {
+			if (rowCount != other.rowCount || columnCount != other.columnCount) return false;
+			size_t count = rowCount * columnCount;
+			for (size_t i = 0; i < count; i++)
+				if (!(elements[i] == other.elements[i])) return false;
+			return true;
+		}
+
+		/**
+		 * Checks if two matrices differ in dimensions or elements
+		 * @param other The matrix to compare with
+		 * @returns Whether or not the matrices are different
+		 */
+		bool operator!=(const Matrix& other) const {
+			return !(*this == other);
+		}
+
+		/**
+		 * Creates the transpose of the matrix (copied in cache sized tiles)
+		 * @returns The transpose
+		 */
+		Matrix transposed() const {
+			constexpr size_t tile = 32;
+			Matrix result;
+			result.reset(columnCount, rowCount);
+			for (size_t ib = 0; ib < rowCount; ib += tile)
+				for (size_t jb = 0; jb < columnCount; jb += tile) {
+					size_t iEnd = ib + tile < rowCount ? ib + tile : rowCount;
+					size_t jEnd = jb + tile < columnCount ? jb + tile : columnCount;
+					for (size_t i = ib; i < iEnd; i++)
+						for (size_t j = jb; j < jEnd; j++)
+							result.elements[j * rowCount + i] = elements[i * columnCount + j];
+				}
+			return result;
+		}
+
+		/**
+		 * Transposes the matrix (in place for square matrices)
+		 */
+		void transpose() {
+			if (rowCount != columnCount) {
+				*this = transposed();
+				return;
+			}
+			for (size_t i = 0; i < rowCount; i++)
+				for (size_t j = i + 1; j < columnCount; j++)
+					std::swap(elements[i * columnCount + j], elements[j * columnCount + i]);
+		}
+
+		/**
+		 * Replaces a square matrix with its LU decomposition with partial pivoting (PA = LU)
+		 * L (below the diagonal, with an implicit unit diagonal) and U (the rest) share the storage
+		 * @param pivots Set to the row swapped with each row, in order
+		 * @param pool The pool the trailing updates of large matrices run on
+		 * @returns Whether or not the matrix is invertible (false stops at the first zero pivot)
+		 */
+		bool decomposeLU(DataStructures::ArrayList<size_t>& pivots, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+			assert(rowCount == columnCount);
+			size_t size = rowCount;
+			pivots.clear();
+			pivots.prepare(size);
+			for (size_t k = 0; k < size; k++) {
+				size_t pivot = k;
+				T largest = std::abs(elements[k * size + k]);
+				for (size_t i = k + 1; i < size; i++) {
+					T value = std::abs(elements[i * size + k]);
+					if (value > largest) {
+						largest = value;
+						pivot = i;
+					}
+				}
+				pivots.push(pivot);
+				if (largest == T()) return false;
+				if (pivot != k)
+					for (size_t j = 0; j < size; j++)
+						std::swap(elements[k * size + j], elements[pivot * size + j]);
+
+				// Rank one update of the trailing rows, each row is independent and contiguous
+				const T* pivotRow = elements + k * size;
+				T inverse = T(1) / pivotRow[k];
+				auto update = [&](size_t first, size_t last) {
+					for (size_t i = first; i < last; i++) {
+						T* target = elements + i * size;
+						T factor = target[k] * inverse;
+						target[k] = factor;
+						for (size_t j = k + 1; j < size; j++)
+							target[j] -= factor * pivotRow[j];
+					}
+				};
+				size_t remaining = size - k - 1;
+				if (remaining * remaining < 1 << 16) update(k + 1, size);
+				else Threading::parallelFor(k + 1, size, update, (1 << 15) / remaining + 1, pool);
+			}
+			return true;
+		}
+
+		/**
+		 * Solves A x = b using this matrix as the result of decomposeLU
+		 * @param pivots The pivots from decomposeLU
+		 * @param rhs The right hand sides b, one per column
+		 * @returns The solutions x, one per column
+		 */
+		Matrix solveLU(const DataStructures::ArrayList<size_t>& pivots, const Matrix& rhs) const {
+			assert(rowCount == columnCount && rhs.rowCount == rowCount && pivots.length() == rowCount);
+			size_t size = rowCount;
+			size_t width = rhs.columnCount;
+			Matrix x(rhs);
+			for (size_t k = 0; k < size; k++)
+				if (pivots[k] != k)
+					for (size_t j = 0; j < width; j++)
+						std::swap(x.elements[k * width + j], x.elements[pivots[k] * width + j]);
+			for (size_t i = 0; i < size; i++)
+				for (size_t k = 0; k < i; k++) {
+					T factor = elements[i * size + k];
+					for (size_t j = 0; j < width; j++)
+						x.elements[i * width + j] -= factor * x.elements[k * width + j];
+				}
+			for (size_t i = size; i-- > 0;) {
+				for (size_t k = i + 1; k < size; k++) {
+					T factor = elements[i * size + k];
+					for (size_t j = 0; j < width; j++)
+						x.elements[i * width + j] -= factor * x.elements[k * width + j];
+				}
+				T inverse = T(1) / elements[i * size + i];
+				for (size_t j = 0; j < width; j++)
+					x.elements[i * width + j] *= inverse;
+			}
+			return x;
+		}
+
+		/**
+		 * Replaces a symmetric positive definite matrix with its Cholesky factor L (A = L L^T), zeroing the upper triangle
+		 * @returns Whether or not the matrix is positive definite (the contents are unspecified if not)
+		 */
+		bool decomposeCholesky() {
+			assert(rowCount == columnCount);
+			size_t size = rowCount;
+			for (size_t i = 0; i < size; i++) {
+				T* rowI = elements + i * size;
+				for (size_t j = 0; j <= i; j++) {
+					// Both rows are contiguous, so the dot product vectorizes
+					const T* rowJ = elements + j * size;
+					T sum = rowI[j];
+					for (size_t k = 0; k < j; k++)
+						sum -= rowI[k] * rowJ[k];
+					if (i == j) {
+						if (!(sum > T())) return false;
+						rowI[i] = std::sqrt(sum);
+					}
+					else {
+						rowI[j] = sum / rowJ[j];
+					}
+				}
+				for (size_t j = i + 1; j < size; j++)
+					rowI[j] = T();
+			}
+			return true;
+		}
+
+		/**
+		 * Solves A x = b using this matrix as the result of decomposeCholesky
+		 * @param rhs The right hand sides b, one per column
+		 * @returns The solutions x, one per column
+		 */
+		Matrix solveCholesky(const Matrix& rhs) const {
+			assert(rowCount == columnCount && rhs.rowCount == rowCount);
+			size_t size = rowCount;
+			size_t width = rhs.columnCount;
+			Matrix x(rhs);
+			for (size_t i = 0; i < size; i++) {
+				for (size_t k = 0; k < i; k++) {
+					T factor = elements[i * size + k];
+					for (size_t j = 0; j < width; j++)
+						x.elements[i * width + j] -= factor * x.elements[k * width + j];
+				}
+				T inverse = T(1) / elements[i * size + i];
+				for (size_t j = 0; j < width; j++)
+					x.elements[i * width + j] *= inverse;
+			}
+			for (size_t i = size; i-- > 0;) {
+				for (size_t k = i + 1; k < size; k++) {
+					T factor = elements[k * size + i];
+					for (size_t j = 0; j < width; j++)
+						x.elements[i * width + j] -= factor * x.elements[k * width + j];
+				}
+				T inverse = T(1) / elements[i * size + i];
+				for (size_t j = 0; j < width; j++)
+					x.elements[i * width + j] *= inverse;
+			}
+			return x;
+		}
+
+		/**
+		 * Computes the determinant of a square matrix (through an LU decomposition of a copy)
+		 * @returns The determinant
+		 */
+		T determinant() const {
+			Matrix lu(*this);
+			DataStructures::ArrayList<size_t> pivots;
+			if (!lu.decomposeLU(pivots)) return T();
+			T result = T(1);
+			for (size_t i = 0; i < rowCount; i++) {
+				result *= lu.elements[i * columnCount + i];
+				if (pivots[i] != i) result = -result;
+			}
+			return result;
+		}
+	};
+
+	/**
+	 * An elementwise combination of two matrix expressions (ie A + B)
+	 * @tparam Op The operation applied to each pair of elements
+	 */
+	template<typename L, typename R, typename Op> class MatrixElementwise : public MatrixExpression<MatrixElementwise<L, R, Op>> {
+	private:
+		/**
+		 * The left operand
+		 */
+		typename MatrixOperand<L>::Type left;
+
+		/**
+		 * The right operand
+		 */
+		typename MatrixOperand<R>::Type right;
+
+	public:
+		/**
+		 * The type of the elements
+		 */
+		using Element = typename L::Element;
+
+		/**
+		 * Creates an expression combining two operands with the same dimensions
+		 * @param left The left operand
+		 * @param right The right operand
+		 */
+		MatrixElementwise(const L& left, const R& right) : left(left), right(right) {
+			assert(left.rows() == right.rows() && left.columns() == right.columns());
+		}
+
+		/**
+		 * Gets the number of rows
+		 * @returns The number of rows
+		 */
+		inline size_t rows() const {
+			return left.rows();
+		}
+
+		/**
+		 * Gets the number of columns
+		 * @returns The number of columns
+		 */
+		inline size_t columns() const {
+			return left.columns();
+		}
+
+		/**
+		 * Computes an element
+		 * @param index The row major index of the element
+		 * @returns The element
+		 */
+		inline Element element(size_t index) const {
+			return Op()(left.element(index), right.element(index));
+		}
+	};
+
+	/**
+	 * A matrix expression multiplied by a scalar
+	 */
+	template<typename E> class MatrixScaled : public MatrixExpression<MatrixScaled<E>> {
+	public:
+		/**
+		 * The type of the elements
+		 */
+		using Element = typename E::Element;
+
+	private:
+		/**
+		 * The scaled expression
+		 */
+		typename MatrixOperand<E>::Type operand;
+
+		/**
+		 * The scalar
+		 */
+		Element factor;
+
+	public:
+		/**
+		 * Creates a scaled expression
+		 * @param operand The expression to scale
+		 * @param factor The scalar
+		 */
+		MatrixScaled(const E& operand, Element factor) : operand(operand), factor(factor) {}
+
+		/**
+		 * Gets the number of rows
+		 * @returns The number of rows
+		 */
+		inline size_t rows() const {
+			return operand.rows();
+		}
+
+		/**
+		 * Gets the number of columns
+		 * @returns The number of columns
+		 */
+		inline size_t columns() const {
+			return operand.columns();
+		}
+
+		/**
+		 * Computes an element
+		 * @param index The row major index of the element
+		 * @returns The element
+		 */
+		inline Element element(size_t index) const {
+			return factor * operand.element(index);
+		}
+	};
+
+	/**
+	 * The product of two matrices, computed with gemm when assigned (or added) to a matrix
+	 */
+	template<typename T> class MatrixProduct {
+	private:
+		/**
+		 * The left operand
+		 */
+		const Matrix<T>& left;
+
+		/**
+		 * The right operand
+		 */
+		const Matrix<T>& right;
+
+	public:
+		/**
+		 * Creates a product of two matrices
+		 * @param left The left operand
+		 * @param right The right operand (with as many rows as left has columns)
+		 */
+		MatrixProduct(const Matrix<T>& left, const Matrix<T>& right) : left(left), right(right) {
+			assert(left.columns() == right.rows());
+		}
+
+		/**
+		 * Gets the number of rows
+		 * @returns The number of rows
+		 */
+		inline size_t rows() const {
+			return left.rows();
+		}
+
+		/**
+		 * Gets the number of columns
+		 * @returns The number of columns
+		 */
+		inline size_t columns() const {
+			return right.columns();
+		}
+
+		/**
+		 * Checks if a matrix is one of the operands
+		 * @param matrix The matrix to check
+		 * @returns Whether or not the matrix is used by the product
+		 */
+		bool aliases(const Matrix<T>& matrix) const {
+			return &matrix == &left || &matrix == &right;
+		}
+
+		/**
+		 * Adds the product to a matrix
+		 * @param out The matrix to add to (with the dimensions of the product, must not be an operand)
+		 */
+		void accumulateInto(Matrix<T>& out) const {
+			gemm(left.rows(), right.columns(), left.columns(), left.data(), left.columns(), right.data(), right.columns(), out.data(), out.columns());
+		}
+	};
+
+	/**
+	 * The sum of a product and an elementwise expression, computed by evaluating the expression into the destination
+	 * and accumulating the product on top (so A * B + C needs no temporary)
+	 */
+	template<typename T, typename E> class MatrixProductSum {
+	private:
+		/**
+		 * The product
+		 */
+		MatrixProduct<T> product;
+
+		/**
+		 * The expression added to the product
+		 */
+		typename MatrixOperand<E>::Type addend;
+
+	public:
+		/**
+		 * Creates the sum of a product and an expression
+		 * @param product The product
+		 * @param addend The expression (with the dimensions of the product)
+		 */
+		MatrixProductSum(const MatrixProduct<T>& product, const E& addend) : product(product), addend(addend) {
+			assert(product.rows() == addend.rows() && product.columns() == addend.columns());
+		}
+
+		/**
+		 * Checks if a matrix is one of the operands of the product
+		 * @param matrix The matrix to check
+		 * @returns Whether or not the matrix is used by the product
+		 */
+		bool aliases(const Matrix<T>& matrix) const {
+			return product.aliases(matrix);
+		}
+
+		/**
+		 * Computes the sum into a matrix
+		 * @param out The matrix to store the sum in (must not be an operand of the product)
+		 */
+		void evaluateInto(Matrix<T>& out) const {
+			out = addend;
+			product.accumulateInto(out);
+		}
+	};
+
+	/**
+	 * Adds two matrix expressions elementwise
+	 * @param left The left operand
+	 * @param right The right operand
+	 * @returns The lazy sum
+	 */
+	template<typename L, typename R>
+	MatrixElementwise<L, R, std::plus<>> operator+(const MatrixExpression<L>& left, const MatrixExpression<R>& right) {
+		return MatrixElementwise<L, R, std::plus<>>(left.self(), right.self());
+	}
+
+	/**
+	 * Subtracts two matrix expressions elementwise
+	 * @param left The left operand
+	 * @param right The right operand
+	 * @returns The lazy difference
+	 */
+	template<typename L, typename R>
+	MatrixElementwise<L, R, std::minus<>> operator-(const MatrixExpression<L>& left, const MatrixExpression<R>& right) {
+		return MatrixElementwise<L, R, std::minus<>>(left.self(), right.self());
+	}
+
+	/**
+	 * Multiplies a matrix expression by a scalar
+	 * @param expression The expression
+	 * @param factor The scalar
+	 * @returns The lazy scaled expression
+	 */
+	template<typename E>
+	MatrixScaled<E> operator*(const MatrixExpression<E>& expression, typename E::Element factor) {
+		return MatrixScaled<E>(expression.self(), factor);
+	}
+
+	/**
+	 * Multiplies a matrix expression by a scalar
+	 * @param factor The scalar
+	 * @param expression The expression
+	 * @returns The lazy scaled expression
+	 */
+	template<typename E>
+	MatrixScaled<E> operator*(typename E::Element factor, const MatrixExpression<E>& expression) {
+		return MatrixScaled<E>(expression.self(), factor);
+	}
+
+	/**
+	 * Multiplies two matrices
+	 * @param left The left operand
+	 * @param right The right operand (with as many rows as left has columns)
+	 * @returns The lazy product, computed when assigned to a matrix
+	 */
+	template<typename T>
+	MatrixProduct<T> operator*(const Matrix<T>& left, const Matrix<T>& right) {
+		return MatrixProduct<T>(left, right);
+	}
+
+	/**
+	 * Adds an elementwise expression to a product
+	 * @param product The product
+	 * @param addend The expression
+	 * @returns The lazy sum
+	 */
+	template<typename T, typename E>
+	MatrixProductSum<T, E> operator+(const MatrixProduct<T>& product, const MatrixExpression<E>& addend) {
+		return MatrixProductSum<T, E>(product, addend.self());
+	}
+
+	/**
+	 * Adds a product to an elementwise expression
+	 * @param addend The expression
+	 * @param product The product
+	 * @returns The lazy sum
+	 */
+	template<typename T, typename E>
+	MatrixProductSum<T, E> operator+(const MatrixExpression<E>& addend, const MatrixProduct<T>& product) {
+		return MatrixProductSum<T, E>(product, addend.self());
+	}
+
+	/**
+	 * A matrix with dimensions fixed at compile time, stored row major inline (usable in constant expressions)
+	 * @tparam Rows The number of rows
+	 * @tparam Columns The number of columns
+	 */
+	template<typename T, size_t Rows, size_t Columns> class Matrix {
+	private:
+		static_assert(Rows != dynamic && Columns != dynamic, "Either both or neither dimension of a matrix may be dynamic");
+
+		template<typename, size_t, size_t> friend class Matrix;
+
+		/**
+		 * The alignment of the elements (16 bytes when they fill whole SSE registers)
+		 */
+		static constexpr size_t alignment = (Rows * Columns * sizeof(T)) % 16 == 0 ? 16 : alignof(T);
+
+		/**
+		 * The elements, row by row
+		 */
+		alignas(alignment) T elements[Rows * Columns];
+
+		/**
+		 * Gets the absolute value of an element in a constant expression
+		 * @param value The value
+		 * @returns The absolute value
+		 */
+		static constexpr T magnitude(const T& value) {
+			return value < T() ? -value : value;
+		}
+
+	public:
+		/**
+		 * The type of the elements
+		 */
+		using Element = T;
+
+		/**
+		 * Creates a matrix filled with zeros
+		 */
+		constexpr Matrix() : elements{} {}
+
+		/**
+		 * Creates a matrix from its elements, row by row
+		 * @param values The elements (exactly Rows * Columns)
+		 */
+		template<typename... A, typename = std::enable_if_t<sizeof...(A) == Rows * Columns && (std::is_convertible_v<A, T> && ...)>>
+		constexpr Matrix(A... values) : elements{ static_cast<T>(values)... } {}
+
+		/**
+		 * Creates an identity matrix
+		 * @returns The matrix
+		 */
+		static constexpr Matrix identity() {
+			static_assert(Rows == Columns, "Only square matrices have an identity");
+			Matrix result;
+			for (size_t i = 0; i < Rows; i++)
+				result.elements[i * Columns + i] = T(1);
+			return result;
+		}
+
+		/**
+		 * Gets an element
+		 * @param row The row of the element
+		 * @param column The column of the element
+		 * @returns The element
+		 */
+		constexpr T& operator()(size_t row, size_t column) {
+			return elements[row * Columns + column];
+		}
+
+		/**
+		 * Gets an element
+		 * @param row The row of the element
+		 * @param column The column of the element
+		 * @returns The element
+		 */
+		constexpr const T& operator()(size_t row, size_t column) const {
+			return elements[row * Columns + column];
+		}
+
+		/**
+		 * Gets the elements, row by row
+		 * @returns The first element
+		 */
+		constexpr T* data() {
+			return elements;
+		}
+
+		/**
+		 * Gets the elements, row by row
+		 * @returns The first element
+		 */
+		constexpr const T* data() const {
+			return elements;
+		}
+
+		/**
+		 * Gets the number of rows
+		 * @returns The number of rows
+		 */
+		static constexpr size_t rows() {
+			return Rows;
+		}
+
+		/**
+		 * Gets the number of columns
+		 * @returns The number of columns
+		 */
+		static constexpr size_t columns() {
+			return Columns;
+		}
+
+		/**
+		 * Adds two matrices
+		 * @param other The matrix to add
+		 * @returns The sum
+		 */
+		constexpr Matrix operator+(const Matrix& other) const {
+			Matrix result;
+			for (size_t i = 0; i < Rows * Columns; i++)
+				result.elements[i] = elements[i] + other.elements[i];
+			return result;
+		}
+
+		/**
+		 * Subtracts two matrices
+		 * @param other The matrix to subtract
+		 * @returns The difference
+		 */
+		constexpr Matrix operator-(const Matrix& other) const {
+			Matrix result;
+			for (size_t i = 0; i < Rows * Columns; i++)
+				result.elements[i] = elements[i] - other.elements[i];
+			return result;
+		}
+
+		/**
+		 * Negates every element
+		 * @returns The negated matrix
+		 */
+		constexpr Matrix operator-() const {
+			Matrix result;
+			for (size_t i = 0; i < Rows * Columns; i++)
+				result.elements[i] = -elements[i];
+			return result;
+		}
+
+		/**
+		 * Multiplies every element by a value
+		 * @param value The value
+		 * @returns The scaled matrix
+		 */
+		constexpr Matrix operator*(const T& value) const {
+			Matrix result;
+			for (size_t i = 0; i < Rows * Columns; i++)
+				result.elements[i] = elements[i] * value;
+			return result;
+		}
+
+		/**
+		 * Multiplies every element of a matrix by a value
+		 * @param value The value
+		 * @param matrix The matrix
+		 * @returns The scaled matrix
+		 */
+		friend constexpr Matrix operator*(const T& value, const Matrix& matrix) {
+			return matrix * value;
+		}
+
+		/**
+		 * Divides every element by a value
+		 * @param value The value
+		 * @returns The scaled matrix
+		 */
+		constexpr Matrix operator/(const T& value) const {
+			Matrix result;
+			for (size_t i = 0; i < Rows * Columns; i++)
+				result.elements[i] = elements[i] / value;
+			return result;
+		}
+
+		/**
+		 * Adds a matrix to this matrix
+		 * @param other The matrix to add
+		 * @returns This matrix
+		 */
+		constexpr Matrix& operator+=(const Matrix& other) {
+			for (size_t i = 0; i < Rows * Columns; i++)
+				elements[i] += other.elements[i];
+			return *this;
+		}
+
+		/**
+		 * Subtracts a matrix from this matrix
+		 * @param other The matrix to subtract
+		 * @returns This matrix
+		 */
+		constexpr Matrix& operator-=(const Matrix& other) {
+			for (size_t i = 0; i < Rows * Columns; i++)
+				elements[i] -= other.elements[i];
+			return *this;
+		}
+
+		/**
+		 * Multiplies every element by a value
+		 * @param value The value
+		 * @returns This matrix
+		 */
+		constexpr Matrix& operator*=(const T& value) {
+			for (size_t i = 0; i < Rows * Columns; i++)
+				elements[i] *= value;
+			return *this;
+		}
+
+		/**
+		 * Multiplies two matrices (4x4 float products use SSE outside of constant expressions)
+		 * @param other The right operand
+		 * @returns The product
+		 */
+		template<size_t K>
+		constexpr Matrix<T, Rows, K> operator*(const Matrix<T, Columns, K>& other) const {
+			Matrix<T, Rows, K> result;
+#ifdef ESSENTIALS_MATH_SSE2
+			if constexpr (std::is_same_v<T, float> && Rows == 4 && Columns == 4 && K == 4) {
+				if (!isConstantEvaluated()) {
+					__m128 b0 = _mm_load_ps(other.elements);
+					__m128 b1 = _mm_load_ps(other.elements + 4);
+					__m128 b2 = _mm_load_ps(other.elements + 8);
+					__m128 b3 = _mm_load_ps(other.elements + 12);
+					for (size_t i = 0; i < 4; i++) {
+						const float* row = elements + i * 4;
+						__m128 sum = _mm_mul_ps(_mm_set1_ps(row[0]), b0);
+						sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(row[1]), b1));
+						sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(row[2]), b2));
+						sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(row[3]), b3));
+						_mm_store_ps(result.elements + i * 4, sum);
+					}
+					return result;
+				}
+			}
+#endif
+			for (size_t i = 0; i < Rows; i++)
+				for (size_t k = 0; k < Columns; k++) {
+					T value = elements[i * Columns + k];
+					for (size_t j = 0; j < K; j++)
+						result.elements[i * K + j] += value * other.elements[k * K + j];
+				}
+			return result;
+		}
+
+		/**
+		 * Checks if two matrices have the same elements
+		 * @param other The matrix to compare with
+		 * @returns Whether or not the matrices are equal
+		 */
+		constexpr bool operator==(const Matrix& other) const {
+			for (size_t i = 0; i < Rows * Columns; i++)
+				if (!(elements[i] == other.elements[i])) return false;
+			return true;
+		}
+
+		/**
+		 * Checks if two matrices have different elements
+		 * @param other The matrix to compare with
+		 * @returns Whether or not the matrices are different
+		 */
+		constexpr bool operator!=(const Matrix& other) const {
+			return !(*this == other);
+		}
+
+		/**
+		 * Creates the transpose of the matrix
+		 * @returns The transpose
+		 */
+		constexpr Matrix<T, Columns, Rows> transposed() const {
+			Matrix<T, Columns, Rows> result;
+			for (size_t i = 0; i < Rows; i++)
+				for (size_t j = 0; j < Columns; j++)
+					result.elements[j * Rows + i] = elements[i * Columns + j];
+			return result;
+		}
+
+		/**
+		 * Computes the determinant of a square matrix (closed form up to 3x3, elimination above)
+		 * @returns The determinant
+		 */
+		constexpr T determinant() const {
+			static_assert(Rows == Columns, "Only square matrices have a determinant");
+			const T* m = elements;
+			if constexpr (Rows == 1) return m[0];
+			else if constexpr (Rows == 2) return m[0] * m[3] - m[1] * m[2];
+			else if constexpr (Rows == 3) {
+				return m[0] * (m[4] * m[8] - m[5] * m[7]) - m[1] * (m[3] * m[8] - m[5] * m[6]) + m[2] * (m[3] * m[7] - m[4] * m[6]);
+			}
+			else {
+				Matrix lu = *this;
+				T result = T(1);
+				for (size_t k = 0; k < Rows; k++) {
+					size_t pivot = k;
+					for (size_t i = k + 1; i < Rows; i++)
+						if (magnitude(lu.elements[i * Columns + k]) > magnitude(lu.elements[pivot * Columns + k])) pivot = i;
+					if (lu.elements[pivot * Columns + k] == T()) return T();
+					if (pivot != k) {
+						for (size_t j = 0; j < Columns; j++) {
+							T swap = lu.elements[k * Columns + j];
+							lu.elements[k * Columns + j] = lu.elements[pivot * Columns + j];
+							lu.elements[pivot * Columns + j] = swap;
+						}
+						result = -result;
+					}
+					result *= lu.elements[k * Columns + k];
+					for (size_t i = k + 1; i < Rows; i++) {
+						T factor = lu.elements[i * Columns + k] / lu.elements[k * Columns + k];
+						for (size_t j = k; j < Columns; j++)
+							lu.elements[i * Columns + j] -= factor * lu.elements[k * Columns + j];
+					}
+				}
+				return result;
+			}
+		}
+
+		/**
+		 * Computes the inverse of a square matrix with Gauss-Jordan elimination and partial pivoting
+		 * @param out Set to the inverse
+		 * @returns Whether or not the matrix is invertible (out is unspecified if not)
+		 */
+		constexpr bool inverse(Matrix& out) const {
+			static_assert(Rows == Columns, "Only square matrices have an inverse");
+			Matrix work = *this;
+			out = identity();
+			for (size_t k = 0; k < Rows; k++) {
+				size_t pivot = k;
+				for (size_t i = k + 1; i < Rows; i++)
+					if (magnitude(work.elements[i * Columns + k]) > magnitude(work.elements[pivot * Columns + k])) pivot = i;
+				if (work.elements[pivot * Columns + k] == T()) return false;
+				if (pivot != k)
+					for (size_t j = 0; j < Columns; j++) {
+						T swap = work.elements[k * Columns + j];
+						work.elements[k * Columns + j] = work.elements[pivot * Columns + j];
+						work.elements[pivot * Columns + j] = swap;
+						swap = out.elements[k * Columns + j];
+						out.elements[k * Columns + j] = out.elements[pivot * Columns + j];
+						out.elements[pivot * Columns + j] = swap;
+					}
+				T scale = T(1) / work.elements[k * Columns + k];
+				for (size_t j = 0; j < Columns; j++) {
+					work.elements[k * Columns + j] *= scale;
+					out.elements[k * Columns + j] *= scale;
+				}
+				for (size_t i = 0; i < Rows; i++) {
+					if (i == k) continue;
+					T factor = work.elements[i * Columns + k];
+					for (size_t j = 0; j < Columns; j++) {
+						work.elements[i * Columns + j] -= factor * work.elements[k * Columns + j];
+						out.elements[i * Columns + j] -= factor * out.elements[k * Columns + j];
+					}
+				}
+			}
+			return true;
+		}
+	};
+
+	/**
+	 * A 2x2 matrix
+	 */
+	template<typename T> using Matrix2 = Matrix<T, 2, 2>;
+
+	/**
+	 * A 3x3 matrix
+	 */
+	template<typename T> using Matrix3 = Matrix<T, 3, 3>;
+
+	/**
+	 * A 4x4 matrix
+	 */
+	template<typename T> using Matrix4 = Matrix<T, 4, 4>;
+
+	/**
+	 * A 2x2 float matrix
+	 */
+	using Matrix2f = Matrix2<float>;
+
+	/**
+	 * A 3x3 float matrix
+	 */
+	using Matrix3f = Matrix3<float>;
+
+	/**
+	 * A 4x4 float matrix
+	 */
+	using Matrix4f = Matrix4<float>;
+
+	/**
+	 * A 2x2 double matrix
+	 */
+	using Matrix2d = Matrix2<double>;
+
+	/**
+	 * A 3x3 double matrix
+	 */
+	using Matrix3d = Matrix3<double>;
+
+	/**
+	 * A 4x4 double matrix
+	 */
+	using Matrix4d = Matrix4<double>;
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
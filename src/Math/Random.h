@@ -0,0 +1,921 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "Simd.h"
+#include "../Threading/Parallel.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/**
+ * The namespace for math in the essentials library
+ */
+namespace Essentials::Math {
+
+	/**
+	 * A namespace alias to the math namespace
+	 */
+	namespace ma = Math;
+
+	/**
+	 * An unsigned 128 bit integer, used for the state of 128 bit generators
+	 */
+	struct Uint128 {
+		/**
+		 * The upper 64 bits
+		 */
+		uint64_t high;
+
+		/**
+		 * The lower 64 bits
+		 */
+		uint64_t low;
+	};
+
+	/**
+	 * Multiplies two 64 bit integers
+	 * @param a The first integer
+	 * @param b The second integer
+	 * @returns The upper 64 bits of the 128 bit product
+	 */
+	inline uint64_t multiplyHigh(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+		return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+		uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+		uint64_t bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+		uint64_t lowLow = aLow * bLow;
+		uint64_t highLow = aHigh * bLow;
+		uint64_t lowHigh = aLow * bHigh;
+		uint64_t middle = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + lowHigh;
+		return aHigh * bHigh + (highLow >> 32) + (middle >> 32);
+#endif
+	}
+
+	/**
+	 * Adds two 128 bit integers (wrapping)
+	 * @param a The first integer
+	 * @param b The second integer
+	 * @returns The sum
+	 */
+	inline Uint128 operator+(Uint128 a, Uint128 b) {
+		uint64_t low = a.low + b.low;
+		return { a.high + b.high + (low < a.low), low };
+	}
+
+	/**
+	 * Multiplies two 128 bit integers (wrapping)
+	 * @param a The first integer
+	 * @param b The second integer
+	 * @returns The lower 128 bits of the product
+	 */
+	inline Uint128 operator*(Uint128 a, Uint128 b) {
+		return { multiplyHigh(a.low, b.low) + a.high * b.low + a.low * b.high, a.low * b.low };
+	}
+
+	/**
+	 * Rotates the bits of an integer left
+	 * @param value The integer
+	 * @param count The number of bits to rotate by (less than 64)
+	 * @returns The rotated integer
+	 */
+	inline constexpr uint64_t rotateLeft(uint64_t value, unsigned count) {
+		return (value << count) | (value >> ((64 - count) & 63));
+	}
+
+	/**
+	 * Rotates the bits of an integer right
+	 * @param value The integer
+	 * @param count The number of bits to rotate by (less than 64)
+	 * @returns The rotated integer
+	 */
+	inline constexpr uint64_t rotateRight(uint64_t value, unsigned count) {
+		return (value >> count) | (value << ((64 - count) & 63));
+	}
+
+	/**
+	 * The splitmix64 generator, used to expand a single seed into the state of the other generators
+	 */
+	class SplitMix64 {
+	private:
+		/**
+		 * The state
+		 */
+		uint64_t state;
+
+	public:
+		/**
+		 * The type of the generated values
+		 */
+		using result_type = uint64_t;
+
+		/**
+		 * Creates a generator
+		 * @param seed The seed
+		 */
+		constexpr SplitMix64(uint64_t seed) : state(seed) {}
+
+		/**
+		 * Generates the next value
+		 * @returns The value
+		 */
+		constexpr uint64_t next() {
+			uint64_t z = (state += 0x9E3779B97F4A7C15);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+			return z ^ (z >> 31);
+		}
+
+		/**
+		 * Generates the next value
+		 * @returns The value
+		 */
+		constexpr uint64_t operator()() {
+			return next();
+		}
+
+		/**
+		 * Gets the smallest value the generator produces
+		 * @returns The smallest value
+		 */
+		static constexpr uint64_t min() {
+			return 0;
+		}
+
+		/**
+		 * Gets the largest value the generator produces
+		 * @returns The largest value
+		 */
+		static constexpr uint64_t max() {
+			return std::numeric_limits<uint64_t>::max();
+		}
+	};
+
+	/**
+	 * The xoshiro256** generator, a fast general purpose generator with a period of 2^256 - 1
+	 * Every value depends on the previous one, so use jump() or longJump() to split off independent streams for threads
+	 */
+	class Xoshiro256 {
+	private:
+		/**
+		 * The state (never all zero)
+		 */
+		uint64_t state[4];
+
+		/**
+		 * Advances the state by the polynomial encoded in a jump table
+		 * @param table The jump polynomial
+		 */
+		void jump(const uint64_t (&table)[4]) {
+			uint64_t result[4] = {};
+			for (uint64_t word : table)
+				for (unsigned bit = 0; bit < 64; bit++) {
+					if (word & (uint64_t(1) << bit))
+						for (size_t i = 0; i < 4; i++)
+							result[i] ^= state[i];
+					next();
+				}
+			for (size_t i = 0; i < 4; i++)
+				state[i] = result[i];
+		}
+
+	public:
+		/**
+		 * The type of the generated values
+		 */
+		using result_type = uint64_t;
+
+		/**
+		 * Creates a generator
+		 * @param seed The seed (expanded to the full state with splitmix64)
+		 */
+		Xoshiro256(uint64_t seed = 0) {
+			SplitMix64 expander(seed);
+			for (uint64_t& word : state)
+				word = expander.next();
+		}
+
+		/**
+		 * Generates the next value
+		 * @returns The value
+		 */
+		inline uint64_t next() {
+			uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+			uint64_t shifted = state[1] << 17;
+			state[2] ^= state[0];
+			state[3] ^= state[1];
+			state[1] ^= state[2];
+			state[0] ^= state[3];
+			state[2] ^= shifted;
+			state[3] = rotateLeft(state[3], 45);
+			return result;
+		}
+
+		/**
+		 * Generates the next value
+		 * @returns The value
+		 */
+		inline uint64_t operator()() {
+			return next();
+		}
+
+		/**
+		 * Gets the smallest value the generator produces
+		 * @returns The smallest value
+		 */
+		static constexpr uint64_t min() {
+			return 0;
+		}
+
+		/**
+		 * Gets the largest value the generator produces
+		 * @returns The largest value
+		 */
+		static constexpr uint64_t max() {
+			return std::numeric_limits<uint64_t>::max();
+		}
+
+		/**
+		 * Generates values in bulk (the same values as calling next() count times)
+		 * @param out Where to store the values
+		 * @param count The number of values
+		 */
+		void fill(uint64_t* out, size_t count) {
+			// Keep the state in registers for the whole loop
+			uint64_t s0 = state[0], s1 = state[1], s2 = state[2], s3 = state[3];
+			for (size_t i = 0; i < count; i++) {
+				out[i] = rotateLeft(s1 * 5, 7) * 9;
+				uint64_t shifted = s1 << 17;
+				s2 ^= s0;
+				s3 ^= s1;
+				s1 ^= s2;
+				s0 ^= s3;
+				s2 ^= shifted;
+				s3 = rotateLeft(s3, 45);
+			}
+			state[0] = s0;
+			state[1] = s1;
+			state[2] = s2;
+			state[3] = s3;
+		}
+
+		/**
+		 * Advances the generator by 2^128 values, giving 2^128 non overlapping streams of 2^128 values
+		 */
+		void jump() {
+			static constexpr uint64_t table[4] = { 0x180EC6D33CFD0ABA, 0xD5A61266F0C9392C, 0xA9582618E03FC9AA, 0x39ABDC4529B1661C };
+			jump(table);
+		}
+
+		/**
+		 * Advances the generator by 2^192 values, giving 2^64 non overlapping groups of streams
+		 */
+		void longJump() {
+			static constexpr uint64_t table[4] = { 0x76E15D3EFEFDCBBF, 0xC5004E441C522FB3, 0x77710069854EE241, 0x39109BB02ACBE635 };
+			jump(table);
+		}
+	};
+
+	/**
+	 * The PCG64 (XSL RR 128/64) generator, a 128 bit linear congruential generator with a permuted output
+	 * Generators with different streams never overlap, and advance() skips ahead in logarithmic time
+	 */
+	class Pcg64 {
+	private:
+		/**
+		 * The multiplier of the underlying linear congruential generator
+		 */
+		static constexpr Uint128 multiplier = { 0x2360ED051FC65DA4, 0x4385DF649FCCF645 };
+
+		/**
+		 * The state
+		 */
+		Uint128 state;
+
+		/**
+		 * The increment, which selects the stream (always odd)
+		 */
+		Uint128 increment;
+
+		/**
+		 * Advances the generator by a 128 bit number of values
+		 * @param delta The number of values to skip
+		 */
+		void advance(Uint128 delta) {
+			Uint128 accumulatedMultiplier = { 0, 1 };
+			Uint128 accumulatedIncrement = { 0, 0 };
+			Uint128 currentMultiplier = multiplier;
+			Uint128 currentIncrement = increment;
+			for (unsigned bit = 0; bit < 128; bit++) {
+				uint64_t word = bit < 64 ? delta.low : delta.high;
+				if ((word >> (bit & 63)) & 1) {
+					accumulatedMultiplier = accumulatedMultiplier * currentMultiplier;
+					accumulatedIncrement = accumulatedIncrement * currentMultiplier + currentIncrement;
+				}
+				currentIncrement = (currentMultiplier + Uint128{ 0, 1 }) * currentIncrement;
+				currentMultiplier = currentMultiplier * currentMultiplier;
+			}
+			state = accumulatedMultiplier * state + accumulatedIncrement;
+		}
+
+	public:
+		/**
+		 * The type of the generated values
+		 */
+		using result_type = uint64_t;
+
+		/**
+		 * Creates a generator
+		 * @param seed The seed (expanded to 128 bits with splitmix64)
+		 * @param stream The stream, generators with different streams produce independent sequences
+		 */
+		Pcg64(uint64_t seed = 0, uint64_t stream = 0) {
+			SplitMix64 seedExpander(seed);
+			SplitMix64 streamExpander(stream ^ 0xDA3E39CB94B95BDB);
+			Uint128 initial = { seedExpander.next(), seedExpander.next() };
+			Uint128 sequence = { streamExpander.next(), streamExpander.next() };
+			increment = { (sequence.high << 1) | (sequence.low >> 63), (sequence.low << 1) | 1 };
+			state = { 0, 0 };
+			next();
+			state = state + initial;
+			next();
+		}
+
+		/**
+		 * Generates the next value
+		 * @returns The value
+		 */
+		inline uint64_t next() {
+			state = state * multiplier + increment;
+			return rotateRight(state.high ^ state.low, static_cast<unsigned>(state.high >> 58));
+		}
+
+		/**
+		 * Generates the next value
+		 * @returns The value
+		 */
+		inline uint64_t operator()() {
+			return next();
+		}
+
+		/**
+		 * Gets the smallest value the generator produces
+		 * @returns The smallest value
+		 */
+		static constexpr uint64_t min() {
+			return 0;
+		}
+
+		/**
+		 * Gets the largest value the generator produces
+		 * @returns The largest value
+		 */
+		static constexpr uint64_t max() {
+			return std::numeric_limits<uint64_t>::max();
+		}
+
+		/**
+		 * Generates values in bulk (the same values as calling next() count times)
+		 * @param out Where to store the values
+		 * @param count The number of values
+		 */
+		void fill(uint64_t* out, size_t count) {
+			for (size_t i = 0; i < count; i++)
+				out[i] = next();
+		}
+
+		/**
+		 * Skips ahead, as if next() was called a number of times
+		 * @param steps The number of values to skip
+		 */
+		void advance(uint64_t steps) {
+			advance(Uint128{ 0, steps });
+		}
+
+		/**
+		 * Advances the generator by 2^64 values, giving 2^64 non overlapping blocks within a stream
+		 */
+		void jump() {
+			advance(Uint128{ 1, 0 });
+		}
+	};
+
+	/**
+	 * The Philox 4x32-10 counter based generator
+	 * Each block of four 32 bit words is a pure function of the key, the block index and the stream, so any position can be
+	 * computed directly: generators with different streams are independent, discard() is constant time and bulk fills
+	 * run eight blocks per AVX2 register and split across threads
+	 */
+	class Philox {
+	private:
+		/**
+		 * The multiplier of the first pair of words
+		 */
+		static constexpr uint32_t multiplier0 = 0xD2511F53;
+
+		/**
+		 * The multiplier of the second pair of words
+		 */
+		static constexpr uint32_t multiplier1 = 0xCD9E8D57;
+
+		/**
+		 * The key increment of the first word
+		 */
+		static constexpr uint32_t weyl0 = 0x9E3779B9;
+
+		/**
+		 * The key increment of the second word
+		 */
+		static constexpr uint32_t weyl1 = 0xBB67AE85;
+
+		/**
+		 * The number of blocks a task generates when a fill is split across threads
+		 */
+		static constexpr size_t parallelGrain = 1 << 15;
+
+		/**
+		 * The key (from the seed)
+		 */
+		uint32_t key[2];
+
+		/**
+		 * The stream, stored in the upper half of the counter
+		 */
+		uint64_t stream;
+
+		/**
+		 * The index of the next block to generate
+		 */
+		uint64_t block = 0;
+
+		/**
+		 * The values of the last generated block
+		 */
+		uint64_t buffered[2] = {};
+
+		/**
+		 * The number of buffered values already returned (2 when the buffer is empty)
+		 */
+		size_t position = 2;
+
+		/**
+		 * Computes one block
+		 * @param index The index of the block
+		 * @param out Set to the two 64 bit values of the block
+		 */
+		void compute(uint64_t index, uint64_t* out) const {
+			uint32_t c0 = static_cast<uint32_t>(index), c1 = static_cast<uint32_t>(index >> 32);
+			uint32_t c2 = static_cast<uint32_t>(stream), c3 = static_cast<uint32_t>(stream >> 32);
+			uint32_t k0 = key[0], k1 = key[1];
+			for (int round = 0; round < 10; round++) {
+				uint64_t product0 = uint64_t(multiplier0) * c0;
+				uint64_t product1 = uint64_t(multiplier1) * c2;
+				uint32_t next0 = static_cast<uint32_t>(product1 >> 32) ^ c1 ^ k0;
+				uint32_t next2 = static_cast<uint32_t>(product0 >> 32) ^ c3 ^ k1;
+				c1 = static_cast<uint32_t>(product1);
+				c3 = static_cast<uint32_t>(product0);
+				c0 = next0;
+				c2 = next2;
+				k0 += weyl0;
+				k1 += weyl1;
+			}
+			out[0] = c0 | (uint64_t(c1) << 32);
+			out[1] = c2 | (uint64_t(c3) << 32);
+		}
+
+#ifdef ESSENTIALS_MATH_AVX2
+		/**
+		 * Multiplies eight 32 bit lanes by a constant
+		 * @param value The lanes
+		 * @param factor The constant in every even lane
+		 * @param high Set to the upper 32 bits of each product
+		 * @returns The lower 32 bits of each product
+		 */
+		__attribute__((target("avx2"))) static inline __m256i multiplyLanes(__m256i value, __m256i factor, __m256i& high) {
+			__m256i even = _mm256_mul_epu32(value, factor);
+			__m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), factor);
+			high = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+			return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+		}
+
+		/**
+		 * Computes consecutive blocks eight at a time with AVX2
+		 * @param first The index of the first block
+		 * @param count The number of blocks (a multiple of 8)
+		 * @param out Set to the two 64 bit values of each block
+		 */
+		__attribute__((target("avx2"))) void computeAvx2(uint64_t first, size_t count, uint64_t* out) const {
+			const __m256i m0 = _mm256_set1_epi64x(multiplier0);
+			const __m256i m1 = _mm256_set1_epi64x(multiplier1);
+			const __m256i streamLow = _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(stream)));
+			const __m256i streamHigh = _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(stream >> 32)));
+			for (size_t b = 0; b < count; b += 8) {
+				alignas(32) uint32_t indexLow[8], indexHigh[8];
+				for (size_t lane = 0; lane < 8; lane++) {
+					uint64_t index = first + b + lane;
+					indexLow[lane] = static_cast<uint32_t>(index);
+					indexHigh[lane] = static_cast<uint32_t>(index >> 32);
+				}
+				__m256i c0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(indexLow));
+				__m256i c1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(indexHigh));
+				__m256i c2 = streamLow;
+				__m256i c3 = streamHigh;
+				uint32_t k0 = key[0], k1 = key[1];
+				for (int round = 0; round < 10; round++) {
+					__m256i high0, high1;
+					__m256i low0 = multiplyLanes(c0, m0, high0);
+					__m256i low1 = multiplyLanes(c2, m1, high1);
+					c0 = _mm256_xor_si256(_mm256_xor_si256(high1, c1), _mm256_set1_epi32(static_cast<int>(k0)));
+					c2 = _mm256_xor_si256(_mm256_xor_si256(high0, c3), _mm256_set1_epi32(static_cast<int>(k1)));
+					c1 = low1;
+					c3 = low0;
+					k0 += weyl0;
+					k1 += weyl1;
+				}
+
+				// Transpose the lanes back into blocks of four consecutive words
+				__m256i t0 = _mm256_unpacklo_epi32(c0, c1);
+				__m256i t1 = _mm256_unpackhi_epi32(c0, c1);
+				__m256i t2 = _mm256_unpacklo_epi32(c2, c3);
+				__m256i t3 = _mm256_unpackhi_epi32(c2, c3);
+				__m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+				__m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+				__m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+				__m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+				__m256i* target = reinterpret_cast<__m256i*>(out + b * 2);
+				_mm256_storeu_si256(target, _mm256_permute2x128_si256(u0, u1, 0x20));
+				_mm256_storeu_si256(target + 1, _mm256_permute2x128_si256(u2, u3, 0x20));
+				_mm256_storeu_si256(target + 2, _mm256_permute2x128_si256(u0, u1, 0x31));
+				_mm256_storeu_si256(target + 3, _mm256_permute2x128_si256(u2, u3, 0x31));
+			}
+		}
+#endif
+
+		/**
+		 * Computes consecutive blocks
+		 * @param first The index of the first block
+		 * @param count The number of blocks
+		 * @param out Set to the two 64 bit values of each block
+		 */
+		void computeRange(uint64_t first, size_t count, uint64_t* out) const {
+			size_t done = 0;
+#ifdef ESSENTIALS_MATH_AVX2
+			if (count >= 8 && cpuSupportsAvx2()) {
+				done = count / 8 * 8;
+				computeAvx2(first, done, out);
+			}
+#endif
+			for (; done < count; done++)
+				compute(first + done, out + done * 2);
+		}
+
+	public:
+		/**
+		 * The type of the generated values
+		 */
+		using result_type = uint64_t;
+
+		/**
+		 * Creates a generator
+		 * @param seed The seed (used as the key)
+		 * @param stream The stream, generators with different streams produce independent sequences
+		 */
+		Philox(uint64_t seed = 0, uint64_t stream = 0) : key{ static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32) }, stream(stream) {}
+
+		/**
+		 * Generates the next value
+		 * @returns The value
+		 */
+		inline uint64_t next() {
+			if (position == 2) {
+				compute(block++, buffered);
+				position = 0;
+			}
+			return buffered[position++];
+		}
+
+		/**
+		 * Generates the next value
+		 * @returns The value
+		 */
+		inline uint64_t operator()() {
+			return next();
+		}
+
+		/**
+		 * Gets the smallest value the generator produces
+		 * @returns The smallest value
+		 */
+		static constexpr uint64_t min() {
+			return 0;
+		}
+
+		/**
+		 * Gets the largest value the generator produces
+		 * @returns The largest value
+		 */
+		static constexpr uint64_t max() {
+			return std::numeric_limits<uint64_t>::max();
+		}
+
+		/**
+		 * Generates values in bulk (the same values as calling next() count times), large fills run in parallel
+		 * @param out Where to store the values
+		 * @param count The number of values
+		 * @param pool The pool large fills run on
+		 */
+		void fill(uint64_t* out, size_t count, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+			while (count > 0 && position < 2) {
+				*out++ = buffered[position++];
+				count--;
+			}
+
+			size_t blocks = count / 2;
+			uint64_t first = block;
+			Threading::parallelFor(0, blocks, [&](size_t begin, size_t end) {
+				computeRange(first + begin, end - begin, out + begin * 2);
+			}, parallelGrain, pool);
+			block += blocks;
+
+			if (count % 2 != 0)
+				out[count - 1] = next();
+		}
+
+		/**
+		 * Skips ahead in constant time, as if next() was called a number of times
+		 * @param steps The number of values to skip
+		 */
+		void discard(uint64_t steps) {
+			while (steps > 0 && position < 2) {
+				position++;
+				steps--;
+			}
+			block += steps / 2;
+			if (steps % 2 != 0) {
+				compute(block++, buffered);
+				position = 1;
+			}
+		}
+	};
+
+	/**
+	 * Generates a uniformly distributed integer below a bound with Lemire's multiply and reject method (rarely divides)
+	 * @param engine The generator to draw from
+	 * @param bound The exclusive upper bound (greater than 0)
+	 * @returns An integer in [0, bound)
+	 */
+	template<typename E> uint64_t uniformBelow(E& engine, uint64_t bound) {
+		uint64_t value = engine.next();
+		uint64_t low = value * bound;
+		if (low < bound) {
+			uint64_t threshold = (0 - bound) % bound;
+			while (low < threshold) {
+				value = engine.next();
+				low = value * bound;
+			}
+		}
+		return multiplyHigh(value, bound);
+	}
+
+	/**
+	 * Generates a uniformly distributed integer in a range
+	 * @param engine The generator to draw from
+	 * @param min The smallest value
+	 * @param max The largest value (inclusive)
+	 * @returns An integer in [min, max]
+	 */
+	template<typename I, typename E> I uniformInt(E& engine, I min, I max) {
+		static_assert(std::is_integral_v<I>, "uniformInt needs an integer type");
+		using Unsigned = std::make_unsigned_t<I>;
+		uint64_t span = static_cast<Unsigned>(static_cast<Unsigned>(max) - static_cast<Unsigned>(min));
+		uint64_t offset = span == std::numeric_limits<uint64_t>::max() ? engine.next() : uniformBelow(engine, span + 1);
+		return static_cast<I>(static_cast<Unsigned>(min) + static_cast<Unsigned>(offset));
+	}
+
+	/**
+	 * Generates a uniformly distributed double from 53 random bits
+	 * @param engine The generator to draw from
+	 * @returns A double in [0, 1)
+	 */
+	template<typename E> double uniformDouble(E& engine) {
+		return static_cast<double>(engine.next() >> 11) * 0x1.0p-53;
+	}
+
+	/**
+	 * Generates a uniformly distributed float from 24 random bits
+	 * @param engine The generator to draw from
+	 * @returns A float in [0, 1)
+	 */
+	template<typename E> float uniformFloat(E& engine) {
+		return static_cast<float>(engine.next() >> 40) * 0x1.0p-24f;
+	}
+
+	/**
+	 * Generates a uniformly distributed value in a range
+	 * @param engine The generator to draw from
+	 * @param min The smallest value
+	 * @param max The end of the range (exclusive)
+	 * @returns A value in [min, max)
+	 */
+	template<typename T, typename E> T uniformReal(E& engine, T min, T max) {
+		static_assert(std::is_floating_point_v<T>, "uniformReal needs a floating point type");
+		if constexpr (std::is_same_v<T, float>) return min + (max - min) * uniformFloat(engine);
+		else return min + (max - min) * static_cast<T>(uniformDouble(engine));
+	}
+
+	/**
+	 * The layers of a ziggurat, covering the area under a decreasing density with rectangles of equal area
+	 * @tparam Layers The number of layers (a power of two)
+	 */
+	template<size_t Layers> struct ZigguratTable {
+		/**
+		 * The right edge of each layer, edges[0] is the width of the base layer (including the tail) and edges[1] is where
+		 * the tail starts
+		 */
+		double edges[Layers + 1];
+
+		/**
+		 * The density at each edge
+		 */
+		double heights[Layers + 1];
+
+		/**
+		 * Builds the layers
+		 * @param tail Where the tail starts
+		 * @param area The area of each layer
+		 * @param density The (unnormalized) density
+		 * @param inverse The inverse of the density
+		 */
+		template<typename F, typename G>
+		ZigguratTable(double tail, double area, F density, G inverse) {
+			edges[0] = area / density(tail);
+			edges[1] = tail;
+			for (size_t i = 1; i < Layers; i++) {
+				double height = density(edges[i]) + area / edges[i];
+				edges[i + 1] = height >= density(0) ? 0 : inverse(height);
+			}
+			edges[Layers] = 0;
+			for (size_t i = 0; i <= Layers; i++)
+				heights[i] = density(edges[i]);
+		}
+	};
+
+	/**
+	 * Gets the ziggurat for the standard normal distribution (Marsaglia and Tsang, 128 layers)
+	 * @returns The table (built on first use)
+	 */
+	inline const ZigguratTable<128>& normalZiggurat() {
+		static const ZigguratTable<128> table(3.442619855899, 9.91256303526217e-3,
+			[](double x) { return std::exp(-0.5 * x * x); }, [](double y) { return std::sqrt(-2 * std::log(y)); });
+		return table;
+	}
+
+	/**
+	 * Gets the ziggurat for the standard exponential distribution (Marsaglia and Tsang, 256 layers)
+	 * @returns The table (built on first use)
+	 */
+	inline const ZigguratTable<256>& exponentialZiggurat() {
+		static const ZigguratTable<256> table(7.69711747013104972, 3.949659822581572e-3,
+			[](double x) { return std::exp(-x); }, [](double y) { return -std::log(y); });
+		return table;
+	}
+
+	/**
+	 * Generates a value from the standard exponential distribution with the ziggurat method
+	 * About 98% of draws take one random value, a multiply and a compare
+	 * @param engine The generator to draw from
+	 * @returns A value with rate 1
+	 */
+	template<typename E> double exponential(E& engine) {
+		const ZigguratTable<256>& table = exponentialZiggurat();
+		while (true) {
+			uint64_t bits = engine.next();
+			size_t layer = bits & 0xFF;
+			double x = static_cast<double>(bits >> 11) * 0x1.0p-53 * table.edges[layer];
+			if (x < table.edges[layer + 1]) return x;
+			if (layer == 0) return table.edges[1] - std::log1p(-uniformDouble(engine));
+			double y = table.heights[layer + 1] + uniformDouble(engine) * (table.heights[layer] - table.heights[layer + 1]);
+			if (y < std::exp(-x)) return x;
+		}
+	}
+
+	/**
+	 * Generates a value from an exponential distribution
+	 * @param engine The generator to draw from
+	 * @param rate The rate (the inverse of the mean)
+	 * @returns The value
+	 */
+	template<typename E> double exponential(E& engine, double rate) {
+		return exponential(engine) / rate;
+	}
+
+	/**
+	 * Generates a value from the standard normal distribution with the ziggurat method
+	 * About 99% of draws take one random value, a multiply and a compare
+	 * @param engine The generator to draw from
+	 * @returns A value with mean 0 and standard deviation 1
+	 */
+	template<typename E> double normal(E& engine) {
+		const ZigguratTable<128>& table = normalZiggurat();
+		while (true) {
+			uint64_t bits = engine.next();
+			size_t layer = bits & 0x7F;
+			bool negative = (bits >> 7) & 1;
+			double x = static_cast<double>(bits >> 11) * 0x1.0p-53 * table.edges[layer];
+			if (x < table.edges[layer + 1]) return negative ? -x : x;
+			if (layer == 0) {
+				// Sample the tail beyond edges[1] with Marsaglia's method
+				double tail = table.edges[1];
+				double a, b;
+				do {
+					a = -std::log1p(-uniformDouble(engine)) / tail;
+					b = -std::log1p(-uniformDouble(engine));
+				} while (b + b < a * a);
+				return negative ? -(tail + a) : tail + a;
+			}
+			double y = table.heights[layer + 1] + uniformDouble(engine) * (table.heights[layer] - table.heights[layer + 1]);
+			if (y < std::exp(-0.5 * x * x)) return negative ? -x : x;
+		}
+	}
+
+	/**
+	 * Generates a value from a normal distribution
+	 * @param engine The generator to draw from
+	 * @param mean The mean
+	 * @param deviation The standard deviation
+	 * @returns The value
+	 */
+	template<typename E> double normal(E& engine, double mean, double deviation) {
+		return mean + deviation * normal(engine);
+	}
+
+	/**
+	 * Fills an array with uniformly distributed values, drawing the random bits in bulk with the generator's fill
+	 * @param engine The generator to draw from
+	 * @param out Where to store the values
+	 * @param count The number of values
+	 * @param min The smallest value
+	 * @param max The end of the range (exclusive)
+	 */
+	template<typename T, typename E> void fillUniform(E& engine, T* out, size_t count, T min = T(0), T max = T(1)) {
+		static_assert(std::is_floating_point_v<T>, "fillUniform needs a floating point type");
+		constexpr size_t chunk = 256;
+		uint64_t bits[chunk];
+		T scale = max - min;
+		for (size_t done = 0; done < count; done += chunk) {
+			size_t todo = count - done < chunk ? count - done : chunk;
+			engine.fill(bits, todo);
+			T* target = out + done;
+			for (size_t i = 0; i < todo; i++) {
+				if constexpr (std::is_same_v<T, float>) target[i] = min + scale * (static_cast<float>(static_cast<uint32_t>(bits[i] >> 40)) * 0x1.0p-24f);
+				else target[i] = min + scale * static_cast<T>(static_cast<double>(bits[i] >> 11) * 0x1.0p-53);
+			}
+		}
+	}
+
+	/**
+	 * Fills an array with normally distributed values
+	 * @param engine The generator to draw from
+	 * @param out Where to store the values
+	 * @param count The number of values
+	 * @param mean The mean
+	 * @param deviation The standard deviation
+	 */
+	template<typename T, typename E> void fillNormal(E& engine, T* out, size_t count, T mean = T(0), T deviation = T(1)) {
+		for (size_t i = 0; i < count; i++)
+			out[i] = static_cast<T>(mean + deviation * normal(engine));
+	}
+
+	/**
+	 * Fills an array with exponentially distributed values
+	 * @param engine The generator to draw from
+	 * @param out Where to store the values
+	 * @param count The number of values
+	 * @param rate The rate (the inverse of the mean)
+	 */
+	template<typename T, typename E> void fillExponential(E& engine, T* out, size_t count, T rate = T(1)) {
+		for (size_t i = 0; i < count; i++)
+			out[i] = static_cast<T>(exponential(engine) / rate);
+	}
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
@@ -0,0 +1,804 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ESSENTIALS_MATH_SSE2
+#endif
+
+#if defined(ESSENTIALS_MATH_SSE2) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ESSENTIALS_MATH_AVX2
+#endif
+
+#ifdef __has_builtin
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define ESSENTIALS_MATH_CONSTANT_EVALUATED
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 9
+#define ESSENTIALS_MATH_CONSTANT_EVALUATED
+#endif
+
+/**
+ * The namespace for math in the essentials library
+ */
+namespace Essentials::Math {
+
+	/**
+	 * A namespace alias to the math namespace
+	 */
+	namespace ma = Math;
+
+	/**
+	 * Checks if the current call is being evaluated at compile time, so constexpr functions can switch to SIMD at runtime
+	 * @returns Whether or not the call is a constant evaluation (always true when the compiler can't tell)
+	 */
+	constexpr bool isConstantEvaluated() {
+#ifdef ESSENTIALS_MATH_CONSTANT_EVALUATED
+		return __builtin_is_constant_evaluated();
+#else
+		return true;
+#endif
+	}
+
+	/**
+	 * Checks if the current cpu supports AVX2 and FMA (checked once and cached)
+	 * @returns Whether or not AVX2 and FMA kernels may be used
+	 */
+	inline bool cpuSupportsFma() {
+#if defined(__AVX2__) && defined(__FMA__)
+		return true;
+#elif defined(ESSENTIALS_MATH_AVX2)
+		static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+		return supported;
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * Checks if the current cpu supports AVX2 (checked once and cached)
+	 * @returns Whether or not AVX2 kernels may be used
+	 */
+	inline bool cpuSupportsAvx2() {
+#if defined(__AVX2__)
+		return true;
+#elif defined(ESSENTIALS_MATH_AVX2)
+		static const bool supported = __builtin_cpu_supports("avx2");
+		return supported;
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * A register of Width lanes of T with the operations math kernels are written in terms of
+	 * Only the widths the target has registers for are native, the primary template covers single lanes
+	 */
+	template<typename T, size_t Width = 1> struct SimdPack {
+		/**
+		 * Whether or not the pack maps to a hardware register
+		 */
+		static constexpr bool native = false;
+
+		/**
+		 * The number of lanes
+		 */
+		static constexpr size_t width = 1;
+
+		/**
+		 * The register type
+		 */
+		using Register = T;
+
+		/**
+		 * Sets every lane to a value
+		 * @param value The value
+		 * @returns The register
+		 */
+		static inline Register broadcast(T value) {
+			return value;
+		}
+
+		/**
+		 * Loads lanes from memory (no alignment needed)
+		 * @param source The first lane
+		 * @returns The register
+		 */
+		static inline Register load(const T* source) {
+			return *source;
+		}
+
+		/**
+		 * Stores lanes to memory (no alignment needed)
+		 * @param destination The first lane
+		 * @param value The register
+		 */
+		static inline void store(T* destination, Register value) {
+			*destination = value;
+		}
+
+		/**
+		 * Adds lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a + b
+		 */
+		static inline Register add(Register a, Register b) {
+			return a + b;
+		}
+
+		/**
+		 * Subtracts lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a - b
+		 */
+		static inline Register subtract(Register a, Register b) {
+			return a - b;
+		}
+
+		/**
+		 * Multiplies lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a * b
+		 */
+		static inline Register multiply(Register a, Register b) {
+			return a * b;
+		}
+
+		/**
+		 * Divides lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a / b
+		 */
+		static inline Register divide(Register a, Register b) {
+			return a / b;
+		}
+
+		/**
+		 * Takes the square root of each lane
+		 * @param value The register
+		 * @returns The lanewise square root
+		 */
+		static inline Register sqrt(Register value) {
+			return std::sqrt(value);
+		}
+
+		/**
+		 * Multiplies and adds lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @param c The register to add
+		 * @returns a * b + c
+		 */
+		static inline Register multiplyAdd(Register a, Register b, Register c) {
+			return a * b + c;
+		}
+
+		/**
+		 * Gets the smaller of each pair of lanes (b when they are equal or either is NaN, like minps)
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns The lanewise minimum
+		 */
+		static inline Register min(Register a, Register b) {
+			return a < b ? a : b;
+		}
+
+		/**
+		 * Gets the larger of each pair of lanes (b when they are equal or either is NaN, like maxps)
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns The lanewise maximum
+		 */
+		static inline Register max(Register a, Register b) {
+			return b < a ? a : b;
+		}
+
+		/**
+		 * Adds the lanes of a register together
+		 * @param value The register
+		 * @returns The sum of the lanes
+		 */
+		static inline T sum(Register value) {
+			return value;
+		}
+	};
+
+#ifdef ESSENTIALS_MATH_SSE2
+	/**
+	 * Four float lanes in an SSE register
+	 */
+	template<> struct SimdPack<float, 4> {
+		/**
+		 * Whether or not the pack maps to a hardware register
+		 */
+		static constexpr bool native = true;
+
+		/**
+		 * The number of lanes
+		 */
+		static constexpr size_t width = 4;
+
+		/**
+		 * The register type
+		 */
+		using Register = __m128;
+
+		/**
+		 * Sets every lane to a value
+		 * @param value The value
+		 * @returns The register
+		 */
+		static inline Register broadcast(float value) {
+			return _mm_set1_ps(value);
+		}
+
+		/**
+		 * Loads lanes from memory (no alignment needed)
+		 * @param source The first lane
+		 * @returns The register
+		 */
+		static inline Register load(const float* source) {
+			return _mm_loadu_ps(source);
+		}
+
+		/**
+		 * Stores lanes to memory (no alignment needed)
+		 * @param destination The first lane
+		 * @param value The register
+		 */
+		static inline void store(float* destination, Register value) {
+			_mm_storeu_ps(destination, value);
+		}
+
+		/**
+		 * Adds lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a + b
+		 */
+		static inline Register add(Register a, Register b) {
+			return _mm_add_ps(a, b);
+		}
+
+		/**
+		 * Subtracts lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a - b
+		 */
+		static inline Register subtract(Register a, Register b) {
+			return _mm_sub_ps(a, b);
+		}
+
+		/**
+		 * Multiplies lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a * b
+		 */
+		static inline Register multiply(Register a, Register b) {
+			return _mm_mul_ps(a, b);
+		}
+
+		/**
+		 * Divides lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a / b
+		 */
+		static inline Register divide(Register a, Register b) {
+			return _mm_div_ps(a, b);
+		}
+
+		/**
+		 * Takes the square root of each lane
+		 * @param value The register
+		 * @returns The lanewise square root
+		 */
+		static inline Register sqrt(Register value) {
+			return _mm_sqrt_ps(value);
+		}
+
+		/**
+		 * Multiplies and adds lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @param c The register to add
+		 * @returns a * b + c
+		 */
+		static inline Register multiplyAdd(Register a, Register b, Register c) {
+			return _mm_add_ps(_mm_mul_ps(a, b), c);
+		}
+
+		/**
+		 * Gets the smaller of each pair of lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns The lanewise minimum
+		 */
+		static inline Register min(Register a, Register b) {
+			return _mm_min_ps(a, b);
+		}
+
+		/**
+		 * Gets the larger of each pair of lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns The lanewise maximum
+		 */
+		static inline Register max(Register a, Register b) {
+			return _mm_max_ps(a, b);
+		}
+
+		/**
+		 * Adds the lanes of a register together
+		 * @param value The register
+		 * @returns The sum of the lanes
+		 */
+		static inline float sum(Register value) {
+			__m128 pairs = _mm_add_ps(value, _mm_movehl_ps(value, value));
+			return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+		}
+	};
+
+	/**
+	 * Two double lanes in an SSE register
+	 */
+	template<> struct SimdPack<double, 2> {
+		/**
+		 * Whether or not the pack maps to a hardware register
+		 */
+		static constexpr bool native = true;
+
+		/**
+		 * The number of lanes
+		 */
+		static constexpr size_t width = 2;
+
+		/**
+		 * The register type
+		 */
+		using Register = __m128d;
+
+		/**
+		 * Sets every lane to a value
+		 * @param value The value
+		 * @returns The register
+		 */
+		static inline Register broadcast(double value) {
+			return _mm_set1_pd(value);
+		}
+
+		/**
+		 * Loads lanes from memory (no alignment needed)
+		 * @param source The first lane
+		 * @returns The register
+		 */
+		static inline Register load(const double* source) {
+			return _mm_loadu_pd(source);
+		}
+
+		/**
+		 * Stores lanes to memory (no alignment needed)
+		 * @param destination The first lane
+		 * @param value The register
+		 */
+		static inline void store(double* destination, Register value) {
+			_mm_storeu_pd(destination, value);
+		}
+
+		/**
+		 * Adds lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a + b
+		 */
+		static inline Register add(Register a, Register b) {
+			return _mm_add_pd(a, b);
+		}
+
+		/**
+		 * Subtracts lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a - b
+		 */
+		static inline Register subtract(Register a, Register b) {
+			return _mm_sub_pd(a, b);
+		}
+
+		/**
+		 * Multiplies lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a * b
+		 */
+		static inline Register multiply(Register a, Register b) {
+			return _mm_mul_pd(a, b);
+		}
+
+		/**
+		 * Divides lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a / b
+		 */
+		static inline Register divide(Register a, Register b) {
+			return _mm_div_pd(a, b);
+		}
+
+		/**
+		 * Takes the square root of each lane
+		 * @param value The register
+		 * @returns The lanewise square root
+		 */
+		static inline Register sqrt(Register value) {
+			return _mm_sqrt_pd(value);
+		}
+
+		/**
+		 * Multiplies and adds lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @param c The register to add
+		 * @returns a * b + c
+		 */
+		static inline Register multiplyAdd(Register a, Register b, Register c) {
+			return _mm_add_pd(_mm_mul_pd(a, b), c);
+		}
+
+		/**
+		 * Gets the smaller of each pair of lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns The lanewise minimum
+		 */
+		static inline Register min(Register a, Register b) {
+			return _mm_min_pd(a, b);
+		}
+
+		/**
+		 * Gets the larger of each pair of lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns The lanewise maximum
+		 */
+		static inline Register max(Register a, Register b) {
+			return _mm_max_pd(a, b);
+		}
+
+		/**
+		 * Adds the lanes of a register together
+		 * @param value The register
+		 * @returns The sum of the lanes
+		 */
+		static inline double sum(Register value) {
+			return _mm_cvtsd_f64(_mm_add_sd(value, _mm_unpackhi_pd(value, value)));
+		}
+	};
+#endif
+
+#ifdef __AVX__
+	/**
+	 * Eight float lanes in an AVX register
+	 */
+	template<> struct SimdPack<float, 8> {
+		/**
+		 * Whether or not the pack maps to a hardware register
+		 */
+		static constexpr bool native = true;
+
+		/**
+		 * The number of lanes
+		 */
+		static constexpr size_t width = 8;
+
+		/**
+		 * The register type
+		 */
+		using Register = __m256;
+
+		/**
+		 * Sets every lane to a value
+		 * @param value The value
+		 * @returns The register
+		 */
+		static inline Register broadcast(float value) {
+			return _mm256_set1_ps(value);
+		}
+
+		/**
+		 * Loads lanes from memory (no alignment needed)
+		 * @param source The first lane
+		 * @returns The register
+		 */
+		static inline Register load(const float* source) {
+			return _mm256_loadu_ps(source);
+		}
+
+		/**
+		 * Stores lanes to memory (no alignment needed)
+		 * @param destination The first lane
+		 * @param value The register
+		 */
+		static inline void store(float* destination, Register value) {
+			_mm256_storeu_ps(destination, value);
+		}
+
+		/**
+		 * Adds lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a + b
+		 */
+		static inline Register add(Register a, Register b) {
+			return _mm256_add_ps(a, b);
+		}
+
+		/**
+		 * Subtracts lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a - b
+		 */
+		static inline Register subtract(Register a, Register b) {
+			return _mm256_sub_ps(a, b);
+		}
+
+		/**
+		 * Multiplies lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a * b
+		 */
+		static inline Register multiply(Register a, Register b) {
+			return _mm256_mul_ps(a, b);
+		}
+
+		/**
+		 * Divides lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a / b
+		 */
+		static inline Register divide(Register a, Register b) {
+			return _mm256_div_ps(a, b);
+		}
+
+		/**
+		 * Takes the square root of each lane
+		 * @param value The register
+		 * @returns The lanewise square root
+		 */
+		static inline Register sqrt(Register value) {
+			return _mm256_sqrt_ps(value);
+		}
+
+		/**
+		 * Multiplies and adds lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @param c The register to add
+		 * @returns a * b + c
+		 */
+		static inline Register multiplyAdd(Register a, Register b, Register c) {
+#ifdef __FMA__
+			return _mm256_fmadd_ps(a, b, c);
+#else
+			return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+		}
+
+		/**
+		 * Gets the smaller of each pair of lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns The lanewise minimum
+		 */
+		static inline Register min(Register a, Register b) {
+			return _mm256_min_ps(a, b);
+		}
+
+		/**
+		 * Gets the larger of each pair of lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns The lanewise maximum
+		 */
+		static inline Register max(Register a, Register b) {
+			return _mm256_max_ps(a, b);
+		}
+
+		/**
+		 * Adds the lanes of a register together
+		 * @param value The register
+		 * @returns The sum of the lanes
+		 */
+		static inline float sum(Register value) {
+			return SimdPack<float, 4>::sum(_mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1)));
+		}
+	};
+
+	/**
+	 * Four double lanes in an AVX register
+	 */
+	template<> struct SimdPack<double, 4> {
+		/**
+		 * Whether or not the pack maps to a hardware register
+		 */
+		static constexpr bool native = true;
+
+		/**
+		 * The number of lanes
+		 */
+		static constexpr size_t width = 4;
+
+		/**
+		 * The register type
+		 */
+		using Register = __m256d;
+
+		/**
+		 * Sets every lane to a value
+		 * @param value The value
+		 * @returns The register
+		 */
+		static inline Register broadcast(double value) {
+			return _mm256_set1_pd(value);
+		}
+
+		/**
+		 * Loads lanes from memory (no alignment needed)
+		 * @param source The first lane
+		 * @returns The register
+		 */
+		static inline Register load(const double* source) {
+			return _mm256_loadu_pd(source);
+		}
+
+		/**
+		 * Stores lanes to memory (no alignment needed)
+		 * @param destination The first lane
+		 * @param value The register
+		 */
+		static inline void store(double* destination, Register value) {
+			_mm256_storeu_pd(destination, value);
+		}
+
+		/**
+		 * Adds lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a + b
+		 */
+		static inline Register add(Register a, Register b) {
+			return _mm256_add_pd(a, b);
+		}
+
+		/**
+		 * Subtracts lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a - b
+		 */
+		static inline Register subtract(Register a, Register b) {
+			return _mm256_sub_pd(a, b);
+		}
+
+		/**
+		 * Multiplies lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a * b
+		 */
+		static inline Register multiply(Register a, Register b) {
+			return _mm256_mul_pd(a, b);
+		}
+
+		/**
+		 * Divides lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns a / b
+		 */
+		static inline Register divide(Register a, Register b) {
+			return _mm256_div_pd(a, b);
+		}
+
+		/**
+		 * Takes the square root of each lane
+		 * @param value The register
+		 * @returns The lanewise square root
+		 */
+		static inline Register sqrt(Register value) {
+			return _mm256_sqrt_pd(value);
+		}
+
+		/**
+		 * Multiplies and adds lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @param c The register to add
+		 * @returns a * b + c
+		 */
+		static inline Register multiplyAdd(Register a, Register b, Register c) {
+#ifdef __FMA__
+			return _mm256_fmadd_pd(a, b, c);
+#else
+			return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+		}
+
+		/**
+		 * Gets the smaller of each pair of lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns The lanewise minimum
+		 */
+		static inline Register min(Register a, Register b) {
+			return _mm256_min_pd(a, b);
+		}
+
+		/**
+		 * Gets the larger of each pair of lanes
+		 * @param a The first register
+		 * @param b The second register
+		 * @returns The lanewise maximum
+		 */
+		static inline Register max(Register a, Register b) {
+			return _mm256_max_pd(a, b);
+		}
+
+		/**
+		 * Adds the lanes of a register together
+		 * @param value The register
+		 * @returns The sum of the lanes
+		 */
+		static inline double sum(Register value) {
+			return SimdPack<double, 2>::sum(_mm_add_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1)));
+		}
+	};
+#endif
+
+	/**
+	 * The widest native pack of T that evenly divides a number of lanes (1 if there is none)
+	 */
+	template<typename T, size_t Lanes> inline constexpr size_t simdWidth =
+		Lanes % 8 == 0 && SimdPack<T, 8>::native ? 8 :
+		Lanes % 4 == 0 && SimdPack<T, 4>::native ? 4 :
+		Lanes % 2 == 0 && SimdPack<T, 2>::native ? 2 : 1;
+
+	/**
+	 * The widest native pack of T
+	 */
+	template<typename T> inline constexpr size_t simdMaxWidth = simdWidth<T, 8>;
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
@@ -0,0 +1,965 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "Simd.h"
+#include "../DataStructures/Allocator.h"
+#include "../DataStructures/Memory.h"
+#include "../Threading/Parallel.h"
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * The namespace for math in the essentials library
+ */
+namespace Essentials::Math {
+
+	/**
+	 * A namespace alias to the math namespace
+	 */
+	namespace ma = Math;
+
+	/**
+	 * A vector of N components, usable in constant expressions
+	 * At runtime float and double vectors of 2, 3, 4 and 8 components run on SSE (or AVX when compiled for it) registers,
+	 * 3 component vectors are padded to 4 lanes so they fill a register (the padding lane is never read)
+	 * @tparam N The number of components
+	 */
+	template<typename T, size_t N> class Vector {
+	private:
+		static_assert(N > 0, "A vector must have at least one component");
+
+		template<typename, size_t> friend class Vector;
+
+		/**
+		 * The number of stored lanes (N rounded up to a full register for 3 components)
+		 */
+		static constexpr size_t lanes = N == 3 && simdWidth<T, 4> > 1 ? 4 : N;
+
+		/**
+		 * The registers the lanes are processed in
+		 */
+		using Pack = SimdPack<T, simdWidth<T, lanes>>;
+
+		/**
+		 * The alignment of the components (a register when the vector is processed in registers)
+		 */
+		static constexpr size_t alignment = Pack::native ? Pack::width * sizeof(T) : alignof(T);
+
+		/**
+		 * The components, followed by any padding lanes
+		 */
+		alignas(alignment) T elements[lanes];
+
+		/**
+		 * Combines the components of two vectors pairwise
+		 * @param other The other vector
+		 * @param scalar The operation on two components, used in constant expressions and for non simd types
+		 * @param packed The same operation on two registers of the Pack type
+		 * @returns The combined vector
+		 */
+		template<typename S, typename P>
+		constexpr Vector combine(const Vector& other, S scalar, P packed) const {
+			Vector result;
+			if constexpr (Pack::native) {
+				if (!isConstantEvaluated()) {
+					for (size_t i = 0; i < lanes; i += Pack::width)
+						Pack::store(result.elements + i, packed(Pack::load(elements + i), Pack::load(other.elements + i)));
+					return result;
+				}
+			}
+			for (size_t i = 0; i < N; i++)
+				result.elements[i] = scalar(elements[i], other.elements[i]);
+			return result;
+		}
+
+		/**
+		 * Takes the square root of a value, with Newton's method in constant expressions
+		 * @param value The value (not negative)
+		 * @returns The square root
+		 */
+		static constexpr T root(T value) {
+			if (!isConstantEvaluated()) return std::sqrt(value);
+			if (!(value > T())) return T();
+			T guess = value > T(1) ? value : T(1);
+			while (true) {
+				T next = (guess + value / guess) / T(2);
+				if (!(next < guess)) return guess;
+				guess = next;
+			}
+		}
+
+	public:
+		/**
+		 * The type of the components
+		 */
+		using Element = T;
+
+		/**
+		 * Creates a vector of zeros
+		 */
+		constexpr Vector() : elements{} {}
+
+		/**
+		 * Creates a vector from its components
+		 * @param values The components (exactly N)
+		 */
+		template<typename... A, typename = std::enable_if_t<sizeof...(A) == N && (std::is_convertible_v<A, T> && ...)>>
+		constexpr Vector(A... values) : elements{ static_cast<T>(values)... } {}
+
+		/**
+		 * Creates a vector with every component set to a value
+		 * @param value The value
+		 * @returns The vector
+		 */
+		static constexpr Vector filled(T value) {
+			Vector result;
+			for (size_t i = 0; i < lanes; i++)
+				result.elements[i] = value;
+			return result;
+		}
+
+		/**
+		 * Gets the number of components
+		 * @returns The number of components
+		 */
+		static constexpr size_t size() {
+			return N;
+		}
+
+		/**
+		 * Gets a component
+		 * @param index The index of the component
+		 * @returns The component
+		 */
+		constexpr T& operator[](size_t index) {
+			assert(index < N);
+			return elements[index];
+		}
+
+		/**
+		 * Gets a component
+		 * @param index The index of the component
+		 * @returns The component
+		 */
+		constexpr const T& operator[](size_t index) const {
+			assert(index < N);
+			return elements[index];
+		}
+
+		/**
+		 * Gets the first component
+		 * @returns The component
+		 */
+		constexpr T x() const {
+			return elements[0];
+		}
+
+		/**
+		 * Gets the second component
+		 * @returns The component
+		 */
+		constexpr T y() const {
+			static_assert(N > 1, "The vector has no y component");
+			return elements[1];
+		}
+
+		/**
+		 * Gets the third component
+		 * @returns The component
+		 */
+		constexpr T z() const {
+			static_assert(N > 2, "The vector has no z component");
+			return elements[2];
+		}
+
+		/**
+		 * Gets the fourth component
+		 * @returns The component
+		 */
+		constexpr T w() const {
+			static_assert(N > 3, "The vector has no w component");
+			return elements[3];
+		}
+
+		/**
+		 * Gets the components
+		 * @returns The first component
+		 */
+		constexpr T* data() {
+			return elements;
+		}
+
+		/**
+		 * Gets the components
+		 * @returns The first component
+		 */
+		constexpr const T* data() const {
+			return elements;
+		}
+
+		/**
+		 * Adds two vectors
+		 * @param other The vector to add
+		 * @returns The sum
+		 */
+		constexpr Vector operator+(const Vector& other) const {
+			return combine(other, [](T a, T b) { return a + b; }, [](auto a, auto b) { return Pack::add(a, b); });
+		}
+
+		/**
+		 * Subtracts two vectors
+		 * @param other The vector to subtract
+		 * @returns The difference
+		 */
+		constexpr Vector operator-(const Vector& other) const {
+			return combine(other, [](T a, T b) { return a - b; }, [](auto a, auto b) { return Pack::subtract(a, b); });
+		}
+
+		/**
+		 * Multiplies two vectors component by component
+		 * @param other The vector to multiply by
+		 * @returns The product
+		 */
+		constexpr Vector operator*(const Vector& other) const {
+			return combine(other, [](T a, T b) { return a * b; }, [](auto a, auto b) { return Pack::multiply(a, b); });
+		}
+
+		/**
+		 * Divides two vectors component by component
+		 * @param other The vector to divide by
+		 * @returns The quotient
+		 */
+		constexpr Vector operator/(const Vector& other) const {
+			return combine(other, [](T a, T b) { return a / b; }, [](auto a, auto b) { return Pack::divide(a, b); });
+		}
+
+		/**
+		 * Multiplies every component by a value
+		 * @param value The value
+		 * @returns The scaled vector
+		 */
+		constexpr Vector operator*(T value) const {
+			return *this * filled(value);
+		}
+
+		/**
+		 * Multiplies every component of a vector by a value
+		 * @param value The value
+		 * @param vector The vector
+		 * @returns The scaled vector
+		 */
+		friend constexpr Vector operator*(T value, const Vector& vector) {
+			return vector * filled(value);
+		}
+
+		/**
+		 * Divides every component by a value
+		 * @param value The value
+		 * @returns The scaled vector
+		 */
+		constexpr Vector operator/(T value) const {
+			return *this / filled(value);
+		}
+
+		/**
+		 * Negates every component
+		 * @returns The negated vector
+		 */
+		constexpr Vector operator-() const {
+			return Vector() - *this;
+		}
+
+		/**
+		 * Adds a vector to this vector
+		 * @param other The vector to add
+		 * @returns This vector
+		 */
+		constexpr Vector& operator+=(const Vector& other) {
+			return *this = *this + other;
+		}
+
+		/**
+		 * Subtracts a vector from this vector
+		 * @param other The vector to subtract
+		 * @returns This vector
+		 */
+		constexpr Vector& operator-=(const Vector& other) {
+			return *this = *this - other;
+		}
+
+		/**
+		 * Multiplies this vector by another component by component
+		 * @param other The vector to multiply by
+		 * @returns This vector
+		 */
+		constexpr Vector& operator*=(const Vector& other) {
+			return *this = *this * other;
+		}
+
+		/**
+		 * Divides this vector by another component by component
+		 * @param other The vector to divide by
+		 * @returns This vector
+		 */
+		constexpr Vector& operator/=(const Vector& other) {
+			return *this = *this / other;
+		}
+
+		/**
+		 * Multiplies every component by a value
+		 * @param value The value
+		 * @returns This vector
+		 */
+		constexpr Vector& operator*=(T value) {
+			return *this = *this * value;
+		}
+
+		/**
+		 * Divides every component by a value
+		 * @param value The value
+		 * @returns This vector
+		 */
+		constexpr Vector& operator/=(T value) {
+			return *this = *this / value;
+		}
+
+		/**
+		 * Checks if two vectors have the same components
+		 * @param other The vector to compare with
+		 * @returns Whether or not the vectors are equal
+		 */
+		constexpr bool operator==(const Vector& other) const {
+			for (size_t i = 0; i < N; i++)
+				if (!(elements[i] == other.elements[i])) return false;
+			return true;
+		}
+
+		/**
+		 * Checks if two vectors have different components
+		 * @param other The vector to compare with
+		 * @returns Whether or not the vectors are different
+		 */
+		constexpr bool operator!=(const Vector& other) const {
+			return !(*this == other);
+		}
+
+		/**
+		 * Gets the smaller of each pair of components (the other vector's when they are equal or either is NaN)
+		 * @param other The other vector
+		 * @returns The componentwise minimum
+		 */
+		constexpr Vector min(const Vector& other) const {
+			return combine(other, [](T a, T b) { return a < b ? a : b; }, [](auto a, auto b) { return Pack::min(a, b); });
+		}
+
+		/**
+		 * Gets the larger of each pair of components (the other vector's when they are equal or either is NaN)
+		 * @param other The other vector
+		 * @returns The componentwise maximum
+		 */
+		constexpr Vector max(const Vector& other) const {
+			return combine(other, [](T a, T b) { return b < a ? a : b; }, [](auto a, auto b) { return Pack::max(a, b); });
+		}
+
+		/**
+		 * Computes the dot product of two vectors
+		 * @param other The other vector
+		 * @returns The dot product
+		 */
+		constexpr T dot(const Vector& other) const {
+			if constexpr (Pack::native) {
+				if (!isConstantEvaluated()) {
+					if constexpr (lanes == N) {
+						typename Pack::Register sum = Pack::multiply(Pack::load(elements), Pack::load(other.elements));
+						for (size_t i = Pack::width; i < lanes; i += Pack::width)
+							sum = Pack::multiplyAdd(Pack::load(elements + i), Pack::load(other.elements + i), sum);
+						return Pack::sum(sum);
+					}
+					else {
+						// Only sum the real components, the padding lane is unspecified
+						alignas(alignment) T products[lanes] = {};
+						for (size_t i = 0; i < lanes; i += Pack::width)
+							Pack::store(products + i, Pack::multiply(Pack::load(elements + i), Pack::load(other.elements + i)));
+						T sum = products[0];
+						for (size_t i = 1; i < N; i++)
+							sum += products[i];
+						return sum;
+					}
+				}
+			}
+			T sum = T();
+			for (size_t i = 0; i < N; i++)
+				sum += elements[i] * other.elements[i];
+			return sum;
+		}
+
+		/**
+		 * Computes the cross product of two 3 component vectors
+		 * @param other The other vector
+		 * @returns The cross product
+		 */
+		constexpr Vector cross(const Vector& other) const {
+			static_assert(N == 3, "The cross product is only defined for 3 component vectors");
+#ifdef ESSENTIALS_MATH_SSE2
+			if constexpr (std::is_same_v<T, float>) {
+				if (!isConstantEvaluated()) {
+					__m128 a = _mm_loadu_ps(elements);
+					__m128 b = _mm_loadu_ps(other.elements);
+					__m128 aYzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+					__m128 bYzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+					__m128 difference = _mm_sub_ps(_mm_mul_ps(a, bYzx), _mm_mul_ps(aYzx, b));
+					Vector result;
+					_mm_storeu_ps(result.elements, _mm_shuffle_ps(difference, difference, _MM_SHUFFLE(3, 0, 2, 1)));
+					return result;
+				}
+			}
+#endif
+			return Vector(elements[1] * other.elements[2] - elements[2] * other.elements[1],
+				elements[2] * other.elements[0] - elements[0] * other.elements[2],
+				elements[0] * other.elements[1] - elements[1] * other.elements[0]);
+		}
+
+		/**
+		 * Computes the squared length of the vector
+		 * @returns The squared length
+		 */
+		constexpr T lengthSquared() const {
+			return dot(*this);
+		}
+
+		/**
+		 * Computes the length of the vector
+		 * @returns The length
+		 */
+		constexpr T length() const {
+			static_assert(std::is_floating_point_v<T>, "Lengths are only defined for floating point vectors");
+			return root(lengthSquared());
+		}
+
+		/**
+		 * Computes a vector in the same direction with a length of one
+		 * @returns The normalized vector (with non finite components if the length is zero)
+		 */
+		constexpr Vector normalized() const {
+			return *this * (T(1) / length());
+		}
+
+		/**
+		 * Interpolates linearly between this vector and another
+		 * @param target The vector to interpolate towards
+		 * @param amount How far to interpolate (0 gives this vector and 1 gives target)
+		 * @returns The interpolated vector
+		 */
+		constexpr Vector lerp(const Vector& target, T amount) const {
+			return *this + (target - *this) * amount;
+		}
+	};
+
+	/**
+	 * A batch of N component vectors stored as structure of arrays (every x, then every y, ...), so operations run on
+	 * whole registers of vectors at a time and large batches are split across threads
+	 * @tparam N The number of components of each vector
+	 */
+	template<typename T, size_t N, typename Allocator = DataStructures::HeapAllocator> class VectorBatch : private Allocator {
+	private:
+		static_assert(std::is_trivially_copyable_v<T>, "Vector batch components must be trivially copyable");
+
+		/**
+		 * The widest registers the components are processed in
+		 */
+		using Pack = SimdPack<T, simdMaxWidth<T>>;
+
+		/**
+		 * The granularity of the capacity, so every component array starts on a cache line
+		 */
+		static constexpr size_t stride = DataStructures::cacheLineSize % sizeof(T) == 0 ? DataStructures::cacheLineSize / sizeof(T) : 1;
+
+		/**
+		 * The number of vectors a task processes when an operation is split across threads
+		 */
+		static constexpr size_t parallelGrain = 1 << 16;
+
+		/**
+		 * The component arrays, each capacity elements long
+		 */
+		T* buffer = nullptr;
+
+		/**
+		 * The number of vectors
+		 */
+		size_t size = 0;
+
+		/**
+		 * The number of vectors there is room for
+		 */
+		size_t cap = 0;
+
+		/**
+		 * Gets the allocator
+		 * @returns The allocator
+		 */
+		Allocator& allocator() {
+			return *this;
+		}
+
+		/**
+		 * Moves the vectors to a buffer with a new capacity
+		 * @param num The new capacity (at least the current length)
+		 */
+		void realloc(size_t num) {
+			num = (num + stride - 1) / stride * stride;
+			T* newBuffer = num > 0 ? static_cast<T*>(allocator().allocate(num * N * sizeof(T), DataStructures::cacheLineSize)) : nullptr;
+			if (newBuffer != nullptr && buffer != nullptr)
+				for (size_t k = 0; k < N; k++)
+					std::memcpy(newBuffer + k * num, buffer + k * cap, size * sizeof(T));
+			if (buffer != nullptr)
+				allocator().deallocate(buffer, cap * N * sizeof(T), DataStructures::cacheLineSize);
+			buffer = newBuffer;
+			cap = num;
+		}
+
+		/**
+		 * Runs a kernel over a range of vectors a register at a time, with single lanes for the remainder
+		 * @param first The first vector
+		 * @param last One past the last vector
+		 * @param kernel Called as kernel(pack, index) for each register, where pack is the SimdPack to use
+		 */
+		template<typename F>
+		static void lanes(size_t first, size_t last, F&& kernel) {
+			size_t i = first;
+			if constexpr (Pack::native) {
+				size_t packed = first + (last - first) / Pack::width * Pack::width;
+				for (; i < packed; i += Pack::width)
+					kernel(Pack(), i);
+			}
+			for (; i < last; i++)
+				kernel(SimdPack<T>(), i);
+		}
+
+		/**
+		 * Runs a function over every vector, split across threads for large batches
+		 * @param body Called as body(first, last) for ranges of vectors
+		 * @param pool The pool to run on
+		 */
+		template<typename F>
+		void run(F&& body, Threading::ThreadPool& pool) const {
+			Threading::parallelFor(0, size, body, parallelGrain, pool);
+		}
+
+	public:
+		/**
+		 * Creates an empty batch
+		 * @param allocator The allocator to use
+		 */
+		VectorBatch(const Allocator& allocator = Allocator()) : Allocator(allocator) {}
+
+		/**
+		 * Creates a batch of zero vectors
+		 * @param count The number of vectors
+		 * @param allocator The allocator to use
+		 */
+		VectorBatch(size_t count, const Allocator& allocator = Allocator()) : Allocator(allocator) {
+			resize(count);
+		}
+
+		/**
+		 * Creates a copy of another batch
+		 * @param other The batch to copy
+		 */
+		VectorBatch(const VectorBatch& other) : Allocator(other) {
+			prepare(other.size);
+			if (other.size > 0)
+				for (size_t k = 0; k < N; k++)
+					std::memcpy(buffer + k * cap, other.buffer + k * other.cap, other.size * sizeof(T));
+			size = other.size;
+		}
+
+		/**
+		 * Takes the vectors of another batch, leaving it empty
+		 * @param other The batch to move from
+		 */
+		VectorBatch(VectorBatch&& other) noexcept : Allocator(std::move(static_cast<Allocator&>(other))), buffer(other.buffer), size(other.size), cap(other.cap) {
+			other.buffer = nullptr;
+			other.size = 0;
+			other.cap = 0;
+		}
+
+		/**
+		 * Replaces the vectors with a copy of another batch
+		 * @param other The batch to copy
+		 * @returns This batch
+		 */
+		VectorBatch& operator=(const VectorBatch& other) {
+			if (this == &other) return *this;
+			size = 0;
+			prepare(other.size);
+			if (other.size > 0)
+				for (size_t k = 0; k < N; k++)
+					std::memcpy(buffer + k * cap, other.buffer + k * other.cap, other.size * sizeof(T));
+			size = other.size;
+			return *this;
+		}
+
+		/**
+		 * Replaces the vectors with the vectors of another batch, leaving it empty
+		 * @param other The batch to move from
+		 * @returns This batch
+		 */
+		VectorBatch& operator=(VectorBatch&& other) noexcept {
+			if (this == &other) return *this;
+			size = 0;
+			realloc(0);
+			allocator() = std::move(static_cast<Allocator&>(other));
+			buffer = other.buffer;
+			size = other.size;
+			cap = other.cap;
+			other.buffer = nullptr;
+			other.size = 0;
+			other.cap = 0;
+			return *this;
+		}
+
+		/**
+		 * Frees resources
+		 */
+		~VectorBatch() {
+			size = 0;
+			realloc(0);
+		}
+
+		/**
+		 * Gets the number of vectors
+		 * @returns The number of vectors
+		 */
+		inline size_t length() const {
+			return size;
+		}
+
+		/**
+		 * Gets the number of vectors there is room for without reallocating
+		 * @returns The capacity
+		 */
+		inline size_t capacity() const {
+			return cap;
+		}
+
+		/**
+		 * Gets the array of one component of every vector
+		 * @param index The index of the component
+		 * @returns The first element of the component array (cache line aligned)
+		 */
+		inline T* component(size_t index) {
+			assert(index < N);
+			return buffer + index * cap;
+		}
+
+		/**
+		 * Gets the array of one component of every vector
+		 * @param index The index of the component
+		 * @returns The first element of the component array (cache line aligned)
+		 */
+		inline const T* component(size_t index) const {
+			assert(index < N);
+			return buffer + index * cap;
+		}
+
+		/**
+		 * Makes sure there is room for a number of vectors
+		 * @param num The number of vectors to prepare for
+		 */
+		void prepare(size_t num) {
+			if (num > cap) realloc(num);
+		}
+
+		/**
+		 * Changes the number of vectors, new vectors are zero
+		 * @param count The new number of vectors
+		 */
+		void resize(size_t count) {
+			prepare(count);
+			if (count > size)
+				for (size_t k = 0; k < N; k++)
+					std::fill(buffer + k * cap + size, buffer + k * cap + count, T());
+			size = count;
+		}
+
+		/**
+		 * Removes every vector, keeping the capacity
+		 */
+		void clear() {
+			size = 0;
+		}
+
+		/**
+		 * Adds a vector to the end of the batch
+		 * @param vector The vector to add
+		 */
+		void push(const Vector<T, N>& vector) {
+			if (size == cap) realloc(cap == 0 ? stride : cap * 2);
+			for (size_t k = 0; k < N; k++)
+				buffer[k * cap + size] = vector[k];
+			size++;
+		}
+
+		/**
+		 * Gets a copy of a vector
+		 * @param index The index of the vector
+		 * @returns The vector
+		 */
+		Vector<T, N> get(size_t index) const {
+			assert(index < size);
+			Vector<T, N> result;
+			for (size_t k = 0; k < N; k++)
+				result[k] = buffer[k * cap + index];
+			return result;
+		}
+
+		/**
+		 * Replaces a vector
+		 * @param index The index of the vector
+		 * @param vector The new value of the vector
+		 */
+		void set(size_t index, const Vector<T, N>& vector) {
+			assert(index < size);
+			for (size_t k = 0; k < N; k++)
+				buffer[k * cap + index] = vector[k];
+		}
+
+		/**
+		 * Adds the vectors of another batch to these vectors
+		 * @param other The batch to add (with the same length)
+		 * @param pool The pool to run on
+		 */
+		void add(const VectorBatch& other, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+			assert(other.size == size);
+			run([&](size_t first, size_t last) {
+				for (size_t k = 0; k < N; k++) {
+					T* target = component(k);
+					const T* source = other.component(k);
+					lanes(first, last, [&](auto pack, size_t i) {
+						using P = decltype(pack);
+						P::store(target + i, P::add(P::load(target + i), P::load(source + i)));
+					});
+				}
+			}, pool);
+		}
+
+		/**
+		 * Adds a vector to every vector
+		 * @param offset The vector to add
+		 * @param pool The pool to run on
+		 */
+		void add(const Vector<T, N>& offset, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+			run([&](size_t first, size_t last) {
+				for (size_t k = 0; k < N; k++) {
+					T* target = component(k);
+					T value = offset[k];
+					lanes(first, last, [&](auto pack, size_t i) {
+						using P = decltype(pack);
+						P::store(target + i, P::add(P::load(target + i), P::broadcast(value)));
+					});
+				}
+			}, pool);
+		}
+
+		/**
+		 * Subtracts the vectors of another batch from these vectors
+		 * @param other The batch to subtract (with the same length)
+		 * @param pool The pool to run on
+		 */
+		void subtract(const VectorBatch& other, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+			assert(other.size == size);
+			run([&](size_t first, size_t last) {
+				for (size_t k = 0; k < N; k++) {
+					T* target = component(k);
+					const T* source = other.component(k);
+					lanes(first, last, [&](auto pack, size_t i) {
+						using P = decltype(pack);
+						P::store(target + i, P::subtract(P::load(target + i), P::load(source + i)));
+					});
+				}
+			}, pool);
+		}
+
+		/**
+		 * Multiplies every vector by a value
+		 * @param factor The value
+		 * @param pool The pool to run on
+		 */
+		void scale(T factor, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+			run([&](size_t first, size_t last) {
+				for (size_t k = 0; k < N; k++) {
+					T* target = component(k);
+					lanes(first, last, [&](auto pack, size_t i) {
+						using P = decltype(pack);
+						P::store(target + i, P::multiply(P::load(target + i), P::broadcast(factor)));
+					});
+				}
+			}, pool);
+		}
+
+		/**
+		 * Adds the vectors of another batch multiplied by a value to these vectors (ie positions += velocities * step)
+		 * @param other The batch to add (with the same length)
+		 * @param factor The value to multiply other by
+		 * @param pool The pool to run on
+		 */
+		void addScaled(const VectorBatch& other, T factor, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+			assert(other.size == size);
+			run([&](size_t first, size_t last) {
+				for (size_t k = 0; k < N; k++) {
+					T* target = component(k);
+					const T* source = other.component(k);
+					lanes(first, last, [&](auto pack, size_t i) {
+						using P = decltype(pack);
+						P::store(target + i, P::multiplyAdd(P::load(source + i), P::broadcast(factor), P::load(target + i)));
+					});
+				}
+			}, pool);
+		}
+
+		/**
+		 * Interpolates every vector linearly towards the matching vector of another batch
+		 * @param other The batch to interpolate towards (with the same length)
+		 * @param amount How far to interpolate (0 keeps these vectors and 1 gives other)
+		 * @param pool The pool to run on
+		 */
+		void lerp(const VectorBatch& other, T amount, Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+			assert(other.size == size);
+			run([&](size_t first, size_t last) {
+				for (size_t k = 0; k < N; k++) {
+					T* target = component(k);
+					const T* source = other.component(k);
+					lanes(first, last, [&](auto pack, size_t i) {
+						using P = decltype(pack);
+						typename P::Register current = P::load(target + i);
+						P::store(target + i, P::multiplyAdd(P::subtract(P::load(source + i), current), P::broadcast(amount), current));
+					});
+				}
+			}, pool);
+		}
+
+		/**
+		 * Computes the dot product of every vector with the matching vector of another batch
+		 * @param other The other batch (with the same length)
+		 * @param out Where to store the dot products (length() elements)
+		 * @param pool The pool to run on
+		 */
+		void dot(const VectorBatch& other, T* out, Threading::ThreadPool& pool = Threading::ThreadPool::global()) const {
+			assert(other.size == size);
+			run([&](size_t first, size_t last) {
+				lanes(first, last, [&](auto pack, size_t i) {
+					using P = decltype(pack);
+					typename P::Register sum = P::multiply(P::load(component(0) + i), P::load(other.component(0) + i));
+					for (size_t k = 1; k < N; k++)
+						sum = P::multiplyAdd(P::load(component(k) + i), P::load(other.component(k) + i), sum);
+					P::store(out + i, sum);
+				});
+			}, pool);
+		}
+
+		/**
+		 * Computes the length of every vector
+		 * @param out Where to store the lengths (length() elements)
+		 * @param pool The pool to run on
+		 */
+		void lengths(T* out, Threading::ThreadPool& pool = Threading::ThreadPool::global()) const {
+			run([&](size_t first, size_t last) {
+				lanes(first, last, [&](auto pack, size_t i) {
+					using P = decltype(pack);
+					typename P::Register value = P::load(component(0) + i);
+					typename P::Register sum = P::multiply(value, value);
+					for (size_t k = 1; k < N; k++) {
+						value = P::load(component(k) + i);
+						sum = P::multiplyAdd(value, value, sum);
+					}
+					P::store(out + i, P::sqrt(sum));
+				});
+			}, pool);
+		}
+
+		/**
+		 * Scales every vector to a length of one (vectors of length zero get non finite components)
+		 * @param pool The pool to run on
+		 */
+		void normalize(Threading::ThreadPool& pool = Threading::ThreadPool::global()) {
+			run([&](size_t first, size_t last) {
+				lanes(first, last, [&](auto pack, size_t i) {
+					using P = decltype(pack);
+					typename P::Register value = P::load(component(0) + i);
+					typename P::Register sum = P::multiply(value, value);
+					for (size_t k = 1; k < N; k++) {
+						value = P::load(component(k) + i);
+						sum = P::multiplyAdd(value, value, sum);
+					}
+					typename P::Register inverse = P::divide(P::broadcast(T(1)), P::sqrt(sum));
+					for (size_t k = 0; k < N; k++)
+						P::store(component(k) + i, P::multiply(P::load(component(k) + i), inverse));
+				});
+			}, pool);
+		}
+	};
+
+	/**
+	 * A 2 component float vector
+	 */
+	using Vector2f = Vector<float, 2>;
+
+	/**
+	 * A 3 component float vector
+	 */
+	using Vector3f = Vector<float, 3>;
+
+	/**
+	 * A 4 component float vector
+	 */
+	using Vector4f = Vector<float, 4>;
+
+	/**
+	 * An 8 component float vector
+	 */
+	using Vector8f = Vector<float, 8>;
+
+	/**
+	 * A 2 component double vector
+	 */
+	using Vector2d = Vector<double, 2>;
+
+	/**
+	 * A 3 component double vector
+	 */
+	using Vector3d = Vector<double, 3>;
+
+	/**
+	 * A 4 component double vector
+	 */
+	using Vector4d = Vector<double, 4>;
+
+	/**
+	 * An 8 component double vector
+	 */
+	using Vector8d = Vector<double, 8>;
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
@@ -0,0 +1,488 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "String.h"
+#include "../DataStructures/Allocator.h"
+#include "../DataStructures/ArrayList.h"
+#include "../DataStructures/Memory.h"
+#include "../DataStructures/Search.h"
+#include <assert.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <new>
+
+/**
+ * The namespace for strings in the essentials library
+ */
+namespace Essentials::Strings {
+
+	/**
+	 * A namespace alias to the strings namespace
+	 */
+	namespace str = Strings;
+
+	/**
+	 * A handle to a string in an Interner, equal handles from one interner mean equal strings
+	 */
+	class Symbol {
+	public:
+		/**
+		 * The id of a handle that does not refer to a string
+		 */
+		static constexpr uint32_t invalidId = UINT32_MAX;
+
+	private:
+		/**
+		 * The id of the string in its interner
+		 */
+		uint32_t value = invalidId;
+
+	public:
+		/**
+		 * Creates a handle that does not refer to a string
+		 */
+		constexpr Symbol() = default;
+
+		/**
+		 * Creates a handle from an id
+		 * @param id The id of the string in its interner
+		 */
+		constexpr explicit Symbol(uint32_t id) : value(id) {}
+
+		/**
+		 * Gets the id of the string (ids are handed out densely from 0, so they can index arrays)
+		 * @returns The id
+		 */
+		constexpr uint32_t id() const {
+			return value;
+		}
+
+		/**
+		 * Checks if the handle refers to a string
+		 * @returns Whether or not the handle is valid
+		 */
+		constexpr bool valid() const {
+			return value != invalidId;
+		}
+
+		/**
+		 * Checks if two handles refer to the same string
+		 * @param other The handle to compare with
+		 * @returns Whether or not they are equal
+		 */
+		constexpr bool operator==(Symbol other) const {
+			return value == other.value;
+		}
+
+		/**
+		 * Checks if two handles refer to different strings
+		 * @param other The handle to compare with
+		 * @returns Whether or not they are not equal
+		 */
+		constexpr bool operator!=(Symbol other) const {
+			return value != other.value;
+		}
+
+		/**
+		 * Orders handles by id (the order they were interned in, not the order of the strings)
+		 * @param other The handle to compare with
+		 * @returns Whether or not this handle was interned first
+		 */
+		constexpr bool operator<(Symbol other) const {
+			return value < other.value;
+		}
+	};
+
+	/**
+	 * Turns strings into 32 bit Symbols, storing one copy of every distinct string
+	 * Lookups of strings which were already interned do not lock, new strings lock one of several shards
+	 * The strings are stored append only in arenas, so views of them stay valid until the interner is destroyed
+	 */
+	class Interner {
+	private:
+		/**
+		 * The number of bits of the hash that pick a shard
+		 */
+		static constexpr size_t shardBits = 4;
+
+		/**
+		 * The number of shards
+		 */
+		static constexpr size_t shardCount = static_cast<size_t>(1) << shardBits;
+
+		/**
+		 * The number of entries in the first chunk is 2^firstChunkBits, each chunk after it is twice as big
+		 */
+		static constexpr size_t firstChunkBits = 10;
+
+		/**
+		 * The number of chunks needed to cover every id
+		 */
+		static constexpr size_t chunkCount = 32 - firstChunkBits + 1;
+
+		/**
+		 * The number of slots of a new shard table
+		 */
+		static constexpr size_t initialSlots = 64;
+
+		/**
+		 * An interned string
+		 */
+		struct Entry {
+			/**
+			 * The characters (null terminated)
+			 */
+			const char* characters;
+
+			/**
+			 * The number of characters
+			 */
+			uint32_t length;
+
+			/**
+			 * The high 32 bits of the hash, which pick the shard and the first slot
+			 */
+			uint32_t hashHigh;
+		};
+
+		/**
+		 * An open addressing table of a shard, each slot holds the low 32 bits of the hash and id + 1 (0 when empty)
+		 */
+		struct Table {
+			/**
+			 * The number of slots - 1 (the number of slots is a power of two)
+			 */
+			size_t mask;
+
+			/**
+			 * The slots
+			 */
+			std::atomic<uint64_t>* slots;
+
+			/**
+			 * Creates a table of empty slots
+			 * @param count The number of slots (a power of two)
+			 */
+			Table(size_t count) : mask(count - 1), slots(new std::atomic<uint64_t>[count]) {
+				for (size_t i = 0; i < count; i++)
+					slots[i].store(0, std::memory_order_relaxed);
+			}
+
+			Table(const Table&) = delete;
+			Table& operator=(const Table&) = delete;
+
+			/**
+			 * Frees the slots
+			 */
+			~Table() {
+				delete[] slots;
+			}
+		};
+
+		/**
+		 * A part of the interner which strings are assigned to by hash, each on its own cache lines
+		 */
+		struct alignas(DataStructures::cacheLineSize) Shard {
+			/**
+			 * Held while adding strings
+			 */
+			std::mutex mutex;
+
+			/**
+			 * The current table
+			 */
+			std::atomic<Table*> table{new Table(initialSlots)};
+
+			/**
+			 * The number of strings in the shard
+			 */
+			size_t count = 0;
+
+			/**
+			 * The storage of the characters
+			 */
+			DataStructures::Arena arena;
+
+			/**
+			 * Tables which were replaced by a larger one, kept alive until the interner is destroyed since readers may
+			 * still be probing them
+			 */
+			DataStructures::ArrayList<Table*> retired;
+		};
+
+		/**
+		 * The shards
+		 */
+		Shard shards[shardCount];
+
+		/**
+		 * The entries by id, in chunks which never move once allocated
+		 */
+		std::atomic<Entry*> chunks[chunkCount] = {};
+
+		/**
+		 * The next id to hand out
+		 */
+		std::atomic<uint32_t> nextId{0};
+
+		/**
+		 * The number of strings which have been added and can be found (ids are reserved before this is counted)
+		 */
+		std::atomic<size_t> published{0};
+
+		/**
+		 * Finds which chunk an id is in
+		 * @param id The id
+		 * @param offset Where to store the index of the entry in the chunk
+		 * @returns The index of the chunk
+		 */
+		static inline size_t chunkOf(uint32_t id, size_t& offset) {
+			size_t chunk = DataStructures::searchHighestBit(static_cast<uint32_t>((id >> firstChunkBits) + 1));
+			offset = static_cast<size_t>(id) - (((static_cast<size_t>(1) << chunk) - 1) << firstChunkBits);
+			return chunk;
+		}
+
+		/**
+		 * Gets the entry of an id which has been published
+		 * @param id The id
+		 * @returns The entry
+		 */
+		inline const Entry& entry(uint32_t id) const {
+			size_t offset;
+			size_t chunk = chunkOf(id, offset);
+			return chunks[chunk].load(std::memory_order_acquire)[offset];
+		}
+
+		/**
+		 * Gets the entry of a new id, allocating its chunk if no other thread has yet
+		 * @param id The id
+		 * @returns The entry to fill in
+		 */
+		Entry& newEntry(uint32_t id) {
+			size_t offset;
+			size_t chunk = chunkOf(id, offset);
+			Entry* entries = chunks[chunk].load(std::memory_order_acquire);
+			if (entries == nullptr) {
+				size_t count = static_cast<size_t>(1) << (chunk + firstChunkBits);
+				Entry* allocated = static_cast<Entry*>(std::calloc(count, sizeof(Entry)));
+				if (allocated == nullptr) throw std::bad_alloc();
+				if (chunks[chunk].compare_exchange_strong(entries, allocated, std::memory_order_acq_rel, std::memory_order_acquire))
+					entries = allocated;
+				else
+					std::free(allocated);
+			}
+			return entries[offset];
+		}
+
+		/**
+		 * Looks for a string in a shard without locking
+		 * @param shard The shard the string hashes to
+		 * @param string The string
+		 * @param hash The hash of the string
+		 * @returns The id of the string (Symbol::invalidId if it is not in the table being probed)
+		 */
+		uint32_t lookup(const Shard& shard, StringView string, uint64_t hash) const {
+			const Table* table = shard.table.load(std::memory_order_acquire);
+			uint32_t fragment = static_cast<uint32_t>(hash);
+			size_t index = static_cast<size_t>(hash >> 32) & table->mask;
+			while (true) {
+				uint64_t slot = table->slots[index].load(std::memory_order_acquire);
+				if (slot == 0) return Symbol::invalidId;
+				if (static_cast<uint32_t>(slot >> 32) == fragment) {
+					uint32_t id = static_cast<uint32_t>(slot) - 1;
+					const Entry& found = entry(id);
+					if (found.length == string.length() && std::memcmp(found.characters, string.data(), string.length()) == 0)
+						return id;
+				}
+				index = (index + 1) & table->mask;
+			}
+		}
+
+		/**
+		 * Places an id in a table (the shard must be locked and the table must have an empty slot)
+		 * @param table The table
+		 * @param hashHigh The high 32 bits of the hash
+		 * @param fragment The low 32 bits of the hash
+		 * @param id The id
+		 */
+		static void place(Table& table, uint32_t hashHigh, uint32_t fragment, uint32_t id) {
+			size_t index = hashHigh & table.mask;
+			while (table.slots[index].load(std::memory_order_relaxed) != 0)
+				index = (index + 1) & table.mask;
+			table.slots[index].store((static_cast<uint64_t>(fragment) << 32) | (static_cast<uint64_t>(id) + 1), std::memory_order_release);
+		}
+
+		/**
+		 * Moves a shard to a table twice as big (the shard must be locked)
+		 * @param shard The shard
+		 */
+		void grow(Shard& shard) {
+			Table* current = shard.table.load(std::memory_order_relaxed);
+			Table* bigger = new Table((current->mask + 1) * 2);
+			for (size_t i = 0; i <= current->mask; i++) {
+				uint64_t slot = current->slots[i].load(std::memory_order_relaxed);
+				if (slot == 0) continue;
+				uint32_t id = static_cast<uint32_t>(slot) - 1;
+				place(*bigger, entry(id).hashHigh, static_cast<uint32_t>(slot >> 32), id);
+			}
+			shard.retired.push(current);
+			shard.table.store(bigger, std::memory_order_release);
+		}
+
+		/**
+		 * Gets the shard a hash belongs to
+		 * @param hash The hash
+		 * @returns The shard
+		 */
+		inline Shard& shardOf(uint64_t hash) {
+			return shards[hash >> (64 - shardBits)];
+		}
+
+		/**
+		 * Gets the shard a hash belongs to
+		 * @param hash The hash
+		 * @returns The shard
+		 */
+		inline const Shard& shardOf(uint64_t hash) const {
+			return shards[hash >> (64 - shardBits)];
+		}
+
+	public:
+		/**
+		 * Creates an empty interner
+		 */
+		Interner() = default;
+
+		Interner(const Interner&) = delete;
+		Interner& operator=(const Interner&) = delete;
+
+		/**
+		 * Frees resources (every view of an interned string is invalidated)
+		 */
+		~Interner() {
+			for (Shard& shard : shards) {
+				delete shard.table.load(std::memory_order_relaxed);
+				for (size_t i = 0; i < shard.retired.length(); i++)
+					delete shard.retired[i];
+			}
+			for (std::atomic<Entry*>& chunk : chunks)
+				std::free(chunk.load(std::memory_order_relaxed));
+		}
+
+		/**
+		 * Gets the Symbol of a string, storing a copy of the string if it has not been seen before (thread safe)
+		 * @param string The string
+		 * @returns The Symbol (the same for every call with equal strings)
+		 */
+		Symbol intern(StringView string) {
+			uint64_t hash = hashBytes(string.data(), string.length());
+			Shard& shard = shardOf(hash);
+			uint32_t id = lookup(shard, string, hash);
+			if (id != Symbol::invalidId) return Symbol(id);
+
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			// Another thread may have added it (or grown the table) since the lookup
+			id = lookup(shard, string, hash);
+			if (id != Symbol::invalidId) return Symbol(id);
+
+			assert(string.length() < UINT32_MAX);
+			char* characters = static_cast<char*>(shard.arena.allocate(string.length() + 1, 1));
+			std::memcpy(characters, string.data(), string.length());
+			characters[string.length()] = '\0';
+
+			id = nextId.fetch_add(1, std::memory_order_relaxed);
+			assert(id != Symbol::invalidId);
+			uint32_t hashHigh = static_cast<uint32_t>(hash >> 32);
+			newEntry(id) = Entry{ characters, static_cast<uint32_t>(string.length()), hashHigh };
+
+			Table* table = shard.table.load(std::memory_order_relaxed);
+			if ((shard.count + 1) * 2 > table->mask + 1) {
+				grow(shard);
+				table = shard.table.load(std::memory_order_relaxed);
+			}
+			place(*table, hashHigh, static_cast<uint32_t>(hash), id);
+			shard.count++;
+			published.fetch_add(1, std::memory_order_release);
+			return Symbol(id);
+		}
+
+		/**
+		 * Gets the Symbol of a string without adding it (thread safe and does not lock)
+		 * @param string The string
+		 * @returns The Symbol (invalid if the string has not been interned, or is being interned by another thread)
+		 */
+		Symbol find(StringView string) const {
+			uint64_t hash = hashBytes(string.data(), string.length());
+			return Symbol(lookup(shardOf(hash), string, hash));
+		}
+
+		/**
+		 * Gets the string of a Symbol (thread safe and does not lock)
+		 * @param symbol A valid Symbol from this interner
+		 * @returns A view of the string (valid until the interner is destroyed)
+		 */
+		StringView view(Symbol symbol) const {
+			assert(symbol.valid() && symbol.id() < nextId.load(std::memory_order_relaxed));
+			const Entry& found = entry(symbol.id());
+			return StringView(found.characters, found.length);
+		}
+
+		/**
+		 * Gets the string of a Symbol as a null terminated string (thread safe and does not lock)
+		 * @param symbol A valid Symbol from this interner
+		 * @returns The characters (valid until the interner is destroyed)
+		 */
+		const char* cString(Symbol symbol) const {
+			return view(symbol).data();
+		}
+
+		/**
+		 * Gets the number of distinct strings which have been interned and can be found
+		 * Ids are exactly 0 to length() - 1 when no intern call is running. While other threads are interning, ids are
+		 * reserved before their strings are counted, so ids up to (and past) length() may belong to strings still being added.
+		 * @returns The number of strings interned
+		 */
+		size_t length() const {
+			return published.load(std::memory_order_acquire);
+		}
+	};
+}
+
+/**
+ * Hashes Symbols by mixing their id (ids are dense so they need spreading over the high bits)
+ */
+template<> struct std::hash<Essentials::Strings::Symbol> {
+	/**
+	 * Hashes a Symbol
+	 * @param symbol The Symbol to hash
+	 * @returns The hash
+	 */
+	size_t operator()(Essentials::Strings::Symbol symbol) const {
+		return static_cast<size_t>(symbol.id() * 0x9E3779B97F4A7C15ull);
+	}
+};
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
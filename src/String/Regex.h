@@ -0,0 +1,2068 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "String.h"
+#include "../DataStructures/ArrayList.h"
+#include "../DataStructures/HashMap.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+/**
+ * The namespace for strings in the essentials library
+ */
+namespace Essentials::Strings {
+
+	/**
+	 * A namespace alias to the strings namespace
+	 */
+	namespace str = Strings;
+
+	/**
+	 * Options for compiling regular expressions
+	 */
+	struct RegexOptions {
+		/**
+		 * Whether or not ASCII letters match regardless of their case
+		 */
+		bool caseInsensitive = false;
+
+		/**
+		 * The number of bytes each lazily built DFA may cache before its states are flushed
+		 */
+		size_t cacheBytes = static_cast<size_t>(8) << 20;
+	};
+
+	/**
+	 * A set of bytes, one bit per byte value
+	 */
+	class ByteSet {
+	private:
+		/**
+		 * The bits of the set, bit b of word w is the byte w * 64 + b
+		 */
+		uint64_t bits[4] = {};
+
+	public:
+		/**
+		 * Adds a byte to the set
+		 * @param byte The byte to add
+		 */
+		void add(unsigned char byte) {
+			bits[byte >> 6] |= static_cast<uint64_t>(1) << (byte & 63);
+		}
+
+		/**
+		 * Adds an inclusive range of bytes to the set
+		 * @param low The first byte to add
+		 * @param high The last byte to add
+		 */
+		void add(unsigned char low, unsigned char high) {
+			for (unsigned value = low; value <= high; value++)
+				add(static_cast<unsigned char>(value));
+		}
+
+		/**
+		 * Adds every byte of another set to this set
+		 * @param other The set to add
+		 */
+		void add(const ByteSet& other) {
+			for (size_t i = 0; i < 4; i++)
+				bits[i] |= other.bits[i];
+		}
+
+		/**
+		 * Replaces the set with every byte that is not in it
+		 */
+		void invert() {
+			for (size_t i = 0; i < 4; i++)
+				bits[i] = ~bits[i];
+		}
+
+		/**
+		 * Checks if a byte is in the set
+		 * @param byte The byte to check
+		 * @returns Whether or not the byte is in the set
+		 */
+		inline bool contains(unsigned char byte) const {
+			return (bits[byte >> 6] >> (byte & 63)) & 1;
+		}
+
+		/**
+		 * Gets the raw bits of the set, used to find equal sets
+		 * @returns A view over the bits
+		 */
+		StringView view() const {
+			return StringView(reinterpret_cast<const char*>(bits), sizeof(bits));
+		}
+	};
+
+	/**
+	 * The kinds of instructions in a compiled regex
+	 */
+	enum class RegexOp : uint8_t {
+		/**
+		 * Consumes a byte from the set in argument, then continues at out
+		 */
+		bytes,
+		/**
+		 * Continues at both out and alternate
+		 */
+		split,
+		/**
+		 * Continues at out
+		 */
+		jump,
+		/**
+		 * Continues at out only at the start of the text
+		 */
+		assertStart,
+		/**
+		 * Continues at out only at the end of the text
+		 */
+		assertEnd,
+		/**
+		 * The pattern with the id in argument has matched
+		 */
+		match
+	};
+
+	/**
+	 * A single state of the NFA a regex is compiled to
+	 */
+	struct RegexInstruction {
+		/**
+		 * What the instruction does
+		 */
+		RegexOp op;
+
+		/**
+		 * The next instruction
+		 */
+		uint32_t out;
+
+		/**
+		 * The other next instruction of a split
+		 */
+		uint32_t alternate;
+
+		/**
+		 * The byte set index of a bytes instruction, or the pattern id of a match
+		 */
+		uint32_t argument;
+	};
+
+	/**
+	 * A Thompson NFA compiled from one or more patterns, along with what the DFA needs to run it
+	 */
+	struct RegexProgram {
+		/**
+		 * The instruction index meaning no instruction (also ends patch lists while compiling)
+		 */
+		static constexpr uint32_t none = UINT32_MAX;
+
+		/**
+		 * The instructions, start is where matching begins
+		 */
+		DataStructures::ArrayList<RegexInstruction> instructions;
+
+		/**
+		 * The distinct byte sets the bytes instructions test against
+		 */
+		DataStructures::ArrayList<ByteSet> sets;
+
+		/**
+		 * Finds the index of a byte set from its bits while compiling
+		 */
+		DataStructures::HashMap<String, uint32_t> setLookup;
+
+		/**
+		 * The first instruction
+		 */
+		uint32_t start = none;
+
+		/**
+		 * The number of patterns compiled into the program
+		 */
+		size_t patternCount = 0;
+
+		/**
+		 * The class of each byte, bytes of one class are in exactly the same sets so the DFA only needs one transition per class
+		 */
+		uint8_t classes[256] = {};
+
+		/**
+		 * A byte of each class
+		 */
+		uint8_t representatives[256] = {};
+
+		/**
+		 * The number of byte classes
+		 */
+		size_t classCount = 1;
+
+		/**
+		 * Characters every match starts with (empty if there are none), used to skip ahead with a SIMD substring search
+		 */
+		String prefix;
+
+		/**
+		 * Adds a byte set, reusing an equal set if there is one
+		 * @param set The set to add
+		 * @returns The index of the set
+		 */
+		uint32_t addSet(const ByteSet& set) {
+			String key(set.view());
+			if (const uint32_t* found = setLookup.get(key))
+				return *found;
+			uint32_t index = static_cast<uint32_t>(sets.length());
+			sets.push(set);
+			setLookup.insert(std::move(key), index);
+			return index;
+		}
+
+		/**
+		 * Splits the bytes into classes by refining a single class with every set
+		 */
+		void computeClasses() {
+			uint8_t refined[256];
+			int16_t remap[512];
+			std::memset(classes, 0, sizeof(classes));
+			classCount = 1;
+			for (const ByteSet& set : sets) {
+				std::fill(remap, remap + classCount * 2, static_cast<int16_t>(-1));
+				size_t count = 0;
+				for (size_t byte = 0; byte < 256; byte++) {
+					size_t key = classes[byte] * static_cast<size_t>(2) + set.contains(static_cast<unsigned char>(byte));
+					if (remap[key] < 0)
+						remap[key] = static_cast<int16_t>(count++);
+					refined[byte] = static_cast<uint8_t>(remap[key]);
+				}
+				std::memcpy(classes, refined, sizeof(classes));
+				classCount = count;
+			}
+			for (size_t byte = 256; byte-- > 0;)
+				representatives[classes[byte]] = static_cast<uint8_t>(byte);
+		}
+	};
+
+	/**
+	 * Parses a pattern and compiles it into a RegexProgram
+	 * Supports literals, escapes, ., [classes], \d \w \s (and their negations), * + ? {m,n} (lazy forms too), |, (groups), (?:groups), ^ and $
+	 * Backreferences, lookaround and word boundaries are not supported since they cannot run on a DFA
+	 */
+	class RegexCompiler {
+	private:
+		/**
+		 * A piece of the NFA with one entry and a list of dangling exits
+		 */
+		struct Fragment {
+			/**
+			 * The entry instruction
+			 */
+			uint32_t start;
+
+			/**
+			 * The first dangling exit slot (instruction * 2 + 1 for alternate), each dangling slot links to the next
+			 */
+			uint32_t head;
+
+			/**
+			 * The last dangling exit slot
+			 */
+			uint32_t tail;
+		};
+
+		/**
+		 * The largest count allowed in a {m,n} repetition
+		 */
+		static constexpr size_t maxRepeat = 1000;
+
+		/**
+		 * The deepest nesting of groups allowed
+		 */
+		static constexpr size_t maxDepth = 1000;
+
+		/**
+		 * The largest number of instructions a program may have
+		 */
+		static constexpr size_t maxInstructions = static_cast<size_t>(1) << 24;
+
+		/**
+		 * The maximum of an unbounded repetition
+		 */
+		static constexpr size_t unbounded = static_cast<size_t>(-1);
+
+		/**
+		 * The program being compiled into
+		 */
+		RegexProgram& program;
+
+		/**
+		 * The pattern being compiled
+		 */
+		StringView pattern;
+
+		/**
+		 * The position of the parser in the pattern
+		 */
+		size_t position = 0;
+
+		/**
+		 * The number of groups the parser is in
+		 */
+		size_t depth = 0;
+
+		/**
+		 * Whether or not to build the NFA for the reversed pattern (used to find where matches start)
+		 */
+		bool reverse;
+
+		/**
+		 * Whether or not letters match both cases
+		 */
+		bool caseInsensitive;
+
+		/**
+		 * Whether or not literals are still being added to the program prefix
+		 */
+		bool collectPrefix;
+
+		/**
+		 * The byte the last atom matched, or -1 if it was not a single literal
+		 */
+		int literal = -1;
+
+		/**
+		 * The error message (nullptr if there has not been an error)
+		 */
+		const char* message = nullptr;
+
+		/**
+		 * The position of the error in the pattern
+		 */
+		size_t messagePosition = 0;
+
+		/**
+		 * Records an error at the current position (keeping the first one)
+		 * @param text The error message
+		 * @returns false
+		 */
+		bool fail(const char* text) {
+			if (message == nullptr) {
+				message = text;
+				messagePosition = position;
+			}
+			return false;
+		}
+
+		/**
+		 * Adds an instruction with dangling exits
+		 * @param op The kind of instruction
+		 * @param argument The argument of the instruction
+		 * @returns The index of the instruction
+		 */
+		uint32_t emit(RegexOp op, uint32_t argument = 0) {
+			uint32_t index = static_cast<uint32_t>(program.instructions.length());
+			program.instructions.push({op, RegexProgram::none, RegexProgram::none, argument});
+			return index;
+		}
+
+		/**
+		 * Gets an exit slot
+		 * @param id The slot (instruction * 2 + 1 for alternate)
+		 * @returns A reference to the slot
+		 */
+		uint32_t& slot(uint32_t id) {
+			RegexInstruction& instruction = program.instructions[id >> 1];
+			return (id & 1) ? instruction.alternate : instruction.out;
+		}
+
+		/**
+		 * Makes a fragment of one instruction whose out is dangling
+		 * @param index The instruction
+		 * @returns The fragment
+		 */
+		Fragment single(uint32_t index) {
+			return {index, index * 2, index * 2};
+		}
+
+		/**
+		 * Points every dangling exit of a fragment at an instruction
+		 * @param fragment The fragment to patch
+		 * @param target The instruction to continue at
+		 */
+		void patch(const Fragment& fragment, uint32_t target) {
+			for (uint32_t id = fragment.head; id != RegexProgram::none;) {
+				uint32_t& exit = slot(id);
+				id = exit;
+				exit = target;
+			}
+		}
+
+		/**
+		 * Makes a fragment matching nothing
+		 * @returns The fragment
+		 */
+		Fragment empty() {
+			return single(emit(RegexOp::jump));
+		}
+
+		/**
+		 * Makes a fragment consuming one byte of a set
+		 * @param set The set of bytes
+		 * @returns The fragment
+		 */
+		Fragment bytes(const ByteSet& set) {
+			return single(emit(RegexOp::bytes, program.addSet(set)));
+		}
+
+		/**
+		 * Makes a fragment matching one fragment and then another (the other way around when reversed)
+		 * @param first The fragment matched first
+		 * @param second The fragment matched second
+		 * @returns The fragment
+		 */
+		Fragment concatenate(Fragment first, Fragment second) {
+			if (reverse)
+				std::swap(first, second);
+			patch(first, second.start);
+			return {first.start, second.head, second.tail};
+		}
+
+		/**
+		 * Makes a fragment matching either of two fragments
+		 * @param left One fragment
+		 * @param right The other fragment
+		 * @returns The fragment
+		 */
+		Fragment alternate(Fragment left, Fragment right) {
+			uint32_t split = emit(RegexOp::split);
+			program.instructions[split].out = left.start;
+			program.instructions[split].alternate = right.start;
+			slot(left.tail) = right.head;
+			return {split, left.head, right.tail};
+		}
+
+		/**
+		 * Makes a fragment matching a fragment any number of times
+		 * @param inner The repeated fragment
+		 * @returns The fragment
+		 */
+		Fragment star(Fragment inner) {
+			uint32_t split = emit(RegexOp::split);
+			program.instructions[split].out = inner.start;
+			patch(inner, split);
+			return {split, split * 2 + 1, split * 2 + 1};
+		}
+
+		/**
+		 * Makes a fragment matching a fragment one or more times
+		 * @param inner The repeated fragment
+		 * @returns The fragment
+		 */
+		Fragment plus(Fragment inner) {
+			uint32_t split = emit(RegexOp::split);
+			program.instructions[split].out = inner.start;
+			patch(inner, split);
+			return {inner.start, split * 2 + 1, split * 2 + 1};
+		}
+
+		/**
+		 * Makes a fragment matching a fragment or nothing
+		 * @param inner The optional fragment
+		 * @returns The fragment
+		 */
+		Fragment optional(Fragment inner) {
+			uint32_t split = emit(RegexOp::split);
+			program.instructions[split].out = inner.start;
+			slot(inner.tail) = split * 2 + 1;
+			return {split, inner.head, split * 2 + 1};
+		}
+
+		/**
+		 * Adds the other case of every ASCII letter in a set
+		 * @param set The set to fold
+		 */
+		static void fold(ByteSet& set) {
+			for (unsigned char lower = 'a'; lower <= 'z'; lower++) {
+				unsigned char upper = static_cast<unsigned char>(lower - 'a' + 'A');
+				if (set.contains(lower) || set.contains(upper)) {
+					set.add(lower);
+					set.add(upper);
+				}
+			}
+		}
+
+		/**
+		 * Gets the set of a class escape
+		 * @param name The letter after the backslash (d, w or s in either case)
+		 * @returns The set, inverted for upper case letters
+		 */
+		static ByteSet escapeClass(char name) {
+			ByteSet set;
+			switch (name | 0x20) {
+			case 'd':
+				set.add('0', '9');
+				break;
+			case 'w':
+				set.add('0', '9');
+				set.add('a', 'z');
+				set.add('A', 'Z');
+				set.add('_');
+				break;
+			default:
+				set.add(' ');
+				set.add('\t', '\r');
+				break;
+			}
+			if (name >= 'A' && name <= 'Z')
+				set.invert();
+			return set;
+		}
+
+		/**
+		 * Parses the character after a backslash
+		 * @param set The set class escapes are added to
+		 * @returns The escaped byte, -1 for a class escape (added to set) or -2 on an error
+		 */
+		int parseEscapeCharacter(ByteSet& set) {
+			if (position >= pattern.length()) {
+				fail("trailing backslash");
+				return -2;
+			}
+			char character = pattern[position++];
+			switch (character) {
+			case 'd': case 'D': case 'w': case 'W': case 's': case 'S':
+				set.add(escapeClass(character));
+				return -1;
+			case 'n':
+				return '\n';
+			case 't':
+				return '\t';
+			case 'r':
+				return '\r';
+			case 'f':
+				return '\f';
+			case 'v':
+				return '\v';
+			case '0':
+				return 0;
+			case 'x': {
+				int value = 0;
+				for (size_t i = 0; i < 2; i++) {
+					char digit = position < pattern.length() ? pattern[position] : '\0';
+					int nibble = digit >= '0' && digit <= '9' ? digit - '0' : (digit | 0x20) >= 'a' && (digit | 0x20) <= 'f' ? (digit | 0x20) - 'a' + 10 : -1;
+					if (nibble < 0) {
+						fail("invalid hex escape");
+						return -2;
+					}
+					value = value * 16 + nibble;
+					position++;
+				}
+				return value;
+			}
+			default:
+				if ((character >= '0' && character <= '9') || ((character | 0x20) >= 'a' && (character | 0x20) <= 'z')) {
+					position--;
+					fail("unsupported escape");
+					return -2;
+				}
+				return static_cast<unsigned char>(character);
+			}
+		}
+
+		/**
+		 * Parses one character of a class
+		 * @param set The set class escapes are added to
+		 * @returns The byte, -1 for a class escape (added to set) or -2 on an error
+		 */
+		int parseClassCharacter(ByteSet& set) {
+			if (pattern[position] != '\\')
+				return static_cast<unsigned char>(pattern[position++]);
+			position++;
+			return parseEscapeCharacter(set);
+		}
+
+		/**
+		 * Parses a [class] starting at the current position
+		 * @param result The fragment consuming a byte of the class
+		 * @returns Whether or not the class was valid
+		 */
+		bool parseClass(Fragment& result) {
+			size_t open = position++;
+			bool negated = position < pattern.length() && pattern[position] == '^';
+			if (negated)
+				position++;
+			ByteSet set;
+			bool first = true;
+			while (position < pattern.length() && (first || pattern[position] != ']')) {
+				first = false;
+				int low = parseClassCharacter(set);
+				if (low == -2) return false;
+				if (low >= 0 && position + 1 < pattern.length() && pattern[position] == '-' && pattern[position + 1] != ']') {
+					position++;
+					int high = parseClassCharacter(set);
+					if (high == -2) return false;
+					if (high < low) return fail("invalid class range");
+					set.add(static_cast<unsigned char>(low), static_cast<unsigned char>(high));
+				} else if (low >= 0) {
+					set.add(static_cast<unsigned char>(low));
+				}
+			}
+			if (position >= pattern.length()) {
+				position = open;
+				return fail("missing ]");
+			}
+			position++;
+			if (caseInsensitive)
+				fold(set);
+			if (negated)
+				set.invert();
+			result = bytes(set);
+			return true;
+		}
+
+		/**
+		 * Makes the fragment of a literal byte
+		 * @param byte The byte
+		 * @param result The fragment consuming the byte
+		 * @returns true
+		 */
+		bool parseLiteral(unsigned char byte, Fragment& result) {
+			ByteSet set;
+			set.add(byte);
+			if (caseInsensitive)
+				fold(set);
+			literal = byte;
+			result = bytes(set);
+			return true;
+		}
+
+		/**
+		 * Parses a group, class, escape, anchor or literal
+		 * @param result The fragment of the atom
+		 * @returns Whether or not the atom was valid
+		 */
+		bool parseAtom(Fragment& result) {
+			literal = -1;
+			char character = pattern[position];
+			switch (character) {
+			case '(': {
+				position++;
+				if (position < pattern.length() && pattern[position] == '?') {
+					if (position + 1 >= pattern.length() || pattern[position + 1] != ':')
+						return fail("unsupported group");
+					position += 2;
+				}
+				if (++depth > maxDepth) return fail("groups nested too deeply");
+				if (!parseAlternation(result)) return false;
+				depth--;
+				if (position >= pattern.length()) return fail("missing )");
+				position++;
+				literal = -1;
+				return true;
+			}
+			case '[':
+				return parseClass(result);
+			case '.': {
+				position++;
+				ByteSet set;
+				set.add(0, '\n' - 1);
+				set.add('\n' + 1, 255);
+				result = bytes(set);
+				return true;
+			}
+			case '^':
+				position++;
+				result = single(emit(reverse ? RegexOp::assertEnd : RegexOp::assertStart));
+				return true;
+			case '$':
+				position++;
+				result = single(emit(reverse ? RegexOp::assertStart : RegexOp::assertEnd));
+				return true;
+			case '*': case '+': case '?': case '{':
+				return fail("nothing to repeat");
+			case '\\': {
+				position++;
+				ByteSet set;
+				int value = parseEscapeCharacter(set);
+				if (value == -2) return false;
+				if (value >= 0) return parseLiteral(static_cast<unsigned char>(value), result);
+				result = bytes(set);
+				return true;
+			}
+			default:
+				position++;
+				return parseLiteral(static_cast<unsigned char>(character), result);
+			}
+		}
+
+		/**
+		 * Parses a decimal count of a {m,n} repetition
+		 * @param count The count (saturated just past maxRepeat)
+		 * @returns Whether or not there were any digits
+		 */
+		bool parseCount(size_t& count) {
+			size_t start = position;
+			count = 0;
+			while (position < pattern.length() && pattern[position] >= '0' && pattern[position] <= '9') {
+				count = std::min(count * 10 + static_cast<size_t>(pattern[position] - '0'), maxRepeat + 1);
+				position++;
+			}
+			return position != start;
+		}
+
+		/**
+		 * Parses the quantifier after an atom if there is one
+		 * @param minimum The least number of times the atom repeats
+		 * @param maximum The most number of times the atom repeats (unbounded for no limit)
+		 * @returns Whether or not the quantifier was valid
+		 */
+		bool parseQuantifier(size_t& minimum, size_t& maximum) {
+			if (position >= pattern.length()) return true;
+			switch (pattern[position]) {
+			case '*':
+				minimum = 0;
+				maximum = unbounded;
+				break;
+			case '+':
+				minimum = 1;
+				maximum = unbounded;
+				break;
+			case '?':
+				minimum = 0;
+				maximum = 1;
+				break;
+			case '{':
+				position++;
+				if (!parseCount(minimum)) return fail("invalid repetition");
+				maximum = minimum;
+				if (position < pattern.length() && pattern[position] == ',') {
+					position++;
+					if (!parseCount(maximum))
+						maximum = unbounded;
+				}
+				if (position >= pattern.length() || pattern[position] != '}') return fail("invalid repetition");
+				if (minimum > maxRepeat || (maximum != unbounded && maximum > maxRepeat)) return fail("repetition too large");
+				if (maximum < minimum) return fail("invalid repetition");
+				break;
+			default:
+				return true;
+			}
+			position++;
+			// Lazy quantifiers match the same strings, which is all a DFA reports
+			if (position < pattern.length() && pattern[position] == '?')
+				position++;
+			if (position < pattern.length() && (pattern[position] == '*' || pattern[position] == '+' || pattern[position] == '?' || pattern[position] == '{'))
+				return fail("nested quantifier");
+			return true;
+		}
+
+		/**
+		 * Builds a {m,n} repetition by compiling the atom again for every copy
+		 * @param result The first copy of the atom, replaced by the repetition
+		 * @param atomStart The position of the atom in the pattern
+		 * @param minimum The least number of copies
+		 * @param maximum The most number of copies (unbounded for no limit)
+		 * @returns Whether or not the repetition fit in the program
+		 */
+		bool repeat(Fragment& result, size_t atomStart, size_t minimum, size_t maximum) {
+			size_t end = position;
+			Fragment spare = result;
+			bool spareUsed = false;
+			auto copy = [&](Fragment& piece) {
+				if (!spareUsed) {
+					spareUsed = true;
+					piece = spare;
+					return true;
+				}
+				if (program.instructions.length() > maxInstructions) return fail("pattern too large");
+				position = atomStart;
+				bool valid = parseAtom(piece);
+				position = end;
+				return valid;
+			};
+			Fragment built;
+			bool any = false;
+			for (size_t i = 0; i < minimum; i++) {
+				Fragment piece;
+				if (!copy(piece)) return false;
+				built = any ? concatenate(built, piece) : piece;
+				any = true;
+			}
+			if (maximum == unbounded) {
+				Fragment piece;
+				if (!copy(piece)) return false;
+				piece = star(piece);
+				built = any ? concatenate(built, piece) : piece;
+				any = true;
+			} else if (maximum > minimum) {
+				// x{0,3} is (x(x(x)?)?)? so that every extra copy is only tried after the one before it
+				Fragment tail;
+				if (!copy(tail)) return false;
+				tail = optional(tail);
+				for (size_t i = minimum + 1; i < maximum; i++) {
+					Fragment piece;
+					if (!copy(piece)) return false;
+					tail = optional(concatenate(piece, tail));
+				}
+				built = any ? concatenate(built, tail) : tail;
+				any = true;
+			}
+			result = any ? built : empty();
+			return true;
+		}
+
+		/**
+		 * Parses an atom and its quantifier
+		 * @param result The fragment of the repetition
+		 * @returns Whether or not the repetition was valid
+		 */
+		bool parseRepetition(Fragment& result) {
+			size_t atomStart = position;
+			if (!parseAtom(result)) return false;
+			int atomLiteral = literal;
+			size_t minimum = 1;
+			size_t maximum = 1;
+			if (!parseQuantifier(minimum, maximum)) return false;
+
+			if (collectPrefix && depth == 0) {
+				if (atomLiteral >= 0 && minimum != 0 && !caseInsensitive)
+					program.prefix.append(static_cast<char>(atomLiteral));
+				if (atomLiteral < 0 || minimum != 1 || maximum != 1 || caseInsensitive)
+					collectPrefix = false;
+			}
+
+			if (minimum == 0 && maximum == unbounded)
+				result = star(result);
+			else if (minimum == 1 && maximum == unbounded)
+				result = plus(result);
+			else if (minimum == 0 && maximum == 1)
+				result = optional(result);
+			else if ((minimum != 1 || maximum != 1) && !repeat(result, atomStart, minimum, maximum))
+				return false;
+			if (program.instructions.length() > maxInstructions) return fail("pattern too large");
+			return true;
+		}
+
+		/**
+		 * Parses a sequence of repetitions up to a | or )
+		 * @param result The fragment of the sequence
+		 * @returns Whether or not the sequence was valid
+		 */
+		bool parseConcatenation(Fragment& result) {
+			bool first = true;
+			while (position < pattern.length() && pattern[position] != '|' && pattern[position] != ')') {
+				Fragment piece;
+				if (!parseRepetition(piece)) return false;
+				result = first ? piece : concatenate(result, piece);
+				first = false;
+			}
+			if (first)
+				result = empty();
+			return true;
+		}
+
+		/**
+		 * Parses sequences separated by |
+		 * @param result The fragment of the alternation
+		 * @returns Whether or not the alternation was valid
+		 */
+		bool parseAlternation(Fragment& result) {
+			if (!parseConcatenation(result)) return false;
+			while (position < pattern.length() && pattern[position] == '|') {
+				position++;
+				if (depth == 0) {
+					// Other branches can start with anything
+					program.prefix.clear();
+					collectPrefix = false;
+				}
+				Fragment other;
+				if (!parseConcatenation(other)) return false;
+				result = alternate(result, other);
+			}
+			return true;
+		}
+
+	public:
+		/**
+		 * Prepares to compile a pattern
+		 * @param program The program to add the pattern to
+		 * @param pattern The pattern
+		 * @param reverse Whether or not to compile the pattern reversed
+		 * @param caseInsensitive Whether or not letters match both cases
+		 * @param collectPrefix Whether or not to record the literal prefix of the pattern in the program
+		 */
+		RegexCompiler(RegexProgram& program, StringView pattern, bool reverse, bool caseInsensitive, bool collectPrefix) : program(program), pattern(pattern), reverse(reverse), caseInsensitive(caseInsensitive), collectPrefix(collectPrefix) {}
+
+		/**
+		 * Compiles the pattern
+		 * @param patternId The id the match instruction reports
+		 * @param start Set to the first instruction of the pattern
+		 * @returns Whether or not the pattern was valid
+		 */
+		bool compile(uint32_t patternId, uint32_t& start) {
+			Fragment result;
+			if (!parseAlternation(result)) return false;
+			if (position < pattern.length()) return fail("unmatched )");
+			patch(result, emit(RegexOp::match, patternId));
+			start = result.start;
+			return true;
+		}
+
+		/**
+		 * Gets the error of an invalid pattern
+		 * @returns The error message (nullptr if there is none)
+		 */
+		const char* error() const {
+			return message;
+		}
+
+		/**
+		 * Gets where the error of an invalid pattern is
+		 * @returns The position of the error in the pattern
+		 */
+		size_t errorPosition() const {
+			return messagePosition;
+		}
+	};
+
+	/**
+	 * How a RegexDfa runs its program
+	 */
+	enum class RegexSearch : uint8_t {
+		/**
+		 * Matches only starting at the first byte
+		 */
+		anchored,
+		/**
+		 * Matches starting anywhere, with states holding every running thread in one set
+		 */
+		unanchored,
+		/**
+		 * Matches starting anywhere, keeping threads grouped by where they started so that once a match is seen only threads that started before it keep running (for leftmost longest matches)
+		 */
+		leftmost
+	};
+
+	/**
+	 * A DFA built lazily from a RegexProgram, every state is a set of NFA instructions
+	 * States and transitions are cached until they use more than the cache limit, when the whole cache is flushed
+	 * Building a state takes time linear in the size of the program, so matching is linear in the text with no backtracking
+	 * Transitions are tagged, (state << 1) | accepting, where 0 is the dead state
+	 */
+	class RegexDfa {
+	private:
+		/**
+		 * A cached DFA state
+		 */
+		struct State {
+			/**
+			 * Where the instructions of the state start in contents
+			 */
+			uint32_t contentStart;
+
+			/**
+			 * The number of instructions (and group marks) of the state
+			 */
+			uint32_t contentLength;
+
+			/**
+			 * Where the ids of the patterns matched in this state start in matchIds
+			 */
+			uint32_t matchStart;
+
+			/**
+			 * The number of patterns matched in this state
+			 */
+			uint32_t matchLength;
+
+			/**
+			 * Where the ids of the patterns matched if the text ends in this state start in matchIds
+			 */
+			uint32_t endMatchStart;
+
+			/**
+			 * The number of patterns matched if the text ends in this state
+			 */
+			uint32_t endMatchLength;
+
+			/**
+			 * The last scan which collected the matches of this state
+			 */
+			uint32_t stamp;
+
+			/**
+			 * Flags of the state (matchSeen, textStart)
+			 */
+			uint8_t flags;
+		};
+
+		/**
+		 * A transition that has not been built yet
+		 */
+		static constexpr uint32_t unknown = UINT32_MAX;
+
+		/**
+		 * Ends a group of threads in a leftmost state
+		 */
+		static constexpr uint32_t mark = UINT32_MAX;
+
+		/**
+		 * The flag of leftmost states after a match, which start no new threads
+		 */
+		static constexpr uint8_t matchSeen = 1;
+
+		/**
+		 * The flag of start states which depend on being at the start of the text
+		 */
+		static constexpr uint8_t textStart = 2;
+
+		/**
+		 * The program being run
+		 */
+		const RegexProgram* program = nullptr;
+
+		/**
+		 * How the program is run
+		 */
+		RegexSearch search = RegexSearch::anchored;
+
+		/**
+		 * The number of transitions of each state
+		 */
+		size_t classCount = 1;
+
+		/**
+		 * The number of bytes the cache may use before it is flushed
+		 */
+		size_t cacheLimit = 0;
+
+		/**
+		 * The approximate number of bytes the cache is using
+		 */
+		size_t memory = 0;
+
+		/**
+		 * The number of times the cache has been flushed
+		 */
+		uint32_t flushCount = 0;
+
+		/**
+		 * The current scan collecting matches
+		 */
+		uint32_t scan = 0;
+
+		/**
+		 * The tagged start states, after the start of the text and at it
+		 */
+		uint32_t starts[2] = {unknown, unknown};
+
+		/**
+		 * The cached states, state 0 is dead
+		 */
+		DataStructures::ArrayList<State> states;
+
+		/**
+		 * The tagged transitions, classCount per state
+		 */
+		DataStructures::ArrayList<uint32_t> transitions;
+
+		/**
+		 * The instructions of every state
+		 */
+		DataStructures::ArrayList<uint32_t> contents;
+
+		/**
+		 * The pattern ids matched by every state
+		 */
+		DataStructures::ArrayList<uint32_t> matchIds;
+
+		/**
+		 * Finds a cached state from its flags and instructions
+		 */
+		DataStructures::HashMap<String, uint32_t> lookup;
+
+		/**
+		 * The generation each instruction was last added to a state in
+		 */
+		DataStructures::ArrayList<uint32_t> visited;
+
+		/**
+		 * The current generation
+		 */
+		uint32_t generation = 0;
+
+		/**
+		 * Whether or not the last closure passed a start of text assertion
+		 */
+		bool touchedStart = false;
+
+		/**
+		 * Scratch instructions left to follow in a closure
+		 */
+		DataStructures::ArrayList<uint32_t> stack;
+
+		/**
+		 * Scratch copy of the state being stepped from
+		 */
+		DataStructures::ArrayList<uint32_t> current;
+
+		/**
+		 * Scratch instructions of the state being built
+		 */
+		DataStructures::ArrayList<uint32_t> next;
+
+		/**
+		 * Scratch instructions of one group of the state being built
+		 */
+		DataStructures::ArrayList<uint32_t> group;
+
+		/**
+		 * Scratch key of the state being built
+		 */
+		String key;
+
+		/**
+		 * Scratch instructions of a state waiting for the cache to be flushed
+		 */
+		DataStructures::ArrayList<uint32_t> pending;
+
+		/**
+		 * The threads starting at every position of an unanchored search
+		 */
+		DataStructures::ArrayList<uint32_t> startClosure;
+
+		/**
+		 * Whether or not each instruction is in startClosure
+		 */
+		DataStructures::ArrayList<uint8_t> inStart;
+
+		/**
+		 * Whether or not the cache is being flushed, so rebuilding the restart state does not flush it again
+		 */
+		bool flushing = false;
+
+		/**
+		 * Starts a new generation so no instruction counts as visited
+		 */
+		void nextGeneration() {
+			if (visited.length() < program->instructions.length())
+				visited.resize(program->instructions.length(), 0);
+			if (++generation == 0) {
+				std::fill(visited.begin(), visited.end(), 0);
+				generation = 1;
+			}
+		}
+
+		/**
+		 * Follows the empty transitions from an instruction, adding every unvisited instruction that consumes a byte, matches or waits for the end of the text
+		 * @param first The instruction to start at
+		 * @param atStart Whether or not this is the start of the text
+		 * @param atEnd Whether or not this is the end of the text
+		 * @param out The list to add the instructions to
+		 */
+		void closure(uint32_t first, bool atStart, bool atEnd, DataStructures::ArrayList<uint32_t>& out) {
+			stack.push(first);
+			while (stack.length() != 0) {
+				uint32_t index = stack[stack.length() - 1];
+				stack.resizeUninitialized(stack.length() - 1);
+				if (visited[index] == generation) continue;
+				visited[index] = generation;
+				const RegexInstruction& instruction = program->instructions[index];
+				switch (instruction.op) {
+				case RegexOp::bytes:
+				case RegexOp::match:
+					out.push(index);
+					break;
+				case RegexOp::assertEnd:
+					if (atEnd)
+						stack.push(instruction.out);
+					else
+						out.push(index);
+					break;
+				case RegexOp::assertStart:
+					touchedStart = true;
+					if (atStart)
+						stack.push(instruction.out);
+					break;
+				case RegexOp::split:
+					stack.push(instruction.alternate);
+					stack.push(instruction.out);
+					break;
+				case RegexOp::jump:
+					stack.push(instruction.out);
+					break;
+				}
+			}
+		}
+
+		/**
+		 * Moves the scratch group into the state being built
+		 * @param flags The flags of the state, gains matchSeen if a leftmost group matched
+		 * @returns Whether or not a leftmost group matched, so later groups are dropped
+		 */
+		bool appendGroup(uint8_t& flags) {
+			if (group.length() == 0) return false;
+			if (search != RegexSearch::leftmost) {
+				next.append(group.data(), group.length());
+				return false;
+			}
+			std::sort(group.begin(), group.end());
+			next.append(group.data(), group.length());
+			next.push(mark);
+			for (uint32_t index : group) {
+				if (program->instructions[index].op == RegexOp::match) {
+					flags |= matchSeen;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * Adds the state dead transitions lead to
+		 */
+		void addDead() {
+			states.push({0, 0, 0, 0, 0, 0, 0, 0});
+			for (size_t i = 0; i < classCount; i++)
+				transitions.push(0);
+		}
+
+		/**
+		 * Builds the state matching begins in
+		 * @param atTextStart Whether or not matching begins at the start of the text
+		 * @returns The tagged state
+		 */
+		uint32_t buildStart(bool atTextStart) {
+			next.clear();
+			group.clear();
+			nextGeneration();
+			touchedStart = false;
+			closure(program->start, atTextStart, false, group);
+			uint8_t flags = 0;
+			if (atTextStart) {
+				bool waitsForEnd = false;
+				for (uint32_t index : group)
+					waitsForEnd |= program->instructions[index].op == RegexOp::assertEnd;
+				if (touchedStart || waitsForEnd)
+					flags = textStart;
+			}
+			appendGroup(flags);
+			return insert(flags);
+		}
+
+		/**
+		 * Throws away every cached state, then rebuilds the restart state so scans can always compare against it
+		 */
+		void flush() {
+			states.clear();
+			transitions.clear();
+			contents.clear();
+			matchIds.clear();
+			lookup.clear();
+			memory = 0;
+			flushCount++;
+			starts[0] = unknown;
+			starts[1] = unknown;
+			addDead();
+			flushing = true;
+			starts[0] = buildStart(false);
+			flushing = false;
+		}
+
+		/**
+		 * Adds the ids of the patterns an instruction list matches, with and without the end of the text
+		 * @param list The instructions
+		 * @param flags The flags of the state the instructions are in
+		 * @param atEnd Whether or not to follow $ (the matches must already be in the current generation)
+		 */
+		void addMatches(const DataStructures::ArrayList<uint32_t>& list, uint8_t flags, bool atEnd) {
+			for (uint32_t index : list) {
+				if (index == mark) continue;
+				const RegexInstruction& instruction = program->instructions[index];
+				if (!atEnd && instruction.op == RegexOp::match) {
+					matchIds.push(instruction.argument);
+					visited[index] = generation;
+				} else if (atEnd && instruction.op == RegexOp::assertEnd) {
+					closure(instruction.out, flags & textStart, true, group);
+				}
+			}
+		}
+
+		/**
+		 * Finds or caches the state of the scratch instructions
+		 * In unanchored searches the threads starting at every position are implied and left out of the instructions
+		 * @param flags The flags of the state
+		 * @returns The tagged state
+		 */
+		uint32_t insert(uint8_t flags) {
+			if (search == RegexSearch::unanchored)
+				next.removeIf([this](uint32_t index) {
+					return inStart[index] != 0;
+				});
+			if (search != RegexSearch::leftmost)
+				std::sort(next.begin(), next.end());
+			if (next.length() == 0 && (search != RegexSearch::unanchored || startClosure.length() == 0)) return 0;
+			key.clear();
+			key.append(static_cast<char>(flags));
+			key.append(StringView(reinterpret_cast<const char*>(next.data()), next.length() * sizeof(uint32_t)));
+			if (const uint32_t* found = lookup.get(key))
+				return *found;
+			if (memory > cacheLimit && !flushing) {
+				std::swap(next, pending);
+				flush();
+				std::swap(next, pending);
+				key.clear();
+				key.append(static_cast<char>(flags));
+				key.append(StringView(reinterpret_cast<const char*>(next.data()), next.length() * sizeof(uint32_t)));
+			}
+
+			State state;
+			state.contentStart = static_cast<uint32_t>(contents.length());
+			state.contentLength = static_cast<uint32_t>(next.length());
+			contents.append(next.data(), next.length());
+
+			nextGeneration();
+			state.matchStart = static_cast<uint32_t>(matchIds.length());
+			addMatches(next, flags, false);
+			if (search == RegexSearch::unanchored)
+				addMatches(startClosure, flags, false);
+			state.matchLength = static_cast<uint32_t>(matchIds.length()) - state.matchStart;
+
+			// The patterns matched when the text ends here include those behind a $
+			group.clear();
+			addMatches(next, flags, true);
+			if (search == RegexSearch::unanchored)
+				addMatches(startClosure, flags, true);
+			state.endMatchStart = static_cast<uint32_t>(matchIds.length());
+			for (uint32_t i = 0; i < state.matchLength; i++)
+				matchIds.push(matchIds[state.matchStart + i]);
+			for (uint32_t index : group) {
+				if (program->instructions[index].op == RegexOp::match)
+					matchIds.push(program->instructions[index].argument);
+			}
+			state.endMatchLength = static_cast<uint32_t>(matchIds.length()) - state.endMatchStart;
+			state.stamp = 0;
+			state.flags = flags;
+
+			uint32_t tagged = static_cast<uint32_t>(states.length() << 1) | (state.matchLength != 0);
+			states.push(state);
+			for (size_t i = 0; i < classCount; i++)
+				transitions.push(unknown);
+			memory += sizeof(State) + classCount * sizeof(uint32_t) + next.length() * sizeof(uint32_t) * 2 + (state.matchLength + state.endMatchLength) * sizeof(uint32_t) + key.length() + 64;
+			lookup.insert(key, tagged);
+			return tagged;
+		}
+
+		/**
+		 * Steps every bytes instruction of a list over a byte
+		 * @param list The instructions
+		 * @param from The first instruction of the group to step
+		 * @param byte The byte consumed
+		 * @returns The position after the group
+		 */
+		size_t stepGroup(const DataStructures::ArrayList<uint32_t>& list, size_t from, unsigned char byte) {
+			for (; from < list.length() && list[from] != mark; from++) {
+				const RegexInstruction& instruction = program->instructions[list[from]];
+				if (instruction.op == RegexOp::bytes && program->sets[instruction.argument].contains(byte))
+					closure(instruction.out, false, false, group);
+			}
+			return from + 1;
+		}
+
+		/**
+		 * Builds and caches a transition
+		 * @param index The state to step from
+		 * @param byteClass The class of the byte consumed
+		 * @returns The tagged state stepped to
+		 */
+		uint32_t computeNext(uint32_t index, size_t byteClass) {
+			const State& state = states[index];
+			current.clear();
+			current.append(contents.data() + state.contentStart, state.contentLength);
+			uint8_t flags = state.flags & matchSeen;
+			unsigned char byte = program->representatives[byteClass];
+			uint32_t flushes = flushCount;
+
+			next.clear();
+			nextGeneration();
+			if (search != RegexSearch::leftmost) {
+				group.clear();
+				stepGroup(current, 0, byte);
+				if (search == RegexSearch::unanchored)
+					stepGroup(startClosure, 0, byte);
+				appendGroup(flags);
+			} else {
+				size_t position = 0;
+				bool stop = false;
+				while (position < current.length() && !stop) {
+					group.clear();
+					position = stepGroup(current, position, byte);
+					stop = appendGroup(flags);
+				}
+				if (!(flags & matchSeen)) {
+					// A new thread starts at every position, after every older thread
+					group.clear();
+					closure(program->start, false, false, group);
+					appendGroup(flags);
+				}
+			}
+
+			uint32_t result = insert(flags);
+			if (flushes == flushCount)
+				transitions[index * classCount + byteClass] = result;
+			return result;
+		}
+
+	public:
+		/**
+		 * Makes a DFA that is not attached to a program
+		 */
+		RegexDfa() = default;
+
+		/**
+		 * Attaches the DFA to a program, throwing away any cached states
+		 * @param program The program to run (must outlive the DFA or the next attach)
+		 * @param search How to run the program
+		 * @param cacheLimit The number of bytes the cache may use before it is flushed
+		 */
+		void attach(const RegexProgram& program, RegexSearch search, size_t cacheLimit) {
+			this->program = &program;
+			this->search = search;
+			this->cacheLimit = cacheLimit;
+			classCount = program.classCount;
+			states.clear();
+			transitions.clear();
+			contents.clear();
+			matchIds.clear();
+			lookup.clear();
+			visited.clear();
+			startClosure.clear();
+			inStart.clear();
+			generation = 0;
+			memory = 0;
+			starts[0] = unknown;
+			starts[1] = unknown;
+		}
+
+		/**
+		 * Gets the state matching begins in, call before holding any other state since it may flush the cache
+		 * @param atTextStart Whether or not matching begins at the start of the text
+		 * @returns The tagged state
+		 */
+		uint32_t start(bool atTextStart) {
+			if (states.length() == 0) {
+				addDead();
+				if (search == RegexSearch::unanchored) {
+					nextGeneration();
+					closure(program->start, false, false, startClosure);
+					inStart.resize(program->instructions.length(), 0);
+					for (uint32_t index : startClosure)
+						inStart[index] = 1;
+				}
+			}
+			if (starts[0] == unknown)
+				starts[0] = buildStart(false);
+			if (atTextStart && starts[1] == unknown)
+				starts[1] = buildStart(true);
+			return starts[atTextStart];
+		}
+
+		/**
+		 * Gets the state of a search with no thread running, which is always cached once start has been called
+		 * @returns The tagged state
+		 */
+		inline uint32_t restart() const {
+			return starts[0];
+		}
+
+		/**
+		 * Steps the DFA over a byte
+		 * @param tagged The tagged state to step from
+		 * @param byte The byte consumed
+		 * @returns The tagged state stepped to
+		 */
+		inline uint32_t step(uint32_t tagged, unsigned char byte) {
+			size_t byteClass = program->classes[byte];
+			uint32_t target = transitions.data()[(tagged >> 1) * classCount + byteClass];
+			if (target != unknown) return target;
+			return computeNext(tagged >> 1, byteClass);
+		}
+
+		/**
+		 * Checks if a state matches when the text ends in it
+		 * @param tagged The tagged state
+		 * @returns Whether or not it matches at the end of the text
+		 */
+		bool acceptsAtEnd(uint32_t tagged) const {
+			return states[tagged >> 1].endMatchLength != 0;
+		}
+
+		/**
+		 * Starts a new scan for collectMatches, so each state reports its patterns once per scan
+		 */
+		void beginScan() {
+			if (++scan == 0) {
+				for (State& state : states)
+					state.stamp = 0;
+				scan = 1;
+			}
+		}
+
+		/**
+		 * Reports the ids of the patterns matched in a state
+		 * @param tagged The tagged state
+		 * @param atEnd Whether or not the text ends in the state
+		 * @param found Called with each pattern id (only the first time a state is seen in a scan unless atEnd)
+		 */
+		template<typename F>
+		void collectMatches(uint32_t tagged, bool atEnd, F&& found) {
+			State& state = states[tagged >> 1];
+			if (atEnd) {
+				for (uint32_t i = 0; i < state.endMatchLength; i++)
+					found(matchIds[state.endMatchStart + i]);
+				return;
+			}
+			if (state.stamp == scan) return;
+			state.stamp = scan;
+			for (uint32_t i = 0; i < state.matchLength; i++)
+				found(matchIds[state.matchStart + i]);
+		}
+	};
+
+	/**
+	 * Where a regex matched in a text
+	 */
+	struct RegexMatch {
+		/**
+		 * The index of the first byte of the match (notFound if there was no match)
+		 */
+		size_t start = notFound;
+
+		/**
+		 * The index just past the last byte of the match (notFound if there was no match)
+		 */
+		size_t end = notFound;
+
+		/**
+		 * Checks if there was a match
+		 * @returns Whether or not there was a match
+		 */
+		bool found() const {
+			return start != notFound;
+		}
+
+		/**
+		 * Gets the number of bytes matched
+		 * @returns The length of the match
+		 */
+		size_t length() const {
+			return end - start;
+		}
+	};
+
+	/**
+	 * A compiled regular expression, matched by lazily built DFAs in time linear in the text
+	 * Patterns are byte oriented (UTF-8 text works, but classes and . see single bytes) and matches are leftmost longest
+	 * Matching fills caches, so one Regex must not match on several threads at once, copies share the compiled program and are cheap
+	 */
+	class Regex {
+	private:
+		/**
+		 * The program of the pattern
+		 */
+		std::shared_ptr<const RegexProgram> forward;
+
+		/**
+		 * The program of the reversed pattern, used to find where matches start
+		 */
+		std::shared_ptr<const RegexProgram> backward;
+
+		/**
+		 * The cache limit of each DFA
+		 */
+		size_t cacheBytes;
+
+		/**
+		 * The error message (nullptr if the pattern was valid)
+		 */
+		const char* message = nullptr;
+
+		/**
+		 * The position of the error in the pattern
+		 */
+		size_t messagePosition = 0;
+
+		/**
+		 * Finds whether there is a match anywhere
+		 */
+		RegexDfa searcher;
+
+		/**
+		 * Finds whether the whole text matches
+		 */
+		RegexDfa matcher;
+
+		/**
+		 * Finds where the leftmost longest match ends
+		 */
+		RegexDfa leftmost;
+
+		/**
+		 * Finds where a match ending at some position starts
+		 */
+		RegexDfa reverse;
+
+		/**
+		 * Attaches the DFAs to the programs
+		 */
+		void attach() {
+			if (!forward) return;
+			searcher.attach(*forward, RegexSearch::unanchored, cacheBytes);
+			matcher.attach(*forward, RegexSearch::anchored, cacheBytes);
+			leftmost.attach(*forward, RegexSearch::leftmost, cacheBytes);
+			reverse.attach(*backward, RegexSearch::anchored, cacheBytes);
+		}
+
+	public:
+		/**
+		 * Compiles a pattern, check valid() before matching
+		 * @param pattern The pattern
+		 * @param options The compile options
+		 */
+		Regex(StringView pattern, const RegexOptions& options = RegexOptions()) : cacheBytes(options.cacheBytes) {
+			std::shared_ptr<RegexProgram> program = std::make_shared<RegexProgram>();
+			RegexCompiler compiler(*program, pattern, false, options.caseInsensitive, true);
+			if (!compiler.compile(0, program->start)) {
+				message = compiler.error();
+				messagePosition = compiler.errorPosition();
+				return;
+			}
+			std::shared_ptr<RegexProgram> reversed = std::make_shared<RegexProgram>();
+			RegexCompiler reverseCompiler(*reversed, pattern, true, options.caseInsensitive, false);
+			reverseCompiler.compile(0, reversed->start);
+
+			for (RegexProgram* compiled : {program.get(), reversed.get()}) {
+				compiled->patternCount = 1;
+				compiled->computeClasses();
+				compiled->setLookup.clear();
+			}
+			forward = std::move(program);
+			backward = std::move(reversed);
+			attach();
+		}
+
+		/**
+		 * Copies a regex, sharing its program but not its caches
+		 * @param other The regex to copy
+		 */
+		Regex(const Regex& other) : forward(other.forward), backward(other.backward), cacheBytes(other.cacheBytes), message(other.message), messagePosition(other.messagePosition) {
+			attach();
+		}
+
+		/**
+		 * Moves a regex
+		 * @param other The regex to move
+		 */
+		Regex(Regex&& other) noexcept = default;
+
+		/**
+		 * Copies a regex, sharing its program but not its caches
+		 * @param other The regex to copy
+		 * @returns This regex
+		 */
+		Regex& operator=(const Regex& other) {
+			if (this == &other) return *this;
+			forward = other.forward;
+			backward = other.backward;
+			cacheBytes = other.cacheBytes;
+			message = other.message;
+			messagePosition = other.messagePosition;
+			attach();
+			return *this;
+		}
+
+		/**
+		 * Moves a regex
+		 * @param other The regex to move
+		 * @returns This regex
+		 */
+		Regex& operator=(Regex&& other) noexcept = default;
+
+		/**
+		 * Checks if the pattern compiled
+		 * @returns Whether or not the pattern was valid
+		 */
+		bool valid() const {
+			return forward != nullptr;
+		}
+
+		/**
+		 * Gets why the pattern did not compile
+		 * @returns The error message (nullptr if the pattern was valid)
+		 */
+		const char* error() const {
+			return message;
+		}
+
+		/**
+		 * Gets where the pattern stopped compiling
+		 * @returns The position of the error in the pattern
+		 */
+		size_t errorPosition() const {
+			return messagePosition;
+		}
+
+		/**
+		 * Checks if the whole text matches
+		 * @param text The text to match
+		 * @returns Whether or not the pattern matches all of the text
+		 */
+		bool matches(StringView text) {
+			if (!valid()) return false;
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+			uint32_t state = matcher.start(true);
+			for (size_t i = 0; i < text.length(); i++) {
+				state = matcher.step(state, bytes[i]);
+				if (state == 0) return false;
+			}
+			return matcher.acceptsAtEnd(state);
+		}
+
+		/**
+		 * Checks if the pattern matches anywhere in the text, stopping at the first position a match ends
+		 * @param text The text to search
+		 * @returns Whether or not there is a match
+		 */
+		bool contains(StringView text) {
+			if (!valid()) return false;
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+			size_t length = text.length();
+			const String& prefix = forward->prefix;
+			uint32_t state = searcher.start(true);
+			if (state & 1) return true;
+			for (size_t i = 0; i < length; i++) {
+				if (prefix.length() != 0 && state == searcher.restart()) {
+					// No thread is running, so skip straight to where the next match could start
+					size_t skip = findSubstring(text.data() + i, length - i, prefix.data(), prefix.length());
+					if (skip == notFound) return false;
+					i += skip;
+				}
+				state = searcher.step(state, bytes[i]);
+				if (state & 1) return true;
+				if (state == 0) return false;
+			}
+			return searcher.acceptsAtEnd(state);
+		}
+
+		/**
+		 * Finds the leftmost longest match starting at or after a position
+		 * @param text The text to search
+		 * @param from The position to start searching at (^ only matches if it is 0)
+		 * @returns The match (not found if there is none)
+		 */
+		RegexMatch find(StringView text, size_t from = 0) {
+			RegexMatch match;
+			size_t length = text.length();
+			if (!valid() || from > length) return match;
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+			const String& prefix = forward->prefix;
+
+			// Forward to the end of the longest match of the leftmost thread
+			uint32_t state = leftmost.start(from == 0);
+			size_t end = (state & 1) ? from : notFound;
+			size_t position = from;
+			for (; position < length && state != 0; position++) {
+				if (prefix.length() != 0 && state == leftmost.restart()) {
+					size_t skip = findSubstring(text.data() + position, length - position, prefix.data(), prefix.length());
+					if (skip == notFound) break;
+					position += skip;
+				}
+				state = leftmost.step(state, bytes[position]);
+				if (state & 1)
+					end = position + 1;
+			}
+			if (position == length && state != 0 && leftmost.acceptsAtEnd(state))
+				end = length;
+			if (end == notFound) return match;
+
+			// Backward from the end to the leftmost start
+			uint32_t backwardState = reverse.start(end == length);
+			size_t start = (backwardState & 1) ? end : notFound;
+			position = end;
+			while (position > from && backwardState != 0) {
+				position--;
+				backwardState = reverse.step(backwardState, bytes[position]);
+				if (backwardState & 1)
+					start = position;
+			}
+			if (position == 0 && backwardState != 0 && reverse.acceptsAtEnd(backwardState))
+				start = 0;
+			match.start = start;
+			match.end = end;
+			return match;
+		}
+
+		/**
+		 * Finds every non overlapping leftmost longest match
+		 * @param text The text to search
+		 * @returns The matches in order
+		 */
+		DataStructures::ArrayList<RegexMatch> findAll(StringView text) {
+			DataStructures::ArrayList<RegexMatch> result;
+			size_t from = 0;
+			while (from <= text.length()) {
+				RegexMatch match = find(text, from);
+				if (!match.found()) break;
+				result.push(match);
+				from = match.end > match.start ? match.end : match.end + 1;
+			}
+			return result;
+		}
+	};
+
+	/**
+	 * Many patterns compiled into one program, so a single pass over a text finds which of them match
+	 * Matching fills a cache, so one RegexSet must not match on several threads at once, copies share the compiled program and are cheap
+	 */
+	class RegexSet {
+	private:
+		/**
+		 * The program of every pattern
+		 */
+		std::shared_ptr<RegexProgram> program = std::make_shared<RegexProgram>();
+
+		/**
+		 * The first instruction of each pattern
+		 */
+		DataStructures::ArrayList<uint32_t> starts;
+
+		/**
+		 * The compile options
+		 */
+		RegexOptions options;
+
+		/**
+		 * The error message of the last pattern added (nullptr if it was valid)
+		 */
+		const char* message = nullptr;
+
+		/**
+		 * The position of the error in the last pattern added
+		 */
+		size_t messagePosition = 0;
+
+		/**
+		 * Whether or not the program is ready to match
+		 */
+		bool prepared = false;
+
+		/**
+		 * Finds the patterns matching anywhere
+		 */
+		RegexDfa searcher;
+
+		/**
+		 * Which patterns have been found in the current scan
+		 */
+		DataStructures::ArrayList<uint8_t> seen;
+
+		/**
+		 * Takes a copy of the program if it is shared with another set
+		 */
+		void own() {
+			if (program.use_count() > 1)
+				program = std::make_shared<RegexProgram>(*program);
+		}
+
+		/**
+		 * Links the patterns under one start instruction and attaches the DFA
+		 */
+		void prepare() {
+			if (prepared) return;
+			own();
+			uint32_t start = starts[starts.length() - 1];
+			for (size_t i = starts.length() - 1; i-- > 0;) {
+				uint32_t split = static_cast<uint32_t>(program->instructions.length());
+				program->instructions.push({RegexOp::split, starts[i], start, 0});
+				start = split;
+			}
+			program->start = start;
+			program->patternCount = starts.length();
+			program->computeClasses();
+			searcher.attach(*program, RegexSearch::unanchored, options.cacheBytes);
+			prepared = true;
+		}
+
+	public:
+		/**
+		 * Makes an empty set
+		 * @param options The options every pattern is compiled with
+		 */
+		RegexSet(const RegexOptions& options = RegexOptions()) : options(options) {}
+
+		/**
+		 * Copies a set, sharing its program but not its cache
+		 * @param other The set to copy
+		 */
+		RegexSet(const RegexSet& other) : program(other.program), starts(other.starts), options(other.options), message(other.message), messagePosition(other.messagePosition), prepared(other.prepared) {
+			if (prepared)
+				searcher.attach(*program, RegexSearch::unanchored, options.cacheBytes);
+		}
+
+		/**
+		 * Moves a set
+		 * @param other The set to move
+		 */
+		RegexSet(RegexSet&& other) noexcept = default;
+
+		/**
+		 * Copies a set, sharing its program but not its cache
+		 * @param other The set to copy
+		 * @returns This set
+		 */
+		RegexSet& operator=(const RegexSet& other) {
+			if (this == &other) return *this;
+			program = other.program;
+			starts = other.starts;
+			options = other.options;
+			message = other.message;
+			messagePosition = other.messagePosition;
+			prepared = other.prepared;
+			if (prepared)
+				searcher.attach(*program, RegexSearch::unanchored, options.cacheBytes);
+			return *this;
+		}
+
+		/**
+		 * Moves a set
+		 * @param other The set to move
+		 * @returns This set
+		 */
+		RegexSet& operator=(RegexSet&& other) noexcept = default;
+
+		/**
+		 * Compiles a pattern into the set, its id is the number of patterns before it
+		 * @param pattern The pattern
+		 * @returns Whether or not the pattern was valid (invalid patterns are not added, see error())
+		 */
+		bool add(StringView pattern) {
+			own();
+			size_t instructionCount = program->instructions.length();
+			RegexCompiler compiler(*program, pattern, false, options.caseInsensitive, false);
+			uint32_t start;
+			if (!compiler.compile(static_cast<uint32_t>(starts.length()), start)) {
+				program->instructions.resize(instructionCount);
+				message = compiler.error();
+				messagePosition = compiler.errorPosition();
+				return false;
+			}
+			starts.push(start);
+			message = nullptr;
+			prepared = false;
+			return true;
+		}
+
+		/**
+		 * Gets the number of patterns in the set
+		 * @returns The number of patterns
+		 */
+		size_t length() const {
+			return starts.length();
+		}
+
+		/**
+		 * Gets why the last pattern added did not compile
+		 * @returns The error message (nullptr if it was valid)
+		 */
+		const char* error() const {
+			return message;
+		}
+
+		/**
+		 * Gets where the last pattern added stopped compiling
+		 * @returns The position of the error in the pattern
+		 */
+		size_t errorPosition() const {
+			return messagePosition;
+		}
+
+		/**
+		 * Checks if any pattern matches anywhere in the text, stopping at the first match
+		 * @param text The text to search
+		 * @returns Whether or not any pattern matches
+		 */
+		bool matchesAny(StringView text) {
+			if (starts.length() == 0) return false;
+			prepare();
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+			uint32_t state = searcher.start(true);
+			if (state & 1) return true;
+			for (size_t i = 0; i < text.length(); i++) {
+				state = searcher.step(state, bytes[i]);
+				if (state & 1) return true;
+				if (state == 0) return false;
+			}
+			return searcher.acceptsAtEnd(state);
+		}
+
+		/**
+		 * Finds every pattern matching anywhere in the text in one pass
+		 * @param text The text to search
+		 * @returns The ids of the matching patterns in increasing order
+		 */
+		DataStructures::ArrayList<size_t> matches(StringView text) {
+			DataStructures::ArrayList<size_t> result;
+			if (starts.length() == 0) return result;
+			prepare();
+			seen.clear();
+			seen.resize(starts.length(), 0);
+			searcher.beginScan();
+			auto note = [&](uint32_t id) {
+				if (!seen[id]) {
+					seen[id] = 1;
+					result.push(id);
+				}
+			};
+
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+			uint32_t state = searcher.start(true);
+			if (state & 1)
+				searcher.collectMatches(state, false, note);
+			size_t position = 0;
+			for (; position < text.length() && state != 0 && result.length() != starts.length(); position++) {
+				state = searcher.step(state, bytes[position]);
+				if (state & 1)
+					searcher.collectMatches(state, false, note);
+			}
+			if (position == text.length() && state != 0)
+				searcher.collectMatches(state, true, note);
+			std::sort(result.begin(), result.end());
+			return result;
+		}
+	};
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
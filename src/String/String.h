@@ -0,0 +1,1363 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "../DataStructures/Allocator.h"
+#include "../DataStructures/ArrayList.h"
+#include "../DataStructures/Iterator.h"
+#include "../DataStructures/Memory.h"
+#include "../DataStructures/Search.h"
+#include <assert.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <utility>
+
+/**
+ * The namespace for strings in the essentials library
+ */
+namespace Essentials::Strings {
+
+	/**
+	 * A namespace alias to the strings namespace
+	 */
+	namespace str = Strings;
+
+	/**
+	 * The index returned by searches that find nothing
+	 */
+	inline constexpr size_t notFound = static_cast<size_t>(-1);
+
+#ifdef ESSENTIALS_SEARCH_SSE2
+	/**
+	 * Searches 16 candidate positions at a time for a pattern of at least 2 characters, comparing the first and last
+	 * characters of the pattern with vector compares and only checking the rest where both match
+	 * @param text The text to search
+	 * @param length The length of the text
+	 * @param pattern The pattern to search for
+	 * @param patternLength The length of the pattern (at least 2 and at most length)
+	 * @param position The first candidate position, set to the first candidate that was not checked
+	 * @returns The index of the first match (notFound if there is none before position)
+	 */
+	inline size_t findSubstringSse2(const char* text, size_t length, const char* pattern, size_t patternLength, size_t& position) {
+		size_t last = patternLength - 1;
+		__m128i first = _mm_set1_epi8(pattern[0]);
+		__m128i final = _mm_set1_epi8(pattern[last]);
+		size_t i = position;
+		for (; i + last + 16 <= length; i += 16) {
+			__m128i starts = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i)), first);
+			__m128i ends = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + last)), final);
+			uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(starts, ends)));
+			while (mask != 0) {
+				unsigned bit = DataStructures::searchLowestBit(mask);
+				if (std::memcmp(text + i + bit + 1, pattern + 1, last - 1) == 0) return i + bit;
+				mask &= mask - 1;
+			}
+		}
+		position = i;
+		return notFound;
+	}
+#endif
+
+#ifdef ESSENTIALS_SEARCH_AVX2
+	/**
+	 * Searches 32 candidate positions at a time for a pattern of at least 2 characters, comparing the first and last
+	 * characters of the pattern with vector compares and only checking the rest where both match
+	 * @param text The text to search
+	 * @param length The length of the text
+	 * @param pattern The pattern to search for
+	 * @param patternLength The length of the pattern (at least 2 and at most length)
+	 * @param position The first candidate position, set to the first candidate that was not checked
+	 * @returns The index of the first match (notFound if there is none before position)
+	 */
+	__attribute__((target("avx2"))) inline size_t findSubstringAvx2(const char* text, size_t length, const char* pattern, size_t patternLength, size_t& position) {
+		size_t last = patternLength - 1;
+		__m256i first = _mm256_set1_epi8(pattern[0]);
+		__m256i final = _mm256_set1_epi8(pattern[last]);
+		size_t i = position;
+		// Two blocks per step, only looking at the masks when either has a candidate
+		for (; i + last + 64 <= length; i += 64) {
+			__m256i low = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i)), first),
+				_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i + last)), final));
+			__m256i high = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i + 32)), first),
+				_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i + last + 32)), final));
+			if (_mm256_testz_si256(_mm256_or_si256(low, high), _mm256_or_si256(low, high))) continue;
+			uint64_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(low)) | static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(high))) << 32;
+			while (mask != 0) {
+				unsigned bit = static_cast<unsigned>(__builtin_ctzll(mask));
+				if (std::memcmp(text + i + bit + 1, pattern + 1, last - 1) == 0) return i + bit;
+				mask &= mask - 1;
+			}
+		}
+		for (; i + last + 32 <= length; i += 32) {
+			__m256i starts = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i)), first);
+			__m256i ends = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i + last)), final);
+			uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(starts, ends)));
+			while (mask != 0) {
+				unsigned bit = DataStructures::searchLowestBit(mask);
+				if (std::memcmp(text + i + bit + 1, pattern + 1, last - 1) == 0) return i + bit;
+				mask &= mask - 1;
+			}
+		}
+		position = i;
+		return notFound;
+	}
+#endif
+
+	/**
+	 * Finds the first occurrence of a pattern in a text (vectorized for texts longer than a block)
+	 * @param text The text to search
+	 * @param length The length of the text
+	 * @param pattern The pattern to search for
+	 * @param patternLength The length of the pattern
+	 * @returns The index of the first match (0 for an empty pattern, notFound if there is none)
+	 */
+	inline size_t findSubstring(const char* text, size_t length, const char* pattern, size_t patternLength) {
+		if (patternLength == 0) return 0;
+		if (patternLength > length) return notFound;
+		if (patternLength == 1) {
+			size_t index = DataStructures::findFirst(text, length, pattern[0]);
+			return index == length ? notFound : index;
+		}
+
+		size_t position = 0;
+		size_t index = notFound;
+#ifdef ESSENTIALS_SEARCH_AVX2
+		if (DataStructures::cpuSupportsAvx2())
+			index = findSubstringAvx2(text, length, pattern, patternLength, position);
+		else
+#endif
+#ifdef ESSENTIALS_SEARCH_SSE2
+		index = findSubstringSse2(text, length, pattern, patternLength, position);
+#endif
+		if (index != notFound) return index;
+
+		// The candidates left over from the blocks
+		size_t lastStart = length - patternLength;
+		while (position <= lastStart) {
+			const void* match = std::memchr(text + position, pattern[0], lastStart - position + 1);
+			if (match == nullptr) return notFound;
+			position = static_cast<size_t>(static_cast<const char*>(match) - text);
+			if (std::memcmp(text + position + 1, pattern + 1, patternLength - 1) == 0) return position;
+			position++;
+		}
+		return notFound;
+	}
+
+	/**
+	 * Finds the last occurrence of a pattern in a text (scans backwards for the first character with vector compares)
+	 * @param text The text to search
+	 * @param length The length of the text
+	 * @param pattern The pattern to search for
+	 * @param patternLength The length of the pattern
+	 * @returns The index of the last match (length for an empty pattern, notFound if there is none)
+	 */
+	inline size_t findLastSubstring(const char* text, size_t length, const char* pattern, size_t patternLength) {
+		if (patternLength == 0) return length;
+		if (patternLength > length) return notFound;
+		size_t end = length - patternLength + 1;
+		while (end > 0) {
+			size_t index = DataStructures::findLast(text, end, pattern[0]);
+			if (index == end) return notFound;
+			if (std::memcmp(text + index + 1, pattern + 1, patternLength - 1) == 0) return index;
+			end = index;
+		}
+		return notFound;
+	}
+
+	/**
+	 * Multiplies two numbers into 128 bits
+	 * @param a The first number
+	 * @param b The second number
+	 * @param low Where to store the low 64 bits of the product
+	 * @param high Where to store the high 64 bits of the product
+	 */
+	inline void multiplyWide(uint64_t a, uint64_t b, uint64_t& low, uint64_t& high) {
+#ifdef __SIZEOF_INT128__
+		unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+		low = static_cast<uint64_t>(product);
+		high = static_cast<uint64_t>(product >> 64);
+#else
+		uint64_t lowLow = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+		uint64_t lowHigh = (a & 0xFFFFFFFF) * (b >> 32);
+		uint64_t highLow = (a >> 32) * (b & 0xFFFFFFFF);
+		uint64_t middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFF) + (highLow & 0xFFFFFFFF);
+		low = (lowLow & 0xFFFFFFFF) | (middle << 32);
+		high = (a >> 32) * (b >> 32) + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+#endif
+	}
+
+	/**
+	 * Multiplies two numbers into 128 bits and folds the halves together
+	 * @param a The first number
+	 * @param b The second number
+	 * @returns The low 64 bits of the product xor the high 64 bits
+	 */
+	inline uint64_t foldMultiply(uint64_t a, uint64_t b) {
+		uint64_t low, high;
+		multiplyWide(a, b, low, high);
+		return low ^ high;
+	}
+
+	/**
+	 * Reads 8 bytes as a number
+	 * @param data The bytes
+	 * @returns The number
+	 */
+	inline uint64_t readWord(const char* data) {
+		uint64_t word;
+		std::memcpy(&word, data, 8);
+		return word;
+	}
+
+	/**
+	 * Reads 4 bytes as a number
+	 * @param data The bytes
+	 * @returns The number
+	 */
+	inline uint64_t readHalfWord(const char* data) {
+		uint32_t word;
+		std::memcpy(&word, data, 4);
+		return word;
+	}
+
+	/**
+	 * Hashes a run of bytes (wyhash, which folds 128 bit products of the input and only uses fixed size reads)
+	 * @param data The bytes to hash
+	 * @param length The number of bytes
+	 * @returns The hash
+	 */
+	inline size_t hashBytes(const char* data, size_t length) {
+		constexpr uint64_t secret[4] = { 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+		uint64_t seed = foldMultiply(secret[0], secret[1]);
+		uint64_t a, b;
+		if (length <= 16) {
+			if (length >= 4) {
+				// Overlapping reads from both ends cover every byte
+				size_t step = (length >> 3) << 2;
+				a = (readHalfWord(data) << 32) | readHalfWord(data + step);
+				b = (readHalfWord(data + length - 4) << 32) | readHalfWord(data + length - 4 - step);
+			}
+			else if (length > 0) {
+				a = (static_cast<uint64_t>(static_cast<unsigned char>(data[0])) << 16) | (static_cast<uint64_t>(static_cast<unsigned char>(data[length >> 1])) << 8) | static_cast<unsigned char>(data[length - 1]);
+				b = 0;
+			}
+			else {
+				a = b = 0;
+			}
+		}
+		else {
+			size_t remaining = length;
+			const char* cursor = data;
+			if (remaining > 48) {
+				// Three independent lanes so the multiplies overlap
+				uint64_t second = seed, third = seed;
+				do {
+					seed = foldMultiply(readWord(cursor) ^ secret[1], readWord(cursor + 8) ^ seed);
+					second = foldMultiply(readWord(cursor + 16) ^ secret[2], readWord(cursor + 24) ^ second);
+					third = foldMultiply(readWord(cursor + 32) ^ secret[3], readWord(cursor + 40) ^ third);
+					cursor += 48;
+					remaining -= 48;
+				} while (remaining > 48);
+				seed ^= second ^ third;
+			}
+			while (remaining > 16) {
+				seed = foldMultiply(readWord(cursor) ^ secret[1], readWord(cursor + 8) ^ seed);
+				cursor += 16;
+				remaining -= 16;
+			}
+			a = readWord(cursor + remaining - 16);
+			b = readWord(cursor + remaining - 8);
+		}
+		multiplyWide(a ^ secret[1], b ^ seed, a, b);
+		return static_cast<size_t>(foldMultiply(a ^ secret[0] ^ length, b ^ secret[1]));
+	}
+
+	/**
+	 * Checks if a character is whitespace (space, tab, newline, carriage return, form feed or vertical tab)
+	 * @param character The character to check
+	 * @returns Whether or not the character is whitespace
+	 */
+	constexpr bool isWhitespace(char character) {
+		return character == ' ' || (character >= '\t' && character <= '\r');
+	}
+
+	/**
+	 * A non owning view of a run of characters with an explicit length (not necessarily null terminated)
+	 */
+	class StringView {
+	private:
+		/**
+		 * The first character
+		 */
+		const char* characters = "";
+
+		/**
+		 * The number of characters
+		 */
+		size_t size = 0;
+
+	public:
+		/**
+		 * Creates an empty view
+		 */
+		constexpr StringView() = default;
+
+		/**
+		 * Creates a view of a null terminated string
+		 * @param cString The string to view (not including the null terminator)
+		 */
+		constexpr StringView(const char* cString) : characters(cString), size(std::char_traits<char>::length(cString)) {}
+
+		/**
+		 * Creates a view of a run of characters
+		 * @param data The first character
+		 * @param length The number of characters
+		 */
+		constexpr StringView(const char* data, size_t length) : characters(data), size(length) {}
+
+		/**
+		 * Gets the first character
+		 * @returns The characters of the view (not necessarily null terminated)
+		 */
+		constexpr const char* data() const {
+			return characters;
+		}
+
+		/**
+		 * Gets the number of characters
+		 * @returns The length of the view
+		 */
+		constexpr size_t length() const {
+			return size;
+		}
+
+		/**
+		 * Checks if the view has no characters
+		 * @returns Whether or not the view is empty
+		 */
+		constexpr bool empty() const {
+			return size == 0;
+		}
+
+		/**
+		 * Gets a character
+		 * @param index The index of the character
+		 * @returns The character
+		 */
+		constexpr char operator[](size_t index) const {
+			assert(index < size);
+			return characters[index];
+		}
+
+		/**
+		 * Gets an iterator at the first character
+		 * @returns The iterator
+		 */
+		DataStructures::Iterator<const char> begin() const {
+			return DataStructures::Iterator<const char>(characters);
+		}
+
+		/**
+		 * Gets an iterator past the last character
+		 * @returns The iterator
+		 */
+		DataStructures::Iterator<const char> end() const {
+			return DataStructures::Iterator<const char>(characters + size);
+		}
+
+		/**
+		 * Gets a view of part of this view
+		 * @param start The index of the first character (clamped to the length)
+		 * @param count The maximum number of characters (defaults to the rest of the view)
+		 * @returns The view of the characters
+		 */
+		constexpr StringView substring(size_t start, size_t count = notFound) const {
+			if (start > size) start = size;
+			if (count > size - start) count = size - start;
+			return StringView(characters + start, count);
+		}
+
+		/**
+		 * Gets this view without leading and trailing whitespace
+		 * @returns The trimmed view
+		 */
+		constexpr StringView trim() const {
+			size_t first = 0;
+			size_t last = size;
+			while (first < last && isWhitespace(characters[first])) first++;
+			while (last > first && isWhitespace(characters[last - 1])) last--;
+			return StringView(characters + first, last - first);
+		}
+
+		/**
+		 * Finds the first occurrence of a character
+		 * @param character The character to search for
+		 * @param from The index to start searching at
+		 * @returns The index of the character (notFound if there is none)
+		 */
+		size_t indexOf(char character, size_t from = 0) const {
+			if (from >= size) return notFound;
+			size_t index = DataStructures::findFirst(characters + from, size - from, character);
+			return index == size - from ? notFound : from + index;
+		}
+
+		/**
+		 * Finds the first occurrence of a string
+		 * @param pattern The string to search for
+		 * @param from The index to start searching at
+		 * @returns The index of the string (notFound if there is none)
+		 */
+		size_t indexOf(StringView pattern, size_t from = 0) const {
+			if (from > size) return notFound;
+			size_t index = findSubstring(characters + from, size - from, pattern.characters, pattern.size);
+			return index == notFound ? notFound : from + index;
+		}
+
+		/**
+		 * Finds the last occurrence of a character
+		 * @param character The character to search for
+		 * @returns The index of the character (notFound if there is none)
+		 */
+		size_t lastIndexOf(char character) const {
+			size_t index = DataStructures::findLast(characters, size, character);
+			return index == size ? notFound : index;
+		}
+
+		/**
+		 * Finds the last occurrence of a string
+		 * @param pattern The string to search for
+		 * @returns The index of the string (notFound if there is none)
+		 */
+		size_t lastIndexOf(StringView pattern) const {
+			return findLastSubstring(characters, size, pattern.characters, pattern.size);
+		}
+
+		/**
+		 * Checks if the view contains a character
+		 * @param character The character to search for
+		 * @returns Whether or not the character was found
+		 */
+		bool contains(char character) const {
+			return indexOf(character) != notFound;
+		}
+
+		/**
+		 * Checks if the view contains a string
+		 * @param pattern The string to search for
+		 * @returns Whether or not the string was found
+		 */
+		bool contains(StringView pattern) const {
+			return indexOf(pattern) != notFound;
+		}
+
+		/**
+		 * Counts the non overlapping occurrences of a string
+		 * @param pattern The string to count (not empty)
+		 * @returns The number of occurrences
+		 */
+		size_t count(StringView pattern) const {
+			assert(!pattern.empty());
+			size_t total = 0;
+			for (size_t index = indexOf(pattern); index != notFound; index = indexOf(pattern, index + pattern.size))
+				total++;
+			return total;
+		}
+
+		/**
+		 * Checks if the view begins with a string
+		 * @param prefix The string to check for
+		 * @returns Whether or not the view starts with the prefix
+		 */
+		bool startsWith(StringView prefix) const {
+			return prefix.size <= size && std::memcmp(characters, prefix.characters, prefix.size) == 0;
+		}
+
+		/**
+		 * Checks if the view ends with a string
+		 * @param suffix The string to check for
+		 * @returns Whether or not the view ends with the suffix
+		 */
+		bool endsWith(StringView suffix) const {
+			return suffix.size <= size && std::memcmp(characters + size - suffix.size, suffix.characters, suffix.size) == 0;
+		}
+
+		/**
+		 * Splits the view around every occurrence of a separator, adding the pieces to a list (reusing one list avoids an
+		 * allocation per call)
+		 * @param separator The separator (not empty)
+		 * @param pieces The list to add the pieces to (n separators give n + 1 pieces, which may be empty)
+		 */
+		template<typename A, size_t I>
+		void split(StringView separator, DataStructures::ArrayList<StringView, A, I>& pieces) const {
+			assert(!separator.empty());
+			size_t start = 0;
+			while (true) {
+				size_t index = separator.size == 1 ? indexOf(separator.characters[0], start) : indexOf(separator, start);
+				if (index == notFound) break;
+				pieces.push(StringView(characters + start, index - start));
+				start = index + separator.size;
+			}
+			pieces.push(StringView(characters + start, size - start));
+		}
+
+		/**
+		 * Splits the view around every occurrence of a separator
+		 * @param separator The separator (not empty)
+		 * @returns The pieces (n separators give n + 1 pieces, which may be empty)
+		 */
+		DataStructures::ArrayList<StringView> split(StringView separator) const {
+			DataStructures::ArrayList<StringView> pieces;
+			split(separator, pieces);
+			return pieces;
+		}
+
+		/**
+		 * Compares the view with another view byte by byte
+		 * @param other The view to compare with
+		 * @returns A negative number, zero or a positive number if this view orders before, equal to or after the other
+		 */
+		int compare(StringView other) const {
+			size_t common = size < other.size ? size : other.size;
+			int result = common == 0 ? 0 : std::memcmp(characters, other.characters, common);
+			if (result != 0) return result;
+			return size < other.size ? -1 : size > other.size ? 1 : 0;
+		}
+
+		/**
+		 * Hashes the characters of the view
+		 * @returns The hash
+		 */
+		size_t hash() const {
+			return hashBytes(characters, size);
+		}
+	};
+
+	/**
+	 * Checks if two strings have the same characters
+	 * @param left The first string
+	 * @param right The second string
+	 * @returns Whether or not they are equal
+	 */
+	inline bool operator==(StringView left, StringView right) {
+		return left.length() == right.length() && std::memcmp(left.data(), right.data(), left.length()) == 0;
+	}
+
+	/**
+	 * Checks if two strings have different characters
+	 * @param left The first string
+	 * @param right The second string
+	 * @returns Whether or not they are not equal
+	 */
+	inline bool operator!=(StringView left, StringView right) {
+		return !(left == right);
+	}
+
+	/**
+	 * Checks if a string orders before another
+	 * @param left The first string
+	 * @param right The second string
+	 * @returns Whether or not left orders before right
+	 */
+	inline bool operator<(StringView left, StringView right) {
+		return left.compare(right) < 0;
+	}
+
+	/**
+	 * Checks if a string orders after another
+	 * @param left The first string
+	 * @param right The second string
+	 * @returns Whether or not left orders after right
+	 */
+	inline bool operator>(StringView left, StringView right) {
+		return left.compare(right) > 0;
+	}
+
+	/**
+	 * Checks if a string orders before or equal to another
+	 * @param left The first string
+	 * @param right The second string
+	 * @returns Whether or not left orders before or equal to right
+	 */
+	inline bool operator<=(StringView left, StringView right) {
+		return left.compare(right) <= 0;
+	}
+
+	/**
+	 * Checks if a string orders after or equal to another
+	 * @param left The first string
+	 * @param right The second string
+	 * @returns Whether or not left orders after or equal to right
+	 */
+	inline bool operator>=(StringView left, StringView right) {
+		return left.compare(right) >= 0;
+	}
+
+	/**
+	 * An owning string with an explicit length, short strings are stored inside the object without allocating
+	 * The characters are always followed by a null terminator so the string can be passed to C functions
+	 */
+	template<typename Allocator = DataStructures::HeapAllocator> class BasicString : private Allocator {
+	private:
+		/**
+		 * The size of the storage, large enough for a pointer, a length and a capacity
+		 */
+		static constexpr size_t storageSize = sizeof(char*) + 2 * sizeof(size_t);
+
+		/**
+		 * The value of the last storage byte when the characters are on the heap
+		 */
+		static constexpr unsigned char heapTag = 0xFF;
+
+	public:
+		/**
+		 * The number of characters that are stored without allocating (the last storage byte doubles as the null
+		 * terminator when it is full)
+		 */
+		static constexpr size_t inlineCapacity = storageSize - 1;
+
+		/**
+		 * The largest capacity of heap storage (the last byte of the capacity field holds the tag)
+		 */
+		static constexpr size_t maxCapacity = (static_cast<size_t>(1) << (8 * (sizeof(size_t) - 1))) - 1;
+
+	private:
+		/**
+		 * Inline characters, or a pointer, length and capacity on the heap
+		 * Inline, the last byte holds inlineCapacity - length, on the heap it holds heapTag
+		 */
+		alignas(char*) char storage[storageSize] = {};
+
+		/**
+		 * Returns the allocator the storage is requested from
+		 * @returns The allocator of the string
+		 */
+		Allocator& allocator() {
+			return *this;
+		}
+
+		/**
+		 * Checks if the characters are stored inside the object
+		 * @returns Whether or not the string has no heap storage
+		 */
+		inline bool isInline() const {
+			return static_cast<unsigned char>(storage[storageSize - 1]) != heapTag;
+		}
+
+		/**
+		 * Gets the heap storage (only valid when not inline)
+		 * @returns The heap characters
+		 */
+		inline char* heapData() const {
+			char* pointer;
+			std::memcpy(&pointer, storage, sizeof(char*));
+			return pointer;
+		}
+
+		/**
+		 * Gets the capacity of the heap storage (only valid when not inline)
+		 * @returns The number of characters the heap storage fits, not counting the null terminator
+		 */
+		inline size_t heapCapacity() const {
+			size_t capacity = 0;
+			for (size_t i = 0; i < sizeof(size_t) - 1; i++)
+				capacity |= static_cast<size_t>(static_cast<unsigned char>(storage[sizeof(char*) + sizeof(size_t) + i])) << (8 * i);
+			return capacity;
+		}
+
+		/**
+		 * Points the string at heap storage
+		 * @param pointer The heap characters
+		 * @param length The number of characters in use
+		 * @param capacity The number of characters the storage fits, not counting the null terminator
+		 */
+		void setHeap(char* pointer, size_t length, size_t capacity) {
+			std::memcpy(storage, &pointer, sizeof(char*));
+			std::memcpy(storage + sizeof(char*), &length, sizeof(size_t));
+			for (size_t i = 0; i < sizeof(size_t) - 1; i++)
+				storage[sizeof(char*) + sizeof(size_t) + i] = static_cast<char>(capacity >> (8 * i));
+			storage[storageSize - 1] = static_cast<char>(heapTag);
+			pointer[length] = '\0';
+		}
+
+		/**
+		 * Sets the number of characters in use and writes the null terminator
+		 * @param length The new length (at most the capacity)
+		 */
+		inline void setLength(size_t length) {
+			if (isInline()) {
+				storage[length] = '\0';
+				storage[storageSize - 1] = static_cast<char>(inlineCapacity - length);
+			}
+			else {
+				std::memcpy(storage + sizeof(char*), &length, sizeof(size_t));
+				heapData()[length] = '\0';
+			}
+		}
+
+		/**
+		 * Makes the string empty and inline without freeing anything
+		 */
+		inline void reset() {
+			storage[0] = '\0';
+			storage[storageSize - 1] = static_cast<char>(inlineCapacity);
+		}
+
+		/**
+		 * Frees the heap storage (if any)
+		 */
+		void freeStorage() {
+			if (!isInline())
+				allocator().deallocate(heapData(), heapCapacity() + 1, 1);
+		}
+
+		/**
+		 * Moves the characters to storage of a new capacity (inline if it fits)
+		 * @param newCapacity The new capacity (at least the length)
+		 */
+		void realloc(size_t newCapacity) {
+			size_t size = length();
+			assert(newCapacity >= size);
+			if (newCapacity <= inlineCapacity) {
+				if (!isInline()) {
+					char* pointer = heapData();
+					size_t capacity = heapCapacity();
+					std::memcpy(storage, pointer, size);
+					storage[storageSize - 1] = 0;
+					setLength(size);
+					allocator().deallocate(pointer, capacity + 1, 1);
+				}
+				return;
+			}
+
+			assert(newCapacity <= maxCapacity);
+			char* block;
+			if (isInline()) {
+				block = static_cast<char*>(allocator().allocate(newCapacity + 1, 1));
+				std::memcpy(block, storage, size);
+			}
+			else {
+				block = static_cast<char*>(allocator().reallocate(heapData(), heapCapacity() + 1, newCapacity + 1, 1));
+			}
+			setHeap(block, size, newCapacity);
+		}
+
+		/**
+		 * Grows the capacity geometrically so that at least minCapacity characters fit
+		 * @param minCapacity The minimum capacity required
+		 */
+		void grow(size_t minCapacity) {
+			size_t current = capacity();
+			size_t newCapacity = current + current / 2;
+			if (newCapacity < minCapacity)
+				newCapacity = minCapacity;
+			if (newCapacity > maxCapacity)
+				newCapacity = maxCapacity;
+			realloc(newCapacity);
+		}
+
+	public:
+		/**
+		 * Creates an empty string
+		 * @param allocator The allocator heap storage is requested from
+		 */
+		BasicString(const Allocator& allocator = Allocator()) : Allocator(allocator) {
+			reset();
+		}
+
+		/**
+		 * Creates a string from a null terminated string
+		 * @param cString The characters to copy
+		 * @param allocator The allocator heap storage is requested from
+		 */
+		BasicString(const char* cString, const Allocator& allocator = Allocator()) : BasicString(StringView(cString), allocator) {}
+
+		/**
+		 * Creates a string from a run of characters
+		 * @param data The characters to copy
+		 * @param length The number of characters
+		 * @param allocator The allocator heap storage is requested from
+		 */
+		BasicString(const char* data, size_t length, const Allocator& allocator = Allocator()) : BasicString(StringView(data, length), allocator) {}
+
+		/**
+		 * Creates a string from a view
+		 * @param view The characters to copy
+		 * @param allocator The allocator heap storage is requested from
+		 */
+		explicit BasicString(StringView view, const Allocator& allocator = Allocator()) : Allocator(allocator) {
+			reset();
+			append(view);
+		}
+
+		/**
+		 * Creates a string with a capacity of exactly the length of another string and copies it
+		 * @param other The string to copy
+		 */
+		BasicString(const BasicString& other) : Allocator(other) {
+			reset();
+			append(other.view());
+		}
+
+		/**
+		 * Takes the storage of another string, leaving it empty
+		 * @param other The string to move from
+		 */
+		BasicString(BasicString&& other) noexcept : Allocator(other) {
+			std::memcpy(storage, other.storage, storageSize);
+			other.reset();
+		}
+
+		/**
+		 * Replaces the characters of this string with a copy of another string
+		 * @param other The string to copy
+		 * @returns This string
+		 */
+		BasicString& operator=(const BasicString& other) {
+			if (this != &other)
+				assign(other.view());
+			return *this;
+		}
+
+		/**
+		 * Replaces the characters of this string with the storage (and allocator) of another string
+		 * @param other The string to move from
+		 * @returns This string
+		 */
+		BasicString& operator=(BasicString&& other) noexcept {
+			if (this != &other) {
+				freeStorage();
+				allocator() = static_cast<Allocator&>(other);
+				std::memcpy(storage, other.storage, storageSize);
+				other.reset();
+			}
+			return *this;
+		}
+
+		/**
+		 * Replaces the characters of this string with a copy of a view
+		 * @param view The characters to copy (may be part of this string)
+		 * @returns This string
+		 */
+		BasicString& operator=(StringView view) {
+			assign(view);
+			return *this;
+		}
+
+		/**
+		 * Replaces the characters of this string with a copy of a null terminated string
+		 * @param cString The characters to copy (may be part of this string)
+		 * @returns This string
+		 */
+		BasicString& operator=(const char* cString) {
+			assign(StringView(cString));
+			return *this;
+		}
+
+		/**
+		 * Frees resources
+		 */
+		~BasicString() {
+			freeStorage();
+		}
+
+		/**
+		 * Gets the number of characters
+		 * @returns The length of the string
+		 */
+		inline size_t length() const {
+			if (isInline())
+				return inlineCapacity - static_cast<unsigned char>(storage[storageSize - 1]);
+			size_t size;
+			std::memcpy(&size, storage + sizeof(char*), sizeof(size_t));
+			return size;
+		}
+
+		/**
+		 * Gets the number of characters that fit without allocating
+		 * @returns The capacity of the string (not counting the null terminator)
+		 */
+		inline size_t capacity() const {
+			return isInline() ? inlineCapacity : heapCapacity();
+		}
+
+		/**
+		 * Checks if the string has no characters
+		 * @returns Whether or not the string is empty
+		 */
+		inline bool empty() const {
+			return length() == 0;
+		}
+
+		/**
+		 * Gets the characters
+		 * @returns The characters, followed by a null terminator
+		 */
+		inline char* data() {
+			return isInline() ? storage : heapData();
+		}
+
+		/**
+		 * Gets the characters
+		 * @returns The characters, followed by a null terminator
+		 */
+		inline const char* data() const {
+			return isInline() ? storage : heapData();
+		}
+
+		/**
+		 * Gets the characters as a null terminated string
+		 * @returns The characters, followed by a null terminator
+		 */
+		inline const char* cString() const {
+			return data();
+		}
+
+		/**
+		 * Gets a view of the characters (invalidated when the string is modified or destroyed)
+		 * @returns The view
+		 */
+		inline StringView view() const {
+			return StringView(data(), length());
+		}
+
+		/**
+		 * Converts the string to a view of its characters
+		 * @returns The view
+		 */
+		inline operator StringView() const {
+			return view();
+		}
+
+		/**
+		 * Gets a character
+		 * @param index The index of the character
+		 * @returns The character
+		 */
+		char& operator[](size_t index) {
+			assert(index < length());
+			return data()[index];
+		}
+
+		/**
+		 * Gets a character
+		 * @param index The index of the character
+		 * @returns The character
+		 */
+		char operator[](size_t index) const {
+			assert(index < length());
+			return data()[index];
+		}
+
+		/**
+		 * Gets an iterator at the first character
+		 * @returns The iterator
+		 */
+		DataStructures::Iterator<char> begin() {
+			return DataStructures::Iterator<char>(data());
+		}
+
+		/**
+		 * Gets an iterator past the last character
+		 * @returns The iterator
+		 */
+		DataStructures::Iterator<char> end() {
+			return DataStructures::Iterator<char>(data() + length());
+		}
+
+		/**
+		 * Gets an iterator at the first character
+		 * @returns The iterator
+		 */
+		DataStructures::Iterator<const char> begin() const {
+			return DataStructures::Iterator<const char>(data());
+		}
+
+		/**
+		 * Gets an iterator past the last character
+		 * @returns The iterator
+		 */
+		DataStructures::Iterator<const char> end() const {
+			return DataStructures::Iterator<const char>(data() + length());
+		}
+
+		/**
+		 * Makes sure a number of characters fit without allocating
+		 * @param num The number of characters
+		 */
+		void reserve(size_t num) {
+			if (num > capacity())
+				realloc(num);
+		}
+
+		/**
+		 * Shrinks the storage to the length (moving the characters inline if they fit)
+		 */
+		void shrinkToFit() {
+			if (!isInline() && heapCapacity() > length())
+				realloc(length());
+		}
+
+		/**
+		 * Changes the length, filling new characters with a character
+		 * @param num The new length
+		 * @param fill The character new positions are set to
+		 */
+		void resize(size_t num, char fill = '\0') {
+			size_t size = length();
+			if (num > size) {
+				reserve(num);
+				std::memset(data() + size, fill, num - size);
+			}
+			setLength(num);
+		}
+
+		/**
+		 * Removes every character (keeps the storage)
+		 */
+		void clear() {
+			setLength(0);
+		}
+
+		/**
+		 * Replaces the characters of this string with a copy of a view
+		 * @param view The characters to copy (may be part of this string)
+		 */
+		void assign(StringView view) {
+			const char* current = data();
+			if (view.data() >= current && view.data() <= current + length()) {
+				// The view is already in the storage, so move it to the front
+				std::memmove(data(), view.data(), view.length());
+				setLength(view.length());
+				return;
+			}
+			clear();
+			append(view);
+		}
+
+		/**
+		 * Adds characters to the end of the string
+		 * @param view The characters to add (may be part of this string)
+		 */
+		void append(StringView view) {
+			size_t size = length();
+			size_t count = view.length();
+			if (count == 0) return;
+			const char* source = view.data();
+			if (size + count > capacity()) {
+				// Compare addresses as integers, since the view may point into another object
+				uintptr_t address = reinterpret_cast<uintptr_t>(source);
+				uintptr_t current = reinterpret_cast<uintptr_t>(data());
+				bool inside = address >= current && address <= current + size;
+				grow(size + count);
+				if (inside) source = data() + (address - current);
+			}
+			std::memmove(data() + size, source, count);
+			setLength(size + count);
+		}
+
+		/**
+		 * Adds a character to the end of the string
+		 * @param character The character to add
+		 */
+		void append(char character) {
+			size_t size = length();
+			if (size == capacity())
+				grow(size + 1);
+			data()[size] = character;
+			setLength(size + 1);
+		}
+
+		/**
+		 * Adds characters to the end of the string
+		 * @param view The characters to add (may be part of this string)
+		 * @returns This string
+		 */
+		BasicString& operator+=(StringView view) {
+			append(view);
+			return *this;
+		}
+
+		/**
+		 * Adds a character to the end of the string
+		 * @param character The character to add
+		 * @returns This string
+		 */
+		BasicString& operator+=(char character) {
+			append(character);
+			return *this;
+		}
+
+		/**
+		 * Inserts characters at an index
+		 * @param index The index to insert at (at most the length)
+		 * @param view The characters to insert (may be part of this string)
+		 */
+		void insert(size_t index, StringView view) {
+			size_t size = length();
+			assert(index <= size);
+			const char* current = data();
+			if (view.data() >= current && view.data() <= current + size) {
+				// Copy the characters out first since moving the tail would overwrite them
+				BasicString copy(view, static_cast<const Allocator&>(*this));
+				insert(index, copy.view());
+				return;
+			}
+			size_t count = view.length();
+			if (count == 0) return;
+			if (size + count > capacity())
+				grow(size + count);
+			char* characters = data();
+			std::memmove(characters + index + count, characters + index, size - index);
+			std::memcpy(characters + index, view.data(), count);
+			setLength(size + count);
+		}
+
+		/**
+		 * Removes characters
+		 * @param index The index of the first character to remove
+		 * @param count The maximum number of characters to remove (defaults to the rest of the string)
+		 */
+		void erase(size_t index, size_t count = notFound) {
+			size_t size = length();
+			assert(index <= size);
+			if (count > size - index) count = size - index;
+			char* characters = data();
+			std::memmove(characters + index, characters + index + count, size - index - count);
+			setLength(size - count);
+		}
+
+		/**
+		 * Replaces every non overlapping occurrence of a string
+		 * @param target The string to replace (not empty)
+		 * @param replacement The string to replace it with (either may be part of this string)
+		 * @returns The number of replacements
+		 */
+		size_t replace(StringView target, StringView replacement) {
+			assert(!target.empty());
+			StringView text = view();
+			size_t index = text.indexOf(target);
+			if (index == notFound) return 0;
+
+			// Overwriting in place would change the target or replacement if either is part of this string
+			const char* current = text.data();
+			auto aliases = [&](StringView part) { return part.data() >= current && part.data() <= current + text.length(); };
+			if (target.length() == replacement.length() && !aliases(target) && !aliases(replacement)) {
+				// Same length, so overwrite the matches in place
+				size_t total = 0;
+				for (; index != notFound; index = text.indexOf(target, index + target.length())) {
+					std::memcpy(data() + index, replacement.data(), replacement.length());
+					total++;
+				}
+				return total;
+			}
+
+			// Build the result in new storage, the old characters stay valid until it is moved in
+			BasicString result(static_cast<const Allocator&>(*this));
+			result.reserve(text.length());
+			size_t total = 0;
+			size_t start = 0;
+			for (; index != notFound; index = text.indexOf(target, start)) {
+				result.append(StringView(current + start, index - start));
+				result.append(replacement);
+				start = index + target.length();
+				total++;
+			}
+			result.append(StringView(current + start, text.length() - start));
+			*this = std::move(result);
+			return total;
+		}
+
+		/**
+		 * Gets a view of part of the string
+		 * @param start The index of the first character (clamped to the length)
+		 * @param count The maximum number of characters (defaults to the rest of the string)
+		 * @returns The view of the characters
+		 */
+		StringView substring(size_t start, size_t count = notFound) const {
+			return view().substring(start, count);
+		}
+
+		/**
+		 * Finds the first occurrence of a character
+		 * @param character The character to search for
+		 * @param from The index to start searching at
+		 * @returns The index of the character (notFound if there is none)
+		 */
+		size_t indexOf(char character, size_t from = 0) const {
+			return view().indexOf(character, from);
+		}
+
+		/**
+		 * Finds the first occurrence of a string
+		 * @param pattern The string to search for
+		 * @param from The index to start searching at
+		 * @returns The index of the string (notFound if there is none)
+		 */
+		size_t indexOf(StringView pattern, size_t from = 0) const {
+			return view().indexOf(pattern, from);
+		}
+
+		/**
+		 * Finds the last occurrence of a character
+		 * @param character The character to search for
+		 * @returns The index of the character (notFound if there is none)
+		 */
+		size_t lastIndexOf(char character) const {
+			return view().lastIndexOf(character);
+		}
+
+		/**
+		 * Finds the last occurrence of a string
+		 * @param pattern The string to search for
+		 * @returns The index of the string (notFound if there is none)
+		 */
+		size_t lastIndexOf(StringView pattern) const {
+			return view().lastIndexOf(pattern);
+		}
+
+		/**
+		 * Checks if the string contains a character
+		 * @param character The character to search for
+		 * @returns Whether or not the character was found
+		 */
+		bool contains(char character) const {
+			return view().contains(character);
+		}
+
+		/**
+		 * Checks if the string contains another string
+		 * @param pattern The string to search for
+		 * @returns Whether or not the string was found
+		 */
+		bool contains(StringView pattern) const {
+			return view().contains(pattern);
+		}
+
+		/**
+		 * Checks if the string begins with another string
+		 * @param prefix The string to check for
+		 * @returns Whether or not the string starts with the prefix
+		 */
+		bool startsWith(StringView prefix) const {
+			return view().startsWith(prefix);
+		}
+
+		/**
+		 * Checks if the string ends with another string
+		 * @param suffix The string to check for
+		 * @returns Whether or not the string ends with the suffix
+		 */
+		bool endsWith(StringView suffix) const {
+			return view().endsWith(suffix);
+		}
+
+		/**
+		 * Splits the string around every occurrence of a separator
+		 * @param separator The separator (not empty)
+		 * @returns Views of the pieces (invalidated when the string is modified or destroyed)
+		 */
+		DataStructures::ArrayList<StringView> split(StringView separator) const {
+			return view().split(separator);
+		}
+
+		/**
+		 * Hashes the characters of the string
+		 * @returns The hash (the same as the hash of a view of the characters)
+		 */
+		size_t hash() const {
+			return view().hash();
+		}
+	};
+
+	/**
+	 * A string allocated from the heap
+	 */
+	using String = BasicString<>;
+
+	/**
+	 * Concatenates two strings
+	 * @param left The first string
+	 * @param right The string to add after it
+	 * @returns The new string (using the allocator of left)
+	 */
+	template<typename A>
+	BasicString<A> operator+(const BasicString<A>& left, StringView right) {
+		BasicString<A> result(left);
+		result.reserve(left.length() + right.length());
+		result.append(right);
+		return result;
+	}
+
+	/**
+	 * Concatenates two strings
+	 * @param left The first string (moved into the result)
+	 * @param right The string to add after it
+	 * @returns The new string
+	 */
+	template<typename A>
+	BasicString<A> operator+(BasicString<A>&& left, StringView right) {
+		left.append(right);
+		return std::move(left);
+	}
+}
+
+/**
+ * The main namespace for data structures in the essentials library
+ */
+namespace Essentials::DataStructures {
+
+	/**
+	 * Strings only hold a pointer to their storage (or the characters themselves), so they can be moved with a memcpy
+	 */
+	template<typename A> struct IsTriviallyRelocatable<Strings::BasicString<A>> : IsTriviallyRelocatable<A> {};
+}
+
+/**
+ * Hashes views with the strings hash so they can be used as HashMap keys
+ */
+template<> struct std::hash<Essentials::Strings::StringView> {
+	/**
+	 * Hashes a view
+	 * @param view The view to hash
+	 * @returns The hash
+	 */
+	size_t operator()(Essentials::Strings::StringView view) const {
+		return view.hash();
+	}
+};
+
+/**
+ * Hashes strings with the strings hash so they can be used as HashMap keys
+ */
+template<typename A> struct std::hash<Essentials::Strings::BasicString<A>> {
+	/**
+	 * Hashes a string
+	 * @param string The string to hash
+	 * @returns The hash
+	 */
+	size_t operator()(const Essentials::Strings::BasicString<A>& string) const {
+		return string.hash();
+	}
+};
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
@@ -0,0 +1,338 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "ThreadPool.h"
+#include "../DataStructures/ArrayList.h"
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+/**
+ * The namespace for concurrency support in the essentials library
+ */
+namespace Essentials::Threading {
+
+	/**
+	 * A namespace alias to the threading namespace
+	 */
+	namespace th = Threading;
+
+	/**
+	 * Gets the number of elements each task should process for a range
+	 * @param count The number of elements in the range
+	 * @param pool The pool the range will be processed on
+	 * @param grain The requested number of elements per task (0 picks one automatically)
+	 * @returns The number of elements per task (at least 1)
+	 */
+	inline size_t chunkSize(size_t count, const ThreadPool& pool, size_t grain) {
+		if (grain > 0) return grain;
+		// A few chunks per thread (counting the caller) so stealing can even out uneven chunks
+		size_t chunks = (pool.threadCount() + 1) * 4;
+		size_t size = (count + chunks - 1) / chunks;
+		return size < 1024 ? 1024 : size;
+	}
+
+	/**
+	 * Runs a function over consecutive chunks of an index range in parallel, the caller helps run the chunks
+	 * @param begin The first index of the range
+	 * @param end One past the last index of the range
+	 * @param body The function to run, called as body(chunkBegin, chunkEnd)
+	 * @param grain The number of indices per chunk (0 picks one automatically)
+	 * @param pool The pool to run on
+	 */
+	template<typename F>
+	void parallelFor(size_t begin, size_t end, F&& body, size_t grain = 0, ThreadPool& pool = ThreadPool::global()) {
+		if (begin >= end) return;
+		size_t chunk = chunkSize(end - begin, pool, grain);
+		if (end - begin <= chunk) {
+			body(begin, end);
+			return;
+		}
+
+		TaskGroup group;
+		for (size_t start = begin + chunk; start < end; start += chunk) {
+			size_t stop = end - start < chunk ? end : start + chunk;
+			pool.submit(group, [&body, start, stop] { body(start, stop); });
+		}
+		body(begin, begin + chunk);
+		pool.wait(group);
+	}
+
+	/**
+	 * Calls a function on every element of a list in parallel (in no particular order)
+	 * @param list The list (any type with length() and operator[], ie ArrayList or Array)
+	 * @param function The function to call with each element
+	 * @param pool The pool to run on
+	 */
+	template<typename L, typename F>
+	void parallelForEach(L& list, F&& function, ThreadPool& pool = ThreadPool::global()) {
+		parallelFor(0, list.length(), [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+				function(list[i]);
+		}, 0, pool);
+	}
+
+	/**
+	 * Creates a new list from the results of calling a function on every element of a list in parallel
+	 * @param list The list (any type with length() and operator[], ie ArrayList or Array)
+	 * @param function The function to call with each element
+	 * @param pool The pool to run on
+	 * @returns A list of the results, in the same order as the elements
+	 */
+	template<typename L, typename F>
+	auto parallelMap(const L& list, F&& function, ThreadPool& pool = ThreadPool::global()) {
+		using R = std::decay_t<decltype(function(list[0]))>;
+		size_t count = list.length();
+		DataStructures::ArrayList<R> result(count);
+		parallelFor(0, count, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+				new(&result.data()[i]) R(function(list[i]));
+		}, 0, pool);
+		result.resizeUninitialized(count);
+		return result;
+	}
+
+	/**
+	 * Combines every element of a list in parallel
+	 * @param list The list (any type with length() and operator[], ie ArrayList or Array)
+	 * @param init The identity of the operation (ie 0 for addition), used as the start of every chunk
+	 * @param operation The operation to combine with (must be associative)
+	 * @param pool The pool to run on
+	 * @returns The combination of all of the elements
+	 */
+	template<typename L, typename R, typename Op = std::plus<>>
+	R parallelReduce(const L& list, R init, Op operation = Op(), ThreadPool& pool = ThreadPool::global()) {
+		size_t count = list.length();
+		size_t chunk = chunkSize(count, pool, 0);
+		size_t chunks = (count + chunk - 1) / chunk;
+		DataStructures::ArrayList<R> partials(chunks);
+		for (size_t i = 0; i < chunks; i++)
+			partials.push(init);
+
+		parallelFor(0, count, [&](size_t begin, size_t end) {
+			R value = init;
+			for (size_t i = begin; i < end; i++)
+				value = operation(std::move(value), list[i]);
+			partials[begin / chunk] = std::move(value);
+		}, chunk, pool);
+
+		R result = init;
+		for (size_t i = 0; i < chunks; i++)
+			result = operation(std::move(result), std::move(partials[i]));
+		return result;
+	}
+
+	/**
+	 * Finds the first element of a list which satisfies a predicate, searching chunks in parallel
+	 * @param list The list (any type with length() and operator[], ie ArrayList or Array)
+	 * @param predicate The predicate to check each element with
+	 * @param pool The pool to run on
+	 * @returns The index of the first matching element (-1 if not found)
+	 */
+	template<typename L, typename P>
+	int parallelFind(const L& list, P&& predicate, ThreadPool& pool = ThreadPool::global()) {
+		size_t count = list.length();
+		std::atomic<size_t> best{count};
+		// Smaller chunks than usual so chunks past an early match are skipped quickly
+		size_t chunk = chunkSize(count, pool, 0) / 4 + 1;
+
+		parallelFor(0, count, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				if (((i - begin) & 1023) == 0 && best.load(std::memory_order_relaxed) < i)
+					return;
+				if (predicate(list[i])) {
+					size_t current = best.load(std::memory_order_relaxed);
+					while (i < current && !best.compare_exchange_weak(current, i, std::memory_order_relaxed)) {}
+					return;
+				}
+			}
+		}, chunk, pool);
+
+		size_t index = best.load();
+		return index == count ? -1 : static_cast<int>(index);
+	}
+
+	/**
+	 * Finds the last element of a list which satisfies a predicate, searching chunks in parallel
+	 * @param list The list (any type with length() and operator[], ie ArrayList or Array)
+	 * @param predicate The predicate to check each element with
+	 * @param pool The pool to run on
+	 * @returns The index of the last matching element (-1 if not found)
+	 */
+	template<typename L, typename P>
+	int parallelFindLast(const L& list, P&& predicate, ThreadPool& pool = ThreadPool::global()) {
+		size_t count = list.length();
+		// Stores index + 1 so 0 can mean not found
+		std::atomic<size_t> best{0};
+		size_t chunk = chunkSize(count, pool, 0) / 4 + 1;
+
+		parallelFor(0, count, [&](size_t begin, size_t end) {
+			for (size_t i = end; i > begin; i--) {
+				if (((end - i) & 1023) == 0 && best.load(std::memory_order_relaxed) > i)
+					return;
+				if (predicate(list[i - 1])) {
+					size_t current = best.load(std::memory_order_relaxed);
+					while (i > current && !best.compare_exchange_weak(current, i, std::memory_order_relaxed)) {}
+					return;
+				}
+			}
+		}, chunk, pool);
+
+		size_t index = best.load();
+		return index == 0 ? -1 : static_cast<int>(index - 1);
+	}
+
+	/**
+	 * Gets the index of the first match of an element, searching chunks in parallel (Uses == to check)
+	 * @param list The list (any type with length() and operator[], ie ArrayList or Array)
+	 * @param item The element to search for
+	 * @param pool The pool to run on
+	 * @returns The index of the element (-1 if not found)
+	 */
+	template<typename L, typename T>
+	int parallelIndexOf(const L& list, const T& item, ThreadPool& pool = ThreadPool::global()) {
+		return parallelFind(list, [&](const auto& element) { return item == element; }, pool);
+	}
+
+	/**
+	 * Gets the index of the last match of an element, searching chunks in parallel (Uses == to check)
+	 * @param list The list (any type with length() and operator[], ie ArrayList or Array)
+	 * @param item The element to search for
+	 * @param pool The pool to run on
+	 * @returns The index of the element (-1 if not found)
+	 */
+	template<typename L, typename T>
+	int parallelLastIndexOf(const L& list, const T& item, ThreadPool& pool = ThreadPool::global()) {
+		return parallelFindLast(list, [&](const auto& element) { return item == element; }, pool);
+	}
+
+	/**
+	 * Checks if an element is in a list, searching chunks in parallel (Uses == to check)
+	 * @param list The list (any type with length() and operator[], ie ArrayList or Array)
+	 * @param item The element to search for
+	 * @param pool The pool to run on
+	 * @returns Whether or not the list contains the element
+	 */
+	template<typename L, typename T>
+	bool parallelContains(const L& list, const T& item, ThreadPool& pool = ThreadPool::global()) {
+		return parallelIndexOf(list, item, pool) != -1;
+	}
+
+	/**
+	 * Merges two sorted ranges into uninitialized memory, splitting large merges into parallel tasks
+	 * @param first The first sorted range
+	 * @param firstCount The length of the first range
+	 * @param second The second sorted range
+	 * @param secondCount The length of the second range
+	 * @param out Where to move the merged elements to (constructed elements, assigned to)
+	 * @param compare The ordering of the elements
+	 * @param group The group to add tasks to
+	 * @param pool The pool to run on
+	 */
+	template<typename T, typename C>
+	void parallelMerge(T* first, size_t firstCount, T* second, size_t secondCount, T* out, C& compare, TaskGroup& group, ThreadPool& pool) {
+		while (firstCount + secondCount > 32768) {
+			// Split at the median of the larger range, the halves can then be merged independently
+			if (firstCount < secondCount) {
+				std::swap(first, second);
+				std::swap(firstCount, secondCount);
+			}
+			size_t firstSplit = firstCount / 2;
+			size_t secondSplit = std::lower_bound(second, second + secondCount, first[firstSplit], compare) - second;
+
+			T* upperFirst = first + firstSplit;
+			T* upperSecond = second + secondSplit;
+			size_t upperFirstCount = firstCount - firstSplit;
+			size_t upperSecondCount = secondCount - secondSplit;
+			T* upperOut = out + firstSplit + secondSplit;
+			pool.submit(group, [=, &compare, &group, &pool] {
+				parallelMerge(upperFirst, upperFirstCount, upperSecond, upperSecondCount, upperOut, compare, group, pool);
+			});
+			firstCount = firstSplit;
+			secondCount = secondSplit;
+		}
+		std::merge(std::make_move_iterator(first), std::make_move_iterator(first + firstCount),
+			std::make_move_iterator(second), std::make_move_iterator(second + secondCount), out, compare);
+	}
+
+	/**
+	 * Sorts a contiguous list in parallel (sorts chunks, then merges them pairwise)
+	 * @param list The list (ArrayList or Array)
+	 * @param compare The ordering of the elements
+	 * @param pool The pool to run on
+	 */
+	template<typename L, typename C = std::less<>>
+	void parallelSort(L& list, C compare = C(), ThreadPool& pool = ThreadPool::global()) {
+		using T = std::remove_reference_t<decltype(list[0])>;
+		size_t count = list.length();
+		if (count < 2) return;
+		T* data = &list[0];
+
+		size_t runs = 1;
+		while (runs < (pool.threadCount() + 1) * 2 && count / (runs * 2) >= 4096)
+			runs *= 2;
+		if (runs == 1) {
+			std::sort(data, data + count, compare);
+			return;
+		}
+
+		size_t run = (count + runs - 1) / runs;
+		parallelFor(0, runs, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				size_t start = i * run;
+				if (start < count)
+					std::sort(data + start, data + (count - start < run ? count : start + run), compare);
+			}
+		}, 1, pool);
+
+		DataStructures::ArrayList<T> buffer(count);
+		buffer.resizeUninitialized(count);
+		T* scratch = buffer.data();
+		parallelFor(0, count, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+				new(&scratch[i]) T(std::move(data[i]));
+		}, 0, pool);
+
+		// The sorted runs are merged back and forth between the buffer and the list until one run is left
+		T* source = scratch;
+		T* dest = data;
+		for (; run < count; run *= 2) {
+			TaskGroup group;
+			for (size_t start = 0; start < count; start += run * 2) {
+				size_t middle = count - start < run ? count : start + run;
+				size_t end = count - start < run * 2 ? count : start + run * 2;
+				pool.submit(group, [=, &compare, &group, &pool] {
+					parallelMerge(source + start, middle - start, source + middle, end - middle, dest + start, compare, group, pool);
+				});
+			}
+			pool.wait(group);
+			std::swap(source, dest);
+		}
+
+		if (source != data) {
+			parallelFor(0, count, [&](size_t begin, size_t end) {
+				std::move(source + begin, source + end, data + begin);
+			}, 0, pool);
+		}
+	}
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
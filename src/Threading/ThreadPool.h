@@ -0,0 +1,566 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "../DataStructures/ArrayList.h"
+#include "../DataStructures/ArrayQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+/**
+ * The namespace for concurrency support in the essentials library
+ */
+namespace Essentials::Threading {
+
+	/**
+	 * A namespace alias to the threading namespace
+	 */
+	namespace th = Threading;
+
+	class TaskGroup;
+
+	/**
+	 * A unit of work which can be run by a ThreadPool
+	 */
+	class Task {
+	public:
+		/**
+		 * Destroys the task
+		 */
+		virtual ~Task() = default;
+
+		/**
+		 * Runs the task (must not throw)
+		 */
+		virtual void run() = 0;
+
+		/**
+		 * The group waiting on this task (may be nullptr)
+		 */
+		TaskGroup* group = nullptr;
+	};
+
+	/**
+	 * A task which runs a function object
+	 */
+	template<typename F> class FunctionTask final : public Task {
+	private:
+		/**
+		 * The function to run
+		 */
+		F function;
+
+	public:
+		/**
+		 * Creates a task which runs a function
+		 * @param function The function to run
+		 */
+		FunctionTask(F&& function) : function(std::move(function)) {}
+
+		/**
+		 * Creates a task which runs a function
+		 * @param function The function to run
+		 */
+		FunctionTask(const F& function) : function(function) {}
+
+		/**
+		 * Runs the function
+		 */
+		void run() override {
+			function();
+		}
+	};
+
+	/**
+	 * A counter of unfinished tasks which a thread can wait on (see ThreadPool::wait)
+	 */
+	class TaskGroup {
+	private:
+		friend class ThreadPool;
+
+		/**
+		 * The number of tasks submitted to the group which haven't finished
+		 */
+		std::atomic<size_t> pending{0};
+
+	public:
+		/**
+		 * Checks if every task submitted to the group has finished
+		 * @returns Whether or not the group is done
+		 */
+		bool done() const {
+			return pending.load(std::memory_order_acquire) == 0;
+		}
+	};
+
+	/**
+	 * A Chase-Lev work stealing deque
+	 * The owning thread pushes and pops at the bottom without contention, any other thread may steal from the top
+	 */
+	template<typename T> class WorkStealingDeque {
+	private:
+		/**
+		 * A circular array of items
+		 */
+		struct Ring {
+			/**
+			 * The number of slots (a power of two)
+			 */
+			int64_t capacity;
+
+			/**
+			 * The slots of the ring
+			 */
+			std::atomic<T*>* items;
+
+			/**
+			 * Creates a new empty ring
+			 * @param capacity The number of slots (a power of two)
+			 */
+			Ring(int64_t capacity) : capacity(capacity), items(new std::atomic<T*>[capacity]) {}
+
+			/**
+			 * Frees the slots
+			 */
+			~Ring() {
+				delete[] items;
+			}
+
+			/**
+			 * Gets the item at a position
+			 * @param index The position of the item
+			 * @returns The item
+			 */
+			T* get(int64_t index) const {
+				return items[index & (capacity - 1)].load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * Sets the item at a position
+			 * @param index The position of the item
+			 * @param item The item
+			 */
+			void put(int64_t index, T* item) {
+				items[index & (capacity - 1)].store(item, std::memory_order_relaxed);
+			}
+		};
+
+		/**
+		 * The position thieves steal from
+		 */
+		alignas(DataStructures::cacheLineSize) std::atomic<int64_t> top{0};
+
+		/**
+		 * The position the owner pushes to
+		 */
+		alignas(DataStructures::cacheLineSize) std::atomic<int64_t> bottom{0};
+
+		/**
+		 * The current ring
+		 */
+		std::atomic<Ring*> ring;
+
+		/**
+		 * Rings which were replaced by a larger one, kept alive until the deque is destroyed since thieves may still read them
+		 */
+		DataStructures::ArrayList<Ring*> retired;
+
+	public:
+		/**
+		 * Creates a new empty deque
+		 * @param capacity The initial number of slots (a power of two)
+		 */
+		WorkStealingDeque(int64_t capacity = 256) : ring(new Ring(capacity)) {}
+
+		WorkStealingDeque(const WorkStealingDeque&) = delete;
+		WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+		/**
+		 * Frees resources
+		 */
+		~WorkStealingDeque() {
+			delete ring.load(std::memory_order_relaxed);
+			for (size_t i = 0; i < retired.length(); i++)
+				delete retired[i];
+		}
+
+		/**
+		 * Adds an item to the bottom of the deque (owner only)
+		 * @param item The item to add
+		 */
+		void push(T* item) {
+			int64_t b = bottom.load(std::memory_order_relaxed);
+			int64_t t = top.load(std::memory_order_acquire);
+			Ring* current = ring.load(std::memory_order_relaxed);
+			if (b - t > current->capacity - 1) {
+				Ring* bigger = new Ring(current->capacity * 2);
+				for (int64_t i = t; i < b; i++)
+					bigger->put(i, current->get(i));
+				retired.push(current);
+				ring.store(bigger, std::memory_order_release);
+				current = bigger;
+			}
+			current->put(b, item);
+			bottom.store(b + 1, std::memory_order_release);
+		}
+
+		/**
+		 * Removes the item at the bottom of the deque (owner only)
+		 * @returns The item (nullptr if the deque is empty)
+		 */
+		T* pop() {
+			int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+			Ring* current = ring.load(std::memory_order_relaxed);
+			// Sequentially consistent so a thief either sees the lowered bottom or the owner sees the thief's top
+			bottom.store(b, std::memory_order_seq_cst);
+			int64_t t = top.load(std::memory_order_seq_cst);
+
+			if (t > b) {
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T* item = current->get(b);
+			if (t == b) {
+				// Last item, race any thief for it
+				if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					item = nullptr;
+				bottom.store(b + 1, std::memory_order_relaxed);
+			}
+			return item;
+		}
+
+		/**
+		 * Removes the item at the top of the deque (any thread)
+		 * @returns The item (nullptr if the deque is empty or another thread won the race for it)
+		 */
+		T* steal() {
+			int64_t t = top.load(std::memory_order_seq_cst);
+			int64_t b = bottom.load(std::memory_order_seq_cst);
+			if (t >= b)
+				return nullptr;
+
+			T* item = ring.load(std::memory_order_acquire)->get(t);
+			if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+			return item;
+		}
+
+		/**
+		 * Checks if the deque looks empty (only a hint while other threads are using it)
+		 * @returns Whether or not the deque is empty
+		 */
+		bool empty() const {
+			return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+		}
+	};
+
+	/**
+	 * A pool of worker threads which share work by stealing
+	 *
+	 * Every worker owns a WorkStealingDeque, tasks submitted from a worker go to its own deque and idle workers steal
+	 * from the others. Tasks submitted from outside the pool go through a shared queue. Threads waiting on a TaskGroup
+	 * run tasks while they wait, so nested parallelism doesn't deadlock.
+	 */
+	class ThreadPool {
+	private:
+		/**
+		 * A worker thread and its deque
+		 */
+		struct Worker {
+			/**
+			 * The worker's tasks
+			 */
+			WorkStealingDeque<Task> deque;
+
+			/**
+			 * The worker's thread
+			 */
+			std::thread thread;
+		};
+
+		/**
+		 * The workers of the pool
+		 */
+		DataStructures::ArrayList<Worker*> workers;
+
+		/**
+		 * Tasks submitted from threads outside the pool
+		 */
+		DataStructures::ArrayQueue<Task*> injected;
+
+		/**
+		 * Guards the injected queue and sleeping
+		 */
+		std::mutex mutex;
+
+		/**
+		 * Signalled when work arrives or the pool stops
+		 */
+		std::condition_variable wake;
+
+		/**
+		 * The number of tasks which have been submitted but not taken by a thread
+		 */
+		std::atomic<size_t> queued{0};
+
+		/**
+		 * The number of workers sleeping (or about to)
+		 */
+		std::atomic<size_t> sleepers{0};
+
+		/**
+		 * Whether or not the pool is shutting down
+		 */
+		std::atomic<bool> stopping{false};
+
+		/**
+		 * Gets the worker of the current thread
+		 * @returns The worker (nullptr if the current thread isn't a worker of this pool)
+		 */
+		Worker* currentWorker() const {
+			return currentPool() == this ? currentWorkerSlot() : nullptr;
+		}
+
+		/**
+		 * Gets the pool the current thread works for
+		 * @returns A reference to the thread local pool pointer
+		 */
+		static const ThreadPool*& currentPool() {
+			thread_local const ThreadPool* pool = nullptr;
+			return pool;
+		}
+
+		/**
+		 * Gets the worker the current thread is
+		 * @returns A reference to the thread local worker pointer
+		 */
+		static Worker*& currentWorkerSlot() {
+			thread_local Worker* worker = nullptr;
+			return worker;
+		}
+
+		/**
+		 * Takes a task from the shared queue
+		 * @returns The task (nullptr if there is none)
+		 */
+		Task* takeInjected() {
+			if (queued.load(std::memory_order_relaxed) == 0) return nullptr;
+			std::lock_guard<std::mutex> lock(mutex);
+			if (injected.length() == 0) return nullptr;
+			return injected.dequeue();
+		}
+
+		/**
+		 * Finds a task to run, from the thread's own deque, the shared queue, or by stealing
+		 * @param self The worker of the current thread (may be nullptr)
+		 * @param seed The state of the thread's victim selection
+		 * @returns The task (nullptr if none was found)
+		 */
+		Task* findTask(Worker* self, uint32_t& seed) {
+			Task* task = nullptr;
+			if (self != nullptr)
+				task = self->deque.pop();
+			if (task == nullptr)
+				task = takeInjected();
+			if (task == nullptr && workers.length() > 0) {
+				seed ^= seed << 13;
+				seed ^= seed >> 17;
+				seed ^= seed << 5;
+				size_t start = seed % workers.length();
+				for (size_t i = 0; i < workers.length() && task == nullptr; i++) {
+					Worker* victim = workers[(start + i) % workers.length()];
+					if (victim != self)
+						task = victim->deque.steal();
+				}
+			}
+			if (task != nullptr)
+				queued.fetch_sub(1, std::memory_order_relaxed);
+			return task;
+		}
+
+		/**
+		 * Runs a task and marks it finished in its group
+		 * @param task The task to run
+		 */
+		static void execute(Task* task) {
+			TaskGroup* group = task->group;
+			task->run();
+			delete task;
+			if (group != nullptr)
+				group->pending.fetch_sub(1, std::memory_order_release);
+		}
+
+		/**
+		 * The main loop of a worker thread
+		 * @param self The worker
+		 * @param index The index of the worker
+		 */
+		void workerLoop(Worker* self, size_t index) {
+			currentPool() = this;
+			currentWorkerSlot() = self;
+			uint32_t seed = static_cast<uint32_t>(index * 2654435761u + 1);
+
+			while (true) {
+				Task* task = findTask(self, seed);
+				if (task != nullptr) {
+					execute(task);
+					continue;
+				}
+
+				for (int spin = 0; spin < 64 && task == nullptr; spin++) {
+					std::this_thread::yield();
+					task = findTask(self, seed);
+				}
+				if (task != nullptr) {
+					execute(task);
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(mutex);
+				sleepers.fetch_add(1, std::memory_order_seq_cst);
+				wake.wait(lock, [&] {
+					return queued.load(std::memory_order_seq_cst) > 0 || stopping.load(std::memory_order_relaxed);
+				});
+				sleepers.fetch_sub(1, std::memory_order_relaxed);
+				if (stopping.load(std::memory_order_relaxed) && queued.load(std::memory_order_relaxed) == 0)
+					return;
+			}
+		}
+
+		/**
+		 * Hands a task to the pool
+		 * @param task The task to run
+		 */
+		void enqueue(Task* task) {
+			if (task->group != nullptr)
+				task->group->pending.fetch_add(1, std::memory_order_relaxed);
+
+			Worker* self = currentWorker();
+			queued.fetch_add(1, std::memory_order_seq_cst);
+			if (self != nullptr) {
+				self->deque.push(task);
+			}
+			else {
+				std::lock_guard<std::mutex> lock(mutex);
+				injected.push(task);
+			}
+
+			if (sleepers.load(std::memory_order_seq_cst) > 0) {
+				{ std::lock_guard<std::mutex> lock(mutex); }
+				wake.notify_one();
+			}
+		}
+
+	public:
+		/**
+		 * Creates a new pool and starts its workers
+		 * @param threads The number of worker threads (defaults to one per hardware thread)
+		 */
+		ThreadPool(size_t threads = std::thread::hardware_concurrency()) {
+			if (threads == 0)
+				threads = 1;
+			workers.prepare(threads);
+			for (size_t i = 0; i < threads; i++)
+				workers.push(new Worker());
+			for (size_t i = 0; i < threads; i++)
+				workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, workers[i], i);
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/**
+		 * Finishes every queued task and stops the workers
+		 */
+		~ThreadPool() {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stopping.store(true);
+			}
+			wake.notify_all();
+			// Other workers may still be stealing from a deque until every thread has stopped
+			for (size_t i = 0; i < workers.length(); i++)
+				workers[i]->thread.join();
+			for (size_t i = 0; i < workers.length(); i++)
+				delete workers[i];
+		}
+
+		/**
+		 * Gets the shared pool used by the parallel algorithms by default
+		 * @returns The global pool
+		 */
+		static ThreadPool& global() {
+			static ThreadPool pool;
+			return pool;
+		}
+
+		/**
+		 * Returns the number of worker threads
+		 * @returns The number of workers
+		 */
+		inline size_t threadCount() const {
+			return workers.length();
+		}
+
+		/**
+		 * Runs a function on the pool without waiting for it
+		 * @param function The function to run (must not throw)
+		 */
+		template<typename F>
+		void submit(F&& function) {
+			enqueue(new FunctionTask<std::decay_t<F>>(std::forward<F>(function)));
+		}
+
+		/**
+		 * Runs a function on the pool as part of a group
+		 * @param group The group to add the task to
+		 * @param function The function to run (must not throw)
+		 */
+		template<typename F>
+		void submit(TaskGroup& group, F&& function) {
+			Task* task = new FunctionTask<std::decay_t<F>>(std::forward<F>(function));
+			task->group = &group;
+			enqueue(task);
+		}
+
+		/**
+		 * Waits for every task of a group to finish, running queued tasks in the meantime
+		 * @param group The group to wait on
+		 */
+		void wait(TaskGroup& group) {
+			Worker* self = currentWorker();
+			uint32_t seed = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&group)) | 1u;
+			while (!group.done()) {
+				Task* task = findTask(self, seed);
+				if (task != nullptr)
+					execute(task);
+				else
+					std::this_thread::yield();
+			}
+		}
+	};
+}
+
+/**
+ * A namespace alias to the Essentials namespace
+ */
+namespace es = Essentials;
\ No newline at end of file
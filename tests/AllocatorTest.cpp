@@ -0,0 +1,220 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "DataStructures/Allocator.h"
+#include "DataStructures/ArrayList.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * Checks if memory is aligned
+	 * @param block The memory
+	 * @param alignment The alignment
+	 * @returns Whether or not the address is a multiple of the alignment
+	 */
+	bool aligned(const void* block, size_t alignment) {
+		return reinterpret_cast<uintptr_t>(block) % alignment == 0;
+	}
+
+	/**
+	 * The heap allocator honours large alignments and keeps the contents when it resizes
+	 */
+	void heapAllocator() {
+		DataStructures::HeapAllocator heap;
+		for (size_t alignment : {size_t(1), size_t(8), size_t(16), size_t(64), size_t(4096)}) {
+			char* block = static_cast<char*>(heap.allocate(100, alignment));
+			ESSENTIALS_CHECK(aligned(block, alignment));
+			std::memset(block, 7, 100);
+			block = static_cast<char*>(heap.reallocate(block, 100, 10000, alignment));
+			ESSENTIALS_CHECK(aligned(block, alignment));
+			ESSENTIALS_CHECK(block[0] == 7 && block[99] == 7);
+			heap.deallocate(block, 10000, alignment);
+		}
+	}
+
+	/**
+	 * Arena allocations are aligned, only the last one is freed or grown in place, and reset reuses the newest block
+	 */
+	void arena() {
+		DataStructures::Arena arena(1024);
+		ESSENTIALS_CHECK(arena.bytesUsed() == 0);
+		char* first = static_cast<char*>(arena.allocate(3, 1));
+		for (size_t alignment : {size_t(2), size_t(8), size_t(16), size_t(64)})
+			ESSENTIALS_CHECK(aligned(arena.allocate(5, alignment), alignment));
+		ESSENTIALS_CHECK(arena.bytesUsed() == 3 + 4 * 5);
+
+		// Only the most recent allocation is reclaimed
+		void* last = arena.allocate(40, 8);
+		arena.deallocate(first, 3);
+		ESSENTIALS_CHECK(arena.bytesUsed() == 3 + 4 * 5 + 40);
+		arena.deallocate(last, 40);
+		ESSENTIALS_CHECK(arena.bytesUsed() == 3 + 4 * 5);
+		ESSENTIALS_CHECK(arena.allocate(40, 8) == last);
+
+		// The last allocation grows in place while it fits in its block, and moves with its contents once it does not
+		char* growing = static_cast<char*>(arena.allocate(16, 8));
+		std::memcpy(growing, "0123456789abcdef", 16);
+		ESSENTIALS_CHECK(arena.reallocate(growing, 16, 64, 8) == growing);
+		ESSENTIALS_CHECK(arena.bytesUsed() == 3 + 4 * 5 + 40 + 64);
+		char* moved = static_cast<char*>(arena.reallocate(growing, 64, 4096, 8));
+		ESSENTIALS_CHECK(moved != growing);
+		ESSENTIALS_CHECK(std::memcmp(moved, "0123456789abcdef", 16) == 0);
+
+		// Allocations larger than a block get a block of their own
+		char* large = static_cast<char*>(arena.allocate(1 << 16, 64));
+		ESSENTIALS_CHECK(aligned(large, 64));
+		std::memset(large, 1, 1 << 16);
+
+		arena.reset();
+		ESSENTIALS_CHECK(arena.bytesUsed() == 0);
+		ESSENTIALS_CHECK(aligned(arena.allocate(8, 8), 8));
+		ESSENTIALS_CHECK(arena.bytesUsed() == 8);
+
+		DataStructures::Arena fresh(1024);
+		void* start = fresh.allocate(100, 8);
+		fresh.allocate(100, 8);
+		fresh.reset();
+		ESSENTIALS_CHECK(fresh.allocate(100, 8) == start);
+	}
+
+	/**
+	 * Pool blocks are distinct, aligned and reused last in first out, across several chunks
+	 */
+	void pool() {
+		DataStructures::Pool tiny(1);
+		ESSENTIALS_CHECK(tiny.size() >= sizeof(void*));
+
+		DataStructures::Pool pool(24, 4, 32);
+		ESSENTIALS_CHECK(pool.size() == 32);
+		ESSENTIALS_CHECK(pool.alignment() == 32);
+		DataStructures::ArrayList<char*> blocks;
+		for (size_t i = 0; i < 10; i++) {
+			char* block = static_cast<char*>(pool.allocate());
+			ESSENTIALS_CHECK(aligned(block, 32));
+			std::memset(block, static_cast<int>(i), 24);
+			blocks.push(block);
+		}
+		bool distinct = true;
+		for (size_t i = 0; i < blocks.length(); i++) {
+			distinct = distinct && blocks[i][0] == static_cast<char>(i) && blocks[i][23] == static_cast<char>(i);
+			for (size_t j = i + 1; j < blocks.length(); j++)
+				distinct = distinct && (blocks[i] + 32 <= blocks[j] || blocks[j] + 32 <= blocks[i]);
+		}
+		ESSENTIALS_CHECK(distinct);
+		pool.deallocate(blocks[3]);
+		pool.deallocate(blocks[7]);
+		ESSENTIALS_CHECK(pool.allocate() == blocks[7]);
+		ESSENTIALS_CHECK(pool.allocate() == blocks[3]);
+		pool.reset();
+		ESSENTIALS_CHECK(aligned(pool.allocate(), 32));
+	}
+
+	/**
+	 * Containers allocate from an arena through ArenaAllocator
+	 */
+	void arenaAllocator() {
+		DataStructures::Arena arena;
+		{
+			DataStructures::ArrayList<std::string, DataStructures::ArenaAllocator> list{DataStructures::ArenaAllocator(arena)};
+			for (size_t i = 0; i < 1000; i++)
+				list.push(std::to_string(i));
+			bool matching = true;
+			for (size_t i = 0; i < 1000; i++)
+				matching = matching && list[i] == std::to_string(i);
+			ESSENTIALS_CHECK(matching);
+			ESSENTIALS_CHECK(arena.bytesUsed() >= 1000 * sizeof(std::string));
+		}
+		arena.reset();
+		ESSENTIALS_CHECK(arena.bytesUsed() == 0);
+	}
+
+	/**
+	 * PoolAllocator serves what fits in a block from the pool, resizes within a block in place, and sends the rest to the heap
+	 */
+	void poolAllocator() {
+		DataStructures::Pool pool(64, 8, 16);
+		DataStructures::PoolAllocator allocator(pool);
+		char* small = static_cast<char*>(allocator.allocate(16, 8));
+		std::memcpy(small, "pooled", 7);
+		ESSENTIALS_CHECK(allocator.reallocate(small, 16, 64, 8) == small);
+		char* grown = static_cast<char*>(allocator.reallocate(small, 64, 1000, 8));
+		ESSENTIALS_CHECK(std::strcmp(grown, "pooled") == 0);
+		// The block went back to the pool when the allocation moved to the heap
+		ESSENTIALS_CHECK(pool.allocate() == small);
+		char* shrunk = static_cast<char*>(allocator.reallocate(grown, 1000, 32, 8));
+		ESSENTIALS_CHECK(std::strcmp(shrunk, "pooled") == 0);
+		allocator.deallocate(shrunk, 32, 8);
+		ESSENTIALS_CHECK(pool.allocate() == shrunk);
+
+		// Alignments stricter than the pool's go to the heap
+		void* strict = allocator.allocate(16, 64);
+		ESSENTIALS_CHECK(aligned(strict, 64));
+		allocator.deallocate(strict, 16, 64);
+	}
+
+	/**
+	 * CountingAllocator records every call, the bytes in use and the peak
+	 */
+	void countingAllocator() {
+		DataStructures::AllocationCounts counts;
+		DataStructures::CountingAllocator<> allocator(counts);
+		void* a = allocator.allocate(100, 8);
+		void* b = allocator.allocate(50, 8);
+		ESSENTIALS_CHECK(counts.allocations == 2 && counts.bytes == 150 && counts.peakBytes == 150);
+		allocator.deallocate(a, 100, 8);
+		ESSENTIALS_CHECK(counts.deallocations == 1 && counts.bytes == 50 && counts.peakBytes == 150);
+		b = allocator.reallocate(b, 50, 400, 8);
+		ESSENTIALS_CHECK(counts.reallocations == 1 && counts.bytes == 400 && counts.peakBytes == 400);
+		b = allocator.reallocate(b, 400, 10, 8);
+		ESSENTIALS_CHECK(counts.bytes == 10 && counts.peakBytes == 400);
+		allocator.deallocate(b, 10, 8);
+		ESSENTIALS_CHECK(counts.bytes == 0);
+
+		// A container gives back everything it took
+		DataStructures::AllocationCounts listCounts;
+		{
+			DataStructures::ArrayList<int, DataStructures::CountingAllocator<>> list{DataStructures::CountingAllocator<>(listCounts)};
+			for (int i = 0; i < 10000; i++)
+				list.push(i);
+			ESSENTIALS_CHECK(listCounts.bytes >= 10000 * sizeof(int));
+			ESSENTIALS_CHECK(listCounts.peakBytes == listCounts.bytes);
+		}
+		ESSENTIALS_CHECK(listCounts.bytes == 0);
+		ESSENTIALS_CHECK(listCounts.allocations == listCounts.deallocations);
+
+		// Counting wraps any allocator
+		DataStructures::Arena arena;
+		DataStructures::AllocationCounts arenaCounts;
+		DataStructures::CountingAllocator<DataStructures::ArenaAllocator> counted(arenaCounts, DataStructures::ArenaAllocator(arena));
+		counted.allocate(32, 8);
+		ESSENTIALS_CHECK(arenaCounts.allocations == 1 && arena.bytesUsed() == 32);
+	}
+}
+
+int main() {
+	heapAllocator();
+	arena();
+	pool();
+	arenaAllocator();
+	poolAllocator();
+	countingAllocator();
+	return Tests::result();
+}
\ No newline at end of file
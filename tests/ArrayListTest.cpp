@@ -0,0 +1,231 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "DataStructures/ArrayList.h"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * The number of Element values alive
+	 */
+	int live = 0;
+
+	/**
+	 * The number of copies left before copying an Element throws (negative to never throw)
+	 */
+	int copiesBeforeThrow = -1;
+
+	/**
+	 * A value which knows its own address (so a bytewise relocation is caught), counts its instances and can throw
+	 * when copied
+	 */
+	struct Element {
+		/**
+		 * The address the value was constructed at
+		 */
+		const Element* self;
+
+		/**
+		 * The value held
+		 */
+		int value;
+
+		/**
+		 * Makes a value
+		 * @param value The value to hold
+		 */
+		Element(int value = -1) : self(this), value(value) { live++; }
+
+		Element(const Element& other) : self(this), value(other.value) {
+			if (copiesBeforeThrow == 0) throw std::runtime_error("copy");
+			if (copiesBeforeThrow > 0) copiesBeforeThrow--;
+			live++;
+		}
+
+		Element(Element&& other) noexcept : self(this), value(other.value) { live++; }
+
+		Element& operator=(const Element& other) {
+			value = other.value;
+			return *this;
+		}
+
+		Element& operator=(Element&& other) noexcept {
+			value = other.value;
+			return *this;
+		}
+
+		~Element() { live--; }
+	};
+
+	/**
+	 * An Element which the lists relocate bytewise (so its self pointer is not checked)
+	 */
+	struct Relocatable : Element {
+		using Element::Element;
+	};
+}
+
+/**
+ * Relocatable values are moved around the list with memcpy
+ */
+template<> struct Essentials::DataStructures::IsTriviallyRelocatable<Relocatable> : std::true_type {};
+
+namespace {
+
+	/**
+	 * Checks that a list holds the values of a reference in order, and that every element is at the address it was
+	 * constructed at unless it is relocated bytewise
+	 * @param list The list
+	 * @param expected The values
+	 * @returns Whether or not they match
+	 */
+	template<typename L> bool sameElements(const L& list, const std::vector<int>& expected) {
+		if (list.length() != expected.size() || list.capacity() < list.length()) return false;
+		bool relocatedBytewise = DataStructures::isTriviallyRelocatable<std::decay_t<decltype(list[0])>>;
+		for (size_t i = 0; i < expected.size(); i++) {
+			if (list[i].value != expected[i] || (!relocatedBytewise && list[i].self != &list[i])) return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Random range inserts, appends, predicate removals, resizes and shrinks checked against std::vector
+	 * @param inlineCapacity The number of elements the list stores inline, which it never shrinks below
+	 * @param seed The seed of the random operations
+	 */
+	template<typename L, typename E = Element> void againstVector(size_t inlineCapacity, unsigned seed) {
+		std::mt19937 random(seed);
+		{
+			L list;
+			std::vector<int> expected;
+			bool matching = true;
+			for (int step = 0; step < 4000; step++) {
+				int value = static_cast<int>(random() % 1000);
+				switch (random() % 7) {
+					case 0:
+					case 1: {
+						std::vector<E> items(random() % 20);
+						for (size_t i = 0; i < items.size(); i++)
+							items[i].value = value + static_cast<int>(i);
+						size_t index = random() % (expected.size() + 1);
+						list.insertRange(index, items.begin(), items.end());
+						for (size_t i = 0; i < items.size(); i++)
+							expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(index + i), items[i].value);
+						break;
+					}
+					case 2: {
+						std::vector<E> items(random() % 10, E(value));
+						list.append(items.data(), items.size());
+						expected.insert(expected.end(), items.size(), value);
+						break;
+					}
+					case 3: {
+						int divisor = static_cast<int>(random() % 5) + 2;
+						size_t removed = list.removeIf([&](const E& item) { return item.value % divisor == 0; });
+						size_t before = expected.size();
+						std::vector<int> kept;
+						for (int item : expected) {
+							if (item % divisor != 0) kept.push_back(item);
+						}
+						expected = kept;
+						matching = matching && removed == before - expected.size();
+						break;
+					}
+					case 4: {
+						size_t length = random() % 300;
+						list.resize(length);
+						expected.resize(length, -1);
+						break;
+					}
+					case 5: {
+						size_t length = random() % 300;
+						list.resize(length, E(value));
+						expected.resize(length, value);
+						break;
+					}
+					default:
+						list.shrinkToFit();
+						matching = matching && list.capacity() == std::max(list.length(), inlineCapacity);
+						break;
+				}
+				matching = matching && sameElements(list, expected);
+			}
+			ESSENTIALS_CHECK(matching);
+			list.resize(0);
+			list.shrinkToFit();
+			ESSENTIALS_CHECK(list.length() == 0 && live == 0);
+		}
+		ESSENTIALS_CHECK(live == 0);
+	}
+
+	/**
+	 * A copy which throws part way through a range insert leaves the list as it was
+	 */
+	template<typename L, typename E = Element> void throwingInsert() {
+		{
+			L list;
+			std::vector<int> expected;
+			for (int i = 0; i < 100; i++) {
+				list.push(E(i));
+				expected.push_back(i);
+			}
+			std::vector<E> items(10, E(1000));
+			for (size_t index : { size_t(0), size_t(37), size_t(99), size_t(100) }) {
+				for (int after : { 0, 4, 9 }) {
+					copiesBeforeThrow = after;
+					bool thrown = false;
+					try {
+						if (index == 100) list.append(items.data(), items.size());
+						else list.insertRange(index, items.begin(), items.end());
+					}
+					catch (const std::runtime_error&) {
+						thrown = true;
+					}
+					copiesBeforeThrow = -1;
+					ESSENTIALS_CHECK(thrown);
+					ESSENTIALS_CHECK(sameElements(list, expected));
+					ESSENTIALS_CHECK(live == 110);
+				}
+			}
+			// The list still works after the failed inserts
+			list.insertRange(50, items.begin(), items.end());
+			expected.insert(expected.begin() + 50, 10, 1000);
+			ESSENTIALS_CHECK(sameElements(list, expected));
+		}
+		ESSENTIALS_CHECK(live == 0);
+	}
+}
+
+/**
+ * Relocating bytewise would leave self pointing at the old address, so Element is moved one by one
+ */
+static_assert(!DataStructures::isTriviallyRelocatable<Element>);
+
+int main() {
+	againstVector<DataStructures::ArrayList<Element>>(0, 1);
+	againstVector<DataStructures::SmallArrayList<Element, 8>>(8, 2);
+	throwingInsert<DataStructures::ArrayList<Element>>();
+	throwingInsert<DataStructures::SmallArrayList<Element, 128>>();
+	againstVector<DataStructures::ArrayList<Relocatable>, Relocatable>(0, 3);
+	throwingInsert<DataStructures::ArrayList<Relocatable>, Relocatable>();
+	return Tests::result();
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "Files/AsyncIO.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * A callback that waits on another request's future, which reaps completions while the pool completions are being reaped
+	 * Every request must finish exactly once and give back its slot exactly once, in either completion order
+	 */
+	void reentrantCallback() {
+		const char* directory = std::getenv("TMPDIR");
+		std::string path = std::string(directory != nullptr ? directory : "/tmp") + "/essentials-async-io-test";
+		std::string text;
+		for (size_t i = 0; i < 256; i++)
+			text += static_cast<char>('a' + i % 26);
+		{
+			Files::File file(path.c_str(), Files::FileMode::create);
+			ESSENTIALS_CHECK(file.write(0, text.data(), text.size()) == text.size());
+		}
+		Files::File file(path.c_str(), Files::FileMode::read, Files::FileOptions{false});
+		Threading::ThreadPool pool(1);
+		Files::AsyncIO io(8, pool, false);
+
+		for (size_t round = 0; round < 20; round++) {
+			char first[128], second[128];
+			Files::IoFuture future;
+			int64_t waited = 0;
+			size_t calls = 0;
+			auto callback = [&](int64_t) {
+				calls++;
+				waited = future.get();
+			};
+			// Both orders, so the request waited on is reaped before and after the one waiting
+			if (round % 2 == 0) {
+				io.read(file, 0, first, 128, callback);
+				future = io.read(file, 128, second, 128);
+			} else {
+				future = io.read(file, 128, second, 128);
+				io.read(file, 0, first, 128, callback);
+			}
+			io.submit();
+			// Let the pool finish both, so they are reaped together
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			io.drain();
+			ESSENTIALS_CHECK(calls == 1);
+			ESSENTIALS_CHECK(waited == 128);
+			ESSENTIALS_CHECK(io.pending() == 0);
+			ESSENTIALS_CHECK(std::string(first, 128) == text.substr(0, 128));
+			ESSENTIALS_CHECK(std::string(second, 128) == text.substr(128));
+		}
+		std::remove(path.c_str());
+	}
+}
+
+int main() {
+	reentrantCallback();
+	return Tests::result();
+}
\ No newline at end of file
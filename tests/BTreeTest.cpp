@@ -0,0 +1,287 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "DataStructures/BTree.h"
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * The number of Tracked values alive
+	 */
+	int live = 0;
+
+	/**
+	 * Whether or not moving a Tracked value throws
+	 */
+	bool throwOnMove = false;
+
+	/**
+	 * A value which counts its instances and whose move constructor throws when asked to
+	 */
+	struct Tracked {
+		/**
+		 * The value held
+		 */
+		int value;
+
+		/**
+		 * Makes a value
+		 * @param value The value to hold
+		 */
+		Tracked(int value) : value(value) { live++; }
+
+		Tracked(const Tracked& other) : value(other.value) { live++; }
+
+		Tracked(Tracked&& other) : value(other.value) {
+			if (throwOnMove) throw std::runtime_error("move");
+			live++;
+		}
+
+		Tracked& operator=(const Tracked& other) = default;
+
+		~Tracked() { live--; }
+	};
+}
+
+/**
+ * Tracked values are moved around the tree with memcpy, so only building a new element calls the throwing move constructor
+ */
+template<> struct Essentials::DataStructures::IsTriviallyRelocatable<Tracked> : std::true_type {};
+
+namespace {
+
+	/**
+	 * Checks that a tree holds exactly the elements of a std::map, in order
+	 * @param tree The tree
+	 * @param expected The map
+	 * @returns Whether or not they match
+	 */
+	template<typename T, typename M> bool sameElements(const T& tree, const M& expected) {
+		if (tree.length() != expected.size()) return false;
+		auto it = expected.begin();
+		for (auto entry : tree) {
+			if (it == expected.end() || entry.key != it->first || entry.value != it->second) return false;
+			++it;
+		}
+		return it == expected.end();
+	}
+
+	/**
+	 * Random inserts, sets and removes checked against std::map, growing the tree to several levels and shrinking it back
+	 * to nothing so nodes split, borrow from both sides and merge, with lookups and ranges checked along the way
+	 */
+	void againstMap() {
+		std::mt19937 random(7);
+		DataStructures::BTreeMap<int, int> tree;
+		std::map<int, int> expected;
+		bool matching = true;
+		for (int phase = 0; phase < 6; phase++) {
+			int range = phase % 2 == 0 ? 20000 : 300;
+			for (int step = 0; step < 60000; step++) {
+				int key = static_cast<int>(random() % range);
+				// Grow in even phases and shrink in odd ones
+				bool growing = phase % 2 == 0 ? random() % 4 != 0 : random() % 4 == 0;
+				if (growing) {
+					switch (random() % 4) {
+						case 0:
+							matching = matching && tree.insert(key, step) == expected.emplace(key, step).second;
+							break;
+						case 1:
+							tree.set(key, step);
+							expected[key] = step;
+							break;
+						case 2:
+							matching = matching && tree.emplace(key, step) == expected.emplace(key, step).first->second;
+							break;
+						default:
+							tree[key] += 1;
+							expected[key] += 1;
+							break;
+					}
+				}
+				else {
+					int removed = static_cast<int>(random() % (phase % 2 == 0 ? range : 20000));
+					matching = matching && tree.remove(removed) == (expected.erase(removed) == 1);
+				}
+				if (step % 5000 == 0)
+					matching = matching && sameElements(tree, expected);
+			}
+			matching = matching && sameElements(tree, expected);
+
+			for (int query = 0; query < 2000; query++) {
+				int low = static_cast<int>(random() % 20100) - 50;
+				int high = low + static_cast<int>(random() % 500);
+				const int* found = tree.get(low);
+				auto at = expected.find(low);
+				matching = matching && (found == nullptr ? at == expected.end() : at != expected.end() && *found == at->second);
+				matching = matching && tree.contains(low) == (at != expected.end());
+				auto lower = tree.lowerBound(low);
+				auto expectedLower = expected.lower_bound(low);
+				matching = matching && (lower == tree.end() ? expectedLower == expected.end() : expectedLower != expected.end() && lower.key() == expectedLower->first);
+				auto upper = tree.upperBound(low);
+				auto expectedUpper = expected.upper_bound(low);
+				matching = matching && (upper == tree.end() ? expectedUpper == expected.end() : expectedUpper != expected.end() && upper.key() == expectedUpper->first);
+				auto it = expected.lower_bound(low);
+				for (auto entry : tree.range(low, high)) {
+					matching = matching && it != expected.end() && it->first < high && entry.key == it->first && entry.value == it->second;
+					if (it != expected.end()) ++it;
+				}
+				matching = matching && (it == expected.end() || it->first >= high);
+			}
+		}
+		// Empty the tree completely, then fill it again
+		for (auto it = expected.begin(); it != expected.end(); it = expected.erase(it))
+			matching = matching && tree.remove(it->first);
+		matching = matching && tree.length() == 0 && tree.begin() == tree.end() && !tree.remove(5);
+		for (int i = 0; i < 5000; i++) {
+			tree.insert(i * 3, i);
+			expected.emplace(i * 3, i);
+		}
+		matching = matching && sameElements(tree, expected);
+		ESSENTIALS_CHECK(matching);
+
+		DataStructures::BTreeMap<int, int> copy = tree;
+		copy.remove(0);
+		ESSENTIALS_CHECK(sameElements(tree, expected));
+		expected.erase(0);
+		ESSENTIALS_CHECK(sameElements(copy, expected));
+	}
+
+	/**
+	 * A set of strings (which are not trivially relocatable) against std::set, and a set built from sorted keys
+	 */
+	void stringSet() {
+		std::mt19937 random(11);
+		DataStructures::BTreeSet<std::string> tree;
+		std::set<std::string> expected;
+		bool matching = true;
+		for (int step = 0; step < 40000; step++) {
+			std::string key = "a key long enough to be on the heap " + std::to_string(random() % 4000);
+			if (random() % 3 != 0) matching = matching && tree.insert(key) == expected.insert(key).second;
+			else matching = matching && tree.remove(key) == (expected.erase(key) == 1);
+		}
+		matching = matching && tree.length() == expected.size();
+		auto it = expected.begin();
+		for (const std::string& key : tree) {
+			matching = matching && it != expected.end() && key == *it;
+			++it;
+		}
+		ESSENTIALS_CHECK(matching);
+
+		DataStructures::ArrayList<int> sorted;
+		for (int i = 0; i < 10000; i++) {
+			sorted.push(i / 2);
+		}
+		DataStructures::BTreeSet<int> built(sorted);
+		ESSENTIALS_CHECK(built.length() == 5000);
+		int next = 0;
+		bool ordered = true;
+		for (int key : built)
+			ordered = ordered && key == next++;
+		ESSENTIALS_CHECK(ordered && next == 5000);
+		ESSENTIALS_CHECK(built.remove(2500) && built.insert(2500) && !built.insert(2500));
+	}
+
+	/**
+	 * A new element whose move throws must leave the tree as it was, with nothing constructed left counted
+	 */
+	void throwingMove() {
+		{
+			DataStructures::BTreeMap<int, Tracked> tree;
+			for (int i = 0; i < 1000; i++)
+				tree.insert(i * 2, Tracked(i));
+			for (int i = 0; i < 1000; i += 7) {
+				throwOnMove = true;
+				bool thrown = false;
+				try {
+					if (i % 3 == 0) tree.insert(i * 2 + 1, Tracked(i));
+					else if (i % 3 == 1) tree.emplace(i * 2 + 1, i);
+					else tree.set(i * 2 + 1, Tracked(i));
+				}
+				catch (const std::runtime_error&) {
+					thrown = true;
+				}
+				throwOnMove = false;
+				ESSENTIALS_CHECK(thrown);
+				ESSENTIALS_CHECK(!tree.contains(i * 2 + 1));
+			}
+			ESSENTIALS_CHECK(tree.length() == 1000);
+			ESSENTIALS_CHECK(live == 1000);
+			int next = 0;
+			bool ordered = true;
+			for (auto entry : tree) {
+				ordered = ordered && entry.key == next * 2 && entry.value.value == next;
+				next++;
+			}
+			ESSENTIALS_CHECK(ordered && next == 1000);
+		}
+		ESSENTIALS_CHECK(live == 0);
+
+		// A failed first insert leaves an empty tree
+		{
+			DataStructures::BTreeMap<int, Tracked> tree;
+			throwOnMove = true;
+			try {
+				tree.emplace(1, 1);
+			}
+			catch (const std::runtime_error&) {}
+			throwOnMove = false;
+			ESSENTIALS_CHECK(tree.length() == 0 && tree.begin() == tree.end());
+			tree.emplace(2, 2);
+			ESSENTIALS_CHECK(tree.length() == 1 && tree.get(2) != nullptr && tree.get(2)->value == 2);
+		}
+		ESSENTIALS_CHECK(live == 0);
+	}
+
+	/**
+	 * Values built from other elements of the same tree, which a split or the gap of the new element moves
+	 */
+	void aliasedArguments() {
+		DataStructures::BTreeMap<int, std::string> tree;
+		std::map<int, std::string> expected;
+		for (int i = 0; i < 2000; i++) {
+			std::string value = "a value long enough to be on the heap " + std::to_string(i);
+			tree.insert(i * 4, value);
+			expected.emplace(i * 4, value);
+		}
+		for (int i = 0; i < 2000; i++) {
+			// The source is the next element, right where the gap for the new one is made
+			int source = (i + 1) % 2000 * 4;
+			tree.emplace(i * 4 + 1, *tree.get(source));
+			expected.emplace(i * 4 + 1, expected[source]);
+			tree.insert(i * 4 + 2, tree[source]);
+			expected.emplace(i * 4 + 2, expected[source]);
+			tree.set(i * 4 + 3, tree[i * 4 + 2]);
+			expected[i * 4 + 3] = expected[i * 4 + 2];
+		}
+		ESSENTIALS_CHECK(sameElements(tree, expected));
+	}
+}
+
+int main() {
+	againstMap();
+	stringSet();
+	throwingMove();
+	aliasedArguments();
+	return Tests::result();
+}
\ No newline at end of file
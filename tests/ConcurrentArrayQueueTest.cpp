@@ -0,0 +1,105 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "DataStructures/ArrayQueue.h"
+#include "DataStructures/ArrayList.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * Producers push numbered items (singly and in batches) through a small ring while consumers pop them
+	 * Every item must come out exactly once, and each consumer must see each producer's items in order
+	 * @param producers The number of producer threads
+	 * @param consumers The number of consumer threads
+	 * @param perProducer The number of items each producer pushes
+	 */
+	void stress(size_t producers, size_t consumers, size_t perProducer) {
+		DataStructures::ConcurrentArrayQueue<uint64_t> queue(8);
+		size_t total = producers * perProducer;
+		std::unique_ptr<std::atomic<uint32_t>[]> seen(new std::atomic<uint32_t>[total]());
+		std::atomic<size_t> received(0);
+		std::atomic<bool> ordered(true);
+
+		DataStructures::ArrayList<std::thread> threads;
+		for (size_t p = 0; p < producers; p++) {
+			threads.emplace([&, p] {
+				uint64_t batch[5];
+				for (size_t i = 0; i < perProducer; ) {
+					if (i % 3 == 0) {
+						size_t count = perProducer - i < 5 ? perProducer - i : 5;
+						for (size_t j = 0; j < count; j++)
+							batch[j] = (static_cast<uint64_t>(p) << 32) | (i + j);
+						size_t pushed = queue.tryPush(batch, count);
+						if (pushed == 0) std::this_thread::yield();
+						i += pushed;
+					}
+					else if (queue.tryPush((static_cast<uint64_t>(p) << 32) | i))
+						i++;
+					else
+						std::this_thread::yield();
+				}
+			});
+		}
+		for (size_t c = 0; c < consumers; c++) {
+			threads.emplace([&, c] {
+				DataStructures::ArrayList<int64_t> last;
+				for (size_t p = 0; p < producers; p++)
+					last.push(-1);
+				uint64_t batch[4];
+				while (received.load(std::memory_order_relaxed) < total) {
+					size_t count = c % 2 == 0 ? queue.tryDequeue(batch, 4) : queue.tryDequeue(batch[0]);
+					if (count == 0) {
+						std::this_thread::yield();
+						continue;
+					}
+					for (size_t j = 0; j < count; j++) {
+						size_t producer = static_cast<size_t>(batch[j] >> 32);
+						int64_t index = static_cast<int64_t>(batch[j] & 0xFFFFFFFFu);
+						if (index <= last[producer]) ordered = false;
+						last[producer] = index;
+						seen[producer * perProducer + static_cast<size_t>(index)].fetch_add(1, std::memory_order_relaxed);
+					}
+					received.fetch_add(count, std::memory_order_relaxed);
+				}
+			});
+		}
+		for (size_t i = 0; i < threads.length(); i++)
+			threads[i].join();
+
+		size_t once = 0;
+		for (size_t i = 0; i < total; i++)
+			once += seen[i].load() == 1;
+		ESSENTIALS_CHECK(once == total);
+		ESSENTIALS_CHECK(received.load() == total);
+		ESSENTIALS_CHECK(ordered.load());
+		ESSENTIALS_CHECK(queue.length() == 0);
+	}
+}
+
+int main() {
+	stress(1, 1, 200000);
+	stress(4, 1, 50000);
+	stress(1, 4, 200000);
+	stress(4, 4, 50000);
+	stress(8, 3, 20000);
+	return Tests::result();
+}
\ No newline at end of file
@@ -0,0 +1,339 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "Files/Directory.h"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * Makes a tree with files of several extensions, hidden files and directories, an empty directory and symbolic links
+	 * @param root The directory to make the tree in
+	 * @param levels The number of levels of subdirectories below root
+	 * @param fanOut The number of subdirectories of each directory above the last level
+	 */
+	void makeTree(const std::filesystem::path& root, size_t levels, size_t fanOut) {
+		std::filesystem::create_directories(root);
+		const char* names[] = {"notes.txt", "data.csv", "file1.log", "file2.txt", "README", ".hidden.txt", "archive.tar.gz", ".profile"};
+		size_t size = 0;
+		for (const char* name : names)
+			std::ofstream(root / name) << std::string(size++ * 7, 'x');
+		if (levels == 0) return;
+		std::filesystem::create_directory(root / "empty");
+		std::filesystem::create_symlink("notes.txt", root / "link.txt");
+		std::filesystem::create_directory_symlink(".", root / "loop");
+		makeTree(root / ".cache", levels - 1, 1);
+		for (size_t i = 0; i < fanOut; i++)
+			makeTree(root / ("directory" + std::to_string(i)), levels - 1, fanOut);
+	}
+
+	/**
+	 * Gets the type a walk should give an entry
+	 * @param status The status of the entry, not following symbolic links
+	 * @returns The type
+	 */
+	Files::EntryType typeOf(const std::filesystem::file_status& status) {
+		if (std::filesystem::is_symlink(status)) return Files::EntryType::symlink;
+		if (std::filesystem::is_directory(status)) return Files::EntryType::directory;
+		if (std::filesystem::is_regular_file(status)) return Files::EntryType::file;
+		return Files::EntryType::other;
+	}
+
+	/**
+	 * Describes an entry so walks can be compared as sets
+	 * @param path The path of the entry
+	 * @param depth The depth of the entry
+	 * @param type The type of the entry
+	 * @returns The description
+	 */
+	std::string describe(const std::string& path, size_t depth, Files::EntryType type) {
+		return path + " " + std::to_string(depth) + " " + std::to_string(static_cast<int>(type));
+	}
+
+	/**
+	 * Lists what a walk should list with std::filesystem
+	 * @param root The directory walked
+	 * @param options The options of the walk
+	 * @param accepts Whether or not a name passes the glob and extension filters
+	 * @returns The description of every entry
+	 */
+	std::multiset<std::string> reference(const std::string& root, const Files::DirectoryOptions& options, const std::function<bool(const std::string&)>& accepts) {
+		std::multiset<std::string> expected;
+		std::filesystem::recursive_directory_iterator entries(root), end;
+		for (; entries != end; ++entries) {
+			std::string name = entries->path().filename().string();
+			size_t depth = static_cast<size_t>(entries.depth());
+			Files::EntryType type = typeOf(entries->symlink_status());
+			if (!options.hidden && name[0] == '.') {
+				entries.disable_recursion_pending();
+				continue;
+			}
+			if (depth >= options.maxDepth)
+				entries.disable_recursion_pending();
+			if ((type == Files::EntryType::directory && !options.directories) || !accepts(name)) continue;
+			expected.insert(describe(entries->path().string(), depth, type));
+		}
+		return expected;
+	}
+
+	/**
+	 * Reads every entry of a walk, checking the name, depth and stat fields of each
+	 * @param directory The walk
+	 * @param stat Whether or not the walk stats every entry
+	 * @returns The description of every entry
+	 */
+	std::multiset<std::string> read(Files::Directory& directory, bool stat) {
+		std::multiset<std::string> found;
+		bool consistent = true;
+		for (Files::DirectoryEntry& entry : directory) {
+			std::string path(entry.path.data(), entry.path.length());
+			Strings::StringView name = entry.name();
+			consistent = consistent && std::filesystem::path(path).filename().string() == std::string(name.data(), name.length());
+			consistent = consistent && entry.hasStat == stat;
+			struct stat info;
+			if (stat && ::lstat(path.c_str(), &info) == 0) {
+				consistent = consistent && entry.mode == static_cast<uint32_t>(info.st_mode);
+				consistent = consistent && entry.size == static_cast<uint64_t>(info.st_size);
+				consistent = consistent && entry.inode == static_cast<uint64_t>(info.st_ino);
+#ifdef __APPLE__
+				consistent = consistent && entry.modified == static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+				consistent = consistent && entry.modified == static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+			} else if (!stat) {
+				consistent = consistent && entry.size == 0 && entry.mode == 0;
+			}
+			found.insert(describe(path, entry.depth, entry.type));
+		}
+		ESSENTIALS_CHECK(consistent);
+		return found;
+	}
+
+	/**
+	 * Every combination of maxDepth, hidden, directories and stat lists what std::filesystem finds, on one and several threads
+	 * @param root The tree to walk
+	 */
+	void options(const std::string& root) {
+		auto everything = [](const std::string&) {
+			return true;
+		};
+		bool matching = true;
+		for (size_t threads : {1, 4}) {
+			Threading::ThreadPool pool(threads);
+			for (size_t maxDepth : {static_cast<size_t>(0), static_cast<size_t>(1), static_cast<size_t>(2), static_cast<size_t>(-1)}) {
+				for (int flags = 0; flags < 8; flags++) {
+					Files::DirectoryOptions options;
+					options.maxDepth = maxDepth;
+					options.hidden = flags & 1;
+					options.directories = flags & 2;
+					options.stat = flags & 4;
+					Files::Directory directory(Strings::StringView(root.data(), root.length()), options, pool);
+					matching = matching && read(directory, options.stat) == reference(root, options, everything);
+					matching = matching && directory.error() == 0;
+				}
+			}
+		}
+		ESSENTIALS_CHECK(matching);
+
+		// A trailing slash on the root is not doubled
+		Threading::ThreadPool pool(2);
+		Files::DirectoryOptions shallow;
+		shallow.maxDepth = 0;
+		std::string slashed = root + "/";
+		Files::Directory directory(Strings::StringView(slashed.data(), slashed.length()), shallow, pool);
+		ESSENTIALS_CHECK(read(directory, false) == reference(root, shallow, everything));
+	}
+
+	/**
+	 * Globs and extensions list entries matching any of them, and directories that do not match are still walked
+	 * @param root The tree to walk
+	 */
+	void filters(const std::string& root) {
+		Threading::ThreadPool pool(3);
+		Files::DirectoryOptions options;
+
+		Files::Directory extensions(Strings::StringView(root.data(), root.length()), options, pool);
+		extensions.addExtension(".txt").addExtension("gz");
+		ESSENTIALS_CHECK(read(extensions, false) == reference(root, options, [](const std::string& name) {
+			std::string extension = std::filesystem::path(name).extension().string();
+			return extension == ".txt" || extension == ".gz";
+		}));
+
+		Files::Directory globs(Strings::StringView(root.data(), root.length()), options, pool);
+		globs.addGlob("file[0-1].*").addGlob("*.csv").addGlob("directory?");
+		ESSENTIALS_CHECK(read(globs, false) == reference(root, options, [](const std::string& name) {
+			return name == "file1.log" || name == "data.csv" || (name.size() == 10 && name.compare(0, 9, "directory") == 0);
+		}));
+
+		Files::Directory both(Strings::StringView(root.data(), root.length()), options, pool);
+		both.addGlob("README").addExtension("log");
+		ESSENTIALS_CHECK(read(both, false) == reference(root, options, [](const std::string& name) {
+			return name == "README" || name == "file1.log";
+		}));
+
+		ESSENTIALS_CHECK(Files::matchGlob("*.t?t", "notes.txt"));
+		ESSENTIALS_CHECK(Files::matchGlob("[!a-m]*", "notes.txt"));
+		ESSENTIALS_CHECK(!Files::matchGlob("[^n]*", "notes.txt"));
+		ESSENTIALS_CHECK(Files::matchGlob("a\\*b", "a*b") && !Files::matchGlob("a\\*b", "axb"));
+		ESSENTIALS_CHECK(Files::matchGlob("[x", "[x") && Files::matchGlob("*a*a*a*", "banana a"));
+		ESSENTIALS_CHECK(!Files::matchGlob("*.txt", "notes.txt.bak"));
+	}
+
+	/**
+	 * With only 8 entries allowed in the buffer the walk parks most directories, and a slow reader still gets every entry once
+	 * @param root The tree to walk
+	 */
+	void parking(const std::string& root) {
+		Files::DirectoryOptions options;
+		options.maxBuffered = 8;
+		auto everything = [](const std::string&) {
+			return true;
+		};
+		std::multiset<std::string> expected = reference(root, options, everything);
+		for (size_t threads : {1, 4}) {
+			Threading::ThreadPool pool(threads);
+			Files::Directory directory(Strings::StringView(root.data(), root.length()), options, pool);
+			std::multiset<std::string> found;
+			Files::DirectoryEntry entry;
+			while (directory.next(entry)) {
+				found.insert(describe(std::string(entry.path.data(), entry.path.length()), entry.depth, entry.type));
+				if (found.size() % 64 == 0)
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			ESSENTIALS_CHECK(found == expected);
+			ESSENTIALS_CHECK(!directory.next(entry));
+		}
+	}
+
+	/**
+	 * forEach visits every entry on the workers, including from inside a task of the same pool
+	 * @param root The tree to walk
+	 */
+	void visitAll(const std::string& root) {
+		Files::DirectoryOptions options;
+		options.hidden = false;
+		std::multiset<std::string> expected = reference(root, options, [](const std::string&) {
+			return true;
+		});
+		Threading::ThreadPool pool(4);
+		std::mutex mutex;
+		std::multiset<std::string> found;
+		Files::Directory directory(Strings::StringView(root.data(), root.length()), options, pool);
+		bool complete = directory.forEach([&](Files::DirectoryEntry& entry) {
+			std::string description = describe(std::string(entry.path.data(), entry.path.length()), entry.depth, entry.type);
+			std::lock_guard<std::mutex> lock(mutex);
+			found.insert(std::move(description));
+		});
+		ESSENTIALS_CHECK(complete);
+		ESSENTIALS_CHECK(found == expected);
+
+		Threading::ThreadPool single(1);
+		Threading::TaskGroup group;
+		std::atomic<size_t> count{0};
+		single.submit(group, [&] {
+			Files::Directory nested(Strings::StringView(root.data(), root.length()), options, single);
+			nested.forEach([&](Files::DirectoryEntry&) {
+				count.fetch_add(1);
+			});
+		});
+		single.wait(group);
+		ESSENTIALS_CHECK(count.load() == expected.size());
+	}
+
+	/**
+	 * Breaking out of a walk or stopping it part way ends it without waiting for the rest of the tree
+	 * @param root The tree to walk
+	 */
+	void earlyExit(const std::string& root) {
+		Threading::ThreadPool pool(4);
+		for (size_t round = 0; round < 20; round++) {
+			Files::DirectoryOptions options;
+			options.maxBuffered = round % 2 == 0 ? 8 : options.maxBuffered;
+			Files::Directory directory(Strings::StringView(root.data(), root.length()), options, pool);
+			size_t seen = 0;
+			for (Files::DirectoryEntry& entry : directory) {
+				(void) entry;
+				if (++seen == round + 1) break;
+			}
+			ESSENTIALS_CHECK(seen == round + 1);
+		}
+
+		Files::Directory stopped(Strings::StringView(root.data(), root.length()), Files::DirectoryOptions(), pool);
+		Files::DirectoryEntry entry;
+		ESSENTIALS_CHECK(stopped.next(entry));
+		stopped.stop();
+		while (stopped.next(entry)) {
+		}
+		ESSENTIALS_CHECK(!stopped.next(entry));
+		ESSENTIALS_CHECK(stopped.error() == 0);
+	}
+
+	/**
+	 * A root that does not exist lists nothing and reports ENOENT
+	 * @param root The tree to walk
+	 */
+	void missingRoot(const std::string& root) {
+		Threading::ThreadPool pool(2);
+		std::string missing = root + "/does-not-exist";
+		Files::Directory directory(Strings::StringView(missing.data(), missing.length()), Files::DirectoryOptions(), pool);
+		Files::DirectoryEntry entry;
+		ESSENTIALS_CHECK(!directory.next(entry));
+		ESSENTIALS_CHECK(directory.error() == ENOENT);
+		ESSENTIALS_CHECK(!(directory.begin() != directory.end()));
+
+		Files::Directory visited(Strings::StringView(missing.data(), missing.length()), Files::DirectoryOptions(), pool);
+		size_t count = 0;
+		ESSENTIALS_CHECK(!visited.forEach([&](Files::DirectoryEntry&) {
+			count++;
+		}));
+		ESSENTIALS_CHECK(count == 0 && visited.error() == ENOENT);
+
+		std::string file = root + "/notes.txt";
+		Files::Directory notDirectory(Strings::StringView(file.data(), file.length()), Files::DirectoryOptions(), pool);
+		ESSENTIALS_CHECK(!notDirectory.next(entry));
+		ESSENTIALS_CHECK(notDirectory.error() == ENOTDIR);
+	}
+}
+
+int main() {
+	const char* temporary = std::getenv("TMPDIR");
+	std::filesystem::path root = std::filesystem::path(temporary != nullptr ? temporary : "/tmp") / "essentials-directory-test";
+	std::filesystem::remove_all(root);
+	makeTree(root, 3, 3);
+	std::string path = root.string();
+
+	options(path);
+	filters(path);
+	parking(path);
+	visitAll(path);
+	earlyExit(path);
+	missingRoot(path);
+	std::filesystem::remove_all(root);
+	return Tests::result();
+}
\ No newline at end of file
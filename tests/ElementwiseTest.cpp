@@ -0,0 +1,314 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "Math/Elementwise.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * Measures how far a result is from the exact value in units in the last place of T
+	 * @param result The computed result
+	 * @param exact The exact value (a long double reference)
+	 * @returns The error in ulps (0 if both are the same infinity)
+	 */
+	template<typename T> double ulps(T result, long double exact) {
+		if (std::isinf(exact) || std::isinf(result)) return result == exact ? 0 : std::numeric_limits<double>::infinity();
+		int exponent = exact == 0 ? std::numeric_limits<T>::min_exponent - 1 : std::ilogb(exact);
+		exponent = std::max(exponent, std::numeric_limits<T>::min_exponent - 1);
+		long double spacing = std::ldexp(1.0L, exponent - (std::numeric_limits<T>::digits - 1));
+		return static_cast<double>(std::abs(result - exact) / spacing);
+	}
+
+	/**
+	 * Makes inputs spread over a range, with a length that leaves a remainder for the padded register
+	 * @param low The smallest input
+	 * @param high The largest input
+	 * @param count The number of random inputs
+	 * @returns The inputs
+	 */
+	template<typename T> std::vector<T> inputs(double low, double high, size_t count) {
+		std::mt19937 random(static_cast<unsigned>(count));
+		std::vector<T> values;
+		for (size_t i = 0; i < count; i++)
+			values.push_back(static_cast<T>(std::uniform_real_distribution<double>(low, high)(random)));
+		values.push_back(static_cast<T>(low));
+		values.push_back(static_cast<T>(high));
+		return values;
+	}
+
+	/**
+	 * Inputs spread over the exponents of T, from denormals up to the largest values
+	 * @param count The number of random inputs
+	 * @returns The positive inputs
+	 */
+	template<typename T> std::vector<T> logInputs(size_t count) {
+		std::mt19937 random(9);
+		std::vector<T> values;
+		int low = std::numeric_limits<T>::min_exponent - std::numeric_limits<T>::digits;
+		int high = std::numeric_limits<T>::max_exponent;
+		for (size_t i = 0; i < count; i++) {
+			T mantissa = static_cast<T>(std::uniform_real_distribution<double>(1, 2)(random));
+			int exponent = low + static_cast<int>(random() % static_cast<unsigned>(high - low));
+			values.push_back(std::ldexp(mantissa, exponent));
+		}
+		// Near 1, where the result loses its leading bits
+		for (size_t i = 0; i < count / 4; i++)
+			values.push_back(static_cast<T>(std::uniform_real_distribution<double>(0.7, 1.4)(random)));
+		values.push_back(std::numeric_limits<T>::denorm_min());
+		values.push_back(std::numeric_limits<T>::min());
+		values.push_back(std::numeric_limits<T>::max());
+		values.push_back(T(1));
+		return values;
+	}
+
+	/**
+	 * Applies an array function and finds its largest error against a long double reference
+	 * @param values The inputs
+	 * @param function The array function
+	 * @param exact The reference function
+	 * @returns The largest error in ulps
+	 */
+	template<typename T, typename F, typename E> double largestError(const std::vector<T>& values, F function, E exact) {
+		std::vector<T> out(values.size());
+		function(values.data(), out.data(), values.size());
+		double largest = 0;
+		for (size_t i = 0; i < values.size(); i++)
+			largest = std::max(largest, ulps(out[i], exact(static_cast<long double>(values[i]))));
+		return largest;
+	}
+
+	/**
+	 * The array functions stay within their documented error bounds (float exp within 1.01 ulp, the rest within 1 ulp)
+	 * @param pool The pool to run on
+	 */
+	template<typename T> void arrayBounds(Threading::ThreadPool& pool) {
+		constexpr bool isFloat = std::is_same_v<T, float>;
+		size_t count = 200003;
+		auto exp = [&](const T* in, T* out, size_t n) { Math::exp(in, out, n, pool); };
+		auto log = [&](const T* in, T* out, size_t n) { Math::log(in, out, n, pool); };
+		auto sin = [&](const T* in, T* out, size_t n) { Math::sin(in, out, n, pool); };
+		auto cos = [&](const T* in, T* out, size_t n) { Math::cos(in, out, n, pool); };
+		auto sqrt = [&](const T* in, T* out, size_t n) { Math::sqrt(in, out, n, pool); };
+		double expLimit = isFloat ? 88.0 : 709.0;
+		double expLow = isFloat ? -103.0 : -744.0;
+		double trigLimit = isFloat ? 8192.0 : 1e5;
+
+		double expError = largestError(inputs<T>(expLow, expLimit, count), exp, [](long double x) { return std::exp(x); });
+		ESSENTIALS_CHECK(expError <= (isFloat ? 1.01 : 1.0));
+		double smallExpError = largestError(inputs<T>(-1, 1, count), exp, [](long double x) { return std::exp(x); });
+		ESSENTIALS_CHECK(smallExpError <= (isFloat ? 1.01 : 1.0));
+		ESSENTIALS_CHECK(largestError(logInputs<T>(count), log, [](long double x) { return std::log(x); }) <= 1.0);
+		for (double range : { 1.0, 100.0, trigLimit }) {
+			ESSENTIALS_CHECK(largestError(inputs<T>(-range, range, count), sin, [](long double x) { return std::sin(x); }) <= 1.0);
+			ESSENTIALS_CHECK(largestError(inputs<T>(-range, range, count), cos, [](long double x) { return std::cos(x); }) <= 1.0);
+		}
+		ESSENTIALS_CHECK(largestError(logInputs<T>(count), sqrt, [](long double x) { return std::sqrt(x); }) <= 0.5);
+
+		// Beyond the reduction range the standard functions are used
+		std::vector<T> large = inputs<T>(trigLimit, trigLimit * 100, 1001);
+		std::vector<T> sines(large.size());
+		Math::sin(large.data(), sines.data(), large.size(), pool);
+		bool matching = true;
+		for (size_t i = 0; i < large.size(); i++)
+			matching = matching && sines[i] == std::sin(large[i]);
+		ESSENTIALS_CHECK(matching);
+	}
+
+	/**
+	 * NaN, infinite, overflowing, zero and denormal inputs to the array functions (in every lane of the register)
+	 */
+	template<typename T> void arraySpecialValues() {
+		constexpr T infinity = std::numeric_limits<T>::infinity();
+		constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+		constexpr T denormal = std::numeric_limits<T>::denorm_min() * 3;
+		const std::vector<T> special = { nan, infinity, -infinity, T(0), -T(0), denormal, -denormal, T(1000), T(-1000), T(-1) };
+		std::vector<T> values;
+		for (size_t shift = 0; shift < 8; shift++)
+			for (size_t i = 0; i < special.size(); i++)
+				values.push_back(special[(i + shift) % special.size()]);
+		std::vector<T> out(values.size());
+		bool matching = true;
+
+		Math::exp(values.data(), out.data(), values.size());
+		for (size_t i = 0; i < values.size(); i++) {
+			T x = values[i];
+			if (std::isnan(x)) matching = matching && std::isnan(out[i]);
+			else if (x == infinity || x == T(1000)) matching = matching && out[i] == infinity;
+			else if (x == -infinity || x == T(-1000)) matching = matching && out[i] == T(0);
+			else if (x == T(-1)) matching = matching && ulps(out[i], std::exp(-1.0L)) <= 1.01;
+			else matching = matching && out[i] == T(1);
+		}
+		ESSENTIALS_CHECK(matching);
+
+		Math::log(values.data(), out.data(), values.size());
+		matching = true;
+		for (size_t i = 0; i < values.size(); i++) {
+			T x = values[i];
+			if (std::isnan(x) || x < 0) matching = matching && std::isnan(out[i]);
+			else if (x == 0) matching = matching && out[i] == -infinity;
+			else if (x == infinity) matching = matching && out[i] == infinity;
+			else matching = matching && ulps(out[i], std::log(static_cast<long double>(x))) <= 1.0;
+		}
+		ESSENTIALS_CHECK(matching);
+
+		Math::sin(values.data(), out.data(), values.size());
+		matching = true;
+		for (size_t i = 0; i < values.size(); i++) {
+			T x = values[i];
+			if (std::isnan(x) || std::isinf(x)) matching = matching && std::isnan(out[i]);
+			// sin keeps the sign of zero and tiny inputs
+			else if (x == 0 || std::abs(x) == denormal) matching = matching && out[i] == x && std::signbit(out[i]) == std::signbit(x);
+			else matching = matching && ulps(out[i], std::sin(static_cast<long double>(x))) <= 1.0;
+		}
+		ESSENTIALS_CHECK(matching);
+
+		Math::cos(values.data(), out.data(), values.size());
+		matching = true;
+		for (size_t i = 0; i < values.size(); i++) {
+			T x = values[i];
+			if (std::isnan(x) || std::isinf(x)) matching = matching && std::isnan(out[i]);
+			else matching = matching && ulps(out[i], std::cos(static_cast<long double>(x))) <= 1.0;
+		}
+		ESSENTIALS_CHECK(matching);
+
+		Math::sqrt(values.data(), out.data(), values.size());
+		matching = true;
+		for (size_t i = 0; i < values.size(); i++) {
+			T x = values[i];
+			if (std::isnan(x) || x < 0) matching = matching && std::isnan(out[i]);
+			else matching = matching && out[i] == std::sqrt(x) && std::signbit(out[i]) == std::signbit(x);
+		}
+		ESSENTIALS_CHECK(matching);
+	}
+
+	/**
+	 * The number of inputs evaluated at compile time for each function
+	 */
+	constexpr size_t constantCount = 64;
+
+	/**
+	 * Makes an input for the compile time evaluations
+	 * @param i The index of the input
+	 * @param low The smallest input
+	 * @param high The largest input
+	 * @returns The input, spread unevenly between low and high
+	 */
+	constexpr double constantInput(size_t i, double low, double high) {
+		double fraction = static_cast<double>((i * 37) % constantCount) / (constantCount - 1);
+		return low + (high - low) * fraction * fraction;
+	}
+
+	/**
+	 * Evaluates a function at compile time over a range of inputs
+	 * @param low The smallest input
+	 * @param high The largest input
+	 * @param function The function to evaluate (called in a constant expression)
+	 * @returns The inputs and results
+	 */
+	template<typename F> constexpr std::array<std::array<double, 2>, constantCount> evaluate(double low, double high, F function) {
+		std::array<std::array<double, 2>, constantCount> results = {};
+		for (size_t i = 0; i < constantCount; i++) {
+			results[i][0] = constantInput(i, low, high);
+			results[i][1] = function(results[i][0]);
+		}
+		return results;
+	}
+
+	/**
+	 * Checks results computed at compile time against a long double reference
+	 * @param results The inputs and results
+	 * @param exact The reference function
+	 * @param bound The largest error allowed in ulps
+	 * @returns Whether or not every result is within the bound
+	 */
+	template<typename E> bool withinBound(const std::array<std::array<double, 2>, constantCount>& results, E exact, double bound) {
+		bool matching = true;
+		for (const auto& [input, result] : results)
+			matching = matching && ulps(result, exact(static_cast<long double>(input))) <= bound;
+		return matching;
+	}
+
+	/**
+	 * The constexpr scalar functions are within 1 ulp of double (sqrt correctly rounded) when evaluated at compile time,
+	 * including NaN, infinite and denormal inputs
+	 */
+	void constantExpressions() {
+		constexpr auto exps = evaluate(-745.0, 709.7, [](double x) { return Math::exp(x); });
+		constexpr auto smallExps = evaluate(-1.0, 1.0, [](double x) { return Math::exp(x); });
+		constexpr auto logs = evaluate(1e-300, 1e300, [](double x) { return Math::log(x); });
+		constexpr auto smallLogs = evaluate(0.5, 2.0, [](double x) { return Math::log(x); });
+		constexpr auto sines = evaluate(-1e5, 1e5, [](double x) { return Math::sin(x); });
+		constexpr auto cosines = evaluate(-1e5, 1e5, [](double x) { return Math::cos(x); });
+		constexpr auto smallSines = evaluate(-4.0, 4.0, [](double x) { return Math::sin(x); });
+		constexpr auto roots = evaluate(1e-300, 1e300, [](double x) { return Math::sqrt(x); });
+		ESSENTIALS_CHECK(withinBound(exps, [](long double x) { return std::exp(x); }, 1.0));
+		ESSENTIALS_CHECK(withinBound(smallExps, [](long double x) { return std::exp(x); }, 1.0));
+		ESSENTIALS_CHECK(withinBound(logs, [](long double x) { return std::log(x); }, 1.0));
+		ESSENTIALS_CHECK(withinBound(smallLogs, [](long double x) { return std::log(x); }, 1.0));
+		ESSENTIALS_CHECK(withinBound(sines, [](long double x) { return std::sin(x); }, 1.0));
+		ESSENTIALS_CHECK(withinBound(cosines, [](long double x) { return std::cos(x); }, 1.0));
+		ESSENTIALS_CHECK(withinBound(smallSines, [](long double x) { return std::sin(x); }, 1.0));
+		bool rounded = true;
+		for (const auto& [input, result] : roots)
+			rounded = rounded && result == std::sqrt(input);
+		ESSENTIALS_CHECK(rounded);
+
+		// Float results are rounded from double
+		constexpr float expFloat = Math::exp(10.5f);
+		constexpr float logFloat = Math::log(3e-40f);
+		ESSENTIALS_CHECK(ulps(expFloat, std::exp(10.5L)) <= 0.51 && ulps(logFloat, std::log(static_cast<long double>(3e-40f))) <= 0.51);
+
+		constexpr double infinity = std::numeric_limits<double>::infinity();
+		constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+		constexpr double denormal = std::numeric_limits<double>::denorm_min();
+		static_assert(Math::exp(0.0) == 1.0 && Math::log(1.0) == 0.0 && Math::sin(0.0) == 0.0 && Math::cos(0.0) == 1.0);
+		static_assert(Math::exp(infinity) == infinity && Math::exp(-infinity) == 0.0 && Math::exp(710.0) == infinity && Math::exp(-746.0) == 0.0);
+		static_assert(Math::exp(-740.0) > 0.0 && Math::exp(-740.0) < std::numeric_limits<double>::min());
+		static_assert(Math::exp(denormal) == 1.0);
+		static_assert(Math::log(0.0) == -infinity && Math::log(infinity) == infinity);
+		static_assert(Math::log(denormal) < -744.4 && Math::log(denormal) > -744.5);
+		static_assert(Math::sqrt(4.0) == 2.0 && Math::sqrt(infinity) == infinity && Math::sqrt(0.0) == 0.0);
+		static_assert(Math::sqrt(denormal) == 0x1p-537 && Math::sqrt(4 * denormal) == 0x1p-536);
+		static_assert(Math::exp(nan) != Math::exp(nan) && Math::log(nan) != Math::log(nan) && Math::log(-1.0) != Math::log(-1.0));
+		static_assert(Math::sqrt(nan) != Math::sqrt(nan) && Math::sqrt(-1.0) != Math::sqrt(-1.0));
+		static_assert(Math::sin(nan) != Math::sin(nan) && Math::sin(infinity) != Math::sin(infinity) && Math::cos(-infinity) != Math::cos(-infinity));
+		static_assert(Math::sin(denormal) == denormal && Math::cos(denormal) == 1.0);
+
+		// At runtime the standard functions are used
+		volatile double input = 0.75;
+		ESSENTIALS_CHECK(Math::exp(input) == std::exp(0.75) && Math::sin(input) == std::sin(0.75) && Math::sqrt(input) == std::sqrt(0.75));
+	}
+}
+
+int main() {
+	for (size_t threads : { size_t(0), size_t(3) }) {
+		Threading::ThreadPool pool(threads);
+		arrayBounds<float>(pool);
+		arrayBounds<double>(pool);
+	}
+	arraySpecialValues<float>();
+	arraySpecialValues<double>();
+	constantExpressions();
+	return Tests::result();
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "Files/File.h"
+#include "Files/RecordReader.h"
+#include <csignal>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * Makes the lines a writer sends down a pipe
+	 * @param count The number of lines
+	 * @returns The lines, each ending with a newline
+	 */
+	std::string makeLines(size_t count) {
+		std::string text;
+		for (size_t i = 0; i < count; i++)
+			text += "line " + std::to_string(i) + "\n";
+		return text;
+	}
+
+	/**
+	 * Opens the read end of a pipe through its path, with a thread writing text into the other end
+	 * @param text The text to write
+	 * @param file The file to open
+	 * @returns The writing thread, which closes the pipe once everything is written (or the file is closed, so a failed read
+	 * cannot leave it blocked)
+	 */
+	std::thread openPipe(const std::string& text, Files::File& file) {
+		int ends[2];
+		ESSENTIALS_CHECK(::pipe(ends) == 0);
+		ESSENTIALS_CHECK(file.open(("/dev/fd/" + std::to_string(ends[0])).c_str()));
+		::close(ends[0]);
+		return std::thread([&text, end = ends[1]] {
+			size_t written = 0;
+			while (written < text.size()) {
+				ssize_t put = ::write(end, text.data() + written, text.size() - written);
+				if (put <= 0) break;
+				written += static_cast<size_t>(put);
+			}
+			::close(end);
+		});
+	}
+
+	/**
+	 * A view of a pipe reads everything sent down it in order, and views cannot go back over bytes already read
+	 */
+	void pipeView() {
+		std::string text = makeLines(50000);
+		Files::File file;
+		std::thread writer = openPipe(text, file);
+		ESSENTIALS_CHECK(!file.seekable());
+		ESSENTIALS_CHECK(file.view(0, 5) == "line ");
+		Strings::StringView rest = file.view(10);
+		ESSENTIALS_CHECK(file.error() == 0);
+		ESSENTIALS_CHECK(rest.length() == text.size() - 10);
+		ESSENTIALS_CHECK(std::string(rest.data(), rest.length()) == text.substr(10));
+		ESSENTIALS_CHECK(file.view(0).length() == 0);
+		ESSENTIALS_CHECK(file.error() == ESPIPE);
+		file.close();
+		writer.join();
+	}
+
+	/**
+	 * A record reader over a pipe gives every line, across chunk boundaries and with prefetching asked for
+	 */
+	void pipeRecords() {
+		std::string text = makeLines(50000);
+		Files::File file;
+		std::thread writer = openPipe(text, file);
+		Files::RecordOptions options;
+		options.chunkSize = 4096;
+		Files::RecordReader reader(file, '\n', Files::FileRange(), options);
+		Strings::StringView record;
+		size_t count = 0;
+		bool matching = true;
+		while (reader.next(record)) {
+			std::string expected = "line " + std::to_string(count);
+			matching = matching && std::string(record.data(), record.length()) == expected;
+			count++;
+		}
+		ESSENTIALS_CHECK(reader.error() == 0);
+		ESSENTIALS_CHECK(count == 50000);
+		ESSENTIALS_CHECK(matching);
+		file.close();
+		writer.join();
+	}
+}
+
+int main() {
+	// Closing a pipe before the writer is done has to fail its writes rather than kill the test
+	std::signal(SIGPIPE, SIG_IGN);
+	pipeView();
+	pipeRecords();
+	return Tests::result();
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "DataStructures/Graph.h"
+#include <cstdio>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * Reads one line as an edge list into a weighted and an unweighted builder
+	 * @param text The contents of the file
+	 * @param valid Whether or not both builders should accept it
+	 * @param edges The number of edges both builders should end up with
+	 */
+	void expect(const char* text, bool valid, size_t edges) {
+		const char* path = "GraphTest.edges";
+		FILE* file = std::fopen(path, "wb");
+		std::fputs(text, file);
+		std::fclose(file);
+
+		DataStructures::GraphBuilder<> unweighted;
+		DataStructures::GraphBuilder<double> weighted;
+		bool unweightedValid = unweighted.readEdgeList(path);
+		bool weightedValid = weighted.readEdgeList(path);
+		std::remove(path);
+		if (unweightedValid != valid || weightedValid != valid || unweighted.edgeCount() != edges || weighted.edgeCount() != edges)
+			std::fprintf(stderr, "edge list \"%s\"\n", text);
+		ESSENTIALS_CHECK(unweightedValid == valid);
+		ESSENTIALS_CHECK(weightedValid == valid);
+		ESSENTIALS_CHECK(unweighted.edgeCount() == edges);
+		ESSENTIALS_CHECK(weighted.edgeCount() == edges);
+	}
+}
+
+int main() {
+	expect("0 1\n", true, 1);
+	expect("0 1 2.5\n", true, 1);
+	expect("0,1,2.5\r\n", true, 1);
+	expect("# comment\n\n0\t1\t3\n", true, 1);
+	expect("0 1 2.5 7\n", false, 0);
+	expect("0 1 2.5x\n", false, 0);
+	expect("0 1x\n", false, 0);
+	expect("0 1.5\n", false, 0);
+	expect("0 1 -2\n", false, 0);
+	expect("0 1 abc\n", false, 0);
+	expect("0 1\n2 3 4 5\n6 7\n", false, 1);
+	return Tests::result();
+}
\ No newline at end of file
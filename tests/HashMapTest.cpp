@@ -0,0 +1,105 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "DataStructures/HashMap.h"
+#include <stdexcept>
+#include <string>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * The number of Tracked values alive
+	 */
+	int live = 0;
+
+	/**
+	 * A value which counts its instances and throws from its constructor when asked to
+	 */
+	struct Tracked {
+		/**
+		 * The value held
+		 */
+		int value;
+
+		/**
+		 * Makes a value
+		 * @param value The value to hold (negative values throw)
+		 */
+		Tracked(int value) : value(value) {
+			if (value < 0) throw std::runtime_error("negative");
+			live++;
+		}
+
+		Tracked(const Tracked& other) : value(other.value) { live++; }
+
+		Tracked(Tracked&& other) noexcept : value(other.value) { live++; }
+
+		Tracked& operator=(const Tracked& other) = default;
+
+		~Tracked() { live--; }
+	};
+
+	/**
+	 * A value constructor that throws must leave the map as it was, with the slot still free
+	 */
+	void throwingConstructor() {
+		{
+			DataStructures::HashMap<std::string, Tracked> map;
+			for (int i = 0; i < 100; i++)
+				map.emplace(std::to_string(i), i);
+
+			for (int i = 100; i < 200; i++) {
+				bool thrown = false;
+				try {
+					map.emplace(std::to_string(i), -1);
+				}
+				catch (const std::runtime_error&) {
+					thrown = true;
+				}
+				ESSENTIALS_CHECK(thrown);
+				ESSENTIALS_CHECK(!map.contains(std::to_string(i)));
+			}
+			ESSENTIALS_CHECK(map.length() == 100);
+			ESSENTIALS_CHECK(live == 100);
+
+			try {
+				map.insert(std::string("insert"), -1);
+			}
+			catch (const std::runtime_error&) {}
+			try {
+				map.set(std::string("set"), -1);
+			}
+			catch (const std::runtime_error&) {}
+			ESSENTIALS_CHECK(!map.contains("insert") && !map.contains("set"));
+
+			for (int i = 100; i < 1000; i++)
+				map.emplace(std::to_string(i), i);
+			ESSENTIALS_CHECK(map.length() == 1000);
+			for (int i = 0; i < 1000; i++) {
+				Tracked* found = map.get(std::to_string(i));
+				ESSENTIALS_CHECK(found != nullptr && found->value == i);
+			}
+		}
+		ESSENTIALS_CHECK(live == 0);
+	}
+}
+
+int main() {
+	throwingConstructor();
+	return Tests::result();
+}
\ No newline at end of file
@@ -0,0 +1,264 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "DataStructures/Heap.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * Random pushes, dequeues and replaces checked against std::priority_queue, along with heaps built from a list and
+	 * lists pushed in both small batches (sifted up one by one) and large ones (heapified)
+	 * @param seed The seed of the random operations
+	 */
+	template<size_t Arity, typename Compare> void againstPriorityQueue(unsigned seed) {
+		std::mt19937 random(seed);
+		DataStructures::Heap<int, Compare, Arity> heap;
+		// std::priority_queue keeps the largest on top, so it takes the reversed comparison
+		auto reversed = [](int a, int b) { return Compare()(b, a); };
+		std::priority_queue<int, std::vector<int>, decltype(reversed)> expected(reversed);
+		bool matching = true;
+		for (int step = 0; step < 50000; step++) {
+			int value = static_cast<int>(random() % 1000);
+			switch (random() % 6) {
+				case 0:
+				case 1:
+					heap.push(value);
+					expected.push(value);
+					break;
+				case 2:
+					heap.emplace(value);
+					expected.push(value);
+					break;
+				case 3:
+					if (expected.empty()) break;
+					matching = matching && heap.replace(value) == expected.top();
+					expected.pop();
+					expected.push(value);
+					break;
+				case 4: {
+					DataStructures::ArrayList<int> batch;
+					// Batches at least a quarter the size of the heap are heapified, smaller ones sifted up
+					size_t count = random() % 3 == 0 && heap.length() < 2000 ? heap.length() + 1 : random() % 4;
+					for (size_t i = 0; i < count; i++) {
+						batch.push(static_cast<int>(random() % 1000));
+						expected.push(batch[i]);
+					}
+					heap.push(batch);
+					break;
+				}
+				default:
+					if (expected.empty()) break;
+					matching = matching && heap.dequeue() == expected.top();
+					expected.pop();
+					break;
+			}
+			matching = matching && heap.length() == expected.size();
+			if (!expected.empty()) matching = matching && heap.peek() == expected.top();
+		}
+		while (!expected.empty()) {
+			matching = matching && heap.dequeue() == expected.top();
+			expected.pop();
+		}
+		ESSENTIALS_CHECK(matching && heap.length() == 0);
+
+		DataStructures::ArrayList<int> list;
+		for (int i = 0; i < 5000; i++)
+			list.push(static_cast<int>(random() % 100000));
+		DataStructures::Heap<int, Compare, Arity> built(list);
+		std::vector<int> sorted(list.begin(), list.end());
+		std::sort(sorted.begin(), sorted.end(), Compare());
+		bool ordered = built.length() == sorted.size();
+		for (int value : sorted)
+			ordered = ordered && built.dequeue() == value;
+		ESSENTIALS_CHECK(ordered && built.length() == 0);
+	}
+
+	/**
+	 * Strings, which are moved around the heap rather than copied
+	 */
+	void strings() {
+		DataStructures::Heap<std::string> heap;
+		for (int i = 999; i >= 0; i--) {
+			heap.push("a string long enough to be on the heap " + std::to_string(1000 + i));
+		}
+		bool ordered = true;
+		for (int i = 0; i < 1000; i++)
+			ordered = ordered && heap.dequeue() == "a string long enough to be on the heap " + std::to_string(1000 + i);
+		ESSENTIALS_CHECK(ordered && heap.length() == 0);
+	}
+
+	/**
+	 * Checks an indexed heap against the reference of which handles hold which values
+	 * @param heap The heap
+	 * @param handles The live handles
+	 * @param values The value held by each handle
+	 * @returns Whether or not they match
+	 */
+	template<typename H> bool sameItems(const H& heap, const std::vector<size_t>& handles, const std::vector<int>& values) {
+		if (heap.length() != handles.size()) return false;
+		if (handles.empty()) return true;
+		int smallest = values[handles[0]];
+		for (size_t handle : handles) {
+			if (!heap.contains(handle) || heap.get(handle) != values[handle]) return false;
+			smallest = std::min(smallest, values[handle]);
+		}
+		return heap.peek() == smallest && heap.get(heap.peekHandle()) == smallest;
+	}
+
+	/**
+	 * Random pushes, dequeues, key decreases, updates and removals by handle checked against the values of the live
+	 * handles, including handles reused after their elements leave the heap
+	 * @param seed The seed of the random operations
+	 */
+	template<size_t Arity> void indexedAgainstReference(unsigned seed) {
+		std::mt19937 random(seed);
+		DataStructures::IndexedHeap<int, std::less<int>, Arity> heap;
+		std::vector<size_t> handles;
+		std::vector<int> values;
+		std::vector<bool> live;
+		bool matching = true;
+		// Removes a handle from the live ones, remembering it can no longer be found in the heap
+		auto retire = [&](size_t handle) {
+			auto at = std::find(handles.begin(), handles.end(), handle);
+			matching = matching && at != handles.end();
+			if (at == handles.end()) return;
+			*at = handles.back();
+			handles.pop_back();
+			live[handle] = false;
+		};
+		for (int step = 0; step < 60000; step++) {
+			int value = static_cast<int>(random() % 10000);
+			unsigned operation = static_cast<unsigned>(random() % 6);
+			if (handles.empty() || operation < 2) {
+				size_t handle = heap.push(value);
+				if (handle >= values.size()) {
+					values.resize(handle + 1);
+					live.resize(handle + 1);
+				}
+				matching = matching && !live[handle];
+				values[handle] = value;
+				live[handle] = true;
+				handles.push_back(handle);
+				continue;
+			}
+			size_t handle = handles[random() % handles.size()];
+			switch (operation) {
+				case 2: {
+					int lower = values[handle] - static_cast<int>(random() % 100);
+					heap.decreaseKey(handle, lower);
+					values[handle] = lower;
+					break;
+				}
+				case 3:
+					heap.update(handle, value);
+					values[handle] = value;
+					break;
+				case 4:
+					matching = matching && heap.erase(handle) == values[handle];
+					retire(handle);
+					break;
+				default: {
+					size_t top = heap.peekHandle();
+					matching = matching && top < live.size() && live[top] && heap.dequeue() == values[top];
+					retire(top);
+					break;
+				}
+			}
+			if (step % 1000 == 0) {
+				matching = matching && sameItems(heap, handles, values);
+				for (size_t i = 0; i < live.size(); i++)
+					matching = matching && heap.contains(i) == live[i];
+			}
+		}
+		matching = matching && sameItems(heap, handles, values);
+		int previous = -(1 << 30);
+		while (heap.length() > 0) {
+			int top = heap.dequeue();
+			matching = matching && top >= previous;
+			previous = top;
+		}
+		ESSENTIALS_CHECK(matching);
+		ESSENTIALS_CHECK(!heap.contains(0) && !heap.contains(1000000));
+	}
+
+	/**
+	 * Dijkstra's shortest paths on a random graph using decrease-key, checked against a lazy-deletion priority queue
+	 */
+	void shortestPaths() {
+		std::mt19937 random(5);
+		const size_t nodes = 2000;
+		std::vector<std::vector<std::pair<size_t, int>>> edges(nodes);
+		for (size_t i = 0; i < nodes * 8; i++)
+			edges[random() % nodes].emplace_back(random() % nodes, static_cast<int>(random() % 1000));
+
+		const int infinity = 1 << 30;
+		std::vector<int> expected(nodes, infinity);
+		using Pair = std::pair<int, size_t>;
+		std::priority_queue<Pair, std::vector<Pair>, std::greater<Pair>> queue;
+		expected[0] = 0;
+		queue.emplace(0, 0);
+		while (!queue.empty()) {
+			auto [distance, node] = queue.top();
+			queue.pop();
+			if (distance > expected[node]) continue;
+			for (auto [next, weight] : edges[node]) {
+				if (distance + weight < expected[next]) {
+					expected[next] = distance + weight;
+					queue.emplace(expected[next], next);
+				}
+			}
+		}
+
+		// Every node is pushed up front, so handle i is node i
+		DataStructures::ArrayList<int> start;
+		for (size_t i = 0; i < nodes; i++)
+			start.push(i == 0 ? 0 : infinity);
+		DataStructures::IndexedHeap<int> heap(start);
+		std::vector<int> found(nodes, infinity);
+		while (heap.length() > 0) {
+			size_t node = heap.peekHandle();
+			int distance = heap.dequeue();
+			found[node] = distance;
+			if (distance == infinity) continue;
+			for (auto [next, weight] : edges[node]) {
+				if (heap.contains(next) && distance + weight < heap.get(next))
+					heap.decreaseKey(next, distance + weight);
+			}
+		}
+		ESSENTIALS_CHECK(found == expected);
+	}
+}
+
+int main() {
+	againstPriorityQueue<2, std::less<int>>(1);
+	againstPriorityQueue<3, std::less<int>>(2);
+	againstPriorityQueue<4, std::greater<int>>(3);
+	againstPriorityQueue<8, std::less<int>>(4);
+	strings();
+	indexedAgainstReference<2>(6);
+	indexedAgainstReference<4>(7);
+	indexedAgainstReference<5>(8);
+	shortestPaths();
+	return Tests::result();
+}
\ No newline at end of file
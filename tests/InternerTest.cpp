@@ -0,0 +1,78 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "String/Interner.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * Threads intern overlapping sets of strings while another watches length(), which must never count a string
+	 * before it can be found and must settle on the number of distinct strings with ids 0 to length() - 1
+	 */
+	void concurrentLength() {
+		Strings::Interner interner;
+		const size_t distinct = 20000;
+		std::vector<std::string> strings;
+		for (size_t i = 0; i < distinct; i++)
+			strings.push_back("string " + std::to_string(i));
+
+		std::atomic<bool> running(true);
+		std::atomic<bool> decreased(false);
+		std::thread watcher([&] {
+			size_t last = 0;
+			while (running.load()) {
+				size_t now = interner.length();
+				if (now < last) decreased = true;
+				last = now;
+			}
+		});
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < 4; t++) {
+			threads.emplace_back([&, t] {
+				for (size_t i = 0; i < distinct; i++)
+					interner.intern(Strings::StringView(strings[(i * (t + 1) * 7919) % distinct].c_str()));
+			});
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+		running = false;
+		watcher.join();
+
+		ESSENTIALS_CHECK(!decreased.load());
+		ESSENTIALS_CHECK(interner.length() == distinct);
+		std::vector<bool> seen(distinct, false);
+		for (const std::string& string : strings) {
+			Strings::Symbol symbol = interner.find(Strings::StringView(string.c_str()));
+			ESSENTIALS_CHECK(symbol.valid() && symbol.id() < interner.length());
+			if (symbol.valid() && symbol.id() < distinct) {
+				ESSENTIALS_CHECK(!seen[symbol.id()]);
+				seen[symbol.id()] = true;
+				ESSENTIALS_CHECK(interner.view(symbol) == string.c_str());
+			}
+		}
+	}
+}
+
+int main() {
+	concurrentLength();
+	return Tests::result();
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "DataStructures/ArrayList.h"
+#include "DataStructures/Iterable.h"
+#include "DataStructures/LinkedList.h"
+#include <iterator>
+#include <type_traits>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * Zipped views end with the shorter range, and their iterators compare equal only when both sides match
+	 */
+	void zip() {
+		DataStructures::ArrayList<int> numbers;
+		DataStructures::LinkedList<int> linked;
+		for (int i = 0; i < 10; i++) {
+			numbers.push(i);
+			if (i < 6) linked.push(i * 10);
+		}
+
+		int sum = 0;
+		size_t pairs = 0;
+		for (auto pair : DataStructures::iterate(numbers).zip(linked)) {
+			sum += pair.first + pair.second;
+			pairs++;
+		}
+		ESSENTIALS_CHECK(pairs == 6);
+		ESSENTIALS_CHECK(sum == 15 + 150);
+
+		auto evens = DataStructures::iterate(numbers).filter([](int value) { return value % 2 == 0; });
+		ESSENTIALS_CHECK(evens.zip(numbers).count() == 5);
+		ESSENTIALS_CHECK(DataStructures::iterate(linked).zip(evens).count() == 5);
+
+		auto view = DataStructures::iterate(numbers).zip(linked);
+		auto a = view.begin();
+		auto b = view.begin();
+		++b;
+		ESSENTIALS_CHECK(a != b);
+		ESSENTIALS_CHECK(++a == b);
+	}
+
+	/**
+	 * Chunk iterators hand out references to a stored group, as a forward iterator must
+	 */
+	void chunk() {
+		using View = decltype(DataStructures::iterate(std::declval<DataStructures::ArrayList<int>&>()).chunk(1));
+		using Iterator = decltype(std::declval<View&>().begin());
+		static_assert(std::is_reference_v<typename std::iterator_traits<Iterator>::reference>, "a forward iterator's reference must be a reference");
+
+		DataStructures::ArrayList<int> numbers;
+		for (int i = 0; i < 10; i++)
+			numbers.push(i);
+		auto groups = DataStructures::iterate(numbers).chunk(4);
+		ESSENTIALS_CHECK(groups.count() == 3);
+
+		auto it = groups.begin();
+		const auto& first = *it;
+		ESSENTIALS_CHECK(first.count() == 4 && *first.begin() == 0);
+		ESSENTIALS_CHECK(it->count() == 4);
+		++it;
+		ESSENTIALS_CHECK(*it->begin() == 4);
+		++it;
+		ESSENTIALS_CHECK(it->count() == 2 && *it->begin() == 8);
+		++it;
+		ESSENTIALS_CHECK(it == groups.end());
+
+		int sum = 0;
+		for (const auto& group : groups)
+			for (int value : group)
+				sum += value;
+		ESSENTIALS_CHECK(sum == 45);
+	}
+}
+
+int main() {
+	zip();
+	chunk();
+	return Tests::result();
+}
\ No newline at end of file
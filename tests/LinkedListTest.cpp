@@ -0,0 +1,225 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "DataStructures/LinkedList.h"
+#include "DataStructures/LinkedQueue.h"
+#include "DataStructures/LinkedStack.h"
+#include <string>
+#include <vector>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * An element of the list and where it was stored
+	 */
+	struct Placed {
+		/**
+		 * The element
+		 */
+		int value;
+
+		/**
+		 * The address of the element
+		 */
+		const int* address;
+	};
+
+	/**
+	 * Gets every element of a list with its address
+	 * @param list The list
+	 * @returns The elements in order
+	 */
+	std::vector<Placed> snapshot(DataStructures::LinkedList<int>& list) {
+		std::vector<Placed> placed;
+		for (int& value : list)
+			placed.push_back({ value, &value });
+		return placed;
+	}
+
+	/**
+	 * Finds the elements stored in the same node as an element, which are consecutive both in order and in memory
+	 * @param placed The elements of the list
+	 * @param index The index of the element
+	 * @param first Set to the index of the first element of the node
+	 * @param last Set to one past the index of the last element of the node
+	 */
+	void nodeOf(const std::vector<Placed>& placed, size_t index, size_t& first, size_t& last) {
+		first = index;
+		while (first > 0 && placed[first - 1].address + 1 == placed[first].address)
+			first--;
+		last = index + 1;
+		while (last < placed.size() && placed[last - 1].address + 1 == placed[last].address)
+			last++;
+	}
+
+	/**
+	 * Checks that only the elements of one node moved
+	 * @param before The elements before the change, with the node of the change given by first and last
+	 * @param after The elements after the change
+	 * @param first The index of the first element of the changed node
+	 * @param last One past the index of the last element of the changed node
+	 */
+	void checkStable(const std::vector<Placed>& before, const std::vector<Placed>& after, size_t first, size_t last) {
+		std::vector<const int*> addresses;
+		for (const Placed& placed : after) {
+			if (addresses.size() <= static_cast<size_t>(placed.value))
+				addresses.resize(static_cast<size_t>(placed.value) + 1, nullptr);
+			addresses[static_cast<size_t>(placed.value)] = placed.address;
+		}
+		for (size_t i = 0; i < before.size(); i++) {
+			if (i >= first && i < last) continue;
+			size_t value = static_cast<size_t>(before[i].value);
+			const int* now = value < addresses.size() ? addresses[value] : nullptr;
+			ESSENTIALS_CHECK(now == nullptr || now == before[i].address);
+		}
+	}
+
+	/**
+	 * Random inserts and erases through iterators must only move elements of the node they happen in
+	 */
+	void iteratorStability() {
+		DataStructures::LinkedList<int> list;
+		std::vector<int> mirror;
+		int nextValue = 0;
+		uint32_t state = 7;
+		for (size_t step = 0; step < 20000; step++) {
+			state = state * 1664525u + 1013904223u;
+			size_t length = mirror.size();
+			// Grow towards a few hundred elements, then hover so nodes keep splitting and merging
+			bool adding = length < 8 || (state >> 16) % 100 < (length < 300 ? 60u : 45u);
+			size_t index = length > 0 ? (state >> 8) % (adding ? length + 1 : length) : 0;
+
+			std::vector<Placed> before = snapshot(list);
+			auto position = list.begin();
+			for (size_t i = 0; i < index; i++)
+				++position;
+			size_t first = 0;
+			size_t last = 0;
+			if (length > 0)
+				nodeOf(before, index < length ? index : length - 1, first, last);
+
+			if (adding) {
+				int value = nextValue++;
+				auto added = list.insert(position, value);
+				ESSENTIALS_CHECK(*added == value);
+				mirror.insert(mirror.begin() + static_cast<std::ptrdiff_t>(index), value);
+			}
+			else {
+				auto following = list.erase(position);
+				mirror.erase(mirror.begin() + static_cast<std::ptrdiff_t>(index));
+				ESSENTIALS_CHECK(index == mirror.size() ? following == list.end() : *following == mirror[index]);
+			}
+
+			std::vector<Placed> after = snapshot(list);
+			ESSENTIALS_CHECK(after.size() == mirror.size() && list.length() == mirror.size());
+			for (size_t i = 0; i < after.size() && i < mirror.size(); i++)
+				ESSENTIALS_CHECK(after[i].value == mirror[i]);
+			checkStable(before, after, first, last);
+			if (Tests::failures() > 0) return;
+		}
+	}
+
+	/**
+	 * Emplace constructs in place, and may be given an element of the list itself
+	 */
+	void emplaceInPlace() {
+		DataStructures::LinkedList<std::string> list;
+		list.emplace("a string too long for inline storage");
+		for (size_t i = 0; i < 100; i++)
+			list.emplace(list.front());
+		ESSENTIALS_CHECK(list.length() == 101);
+		for (const std::string& item : list)
+			ESSENTIALS_CHECK(item == "a string too long for inline storage");
+		list.emplace(5, 'x');
+		ESSENTIALS_CHECK(list.back() == "xxxxx");
+	}
+
+	/**
+	 * Lists, stacks and queues request their pools and nodes from their allocator and give every byte back
+	 */
+	void allocators() {
+		DataStructures::AllocationCounts counts;
+		using Counting = DataStructures::CountingAllocator<>;
+		{
+			DataStructures::LinkedList<std::string, Counting> list{ Counting(counts) };
+			ESSENTIALS_CHECK(counts.allocations == 0);
+			for (int i = 0; i < 1000; i++)
+				list.push("a string too long for inline storage " + std::to_string(i));
+			// The pool itself and its chunks of nodes
+			ESSENTIALS_CHECK(counts.allocations > 1 && counts.bytes > 0);
+			size_t allocations = counts.allocations;
+			for (int i = 0; i < 1000; i++)
+				list.popFront();
+			for (int i = 0; i < 1000; i++)
+				list.push("another string too long for inline storage");
+			ESSENTIALS_CHECK(counts.allocations == allocations);
+
+			DataStructures::LinkedList<std::string, Counting> moved(std::move(list));
+			DataStructures::LinkedList<std::string, Counting> copied(moved);
+			ESSENTIALS_CHECK(copied.length() == 1000 && copied.back() == "another string too long for inline storage");
+			DataStructures::LinkedList<std::string, Counting> empty{ Counting(counts) };
+			empty.splice(copied);
+			ESSENTIALS_CHECK(empty.length() == 1000 && copied.length() == 0);
+		}
+		ESSENTIALS_CHECK(counts.bytes == 0 && counts.allocations == counts.deallocations);
+
+		{
+			DataStructures::LinkedNodePool<int, Counting> pool(16, Counting(counts));
+			DataStructures::LinkedStack<int, Counting> stack(pool);
+			DataStructures::LinkedQueue<int, Counting> queue(pool);
+			for (int i = 0; i < 500; i++) {
+				stack.push(i);
+				queue.push(i);
+			}
+			bool ordered = true;
+			for (int i = 0; i < 500; i++) {
+				ordered = ordered && stack.pop() == 499 - i;
+				ordered = ordered && queue.dequeue() == i;
+			}
+			ESSENTIALS_CHECK(ordered && stack.length() == 0 && queue.length() == 0);
+			DataStructures::LinkedQueue<int, Counting> own{ Counting(counts) };
+			own.push(1);
+			ESSENTIALS_CHECK(own.peek() == 1);
+		}
+		ESSENTIALS_CHECK(counts.bytes == 0 && counts.allocations == counts.deallocations);
+
+		DataStructures::Arena arena;
+		{
+			DataStructures::ArenaAllocator handle(arena);
+			DataStructures::LinkedList<int, DataStructures::ArenaAllocator> list(handle);
+			for (int i = 0; i < 10000; i++)
+				list.pushFront(i);
+			ESSENTIALS_CHECK(arena.bytesUsed() >= 10000 * sizeof(int));
+			bool ordered = list.length() == 10000;
+			int expected = 9999;
+			for (int item : list)
+				ordered = ordered && item == expected--;
+			ESSENTIALS_CHECK(ordered);
+			DataStructures::LinkedStack<int, DataStructures::ArenaAllocator> stack(handle);
+			stack.push(3);
+			ESSENTIALS_CHECK(stack.peek() == 3);
+		}
+	}
+}
+
+int main() {
+	iteratorStability();
+	emplaceInPlace();
+	allocators();
+	return Tests::result();
+}
\ No newline at end of file
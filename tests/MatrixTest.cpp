@@ -0,0 +1,297 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "Math/Matrix.h"
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * Fills a matrix with random values, small integers for integer matrices
+	 * @param matrix The matrix
+	 * @param random The random number generator
+	 */
+	template<typename T> void fill(Math::Matrix<T>& matrix, std::mt19937& random) {
+		for (size_t i = 0; i < matrix.rows() * matrix.columns(); i++) {
+			if constexpr (std::is_integral_v<T>) matrix.data()[i] = static_cast<T>(random() % 21) - 10;
+			else matrix.data()[i] = static_cast<T>(std::uniform_real_distribution<double>(-1, 1)(random));
+		}
+	}
+
+	/**
+	 * Checks C = C0 + A * B against a long double reference, within the rounding error of a dot product of each length
+	 * (exactly for integers)
+	 * @param a The left operand
+	 * @param b The right operand
+	 * @param c0 What C held before the product was added
+	 * @param c The computed result
+	 * @returns Whether or not every element is close enough to the reference
+	 */
+	template<typename T> bool closeToProduct(const Math::Matrix<T>& a, const Math::Matrix<T>& b, const Math::Matrix<T>& c0, const Math::Matrix<T>& c) {
+		if (c.rows() != a.rows() || c.columns() != b.columns()) return false;
+		for (size_t i = 0; i < a.rows(); i++)
+			for (size_t j = 0; j < b.columns(); j++) {
+				long double sum = c0(i, j);
+				long double magnitude = std::abs(static_cast<long double>(c0(i, j)));
+				for (size_t k = 0; k < a.columns(); k++) {
+					sum += static_cast<long double>(a(i, k)) * b(k, j);
+					magnitude += std::abs(static_cast<long double>(a(i, k)) * b(k, j));
+				}
+				long double error = std::abs(static_cast<long double>(c(i, j)) - sum);
+				if constexpr (std::is_integral_v<T>) {
+					if (error != 0) return false;
+				}
+				else if (error > magnitude * (a.columns() + 1) * std::numeric_limits<T>::epsilon()) return false;
+			}
+		return true;
+	}
+
+	/**
+	 * Products at sizes around the small product cutoff and not multiples of the register tile (6 rows by 8 or 16
+	 * columns) or the blocks (72 rows, 256 deep, 4080 columns), on pools with and without helper threads
+	 * @param pool The pool to run gemm on
+	 */
+	template<typename T> void gemmSizes(Threading::ThreadPool& pool) {
+		std::mt19937 random(3);
+		const size_t sizes[][3] = {
+			{ 1, 1, 1 }, { 3, 5, 7 }, { 32, 32, 32 }, { 33, 32, 32 }, { 6, 16, 400 }, { 7, 17, 300 }, { 13, 9, 257 },
+			{ 71, 33, 41 }, { 73, 131, 257 }, { 145, 47, 513 }, { 150, 150, 150 }, { 5, 4097, 3 }, { 2, 8200, 40 }
+		};
+		bool matching = true;
+		for (const auto& size : sizes) {
+			Math::Matrix<T> a(size[0], size[2]);
+			Math::Matrix<T> b(size[2], size[1]);
+			Math::Matrix<T> c0(size[0], size[1]);
+			fill(a, random);
+			fill(b, random);
+			fill(c0, random);
+			Math::Matrix<T> c(c0);
+			Math::gemm(size[0], size[1], size[2], a.data(), a.columns(), b.data(), b.columns(), c.data(), c.columns(), pool);
+			matching = matching && closeToProduct(a, b, c0, c);
+		}
+		ESSENTIALS_CHECK(matching);
+	}
+
+	/**
+	 * The product expressions: A * B, A * B + C (in either order) and C += A * B, including ones assigned to an operand
+	 */
+	template<typename T> void productExpressions() {
+		std::mt19937 random(4);
+		bool matching = true;
+		for (size_t size : { size_t(5), size_t(40), size_t(77), size_t(130) }) {
+			Math::Matrix<T> a(size, size + 3);
+			Math::Matrix<T> b(size + 3, size + 1);
+			Math::Matrix<T> c(size, size + 1);
+			fill(a, random);
+			fill(b, random);
+			fill(c, random);
+			Math::Matrix<T> zero(size, size + 1);
+
+			Math::Matrix<T> product = a * b;
+			matching = matching && closeToProduct(a, b, zero, product);
+			Math::Matrix<T> sum = a * b + c;
+			matching = matching && closeToProduct(a, b, c, sum);
+			Math::Matrix<T> reversed = c + a * b;
+			matching = matching && closeToProduct(a, b, c, reversed);
+			Math::Matrix<T> scaled = a * b + c * T(2);
+			matching = matching && closeToProduct(a, b, Math::Matrix<T>(c * T(2)), scaled);
+			Math::Matrix<T> accumulated(c);
+			accumulated += a * b;
+			matching = matching && closeToProduct(a, b, c, accumulated);
+			// The destination is also the addend
+			Math::Matrix<T> into(c);
+			into = a * b + into;
+			matching = matching && closeToProduct(a, b, c, into);
+
+			// The destination is also an operand
+			Math::Matrix<T> square(size, size);
+			fill(square, random);
+			Math::Matrix<T> original(square);
+			square = square * original;
+			matching = matching && closeToProduct(original, original, Math::Matrix<T>(size, size), square);
+			square = original;
+			square = square * original + original;
+			matching = matching && closeToProduct(original, original, original, square);
+			square = original;
+			square += original * square;
+			matching = matching && closeToProduct(original, original, original, square);
+		}
+		ESSENTIALS_CHECK(matching);
+	}
+
+	/**
+	 * LU and Cholesky decompositions solve systems, and report singular and non positive definite input
+	 */
+	template<typename T> void decompositions() {
+		std::mt19937 random(5);
+		T tolerance = std::numeric_limits<T>::epsilon() * 1000;
+		for (size_t size : { size_t(1), size_t(4), size_t(50), size_t(300) }) {
+			// Diagonally dominant, so well conditioned, and symmetric positive definite once made symmetric
+			Math::Matrix<T> matrix(size, size);
+			fill(matrix, random);
+			for (size_t i = 0; i < size; i++)
+				matrix(i, i) += T(size);
+			Math::Matrix<T> symmetric = matrix + matrix.transposed();
+			Math::Matrix<T> rhs(size, 3);
+			fill(rhs, random);
+
+			Math::Matrix<T> lu(matrix);
+			DataStructures::ArrayList<size_t> pivots;
+			ESSENTIALS_CHECK(lu.decomposeLU(pivots));
+			Math::Matrix<T> x = lu.solveLU(pivots, rhs);
+			Math::Matrix<T> residual = Math::Matrix<T>(matrix * x) - rhs;
+			Math::Matrix<T> cholesky(symmetric);
+			ESSENTIALS_CHECK(cholesky.decomposeCholesky());
+			Math::Matrix<T> y = cholesky.solveCholesky(rhs);
+			Math::Matrix<T> symmetricResidual = Math::Matrix<T>(symmetric * y) - rhs;
+			bool small = true;
+			for (size_t i = 0; i < size * 3; i++)
+				small = small && std::abs(residual.data()[i]) < tolerance && std::abs(symmetricResidual.data()[i]) < tolerance;
+			ESSENTIALS_CHECK(small);
+
+			// A zero column stays zero through the elimination, so its pivot is exactly zero
+			Math::Matrix<T> singular(matrix);
+			for (size_t i = 0; i < size; i++)
+				singular(i, size / 2) = T();
+			ESSENTIALS_CHECK(!singular.decomposeLU(pivots));
+			ESSENTIALS_CHECK(Math::Matrix<T>(singular).determinant() == T());
+
+			// Flipping the sign of one diagonal element of a diagonal dominant symmetric matrix makes it indefinite
+			Math::Matrix<T> indefinite(symmetric);
+			indefinite(size - 1, size - 1) = -indefinite(size - 1, size - 1);
+			ESSENTIALS_CHECK(!indefinite.decomposeCholesky());
+		}
+
+		// Dependent rows are found exactly with small integers
+		Math::Matrix<T> dependent = { { 1, 2, 3 }, { 2, 4, 6 }, { 1, 1, 1 } };
+		DataStructures::ArrayList<size_t> pivots;
+		ESSENTIALS_CHECK(!dependent.decomposeLU(pivots));
+		Math::Matrix<T> semidefinite = { { 1, 1 }, { 1, 1 } };
+		ESSENTIALS_CHECK(!semidefinite.decomposeCholesky());
+		Math::Matrix<T> negative = { { -4 } };
+		ESSENTIALS_CHECK(!negative.decomposeCholesky());
+		Math::Matrix<T> notANumber = { { std::numeric_limits<T>::quiet_NaN() } };
+		ESSENTIALS_CHECK(!notANumber.decomposeCholesky());
+	}
+
+	/**
+	 * Converts a fixed size matrix to a dynamic one
+	 * @param matrix The matrix
+	 * @returns The dynamic copy
+	 */
+	template<typename T, size_t R, size_t C> Math::Matrix<T> dynamicCopy(const Math::Matrix<T, R, C>& matrix) {
+		Math::Matrix<T> result(R, C);
+		for (size_t i = 0; i < R; i++)
+			for (size_t j = 0; j < C; j++)
+				result(i, j) = matrix(i, j);
+		return result;
+	}
+
+	/**
+	 * Fixed size products (SSE for 4x4 floats), determinants and inverses against the dynamic matrices
+	 */
+	template<typename T, size_t N> void fixedSize() {
+		std::mt19937 random(6);
+		T tolerance = std::numeric_limits<T>::epsilon() * 64;
+		bool matching = true;
+		for (int trial = 0; trial < 1000; trial++) {
+			Math::Matrix<T, N, N> a;
+			Math::Matrix<T, N, N> b;
+			for (size_t i = 0; i < N; i++)
+				for (size_t j = 0; j < N; j++) {
+					a(i, j) = static_cast<T>(std::uniform_real_distribution<double>(-1, 1)(random));
+					b(i, j) = static_cast<T>(std::uniform_real_distribution<double>(-1, 1)(random));
+				}
+			Math::Matrix<T, N, N> product = a * b;
+			matching = matching && closeToProduct(dynamicCopy(a), dynamicCopy(b), Math::Matrix<T>(N, N), dynamicCopy(product));
+
+			T determinant = a.determinant();
+			T expected = dynamicCopy(a).determinant();
+			matching = matching && std::abs(determinant - expected) <= tolerance;
+
+			Math::Matrix<T, N, N> inverse;
+			if (std::abs(determinant) > T(0.01) && a.inverse(inverse)) {
+				Math::Matrix<T, N, N> identity = a * inverse;
+				for (size_t i = 0; i < N; i++)
+					for (size_t j = 0; j < N; j++)
+						matching = matching && std::abs(identity(i, j) - (i == j ? T(1) : T(0))) <= tolerance / std::abs(determinant);
+			}
+		}
+		ESSENTIALS_CHECK(matching);
+
+		// A repeated row has no inverse and a zero determinant
+		Math::Matrix<T, N, N> singular = Math::Matrix<T, N, N>::identity();
+		for (size_t j = 0; j < N; j++)
+			singular(N - 1, j) = singular(0, j);
+		Math::Matrix<T, N, N> inverse;
+		ESSENTIALS_CHECK(!singular.inverse(inverse));
+		ESSENTIALS_CHECK(singular.determinant() == T());
+	}
+
+	/**
+	 * The fixed size operations are usable in constant expressions (where 4x4 float products skip SSE)
+	 */
+	void constantExpressions() {
+		constexpr Math::Matrix2d rotate(0.0, -1.0, 1.0, 0.0);
+		static_assert(rotate * rotate == -Math::Matrix2d::identity());
+		static_assert(rotate.determinant() == 1.0);
+		static_assert(rotate.transposed() * rotate == Math::Matrix2d::identity());
+
+		constexpr Math::Matrix3d scale(2.0, 0.0, 0.0, 0.0, 4.0, 0.0, 1.0, 0.0, 8.0);
+		static_assert(scale.determinant() == 64.0);
+		constexpr Math::Matrix3d inverse = [&]() {
+			Math::Matrix3d result;
+			scale.inverse(result);
+			return result;
+		}();
+		static_assert(inverse * scale == Math::Matrix3d::identity());
+
+		constexpr Math::Matrix4f translate(1.0f, 0.0f, 0.0f, 3.0f, 0.0f, 1.0f, 0.0f, 4.0f, 0.0f, 0.0f, 1.0f, 5.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+		constexpr Math::Matrix4f twice = translate * translate;
+		static_assert(twice(0, 3) == 6.0f && twice(1, 3) == 8.0f && twice(2, 3) == 10.0f && twice(3, 3) == 1.0f);
+		static_assert(translate.determinant() == 1.0f);
+		static_assert((Math::Matrix<int, 2, 3>(1, 2, 3, 4, 5, 6) * Math::Matrix<int, 3, 2>(1, 0, 0, 1, 1, 1)) == Math::Matrix<int, 2, 2>(4, 5, 10, 11));
+
+		// The same product at runtime goes through SSE
+		Math::Matrix4f runtime = translate;
+		ESSENTIALS_CHECK(runtime * runtime == twice);
+	}
+}
+
+int main() {
+	for (size_t threads : { size_t(0), size_t(3) }) {
+		Threading::ThreadPool pool(threads);
+		gemmSizes<float>(pool);
+		gemmSizes<double>(pool);
+		gemmSizes<int>(pool);
+	}
+	productExpressions<float>();
+	productExpressions<double>();
+	decompositions<float>();
+	decompositions<double>();
+	fixedSize<float, 2>();
+	fixedSize<float, 3>();
+	fixedSize<float, 4>();
+	fixedSize<double, 2>();
+	fixedSize<double, 3>();
+	fixedSize<double, 4>();
+	constantExpressions();
+	return Tests::result();
+}
\ No newline at end of file
@@ -0,0 +1,273 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "DataStructures/ArrayList.h"
+#include "Threading/Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * Sizes around the automatic grain (1024 elements per chunk at least), the sort's first split into runs (8192) and the
+	 * size above which merges are split into tasks (32768)
+	 */
+	const size_t sizes[] = {0, 1, 2, 1023, 1024, 1025, 4097, 8191, 8192, 8193, 20479, 20481, 32769, 65537, 300001};
+
+	/**
+	 * Makes a list of random values with many duplicates
+	 * @param count The number of values
+	 * @param seed The seed of the values
+	 * @returns The values
+	 */
+	DataStructures::ArrayList<int> randomValues(size_t count, uint32_t seed) {
+		std::mt19937 random(seed);
+		DataStructures::ArrayList<int> values;
+		for (size_t i = 0; i < count; i++)
+			values.push(static_cast<int>(random() % (count / 2 + 1)));
+		return values;
+	}
+
+	/**
+	 * parallelFor calls the body over every index exactly once, with automatic and explicit grains
+	 * @param pool The pool to run on
+	 */
+	void forCoversEveryIndex(Threading::ThreadPool& pool) {
+		for (size_t count : sizes) {
+			for (size_t grain : {size_t(0), size_t(1), size_t(7), size_t(5000)}) {
+				if (grain == 1 && count > 20000) continue;
+				std::vector<std::atomic<int>> visits(count + 3);
+				Threading::parallelFor(3, count + 3, [&](size_t begin, size_t end) {
+					for (size_t i = begin; i < end; i++)
+						visits[i].fetch_add(1, std::memory_order_relaxed);
+				}, grain, pool);
+				bool once = visits[0] == 0 && visits[1] == 0 && visits[2] == 0;
+				for (size_t i = 3; i < count + 3; i++)
+					once = once && visits[i] == 1;
+				ESSENTIALS_CHECK(once);
+			}
+		}
+	}
+
+	/**
+	 * parallelForEach, parallelMap and parallelReduce agree with the serial loops, order included
+	 * @param pool The pool to run on
+	 */
+	void mapAndReduce(Threading::ThreadPool& pool) {
+		for (size_t count : sizes) {
+			DataStructures::ArrayList<int> values = randomValues(count, static_cast<uint32_t>(count));
+
+			DataStructures::ArrayList<int> doubled = values;
+			Threading::parallelForEach(doubled, [](int& value) { value *= 2; }, pool);
+			bool matching = doubled.length() == count;
+			for (size_t i = 0; i < count && matching; i++)
+				matching = doubled[i] == values[i] * 2;
+			ESSENTIALS_CHECK(matching);
+
+			DataStructures::ArrayList<std::string> strings = Threading::parallelMap(values, [](int value) { return std::to_string(value); }, pool);
+			matching = strings.length() == count;
+			for (size_t i = 0; i < count && matching; i++)
+				matching = strings[i] == std::to_string(values[i]);
+			ESSENTIALS_CHECK(matching);
+
+			long long sum = Threading::parallelReduce(values, 0LL, std::plus<>(), pool);
+			ESSENTIALS_CHECK(sum == std::accumulate(values.begin(), values.end(), 0LL));
+			int largest = Threading::parallelReduce(values, -1, [](int a, int b) { return a > b ? a : b; }, pool);
+			ESSENTIALS_CHECK(largest == (count == 0 ? -1 : *std::max_element(values.begin(), values.end())));
+
+			// Concatenation is associative but not commutative, so the chunks have to be combined in order
+			if (count <= 65537) {
+				std::string serial;
+				for (size_t i = 0; i < count; i++)
+					serial += static_cast<char>('a' + values[i] % 26);
+				DataStructures::ArrayList<std::string> letters;
+				for (size_t i = 0; i < count; i++)
+					letters.push(std::string(1, static_cast<char>('a' + values[i] % 26)));
+				std::string joined = Threading::parallelReduce(letters, std::string(), [](std::string a, const std::string& b) {
+					a += b;
+					return a;
+				}, pool);
+				ESSENTIALS_CHECK(joined == serial);
+			}
+		}
+	}
+
+	/**
+	 * The parallel searches give the first and last matches the serial searches give, with matches at chunk boundaries
+	 * @param pool The pool to run on
+	 */
+	void searches(Threading::ThreadPool& pool) {
+		for (size_t count : sizes) {
+			DataStructures::ArrayList<int> values;
+			for (size_t i = 0; i < count; i++)
+				values.push(0);
+			ESSENTIALS_CHECK(Threading::parallelIndexOf(values, 1, pool) == -1);
+			ESSENTIALS_CHECK(Threading::parallelLastIndexOf(values, 1, pool) == -1);
+			ESSENTIALS_CHECK(!Threading::parallelContains(values, 1, pool));
+
+			std::vector<size_t> places = {0, count / 3, count / 2, count - 1, 1023, 1024, 1025, 4096, 8191, 8192};
+			for (size_t first = 0; first < places.size(); first++) {
+				for (size_t second = first; second < places.size(); second++) {
+					if (places[first] >= count || places[second] >= count) continue;
+					values[places[first]] = 1;
+					values[places[second]] = 1;
+					int serialFirst = static_cast<int>(std::find(values.begin(), values.end(), 1) - values.begin());
+					int serialLast = static_cast<int>(count - 1 - (std::find(std::make_reverse_iterator(values.end()), std::make_reverse_iterator(values.begin()), 1) - std::make_reverse_iterator(values.end())));
+					ESSENTIALS_CHECK(Threading::parallelIndexOf(values, 1, pool) == serialFirst);
+					ESSENTIALS_CHECK(Threading::parallelLastIndexOf(values, 1, pool) == serialLast);
+					ESSENTIALS_CHECK(Threading::parallelFind(values, [](int value) { return value != 0; }, pool) == serialFirst);
+					ESSENTIALS_CHECK(Threading::parallelFindLast(values, [](int value) { return value != 0; }, pool) == serialLast);
+					ESSENTIALS_CHECK(Threading::parallelContains(values, 1, pool));
+					values[places[first]] = 0;
+					values[places[second]] = 0;
+				}
+			}
+		}
+	}
+
+	/**
+	 * parallelSort gives what std::sort gives, for duplicates, a custom order and elements that are not trivially copyable
+	 * @param pool The pool to run on
+	 */
+	void sorting(Threading::ThreadPool& pool) {
+		for (size_t count : sizes) {
+			DataStructures::ArrayList<int> values = randomValues(count, static_cast<uint32_t>(count) + 1);
+			std::vector<int> expected(values.begin(), values.end());
+			std::sort(expected.begin(), expected.end());
+			Threading::parallelSort(values, std::less<>(), pool);
+			ESSENTIALS_CHECK(std::equal(values.begin(), values.end(), expected.begin(), expected.end()));
+
+			Threading::parallelSort(values, std::greater<>(), pool);
+			std::reverse(expected.begin(), expected.end());
+			ESSENTIALS_CHECK(std::equal(values.begin(), values.end(), expected.begin(), expected.end()));
+
+			if (count > 70000) continue;
+			DataStructures::ArrayList<std::string> strings;
+			for (int value : values)
+				strings.push("value " + std::to_string(value));
+			std::vector<std::string> expectedStrings(strings.begin(), strings.end());
+			std::sort(expectedStrings.begin(), expectedStrings.end());
+			Threading::parallelSort(strings, std::less<>(), pool);
+			ESSENTIALS_CHECK(std::equal(strings.begin(), strings.end(), expectedStrings.begin(), expectedStrings.end()));
+		}
+	}
+
+	/**
+	 * An owner pushing and popping while thieves steal hands out every item exactly once, through ring growth
+	 */
+	void dequeStealing() {
+		const size_t count = 200000;
+		std::vector<int> items(count);
+		std::vector<std::atomic<int>> taken(count);
+		Threading::WorkStealingDeque<int> deque(4);
+		std::atomic<bool> done(false);
+		std::vector<std::thread> thieves;
+		for (size_t t = 0; t < 3; t++) {
+			thieves.emplace_back([&] {
+				while (!done.load() || !deque.empty()) {
+					int* item = deque.steal();
+					if (item != nullptr)
+						taken[item - items.data()].fetch_add(1);
+				}
+			});
+		}
+		for (size_t i = 0; i < count; i++) {
+			deque.push(&items[i]);
+			// Pop every third push so the owner races the thieves for the last item
+			if (i % 3 == 0) {
+				int* item = deque.pop();
+				if (item != nullptr)
+					taken[item - items.data()].fetch_add(1);
+			}
+		}
+		int* item;
+		while ((item = deque.pop()) != nullptr)
+			taken[item - items.data()].fetch_add(1);
+		done = true;
+		for (std::thread& thief : thieves)
+			thief.join();
+		bool once = true;
+		for (size_t i = 0; i < count; i++)
+			once = once && taken[i] == 1;
+		ESSENTIALS_CHECK(once);
+	}
+
+	/**
+	 * Sums a range by splitting it into tasks which wait on their own groups, so workers wait inside tasks
+	 * @param begin The first number
+	 * @param end One past the last number
+	 * @param pool The pool to run on
+	 * @returns The sum of the numbers
+	 */
+	long long nestedSum(long long begin, long long end, Threading::ThreadPool& pool) {
+		if (end - begin <= 64) {
+			long long sum = 0;
+			for (long long i = begin; i < end; i++)
+				sum += i;
+			return sum;
+		}
+		long long middle = begin + (end - begin) / 2;
+		long long upper = 0;
+		Threading::TaskGroup group;
+		pool.submit(group, [&] { upper = nestedSum(middle, end, pool); });
+		long long lower = nestedSum(begin, middle, pool);
+		pool.wait(group);
+		return lower + upper;
+	}
+
+	/**
+	 * Waiting on a group from inside a task runs other tasks instead of blocking, so nested parallelism finishes
+	 * @param pool The pool to run on
+	 */
+	void nestedWaits(Threading::ThreadPool& pool) {
+		ESSENTIALS_CHECK(nestedSum(0, 100000, pool) == 100000LL * 99999 / 2);
+
+		std::vector<std::atomic<int>> visits(64 * 4096);
+		Threading::parallelFor(0, 64, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				Threading::parallelFor(i * 4096, (i + 1) * 4096, [&](size_t innerBegin, size_t innerEnd) {
+					for (size_t j = innerBegin; j < innerEnd; j++)
+						visits[j].fetch_add(1, std::memory_order_relaxed);
+				}, 256, pool);
+			}
+		}, 1, pool);
+		bool once = true;
+		for (std::atomic<int>& visit : visits)
+			once = once && visit == 1;
+		ESSENTIALS_CHECK(once);
+	}
+}
+
+int main() {
+	for (size_t threads : {size_t(1), size_t(4)}) {
+		Threading::ThreadPool pool(threads);
+		forCoversEveryIndex(pool);
+		mapAndReduce(pool);
+		searches(pool);
+		sorting(pool);
+		nestedWaits(pool);
+	}
+	dequeStealing();
+	return Tests::result();
+}
\ No newline at end of file
@@ -0,0 +1,346 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "Files/File.h"
+#include "Files/RecordReader.h"
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * A record and the file offset just past its delimiter
+	 */
+	struct Record {
+		std::string text;
+		size_t next;
+
+		bool operator==(const Record& other) const {
+			return text == other.text && next == other.next;
+		}
+	};
+
+	/**
+	 * The ways a file can be opened for a reader
+	 */
+	enum class Source {
+		mapped,
+		pread,
+		pipe
+	};
+
+	/**
+	 * Splits a text into records the simple way, for comparing readers against
+	 * @param text The text
+	 * @param delimiter The byte records end at
+	 * @param trimCarriageReturn Whether or not a \r before a delimiter (or the end) is dropped
+	 * @param begin Only records starting at or after this offset are kept
+	 * @param end Only records starting before this offset are kept
+	 * @returns The records
+	 */
+	std::vector<Record> referenceSplit(const std::string& text, char delimiter, bool trimCarriageReturn, size_t begin = 0, size_t end = static_cast<size_t>(-1)) {
+		std::vector<Record> records;
+		size_t start = 0;
+		while (start < text.size()) {
+			size_t stop = text.find(delimiter, start);
+			size_t next = stop == std::string::npos ? text.size() : stop + 1;
+			if (stop == std::string::npos)
+				stop = text.size();
+			size_t length = stop - start;
+			if (trimCarriageReturn && length > 0 && text[stop - 1] == '\r')
+				length--;
+			if (start >= begin && start < end)
+				records.push_back({text.substr(start, length), next});
+			start = next;
+		}
+		return records;
+	}
+
+	/**
+	 * Gets the path of a scratch file
+	 * @returns The path
+	 */
+	std::string scratchPath() {
+		const char* directory = std::getenv("TMPDIR");
+		return std::string(directory != nullptr ? directory : "/tmp") + "/essentials-record-reader-test";
+	}
+
+	/**
+	 * Writes a text to the scratch file
+	 * @param text The text
+	 */
+	void writeScratch(const std::string& text) {
+		Files::File file(scratchPath().c_str(), Files::FileMode::create, Files::FileOptions{false});
+		ESSENTIALS_CHECK(file.write(0, text.data(), text.size()) == text.size());
+	}
+
+	/**
+	 * Reads the records of a range of a file
+	 * @param file The file
+	 * @param delimiter The byte records end at
+	 * @param range The range
+	 * @param options The options of the reader
+	 * @returns The records
+	 */
+	std::vector<Record> readRecords(Files::File& file, char delimiter, Files::FileRange range, const Files::RecordOptions& options) {
+		Files::RecordReader reader(file, delimiter, range, options);
+		std::vector<Record> records;
+		Strings::StringView record;
+		while (reader.next(record))
+			records.push_back({std::string(record.data(), record.length()), reader.offset()});
+		ESSENTIALS_CHECK(reader.error() == 0);
+		ESSENTIALS_CHECK(!reader.next(record));
+		return records;
+	}
+
+	/**
+	 * Reads every record of a text written to the scratch file or sent down a pipe
+	 * @param text The text
+	 * @param source How the file is opened
+	 * @param delimiter The byte records end at
+	 * @param options The options of the reader
+	 * @returns The records
+	 */
+	std::vector<Record> readText(const std::string& text, Source source, char delimiter, const Files::RecordOptions& options) {
+		if (source != Source::pipe) {
+			writeScratch(text);
+			Files::File file(scratchPath().c_str(), Files::FileMode::read, Files::FileOptions{source == Source::mapped});
+			ESSENTIALS_CHECK(file.mapped() == (source == Source::mapped && !text.empty()));
+			return readRecords(file, delimiter, Files::FileRange(), options);
+		}
+		int ends[2];
+		ESSENTIALS_CHECK(::pipe(ends) == 0);
+		Files::File file;
+		ESSENTIALS_CHECK(file.open(("/dev/fd/" + std::to_string(ends[0])).c_str()));
+		::close(ends[0]);
+		std::thread writer([&text, end = ends[1]] {
+			size_t written = 0;
+			while (written < text.size()) {
+				ssize_t put = ::write(end, text.data() + written, text.size() - written);
+				if (put <= 0) break;
+				written += static_cast<size_t>(put);
+			}
+			::close(end);
+		});
+		std::vector<Record> records = readRecords(file, delimiter, Files::FileRange(), options);
+		file.close();
+		writer.join();
+		return records;
+	}
+
+	/**
+	 * Makes a random text of records of mixed lengths, some empty, some longer than a chunk, some ending with \r
+	 * @param random The random number generator
+	 * @param delimiter The byte records end at
+	 * @param longest The longest record
+	 * @returns The text
+	 */
+	std::string randomText(std::mt19937& random, char delimiter, size_t longest) {
+		std::string text;
+		size_t records = random() % 200;
+		for (size_t i = 0; i < records; i++) {
+			size_t kind = random() % 10;
+			size_t length = kind == 0 ? 0 : kind < 8 ? random() % 80 : random() % (longest + 1);
+			for (size_t j = 0; j < length; j++) {
+				char character = static_cast<char>('a' + random() % 26);
+				text += character == delimiter ? 'z' : character;
+			}
+			if (random() % 4 == 0)
+				text += '\r';
+			text += delimiter;
+		}
+		// Sometimes the last record has no delimiter after it
+		size_t last = random() % 6;
+		if (last < 2)
+			text += last == 0 ? "last" : "last\r";
+		return text;
+	}
+
+	/**
+	 * Random texts read from mapped files, with pread (with and without prefetching) and from pipes, with several chunk
+	 * sizes, delimiters and carriage return trimming, checked against the reference splitter
+	 */
+	void againstReference() {
+		std::mt19937 random(25);
+		const char delimiters[] = {'\n', '\0', '|', ','};
+		bool matching = true;
+		for (size_t trial = 0; trial < 120; trial++) {
+			char delimiter = delimiters[trial % 4];
+			Files::RecordOptions options;
+			options.chunkSize = trial % 3 == 0 ? 64 : trial % 3 == 1 ? 100 : 4096;
+			options.trimCarriageReturn = trial % 2 == 0;
+			std::string text = randomText(random, delimiter, options.chunkSize * 3);
+			std::vector<Record> expected = referenceSplit(text, delimiter, options.trimCarriageReturn);
+			for (Source source : {Source::mapped, Source::pread, Source::pipe}) {
+				for (bool prefetch : {true, false}) {
+					options.prefetch = prefetch;
+					matching = matching && readText(text, source, delimiter, options) == expected;
+				}
+			}
+		}
+		ESSENTIALS_CHECK(matching);
+	}
+
+	/**
+	 * Records ending just before, on and just after the end of a chunk, and a delimiter as the first byte of a chunk
+	 */
+	void chunkBoundaries() {
+		const size_t chunk = 128;
+		Files::RecordOptions options;
+		options.chunkSize = chunk;
+		bool matching = true;
+		for (size_t first = chunk - 3; first <= chunk + 3; first++) {
+			for (size_t second : {static_cast<size_t>(0), static_cast<size_t>(1), chunk - 1, chunk, chunk + 1}) {
+				std::string text = std::string(first - 1, 'a') + "\n" + std::string(second, 'b') + "\n" + std::string(5, 'c');
+				std::vector<Record> expected = referenceSplit(text, '\n', false);
+				for (Source source : {Source::mapped, Source::pread, Source::pipe})
+					matching = matching && readText(text, source, '\n', options) == expected;
+			}
+		}
+		ESSENTIALS_CHECK(matching);
+
+		// A \r\n pair split across two chunks is still trimmed
+		options.trimCarriageReturn = true;
+		std::string text = std::string(chunk - 1, 'a') + "\r\n" + "b\r\n";
+		std::vector<Record> expected = {{std::string(chunk - 1, 'a'), chunk + 1}, {"b", chunk + 4}};
+		ESSENTIALS_CHECK(readText(text, Source::pread, '\n', options) == expected);
+		ESSENTIALS_CHECK(readText(text, Source::pipe, '\n', options) == expected);
+	}
+
+	/**
+	 * Records many chunks long go through the spill buffer, including several in a row and one at the end of the file
+	 */
+	void spill() {
+		Files::RecordOptions options;
+		options.chunkSize = 64;
+		std::string huge(64 * 10 + 7, 'h');
+		std::string text = "short\n" + huge + "\n" + huge + huge + "\nx\n\n" + huge;
+		std::vector<Record> expected = referenceSplit(text, '\n', false);
+		ESSENTIALS_CHECK(expected.size() == 6);
+		for (Source source : {Source::mapped, Source::pread, Source::pipe})
+			for (bool prefetch : {true, false}) {
+				options.prefetch = prefetch;
+				ESSENTIALS_CHECK(readText(text, source, '\n', options) == expected);
+			}
+
+		// A chunk size below 64 is raised to 64
+		options.chunkSize = 1;
+		ESSENTIALS_CHECK(readText(text, Source::pread, '\n', options) == expected);
+	}
+
+	/**
+	 * Readers over the ranges from split(), or over any cut of the file into ranges, give every record exactly once
+	 */
+	void splitRanges() {
+		std::mt19937 random(3);
+		bool matching = true;
+		for (size_t trial = 0; trial < 40; trial++) {
+			char delimiter = trial % 2 == 0 ? '\n' : ';';
+			Files::RecordOptions options;
+			options.chunkSize = trial % 4 < 2 ? 64 : 1024;
+			options.trimCarriageReturn = trial % 3 == 0;
+			std::string text = randomText(random, delimiter, 300);
+			std::vector<Record> expected = referenceSplit(text, delimiter, options.trimCarriageReturn);
+			writeScratch(text);
+			for (bool map : {true, false}) {
+				Files::File file(scratchPath().c_str(), Files::FileMode::read, Files::FileOptions{map});
+				for (size_t parts : {2, 3, 7, 64}) {
+					DataStructures::ArrayList<Files::FileRange> ranges = Files::RecordReader::split(file, parts, 1 + trial % 5);
+					ESSENTIALS_CHECK(ranges.length() >= 1 && ranges[0].begin == 0 && ranges[ranges.length() - 1].end == static_cast<size_t>(-1));
+					std::vector<Record> found;
+					for (size_t i = 0; i < ranges.length(); i++) {
+						matching = matching && (i == 0 || ranges[i].begin == ranges[i - 1].end);
+						std::vector<Record> part = readRecords(file, delimiter, ranges[i], options);
+						found.insert(found.end(), part.begin(), part.end());
+					}
+					matching = matching && found == expected;
+				}
+
+				// Random cuts, including empty ranges and cuts on delimiters
+				std::vector<size_t> cuts = {0, text.size()};
+				for (size_t i = 0; i < 6; i++)
+					cuts.push_back(random() % (text.size() + 1));
+				std::sort(cuts.begin(), cuts.end());
+				std::vector<Record> found;
+				for (size_t i = 0; i + 1 < cuts.size(); i++) {
+					std::vector<Record> part = readRecords(file, delimiter, {cuts[i], cuts[i + 1]}, options);
+					matching = matching && part == referenceSplit(text, delimiter, options.trimCarriageReturn, cuts[i], cuts[i + 1]);
+					found.insert(found.end(), part.begin(), part.end());
+				}
+				matching = matching && found == expected;
+			}
+		}
+		ESSENTIALS_CHECK(matching);
+
+		// Small files are not split
+		writeScratch("a\nb\n");
+		Files::File small(scratchPath().c_str(), Files::FileMode::read);
+		ESSENTIALS_CHECK(Files::RecordReader::split(small, 8).length() == 1);
+	}
+
+	/**
+	 * Delimiters other than a newline, including a null byte and one also used as the carriage return
+	 */
+	void delimiters() {
+		Files::RecordOptions options;
+		std::string text("one\0two\0\0three", 14);
+		std::vector<Record> expected = {{"one", 4}, {"two", 8}, {"", 9}, {"three", 14}};
+		for (Source source : {Source::mapped, Source::pread, Source::pipe}) {
+			ESSENTIALS_CHECK(readText(text, source, '\0', options) == expected);
+			ESSENTIALS_CHECK(readText("a,b,,c,", source, ',', options) == std::vector<Record>({{"a", 2}, {"b", 4}, {"", 5}, {"c", 7}}));
+			ESSENTIALS_CHECK(readText("no delimiter", source, ',', options) == std::vector<Record>({{"no delimiter", 12}}));
+			ESSENTIALS_CHECK(readText("", source, ',', options).empty());
+			ESSENTIALS_CHECK(readText(",", source, ',', options) == std::vector<Record>({{"", 1}}));
+		}
+		// Newlines are ordinary bytes when they are not the delimiter
+		ESSENTIALS_CHECK(readText("a\nb|c\n", Source::pread, '|', options) == std::vector<Record>({{"a\nb", 4}, {"c\n", 6}}));
+	}
+
+	/**
+	 * trimCarriageReturn drops only a single \r right before a delimiter or the end of the file
+	 */
+	void carriageReturns() {
+		Files::RecordOptions options;
+		options.trimCarriageReturn = true;
+		for (Source source : {Source::mapped, Source::pread, Source::pipe}) {
+			ESSENTIALS_CHECK(readText("a\r\nb\r\r\n\r\nc\rd\n\r", source, '\n', options) == std::vector<Record>({{"a", 3}, {"b\r", 7}, {"", 9}, {"c\rd", 13}, {"", 14}}));
+			ESSENTIALS_CHECK(readText("x\r\n", source, '\n', options) == std::vector<Record>({{"x", 3}}));
+		}
+		options.trimCarriageReturn = false;
+		ESSENTIALS_CHECK(readText("a\r\nb\r", Source::pread, '\n', options) == std::vector<Record>({{"a\r", 3}, {"b\r", 5}}));
+	}
+}
+
+int main() {
+	// Closing a pipe before the writer is done has to fail its writes rather than kill the test
+	std::signal(SIGPIPE, SIG_IGN);
+	againstReference();
+	chunkBoundaries();
+	spill();
+	splitRanges();
+	delimiters();
+	carriageReturns();
+	std::remove(scratchPath().c_str());
+	return Tests::result();
+}
\ No newline at end of file
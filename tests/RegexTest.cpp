@@ -0,0 +1,303 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "String/Regex.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * Builds a random pattern over the letters a to c that std::regex parses the same way
+	 * @param random The random number generator
+	 * @param depth How many more groups may be nested
+	 * @returns The pattern
+	 */
+	std::string randomPattern(std::mt19937& random, int depth) {
+		std::string pattern;
+		int pieces = 1 + static_cast<int>(random() % 4);
+		for (int piece = 0; piece < pieces; piece++) {
+			int kind = static_cast<int>(random() % 10);
+			bool group = kind < 2 && depth > 0;
+			if (kind == 0 && depth > 0) {
+				pattern += "(" + randomPattern(random, depth - 1) + "|" + randomPattern(random, depth - 1) + ")";
+			} else if (kind == 1 && depth > 0) {
+				pattern += "(" + randomPattern(random, depth - 1) + ")";
+			} else if (kind == 2) {
+				pattern += ".";
+			} else if (kind == 3) {
+				pattern += (random() & 1) ? "[ab]" : "[^a]";
+			} else if (kind == 4) {
+				pattern += "[b-c]";
+			} else {
+				pattern += static_cast<char>('a' + random() % 3);
+			}
+			// Anchors are never quantified since std::regex rejects that, and groups only get bounded quantifiers since std::regex backtracks exponentially on nested stars
+			int quantifier = static_cast<int>(random() % 12);
+			if (group && (quantifier < 2 || quantifier == 5)) quantifier = 2;
+			if (quantifier == 0) pattern += "*";
+			else if (quantifier == 1) pattern += "+";
+			else if (quantifier == 2) pattern += "?";
+			else if (quantifier == 3) pattern += "{1,2}";
+			else if (quantifier == 4) pattern += "{2}";
+			else if (quantifier == 5) pattern += "{0,}";
+		}
+		if (random() % 8 == 0) pattern = "^" + pattern;
+		if (random() % 8 == 0) pattern += "$";
+		if (random() % 10 == 0) pattern += "|" + randomPattern(random, 0);
+		return pattern;
+	}
+
+	/**
+	 * Builds a random text over the letters a to c
+	 * @param random The random number generator
+	 * @returns The text
+	 */
+	std::string randomText(std::mt19937& random) {
+		std::string text(random() % 13, 'a');
+		for (char& character : text)
+			character = static_cast<char>('a' + random() % 3);
+		return text;
+	}
+
+	/**
+	 * Finds the leftmost longest match with std::regex, which only gives leftmost first matches directly
+	 * @param reference The std::regex of the pattern
+	 * @param text The text to search
+	 * @returns The match (not found if there is none)
+	 */
+	Strings::RegexMatch referenceFind(const std::regex& reference, const std::string& text) {
+		Strings::RegexMatch match;
+		std::smatch first;
+		if (!std::regex_search(text, first, reference)) return match;
+		size_t start = static_cast<size_t>(first.position(0));
+		for (size_t end = text.length();; end--) {
+			auto flags = std::regex_constants::match_default;
+			if (start != 0) flags |= std::regex_constants::match_not_bol | std::regex_constants::match_prev_avail;
+			if (end != text.length()) flags |= std::regex_constants::match_not_eol;
+			if (std::regex_match(text.begin() + static_cast<std::ptrdiff_t>(start), text.begin() + static_cast<std::ptrdiff_t>(end), reference, flags)) {
+				match.start = start;
+				match.end = end;
+				return match;
+			}
+		}
+	}
+
+	/**
+	 * Random patterns and texts checked against std::regex for matches, contains and find, with and without case folding
+	 */
+	void againstStdRegex() {
+		std::mt19937 random(21);
+		bool matching = true;
+		for (int trial = 0; trial < 1500 && matching; trial++) {
+			std::string pattern = randomPattern(random, 2);
+			bool caseInsensitive = trial % 5 == 0;
+			// Upper case every letter so class ranges stay ordered
+			if (caseInsensitive)
+				for (char& character : pattern)
+					if (character >= 'a' && character <= 'c') character = static_cast<char>(character - 'a' + 'A');
+
+			Strings::RegexOptions options;
+			options.caseInsensitive = caseInsensitive;
+			Strings::Regex regex(Strings::StringView(pattern.data(), pattern.length()), options);
+			std::regex reference(pattern, caseInsensitive ? std::regex::ECMAScript | std::regex::icase : std::regex::ECMAScript);
+			matching = matching && regex.valid();
+
+			for (int textTrial = 0; textTrial < 20 && matching; textTrial++) {
+				std::string text = randomText(random);
+				Strings::StringView view(text.data(), text.length());
+				matching = matching && regex.matches(view) == std::regex_match(text, reference);
+				matching = matching && regex.contains(view) == std::regex_search(text, reference);
+				Strings::RegexMatch found = regex.find(view);
+				Strings::RegexMatch expected = referenceFind(reference, text);
+				matching = matching && found.start == expected.start && found.end == expected.end;
+				if (!matching)
+					std::fprintf(stderr, "pattern %s text %s\n", pattern.c_str(), text.c_str());
+			}
+		}
+		ESSENTIALS_CHECK(matching);
+	}
+
+	/**
+	 * ^ and $ only match at the ends of the text, also when searching from an offset
+	 */
+	void anchors() {
+		Strings::Regex start("^ab");
+		ESSENTIALS_CHECK(start.contains("abc"));
+		ESSENTIALS_CHECK(!start.contains("cab"));
+		ESSENTIALS_CHECK(start.find("abab").start == 0);
+		ESSENTIALS_CHECK(!start.find("abab", 2).found());
+		ESSENTIALS_CHECK(start.findAll("ababab").length() == 1);
+
+		Strings::Regex end("ab$");
+		ESSENTIALS_CHECK(end.contains("cab"));
+		ESSENTIALS_CHECK(!end.contains("abc"));
+		Strings::RegexMatch match = end.find("ababab");
+		ESSENTIALS_CHECK(match.start == 4 && match.end == 6);
+
+		Strings::Regex both("^a*$");
+		ESSENTIALS_CHECK(both.matches(""));
+		ESSENTIALS_CHECK(both.contains("aaaa"));
+		ESSENTIALS_CHECK(!both.contains("aaba"));
+		match = both.find("");
+		ESSENTIALS_CHECK(match.start == 0 && match.end == 0);
+
+		Strings::Regex inner("a^b|c$d|e");
+		ESSENTIALS_CHECK(!inner.contains("ab"));
+		ESSENTIALS_CHECK(!inner.contains("cd"));
+		ESSENTIALS_CHECK(inner.contains("xe"));
+
+		Strings::Regex alternatives("^a|b$");
+		ESSENTIALS_CHECK(alternatives.contains("ax"));
+		ESSENTIALS_CHECK(alternatives.contains("xb"));
+		ESSENTIALS_CHECK(!alternatives.contains("xax"));
+		ESSENTIALS_CHECK(alternatives.findAll("aab").length() == 2);
+	}
+
+	/**
+	 * A DFA that flushes its cache after every few states must still give the same answers as one that never flushes
+	 */
+	void tinyCache() {
+		const char* patterns[] = {"(a|b)*a(a|b){6}", "[ab]*b[ab]{5}c", "(ab|ba|a{2,4})+b$", "^(a|b|c)*c(a|b){3}"};
+		std::mt19937 random(5);
+		bool matching = true;
+		for (const char* pattern : patterns) {
+			Strings::RegexOptions tiny;
+			tiny.cacheBytes = 1;
+			Strings::Regex flushing(pattern, tiny);
+			Strings::Regex caching(pattern);
+			Strings::RegexSet flushingSet(tiny);
+			flushingSet.add(pattern);
+			flushingSet.add("cc");
+			for (int trial = 0; trial < 200; trial++) {
+				std::string text(1 + random() % 200, 'a');
+				for (char& character : text)
+					character = static_cast<char>('a' + random() % 3);
+				Strings::StringView view(text.data(), text.length());
+				matching = matching && flushing.matches(view) == caching.matches(view);
+				matching = matching && flushing.contains(view) == caching.contains(view);
+				Strings::RegexMatch flushed = flushing.find(view, trial % 7);
+				Strings::RegexMatch cached = caching.find(view, trial % 7);
+				matching = matching && flushed.start == cached.start && flushed.end == cached.end;
+				matching = matching && flushing.findAll(view).length() == caching.findAll(view).length();
+
+				DataStructures::ArrayList<size_t> ids = flushingSet.matches(view);
+				size_t expected = (caching.contains(view) ? 1 : 0) + (text.find("cc") != std::string::npos ? 1 : 0);
+				matching = matching && ids.length() == expected && flushingSet.matchesAny(view) == (expected != 0);
+			}
+		}
+		ESSENTIALS_CHECK(matching);
+	}
+
+	/**
+	 * Invalid patterns report what went wrong and where, and match nothing
+	 */
+	void invalidPatterns() {
+		struct Case {
+			const char* pattern;
+			const char* message;
+			size_t position;
+		};
+		const Case cases[] = {
+			{"ab(c", "missing )", 4},
+			{"abc)", "unmatched )", 3},
+			{"a[bc", "missing ]", 1},
+			{"*a", "nothing to repeat", 0},
+			{"a|+", "nothing to repeat", 2},
+			{"a**", "nested quantifier", 2},
+			{"[z-a]", "invalid class range", 4},
+			{"a{2,1}", "invalid repetition", 5},
+			{"a{x}", "invalid repetition", 2},
+			{"a{5000}", "repetition too large", 6},
+			{"ab\\", "trailing backslash", 3},
+			{"\\xg1", "invalid hex escape", 2},
+			{"\\q", "unsupported escape", 1},
+			{"(?=a)", "unsupported group", 1},
+		};
+		for (const Case& test : cases) {
+			Strings::Regex regex(test.pattern);
+			ESSENTIALS_CHECK(!regex.valid());
+			ESSENTIALS_CHECK(regex.error() != nullptr && std::strcmp(regex.error(), test.message) == 0);
+			ESSENTIALS_CHECK(regex.errorPosition() == test.position);
+			ESSENTIALS_CHECK(!regex.matches(test.pattern) && !regex.contains(test.pattern) && !regex.find(test.pattern).found());
+
+			Strings::RegexSet set;
+			ESSENTIALS_CHECK(!set.add(test.pattern));
+			ESSENTIALS_CHECK(set.length() == 0 && set.errorPosition() == test.position);
+		}
+
+		Strings::Regex valid("a{2,}b");
+		ESSENTIALS_CHECK(valid.valid() && valid.error() == nullptr);
+	}
+
+	/**
+	 * matchesAny and matches agree with checking every pattern on its own, and failed adds leave the set usable
+	 */
+	void regexSet() {
+		const char* patterns[] = {"error", "warn(ing)?", "^\\d+ ", "timeout$", "[A-Z]{3}-\\d{2}"};
+		Strings::RegexSet set;
+		std::vector<Strings::Regex> singles;
+		for (const char* pattern : patterns) {
+			ESSENTIALS_CHECK(set.add(pattern));
+			singles.emplace_back(pattern);
+			ESSENTIALS_CHECK(!set.add("(unclosed"));
+			ESSENTIALS_CHECK(set.error() != nullptr);
+		}
+		ESSENTIALS_CHECK(set.length() == 5);
+
+		const char* texts[] = {"", "all good", "error here", "12 warn", "a timeout", "timeout now", "ABC-12", "abc-12", "42 error timeout", "warning: XYZ-99"};
+		bool matching = true;
+		for (const char* text : texts) {
+			DataStructures::ArrayList<size_t> ids = set.matches(text);
+			std::vector<size_t> expected;
+			for (size_t i = 0; i < singles.size(); i++)
+				if (singles[i].contains(text)) expected.push_back(i);
+			matching = matching && ids.length() == expected.size();
+			for (size_t i = 0; i < expected.size() && matching; i++)
+				matching = matching && ids[i] == expected[i];
+			matching = matching && set.matchesAny(text) == !expected.empty();
+		}
+		ESSENTIALS_CHECK(matching);
+
+		Strings::RegexSet empty;
+		ESSENTIALS_CHECK(!empty.matchesAny("anything"));
+		Strings::RegexSet emptyPattern;
+		emptyPattern.add("");
+		ESSENTIALS_CHECK(emptyPattern.matchesAny(""));
+
+		Strings::RegexOptions options;
+		options.caseInsensitive = true;
+		Strings::RegexSet folded(options);
+		folded.add("error");
+		ESSENTIALS_CHECK(folded.matchesAny("An ERROR occurred"));
+		ESSENTIALS_CHECK(!folded.matchesAny("An err occurred"));
+	}
+}
+
+int main() {
+	againstStdRegex();
+	anchors();
+	tinyCache();
+	invalidPatterns();
+	regexSet();
+	return Tests::result();
+}
\ No newline at end of file
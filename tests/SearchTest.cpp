@@ -0,0 +1,158 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "DataStructures/Search.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * An enum, which is searched through its underlying integer
+	 */
+	enum class Color : uint16_t {
+		red,
+		green,
+		blue
+	};
+
+	/**
+	 * A search function over a range of elements
+	 */
+	template<typename T> using Finder = size_t (*)(const T*, size_t, const T&);
+
+	/**
+	 * Gets every search kernel the machine can run, the dispatching ones first
+	 * @param last Whether to get the kernels finding the last match rather than the first
+	 * @returns The kernels
+	 */
+	template<typename T> std::vector<Finder<T>> kernels(bool last) {
+		std::vector<Finder<T>> found = {last ? &DataStructures::findLast<T> : &DataStructures::findFirst<T>};
+#ifdef ESSENTIALS_SEARCH_SSE2
+		found.push_back(last ? &DataStructures::findLastSse2<T> : &DataStructures::findFirstSse2<T>);
+#endif
+#ifdef ESSENTIALS_SEARCH_AVX2
+		if (DataStructures::cpuSupportsAvx2())
+			found.push_back(last ? &DataStructures::findLastAvx2<T> : &DataStructures::findFirstAvx2<T>);
+#endif
+		return found;
+	}
+
+	/**
+	 * Checks every kernel against a plain loop on one range
+	 * @param data The elements
+	 * @param count The number of elements
+	 * @param item The item to search for
+	 * @returns Whether or not every kernel agreed with the loop
+	 */
+	template<typename T> bool agrees(const T* data, size_t count, const T& item) {
+		size_t first = count, last = count;
+		for (size_t i = 0; i < count; i++) {
+			if (item == data[i]) {
+				if (first == count) first = i;
+				last = i;
+			}
+		}
+		bool matching = true;
+		for (Finder<T> find : kernels<T>(false))
+			matching = matching && find(data, count, item) == first;
+		for (Finder<T> find : kernels<T>(true))
+			matching = matching && find(data, count, item) == last;
+		return matching;
+	}
+
+	/**
+	 * Searches ranges of every length up to a few blocks (so tails shorter than a vector are covered), starting at
+	 * unaligned addresses, with zero, one and two matches at every position
+	 * @param item The item to search for
+	 * @param backgrounds Values that are not equal to the item to fill the ranges with (they share bytes with it where possible)
+	 */
+	template<typename T> void checkType(T item, const std::vector<T>& backgrounds) {
+		constexpr size_t perBlock = 64 / sizeof(T);
+		std::vector<T> buffer(perBlock * 4 + 8);
+		bool matching = true;
+		for (size_t start : {size_t(0), size_t(1), size_t(3)}) {
+			for (size_t count = 0; start + count <= buffer.size(); count++) {
+				T* data = buffer.data() + start;
+				for (size_t i = 0; i < buffer.size(); i++)
+					buffer[i] = backgrounds[i % backgrounds.size()];
+				matching = matching && agrees(data, count, item);
+				for (size_t p = 0; p < count; p++) {
+					data[p] = item;
+					matching = matching && agrees(data, count, item);
+					size_t q = (p * 7 + 3) % count;
+					T previous = data[q];
+					data[q] = item;
+					matching = matching && agrees(data, count, item);
+					data[q] = previous;
+					data[p] = backgrounds[(p + start) % backgrounds.size()];
+				}
+			}
+		}
+		ESSENTIALS_CHECK(matching);
+	}
+
+	/**
+	 * Floating point elements compare like ==, so -0.0 finds 0.0 and NaN finds nothing, not even itself
+	 */
+	template<typename T> void floatingPoint() {
+		constexpr size_t perBlock = 64 / sizeof(T);
+		T nan = std::numeric_limits<T>::quiet_NaN();
+		std::vector<T> data(perBlock * 3 + 5, T(1));
+		bool matching = true;
+		for (size_t p = 0; p < data.size(); p++) {
+			data[p] = T(0);
+			for (Finder<T> find : kernels<T>(false))
+				matching = matching && find(data.data() + 1, data.size() - 1, T(-0.0)) == (p == 0 ? data.size() - 1 : p - 1);
+			for (Finder<T> find : kernels<T>(true))
+				matching = matching && find(data.data(), data.size(), T(-0.0)) == p;
+			data[p] = T(1);
+		}
+		ESSENTIALS_CHECK(matching);
+
+		std::vector<T> nans(perBlock * 3 + 5, nan);
+		for (Finder<T> find : kernels<T>(false))
+			ESSENTIALS_CHECK(find(nans.data(), nans.size(), nan) == nans.size());
+		for (Finder<T> find : kernels<T>(true))
+			ESSENTIALS_CHECK(find(nans.data(), nans.size(), nan) == nans.size());
+		nans[perBlock + 2] = T(2);
+		for (Finder<T> find : kernels<T>(false))
+			ESSENTIALS_CHECK(find(nans.data(), nans.size(), T(2)) == perBlock + 2);
+		for (Finder<T> find : kernels<T>(true))
+			ESSENTIALS_CHECK(find(nans.data(), nans.size(), T(2)) == perBlock + 2);
+	}
+}
+
+int main() {
+	checkType<int8_t>(-1, {0, 127, -128, 1});
+	checkType<char>('\n', {'a', '\r', '\0'});
+	checkType<uint16_t>(0x0101, {0x0100, 0x0001, 0x1010, 0xFFFF});
+	checkType<int32_t>(-7, {7, 0, -8, 0x7FFFFFF9});
+	checkType<float>(2.5f, {1.0f, -2.5f, 2.5000002f});
+	// 64 bit lanes that match in one 32 bit half but not the other (SSE2 compares the halves separately)
+	checkType<uint64_t>(0x0000000100000000ull, {0, 0x00000001FFFFFFFFull, 0xFFFFFFFF00000000ull, 0x0000000200000000ull});
+	checkType<int64_t>(-1, {0x00000000FFFFFFFFll, static_cast<int64_t>(0xFFFFFFFF00000000ull), 1});
+	checkType<double>(0.1, {0.2, -0.1, 0.30000000000000004});
+	checkType<Color>(Color::blue, {Color::red, Color::green});
+	int targets[3];
+	checkType<int*>(&targets[1], {&targets[0], &targets[2], nullptr});
+	floatingPoint<float>();
+	floatingPoint<double>();
+	return Tests::result();
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "String/String.h"
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * The target and replacement of replace may both be views of the string being changed
+	 */
+	void replaceAliased() {
+		Strings::String target("abab");
+		ESSENTIALS_CHECK(target.replace(target.substring(0, 2), "xy") == 2);
+		ESSENTIALS_CHECK(target.view() == "xyxy");
+
+		Strings::String replacement("abcd");
+		ESSENTIALS_CHECK(replacement.replace("ab", replacement.substring(2, 2)) == 1);
+		ESSENTIALS_CHECK(replacement.view() == "cdcd");
+
+		Strings::String both("abab and more text to leave the inline buffer");
+		ESSENTIALS_CHECK(both.replace(both.substring(0, 2), both.substring(2, 2)) == 2);
+		ESSENTIALS_CHECK(both.view() == "abab and more text to leave the inline buffer");
+
+		Strings::String longer("a-a-a");
+		ESSENTIALS_CHECK(longer.replace(longer.substring(0, 1), longer.substring(0, 2)) == 3);
+		ESSENTIALS_CHECK(longer.view() == "a--a--a-");
+
+		Strings::String plain("one two one");
+		ESSENTIALS_CHECK(plain.replace("one", "six") == 2);
+		ESSENTIALS_CHECK(plain.view() == "six two six");
+	}
+
+	/**
+	 * Appending a view of the string itself must survive the buffer growing underneath it
+	 */
+	void appendAliased() {
+		Strings::String text("0123456789");
+		std::string expected("0123456789");
+		for (int round = 0; round < 8; round++) {
+			text.append(text.view());
+			expected += expected;
+			text.append(text.substring(1, 3));
+			expected += expected.substr(1, 3);
+		}
+		ESSENTIALS_CHECK(text.view() == Strings::StringView(expected.data(), expected.length()));
+
+		Strings::String other("abc");
+		other.append(text.substring(0, 40));
+		ESSENTIALS_CHECK(other.view() == Strings::StringView(("abc" + expected.substr(0, 40)).c_str()));
+	}
+}
+
+int main() {
+	replaceAliased();
+	appendAliased();
+	return Tests::result();
+}
\ No newline at end of file
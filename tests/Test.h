@@ -0,0 +1,62 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdio>
+
+/**
+ * Checks a condition, reporting the file and line if it doesn't hold
+ * @param condition The condition which should be true
+ */
+#define ESSENTIALS_CHECK(condition) \
+	Essentials::Tests::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+/**
+ * The namespace for the tests of the essentials library
+ */
+namespace Essentials::Tests {
+
+	/**
+	 * Gets the number of failed checks so far
+	 * @returns The number of failures
+	 */
+	inline int& failures() {
+		static int count = 0;
+		return count;
+	}
+
+	/**
+	 * Records the result of a check (used by ESSENTIALS_CHECK)
+	 * @param passed Whether or not the check passed
+	 * @param text The source text of the condition
+	 * @param file The file the check is in
+	 * @param line The line the check is on
+	 */
+	inline void check(bool passed, const char* text, const char* file, int line) {
+		if (passed) return;
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, text);
+		failures()++;
+	}
+
+	/**
+	 * Gets the exit code of a test executable
+	 * @returns 0 if every check passed, 1 otherwise
+	 */
+	inline int result() {
+		return failures() == 0 ? 0 : 1;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,339 @@
+/*
+   Copyright 2021 Rishi Challa
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "Test.h"
+#include "Math/Vector.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Essentials;
+
+namespace {
+	/**
+	 * Checks if two values are the same, bit for bit (any two NaNs count as the same)
+	 * @param a The first value
+	 * @param b The second value
+	 * @returns Whether or not they are the same
+	 */
+	template<typename T> bool same(T a, T b) {
+		if (std::isnan(a) && std::isnan(b)) return true;
+		return std::memcmp(&a, &b, sizeof(T)) == 0;
+	}
+
+	/**
+	 * Checks if a value is within a few roundings of a reference
+	 * @param value The value
+	 * @param expected The reference
+	 * @param magnitude The size of the terms the reference was computed from
+	 * @returns Whether or not the value is close enough
+	 */
+	template<typename T> bool close(T value, long double expected, long double magnitude) {
+		return std::abs(value - expected) <= magnitude * 8 * std::numeric_limits<T>::epsilon();
+	}
+
+	/**
+	 * Makes a random value, sometimes a special one (signed zeros, infinities, NaN, denormals and equal pairs)
+	 * @param random The random number generator
+	 * @returns The value
+	 */
+	template<typename T> T value(std::mt19937& random) {
+		switch (random() % 16) {
+			case 0: return T(0);
+			case 1: return -T(0);
+			case 2: return std::numeric_limits<T>::infinity();
+			case 3: return -std::numeric_limits<T>::infinity();
+			case 4: return std::numeric_limits<T>::quiet_NaN();
+			case 5: return std::numeric_limits<T>::denorm_min() * T(random() % 100);
+			case 6: return T(1);
+			default: return static_cast<T>(std::uniform_real_distribution<double>(-100, 100)(random));
+		}
+	}
+
+	/**
+	 * Every operation of a native pack against the single lane pack applied to each lane
+	 */
+	template<typename T, size_t Width> void packAgainstScalar() {
+		using Pack = Math::SimdPack<T, Width>;
+		using Scalar = Math::SimdPack<T>;
+		if constexpr (Pack::native) {
+			std::mt19937 random(static_cast<unsigned>(Width * sizeof(T)));
+			bool matching = true;
+			for (int trial = 0; trial < 20000; trial++) {
+				T a[Width], b[Width], c[Width], out[Width];
+				for (size_t i = 0; i < Width; i++) {
+					a[i] = value<T>(random);
+					b[i] = random() % 8 == 0 ? a[i] : value<T>(random);
+					c[i] = value<T>(random);
+				}
+				auto lanewise = [&](typename Pack::Register result, auto scalar) {
+					Pack::store(out, result);
+					for (size_t i = 0; i < Width; i++)
+						matching = matching && same(out[i], scalar(a[i], b[i]));
+				};
+				auto va = Pack::load(a);
+				auto vb = Pack::load(b);
+				lanewise(va, [](T x, T) { return x; });
+				lanewise(Pack::broadcast(a[0]), [&](T, T) { return a[0]; });
+				lanewise(Pack::add(va, vb), [](T x, T y) { return Scalar::add(x, y); });
+				lanewise(Pack::subtract(va, vb), [](T x, T y) { return Scalar::subtract(x, y); });
+				lanewise(Pack::multiply(va, vb), [](T x, T y) { return Scalar::multiply(x, y); });
+				lanewise(Pack::divide(va, vb), [](T x, T y) { return Scalar::divide(x, y); });
+				lanewise(Pack::sqrt(va), [](T x, T) { return Scalar::sqrt(x); });
+				lanewise(Pack::min(va, vb), [](T x, T y) { return Scalar::min(x, y); });
+				lanewise(Pack::max(va, vb), [](T x, T y) { return Scalar::max(x, y); });
+
+				// Packs may fuse the multiply and add, so either rounding is allowed
+				Pack::store(out, Pack::multiplyAdd(va, vb, Pack::load(c)));
+				for (size_t i = 0; i < Width; i++) {
+					volatile T product = a[i] * b[i];
+					matching = matching && (same(out[i], static_cast<T>(product + c[i])) || same(out[i], std::fma(a[i], b[i], c[i])));
+				}
+
+				// The lanes may be summed in any order
+				long double sum = 0;
+				long double magnitude = 0;
+				bool finite = true;
+				for (size_t i = 0; i < Width; i++) {
+					sum += a[i];
+					magnitude += std::abs(static_cast<long double>(a[i]));
+					finite = finite && std::isfinite(a[i]);
+				}
+				if (finite) matching = matching && close(Pack::sum(va), sum, magnitude);
+			}
+			ESSENTIALS_CHECK(matching);
+		}
+	}
+
+	/**
+	 * Makes a random vector of ordinary values
+	 * @param random The random number generator
+	 * @returns The vector
+	 */
+	template<typename T, size_t N> Math::Vector<T, N> randomVector(std::mt19937& random) {
+		Math::Vector<T, N> result;
+		for (size_t i = 0; i < N; i++)
+			result[i] = static_cast<T>(std::uniform_real_distribution<double>(-10, 10)(random));
+		return result;
+	}
+
+	/**
+	 * Vector operations (SIMD at runtime) against the same operations done one component at a time
+	 */
+	template<typename T, size_t N> void vectorAgainstScalar() {
+		std::mt19937 random(static_cast<unsigned>(N));
+		bool matching = true;
+		for (int trial = 0; trial < 20000; trial++) {
+			Math::Vector<T, N> a = randomVector<T, N>(random);
+			Math::Vector<T, N> b = randomVector<T, N>(random);
+			if (trial % 4 == 0) {
+				// Special values in the elementwise operations
+				for (size_t i = 0; i < N; i++) {
+					a[i] = value<T>(random);
+					b[i] = random() % 4 == 0 ? a[i] : value<T>(random);
+				}
+			}
+			T factor = value<T>(random);
+			auto componentwise = [&](const Math::Vector<T, N>& result, auto scalar) {
+				for (size_t i = 0; i < N; i++)
+					matching = matching && same(result[i], static_cast<T>(scalar(a[i], b[i])));
+			};
+			componentwise(a + b, [](T x, T y) { return x + y; });
+			componentwise(a - b, [](T x, T y) { return x - y; });
+			componentwise(a * b, [](T x, T y) { return x * y; });
+			componentwise(a / b, [](T x, T y) { return x / y; });
+			componentwise(a * factor, [&](T x, T) { return x * factor; });
+			componentwise(factor * a, [&](T x, T) { return x * factor; });
+			componentwise(a / factor, [&](T x, T) { return x / factor; });
+			componentwise(-a, [](T x, T) { return T(0) - x; });
+			componentwise(a.min(b), [](T x, T y) { return Math::SimdPack<T>::min(x, y); });
+			componentwise(a.max(b), [](T x, T y) { return Math::SimdPack<T>::max(x, y); });
+
+			if (trial % 4 == 0) continue;
+			Math::Vector<T, N> sum = a;
+			sum += b;
+			matching = matching && sum == a + b;
+			long double dot = 0;
+			long double magnitude = 0;
+			for (size_t i = 0; i < N; i++) {
+				dot += static_cast<long double>(a[i]) * b[i];
+				magnitude += std::abs(static_cast<long double>(a[i]) * b[i]);
+			}
+			matching = matching && close(a.dot(b), dot, magnitude);
+			matching = matching && close(a.length(), std::sqrt(static_cast<long double>(a.lengthSquared())), a.length());
+			Math::Vector<T, N> unit = a.normalized();
+			matching = matching && close(unit.length(), 1, 1);
+			componentwise(a.lerp(b, T(0.25)), [](T x, T y) { return x + (y - x) * T(0.25); });
+			if constexpr (N == 3) {
+				Math::Vector<T, N> cross = a.cross(b);
+				for (size_t i = 0; i < 3; i++) {
+					size_t j = (i + 1) % 3;
+					size_t k = (i + 2) % 3;
+					long double expected = static_cast<long double>(a[j]) * b[k] - static_cast<long double>(a[k]) * b[j];
+					matching = matching && close(cross[i], expected, std::abs(static_cast<long double>(a[j]) * b[k]) + std::abs(static_cast<long double>(a[k]) * b[j]));
+				}
+			}
+		}
+		ESSENTIALS_CHECK(matching);
+	}
+
+	/**
+	 * The padding lane of 3 component vectors never reaches a result, even when it holds NaN
+	 */
+	template<typename T> void paddedVectors() {
+		using Vector = Math::Vector<T, 3>;
+		if constexpr (sizeof(Vector) == 4 * sizeof(T)) {
+			Vector a(T(1), T(2), T(3));
+			Vector b(T(4), T(-5), T(6));
+			a.data()[3] = std::numeric_limits<T>::quiet_NaN();
+			b.data()[3] = std::numeric_limits<T>::infinity();
+			ESSENTIALS_CHECK(a.dot(b) == T(12));
+			ESSENTIALS_CHECK(a.lengthSquared() == T(14));
+			ESSENTIALS_CHECK(a.cross(b) == Vector(T(27), T(6), T(-13)));
+			ESSENTIALS_CHECK((a + b) == Vector(T(5), T(-3), T(9)));
+			ESSENTIALS_CHECK(a != b && a == Vector(T(1), T(2), T(3)));
+			ESSENTIALS_CHECK(std::isfinite(a.normalized().dot(b.normalized())));
+		}
+	}
+
+	/**
+	 * The vector operations are usable in constant expressions (where the SIMD paths are skipped)
+	 */
+	void constantExpressions() {
+		constexpr Math::Vector3f a(1.0f, 2.0f, 3.0f);
+		constexpr Math::Vector3f b(4.0f, -5.0f, 6.0f);
+		static_assert(a.dot(b) == 12.0f);
+		static_assert(a.cross(b) == Math::Vector3f(27.0f, 6.0f, -13.0f));
+		static_assert(a + b == Math::Vector3f(5.0f, -3.0f, 9.0f) && a - b == Math::Vector3f(-3.0f, 7.0f, -3.0f));
+		static_assert(a * 2.0f == Math::Vector3f(2.0f, 4.0f, 6.0f) && -a == Math::Vector3f(-1.0f, -2.0f, -3.0f));
+		static_assert(a.min(b) == Math::Vector3f(1.0f, -5.0f, 3.0f) && a.max(b) == Math::Vector3f(4.0f, 2.0f, 6.0f));
+		static_assert(Math::Vector2d(3.0, 4.0).length() == 5.0);
+		static_assert(Math::Vector2d(0.0, -8.0).normalized() == Math::Vector2d(0.0, -1.0));
+		static_assert(Math::Vector4d(1.0, 2.0, 3.0, 4.0).lerp(Math::Vector4d(3.0, 2.0, 1.0, 0.0), 0.5) == Math::Vector4d::filled(2.0));
+		static_assert(Math::Vector8f::filled(2.0f).dot(Math::Vector8f::filled(3.0f)) == 48.0f);
+		static_assert(Math::Vector3d(1.0, 0.0, 0.0).cross(Math::Vector3d(0.0, 1.0, 0.0)) == Math::Vector3d(0.0, 0.0, 1.0));
+
+		// The same operations at runtime go through SIMD
+		Math::Vector3f runtimeA = a;
+		Math::Vector3f runtimeB = b;
+		ESSENTIALS_CHECK(runtimeA.dot(runtimeB) == a.dot(b));
+		ESSENTIALS_CHECK(runtimeA.cross(runtimeB) == a.cross(b));
+		ESSENTIALS_CHECK(runtimeA.min(runtimeB) == a.min(b) && runtimeA.max(runtimeB) == a.max(b));
+	}
+
+	/**
+	 * Batch operations against the same operations on each vector, at lengths around the 64K vectors split between threads
+	 * @param pool The pool to run on
+	 */
+	template<typename T, size_t N> void batchAgainstVectors(Threading::ThreadPool& pool) {
+		using Vector = Math::Vector<T, N>;
+		std::mt19937 random(static_cast<unsigned>(N * sizeof(T)));
+		bool matching = true;
+		for (size_t length : { size_t(0), size_t(1), size_t(7), size_t(65535), size_t(65536), size_t(65537), size_t(3 * 65536 + 5) }) {
+			Math::VectorBatch<T, N> a;
+			Math::VectorBatch<T, N> b(length);
+			std::vector<Vector> expectedA;
+			std::vector<Vector> expectedB;
+			for (size_t i = 0; i < length; i++) {
+				expectedA.push_back(randomVector<T, N>(random));
+				expectedB.push_back(randomVector<T, N>(random));
+				a.push(expectedA[i]);
+				b.set(i, expectedB[i]);
+			}
+			matching = matching && a.length() == length && b.length() == length;
+			// Elementwise results are within a rounding of the reference (batches may fuse multiply and add)
+			auto check = [&](const Math::VectorBatch<T, N>& batch, const std::vector<Vector>& expected) {
+				for (size_t i = 0; i < length; i++) {
+					Vector actual = batch.get(i);
+					for (size_t k = 0; k < N; k++)
+						matching = matching && close(actual[k], expected[i][k], std::abs(expected[i][k]) + 100);
+				}
+			};
+			Vector offset = randomVector<T, N>(random);
+
+			a.add(b, pool);
+			for (size_t i = 0; i < length; i++)
+				expectedA[i] += expectedB[i];
+			check(a, expectedA);
+			a.add(offset, pool);
+			for (size_t i = 0; i < length; i++)
+				expectedA[i] += offset;
+			check(a, expectedA);
+			a.subtract(b, pool);
+			for (size_t i = 0; i < length; i++)
+				expectedA[i] -= expectedB[i];
+			check(a, expectedA);
+			a.scale(T(1.5), pool);
+			for (size_t i = 0; i < length; i++)
+				expectedA[i] *= T(1.5);
+			check(a, expectedA);
+			a.addScaled(b, T(-0.5), pool);
+			for (size_t i = 0; i < length; i++)
+				expectedA[i] += expectedB[i] * T(-0.5);
+			check(a, expectedA);
+			a.lerp(b, T(0.25), pool);
+			for (size_t i = 0; i < length; i++)
+				expectedA[i] = expectedA[i].lerp(expectedB[i], T(0.25));
+			check(a, expectedA);
+
+			std::vector<T> out(length + 1, T(-1));
+			a.dot(b, out.data(), pool);
+			for (size_t i = 0; i < length; i++)
+				matching = matching && close(out[i], expectedA[i].dot(expectedB[i]), 1000);
+			a.lengths(out.data(), pool);
+			for (size_t i = 0; i < length; i++)
+				matching = matching && close(out[i], expectedA[i].length(), expectedA[i].length());
+			matching = matching && out[length] == T(-1);
+			a.normalize(pool);
+			for (size_t i = 0; i < length; i++)
+				expectedA[i] = expectedA[i].normalized();
+			check(a, expectedA);
+
+			Math::VectorBatch<T, N> copy(a);
+			Math::VectorBatch<T, N> moved(std::move(copy));
+			matching = matching && moved.length() == length && (length == 0 || moved.get(length - 1) == a.get(length - 1));
+		}
+		ESSENTIALS_CHECK(matching);
+	}
+}
+
+int main() {
+	packAgainstScalar<float, 4>();
+	packAgainstScalar<double, 2>();
+	packAgainstScalar<float, 8>();
+	packAgainstScalar<double, 4>();
+	vectorAgainstScalar<float, 2>();
+	vectorAgainstScalar<float, 3>();
+	vectorAgainstScalar<float, 4>();
+	vectorAgainstScalar<float, 8>();
+	vectorAgainstScalar<double, 2>();
+	vectorAgainstScalar<double, 3>();
+	vectorAgainstScalar<double, 4>();
+	vectorAgainstScalar<double, 8>();
+	paddedVectors<float>();
+	paddedVectors<double>();
+	constantExpressions();
+	for (size_t threads : { size_t(0), size_t(3) }) {
+		Threading::ThreadPool pool(threads);
+		batchAgainstVectors<float, 3>(pool);
+		batchAgainstVectors<float, 4>(pool);
+		batchAgainstVectors<double, 2>(pool);
+		batchAgainstVectors<double, 3>(pool);
+	}
+	return Tests::result();
+}
\ No newline at end of file